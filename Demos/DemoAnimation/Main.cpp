@@ -78,6 +78,11 @@ using namespace mash;
  
  Lodding, animation, material selection, and lighting have already be applied offline
  in the scene editor.	
+ 
+ The characters skin is added to a MashSkinPaletteBuffer. Its bone palette is then
+ uploaded to a texture once per frame and read by the vertex shader using the
+ autoBonePaletteTexture and autoBonePaletteInfo auto parameters. Crowds of characters
+ can share one buffer so all their palettes are uploaded together.
  */
 class MainLoop : public MashGameLoop
 {
@@ -86,6 +91,7 @@ private:
     
 	MashSceneNode *m_root;
 	MashEntity *m_animatedEntity;
+	MashSkinPaletteBuffer *m_paletteBuffer;
 	MashSceneNode *m_batAttachPoint;
 	MashAnimationMixer *m_animationMixer;
 	uint32 m_playerControl;
@@ -100,8 +106,15 @@ private:
 	MashGUIStaticText *m_footStepText;
 	f32 m_footStepSoundTimer;
 public:
-	MainLoop(MashDevice *device):m_device(device), m_leanFrame(0), m_footStepSoundTimer(0.0f), m_addToCameraPosition(0.0f){}
-	virtual ~MainLoop(){}
+	MainLoop(MashDevice *device):m_device(device), m_paletteBuffer(0), m_leanFrame(0), m_footStepSoundTimer(0.0f), m_addToCameraPosition(0.0f){}
+	virtual ~MainLoop()
+	{
+		if (m_paletteBuffer)
+		{
+			m_paletteBuffer->Drop();
+			m_paletteBuffer = 0;
+		}
+	}
     
 	bool Initialise()
 	{
@@ -170,6 +183,9 @@ public:
         m_root->AddChild(chararacterRoot);	
         
 		m_animatedEntity = (MashEntity*)m_root->GetChildByName("Character");
+		//the skinning material reads bones from the palette buffers texture
+		m_paletteBuffer = m_device->GetSceneManager()->CreateSkinPaletteBuffer();
+		m_paletteBuffer->AddSkin(m_animatedEntity->GetSkin());
 		//Note the animation mixer is not within the entity, but its parent.
 		m_animationMixer = chararacterRoot->GetAnimationMixer();
         
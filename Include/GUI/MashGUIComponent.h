@@ -85,8 +85,17 @@ namespace mash
 		virtual void OnMouseEnter(const mash::MashVector2 &vScreenPos){}
 		virtual void OnMouseExit(const mash::MashVector2 &vScreenPos){}
 		virtual void OnChildRegionChange(MashGUIComponent *component){}
+		virtual void OnRenderCacheDirty(){}
+		virtual void OnHitTestDirty(){}
 		virtual void OnChildAlwaysOnTop(MashGUIComponent *component){}
 		virtual void OnRemoveChildAlwaysOnTop(MashGUIComponent *component){}
+
+		/*
+			Called when this components absolute clipped region changes. Invalidates
+			the hit testing data of this component and its parent only. Views further
+			up only test against their direct children so they are unaffected.
+		*/
+		void MarkLayoutDirty();
 	public:
 		MashGUIComponent(MashGUIManager *pGUIManager,
 			MashInputManager *pInputManager,
@@ -274,6 +283,27 @@ namespace mash
 		//! Drawing function implimented by each component.
 		virtual void Draw() = 0;
 
+		//! Marks this component as needing to be redrawn.
+		/*!
+			Any retained views above this component will rebuild their cached geometry
+			on the next draw. See MashGUIView::SetRetainedMode().
+
+			This is done automatically for region, visibility, focus, hover, style and
+			input changes, and by the common setters of each component. Call this after
+			changing anything else that affects rendering, for example a skin.
+		*/
+		void MarkDirty();
+
+		//! Returns true if this component must be drawn every frame.
+		/*!
+			Retained views holding this component will rebuild every frame while this
+			returns true. For example, a focused textbox that renders a blinking caret.
+			Only checked for the focused component.
+
+			\return True if this component changes every frame.
+		*/
+		virtual bool _RedrawEveryFrame()const{return false;}
+
 		//! GUI Type.
 		/*!
 			\return GUI type.
@@ -436,6 +436,57 @@ namespace mash
 		//! Flushes render buffers.
 		virtual void FlushBuffers() = 0;
 
+		//! Gets the number of vertices generated since BeginDraw().
+		/*!
+			Debug method. Counts vertices built by components while drawing.
+			Vertices drawn from a retained view cache are not included.
+
+			\return Vertices generated.
+		*/
+		virtual uint32 GetGeneratedVertexCount()const = 0;
+
+		//! Gets the number of vertices reused from retained view caches since BeginDraw().
+		/*!
+			Debug method. See MashGUIView::SetRetainedMode().
+
+			\return Vertices reused.
+		*/
+		virtual uint32 GetReusedVertexCount()const = 0;
+
+		//! Internal use only.
+		/*!
+			Starts recording draw calls into the cache owned by a retained view.
+			Must be followed by _EndRetainedDraw().
+
+			\param owner Retained view.
+		*/
+		virtual void _BeginRetainedDraw(MashGUIComponent *owner) = 0;
+
+		//! Internal use only.
+		/*!
+			Stops recording draw calls started with _BeginRetainedDraw().
+
+			\param owner Retained view.
+		*/
+		virtual void _EndRetainedDraw(MashGUIComponent *owner) = 0;
+
+		//! Internal use only.
+		/*!
+			Draws the cache of a retained view.
+
+			\param owner Retained view.
+			\return True if the cache was drawn. False if it must be rebuilt.
+		*/
+		virtual bool _DrawRetained(MashGUIComponent *owner) = 0;
+
+		//! Internal use only.
+		/*!
+			Frees the cache of a retained view.
+
+			\param owner Retained view.
+		*/
+		virtual void _ReleaseRetained(MashGUIComponent *owner) = 0;
+
 		//! Gets the gui factory.
 		/*!
 			This should be accessed only when creating composite objects such as
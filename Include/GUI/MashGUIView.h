@@ -51,6 +51,25 @@ namespace mash
 		*/
 		virtual bool GetRenderbackgroundState()const = 0;
 
+		//! Enables retained mode rendering.
+		/*!
+			A retained view caches the geometry generated by itself and all its children.
+			The cache is drawn each frame without walking the children, and is only rebuilt
+			when something inside the view is marked dirty. See MashGUIComponent::MarkDirty().
+
+			Use this for large views that rarely change, such as tool panels.
+			Custom renderers that change their output must call MarkDirty() themselves.
+
+			\param enable Enables or disables retained mode.
+		*/
+		virtual void SetRetainedMode(bool enable) = 0;
+
+		//! Gets the retained mode state.
+		/*!
+			\return True if retained mode is enabled, false otherwise.
+		*/
+		virtual bool GetRetainedMode()const = 0;
+
 		//! Is the horizontal scrollbar enabled.
 		/*!
             Note if this returns true, the scrollbar may not be activated if
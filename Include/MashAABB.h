@@ -9,12 +9,12 @@
 
 #include "MashCompileSettings.h"
 #include "MashVector3.h"
+#include "MashMatrix4.h"
 #include "MashArray.h"
 
 namespace mash
 {
 	class MashPlane;
-	class MashMatrix4;
 	class MashTransformState;
 
 	//! Defines an axis aligned 3D box.
@@ -162,6 +162,12 @@ namespace mash
 		*/
 		void Add(const MashVector3 &point);
 	};
+
+	inline MashAABB& MashAABB::Transform(const MashMatrix4 &matrix)
+	{
+		simd::AABBTransform(matrix.v, min.v, max.v, min.v, max.v);
+		return *this;
+	}
 }
 
 #endif
\ No newline at end of file
@@ -13,6 +13,7 @@
 #include "MashEventTypes.h"
 #include "MashArray.h"
 #include "MashString.h"
+#include "MashStringID.h"
 
 namespace mash
 {
@@ -98,6 +99,12 @@ namespace mash
 					the same track as the one being faded in.
 		*/
 		virtual void Transition(const int8 *name, f32 transitionLength = 0.4f, bool affectAllTracks = false) = 0; 
+
+		//! Transition by interned name.
+		/*!
+			Same as Transition(const int8*, f32, bool) but avoids a string lookup.
+		*/
+		virtual void Transition(const MashStringID &animationID, f32 transitionLength = 0.4f, bool affectAllTracks = false) = 0;
 		
 		//! Play a particular animation set.
 		/*!
@@ -112,6 +119,13 @@ namespace mash
 		*/
 		virtual eMASH_STATUS Play(const int8 *name, bool stopAndResetAllTracks = false) = 0;
 
+		//! Play by interned name.
+		/*!
+			Same as Play(const int8*, bool) but avoids a string lookup.
+			Create the id once, for example MashStringID("walk"), and reuse it.
+		*/
+		virtual eMASH_STATUS Play(const MashStringID &animationID, bool stopAndResetAllTracks = false) = 0;
+
 		//! Stop an animation set from playing.
 		/*!
 			\param name Animation set to stop playing.
@@ -119,6 +133,12 @@ namespace mash
 		*/
 		virtual eMASH_STATUS Stop(const int8 *name, bool resetBackStart = false) = 0;
 
+		//! Stop by interned name.
+		/*!
+			Same as Stop(const int8*, bool) but avoids a string lookup.
+		*/
+		virtual eMASH_STATUS Stop(const MashStringID &animationID, bool resetBackStart = false) = 0;
+
 		//! Stop all animation sets from playing.
 		/*!
 			\return OK if no errors occured. FAILED otherwise.
@@ -143,6 +163,12 @@ namespace mash
 		*/
 		virtual eMASH_STATUS SetSpeed(const int8 *name, f32 speed) = 0;
 
+		//! SetSpeed by interned name.
+		/*!
+			Same as SetSpeed(const int8*, f32) but avoids a string lookup.
+		*/
+		virtual eMASH_STATUS SetSpeed(const MashStringID &animationID, f32 speed) = 0;
+
 		//! Only useful if Play is false. Sets the current frame.
 		/*!
 			This can be used for procedural animation, for example, playing
@@ -154,6 +180,12 @@ namespace mash
 		*/
 		virtual eMASH_STATUS SetFrame(const int8 *name, int32 frame) = 0;
 
+		//! SetFrame by interned name.
+		/*!
+			Same as SetFrame(const int8*, int32) but avoids a string lookup.
+		*/
+		virtual eMASH_STATUS SetFrame(const MashStringID &animationID, int32 frame) = 0;
+
 		//! Manually sets the blend weight.
 		/*!
 			Only valid if an animations blend mode is set to aBLEND_BLEND.
@@ -170,6 +202,12 @@ namespace mash
 		*/
 		virtual eMASH_STATUS SetWeight(const int8 *name, f32 weight) = 0;
 
+		//! SetWeight by interned name.
+		/*!
+			Same as SetWeight(const int8*, f32) but avoids a string lookup.
+		*/
+		virtual eMASH_STATUS SetWeight(const MashStringID &animationID, f32 weight) = 0;
+
 		//! Sets the wrap mode.
 		/*!
 			\param name Animation set to affect.
@@ -207,6 +245,12 @@ namespace mash
 		*/
 		virtual bool GetIsPlaying(const int8 *name)const = 0;
 
+		//! GetIsPlaying by interned name.
+		/*!
+			Same as GetIsPlaying(const int8*) but avoids a string lookup.
+		*/
+		virtual bool GetIsPlaying(const MashStringID &animationID)const = 0;
+
 		//! Returns the current frame.
 		/*!
 			\param name Animation set name.
@@ -214,6 +258,12 @@ namespace mash
 		*/
 		virtual int32 GetFrame(const int8 *name)const = 0;
 
+		//! GetFrame by interned name.
+		/*!
+			Same as GetFrame(const int8*) but avoids a string lookup.
+		*/
+		virtual int32 GetFrame(const MashStringID &animationID)const = 0;
+
 		//! Returns the speed.
 		/*!
 			\param name Animation set name.
@@ -228,6 +278,12 @@ namespace mash
 		*/
 		virtual f32 GetWeight(const int8 *name)const = 0;
 
+		//! GetWeight by interned name.
+		/*!
+			Same as GetWeight(const int8*) but avoids a string lookup.
+		*/
+		virtual f32 GetWeight(const MashStringID &animationID)const = 0;
+
 		//! Returns the wrap mode.
 		/*!
 			\param name Animation set name.
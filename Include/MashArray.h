@@ -19,6 +19,13 @@ namespace mash
 {
     /*!
         Templated dynamic array. 
+
+        Elements are moved with memcpy when the array grows if the type is fundamental
+        or helpers::MashIsTriviallyRelocatable is specialised for it. Other types are
+        moved using helpers::MashRelocateElement.
+
+        See MashInlineArray for an array that holds a number of elements before
+        allocating memory.
     */
 	template<class T, class TAlloc = MashMemoryPoolSimple>
 	class MashArray
@@ -241,51 +248,104 @@ namespace mash
 		uint32 m_reservedElements;
 		uint32 m_currentElements;
 
+		//storage owned by MashInlineArray. Never freed.
+		T *m_inlineData;
+		uint32 m_inlineElements;
+
+		bool _IsInline()const
+		{
+			return (m_data != 0) && (m_data == m_inlineData);
+		}
+
+		void _FreeData()
+		{
+			if (m_data && !_IsInline())
+				m_memoryPool.FreeMemory(m_data);
+
+			m_data = m_inlineData;
+			m_reservedElements = m_inlineElements;
+		}
+
 		void _Reserve(uint32 elementCount)
 		{
-			T *newMemory = (T*)m_memoryPool.GetMemory(sizeof(T) * elementCount);
+			T *newMemory = 0;
+			if (m_inlineData && (elementCount <= m_inlineElements))
+				newMemory = m_inlineData;
+			else
+				newMemory = (T*)m_memoryPool.GetMemory(sizeof(T) * elementCount);
 
-			//copy over old data
+			if (newMemory == m_data)
+				return;
+
+			//move over old data
 			if (m_data)
 			{
-				if (m_currentElements > 0)
-				{
-					//reconstruct old data
-					if (!helpers::MashIsFundamental<T>::value)
-					{
-						for(uint32 i = 0; i < m_currentElements; ++i)
-						{
-							MashMemoryAllocatorHelper<T>::Construct(&newMemory[i], m_data[i]);
-							MashMemoryAllocatorHelper<T>::Destruct(&m_data[i]);
-						}
-					}
-					else
-					{
-						//memcpy primitive types
-						memcpy(newMemory, m_data, sizeof(T) * m_currentElements);
-					}
-				}
+				helpers::MashRelocate<T>(newMemory, m_data, m_currentElements);
+
+				if (!_IsInline())
+					m_memoryPool.FreeMemory(m_data);
 
-				m_memoryPool.FreeMemory(m_data);
 				m_data = 0;
 			}
 
 			m_data = newMemory;
-			m_reservedElements = elementCount;
+			m_reservedElements = (newMemory == m_inlineData) ? m_inlineElements : elementCount;
+		}
+	protected:
+		//keeps the inline storage constructors from being picked over MashArray(const T*, uint32)
+		struct sInlineStorageTag{};
+
+		/*
+			Used by MashInlineArray. The buffer must stay valid for the lifetime
+			of this array.
+		*/
+		MashArray(sInlineStorageTag, T *inlineData, uint32 inlineElements):m_data(inlineData), m_reservedElements(inlineElements), m_currentElements(0),
+			m_inlineData(inlineData), m_inlineElements(inlineElements)
+		{
+		}
+
+		MashArray(sInlineStorageTag, T *inlineData, uint32 inlineElements, const TAlloc &alloc):m_memoryPool(alloc), 
+			m_data(inlineData), m_reservedElements(inlineElements), m_currentElements(0),
+			m_inlineData(inlineData), m_inlineElements(inlineElements)
+		{
 		}
 	public:
-		MashArray():m_data(0), m_reservedElements(0), m_currentElements(0)
+		MashArray():m_data(0), m_reservedElements(0), m_currentElements(0), m_inlineData(0), m_inlineElements(0)
 		{
 		}
 
 		MashArray(const MashArray<T, TAlloc> &other):m_memoryPool(other.m_memoryPool), 
-			m_data(0), m_reservedElements(0), m_currentElements(0)
+			m_data(0), m_reservedElements(0), m_currentElements(0), m_inlineData(0), m_inlineElements(0)
 		{
 			*this = other;
 		}
 
+#ifdef MASH_HAS_MOVE_SEMANTICS
+        //! Move constructor.
+        /*!
+            Takes the memory of other if possible. other is left empty.
+        */
+		MashArray(MashArray<T, TAlloc> &&other):m_memoryPool(other.m_memoryPool), 
+			m_data(0), m_reservedElements(0), m_currentElements(0), m_inlineData(0), m_inlineElements(0)
+		{
+			Swap(other);
+		}
+
+        //! Move assignment.
+		MashArray<T, TAlloc>& operator=(MashArray<T, TAlloc> &&other)
+		{
+			if (&other != this)
+			{
+				Clear();
+				Swap(other);
+			}
+
+			return *this;
+		}
+#endif
+
 		MashArray(const TAlloc &alloc):m_memoryPool(alloc), 
-			m_data(0), m_reservedElements(0), m_currentElements(0)
+			m_data(0), m_reservedElements(0), m_currentElements(0), m_inlineData(0), m_inlineElements(0)
 		{
 		}
 
@@ -294,7 +354,7 @@ namespace mash
             \param items A C array of items to fill this array with.
             \param count Number of elements in items.
         */
-		MashArray(const T *items, uint32 count):m_data(0), m_reservedElements(0), m_currentElements(0)
+		MashArray(const T *items, uint32 count):m_data(0), m_reservedElements(0), m_currentElements(0), m_inlineData(0), m_inlineElements(0)
 		{
 			Append(items, count);
 		}
@@ -306,7 +366,7 @@ namespace mash
             \param alloc Allocator.
          */
 		MashArray(const T *items, uint32 count, const TAlloc &alloc):m_memoryPool(alloc), 
-			m_data(0), m_reservedElements(0), m_currentElements(0)
+			m_data(0), m_reservedElements(0), m_currentElements(0), m_inlineData(0), m_inlineElements(0)
 		{
 			Append(items, count);
 		}
@@ -316,7 +376,7 @@ namespace mash
             \param size Number of elements this array will be resized to.
             \param val Default value for all newly constructed elements.
         */
-		MashArray(uint32 size, const T &val = T()):m_data(0), m_reservedElements(0), m_currentElements(0)
+		MashArray(uint32 size, const T &val = T()):m_data(0), m_reservedElements(0), m_currentElements(0), m_inlineData(0), m_inlineElements(0)
 		{
 			Resize(size, val);
 		}
@@ -328,7 +388,7 @@ namespace mash
             \param alloc Allocator.
          */
 		MashArray(uint32 size, const T &val, const TAlloc &alloc):m_memoryPool(alloc), 
-			m_data(0), m_reservedElements(0), m_currentElements(0)
+			m_data(0), m_reservedElements(0), m_currentElements(0), m_inlineData(0), m_inlineElements(0)
 		{
 			Resize(size, val);
 		}
@@ -349,15 +409,57 @@ namespace mash
 					for(uint32 i = 0; i < m_currentElements; ++i)
 						MashMemoryAllocatorHelper<T>::Destruct(&m_data[i]);
 				}
-
-				m_memoryPool.FreeMemory(m_data);
-				m_data = 0;
 			}
 
-			m_reservedElements = 0;
+			_FreeData();
 			m_currentElements = 0;
 		}
 
+        //! Exchanges the contents of two arrays.
+        /*!
+            Only pointers are exchanged if the allocator is stateless and neither array
+            is using inline storage. Otherwise elements are moved between the arrays.
+        */
+		void Swap(MashArray<T, TAlloc> &other)
+		{
+			if (&other == this)
+				return;
+
+			if (helpers::MashIsAllocatorStateless<TAlloc>::value && !_IsInline() && !other._IsInline())
+			{
+				//an array with no memory reports its inline storage, so keep that with the array
+				T *data = m_data;
+				uint32 reserved = m_reservedElements;
+				uint32 current = m_currentElements;
+
+				m_data = other.m_data ? other.m_data : m_inlineData;
+				m_reservedElements = other.m_data ? other.m_reservedElements : m_inlineElements;
+				m_currentElements = other.m_currentElements;
+
+				other.m_data = data ? data : other.m_inlineData;
+				other.m_reservedElements = data ? reserved : other.m_inlineElements;
+				other.m_currentElements = current;
+			}
+			else
+			{
+				MashArray<T, TAlloc> temp(m_memoryPool);
+				temp.Reserve(m_currentElements);
+				helpers::MashRelocate<T>(temp.m_data, m_data, m_currentElements);
+				temp.m_currentElements = m_currentElements;
+				m_currentElements = 0;
+
+				Reserve(other.m_currentElements);
+				helpers::MashRelocate<T>(m_data, other.m_data, other.m_currentElements);
+				m_currentElements = other.m_currentElements;
+				other.m_currentElements = 0;
+
+				other.Reserve(temp.m_currentElements);
+				helpers::MashRelocate<T>(other.m_data, temp.m_data, temp.m_currentElements);
+				other.m_currentElements = temp.m_currentElements;
+				temp.m_currentElements = 0;
+			}
+		}
+
         //! Returns true if this array contains the given value.
 		bool Contains(const T &val)
 		{
@@ -488,7 +590,7 @@ namespace mash
         */
 		void Reserve(uint32 elementCount)
 		{
-			if (elementCount < m_reservedElements)
+			if (elementCount <= m_reservedElements)
 				return;
 
 			_Reserve(elementCount);
@@ -511,9 +613,10 @@ namespace mash
 			if (elementCount == m_currentElements)
 				return;
 
-			if (elementCount > m_reservedElements)
+			if (elementCount > m_currentElements)
 			{
-				_Reserve(elementCount);
+				if (elementCount > m_reservedElements)
+					_Reserve(elementCount);
 			
 				//construct new elements
 				if (helpers::MashIsInt8<T>::value || helpers::MashIsUInt8<T>::value)
@@ -558,15 +661,8 @@ namespace mash
 			if (newSize > m_reservedElements)
 				_Reserve(newSize * 2);
 
-			if (m_currentElements > 0)
-			{
-				int32 loc = location;
-				for(int32 i = m_currentElements-1; i >= loc; --i)
-				{
-					MashMemoryAllocatorHelper<T>::Construct(&m_data[i+count], m_data[i]);
-					MashMemoryAllocatorHelper<T>::Destruct(&m_data[i]);
-				}
-			}
+			if (location < m_currentElements)
+				helpers::MashRelocate<T>(&m_data[location + count], &m_data[location], m_currentElements - location);
 
 			for(uint32 i = 0; i < count; ++i)
 			{
@@ -629,6 +725,18 @@ namespace mash
 		{
 			Append(&item, 1);
 		}
+
+#ifdef MASH_HAS_MOVE_SEMANTICS
+        //! Moves a new item to the end of this array.
+		void PushBack(T &&item)
+		{
+			if (m_currentElements == m_reservedElements)
+				_Reserve((m_currentElements + 1) * 2);
+
+			new ((void*)&m_data[m_currentElements]) T(static_cast<T&&>(item));
+			++m_currentElements;
+		}
+#endif
         
         //! Adds a new item to the front of this array.
         /*!
@@ -680,21 +788,9 @@ namespace mash
 			if (m_currentElements > 0)
 			{
 				if (!helpers::MashIsFundamental<T>::value)
-				{
-					for(uint32 i = index+1; i < m_currentElements; ++i)
-					{
-						MashMemoryAllocatorHelper<T>::Destruct(&m_data[i-1]);
-						MashMemoryAllocatorHelper<T>::Construct(&m_data[i-1], m_data[i]);
-					}
-
-					//destruct the last element
-					MashMemoryAllocatorHelper<T>::Destruct(&m_data[m_currentElements-1]);
-				}
-				else
-				{
-					for(uint32 i = index+1; i < m_currentElements; ++i)
-						m_data[i-1] = m_data[i];
-				}
+					MashMemoryAllocatorHelper<T>::Destruct(&m_data[index]);
+
+				helpers::MashRelocate<T>(&m_data[index], &m_data[index+1], m_currentElements - (index+1));
 				
 				--m_currentElements;
 			}
@@ -789,16 +885,12 @@ namespace mash
         //! Shrinks the reserved memory to fit Size().
 		void ShrinkToFit()
 		{
-			if (m_reservedElements != m_currentElements)
+			if ((m_reservedElements != m_currentElements) && !_IsInline())
 			{
 				if (m_currentElements > 0)
 					_Reserve(m_currentElements);
-				else if (m_data)
-				{
-					m_memoryPool.FreeMemory(m_data);
-					m_data = 0;
-					m_reservedElements = 0;
-				}
+				else
+					_FreeData();
 			}
 		}
 
@@ -838,6 +930,72 @@ namespace mash
             return m_memoryPool;
         }
 	};
+
+    /*!
+        Array that holds up to TInlineCount elements without allocating memory.
+        Memory is only allocated if the array grows beyond that.
+
+        Useful for small arrays that are created and destroyed often.
+        This is not trivially relocatable so avoid storing it in other containers.
+    */
+	template<class T, uint32 TInlineCount, class TAlloc = MashMemoryPoolSimple>
+	class MashInlineArray : public MashArray<T, TAlloc>
+	{
+	private:
+		union
+		{
+			int8 m_inlineBytes[sizeof(T) * TInlineCount];
+			//forces alignment for the largest built in types
+			f64 m_alignDouble;
+			void *m_alignPointer;
+		};
+	public:
+		MashInlineArray():MashArray<T, TAlloc>(typename MashArray<T, TAlloc>::sInlineStorageTag(), (T*)m_inlineBytes, TInlineCount)
+		{
+		}
+
+		MashInlineArray(const TAlloc &alloc):MashArray<T, TAlloc>(typename MashArray<T, TAlloc>::sInlineStorageTag(), (T*)m_inlineBytes, TInlineCount, alloc)
+		{
+		}
+
+		MashInlineArray(const MashInlineArray<T, TInlineCount, TAlloc> &other):MashArray<T, TAlloc>(typename MashArray<T, TAlloc>::sInlineStorageTag(), (T*)m_inlineBytes, TInlineCount, other.GetAllocator())
+		{
+			this->Append(other.Pointer(), other.Size());
+		}
+
+		MashInlineArray(const MashArray<T, TAlloc> &other):MashArray<T, TAlloc>(typename MashArray<T, TAlloc>::sInlineStorageTag(), (T*)m_inlineBytes, TInlineCount, other.GetAllocator())
+		{
+			this->Append(other.Pointer(), other.Size());
+		}
+
+		~MashInlineArray()
+		{
+			//free before the inline storage goes away
+			this->DeleteData();
+		}
+
+		MashInlineArray<T, TInlineCount, TAlloc>& operator=(const MashInlineArray<T, TInlineCount, TAlloc> &other)
+		{
+			MashArray<T, TAlloc>::operator=(other);
+			return *this;
+		}
+
+		MashInlineArray<T, TInlineCount, TAlloc>& operator=(const MashArray<T, TAlloc> &other)
+		{
+			MashArray<T, TAlloc>::operator=(other);
+			return *this;
+		}
+	};
+
+	namespace helpers
+	{
+		//arrays hold no pointers into themselves unless they use inline storage
+		template<class T>
+		struct MashIsTriviallyRelocatable<MashArray<T, MashMemoryPoolSimple> >
+		{
+			enum {value = 1};
+		};
+	}
 }
 
 #endif
\ No newline at end of file
@@ -53,6 +53,16 @@ namespace mash
             \return A string containing the paramerter name.
          */
 		virtual const int8* GetParameterName()const = 0;
+
+        //! How often this parameter is expected to change.
+		/*!
+            Parameters that change less than once per object are only uploaded
+            when their data changes. Override this for custom parameters whose data
+            does not change per object.
+         
+            \return Update rate. Default is aAUTO_PARAM_UPDATE_PER_OBJECT.
+         */
+		virtual eAUTO_PARAM_UPDATE_RATE GetUpdateRate()const{return aAUTO_PARAM_UPDATE_PER_OBJECT;}
 	};
 
 	class MashParameterWVP : public MashAutoEffectParameter
@@ -81,6 +91,7 @@ namespace mash
 			uint32 index = 0);
 
 		const int8* GetParameterName()const{return g_effectAutoNames[aEFFECT_VIEW_PROJECTION];}
+		eAUTO_PARAM_UPDATE_RATE GetUpdateRate()const{return aAUTO_PARAM_UPDATE_PER_VIEW;}
 	};
 
 	class MashParameterWorld : public MashAutoEffectParameter
@@ -109,6 +120,7 @@ namespace mash
 			uint32 index = 0);
 
 		const int8* GetParameterName()const{return g_effectAutoNames[aEFFECT_VIEW];}
+		eAUTO_PARAM_UPDATE_RATE GetUpdateRate()const{return aAUTO_PARAM_UPDATE_PER_VIEW;}
 	};
 
 	class MashParameterProj : public MashAutoEffectParameter
@@ -123,6 +135,7 @@ namespace mash
 			uint32 index = 0);
 
 		const int8* GetParameterName()const{return g_effectAutoNames[aEFFECT_PROJECTION];}
+		eAUTO_PARAM_UPDATE_RATE GetUpdateRate()const{return aAUTO_PARAM_UPDATE_PER_VIEW;}
 	};
 
 	class MashParameterWorldInvTrans : public MashAutoEffectParameter
@@ -151,6 +164,7 @@ namespace mash
 			uint32 index = 0);
 
 		const int8* GetParameterName()const{return g_effectAutoNames[aEFFECT_VIEW_INV_TRANSPOSE];}
+		eAUTO_PARAM_UPDATE_RATE GetUpdateRate()const{return aAUTO_PARAM_UPDATE_PER_VIEW;}
 	};
 
 	class MashParameterWorldViewInvTrans : public MashAutoEffectParameter
@@ -181,6 +195,7 @@ namespace mash
 			uint32 index = 0);
 
 		const int8* GetParameterName()const{return g_effectAutoNames[aEFFECT_INV_VIEW_PROJ];}
+		eAUTO_PARAM_UPDATE_RATE GetUpdateRate()const{return aAUTO_PARAM_UPDATE_PER_VIEW;}
 	};
 
 	class MashParameterInvView : public MashAutoEffectParameter
@@ -197,6 +212,7 @@ namespace mash
 			uint32 index = 0);
 
 		const int8* GetParameterName()const{return g_effectAutoNames[aEFFECT_INV_VIEW];}
+		eAUTO_PARAM_UPDATE_RATE GetUpdateRate()const{return aAUTO_PARAM_UPDATE_PER_VIEW;}
 	};
 
 	class MashParameterInvProj : public MashAutoEffectParameter
@@ -213,6 +229,7 @@ namespace mash
 			uint32 index = 0);
 
 		const int8* GetParameterName()const{return g_effectAutoNames[aEFFECT_INV_PROJECTION];}
+		eAUTO_PARAM_UPDATE_RATE GetUpdateRate()const{return aAUTO_PARAM_UPDATE_PER_VIEW;}
 	};
 
 	class MashParameterTexture : public MashAutoEffectParameter
@@ -243,6 +260,7 @@ namespace mash
 			uint32 index = 0);
 
 		const int8* GetParameterName()const{return g_effectAutoNames[aEFFECT_LIGHT];}
+		eAUTO_PARAM_UPDATE_RATE GetUpdateRate()const{return aAUTO_PARAM_UPDATE_PER_FRAME;}
 	};
 
 	class MashParameterCameraNearFar : public MashAutoEffectParameter
@@ -257,6 +275,7 @@ namespace mash
 			uint32 index = 0);
 
 		const int8* GetParameterName()const{return g_effectAutoNames[aEFFECT_CAMERA_NEAR_FAR];}
+		eAUTO_PARAM_UPDATE_RATE GetUpdateRate()const{return aAUTO_PARAM_UPDATE_PER_VIEW;}
 	};
 
 	class MashParameterShadowMap : public MashAutoEffectParameter
@@ -371,6 +390,76 @@ namespace mash
 		const int8* GetParameterName()const{return g_effectAutoNames[aEFFECT_BONE_PALETTE_ARRAY];}
 	};
 
+	class MashParamBonePaletteTexture : public MashAutoEffectParameter
+	{
+	public:
+		MashParamBonePaletteTexture():MashAutoEffectParameter(){}
+		~MashParamBonePaletteTexture(){}
+
+		void OnSet(const MashRenderInfo *renderInfo, 
+			MashEffect *effect, 
+			MashEffectParamHandle *parameter,
+			uint32 index = 0);
+
+		const int8* GetParameterName()const{return g_effectAutoNames[aEFFECT_BONE_PALETTE_TEXTURE];}
+	};
+
+	class MashParamBonePaletteInfo : public MashAutoEffectParameter
+	{
+	public:
+		MashParamBonePaletteInfo():MashAutoEffectParameter(){}
+		~MashParamBonePaletteInfo(){}
+
+		void OnSet(const MashRenderInfo *renderInfo, 
+			MashEffect *effect, 
+			MashEffectParamHandle *parameter,
+			uint32 index = 0);
+
+		const int8* GetParameterName()const{return g_effectAutoNames[aEFFECT_BONE_PALETTE_INFO];}
+	};
+
+	class MashParamLightClusterTexture : public MashAutoEffectParameter
+	{
+	public:
+		MashParamLightClusterTexture():MashAutoEffectParameter(){}
+		~MashParamLightClusterTexture(){}
+
+		void OnSet(const MashRenderInfo *renderInfo, 
+			MashEffect *effect, 
+			MashEffectParamHandle *parameter,
+			uint32 index = 0);
+
+		const int8* GetParameterName()const{return g_effectAutoNames[aEFFECT_LIGHT_CLUSTER_TEXTURE];}
+	};
+
+	class MashParamLightClusterInfo : public MashAutoEffectParameter
+	{
+	public:
+		MashParamLightClusterInfo():MashAutoEffectParameter(){}
+		~MashParamLightClusterInfo(){}
+
+		void OnSet(const MashRenderInfo *renderInfo, 
+			MashEffect *effect, 
+			MashEffectParamHandle *parameter,
+			uint32 index = 0);
+
+		const int8* GetParameterName()const{return g_effectAutoNames[aEFFECT_LIGHT_CLUSTER_INFO];}
+	};
+
+	class MashParamLightClusterGrid : public MashAutoEffectParameter
+	{
+	public:
+		MashParamLightClusterGrid():MashAutoEffectParameter(){}
+		~MashParamLightClusterGrid(){}
+
+		void OnSet(const MashRenderInfo *renderInfo, 
+			MashEffect *effect, 
+			MashEffectParamHandle *parameter,
+			uint32 index = 0);
+
+		const int8* GetParameterName()const{return g_effectAutoNames[aEFFECT_LIGHT_CLUSTER_GRID];}
+	};
+
 	class MashParamLightWorldPosition : public MashAutoEffectParameter
 	{
 	public:
@@ -383,6 +472,7 @@ namespace mash
 			uint32 index = 0);
 
 		const int8* GetParameterName()const{return g_effectAutoNames[aEFFECT_LIGHT_WORLD_POSITION];}
+		eAUTO_PARAM_UPDATE_RATE GetUpdateRate()const{return aAUTO_PARAM_UPDATE_PER_FRAME;}
 	};
 
 	class MashParamWorldView : public MashAutoEffectParameter
@@ -427,6 +517,7 @@ namespace mash
 			uint32 index = 0);
 
 		const int8* GetParameterName()const{return g_effectAutoNames[aEFFECT_SHADOWS_ENABLED];}
+		eAUTO_PARAM_UPDATE_RATE GetUpdateRate()const{return aAUTO_PARAM_UPDATE_PER_FRAME;}
 	};
 
 	class MashParamGUIAlphaMaskThreshold : public MashAutoEffectParameter
@@ -444,6 +535,7 @@ namespace mash
 
 		void SetValue(f32 f){m_threshold = f;}
 		const int8* GetParameterName()const{return g_additionalEffectAutoNames[aADDITIONAL_EFFECT_GUI_ALPHAMASK_THRESHOLD];}
+		eAUTO_PARAM_UPDATE_RATE GetUpdateRate()const{return aAUTO_PARAM_UPDATE_PER_MATERIAL;}
 	};
 
 	class MashParamGUIBaseColour : public MashAutoEffectParameter
@@ -461,6 +553,7 @@ namespace mash
 
 		void SetValue(const sMashColour4 &c){m_colour = c;}
 		const int8* GetParameterName()const{return g_additionalEffectAutoNames[aADDITIONAL_EFFECT_GUI_BASE_COLOUR];}
+		eAUTO_PARAM_UPDATE_RATE GetUpdateRate()const{return aAUTO_PARAM_UPDATE_PER_MATERIAL;}
 	};
 
 	class MashParamGUIFontColour : public MashAutoEffectParameter
@@ -478,6 +571,7 @@ namespace mash
 
 		void SetValue(const sMashColour4 &c){m_colour = c;}
 		const int8* GetParameterName()const{return g_additionalEffectAutoNames[aADDITIONAL_EFFECT_GUI_FONT_COLOUR];}
+		eAUTO_PARAM_UPDATE_RATE GetUpdateRate()const{return aAUTO_PARAM_UPDATE_PER_MATERIAL;}
 	};
 
 	class MashParameterParticleBuffer : public MashAutoEffectParameter
@@ -506,6 +600,7 @@ namespace mash
 			uint32 index = 0);
 
 		const int8* GetParameterName()const{return g_additionalEffectAutoNames[aADDITIONAL_EFFECT_SOFT_PARTICLE_SCALE];}
+		eAUTO_PARAM_UPDATE_RATE GetUpdateRate()const{return aAUTO_PARAM_UPDATE_PER_MATERIAL;}
 	};
 
 }
@@ -55,6 +55,36 @@
 
 #define _MASH_ABGR_COLOUR_FORMAT_
 
+/*
+	SIMD math backend. SSE is used when the compiler targets it and AVX is
+	used for some operations when available. Define MASH_NO_SIMD to force the
+	scalar implementation.
+*/
+#if !defined(MASH_NO_SIMD)
+	#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1))
+	#define MASH_SIMD_SSE
+	#endif
+
+	#if defined(MASH_SIMD_SSE) && defined(__AVX__)
+	#define MASH_SIMD_AVX
+	#endif
+#endif
+
+/*
+	Containers get move constructors when the compiler supports rvalue references.
+*/
+#if (__cplusplus >= 201103L) || (defined(_MSC_VER) && (_MSC_VER >= 1600))
+#define MASH_HAS_MOVE_SEMANTICS
+#endif
+
+/*
+	Number of characters a string can hold before it allocates memory.
+	Names in the engine are mostly under 32 characters.
+*/
+#ifndef MASH_STRING_INLINE_CAPACITY
+#define MASH_STRING_INLINE_CAPACITY 32
+#endif
+
 
 
 #endif
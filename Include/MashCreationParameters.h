@@ -42,6 +42,13 @@ namespace mash
 		
 		bool fullScreen;
 		bool enableVSync;
+
+		/*!
+			No window is created and no OS messages are processed. This is
+			intended for automated tests and benchmarks, and should be used with
+			a renderer that does not need a window, such as CreateMashNullDevice().
+		*/
+		bool headless;
 		eBACKBUFFER_FORMAT backbufferFormat;
 		eDEPTH_FORMAT depthFormat;
         
@@ -123,6 +130,7 @@ namespace mash
             virtualFileLoaderPtr(0),
 			fullScreen(false),
 			enableVSync(true),
+			headless(false),
 			screenWidth(800),
 			screenHeight(600),
             fixedTimeStep(1.0f / 30.0f),
@@ -11,6 +11,7 @@
 #include "MashEnum.h"
 #include "MashTypes.h"
 #include "MashString.h"
+#include "MashStringID.h"
 
 namespace mash
 {
@@ -131,6 +132,16 @@ namespace mash
         */
 		virtual MashEffectParamHandle* GetParameterByName(const int8 *name, ePROGRAM_TYPE type) = 0;
 
+        //! Fetches a parameter by interned name.
+		/*!
+            Same as GetParameterByName(const int8*, ePROGRAM_TYPE). Renderers that key their
+            parameters by id override this to avoid a string lookup.
+
+            \param name Name of the parameter to fetch.
+            \return The named parameter or NULL if the named parameter does not exist within this effect.
+        */
+		virtual MashEffectParamHandle* GetParameterByName(const MashStringID &name, ePROGRAM_TYPE type){return GetParameterByName(name.GetString(), type);}
+
         //! Returns true if this effect compiled ok.
         /*!
             \return True if this effect is valid. False otherise.
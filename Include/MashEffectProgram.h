@@ -12,19 +12,83 @@
 #include "MashTypes.h"
 #include "MashArray.h"
 #include "MashString.h"
+#include <cstring>
 
 namespace mash
 {
     /*!
         Parameter handles represent a parameter within an effect program. 
+
+        Handles keep a copy of the last data uploaded so that uploads of
+        unchanged data can be skipped. This is enabled by default and is
+        disabled by effects for auto parameters that change per object.
     */
 	class MashEffectParamHandle : public MashReferenceCounter
 	{
+	private:
+		uint8 *m_lastData;
+		uint32 m_lastDataSize;
+		bool m_trackChanges;
 	public:
-		MashEffectParamHandle():MashReferenceCounter(){}
-		virtual ~MashEffectParamHandle(){}
+		MashEffectParamHandle():MashReferenceCounter(), m_lastData(0), m_lastDataSize(0), m_trackChanges(true){}
+		virtual ~MashEffectParamHandle()
+		{
+			if (m_lastData)
+				MASH_FREE(m_lastData);
+		}
+
+		//! Enables or disables change tracking for this parameter.
+		void _SetChangeTracking(bool enable);
+
+		//! Returns true if uploads of unchanged data are skipped.
+		bool _GetChangeTracking()const;
+
+		//! Called by effects before uploading data.
+		/*!
+			\param data Data about to be uploaded.
+			\param sizeInBytes Data size.
+			\return True if the data needs to be uploaded. False if it matches the last upload.
+		*/
+		bool _OnDataChange(const void *data, uint32 sizeInBytes);
 	};
 
+	inline void MashEffectParamHandle::_SetChangeTracking(bool enable)
+	{
+		m_trackChanges = enable;
+		if (!m_trackChanges && m_lastData)
+		{
+			MASH_FREE(m_lastData);
+			m_lastData = 0;
+			m_lastDataSize = 0;
+		}
+	}
+
+	inline bool MashEffectParamHandle::_GetChangeTracking()const
+	{
+		return m_trackChanges;
+	}
+
+	inline bool MashEffectParamHandle::_OnDataChange(const void *data, uint32 sizeInBytes)
+	{
+		if (!m_trackChanges)
+			return true;
+
+		if (m_lastData && (m_lastDataSize == sizeInBytes) && (memcmp(m_lastData, data, sizeInBytes) == 0))
+			return false;
+
+		if (m_lastDataSize != sizeInBytes)
+		{
+			if (m_lastData)
+				MASH_FREE(m_lastData);
+
+			m_lastData = (uint8*)MASH_ALLOC_COMMON(sizeInBytes);
+			m_lastDataSize = sizeInBytes;
+		}
+
+		memcpy(m_lastData, data, sizeInBytes);
+		return true;
+	}
+
     /*!
         Effect programs are vertex, pixel, geometry, etc programs
         for the GPU. They can be created from MashEffect::AddProgram.
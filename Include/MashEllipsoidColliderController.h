@@ -27,6 +27,46 @@ namespace mash
         
         //! Gets the collision scene for this object.
 		virtual MashSceneNode* GetCollisionScene()const = 0;
+
+		//! Enables or disables the triangle cache.
+		/*!
+			When enabled (the default), candidate triangles are gathered once per move using
+			the swept bounds of the move. They are transformed into ellipsoid space once and
+			all slide iterations are run against that list. Controllers created by the scene
+			manager are also stepped together, after all node callbacks have been called.
+			See SetDeferStep().
+
+			When disabled, the collision scene is walked on each slide iteration and the
+			controller is stepped from its own node callback.
+
+			\param enable True to enable the triangle cache.
+		*/
+		virtual void SetUseTriangleCache(bool enable) = 0;
+
+		//! Returns true if the triangle cache is enabled.
+		virtual bool GetUseTriangleCache()const = 0;
+
+		//! Sets when the move is applied to the node.
+		/*!
+			Only used when the triangle cache is enabled and the controller was created
+			by the scene manager.
+
+			When enabled (the default), the controller is stepped together with all other
+			controllers once every node callback for the update has been called. Controllers
+			that share a collision scene share one walk of that scene and the collision tests
+			may be run on worker threads. Node callbacks called after this one in the same
+			update will see the node at its requested position, before collision has been
+			resolved.
+
+			When disabled, the controller is stepped from its own node callback so later
+			callbacks see the collided position, as they did before moves were batched.
+
+			\param enable True to defer the move.
+		*/
+		virtual void SetDeferStep(bool enable) = 0;
+
+		//! Returns true if the move is deferred. See SetDeferStep().
+		virtual bool GetDeferStep()const = 0;
         
 	};
 }
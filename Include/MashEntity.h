@@ -94,6 +94,27 @@ namespace mash
 		*/
 		virtual const MashArray<uint32>& GetLodDistances()const = 0;
 
+		//! Sets where a lod will start based on its size on screen.
+		/*!
+			Screen size is the radius of the entities bounds divided by the half height
+			of the view frustum at the entities distance. So 1.0 roughly fills the
+			screen vertically. A lod is used once the entity is smaller than its screen size.
+			When screen sizes are set they are used instead of lod distances.
+
+			This should be used in order from lod 0 - (n-1).
+			Lod screen size (n+1) must be less than n.
+
+			\param lod Lod to set screen size for.
+			\param screenSize Lod screen size. 0 disables screen size selection for this lod.
+		*/
+		virtual eMASH_STATUS SetLodScreenSize(uint32 lod, f32 screenSize) = 0;
+
+		//! Gets the lod screen size list.
+		/*!
+			\return lod screen size list.
+		*/
+		virtual const MashArray<f32>& GetLodScreenSizes()const = 0;
+
         //! Gets the model this Entity is based on.
         /*!
             \return Base model.
@@ -97,7 +97,8 @@ namespace mash
     {
         aDEVICE_TYPE_WINDOWS,
         aDEVICE_TYPE_APPLE,
-        aDEVICE_TYPE_LINUX
+        aDEVICE_TYPE_LINUX,
+        aDEVICE_TYPE_NULL
     };
 
 	enum eMASH_OPENGL_VERSION
@@ -234,7 +235,13 @@ namespace mash
 		aLIGHT_TYPE_VERTEX,
 		aLIGHT_TYPE_PIXEL,
 		aLIGHT_TYPE_DEFERRED,
-		aLIGHT_TYPE_LIGHT_MAP//not used
+		aLIGHT_TYPE_LIGHT_MAP,//not used
+		/*!
+			Forward rendered per pixel lighting. Each frame the scene lights are also
+			binned into a view space cluster grid (see MashLightClusterGrid) that
+			effects can read using the autoLightCluster* auto parameters.
+		*/
+		aLIGHT_TYPE_CLUSTERED
 	};	
     
     enum eLIGHT_RENDERER_TYPE
@@ -312,9 +319,27 @@ namespace mash
 		aEFFECT_WORLD_VIEW,
 		aEFFECT_WORLD_POSITION,
 		aEFFECT_SHADOWS_ENABLED,
+		aEFFECT_BONE_PALETTE_TEXTURE,
+		aEFFECT_BONE_PALETTE_INFO,
+		aEFFECT_LIGHT_CLUSTER_TEXTURE,
+		aEFFECT_LIGHT_CLUSTER_INFO,
+		aEFFECT_LIGHT_CLUSTER_GRID,
 		aEFFECT_UNDEFINED
 	};
 
+	/*!
+		How often the data of an auto parameter is expected to change.
+		Parameters that change less often than once per object have their
+		uploads skipped when the data has not changed.
+	*/
+	enum eAUTO_PARAM_UPDATE_RATE
+	{
+		aAUTO_PARAM_UPDATE_PER_FRAME,
+		aAUTO_PARAM_UPDATE_PER_VIEW,
+		aAUTO_PARAM_UPDATE_PER_MATERIAL,
+		aAUTO_PARAM_UPDATE_PER_OBJECT
+	};
+
 	static const int8 *const g_effectAutoNames[] = {
 		"autoWorldViewProjection",
 		"autoViewProjection",
@@ -342,6 +367,11 @@ namespace mash
 		"autoWorldView",
 		"autoWorldPosition",
 		"autoShadowsEnabled",
+		"autoBonePaletteTexture",
+		"autoBonePaletteInfo",
+		"autoLightClusterTexture",
+		"autoLightClusterInfo",
+		"autoLightClusterGrid",
 		0
 	};
 
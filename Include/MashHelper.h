@@ -8,11 +8,20 @@
 #define _MASH_HELPER_H_
 
 #include "MashEnum.h"
+#include <cstring>
+#include <new>
 
 namespace mash
 {
     class MashFileManager;
     struct sMashVertexElement;
+    class MashMemoryPoolSimple;
+    class MashVector2;
+    class MashVector3;
+    class MashVector4;
+    class MashQuaternion;
+    class MashMatrix4;
+    class MashAABB;
     
 	/*!
 		Convenience and conversion methods. 
@@ -271,6 +280,107 @@ namespace mash
             enum {value = 1};
         };
 
+        template<>
+        struct MashIsFundamental<f32>
+        {
+            enum {value = 1};
+        };
+
+        template<>
+        struct MashIsFundamental<f64>
+        {
+            enum {value = 1};
+        };
+
+        template<class T>
+        struct MashIsFundamental<T*>
+        {
+            enum {value = 1};
+        };
+
+    //////////////////////////////////////////////////////////////
+    //Test for types that can be moved in memory with memcpy
+    //////////////////////////////////////////////////////////////
+        /*!
+            Containers relocate these types with memcpy when growing or shifting
+            elements, rather than copy constructing then destructing each one.
+
+            A type is trivially relocatable if it holds no pointers into itself.
+            Specialise this for your own types to get the fast path.
+        */
+        template<class T>
+        struct MashIsTriviallyRelocatable
+        {
+            enum {value = MashIsFundamental<T>::value};
+        };
+
+        template<> struct MashIsTriviallyRelocatable<MashVector2>{enum {value = 1};};
+        template<> struct MashIsTriviallyRelocatable<MashVector3>{enum {value = 1};};
+        template<> struct MashIsTriviallyRelocatable<MashVector4>{enum {value = 1};};
+        template<> struct MashIsTriviallyRelocatable<MashQuaternion>{enum {value = 1};};
+        template<> struct MashIsTriviallyRelocatable<MashMatrix4>{enum {value = 1};};
+        template<> struct MashIsTriviallyRelocatable<MashAABB>{enum {value = 1};};
+
+        /*!
+            Allocators that hold no state can free memory allocated by another
+            instance. Containers using them can swap buffers instead of copying.
+        */
+        template<class TAlloc>
+        struct MashIsAllocatorStateless
+        {
+            enum {value = 0};
+        };
+
+        template<>
+        struct MashIsAllocatorStateless<MashMemoryPoolSimple>
+        {
+            enum {value = 1};
+        };
+
+        //! Moves one element to uninitialised memory and destructs the source.
+        /*!
+            Specialise this for types that can be moved more cheaply than a copy.
+        */
+        template<class T>
+        struct MashRelocateElement
+        {
+            static void Relocate(T *dst, T *src)
+            {
+#ifdef MASH_HAS_MOVE_SEMANTICS
+                new ((void*)dst) T(static_cast<T&&>(*src));
+#else
+                new ((void*)dst) T(*src);
+#endif
+                src->~T();
+            }
+        };
+
+        //! Moves elements to uninitialised memory and destructs the source elements.
+        /*!
+            The source and destination may overlap.
+        */
+        template<class T>
+        void MashRelocate(T *dst, T *src, uint32 count)
+        {
+            if ((count == 0) || (dst == src))
+                return;
+
+            if (MashIsTriviallyRelocatable<T>::value)
+            {
+                memmove((void*)dst, (const void*)src, sizeof(T) * count);
+            }
+            else if (dst < src)
+            {
+                for(uint32 i = 0; i < count; ++i)
+                    MashRelocateElement<T>::Relocate(&dst[i], &src[i]);
+            }
+            else
+            {
+                for(uint32 i = count; i > 0; --i)
+                    MashRelocateElement<T>::Relocate(&dst[i-1], &src[i-1]);
+            }
+        }
+
     //////////////////////////////////////////////////////////////
     //Test specific data types
     //////////////////////////////////////////////////////////////
@@ -32,6 +32,9 @@
 #include "MashVideo.h"
 #include "MashTypes.h"
 #include "MashSkin.h"
+#include "MashSkinPaletteBuffer.h"
+#include "MashLightClusterGrid.h"
+#include "MashLightInfluenceIndex.h"
 #include "MashMaterialManager.h"
 #include "MashControllerManager.h"
 #include "MashCullTechnique.h"
@@ -55,6 +58,7 @@
 #include "MashGeometryBatch.h"
 #include "MashIndexBuffer.h"
 #include "MashVertexBuffer.h"
+#include "MashTransientVertexBuffer.h"
 #include "MashTriangleBuffer.h"
 #include "MashTriangleCollider.h"
 #include "MashMeshBuilder.h"
@@ -79,6 +83,10 @@
 #include "MashString.h"
 #include "MashStringHelper.h"
 #include "MashGenericArray.h"
+#include "MashJob.h"
+#include "MashMathKernels.h"
+#include "MashStringIDMap.h"
+#include "MashTextParser.h"
 
 #include "MashEllipsoidColliderController.h"
 #include "MashFreeMovementController.h"
@@ -11,6 +11,7 @@
 #include "MashReferenceCounter.h"
 #include "MashArray.h"
 #include "MashString.h"
+#include "MashStringID.h"
 
 namespace mash
 {
@@ -239,6 +240,16 @@ namespace mash
         */
 		virtual eMASH_STATUS SetCurrentPlayerContext(uint32 playerID, const MashStringc &context) = 0;
 
+		//! Sets the active context for a player by interned name.
+		/*!
+			Same as SetCurrentPlayerContext(uint32, const MashStringc&) but avoids a string lookup.
+
+			\param playerID Player ID created with CreatePlayer().
+			\param context New active context.
+			\return Function status.
+		*/
+		virtual eMASH_STATUS SetCurrentPlayerContext(uint32 playerID, const MashStringID &context) = 0;
+
 		//! Adds a context change callback. Called when the selected context is left.
 		/*!
 			Changing context can cause, for example, release key events to go missing
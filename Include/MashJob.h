@@ -0,0 +1,63 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+
+#ifndef _MASH_JOB_H_
+#define _MASH_JOB_H_
+
+#include "MashCompileSettings.h"
+#include "MashDataTypes.h"
+#include "MashMemoryObject.h"
+
+namespace mash
+{
+	//! A unit of work that can be run on a worker thread.
+	/*!
+		Jobs must not call into the renderer, scene manager or file manager
+		as these are not thread safe. Load any data a job needs beforehand and
+		consume its results once RunJobs() returns.
+	*/
+	class MashJob : public MashMemoryObject
+	{
+	public:
+		MashJob():MashMemoryObject(){}
+		virtual ~MashJob(){}
+
+		//! Called from a worker thread.
+		virtual void Run() = 0;
+	};
+
+	namespace jobs
+	{
+		//! Returns the number of hardware threads available.
+		_MASH_EXPORT uint32 GetHardwareThreadCount();
+
+		//! Runs a list of jobs across worker threads.
+		/*!
+			The calling thread also runs jobs. This function blocks until all
+			jobs have completed. Jobs are run in no particular order.
+
+			Worker threads are started on first use and kept for later calls,
+			so this is cheap enough to call every frame. If the workers are
+			already in use, for example when called from within a job, the jobs
+			are run on the calling thread.
+
+			\param jobs Jobs to run.
+			\param jobCount Number of jobs.
+			\param maxThreads Maximum number of threads to use, including the calling thread.
+				0 will use GetHardwareThreadCount().
+		*/
+		_MASH_EXPORT void RunJobs(MashJob **jobs, uint32 jobCount, uint32 maxThreads = 0);
+
+		//! Stops the worker threads started by RunJobs().
+		/*!
+			This is called by the device when it is destroyed. Workers are started
+			again if RunJobs() is called afterwards.
+		*/
+		_MASH_EXPORT void ReleaseWorkerThreads();
+	}
+}
+
+#endif
@@ -0,0 +1,207 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+
+#ifndef _MASH_LIGHT_CLUSTER_GRID_H_
+#define _MASH_LIGHT_CLUSTER_GRID_H_
+
+#include "MashCompileSettings.h"
+#include "MashDataTypes.h"
+#include "MashEnum.h"
+#include "MashVector3.h"
+#include "MashArray.h"
+
+namespace mash
+{
+	class MashLight;
+	class MashAABB;
+
+    /*!
+        Bins lights into a view space grid of clusters (froxels) so each pixel
+        only needs to light itself with the lights touching its cluster.
+
+        The view frustum is divided into tiles in x and y. Depth is divided into
+        slices that grow exponentially from the near plane to the far plane. Slice
+        k covers view depths near * (far / near)^(k / slices) to
+        near * (far / near)^((k + 1) / slices).
+
+        After Build() each cluster holds an offset and count into a single array
+        of light indices. The indices refer to the lights passed to Build(). Point
+        lights are tested as spheres, spot lights as cones and directional lights
+        are added to every cluster.
+
+        Cluster bounds are only rebuilt when the grid or projection changes.
+        Memory is kept between builds so binning a stable scene doesn't allocate.
+
+        The scene manager uses this for the aLIGHT_TYPE_CLUSTERED lighting mode.
+        It can also be used directly, for example by custom culling code.
+    */
+	class _MASH_EXPORT MashLightClusterGrid
+	{
+	public:
+		//! Light in view space.
+		struct sLightVolume
+		{
+			eLIGHTTYPE type;
+			//! View space position. Not used by directional lights.
+			MashVector3 position;
+			//! Point and spot light range.
+			f32 range;
+			//! Normalized view space direction. Only used by spot lights.
+			MashVector3 direction;
+			//! Cosine of half the outer cone angle. Only used by spot lights.
+			f32 cosOuterCone;
+		};
+
+		//! Lights affecting a cluster.
+		struct sCluster
+		{
+			//! First element in GetLightIndices().
+			uint32 offset;
+			//! Number of lights.
+			uint32 count;
+		};
+
+		//! Default grid size.
+		enum
+		{
+			aDEFAULT_TILES_X = 16,
+			aDEFAULT_TILES_Y = 9,
+			aDEFAULT_SLICES = 24
+		};
+	private:
+		struct sLightClusterPair
+		{
+			uint32 cluster;
+			uint32 light;
+		};
+
+		class CBinJob;
+
+		uint32 m_tilesX;
+		uint32 m_tilesY;
+		uint32 m_slices;
+		f32 m_fovY;
+		f32 m_aspect;
+		f32 m_near;
+		f32 m_far;
+		f32 m_tanHalfFovX;
+		f32 m_tanHalfFovY;
+		f32 m_logFarOverNear;
+		bool m_boundsDirty;
+		uint32 m_maxThreads;
+
+		//cluster bounds stored as separate arrays so 4 clusters can be tested at once
+		MashArray<f32> m_boundsMinX;
+		MashArray<f32> m_boundsMinY;
+		MashArray<f32> m_boundsMinZ;
+		MashArray<f32> m_boundsMaxX;
+		MashArray<f32> m_boundsMaxY;
+		MashArray<f32> m_boundsMaxZ;
+		//depth at the start of each slice plus the far plane
+		MashArray<f32> m_sliceDepths;
+
+		MashArray<sCluster> m_clusters;
+		MashArray<uint32> m_lightIndices;
+		MashArray<sLightVolume> m_lightVolumes;
+		MashArray<MashArray<sLightClusterPair> > m_pairs;
+		MashArray<uint32> m_directionalLights;
+
+		void _RebuildBounds();
+		uint32 _GetSlice(f32 viewDepth)const;
+		void _BinLights(const sLightVolume *lights, uint32 first, uint32 last, MashArray<sLightClusterPair> &pairsOut)const;
+		void _BinLight(const sLightVolume &light, uint32 lightIndex, MashArray<sLightClusterPair> &pairsOut)const;
+	public:
+		MashLightClusterGrid();
+		~MashLightClusterGrid();
+
+		//! Sets the number of clusters.
+		/*!
+			\param tilesX Number of tiles across the screen.
+			\param tilesY Number of tiles down the screen.
+			\param slices Number of depth slices.
+		*/
+		void SetGridSize(uint32 tilesX, uint32 tilesY, uint32 slices);
+
+		//! Sets the perspective projection the grid covers.
+		/*!
+			\param fovY Vertical field of view in radians.
+			\param aspect Width / height.
+			\param zNear Near plane.
+			\param zFar Far plane.
+		*/
+		void SetProjection(f32 fovY, f32 aspect, f32 zNear, f32 zFar);
+
+		//! Maximum number of threads used to bin lights.
+		/*!
+			Large light counts are split across threads using jobs::RunJobs().
+			Set to 1 to always bin on the calling thread. 0 uses all hardware threads.
+		*/
+		void SetMaxThreads(uint32 maxThreads);
+
+		//! Bins lights into the grid.
+		/*!
+			\param lights Lights in view space.
+			\param count Number of lights.
+		*/
+		void Build(const sLightVolume *lights, uint32 count);
+
+		//! Bins scene lights into the grid.
+		/*!
+			The lights view space data must be up to date, this is true for lights that
+			passed the current cull pass. Disabled lights are added to no clusters.
+
+			\param lights Lights to bin. Indices in GetLightIndices() refer to this array.
+			\param count Number of lights.
+		*/
+		void Build(MashLight *const *lights, uint32 count);
+
+		//! Returns the cluster a view space position falls in.
+		/*!
+			\return Cluster index. -1 if the position is outside the view frustum.
+		*/
+		int32 GetClusterIndex(const MashVector3 &viewPosition)const;
+
+		//! Returns the cluster index for a tile and slice.
+		uint32 GetClusterIndex(uint32 tileX, uint32 tileY, uint32 slice)const{return (slice * m_tilesY + tileY) * m_tilesX + tileX;}
+
+		//! Returns the view space bounds of a cluster.
+		void GetClusterBounds(uint32 cluster, MashAABB &boundsOut)const;
+
+		//! Gathers the lights touching a tile within a depth range.
+		/*!
+			Merges the light lists of all clusters in the tile between minDepth and
+			maxDepth. Each light is returned once, in ascending order.
+
+			\param tileX Tile column.
+			\param tileY Tile row. Row 0 is the bottom of the screen.
+			\param minDepth Nearest view depth in the tile.
+			\param maxDepth Furthest view depth in the tile.
+			\param lightsOut Indices of lights passed to Build(). Cleared before filling.
+			\return Number of lights found.
+		*/
+		uint32 GetTileLights(uint32 tileX, uint32 tileY, f32 minDepth, f32 maxDepth, MashArray<uint32> &lightsOut)const;
+
+		//! Lights affecting each cluster. GetClusterCount() elements.
+		const sCluster* GetClusters()const{return m_clusters.Pointer();}
+
+		//! Light indices referenced by GetClusters().
+		const uint32* GetLightIndices()const{return m_lightIndices.Pointer();}
+
+		//! Number of elements in GetLightIndices().
+		uint32 GetLightIndexCount()const{return m_lightIndices.Size();}
+
+		//! Number of clusters.
+		uint32 GetClusterCount()const{return m_tilesX * m_tilesY * m_slices;}
+
+		uint32 GetTilesX()const{return m_tilesX;}
+		uint32 GetTilesY()const{return m_tilesY;}
+		uint32 GetSlices()const{return m_slices;}
+		f32 GetNear()const{return m_near;}
+		f32 GetFar()const{return m_far;}
+	};
+}
+
+#endif
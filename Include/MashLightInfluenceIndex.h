@@ -0,0 +1,122 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+
+#ifndef _MASH_LIGHT_INFLUENCE_INDEX_H_
+#define _MASH_LIGHT_INFLUENCE_INDEX_H_
+
+#include "MashCompileSettings.h"
+#include "MashDataTypes.h"
+#include "MashVector3.h"
+#include "MashArray.h"
+
+namespace mash
+{
+	class MashAABB;
+
+    /*!
+        Spatial hash of point and spot light bounds in world space. Used to find the
+        lights that reach an object so forward rendered objects are only lit by the
+        lights that affect them.
+
+        Space is divided into cubes of GetCellSize(). Each light is stored in every
+        cell its range touches. Lights are only rehashed when they move into a
+        different set of cells, so lights that are still or move a little cost
+        almost nothing to update.
+
+        Lights covering a very large number of cells are kept in a separate list
+        that is checked for every query.
+
+        Spot lights are treated as point lights. Directional lights affect everything
+        and should not be added.
+    */
+	class _MASH_EXPORT MashLightInfluenceIndex
+	{
+	private:
+		enum
+		{
+			aBUCKET_COUNT = 1024,
+			//lights touching more cells than this are not hashed
+			aMAX_LIGHT_CELLS = 64
+		};
+
+		struct sLightRecord
+		{
+			MashVector3 position;
+			f32 range;
+			MashVector3 attenuation;
+			f32 intensity;
+			int32 cellMin[3];
+			int32 cellMax[3];
+			uint32 queryStamp;
+			bool active;
+			bool oversized;
+		};
+
+		f32 m_cellSize;
+		f32 m_invCellSize;
+		uint32 m_activeLightCount;
+		uint32 m_rehashCount;
+		uint32 m_queryStamp;
+		MashArray<sLightRecord> m_lights;
+		MashArray<MashArray<uint32> > m_buckets;
+		MashArray<uint32> m_oversizedLights;
+
+		uint32 _GetBucket(int32 x, int32 y, int32 z)const;
+		void _GetCells(const MashVector3 &boundsMin, const MashVector3 &boundsMax, int32 *cellMinOut, int32 *cellMaxOut)const;
+		void _Insert(uint32 id);
+		void _Remove(uint32 id);
+		void _AddCandidate(uint32 id, const MashAABB &bounds, uint32 maxLights, uint32 *lightsOut, f32 *scores, uint32 &countOut);
+	public:
+		//! Constructor.
+		/*!
+			\param cellSize Width of each cell in world units. This should be around
+				the size of the average light range.
+		*/
+		MashLightInfluenceIndex(f32 cellSize = 16.0f);
+		~MashLightInfluenceIndex();
+
+		//! Sets the cell size. All lights are rehashed.
+		void SetCellSize(f32 cellSize);
+
+		//! Adds or updates a light.
+		/*!
+			\param id User id for the light. Ids should be kept small, such as an index into a light list.
+			\param position World space position.
+			\param range Light range.
+			\param attenuation Attenuation factors as stored in sMashLight::atten.
+			\param intensity Brightness used to rank lights, for example the largest diffuse channel.
+		*/
+		void SetLight(uint32 id, const MashVector3 &position, f32 range, const MashVector3 &attenuation, f32 intensity);
+
+		//! Removes a light.
+		void RemoveLight(uint32 id);
+
+		//! Removes all lights.
+		void Clear();
+
+		//! Finds the most significant lights reaching a bounding box.
+		/*!
+			Lights are ranked by their intensity multiplied by their attenuation at the
+			closest point on the box. Lights that don't reach the box are ignored.
+
+			\param bounds World space bounds.
+			\param maxLights Size of lightsOut.
+			\param lightsOut Light ids, most significant first.
+			\return Number of lights written to lightsOut.
+		*/
+		uint32 GetInfluences(const MashAABB &bounds, uint32 maxLights, uint32 *lightsOut);
+
+		//! Number of lights added.
+		uint32 GetLightCount()const{return m_activeLightCount;}
+
+		//! Number of times lights have been rehashed since creation.
+		uint32 GetRehashCount()const{return m_rehashCount;}
+
+		f32 GetCellSize()const{return m_cellSize;}
+	};
+}
+
+#endif
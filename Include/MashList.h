@@ -10,6 +10,7 @@
 #include "MashDataTypes.h"
 #include "MashMemory.h"
 #include "MashMemoryPoolSimple.h"
+#include "MashMemoryPoolBlock.h"
 #include "MashAlgorithms.h"
 #include "MashHelper.h"
 
@@ -17,8 +18,11 @@ namespace mash
 {
     /*!
         Templated doubly linked list.
+
+        By default nodes are taken from blocks owned by each list rather than
+        being allocated individually.
     */
-	template<class T, class TAlloc = MashMemoryPoolSimple, bool TSaveErasedNodes = false>
+	template<class T, class TAlloc = MashMemoryPoolBlock, bool TSaveErasedNodes = false>
 	class MashList
 	{
 	public:
@@ -343,6 +347,79 @@ namespace mash
 			DeleteData();
 		}
 
+#ifdef MASH_HAS_MOVE_SEMANTICS
+        //! Move constructor.
+        /*!
+            Takes the nodes of other. other is left empty.
+        */
+		MashList(MashList<T, TAlloc, TSaveErasedNodes> &&other):m_memoryPool(other.m_memoryPool),
+			m_listStart(0), m_freeList(0),m_currentNodeCount(0)
+		{
+			m_listStart = &m_end;
+			Swap(other);
+		}
+
+        //! Move assignment.
+		MashList<T, TAlloc, TSaveErasedNodes>& operator=(MashList<T, TAlloc, TSaveErasedNodes> &&other)
+		{
+			if (&other != this)
+			{
+				DeleteData();
+				Swap(other);
+			}
+
+			return *this;
+		}
+#endif
+
+        //! Exchanges the contents of two lists.
+        /*!
+            Nodes and allocators are exchanged, no elements are copied.
+            Iterators remain valid but will belong to the other list.
+        */
+		void Swap(MashList<T, TAlloc, TSaveErasedNodes> &other)
+		{
+			if (&other == this)
+				return;
+
+			sItem *first = (m_listStart != &m_end) ? m_listStart : 0;
+			sItem *last = m_end.previous;
+			sItem *freeList = m_freeList;
+			uint32 nodeCount = m_currentNodeCount;
+
+			if (other.m_listStart != &other.m_end)
+			{
+				m_listStart = other.m_listStart;
+				m_end.previous = other.m_end.previous;
+				m_end.previous->next = &m_end;
+			}
+			else
+			{
+				m_listStart = &m_end;
+				m_end.previous = 0;
+			}
+
+			m_freeList = other.m_freeList;
+			m_currentNodeCount = other.m_currentNodeCount;
+
+			if (first)
+			{
+				other.m_listStart = first;
+				other.m_end.previous = last;
+				last->next = &other.m_end;
+			}
+			else
+			{
+				other.m_listStart = &other.m_end;
+				other.m_end.previous = 0;
+			}
+
+			other.m_freeList = freeList;
+			other.m_currentNodeCount = nodeCount;
+
+			m_memoryPool.Swap(other.m_memoryPool);
+		}
+
         //! Assignment operator.
 		void operator=(const MashList<T, TAlloc> &other)
 		{
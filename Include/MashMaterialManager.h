@@ -23,6 +23,7 @@ namespace mash
 	class MashEffectParamHandle;
 	class MashEffect;
 	class MashAutoEffectParameter;
+	class MashStringID;
 
     /*!
         Handles material and GPU data. This can be accessed from MashVideo::GetMaterialManager().
@@ -57,6 +58,9 @@ namespace mash
 			aSTANDARD_MATERIAL_GBUFFER_POINT_LIGHT,
 			aSTANDARD_MATERIAL_GBUFFER_COMBINE,
 			aSTANDARD_MATERIAL_GBUFFER_CLEAR,
+			aSTANDARD_MATERIAL_GBUFFER_TILED_DIR_LIGHT,
+			aSTANDARD_MATERIAL_GBUFFER_TILED_SPOT_LIGHT,
+			aSTANDARD_MATERIAL_GBUFFER_TILED_POINT_LIGHT,
 			aSTANDARD_MATERIAL_COUNT
 		};
 	public:
@@ -90,6 +94,16 @@ namespace mash
         */
 		virtual MashAutoEffectParameter* GetAutoParameterByName(const int8 *name)const = 0;
 
+        //! Returns how often an auto parameter is expected to change.
+        /*!
+            Effects use this to decide which parameters have their uploads
+            skipped when the data has not changed.
+
+            \param autoParamHandlerIndex Handle returned from IsAutoParameter().
+            \return Update rate of the parameter.
+        */
+		virtual eAUTO_PARAM_UPDATE_RATE GetAutoParameterUpdateRate(uint32 autoParamHandlerIndex)const = 0;
+
         //! Gets a built in material.
         /*!
             This loads the material if it has not already been loaded. The returned pointer must
@@ -129,6 +143,15 @@ namespace mash
             \return NULL if a material with the given name was not found.
         */
         virtual MashMaterial* FindMaterial(const int8 *name)const = 0;
+
+        //! Finds a material by interned name.
+        /*!
+            Same as FindMaterial(const int8*) but avoids a string lookup.
+
+            \param name Material to search for.
+            \return NULL if a material with the given name was not found.
+        */
+        virtual MashMaterial* FindMaterial(const MashStringID &name)const = 0;
         
         //! Gets a material from the manager.
         /*!
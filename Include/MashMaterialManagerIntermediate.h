@@ -8,6 +8,7 @@
 #define _MASH_MATERIAL_MANAGER_INTERMEDIATE_H_
 
 #include "MashMaterialManager.h"
+#include "MashStringIDMap.h"
 
 namespace mash
 {
@@ -24,6 +25,7 @@ namespace mash
 		MashVideo *m_renderer;
 	private:
 		MashList<MashMaterial*> m_materials;
+		MashStringIDMap<MashMaterial*> m_materialsByName;
 		MashMaterialBuilder *m_materialBuilder;
 		
 		uint32 m_materialNameCounter;
@@ -42,6 +44,7 @@ namespace mash
 		void RegisterAutoParameterHandler(MashAutoEffectParameter *autoParamHandler, bool overWrite = false);
 		bool IsAutoParameter(const int8 *simpleName, uint32 &autoParamHandlerIndex)const;
 		MashAutoEffectParameter* GetAutoParameterByName(const int8 *simpleName)const;
+		eAUTO_PARAM_UPDATE_RATE GetAutoParameterUpdateRate(uint32 autoParamHandlerIndex)const;
 
 		const MashList<MashMaterial*>& GetMaterialList()const;
 
@@ -64,6 +67,7 @@ namespace mash
 		MashMaterial* AddMaterial(const int8 *name, const sMashVertexElement *vertexElements, uint32 elementCount);
 
 		MashMaterial* FindMaterial(const int8 *name)const;
+		MashMaterial* FindMaterial(const MashStringID &name)const;
 
 		void RemoveAllMaterials();
 		void RemoveMaterial(MashMaterial *material);
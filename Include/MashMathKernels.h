@@ -0,0 +1,113 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+
+#ifndef _MASH_MATH_KERNELS_H_
+#define _MASH_MATH_KERNELS_H_
+
+#include "MashCompileSettings.h"
+#include "MashDataTypes.h"
+
+namespace mash
+{
+	class MashMatrix4;
+	class MashQuaternion;
+	class MashTransformState;
+	class MashAABB;
+
+    /*!
+        Batch math operations over arrays of elements.
+
+        These are much faster than calling the member functions of each element in
+        a loop. Vector functions take a stride in bytes so they can work directly on
+        interleaved vertex data. The stride must be at least the size of the element.
+
+        The best implementation for the current CPU is selected the first time any
+        kernel is called. SSE is used if enabled in MashCompileSettings.h, and AVX is
+        used for some kernels if the CPU supports it.
+    */
+	namespace kernels
+	{
+		//! Transforms 3D points by a matrix (w = 1).
+		/*!
+			Input and output may be the same buffer if both strides are equal.
+
+			\param matrix Transformation matrix.
+			\param points First point. Each point is 3 floats.
+			\param pointStride Bytes between each input point.
+			\param pointsOut First output point.
+			\param pointOutStride Bytes between each output point.
+			\param count Number of points.
+		*/
+		_MASH_EXPORT void TransformPoints(const MashMatrix4 &matrix, const void *points, uint32 pointStride, void *pointsOut, uint32 pointOutStride, uint32 count);
+
+		//! Transforms 3D points by a transform state.
+		/*!
+			Same as calling MashTransformState::Transform() on each point.
+			See TransformPoints() for details.
+		*/
+		_MASH_EXPORT void TransformPoints(const MashTransformState &state, const void *points, uint32 pointStride, void *pointsOut, uint32 pointOutStride, uint32 count);
+
+		//! Transforms 3D vectors by the rotation and scale portion of a matrix (w = 0).
+		/*!
+			See TransformPoints() for details.
+		*/
+		_MASH_EXPORT void TransformVectors(const MashMatrix4 &matrix, const void *vectors, uint32 vectorStride, void *vectorsOut, uint32 vectorOutStride, uint32 count);
+
+		//! Normalizes 3D vectors in place.
+		/*!
+			Zero length vectors are left unchanged.
+
+			\param vectors First vector. Each vector is 3 floats.
+			\param vectorStride Bytes between each vector.
+			\param count Number of vectors.
+		*/
+		_MASH_EXPORT void NormalizeVectors(void *vectors, uint32 vectorStride, uint32 count);
+
+		//! Computes the bounds of a stream of 3D points.
+		/*!
+			\param points First point. Each point is 3 floats.
+			\param pointStride Bytes between each point.
+			\param count Number of points.
+			\param boundsOut Bounds of all points. Set to an invalid box if count is zero.
+		*/
+		_MASH_EXPORT void ComputeBounds(const void *points, uint32 pointStride, uint32 count, MashAABB &boundsOut);
+
+		//! Merges many boxes into one.
+		/*!
+			\param boxes Boxes to merge.
+			\param count Number of boxes.
+			\param boundsInOut Boxes are merged into this. Initialize it to an empty MashAABB
+				to get the bounds of the boxes only.
+		*/
+		_MASH_EXPORT void MergeAABBs(const MashAABB *boxes, uint32 count, MashAABB &boundsInOut);
+
+		//! Multiplies pairs of matrices.
+		/*!
+			out[i] = a[i] * b[i]. out may be the same array as a or b.
+
+			\param a First matrices.
+			\param b Second matrices.
+			\param out Results.
+			\param count Number of pairs.
+		*/
+		_MASH_EXPORT void MultiplyMatrices(const MashMatrix4 *a, const MashMatrix4 *b, MashMatrix4 *out, uint32 count);
+
+		//! Normalizes quaternions in place.
+		/*!
+			Same as calling MashQuaternion::Normalize() on each element.
+			Zero length quaternions are set to the identity.
+
+			\param quaternions Quaternions to normalize.
+			\param count Number of quaternions.
+		*/
+		_MASH_EXPORT void NormalizeQuaternions(MashQuaternion *quaternions, uint32 count);
+
+		//! Returns the name of the implementation selected for this CPU. For logging.
+		_MASH_EXPORT const int8* GetKernelBackendName();
+	}
+}
+
+#endif
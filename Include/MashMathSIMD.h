@@ -0,0 +1,695 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+
+#ifndef _MASH_MATH_SIMD_H_
+#define _MASH_MATH_SIMD_H_
+
+#include "MashCompileSettings.h"
+#include "MashDataTypes.h"
+#include <math.h>
+
+#ifdef MASH_SIMD_SSE
+#include <xmmintrin.h>
+#endif
+
+#ifdef MASH_SIMD_AVX
+#include <immintrin.h>
+#endif
+
+namespace mash
+{
+    /*!
+        Kernels used by the core math types for their hot operations.
+
+        The backend is selected at compile time in MashCompileSettings.h. Each kernel
+        also has a Scalar version that is always available. These are used when SIMD
+        is disabled and can be used to validate or benchmark the SIMD path.
+
+        Matrices are 16 floats stored as row vectors (see MashMatrix4). Quaternions are
+        4 floats stored as x, y, z, w. No alignment is required.
+    */
+	namespace simd
+	{
+		//! out = a * b. out must not point to a or b.
+		inline void MatrixMultiplyScalar(const f32 *a, const f32 *b, f32 *out)
+		{
+			for(uint32 r = 0; r < 4; ++r)
+			{
+				const f32 *row = &a[r * 4];
+				out[r * 4 + 0] = row[0]*b[0] + row[1]*b[4] + row[2]*b[8] + row[3]*b[12];
+				out[r * 4 + 1] = row[0]*b[1] + row[1]*b[5] + row[2]*b[9] + row[3]*b[13];
+				out[r * 4 + 2] = row[0]*b[2] + row[1]*b[6] + row[2]*b[10] + row[3]*b[14];
+				out[r * 4 + 3] = row[0]*b[3] + row[1]*b[7] + row[2]*b[11] + row[3]*b[15];
+			}
+		}
+
+		//! out = a * b. out may point to a or b.
+		inline void MatrixMultiply(const f32 *a, const f32 *b, f32 *out)
+		{
+#if defined(MASH_SIMD_AVX)
+			//two rows of a at a time. Each 128 bit lane holds one row.
+			const __m256 b0 = _mm256_broadcast_ps((const __m128*)&b[0]);
+			const __m256 b1 = _mm256_broadcast_ps((const __m128*)&b[4]);
+			const __m256 b2 = _mm256_broadcast_ps((const __m128*)&b[8]);
+			const __m256 b3 = _mm256_broadcast_ps((const __m128*)&b[12]);
+			const __m256 a01 = _mm256_loadu_ps(&a[0]);
+			const __m256 a23 = _mm256_loadu_ps(&a[8]);
+
+			__m256 r01 = _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0x00), b0);
+			r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0x55), b1));
+			r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0xAA), b2));
+			r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0xFF), b3));
+
+			__m256 r23 = _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0x00), b0);
+			r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0x55), b1));
+			r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0xAA), b2));
+			r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0xFF), b3));
+
+			_mm256_storeu_ps(&out[0], r01);
+			_mm256_storeu_ps(&out[8], r23);
+#elif defined(MASH_SIMD_SSE)
+			const __m128 b0 = _mm_loadu_ps(&b[0]);
+			const __m128 b1 = _mm_loadu_ps(&b[4]);
+			const __m128 b2 = _mm_loadu_ps(&b[8]);
+			const __m128 b3 = _mm_loadu_ps(&b[12]);
+
+			for(uint32 r = 0; r < 4; ++r)
+			{
+				const __m128 row = _mm_loadu_ps(&a[r * 4]);
+				__m128 result = _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+				result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(1, 1, 1, 1)), b1));
+				result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(2, 2, 2, 2)), b2));
+				result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(3, 3, 3, 3)), b3));
+				_mm_storeu_ps(&out[r * 4], result);
+			}
+#else
+			f32 result[16];
+			MatrixMultiplyScalar(a, b, result);
+			for(uint32 i = 0; i < 16; ++i)
+				out[i] = result[i];
+#endif
+		}
+
+		//! Inverts a general 4x4 matrix.
+		/*!
+			\param m Matrix to invert.
+			\param out Inverse. Not written if the matrix can't be inverted. May point to m.
+			\return False if the determinant is zero.
+		*/
+		inline bool MatrixInverseScalar(const f32 *m, f32 *out)
+		{
+			const f32 m11 = m[0], m12 = m[1], m13 = m[2], m14 = m[3];
+			const f32 m21 = m[4], m22 = m[5], m23 = m[6], m24 = m[7];
+			const f32 m31 = m[8], m32 = m[9], m33 = m[10], m34 = m[11];
+			const f32 m41 = m[12], m42 = m[13], m43 = m[14], m44 = m[15];
+
+			f32 det = (m11 * m22 - m12 * m21) * (m33 * m44 - m34 * m43) -
+				(m11 * m23 - m13 * m21) * (m32 * m44 - m34 * m42) +
+				(m11 * m24 - m14 * m21) * (m32 * m43 - m33 * m42) +
+				(m12 * m23 - m13 * m22) * (m31 * m44 - m34 * m41) -
+				(m12 * m24 - m14 * m22) * (m31 * m43 - m33 * m41) +
+				(m13 * m24 - m14 * m23) * (m31 * m42 - m32 * m41);
+
+			if (fabsf(det) <= 0.00000001f)
+				return false;
+
+			det = 1.0f / det;
+
+			out[0] = det * (m22 * (m33 * m44 - m34 * m43) + m23 * (m34 * m42 - m32 * m44) + m24 * (m32 * m43 - m33 * m42));
+			out[1] = det * (m32 * (m13 * m44 - m14 * m43) + m33 * (m14 * m42 - m12 * m44) + m34 * (m12 * m43 - m13 * m42));
+			out[2] = det * (m42 * (m13 * m24 - m14 * m23) + m43 * (m14 * m22 - m12 * m24) + m44 * (m12 * m23 - m13 * m22));
+			out[3] = det * (m12 * (m24 * m33 - m23 * m34) + m13 * (m22 * m34 - m24 * m32) + m14 * (m23 * m32 - m22 * m33));
+			out[4] = det * (m23 * (m31 * m44 - m34 * m41) + m24 * (m33 * m41 - m31 * m43) + m21 * (m34 * m43 - m33 * m44));
+			out[5] = det * (m33 * (m11 * m44 - m14 * m41) + m34 * (m13 * m41 - m11 * m43) + m31 * (m14 * m43 - m13 * m44));
+			out[6] = det * (m43 * (m11 * m24 - m14 * m21) + m44 * (m13 * m21 - m11 * m23) + m41 * (m14 * m23 - m13 * m24));
+			out[7] = det * (m13 * (m24 * m31 - m21 * m34) + m14 * (m21 * m33 - m23 * m31) + m11 * (m23 * m34 - m24 * m33));
+			out[8] = det * (m24 * (m31 * m42 - m32 * m41) + m21 * (m32 * m44 - m34 * m42) + m22 * (m34 * m41 - m31 * m44));
+			out[9] = det * (m34 * (m11 * m42 - m12 * m41) + m31 * (m12 * m44 - m14 * m42) + m32 * (m14 * m41 - m11 * m44));
+			out[10] = det * (m44 * (m11 * m22 - m12 * m21) + m41 * (m12 * m24 - m14 * m22) + m42 * (m14 * m21 - m11 * m24));
+			out[11] = det * (m14 * (m22 * m31 - m21 * m32) + m11 * (m24 * m32 - m22 * m34) + m12 * (m21 * m34 - m24 * m31));
+			out[12] = det * (m21 * (m33 * m42 - m32 * m43) + m22 * (m31 * m43 - m33 * m41) + m23 * (m32 * m41 - m31 * m42));
+			out[13] = det * (m31 * (m13 * m42 - m12 * m43) + m32 * (m11 * m43 - m13 * m41) + m33 * (m12 * m41 - m11 * m42));
+			out[14] = det * (m41 * (m13 * m22 - m12 * m23) + m42 * (m11 * m23 - m13 * m21) + m43 * (m12 * m21 - m11 * m22));
+			out[15] = det * (m11 * (m22 * m33 - m23 * m32) + m12 * (m23 * m31 - m21 * m33) + m13 * (m21 * m32 - m22 * m31));
+
+			return true;
+		}
+
+#ifdef MASH_SIMD_SSE
+		//2x2 row major matrices packed in one register as (m11, m12, m21, m22)
+
+		//a * b
+		inline __m128 Mat2Mul(__m128 a, __m128 b)
+		{
+			return _mm_add_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+				_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+		}
+
+		//adjugate(a) * b
+		inline __m128 Mat2AdjMul(__m128 a, __m128 b)
+		{
+			return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+				_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+		}
+
+		//a * adjugate(b)
+		inline __m128 Mat2MulAdj(__m128 a, __m128 b)
+		{
+			return _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+				_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+		}
+#endif
+
+		//! Inverts a general 4x4 matrix. See MatrixInverseScalar().
+		inline bool MatrixInverse(const f32 *m, f32 *out)
+		{
+#ifdef MASH_SIMD_SSE
+			/*
+				Blockwise inversion using 2x2 sub matrices.
+				| A B |
+				| C D |
+			*/
+			const __m128 r0 = _mm_loadu_ps(&m[0]);
+			const __m128 r1 = _mm_loadu_ps(&m[4]);
+			const __m128 r2 = _mm_loadu_ps(&m[8]);
+			const __m128 r3 = _mm_loadu_ps(&m[12]);
+
+			const __m128 A = _mm_movelh_ps(r0, r1);
+			const __m128 B = _mm_movehl_ps(r1, r0);
+			const __m128 C = _mm_movelh_ps(r2, r3);
+			const __m128 D = _mm_movehl_ps(r3, r2);
+
+			//(|A|, |B|, |C|, |D|)
+			const __m128 detSub = _mm_sub_ps(
+				_mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(3, 1, 3, 1))),
+				_mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(2, 0, 2, 0))));
+			const __m128 detA = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(0, 0, 0, 0));
+			const __m128 detB = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(1, 1, 1, 1));
+			const __m128 detC = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(2, 2, 2, 2));
+			const __m128 detD = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(3, 3, 3, 3));
+
+			const __m128 DC = Mat2AdjMul(D, C);
+			const __m128 AB = Mat2AdjMul(A, B);
+
+			__m128 X = _mm_sub_ps(_mm_mul_ps(detD, A), Mat2Mul(B, DC));
+			__m128 W = _mm_sub_ps(_mm_mul_ps(detA, D), Mat2Mul(C, AB));
+			__m128 Y = _mm_sub_ps(_mm_mul_ps(detB, C), Mat2MulAdj(D, AB));
+			__m128 Z = _mm_sub_ps(_mm_mul_ps(detC, B), Mat2MulAdj(A, DC));
+
+			//|M| = |A||D| + |B||C| - trace(AB * DC)
+			__m128 trace = _mm_mul_ps(AB, _mm_shuffle_ps(DC, DC, _MM_SHUFFLE(3, 1, 2, 0)));
+			trace = _mm_add_ps(trace, _mm_movehl_ps(trace, trace));
+			trace = _mm_add_ss(trace, _mm_shuffle_ps(trace, trace, _MM_SHUFFLE(1, 1, 1, 1)));
+
+			__m128 detM = _mm_add_ss(_mm_mul_ss(detA, detD), _mm_mul_ss(detB, detC));
+			detM = _mm_sub_ss(detM, trace);
+
+			const f32 det = _mm_cvtss_f32(detM);
+			if (fabsf(det) <= 0.00000001f)
+				return false;
+
+			const f32 invDet = 1.0f / det;
+			const __m128 invDetSigned = _mm_setr_ps(invDet, -invDet, -invDet, invDet);
+
+			X = _mm_mul_ps(X, invDetSigned);
+			Y = _mm_mul_ps(Y, invDetSigned);
+			Z = _mm_mul_ps(Z, invDetSigned);
+			W = _mm_mul_ps(W, invDetSigned);
+
+			//the adjugate shuffle is combined with the store shuffle
+			_mm_storeu_ps(&out[0], _mm_shuffle_ps(X, Y, _MM_SHUFFLE(1, 3, 1, 3)));
+			_mm_storeu_ps(&out[4], _mm_shuffle_ps(X, Y, _MM_SHUFFLE(0, 2, 0, 2)));
+			_mm_storeu_ps(&out[8], _mm_shuffle_ps(Z, W, _MM_SHUFFLE(1, 3, 1, 3)));
+			_mm_storeu_ps(&out[12], _mm_shuffle_ps(Z, W, _MM_SHUFFLE(0, 2, 0, 2)));
+
+			return true;
+#else
+			return MatrixInverseScalar(m, out);
+#endif
+		}
+
+		//! out = v * m, where v and out are 4 component vectors.
+		inline void TransformVector4Scalar(const f32 *m, const f32 *v, f32 *out)
+		{
+			const f32 x = v[0], y = v[1], z = v[2], w = v[3];
+			out[0] = m[0]*x + m[4]*y + m[8]*z + m[12]*w;
+			out[1] = m[1]*x + m[5]*y + m[9]*z + m[13]*w;
+			out[2] = m[2]*x + m[6]*y + m[10]*z + m[14]*w;
+			out[3] = m[3]*x + m[7]*y + m[11]*z + m[15]*w;
+		}
+
+		//! out = v * m, where v and out are 4 component vectors.
+		inline void TransformVector4(const f32 *m, const f32 *v, f32 *out)
+		{
+#ifdef MASH_SIMD_SSE
+			__m128 result = _mm_mul_ps(_mm_set1_ps(v[0]), _mm_loadu_ps(&m[0]));
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(v[1]), _mm_loadu_ps(&m[4])));
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(v[2]), _mm_loadu_ps(&m[8])));
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(v[3]), _mm_loadu_ps(&m[12])));
+			_mm_storeu_ps(out, result);
+#else
+			TransformVector4Scalar(m, v, out);
+#endif
+		}
+
+		//! Transforms a point (w = 1). v and out are 3 component vectors.
+		inline void TransformPointScalar(const f32 *m, const f32 *v, f32 *out)
+		{
+			const f32 x = v[0], y = v[1], z = v[2];
+			out[0] = x*m[0] + y*m[4] + z*m[8] + m[12];
+			out[1] = x*m[1] + y*m[5] + z*m[9] + m[13];
+			out[2] = x*m[2] + y*m[6] + z*m[10] + m[14];
+		}
+
+		//! Transforms a point (w = 1). v and out are 3 component vectors.
+		inline void TransformPoint(const f32 *m, const f32 *v, f32 *out)
+		{
+#ifdef MASH_SIMD_SSE
+			__m128 result = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(v[0]), _mm_loadu_ps(&m[0])), _mm_loadu_ps(&m[12]));
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(v[1]), _mm_loadu_ps(&m[4])));
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(v[2]), _mm_loadu_ps(&m[8])));
+			_mm_storel_pi((__m64*)out, result);
+			_mm_store_ss(&out[2], _mm_movehl_ps(result, result));
+#else
+			TransformPointScalar(m, v, out);
+#endif
+		}
+
+		//! Transforms an axis aligned box and returns the box that contains it.
+		/*!
+			Only the 3x3 portion and translation of the matrix are used.
+		*/
+		inline void AABBTransformScalar(const f32 *m, const f32 *boxMin, const f32 *boxMax, f32 *minOut, f32 *maxOut)
+		{
+			f32 bMin[3] = {m[12], m[13], m[14]};
+			f32 bMax[3] = {m[12], m[13], m[14]};
+
+			for(uint32 i = 0; i < 3; ++i)
+			{
+				for(uint32 j = 0; j < 3; ++j)
+				{
+					const f32 a = m[j * 4 + i] * boxMin[j];
+					const f32 b = m[j * 4 + i] * boxMax[j];
+
+					if (a < b)
+					{
+						bMin[i] += a;
+						bMax[i] += b;
+					}
+					else
+					{
+						bMin[i] += b;
+						bMax[i] += a;
+					}
+				}
+			}
+
+			for(uint32 i = 0; i < 3; ++i)
+			{
+				minOut[i] = bMin[i];
+				maxOut[i] = bMax[i];
+			}
+		}
+
+		//! See AABBTransformScalar().
+		inline void AABBTransform(const f32 *m, const f32 *boxMin, const f32 *boxMax, f32 *minOut, f32 *maxOut)
+		{
+#ifdef MASH_SIMD_SSE
+			__m128 resultMin = _mm_loadu_ps(&m[12]);
+			__m128 resultMax = resultMin;
+
+			for(uint32 j = 0; j < 3; ++j)
+			{
+				const __m128 row = _mm_loadu_ps(&m[j * 4]);
+				const __m128 a = _mm_mul_ps(row, _mm_set1_ps(boxMin[j]));
+				const __m128 b = _mm_mul_ps(row, _mm_set1_ps(boxMax[j]));
+				resultMin = _mm_add_ps(resultMin, _mm_min_ps(a, b));
+				resultMax = _mm_add_ps(resultMax, _mm_max_ps(a, b));
+			}
+
+			_mm_storel_pi((__m64*)minOut, resultMin);
+			_mm_store_ss(&minOut[2], _mm_movehl_ps(resultMin, resultMin));
+			_mm_storel_pi((__m64*)maxOut, resultMax);
+			_mm_store_ss(&maxOut[2], _mm_movehl_ps(resultMax, resultMax));
+#else
+			AABBTransformScalar(m, boxMin, boxMax, minOut, maxOut);
+#endif
+		}
+
+		//! Normalized linear interpolation between two quaternions. Takes the shortest path.
+		inline void QuaternionNlerpScalar(const f32 *a, const f32 *b, f32 t, f32 *out)
+		{
+			const f32 dot = a[0]*b[0] + a[1]*b[1] + a[2]*b[2] + a[3]*b[3];
+			const f32 scaleA = 1.0f - t;
+			const f32 scaleB = (dot < 0.0f) ? -t : t;
+
+			f32 result[4];
+			f32 lengthSq = 0.0f;
+			for(uint32 i = 0; i < 4; ++i)
+			{
+				result[i] = a[i]*scaleA + b[i]*scaleB;
+				lengthSq += result[i]*result[i];
+			}
+
+			const f32 invLength = (lengthSq > 0.0f) ? (1.0f / sqrtf(lengthSq)) : 0.0f;
+			for(uint32 i = 0; i < 4; ++i)
+				out[i] = result[i] * invLength;
+		}
+
+		//! See QuaternionNlerpScalar().
+		inline void QuaternionNlerp(const f32 *a, const f32 *b, f32 t, f32 *out)
+		{
+#ifdef MASH_SIMD_SSE
+			const __m128 qa = _mm_loadu_ps(a);
+			const __m128 qb = _mm_loadu_ps(b);
+
+			__m128 dot = _mm_mul_ps(qa, qb);
+			dot = _mm_add_ps(dot, _mm_movehl_ps(dot, dot));
+			dot = _mm_add_ss(dot, _mm_shuffle_ps(dot, dot, _MM_SHUFFLE(1, 1, 1, 1)));
+
+			const f32 scaleB = (_mm_cvtss_f32(dot) < 0.0f) ? -t : t;
+			__m128 result = _mm_add_ps(_mm_mul_ps(qa, _mm_set1_ps(1.0f - t)), _mm_mul_ps(qb, _mm_set1_ps(scaleB)));
+
+			__m128 lengthSq = _mm_mul_ps(result, result);
+			lengthSq = _mm_add_ps(lengthSq, _mm_movehl_ps(lengthSq, lengthSq));
+			lengthSq = _mm_add_ss(lengthSq, _mm_shuffle_ps(lengthSq, lengthSq, _MM_SHUFFLE(1, 1, 1, 1)));
+
+			const f32 length = _mm_cvtss_f32(_mm_sqrt_ss(lengthSq));
+			const f32 invLength = (length > 0.0f) ? (1.0f / length) : 0.0f;
+			_mm_storeu_ps(out, _mm_mul_ps(result, _mm_set1_ps(invLength)));
+#else
+			QuaternionNlerpScalar(a, b, t, out);
+#endif
+		}
+
+		/*
+			Computes the slerp weights and the second quaternion for QuaternionSlerp().
+			Single precision trig is used throughout.
+		*/
+		inline void QuaternionSlerpWeights(const f32 *a, const f32 *b, f32 t, f32 *bOut, f32 &scaleA, f32 &scaleB, f32 &signA)
+		{
+			f32 cosAngle = a[0]*b[0] + a[1]*b[1] + a[2]*b[2] + a[3]*b[3];
+
+			signA = 1.0f;
+			if (cosAngle < 0.0f)
+			{
+				signA = -1.0f;
+				cosAngle = -cosAngle;
+			}
+
+			bOut[0] = b[0];
+			bOut[1] = b[1];
+			bOut[2] = b[2];
+			bOut[3] = b[3];
+
+			if ((cosAngle + 1.0f) > 0.05f)
+			{
+				if ((1.0f - cosAngle) >= 0.05f)
+				{
+					const f32 theta = acosf(cosAngle);
+					const f32 invSinTheta = 1.0f / sinf(theta);
+					scaleA = sinf(theta * (1.0f - t)) * invSinTheta;
+					scaleB = sinf(theta * t) * invSinTheta;
+				}
+				else
+				{
+					scaleA = 1.0f - t;
+					scaleB = t;
+				}
+			}
+			else
+			{
+				//nearly opposite. Interpolate through a perpendicular quaternion.
+				bOut[0] = -a[1] * signA;
+				bOut[1] = a[0] * signA;
+				bOut[2] = -a[3] * signA;
+				bOut[3] = a[2] * signA;
+
+				const f32 pi = 3.14159265358979f;
+				scaleA = sinf(pi * (0.5f - t));
+				scaleB = sinf(pi * t);
+			}
+		}
+
+		//! Spherical linear interpolation between two quaternions. Takes the shortest path.
+		inline void QuaternionSlerpScalar(const f32 *a, const f32 *b, f32 t, f32 *out)
+		{
+			f32 bt[4];
+			f32 scaleA, scaleB, signA;
+			QuaternionSlerpWeights(a, b, t, bt, scaleA, scaleB, signA);
+
+			scaleA *= signA;
+			for(uint32 i = 0; i < 4; ++i)
+				out[i] = a[i]*scaleA + bt[i]*scaleB;
+		}
+
+		//! See QuaternionSlerpScalar().
+		inline void QuaternionSlerp(const f32 *a, const f32 *b, f32 t, f32 *out)
+		{
+#ifdef MASH_SIMD_SSE
+			f32 bt[4];
+			f32 scaleA, scaleB, signA;
+			QuaternionSlerpWeights(a, b, t, bt, scaleA, scaleB, signA);
+
+			const __m128 result = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(scaleA * signA)),
+				_mm_mul_ps(_mm_loadu_ps(bt), _mm_set1_ps(scaleB)));
+			_mm_storeu_ps(out, result);
+#else
+			QuaternionSlerpScalar(a, b, t, out);
+#endif
+		}
+
+		//! Tests one ray against 4 triangles.
+		/*!
+			Matches collision::Ray_Triangle(). Back facing triangles are rejected.
+
+			\param triangles 36 floats. Point a x[4], y[4], z[4] then point b then point c.
+				Unused lanes should be zero, degenerate triangles never hit.
+			\param origin Ray origin.
+			\param dir Ray direction.
+			\param tOut Distance along the ray for each lane. Only valid for lanes that hit.
+			\param vOut Barycentric v for each lane. u = 1 - v - w.
+			\param wOut Barycentric w for each lane.
+			\return Bit i is set if triangle i was hit.
+		*/
+		inline uint32 RayTriangle4Scalar(const f32 *triangles, const f32 *origin, const f32 *dir, f32 *tOut, f32 *vOut, f32 *wOut)
+		{
+			const f32 epsilon = 0.00001f;
+			const f32 qpx = -dir[0], qpy = -dir[1], qpz = -dir[2];
+
+			uint32 mask = 0;
+			for(uint32 i = 0; i < 4; ++i)
+			{
+				const f32 ax = triangles[i], ay = triangles[4 + i], az = triangles[8 + i];
+				const f32 abx = triangles[12 + i] - ax, aby = triangles[16 + i] - ay, abz = triangles[20 + i] - az;
+				const f32 acx = triangles[24 + i] - ax, acy = triangles[28 + i] - ay, acz = triangles[32 + i] - az;
+
+				const f32 nx = aby*acz - abz*acy;
+				const f32 ny = abz*acx - abx*acz;
+				const f32 nz = abx*acy - aby*acx;
+
+				const f32 d = qpx*nx + qpy*ny + qpz*nz;
+				if (d < epsilon)
+					continue;
+
+				const f32 apx = origin[0] - ax, apy = origin[1] - ay, apz = origin[2] - az;
+				const f32 t = apx*nx + apy*ny + apz*nz;
+				if (t < 0.0f)
+					continue;
+
+				const f32 ex = qpy*apz - qpz*apy;
+				const f32 ey = qpz*apx - qpx*apz;
+				const f32 ez = qpx*apy - qpy*apx;
+
+				const f32 v = acx*ex + acy*ey + acz*ez;
+				if ((v < 0.0f) || (v > d))
+					continue;
+
+				const f32 w = -(abx*ex + aby*ey + abz*ez);
+				if ((w < 0.0f) || ((v + w) > d))
+					continue;
+
+				const f32 ood = 1.0f / d;
+				tOut[i] = t * ood;
+				vOut[i] = v * ood;
+				wOut[i] = w * ood;
+				mask |= 1 << i;
+			}
+
+			return mask;
+		}
+
+		//! See RayTriangle4Scalar().
+		inline uint32 RayTriangle4(const f32 *triangles, const f32 *origin, const f32 *dir, f32 *tOut, f32 *vOut, f32 *wOut)
+		{
+#ifdef MASH_SIMD_SSE
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 qpx = _mm_set1_ps(-dir[0]);
+			const __m128 qpy = _mm_set1_ps(-dir[1]);
+			const __m128 qpz = _mm_set1_ps(-dir[2]);
+
+			const __m128 ax = _mm_loadu_ps(&triangles[0]);
+			const __m128 ay = _mm_loadu_ps(&triangles[4]);
+			const __m128 az = _mm_loadu_ps(&triangles[8]);
+			const __m128 abx = _mm_sub_ps(_mm_loadu_ps(&triangles[12]), ax);
+			const __m128 aby = _mm_sub_ps(_mm_loadu_ps(&triangles[16]), ay);
+			const __m128 abz = _mm_sub_ps(_mm_loadu_ps(&triangles[20]), az);
+			const __m128 acx = _mm_sub_ps(_mm_loadu_ps(&triangles[24]), ax);
+			const __m128 acy = _mm_sub_ps(_mm_loadu_ps(&triangles[28]), ay);
+			const __m128 acz = _mm_sub_ps(_mm_loadu_ps(&triangles[32]), az);
+
+			const __m128 nx = _mm_sub_ps(_mm_mul_ps(aby, acz), _mm_mul_ps(abz, acy));
+			const __m128 ny = _mm_sub_ps(_mm_mul_ps(abz, acx), _mm_mul_ps(abx, acz));
+			const __m128 nz = _mm_sub_ps(_mm_mul_ps(abx, acy), _mm_mul_ps(aby, acx));
+
+			const __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(qpx, nx), _mm_mul_ps(qpy, ny)), _mm_mul_ps(qpz, nz));
+			__m128 hit = _mm_cmpnlt_ps(d, _mm_set1_ps(0.00001f));
+			if (_mm_movemask_ps(hit) == 0)
+				return 0;
+
+			const __m128 apx = _mm_sub_ps(_mm_set1_ps(origin[0]), ax);
+			const __m128 apy = _mm_sub_ps(_mm_set1_ps(origin[1]), ay);
+			const __m128 apz = _mm_sub_ps(_mm_set1_ps(origin[2]), az);
+			const __m128 t = _mm_add_ps(_mm_add_ps(_mm_mul_ps(apx, nx), _mm_mul_ps(apy, ny)), _mm_mul_ps(apz, nz));
+			hit = _mm_and_ps(hit, _mm_cmpnlt_ps(t, zero));
+
+			const __m128 ex = _mm_sub_ps(_mm_mul_ps(qpy, apz), _mm_mul_ps(qpz, apy));
+			const __m128 ey = _mm_sub_ps(_mm_mul_ps(qpz, apx), _mm_mul_ps(qpx, apz));
+			const __m128 ez = _mm_sub_ps(_mm_mul_ps(qpx, apy), _mm_mul_ps(qpy, apx));
+
+			const __m128 v = _mm_add_ps(_mm_add_ps(_mm_mul_ps(acx, ex), _mm_mul_ps(acy, ey)), _mm_mul_ps(acz, ez));
+			hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpnlt_ps(v, zero), _mm_cmpngt_ps(v, d)));
+
+			const __m128 w = _mm_xor_ps(_mm_set1_ps(-0.0f), _mm_add_ps(_mm_add_ps(_mm_mul_ps(abx, ex), _mm_mul_ps(aby, ey)), _mm_mul_ps(abz, ez)));
+			hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpnlt_ps(w, zero), _mm_cmpngt_ps(_mm_add_ps(v, w), d)));
+
+			const uint32 mask = (uint32)_mm_movemask_ps(hit);
+			if (mask != 0)
+			{
+				const __m128 ood = _mm_div_ps(_mm_set1_ps(1.0f), d);
+				_mm_storeu_ps(tOut, _mm_mul_ps(t, ood));
+				_mm_storeu_ps(vOut, _mm_mul_ps(v, ood));
+				_mm_storeu_ps(wOut, _mm_mul_ps(w, ood));
+			}
+
+			return mask;
+#else
+			return RayTriangle4Scalar(triangles, origin, dir, tOut, vOut, wOut);
+#endif
+		}
+
+		//! Tests 4 rays against one axis aligned box.
+		/*!
+			Matches collision::Ray_AABB().
+
+			\param boxMin Box minimum.
+			\param boxMax Box maximum.
+			\param origins 12 floats. Ray origins x[4], y[4], z[4].
+			\param dirs 12 floats. Ray directions x[4], y[4], z[4].
+			\param tOut Distance to the box for each lane. Only valid for lanes that hit.
+			\return Bit i is set if ray i hit the box.
+		*/
+		inline uint32 RayAABB4Scalar(const f32 *boxMin, const f32 *boxMax, const f32 *origins, const f32 *dirs, f32 *tOut)
+		{
+			const f32 epsilon = 0.00001f;
+
+			uint32 mask = 0;
+			for(uint32 i = 0; i < 4; ++i)
+			{
+				f32 tMin = 0.0f;
+				f32 tMax = 99999999.f;
+				bool hit = true;
+				for(uint32 axis = 0; (axis < 3) && hit; ++axis)
+				{
+					const f32 o = origins[axis * 4 + i];
+					const f32 d = dirs[axis * 4 + i];
+					if (fabsf(d) < epsilon)
+					{
+						if ((o < boxMin[axis]) || (o > boxMax[axis]))
+							hit = false;
+					}
+					else
+					{
+						const f32 ood = 1.0f / d;
+						f32 t1 = (boxMin[axis] - o) * ood;
+						f32 t2 = (boxMax[axis] - o) * ood;
+						if (t1 > t2)
+						{
+							const f32 temp = t1;
+							t1 = t2;
+							t2 = temp;
+						}
+
+						if (t1 > tMin)
+							tMin = t1;
+						if (t2 < tMax)
+							tMax = t2;
+
+						if (tMin > tMax)
+							hit = false;
+					}
+				}
+
+				if (hit)
+				{
+					tOut[i] = tMin;
+					mask |= 1 << i;
+				}
+			}
+
+			return mask;
+		}
+
+		//! See RayAABB4Scalar().
+		inline uint32 RayAABB4(const f32 *boxMin, const f32 *boxMax, const f32 *origins, const f32 *dirs, f32 *tOut)
+		{
+#ifdef MASH_SIMD_SSE
+			const __m128 signMask = _mm_set1_ps(-0.0f);
+			const __m128 epsilon = _mm_set1_ps(0.00001f);
+			const __m128 one = _mm_set1_ps(1.0f);
+
+			__m128 tMin = _mm_setzero_ps();
+			__m128 tMax = _mm_set1_ps(99999999.f);
+			__m128 miss = _mm_setzero_ps();
+
+			for(uint32 axis = 0; axis < 3; ++axis)
+			{
+				const __m128 o = _mm_loadu_ps(&origins[axis * 4]);
+				const __m128 d = _mm_loadu_ps(&dirs[axis * 4]);
+				const __m128 bMin = _mm_set1_ps(boxMin[axis]);
+				const __m128 bMax = _mm_set1_ps(boxMax[axis]);
+
+				//parallel rays miss if they start outside the slab
+				const __m128 parallel = _mm_cmplt_ps(_mm_andnot_ps(signMask, d), epsilon);
+				const __m128 outside = _mm_or_ps(_mm_cmplt_ps(o, bMin), _mm_cmpgt_ps(o, bMax));
+				miss = _mm_or_ps(miss, _mm_and_ps(parallel, outside));
+
+				const __m128 ood = _mm_div_ps(one, d);
+				const __m128 t1 = _mm_mul_ps(_mm_sub_ps(bMin, o), ood);
+				const __m128 t2 = _mm_mul_ps(_mm_sub_ps(bMax, o), ood);
+
+				//only lanes that aren't parallel update the range
+				const __m128 newMin = _mm_max_ps(_mm_min_ps(t1, t2), tMin);
+				const __m128 newMax = _mm_min_ps(_mm_max_ps(t1, t2), tMax);
+				tMin = _mm_or_ps(_mm_and_ps(parallel, tMin), _mm_andnot_ps(parallel, newMin));
+				tMax = _mm_or_ps(_mm_and_ps(parallel, tMax), _mm_andnot_ps(parallel, newMax));
+
+				miss = _mm_or_ps(miss, _mm_cmpgt_ps(tMin, tMax));
+			}
+
+			const uint32 mask = (uint32)_mm_movemask_ps(miss) ^ 0xF;
+			if (mask != 0)
+				_mm_storeu_ps(tOut, tMin);
+
+			return mask;
+#else
+			return RayAABB4Scalar(boxMin, boxMax, origins, dirs, tOut);
+#endif
+		}
+	}
+}
+
+#endif
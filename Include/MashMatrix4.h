@@ -9,12 +9,13 @@
 
 #include "MashCompileSettings.h"
 #include "MashEnum.h"
+#include "MashVector2.h"
+#include "MashVector3.h"
+#include "MashVector4.h"
+#include "MashMathSIMD.h"
 
 namespace mash
 {
-	class MashVector2;
-	class MashVector3;
-	class MashVector4;
 	class MashQuaternion;
 
 	/*!
@@ -308,6 +309,51 @@ namespace mash
         */
 		eMASH_STATUS Decompose(MashVector3 &scale, MashQuaternion &rotation, MashVector3 &translation)const;
 	};
+
+	inline MashMatrix4 MashMatrix4::operator*(const MashMatrix4 &other)const
+	{
+		MashMatrix4 newMatrix(false);
+		simd::MatrixMultiply(v, other.v, newMatrix.v);
+		return newMatrix;
+	}
+
+	inline MashMatrix4& MashMatrix4::operator*=(MashMatrix4 &matrix)
+	{
+		simd::MatrixMultiply(v, matrix.v, v);
+		return (*this);
+	}
+
+	inline MashMatrix4& MashMatrix4::Invert()
+	{
+		//the matrix is left unchanged if the determinant is zero
+		simd::MatrixInverse(v, v);
+		return *this;
+	}
+
+	inline MashVector4 MashMatrix4::TransformVector(const MashVector4 &vector)const
+	{
+		MashVector4 out;
+		simd::TransformVector4(v, vector.v, out.v);
+		return out;
+	}
+
+	inline void MashMatrix4::TransformVector(const MashVector3 &vector, MashVector3 &out)const
+	{
+		simd::TransformPoint(v, vector.v, out.v);
+	}
+
+	inline MashVector2 MashMatrix4::TransformVector(const MashVector2 &vector)const
+	{
+		return MashVector2(vector.x*m11 + vector.y*m21 + m41,
+							vector.x*m12 + vector.y*m22 + m42);
+	}
+
+	inline MashVector3 MashMatrix4::TransformVector(const MashVector3 &vector)const
+	{
+		MashVector3 out;
+		simd::TransformPoint(v, vector.v, out.v);
+		return out;
+	}
 }
 
 #endif
\ No newline at end of file
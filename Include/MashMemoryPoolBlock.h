@@ -0,0 +1,279 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+
+#ifndef _MASH_MEMORY_POOL_BLOCK_H_
+#define _MASH_MEMORY_POOL_BLOCK_H_
+
+#include "MashMemory.h"
+
+namespace mash
+{
+    /*!
+        Allocator for containers that allocate many objects of the same size, such
+        as list nodes.
+
+        Objects are taken from large blocks of memory rather than allocating each one
+        from the heap. Blocks double in size as they are needed and are released
+        once all objects within them have been freed.
+
+        The size of the first allocation sets the object size for this pool. Any
+        allocation of a different size, or with a larger alignment, is taken from the
+        heap instead.
+
+        Each object is preceded by a pointer to the block that owns it so freeing
+        doesn't need to search for the block. Blocks with free objects are kept in
+        their own list so allocating doesn't search either.
+
+        Each container owns its own pool so copying a pool creates an empty pool.
+        Memory must be returned to the pool it came from.
+    */
+	class MashMemoryPoolBlock
+	{
+	private:
+		enum
+		{
+			aFIRST_BLOCK_OBJECT_COUNT = 8,
+			aMAX_BLOCK_OBJECT_COUNT = 256
+		};
+
+		struct sBlock
+		{
+			sBlock *previous;
+			sBlock *next;
+			//links blocks that have free objects
+			sBlock *previousFree;
+			sBlock *nextFree;
+			void *freeList;
+			uint32 usedCount;
+		};
+
+		sBlock *m_blocks;
+		sBlock *m_freeBlocks;
+		uint32 m_blockCount;
+		//object size including the owner header
+		uint32 m_slotSize;
+		uint32 m_nextBlockObjectCount;
+
+		static uint32 _AlignSize(uint32 size, size_t alignment)
+		{
+			return (uint32)((size + alignment - 1) & ~(alignment - 1));
+		}
+
+		static uint32 _GetHeaderSize()
+		{
+			return _AlignSize(sizeof(void*), mash::_g_globalMemoryAlignment);
+		}
+
+		/*
+			The word before each object holds its owner. This is either a block, or for
+			memory taken from the heap, the offset back to the allocation with the
+			lowest bit set. Blocks are pointer aligned so their lowest bit is never set.
+		*/
+		static size_t& _GetOwner(void *ptr)
+		{
+			return *((size_t*)ptr - 1);
+		}
+
+		static void* _AllocateFromHeap(uint32 sizeInBytes, size_t alignment)
+		{
+			const uint32 headerSize = (alignment > _GetHeaderSize()) ? (uint32)alignment : _GetHeaderSize();
+			int8 *memory = (int8*)MASH_ALLOC_ALIGN(headerSize + sizeInBytes, aMEMORY_CATEGORY_COMMON, alignment);
+			void *object = memory + headerSize;
+			_GetOwner(object) = ((size_t)headerSize << 1) | 1;
+			return object;
+		}
+
+		void _LinkFree(sBlock *block)
+		{
+			block->previousFree = 0;
+			block->nextFree = m_freeBlocks;
+			if (m_freeBlocks)
+				m_freeBlocks->previousFree = block;
+
+			m_freeBlocks = block;
+		}
+
+		void _UnlinkFree(sBlock *block)
+		{
+			if (block->previousFree)
+				block->previousFree->nextFree = block->nextFree;
+			else
+				m_freeBlocks = block->nextFree;
+
+			if (block->nextFree)
+				block->nextFree->previousFree = block->previousFree;
+		}
+
+		void _CreateBlock()
+		{
+			const uint32 blockHeaderSize = _AlignSize(sizeof(sBlock), mash::_g_globalMemoryAlignment);
+			int8 *memory = (int8*)MASH_ALLOC_ALIGN(blockHeaderSize + (m_slotSize * m_nextBlockObjectCount), aMEMORY_CATEGORY_COMMON, mash::_g_globalMemoryAlignment);
+
+			sBlock *block = (sBlock*)memory;
+			block->usedCount = 0;
+
+			//link all objects into the free list
+			int8 *object = memory + blockHeaderSize + _GetHeaderSize();
+			block->freeList = object;
+			for(uint32 i = 0; i < m_nextBlockObjectCount; ++i, object += m_slotSize)
+			{
+				_GetOwner(object) = (size_t)block;
+				*(void**)object = (i < (m_nextBlockObjectCount - 1)) ? (object + m_slotSize) : 0;
+			}
+
+			block->previous = 0;
+			block->next = m_blocks;
+			if (m_blocks)
+				m_blocks->previous = block;
+
+			m_blocks = block;
+			++m_blockCount;
+			_LinkFree(block);
+
+			if (m_nextBlockObjectCount < aMAX_BLOCK_OBJECT_COUNT)
+				m_nextBlockObjectCount *= 2;
+		}
+
+		void _FreeBlocks()
+		{
+			while(m_blocks)
+			{
+				sBlock *next = m_blocks->next;
+				MASH_FREE(m_blocks);
+				m_blocks = next;
+			}
+
+			m_freeBlocks = 0;
+			m_blockCount = 0;
+			m_nextBlockObjectCount = aFIRST_BLOCK_OBJECT_COUNT;
+		}
+	public:
+		MashMemoryPoolBlock():m_blocks(0), m_freeBlocks(0), m_blockCount(0), m_slotSize(0), m_nextBlockObjectCount(aFIRST_BLOCK_OBJECT_COUNT){}
+		MashMemoryPoolBlock(const MashMemoryPoolBlock &c):m_blocks(0), m_freeBlocks(0), m_blockCount(0), m_slotSize(0), m_nextBlockObjectCount(aFIRST_BLOCK_OBJECT_COUNT){}
+
+		~MashMemoryPoolBlock()
+		{
+			_FreeBlocks();
+		}
+
+		//! Does nothing. Memory is owned by each pool.
+		MashMemoryPoolBlock& operator=(const MashMemoryPoolBlock &c)
+		{
+			return *this;
+		}
+
+        //! Gets memory from this pool.
+		void* GetMemory(uint32 sizeInBytes, size_t alignment = mash::_g_globalMemoryAlignment)
+		{
+			if (alignment > mash::_g_globalMemoryAlignment)
+				return _AllocateFromHeap(sizeInBytes, alignment);
+
+			uint32 objectSize = _AlignSize(sizeInBytes, mash::_g_globalMemoryAlignment);
+			if (objectSize < sizeof(void*))
+				objectSize = sizeof(void*);
+
+			const uint32 slotSize = _GetHeaderSize() + objectSize;
+			if (m_slotSize == 0)
+				m_slotSize = slotSize;
+			else if (slotSize != m_slotSize)
+				return _AllocateFromHeap(sizeInBytes, mash::_g_globalMemoryAlignment);
+
+			if (!m_freeBlocks)
+				_CreateBlock();
+
+			sBlock *block = m_freeBlocks;
+			void *object = block->freeList;
+			block->freeList = *(void**)object;
+			++block->usedCount;
+
+			if (!block->freeList)
+				_UnlinkFree(block);
+
+			return object;
+		}
+
+        //! Returns memory back to the pool.
+		void FreeMemory(void *ptr)
+		{
+			if (!ptr)
+				return;
+
+			const size_t owner = _GetOwner(ptr);
+			if (owner & 1)
+			{
+				MASH_FREE((int8*)ptr - (owner >> 1));
+				return;
+			}
+
+			sBlock *block = (sBlock*)owner;
+			if (!block->freeList)
+				_LinkFree(block);
+
+			*(void**)ptr = block->freeList;
+			block->freeList = ptr;
+			--block->usedCount;
+
+			//release empty blocks, but keep one around to avoid thrashing
+			if ((block->usedCount == 0) && (m_blockCount > 1))
+			{
+				_UnlinkFree(block);
+
+				if (block->previous)
+					block->previous->next = block->next;
+				else
+					m_blocks = block->next;
+
+				if (block->next)
+					block->next->previous = block->previous;
+
+				--m_blockCount;
+				MASH_FREE(block);
+			}
+		}
+
+        //! Exchanges the memory of two pools.
+		void Swap(MashMemoryPoolBlock &other)
+		{
+			sBlock *blocks = m_blocks;
+			sBlock *freeBlocks = m_freeBlocks;
+			uint32 blockCount = m_blockCount;
+			uint32 slotSize = m_slotSize;
+			uint32 nextBlockObjectCount = m_nextBlockObjectCount;
+
+			m_blocks = other.m_blocks;
+			m_freeBlocks = other.m_freeBlocks;
+			m_blockCount = other.m_blockCount;
+			m_slotSize = other.m_slotSize;
+			m_nextBlockObjectCount = other.m_nextBlockObjectCount;
+
+			other.m_blocks = blocks;
+			other.m_freeBlocks = freeBlocks;
+			other.m_blockCount = blockCount;
+			other.m_slotSize = slotSize;
+			other.m_nextBlockObjectCount = nextBlockObjectCount;
+		}
+
+        //! Releases all blocks if no memory is in use.
+		void Clear()
+		{
+			for(sBlock *block = m_blocks; block; block = block->next)
+			{
+				if (block->usedCount > 0)
+					return;
+			}
+
+			_FreeBlocks();
+		}
+
+        //! Same as Clear().
+		void Destroy()
+		{
+			Clear();
+		}
+	};
+}
+
+#endif
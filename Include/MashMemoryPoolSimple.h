@@ -33,6 +33,9 @@ namespace mash
 			MASH_FREE(ptr);
 		}
 
+        //! Does nothing. This pool holds no state.
+		void Swap(MashMemoryPoolSimple &other){}
+
         //! Does nothing.
 		void Clear(){}
 		void Destroy(){}
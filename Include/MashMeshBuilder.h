@@ -17,6 +17,7 @@ namespace mash
 	class MashAABB;
 	class MashVertex;
 	class MashTriangleBuffer;
+	class MashModel;
 
     /*!
         Can be used to create some basic meshes or manipulate current ones.
@@ -44,7 +45,15 @@ namespace mash
 				This is useful when creating new meshes. You can just pass in an
 				empty mesh and let the update funtion fill it for you.
 			*/
-			aMESH_UPDATE_FILL_MESH = 32
+			aMESH_UPDATE_FILL_MESH = 32,
+
+			/*!
+				Reorders triangles for the post transform vertex cache, then reorders
+				triangle clusters to reduce overdraw, and finally reorders the vertices
+				into fetch order. Only triangle lists are optimised. The ACMR and ATVR
+				before and after optimisation are written to the log.
+			*/
+			aMESH_UPDATE_OPTIMISE = 64
 		};
 
 		struct sMesh
@@ -161,6 +170,64 @@ namespace mash
 			const void *vertexList,
 			uint32 vertexCount,
 			mash::MashAABB &boundingBox)const = 0;
+
+        //! Calculates vertex cache statistics for a mesh.
+        /*!
+            A FIFO cache is simulated to calculate the average cache miss ratio (ACMR),
+            the number of cache misses per triangle, and the average transformed
+            vertex ratio (ATVR), the number of cache misses per vertex. 1.0 is the best 
+            possible ATVR.
+
+            \param mesh Mesh to test. This must be a triangle list with its initialise data available.
+            \param cacheSize Size of the simulated vertex cache.
+            \param acmrOut Returned ACMR.
+            \param atvrOut Returned ATVR.
+            \return Ok on success, Failed otherwise.
+        */
+		virtual eMASH_STATUS CalculateVertexCacheStats(const MashMesh *mesh, uint32 cacheSize, f32 &acmrOut, f32 &atvrOut)const = 0;
+
+        //! Creates a lower detail version of a mesh.
+        /*!
+            Triangles are removed by collapsing edges onto neighbouring vertices in
+            order of least geometric error. Vertices are never moved so normals, texture
+            coordinates and bone weights of the remaining vertices are unchanged. Vertices
+            on uv seams, hard edges and open borders are preserved.
+
+            Only vertices still referenced by the simplified triangles are written to the
+            destination mesh. The destination mesh keeps the bounds of the source mesh.
+
+            \param destinationMesh Simplified mesh will be written here. This may not be the source mesh.
+            \param sourceMesh Mesh to simplify. This must be a triangle list with its initialise data available.
+            \param triangleRatio Target number of triangles as a ratio of the source triangle count. Between 0 and 1.
+            \param maxError Collapses that would move the surface further than this distance will not be performed.
+                The result may then contain more triangles than requested.
+            \param errorOut Optional. Returns the largest error of any collapse performed.
+            \return Ok on success, Failed otherwise.
+        */
+		virtual eMASH_STATUS SimplifyMesh(MashMesh *destinationMesh, 
+			const MashMesh *sourceMesh, 
+			f32 triangleRatio, 
+			f32 maxError = mash::math::MaxFloat(), 
+			f32 *errorOut = 0)const = 0;
+
+        //! Appends simplified lods to a model.
+        /*!
+            Each new lod is simplified from the first lod of the model. Lod n will have roughly
+            triangleRatioPerLod^n of the triangles of the first lod.
+
+            The models meshes must have their initialise data available.
+            Set the distance or screen size for each lod on the entity, MashEntity::SetLodDistance().
+
+            \param model Model to append lods to. The model should only contain one lod.
+            \param lodCount Number of lods to add.
+            \param triangleRatioPerLod Triangle ratio between each lod. Between 0 and 1.
+            \param maxError Maximum error allowed for any collapse. See SimplifyMesh().
+            \return Ok on success, Failed otherwise.
+        */
+		virtual eMASH_STATUS GenerateLods(MashModel *model, 
+			uint32 lodCount, 
+			f32 triangleRatioPerLod = 0.5f, 
+			f32 maxError = mash::math::MaxFloat())const = 0;
 	};
 }
 
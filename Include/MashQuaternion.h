@@ -9,6 +9,7 @@
 
 #include "MashCompileSettings.h"
 #include "MashDataTypes.h"
+#include "MashMathSIMD.h"
 
 namespace mash
 {
@@ -173,6 +174,19 @@ namespace mash
         */
         MashQuaternion& Lerp(const MashQuaternion &a, const MashQuaternion &b, f32 t);
 
+        //! Normalized linear interpolation.
+        /*!
+            Sets this quaternion to the normalized result of linear interpolation
+            between a and b, taking the shortest path. Much cheaper than Slerp()
+            and close enough for small angles, such as between animation keys.
+         
+            \param a Start.
+            \param b End.
+            \param t Nlerp amount.
+            \return This result.
+        */
+        MashQuaternion& Nlerp(const MashQuaternion &a, const MashQuaternion &b, f32 t);
+
 		//! Equivalent to MashQuaternion inverse for unit MashQuaternions.
 		/*!
             Perfoms the operation on this MashQuaternion.
@@ -219,5 +233,17 @@ namespace mash
         */
 		void RotateTo(const MashVector3 &from, const MashVector3 &to);
 	};
+
+	inline MashQuaternion& MashQuaternion::Slerp(const MashQuaternion &a, const MashQuaternion &b, f32 t)
+	{
+		simd::QuaternionSlerp(a.v, b.v, t, v);
+		return *this;
+	}
+
+	inline MashQuaternion& MashQuaternion::Nlerp(const MashQuaternion &a, const MashQuaternion &b, f32 t)
+	{
+		simd::QuaternionNlerp(a.v, b.v, t, v);
+		return *this;
+	}
 }
 #endif
\ No newline at end of file
@@ -21,8 +21,12 @@ namespace mash
 	class MashShadowCaster;
 	class MashParticleSystem;
 	class MashSkin;
+	class MashSkinPaletteBuffer;
 	class MashMatrix4;
 	class MashTexture;
+	class MashTextureState;
+	class MashLightClusterGrid;
+	class MashVector4;
 
     /*!
         This is a blackboard for the current render state. Renderable objects write to
@@ -57,6 +61,19 @@ namespace mash
         
         //! Last number of bones that were written to the bone array.
 		virtual uint32 GetCurrentBoneCount()const = 0;
+
+        //! Palette buffer of the current skin.
+        /*!
+            Only set when the current skin belongs to a MashSkinPaletteBuffer.
+            In this case GetBonePalette() is not filled. The palette is found
+            in the buffer at GetBonePaletteOffset().
+         
+            \return Palette buffer. NULL if the current skin does not use one.
+        */
+		virtual MashSkinPaletteBuffer* GetSkinPaletteBuffer()const = 0;
+
+        //! Offset of the current skin in GetSkinPaletteBuffer(), in matrices.
+		virtual uint32 GetBonePaletteOffset()const = 0;
         
         //! Gets the current world transform.
 		virtual const mash::MashMatrix4& GetWorldTransform()const = 0;
@@ -116,11 +133,43 @@ namespace mash
         //! Gets the active shadow caster.
 		virtual MashShadowCaster* GetShadowCaster()const = 0;
 
+        //! Gets the light cluster grid of the current scene.
+        /*!
+            Only valid when the scene is using aLIGHT_TYPE_CLUSTERED lighting.
+            Light indices in the grid refer to GetLightBuffer().
+
+            \return Cluster grid. NULL if clustered lighting is not in use.
+        */
+		virtual const MashLightClusterGrid* GetLightClusterGrid()const = 0;
+
+        //! Gets the texture holding the light cluster data.
+        /*!
+            \param textureStateOut Sampler state to use with the texture. May be NULL.
+            \return Cluster texture. NULL if clustered lighting is not in use.
+        */
+		virtual MashTexture* GetLightClusterTexture(const MashTextureState **textureStateOut = 0)const = 0;
+
+        //! Layout of the light cluster texture.
+        /*!
+            x = First texel of the cluster records.
+            y = First texel of the light indices.
+            z = 1 / texture width.
+            w = 1 / texture height.
+        */
+		virtual const MashVector4& GetLightClusterLayout()const = 0;
+
 		//! Gets the active vertex declaration.
 		virtual MashVertex* GetVertex()const = 0;
         
         //! Sets the current skin.
         virtual void SetSkin(MashSkin *skin) = 0;
+
+        //! Sets the palette buffer and offset of the current skin.
+        /*!
+            \param buffer Palette buffer. Set to NULL if the current skin fills GetBonePalette().
+            \param offset Offset of the current skin in the buffer, in matrices.
+        */
+        virtual void SetSkinPaletteBuffer(MashSkinPaletteBuffer *buffer, uint32 offset) = 0;
         
         //! Sets the current list.
 		virtual void SetLight(MashLight *light) = 0;
@@ -181,6 +230,15 @@ namespace mash
         //! Sets the active shadow caster.
 		virtual void SetShadowCaster(MashShadowCaster *caster) = 0;
 
+        //! Sets the light cluster data of the current scene.
+        /*!
+            \param grid Cluster grid. Set to NULL when clustered lighting is not in use.
+            \param texture Texture holding the light, cluster and index data.
+            \param textureState Sampler state for the texture.
+            \param layout See GetLightClusterLayout().
+        */
+		virtual void SetLightClusters(const MashLightClusterGrid *grid, MashTexture *texture, const MashTextureState *textureState, const MashVector4 &layout) = 0;
+
 		//! Sets the active vertex declaration.
 		virtual void SetVertex(MashVertex *vertexDecl) = 0;
 	};
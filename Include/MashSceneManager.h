@@ -49,6 +49,9 @@ namespace mash
 	class MashTriangleBuffer;
 	class MashTriangleCollider;
 	class MashSkin;
+	class MashSkinPaletteBuffer;
+	class MashLightClusterGrid;
+	class MashLightInfluenceIndex;
 
 	class MashRenderable;
 	class MashVideo;
@@ -140,6 +143,30 @@ namespace mash
             
             //! Solid objects rendered in the deferred renderer.
 			uint32 deferredObjectSolidCount;
+
+            //! Number of times the render queues had to grow during the last frame.
+            /*!
+                Queues keep their memory between frames so this should be 0 once
+                the number of visible objects is stable.
+            */
+			uint32 renderQueueAllocationCount;
+
+            //! Deferred lighting draws in the last frame.
+            /*!
+                Each shadowed light is one draw. With tiled deferred lighting each
+                batch of lights drawn over a tile is also one draw.
+            */
+			uint32 deferredLightPassCount;
+
+            //! Full screen deferred light passes replaced by tiled lighting in the last frame.
+			uint32 deferredLightPassesSaved;
+
+            //! Point and spot lights turned off for forward rendered objects in the last frame.
+            /*!
+                Counts each light left out of an object's light slots when forward light
+                influence is enabled. See SetForwardLightInfluenceEnabled().
+            */
+			uint32 forwardLightsSkipped;
 		};
 
 		
@@ -176,6 +203,9 @@ namespace mash
 			memory usage and fragmentation.
 
             Valid file extentions are .nss or .dae.
+
+            COLLADA files can be parsed in parallel by setting sLoadSceneSettings::maxLoadThreads.
+            Nodes are always created in the order files appear in filenames.
          
             If this is called after MashGameLoop::Initialise() then you may want to call
             MashSceneManager::CompileAllMaterials(aMATERIAL_COMPILER_NON_COMPILED) to compile any materials
@@ -586,6 +616,17 @@ namespace mash
         */
         virtual MashSkin* CreateSkin() = 0;
 
+        //! Creates a buffer that holds the bone palettes of many skins.
+        /*!
+            The returned pointer must be dropped by the user when done.
+
+            Skins added to the buffer have their palettes computed together once per frame
+            and uploaded to a single texture. This is useful for crowds. See MashSkinPaletteBuffer.
+
+            \return New palette buffer.
+        */
+        virtual MashSkinPaletteBuffer* CreateSkinPaletteBuffer() = 0;
+
         //! Creates a new triangle from a mesh.
 		/*!
             The returned pointer must be dropped by the user when done.
@@ -836,6 +877,46 @@ namespace mash
 		*/
 		virtual void SetPreferredLightingMode(eLIGHTING_TYPE type) = 0;
 
+        //! Gets the light cluster grid.
+        /*!
+            Used when the preferred lighting mode is aLIGHT_TYPE_CLUSTERED. Lights
+            that pass the scene cull are binned into this grid each frame before
+            forward rendered objects are drawn. The grid size and number of threads
+            used can be changed here.
+         
+            \return Light cluster grid.
+        */
+		virtual MashLightClusterGrid* GetLightClusterGrid() = 0;
+
+        //! Enables per object light selection for forward rendered objects.
+        /*!
+            By default every forward rendered object is lit by every forward rendered light.
+            With this enabled, point and spot lights are stored in a spatial index and each
+            object is given the most significant lights reaching its bounds when it's added
+            to the render queue. Other point and spot lights have their range set to 0
+            while the object is drawn so the lighting shaders skip them.
+
+            Directional lights always light every object. This has no effect when the
+            preferred lighting mode is aLIGHT_TYPE_CLUSTERED.
+
+            \param enable Enable or disable light selection.
+            \param maxLightsPerObject Maximum point and spot lights per object. Limited to 16.
+        */
+        virtual void SetForwardLightInfluenceEnabled(bool enable, uint32 maxLightsPerObject = 4) = 0;
+
+        //! Returns true if per object light selection is enabled.
+        virtual bool GetForwardLightInfluenceEnabled()const = 0;
+
+        //! Gets the forward light influence index.
+        /*!
+            Light ids in the index are indices into GetForwardRenderedLightList(). The cell
+            size can be changed here to suit the scale of the scene.
+         
+            
+eturn Light influence index.
+        */
+		virtual MashLightInfluenceIndex* GetLightInfluenceIndex() = 0;
+
         //! Sets the active camera.
         /*!
             This will be the camera responsible for rendering the scene. This camera must still be attached to a 
@@ -1060,6 +1141,24 @@ namespace mash
             have been created.
         */
         virtual bool IsDeferredRendererInitialised()const = 0;
+
+        //! Enables tiled deferred lighting.
+        /*!
+            By default the deferred renderer draws one full screen pass per light.
+            With tiled lighting the screen is split into tiles and each tile gets a list
+            of lights from the light bounds and the depth range of the deferred objects
+            within it. Lights without shadows are then drawn over each tile in batches,
+            so the gbuffer is read once per batch rather than once per light.
+
+            Lights with shadows enabled still get their own full screen pass.
+
+            \param enable Enable or disable tiled lighting.
+            \param tileSize Tile width and height in pixels.
+        */
+        virtual void SetDeferredTiledLightingEnabled(bool enable, uint32 tileSize = 64) = 0;
+
+        //! Returns true if tiled deferred lighting is enabled.
+        virtual bool GetDeferredTiledLightingEnabled()const = 0;
         
         //! Sets the hash function used to sort scene nodes before rendering.
         /*!
@@ -87,6 +87,30 @@ namespace mash
 			uint32 typesToTest,
 			bool backFaceCull,
 			sTriPickResult &out);
+
+        //! Gets the closest triangle to many rays.
+		/*!
+            Triangle colliders must be added to nodes for this to work.
+
+            The scene graph is walked once for the whole batch. Only rays that intersect
+            a nodes bounds are passed on to its collider and children. This is much faster
+            than calling GetClosestTriFromScene() for each ray.
+         
+            \param scene Scene graph to test.
+            \param rays Rays to test in world space.
+            \param rayCount Number of rays in the array.
+            \param typesToTest Bitwise eNODE_TYPE to test.
+            \param backFaceCull Set to true to cull triangle backfaces when testing.
+            \param out One element per ray. Contains the triangle that intersects each ray.
+                Each elements collision flag is set if its ray intersected a triangle.
+            \return Number of rays that intersected a triangle. 
+		*/
+		static uint32 GetClosestTrisFromScene(MashSceneNode *scene,
+			const MashRay *rays,
+			uint32 rayCount,
+			uint32 typesToTest,
+			bool backFaceCull,
+			sTriPickResult *out);
 	};	
 }
 
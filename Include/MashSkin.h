@@ -14,6 +14,7 @@ namespace mash
 {
 	class MashBone;
     class MashSceneNode;
+	class MashSkinPaletteBuffer;
 
     /*!
         Skins contain bone scene nodes that are used for skinning. These can be
@@ -30,6 +31,9 @@ namespace mash
         a skin will not update the bones added to it. Skins are simply containers for
         bones and they still need to be attached to a scene to be updated.
         Instances can be created using CreateInstance().
+
+        Skins drawn many times per frame, such as crowds, can be added to a
+        MashSkinPaletteBuffer. Their palettes are then computed together into one buffer.
     */
 	class MashSkin : public MashReferenceCounter
 	{
@@ -89,8 +93,27 @@ namespace mash
          
             If an elements matrix is set to the identity matrix then that means the bone
             is in its bind pose.
+
+            If this skin belongs to a MashSkinPaletteBuffer then the buffer is updated instead and
+            this skins offset is set in MashRenderInfo.
         */
 		virtual void OnRender() = 0;
+
+        //! Palette buffer this skin belongs to.
+        /*!
+            \return Palette buffer. NULL if this skin fills the shared palette.
+        */
+		virtual MashSkinPaletteBuffer* GetPaletteBuffer()const = 0;
+
+        //! Offset of this skin in GetPaletteBuffer(), in matrices.
+		virtual uint32 GetPaletteOffset()const = 0;
+
+        //! Called by MashSkinPaletteBuffer when this skin is added or its offset changes.
+        /*!
+            \param buffer Buffer this skin belongs to. NULL when removed.
+            \param offset Offset of this skin in the buffer, in matrices.
+        */
+		virtual void _SetPaletteBuffer(MashSkinPaletteBuffer *buffer, uint32 offset) = 0;
 	};
 }
 
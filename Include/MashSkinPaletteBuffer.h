@@ -0,0 +1,127 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+
+#ifndef _MASH_SKIN_PALETTE_BUFFER_H_
+#define _MASH_SKIN_PALETTE_BUFFER_H_
+
+#include "MashReferenceCounter.h"
+#include "MashEnum.h"
+
+namespace mash
+{
+	class MashSkin;
+	class MashMatrix4;
+	class MashTexture;
+	class MashTextureState;
+
+    /*!
+        Holds the bone palettes of many skins in one large matrix buffer. Useful
+        for crowds where many instances of the same skinned mesh are drawn each frame.
+
+        Skins added to this buffer no longer fill the shared palette in MashRenderInfo.
+        Instead, the palettes of every skin in the buffer are computed in a single pass
+        the first time one of them is rendered each frame. The results are then uploaded
+        to a floating point texture.
+
+        Each skin gets a fixed offset into the buffer. When a skin in this buffer is
+        rendered, its offset can be read from shaders using the auto parameter
+        "autoBonePaletteInfo". The texture is bound using "autoBonePaletteTexture".
+        "autoBonePalette" is not set for skins in this buffer so their vertex shaders
+        must read bones from the texture. See PaletteBufferVertexSkinningShader.eff in
+        the animation demo.
+
+        autoBonePaletteInfo is a float4 with:
+         - x : Offset of the current skin, in matrices.
+         - y : Matrices per texture row.
+         - z : 1 / texture width.
+         - w : 1 / texture height.
+
+        Each matrix takes up 4 consecutive texels in a row. Matrix n starts at
+        texel (n % y) * 4 in row n / y.
+
+        For hardware instancing, the offset of each instance can be read from
+        GetSkinOffset() and written to an instance stream. Many instances of the
+        same mesh with different poses can then be drawn in one call.
+
+        Create buffers using MashSceneManager::CreateSkinPaletteBuffer().
+    */
+	class MashSkinPaletteBuffer : public MashReferenceCounter
+	{
+	public:
+		MashSkinPaletteBuffer():MashReferenceCounter(){}
+		virtual ~MashSkinPaletteBuffer(){}
+
+		//! Adds a skin to this buffer.
+		/*!
+			The skin will be grabbed. A skin can only belong to one buffer.
+
+			\param skin Skin to add.
+			\return Ok on success. Failed if the skin already belongs to a buffer.
+		*/
+		virtual eMASH_STATUS AddSkin(MashSkin *skin) = 0;
+
+		//! Removes a skin from this buffer.
+		/*!
+			The offsets of all other skins in this buffer may change.
+
+			\param skin Skin to remove.
+		*/
+		virtual void RemoveSkin(MashSkin *skin) = 0;
+
+		//! Removes all skins from this buffer.
+		virtual void RemoveAllSkins() = 0;
+
+		//! Computes the palettes of all skins and updates the texture.
+		/*!
+			This is called automatically the first time a skin in this buffer is
+			rendered each frame. It only needs to be called manually if the palettes
+			are needed before then.
+
+			The palettes are only computed once per frame.
+
+			\return Ok on success, failed otherwise.
+		*/
+		virtual eMASH_STATUS Update() = 0;
+
+		//! Gets the offset of a skin in matrices.
+		/*!
+			\param skin Skin in this buffer.
+			\return Offset of the skin. -1 if the skin is not in this buffer.
+		*/
+		virtual int32 GetSkinOffset(const MashSkin *skin)const = 0;
+
+		//! Gets the palettes of all skins.
+		/*!
+			Only valid after Update().
+
+			\return Palette matrices. Use GetSkinOffset() to find a skins palette.
+		*/
+		virtual const MashMatrix4* GetPalette()const = 0;
+
+		//! Number of matrices in GetPalette().
+		virtual uint32 GetPaletteSize()const = 0;
+
+		//! Number of skins in this buffer.
+		virtual uint32 GetSkinCount()const = 0;
+
+		//! Texture the palettes are uploaded to.
+		/*!
+			The texture may be recreated when skins are added.
+
+			\param textureStateOut Point sampler state to use with the texture. May be NULL.
+			\return Palette texture. NULL if no skins have been added.
+		*/
+		virtual MashTexture* GetTexture(const MashTextureState **textureStateOut = 0)const = 0;
+
+		//! Matrices per row in the texture.
+		virtual uint32 GetMatricesPerRow()const = 0;
+
+		//! Called by a skin in this buffer when its bones change.
+		virtual void _OnSkinChange() = 0;
+	};
+}
+
+#endif
@@ -243,7 +243,8 @@ namespace mash
 
 		enum
 		{
-			INTERNAL_POOL_SIZE = 16
+			//strings up to this length (including the null terminator) don't allocate memory
+			INTERNAL_POOL_SIZE = MASH_STRING_INLINE_CAPACITY
 		};
 
 		T m_internalPool[INTERNAL_POOL_SIZE];
@@ -404,6 +405,93 @@ namespace mash
 			}
 		}
 
+#ifdef MASH_HAS_MOVE_SEMANTICS
+        //! Move constructor.
+        /*!
+            Takes the memory of other if possible. other is left empty.
+        */
+		MashBaseString(MashBaseString<T, TAlloc> &&other):
+			m_memoryPool(other.m_memoryPool),
+			m_usedElements(0),
+			m_reservedElements(0), 
+			m_string(0)
+		{
+			_Reserve(1);
+			m_usedElements = 1;
+			m_string[0] = 0;
+
+			Swap(other);
+		}
+
+        //! Move assignment.
+		MashBaseString<T, TAlloc>& operator=(MashBaseString<T, TAlloc> &&other)
+		{
+			if (this != &other)
+			{
+				Clear();
+				Swap(other);
+			}
+
+			return *this;
+		}
+#endif
+
+        //! Exchanges the contents of two strings.
+        /*!
+            Heap memory is exchanged without copying if the allocator is stateless.
+            Short strings held in the internal pool are copied.
+        */
+		void Swap(MashBaseString<T, TAlloc> &other)
+		{
+			if (this == &other)
+				return;
+
+			if (!helpers::MashIsAllocatorStateless<TAlloc>::value)
+			{
+				MashBaseString<T, TAlloc> temp(*this);
+				*this = other;
+				other = temp;
+				return;
+			}
+
+			const bool thisHeap = m_reservedElements > INTERNAL_POOL_SIZE;
+			const bool otherHeap = other.m_reservedElements > INTERNAL_POOL_SIZE;
+
+			T *thisString = m_string;
+			const uint32 thisReserved = m_reservedElements;
+			const uint32 thisUsed = m_usedElements;
+
+			if (thisHeap && otherHeap)
+			{
+				m_string = other.m_string;
+				other.m_string = thisString;
+			}
+			else if (thisHeap)
+			{
+				memcpy(m_internalPool, other.m_internalPool, sizeof(T) * other.m_usedElements);
+				m_string = &m_internalPool[0];
+				other.m_string = thisString;
+			}
+			else if (otherHeap)
+			{
+				memcpy(other.m_internalPool, m_internalPool, sizeof(T) * m_usedElements);
+				m_string = other.m_string;
+				other.m_string = &other.m_internalPool[0];
+			}
+			else
+			{
+				T temp[INTERNAL_POOL_SIZE];
+				memcpy(temp, m_internalPool, sizeof(T) * m_usedElements);
+				memcpy(m_internalPool, other.m_internalPool, sizeof(T) * other.m_usedElements);
+				memcpy(other.m_internalPool, temp, sizeof(T) * thisUsed);
+			}
+
+			m_reservedElements = other.m_reservedElements;
+			m_usedElements = other.m_usedElements;
+			other.m_reservedElements = thisReserved;
+			other.m_usedElements = thisUsed;
+		}
+
         //! Constructor.
         /*!
             \param num Converts an int to a string.
@@ -1093,6 +1181,24 @@ namespace mash
 	const uint32 MashBaseString<T, TAlloc>::npos = -1;
 
 	typedef MashBaseString<int8, MashMemoryPoolSimple> MashStringc;
+
+	namespace helpers
+	{
+		/*
+			Strings may point into their own internal pool so they can't be memcpy'd.
+			Swapping into the new location avoids copying heap memory.
+		*/
+		template<class T, class TAlloc>
+		struct MashRelocateElement<MashBaseString<T, TAlloc> >
+		{
+			static void Relocate(MashBaseString<T, TAlloc> *dst, MashBaseString<T, TAlloc> *src)
+			{
+				new ((void*)dst) MashBaseString<T, TAlloc>(src->GetAllocator());
+				dst->Swap(*src);
+				src->~MashBaseString<T, TAlloc>();
+			}
+		};
+	}
 }
 
 #endif
@@ -0,0 +1,75 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+
+#ifndef _MASH_STRING_ID_H_
+#define _MASH_STRING_ID_H_
+
+#include "MashCompileSettings.h"
+#include "MashDataTypes.h"
+#include "MashString.h"
+
+namespace mash
+{
+	//! Interned string.
+	/*!
+		Each unique string is stored once in a global table and given a 32-bit id.
+		Comparing and hashing ids is much faster than comparing strings, so these
+		should be used as keys for names that are looked up often, such as animation
+		sets, materials and effect parameters.
+
+		Create ids once at load time and store them. Creating an id from a string
+		needs to hash the string and lock the table.
+
+		Ids are only valid for the lifetime of the process. Do not save them to file.
+
+		The empty string always has an id of 0.
+	*/
+	class _MASH_EXPORT MashStringID
+	{
+	private:
+		uint32 m_id;
+	public:
+		//! Creates the empty string id.
+		MashStringID():m_id(0){}
+
+		//! Interns a string.
+		/*!
+			\param string String to intern. NULL is the same as the empty string.
+		*/
+		explicit MashStringID(const int8 *string);
+
+		//! Interns a string.
+		explicit MashStringID(const MashStringc &string);
+
+		//! Returns the id of this string.
+		uint32 GetID()const{return m_id;}
+
+		//! Returns the interned string. This pointer is valid for the lifetime of the process.
+		const int8* GetString()const;
+
+		//! Returns true if this is the empty string.
+		bool IsEmpty()const{return m_id == 0;}
+
+		bool operator==(const MashStringID &other)const{return m_id == other.m_id;}
+		bool operator!=(const MashStringID &other)const{return m_id != other.m_id;}
+
+		//! Orders by id, not alphabetically.
+		bool operator<(const MashStringID &other)const{return m_id < other.m_id;}
+
+		//! Finds the id of a string without interning it.
+		/*!
+			Use this when searching with a user supplied string. If the string
+			has never been interned then nothing can be keyed by it.
+
+			\param string String to find.
+			\param out Id of the string if it was found.
+			\return True if the string has been interned.
+		*/
+		static bool Find(const int8 *string, MashStringID &out);
+	};
+}
+
+#endif
@@ -0,0 +1,229 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+
+#ifndef _MASH_STRING_ID_MAP_H_
+#define _MASH_STRING_ID_MAP_H_
+
+#include "MashStringID.h"
+#include "MashArray.h"
+
+namespace mash
+{
+	//! Hash map keyed by MashStringID.
+	/*!
+		Lookups hash the 32-bit id only, so no strings are compared or allocated.
+		Elements are stored in a single array using linear probing.
+
+		Pointers returned from Find() are invalidated by Insert() and Erase().
+
+		T must be copyable.
+	*/
+	template<class T>
+	class MashStringIDMap
+	{
+	private:
+		struct sEntry
+		{
+			uint32 key;
+			T value;
+
+			sEntry():key(aEMPTY_KEY), value(){}
+		};
+
+		enum
+		{
+			aEMPTY_KEY = 0xFFFFFFFF,
+			aMIN_CAPACITY = 16
+		};
+
+		MashArray<sEntry> m_entries;
+		uint32 m_count;
+
+		uint32 GetSlot(uint32 key)const
+		{
+			//fibonacci hashing spreads sequential ids across the table
+			return (key * 2654435761U) & (m_entries.Size() - 1);
+		}
+
+		void Grow()
+		{
+			const uint32 newSize = (m_entries.Size() > 0) ? m_entries.Size() * 2 : (uint32)aMIN_CAPACITY;
+			MashArray<sEntry> oldEntries(m_entries);
+			m_entries.Clear();
+			m_entries.Resize(newSize);
+
+			const uint32 oldSize = oldEntries.Size();
+			for(uint32 i = 0; i < oldSize; ++i)
+			{
+				if (oldEntries[i].key != aEMPTY_KEY)
+				{
+					uint32 slot = GetSlot(oldEntries[i].key);
+					while(m_entries[slot].key != aEMPTY_KEY)
+						slot = (slot + 1) & (m_entries.Size() - 1);
+
+					m_entries[slot] = oldEntries[i];
+				}
+			}
+		}
+
+		int32 FindSlot(uint32 key)const
+		{
+			if (m_count == 0)
+				return -1;
+
+			const uint32 mask = m_entries.Size() - 1;
+			uint32 slot = GetSlot(key);
+			while(m_entries[slot].key != aEMPTY_KEY)
+			{
+				if (m_entries[slot].key == key)
+					return (int32)slot;
+
+				slot = (slot + 1) & mask;
+			}
+
+			return -1;
+		}
+	public:
+		MashStringIDMap():m_entries(), m_count(0){}
+		~MashStringIDMap(){}
+
+		//! Inserts or replaces an element.
+		void Insert(const MashStringID &key, const T &value)
+		{
+			//keep the load factor under 0.5 so probes stay short
+			if ((m_count + 1) * 2 > m_entries.Size())
+				Grow();
+
+			const uint32 mask = m_entries.Size() - 1;
+			uint32 slot = GetSlot(key.GetID());
+			while(m_entries[slot].key != aEMPTY_KEY)
+			{
+				if (m_entries[slot].key == key.GetID())
+				{
+					m_entries[slot].value = value;
+					return;
+				}
+
+				slot = (slot + 1) & mask;
+			}
+
+			m_entries[slot].key = key.GetID();
+			m_entries[slot].value = value;
+			++m_count;
+		}
+
+		//! Finds an element.
+		/*!
+			\return Pointer to the value, or NULL if the key was not found.
+		*/
+		T* Find(const MashStringID &key)
+		{
+			const int32 slot = FindSlot(key.GetID());
+			return (slot < 0) ? 0 : &m_entries[slot].value;
+		}
+
+		//! Finds an element.
+		const T* Find(const MashStringID &key)const
+		{
+			const int32 slot = FindSlot(key.GetID());
+			return (slot < 0) ? 0 : &m_entries[slot].value;
+		}
+
+		//! Finds an element by string without interning the string.
+		T* Find(const int8 *key)
+		{
+			MashStringID id;
+			if (!MashStringID::Find(key, id))
+				return 0;
+
+			return Find(id);
+		}
+
+		//! Finds an element by string without interning the string.
+		const T* Find(const int8 *key)const
+		{
+			MashStringID id;
+			if (!MashStringID::Find(key, id))
+				return 0;
+
+			return Find(id);
+		}
+
+		//! Returns true if the key exists.
+		bool Contains(const MashStringID &key)const
+		{
+			return FindSlot(key.GetID()) >= 0;
+		}
+
+		//! Removes an element.
+		/*!
+			\return True if the key was found.
+		*/
+		bool Erase(const MashStringID &key)
+		{
+			const int32 foundSlot = FindSlot(key.GetID());
+			if (foundSlot < 0)
+				return false;
+
+			/*
+				Shift following entries back so no tombstones are needed. An entry
+				is only moved if the hole lies between its ideal slot and its
+				current slot.
+			*/
+			const uint32 mask = m_entries.Size() - 1;
+			uint32 hole = (uint32)foundSlot;
+			uint32 slot = (hole + 1) & mask;
+			while(m_entries[slot].key != aEMPTY_KEY)
+			{
+				const uint32 ideal = GetSlot(m_entries[slot].key);
+				const uint32 distanceToHole = (hole - ideal) & mask;
+				const uint32 distanceToSlot = (slot - ideal) & mask;
+				if (distanceToHole < distanceToSlot)
+				{
+					m_entries[hole] = m_entries[slot];
+					hole = slot;
+				}
+
+				slot = (slot + 1) & mask;
+			}
+
+			m_entries[hole] = sEntry();
+			--m_count;
+
+			return true;
+		}
+
+		//! Removes all elements. Memory is kept.
+		void Clear()
+		{
+			const uint32 size = m_entries.Size();
+			for(uint32 i = 0; i < size; ++i)
+				m_entries[i] = sEntry();
+
+			m_count = 0;
+		}
+
+		//! Number of elements.
+		uint32 Size()const{return m_count;}
+
+		//! Returns true if there are no elements.
+		bool Empty()const{return m_count == 0;}
+
+		//! Number of slots. Used with IsSlotUsed() to visit every element.
+		uint32 GetSlotCount()const{return m_entries.Size();}
+
+		//! Returns true if a slot holds an element.
+		bool IsSlotUsed(uint32 slot)const{return m_entries[slot].key != aEMPTY_KEY;}
+
+		//! Returns the value in a used slot.
+		T& GetSlotValue(uint32 slot){return m_entries[slot].value;}
+
+		//! Returns the value in a used slot.
+		const T& GetSlotValue(uint32 slot)const{return m_entries[slot].value;}
+	};
+}
+
+#endif
@@ -0,0 +1,105 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+
+#ifndef _MASH_TEXT_PARSER_H_
+#define _MASH_TEXT_PARSER_H_
+
+#include "MashCompileSettings.h"
+#include "MashDataTypes.h"
+#include "MashArray.h"
+
+namespace mash
+{
+    /*!
+        Fast parsing of large whitespace separated number lists, such as the arrays
+        found in COLLADA files.
+
+        Whitespace is space, tab, new line and carriage return as defined by XML.
+        Numbers are read in the C locale. Floats are rounded exactly as strtof() would
+        round them.
+    */
+	namespace text
+	{
+		//! Returns true if c is xml whitespace.
+		inline bool IsWhitespace(int8 c)
+		{
+			return (c == ' ') || (c == '\n') || (c == '\t') || (c == '\r');
+		}
+
+		//! Returns the first character that isn't whitespace.
+		/*!
+			Long runs of whitespace are scanned 16 characters at a time when SSE2 is
+			available. str must be null terminated.
+		*/
+		_MASH_EXPORT const int8* SkipWhitespace(const int8 *str);
+
+		//! Parses a float.
+		/*!
+			\param str Start of the number. Leading whitespace is not skipped.
+			\param out Parsed value.
+			\return One past the last character used. Returns str if no number was found.
+		*/
+		_MASH_EXPORT const int8* ParseFloat(const int8 *str, f32 &out);
+
+		//! Parses a decimal integer.
+		/*!
+			\param str Start of the number. Leading whitespace is not skipped.
+			\param out Parsed value.
+			\return One past the last character used. Returns str if no number was found.
+		*/
+		_MASH_EXPORT const int8* ParseInt(const int8 *str, int32 &out);
+
+		//! Parses a whitespace separated list of floats.
+		/*!
+			Tokens that are not numbers are written as 0.
+
+			\param str Null terminated list.
+			\param out Values are written here.
+			\param maxCount Size of out. Parsing stops once out is full.
+			\return Number of values written.
+		*/
+		_MASH_EXPORT uint32 ParseFloatArray(const int8 *str, f32 *out, uint32 maxCount);
+
+		//! Parses a whitespace separated list of integers.
+		/*!
+			See ParseFloatArray().
+		*/
+		_MASH_EXPORT uint32 ParseIntArray(const int8 *str, int32 *out, uint32 maxCount);
+
+		//! Parses a whitespace separated list of xml booleans.
+		/*!
+			Tokens starting with 't' or '1' are true, everything else is false.
+			See ParseFloatArray().
+		*/
+		_MASH_EXPORT uint32 ParseBoolArray(const int8 *str, bool *out, uint32 maxCount);
+
+		//! Moves the text of selected elements out of an xml document.
+		/*!
+			This lets an xml parser skip large text payloads such as number arrays. The
+			payloads can then be read directly from text without being copied into the
+			document tree.
+
+			text is copied to documentOut without the text of elements named in
+			elementNames. That text is null terminated in place within text.
+
+			textOut receives one entry for each start tag matching elementNames, in
+			document order. Entries are 0 when the element was left in the document.
+			This happens for self closing or empty elements, and elements whose text
+			contains child elements, comments or entities.
+
+			\param text Null terminated document. This is modified.
+			\param elementNames Names of elements to move.
+			\param elementNameCount Number of names.
+			\param documentOut Must hold at least strlen(text) + 1 characters.
+			\param textOut Element text in document order. Cleared before filling.
+			\return Number of elements whose text was moved.
+		*/
+		_MASH_EXPORT uint32 ExtractElementText(int8 *text, const int8 *const *elementNames, uint32 elementNameCount,
+			int8 *documentOut, MashArray<const int8*> &textOut);
+	}
+}
+
+#endif
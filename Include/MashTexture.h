@@ -55,9 +55,11 @@ namespace mash
             \param data This will return a pointer to the start of this buffer.
             \param level Mip level to lock. 0 is default.
             \param face Texture face of type eCUBEMAP_FACE.
+            \param rowPitch If not null, returns the size in bytes of each locked row. This
+                may be larger than width * pixel size so rows must be written using this pitch.
             \return Ok on success, failed otherwise.
         */
-		virtual eMASH_STATUS Lock(eBUFFER_LOCK type, void **data, uint32 level = 0, uint32 face = 0) = 0;
+		virtual eMASH_STATUS Lock(eBUFFER_LOCK type, void **data, uint32 level = 0, uint32 face = 0, uint32 *rowPitch = 0) = 0;
         
         //! Unlocks the texture buffer.
         /*!
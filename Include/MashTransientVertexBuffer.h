@@ -0,0 +1,81 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+
+#ifndef _MASH_TRANSIENT_VERTEX_BUFFER_H_
+#define _MASH_TRANSIENT_VERTEX_BUFFER_H_
+
+#include "MashReferenceCounter.h"
+#include "MashEnum.h"
+
+namespace mash
+{
+	class MashMeshBuffer;
+	class MashVertex;
+
+    /*!
+        Shared buffer for geometry that is rebuilt every frame, such as GUI, particles and debug lines.
+
+        Data is sub allocated from a ring buffer. Each write only locks the buffer without
+        waiting on the GPU (aLOCK_WRITE_NOOVERWRITE). The buffer is only discarded when
+        the ring wraps around. This avoids each system owning its own dynamic buffer and
+        discarding the whole thing on every update.
+
+        The first vertex returned from Unlock() or Write() is then passed to MashVideo::DrawVertexList().
+        Data written is only valid for the current frame.
+
+        One transient buffer is shared by all systems using the same vertex declaration. See
+        MashVideo::GetTransientVertexBuffer().
+    */
+	class MashTransientVertexBuffer : public MashReferenceCounter
+	{
+	public:
+		MashTransientVertexBuffer():MashReferenceCounter(){}
+		virtual ~MashTransientVertexBuffer(){}
+
+		//! Locks space in the buffer for writing.
+		/*!
+			Only one lock can be held at a time. Unlock() must be called before rendering
+			from this buffer or locking it again. Use Write() if the data is already in memory.
+
+			\param maxVertexCount Maximum number of vertices that will be written.
+			\param dataOut Pointer to write the vertices to.
+			\return Ok on success, failed otherwise.
+		*/
+		virtual eMASH_STATUS Lock(uint32 maxVertexCount, void **dataOut) = 0;
+
+		//! Unlocks the buffer after a call to Lock().
+		/*!
+			\param vertexCount Number of vertices written. Must be <= the maxVertexCount passed to Lock().
+				Any unused space is returned to the buffer.
+			\param firstVertexOut First vertex of the written data.
+			\return Ok on success, failed otherwise.
+		*/
+		virtual eMASH_STATUS Unlock(uint32 vertexCount, uint32 &firstVertexOut) = 0;
+
+		//! Copies vertices into the buffer.
+		/*!
+			\param vertices Vertices to copy.
+			\param vertexCount Number of vertices.
+			\param firstVertexOut First vertex of the written data.
+			\return Ok on success, failed otherwise.
+		*/
+		virtual eMASH_STATUS Write(const void *vertices, uint32 vertexCount, uint32 &firstVertexOut) = 0;
+
+		//! Mesh buffer used for rendering.
+		/*!
+			The returned pointer must not be dropped. Its buffers must not be resized or locked directly.
+		*/
+		virtual MashMeshBuffer* GetMeshBuffer()const = 0;
+
+		//! Vertex declaration of this buffer.
+		virtual MashVertex* GetVertexDeclaration()const = 0;
+
+		//! Returns true between calls to Lock() and Unlock().
+		virtual bool IsLocked()const = 0;
+	};
+}
+
+#endif
@@ -78,6 +78,60 @@ namespace mash
 			const MashTransformState &transform,
 			MashArray<sTriPickResult> &out)const = 0;
 
+		//! Collision test against many rays.
+		/*!
+			Batches are faster than testing rays one at a time as rays are
+			transformed once and traversed in a coherent order.
+
+			Ray batch queries do not modify the collider so a large batch can be
+			split into ranges and run on seperate threads.
+
+			\param rays Rays to test in world space.
+			\param rayCount Number of rays in the array.
+			\param transform The world space trasform of the object that owns this collider.
+			\param out One element per ray. Set to true if the ray intersects any triangles.
+			\return Number of rays that intersected a triangle.
+		*/
+		virtual uint32 CheckCollisions(const MashRay *rays,
+			uint32 rayCount,
+			const MashTransformState &transform,
+			bool *out)const = 0;
+
+		//! Gets the closest triangle to many rays.
+		/*!
+			See CheckCollisions() for notes on batching.
+
+			\param rays Rays to test in world space.
+			\param rayCount Number of rays in the array.
+			\param transform The world space trasform of the object that owns this collider.
+			\param out One element per ray. Each element is only written to if its ray intersects a triangle
+				closer than its current distance, so this can be used to find the closest triangle over many colliders.
+				Initialise each distance to mash::math::MaxFloat() before the first call.
+			\return Number of elements written to.
+		*/
+		virtual uint32 GetClosestTriangles(const MashRay *rays,
+			uint32 rayCount,
+			const MashTransformState &transform,
+			sTriPickResult *out)const = 0;
+
+		//! Gets intersecting triangles for many AABBs.
+		/*!
+			Results for all AABBs are stored in one array. The results for bounds[i]
+			are stored from out[resultStartOut[i]] to out[resultStartOut[i + 1] - 1].
+
+			\param bounds Bounds in world space.
+			\param boundsCount Number of bounds in the array.
+			\param transform The world space trasform of the object that owns this collider.
+			\param out Intersecting triangles will be added here. Note, this function will not initially clear the array.
+			\param resultStartOut Must be able to hold boundsCount + 1 elements. Returns the start of each AABBs results within out.
+			\return Number of triangles added to the array.
+		*/
+		virtual uint32 GetIntersectingTriangles(const MashAABB *bounds,
+			uint32 boundsCount,
+			const MashTransformState &transform, 
+			MashArray<sIntersectingTriangleResult> &out,
+			uint32 *resultStartOut)const = 0;
+
         //! Gets the triangle buffers in this collection. This list must not be modified.
 		virtual const MashArray<MashTriangleBuffer*>& GetTriangleBufferCollection()const = 0;
         
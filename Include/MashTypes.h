@@ -73,17 +73,40 @@ namespace mash
         */
         bool deleteMeshInitialiseDataOnLoad;
 
+        /*!
+            Maximum number of threads used to parse COLLADA files when many files are
+            loaded with MashSceneManager::LoadSceneFile(). Files are parsed on worker threads
+            in groups of this size, then scene nodes and GPU resources are created on the
+            calling thread in the order the files were given. Parse and build times for
+            each file are written to the log.
+
+            Set to 1 to load on the calling thread only. 0 uses all hardware threads.
+            Each file being parsed holds its own memory pool so higher values use more memory.
+            Log receivers may be called from worker threads while parsing.
+        */
+        uint32 maxLoadThreads;
+
 		sLoadSceneSettings():frameRate(30), 
 			createRootNode(true),
 			saveGeometryFlags(0),
-            deleteMeshInitialiseDataOnLoad(false){}
+            deleteMeshInitialiseDataOnLoad(false),
+            maxLoadThreads(1){}
 	};
 
 	struct sSaveSceneSettings
 	{
 		int32 notUsed;
 
-		sSaveSceneSettings():notUsed(0){}
+		/*!
+			If set to true then meshes are saved already converted into the vertex
+			format of the material assigned to them and optimised for the vertex cache.
+			On load, these meshes can be handed straight to the renderer without any
+			vertex conversion.
+			Meshes that have no material assigned are saved as is.
+		*/
+		bool cookMeshes;
+
+		sSaveSceneSettings():notUsed(0), cookMeshes(false){}
 	};
 
 	struct sJoystickThreshold
@@ -25,6 +25,7 @@ namespace mash
 	class MashVertexBuffer;
 	class MashIndexBuffer;
 	class MashMeshBuffer;
+	class MashTransientVertexBuffer;
 
 	class MashVector2;
 	class MashRectangle2;
@@ -303,6 +304,19 @@ namespace mash
             \return New buffer.
         */
 		virtual MashIndexBuffer* CreateIndexBuffer(const void *data, uint32 indexCount, eUSAGE usage, eFORMAT format) = 0; 
+
+        //! Gets the transient buffer for a vertex declaration.
+        /*!
+            Transient buffers should be used for geometry that is rebuilt each frame rather
+            than creating a dynamic buffer. All systems using the same vertex declaration share
+            the same buffer.
+
+            The returned pointer must not be dropped.
+
+            \param vertexDecl Vertex declaration. Only stream 0 is used.
+            \return Transient buffer. NULL on error.
+        */
+		virtual MashTransientVertexBuffer* GetTransientVertexBuffer(MashVertex *vertexDecl) = 0;
 		
         //! Creates a render surface using a cube texture.
         /*!
@@ -407,10 +421,11 @@ namespace mash
             \param vertexCount Number of vertices in vertex stream 0.
             \param primitiveCount Number of primitive in the index list.
             \param primType Primitive type.
+            \param firstVertex First vertex to draw from. See MashTransientVertexBuffer.
             \return Ok on success, failed if any errors occured.
          */
 		virtual eMASH_STATUS DrawVertexList(const MashMeshBuffer *buffer, uint32 vertexCount,
-			uint32 primitiveCount, ePRIMITIVE_TYPE primType) = 0;
+			uint32 primitiveCount, ePRIMITIVE_TYPE primType, uint32 firstVertex = 0) = 0;
 
         //! Draws a mesh buffer that contains instance data to the current render surface.
         /*!
@@ -500,6 +515,19 @@ namespace mash
         */
 		virtual eMASH_STATUS DrawFullScreenQuadTexCoords(const mash::MashRectangle2 &texCoords) = 0;
 
+        //! Draws a quad covering part of the viewport.
+        /*!
+            This uses the vertex declaration MashVertexPosTex, same as DrawFullScreenQuad().
+            Unlike calling SetViewport() then DrawFullScreenQuadTexCoords(), vertex positions
+            are kept in full screen space. This is useful for effects that rebuild view space
+            positions from the vertex position, such as deferred lighting.
+         
+            \param region Area of the viewport to cover. (0, 0) is the top left of the viewport and (1, 1) the bottom right.
+            \param texCoords Texture coordinates at the corners of region.
+            \return Ok on success, failed if any errors occured.
+        */
+		virtual eMASH_STATUS DrawQuadRegion(const mash::MashRectangle2 &region, const mash::MashRectangle2 &texCoords) = 0;
+
         //! Draws a clipped texture to a particluar location on the current target.
         /*!
             This is a helper method for drawing a texture quickly. A rendering material will
@@ -545,6 +573,22 @@ namespace mash
         */
 		virtual uint32 GetCurrentFrameTechniqueChangeCount()const = 0;
 
+        //! Gets the number of bytes of effect parameter data uploaded this frame.
+        /*!
+            Debug method. This is reset before entering MashGameLoop::Render().
+         
+            \return Parameter bytes uploaded for the current frame.
+        */
+		virtual uint32 GetCurrentFrameConstantBytesUploaded()const = 0;
+
+        //! Gets the number of effect parameter uploads skipped this frame because the data had not changed.
+        /*!
+            Debug method. This is reset before entering MashGameLoop::Render().
+         
+            \return Skipped parameter uploads for the current frame.
+        */
+		virtual uint32 GetCurrentFrameConstantUploadsSkipped()const = 0;
+
         //! Gets the material manager.
 		virtual mash::MashMaterialManager* GetMaterialManager()const = 0;
 
@@ -609,6 +653,23 @@ namespace mash
 		*/
 		virtual MashTexture* GetTexture(const MashStringc &fileName) = 0;
 
+		//! Loads a list of textures from file.
+		/*!
+			This is faster than calling GetTexture() for each file when many textures
+			need loading. Where the renderer supports it, images are decoded and their
+			mipmaps generated on worker threads. Only the final upload is done on the
+			calling thread.
+
+			Previously loaded textures are taken from the cache. After this call
+			GetTexture() can be used to retrieve each texture without any loading cost.
+
+			\param fileNames Locations of the textures. Duplicates are allowed.
+			\param count Number of file names.
+			\param out Optional. Must hold count elements. Filled with a pointer to each texture, NULL if that texture failed to load.
+			\return Failed if any texture failed to load.
+		*/
+		virtual eMASH_STATUS GetTextures(const MashStringc *fileNames, uint32 count, MashTexture **out = 0) = 0;
+
         //! Removes a texture from the internal list.
 		/*!
 			This removes the texture from the internal texture list and drops
@@ -11,6 +11,7 @@
 #include "MashArray.h"
 #include "MashString.h"
 #include "MashList.h"
+#include "MashEffectProgram.h"
 #include <map>
 
 namespace mash
@@ -47,6 +48,8 @@ namespace mash
 		
 		uint32 m_currentDrawCount;
 		uint32 m_currentFrameTechniqueChangeCount;
+		uint32 m_currentFrameConstantBytesUploaded;
+		uint32 m_currentFrameConstantUploadsSkipped;
 		
 		uint16 m_FSVertexCount;
 		MashRenderInfo *m_renderInfo;
@@ -75,9 +78,17 @@ namespace mash
 		eMASH_STATUS OnPostResolutionChangeIntermediate(uint32 width, uint32 height);
 
 		std::map<MashMaterialDependentResourceBase*, MashList<MashMaterialDependentResourceBase*> > m_onDependencyCompileResources;
+		std::map<const MashVertex*, MashTransientVertexBuffer*> m_transientVertexBuffers;
 	private:
 		MashTexture* FindTexture(const MashStringc &name);
 		virtual MashTexture* LoadTextureFromFile(const MashStringc &fileName) = 0;
+
+		/*
+			Loads a list of unique, uncached textures. Loaded textures must be added to the cache.
+			By default each texture is loaded with LoadTextureFromFile(). Renderers can override
+			this to decode textures in parallel.
+		*/
+		virtual void LoadTexturesFromFiles(const MashStringc *fileNames, uint32 count);
 	public:
 
 		virtual eMASH_STATUS EndRender();
@@ -100,6 +111,8 @@ namespace mash
 		MashGeometryBatch* CreateGeometryBatch(MashMaterial *material, ePRIMITIVE_TYPE type, MashGeometryBatch::eBATCH_TYPE batchType);
 
 		MashTexture* GetTexture(const MashStringc &fileName);
+		eMASH_STATUS GetTextures(const MashStringc *fileNames, uint32 count, MashTexture **out = 0);
+		MashTransientVertexBuffer* GetTransientVertexBuffer(MashVertex *vertexDecl);
 		bool RemoveTextureFromCache(mash::MashTexture *texture);
 
 		void RemoveAllTexturesFromCache();
@@ -109,6 +122,7 @@ namespace mash
 
 		eMASH_STATUS DrawFullScreenQuad();
 		eMASH_STATUS DrawFullScreenQuadTexCoords(const mash::MashRectangle2 &texCoords);
+		eMASH_STATUS DrawQuadRegion(const mash::MashRectangle2 &region, const mash::MashRectangle2 &texCoords);
 
 		eMASH_STATUS DrawTextureClip(mash::MashTexture *texture,
 				const mash::MashRectangle2 &screenPos,
@@ -125,6 +139,22 @@ namespace mash
 		uint32 GetCurrentFrameTechniqueChangeCount()const;
 		void _IncrementCurrentFrameTechniqueChanges();
 
+		uint32 GetCurrentFrameConstantBytesUploaded()const;
+		uint32 GetCurrentFrameConstantUploadsSkipped()const;
+
+		/*
+			Called by effects when parameter data is sent to the GPU, or
+			when an upload was skipped because the data had not changed.
+		*/
+		void _OnConstantDataUploaded(uint32 sizeInBytes);
+		void _OnConstantUploadSkipped();
+
+		/*
+			Returns true if the data differs from the last data uploaded
+			to this parameter. Frame counters are updated.
+		*/
+		bool _OnConstantDataChange(MashEffectParamHandle *parameter, const void *data, uint32 sizeInBytes);
+
 		void _OnViewportChange();
 		void _SetSceneManager(mash::MashSceneManager *pSceneManager);
 
@@ -159,6 +189,38 @@ namespace mash
 		return m_currentFrameTechniqueChangeCount;
 	}
 
+	inline uint32 MashVideoIntermediate::GetCurrentFrameConstantBytesUploaded()const
+	{
+		return m_currentFrameConstantBytesUploaded;
+	}
+
+	inline uint32 MashVideoIntermediate::GetCurrentFrameConstantUploadsSkipped()const
+	{
+		return m_currentFrameConstantUploadsSkipped;
+	}
+
+	inline void MashVideoIntermediate::_OnConstantDataUploaded(uint32 sizeInBytes)
+	{
+		m_currentFrameConstantBytesUploaded += sizeInBytes;
+	}
+
+	inline void MashVideoIntermediate::_OnConstantUploadSkipped()
+	{
+		++m_currentFrameConstantUploadsSkipped;
+	}
+
+	inline bool MashVideoIntermediate::_OnConstantDataChange(MashEffectParamHandle *parameter, const void *data, uint32 sizeInBytes)
+	{
+		if (!parameter->_OnDataChange(data, sizeInBytes))
+		{
+			++m_currentFrameConstantUploadsSkipped;
+			return false;
+		}
+
+		m_currentFrameConstantBytesUploaded += sizeInBytes;
+		return true;
+	}
+
 	inline uint32 MashVideoIntermediate::GetCurrentFrameDrawCount()const
 	{
 		return m_currentDrawCount;
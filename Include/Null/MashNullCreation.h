@@ -0,0 +1,26 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+
+#ifndef _MASH_NULL_CREATION_H_
+#define _MASH_NULL_CREATION_H_
+
+#include "MashCompileSettings.h"
+namespace mash
+{
+    //! Called to create a null renderer.
+    /*!
+        The null renderer keeps all resources in memory and records
+        draw calls, state changes and buffer updates into a command log
+        instead of sending them to the GPU. It is intended for automated
+        tests and CPU side benchmarks. See MashNullVideo.
+
+        This is usually used with sMashDeviceSettings::headless set to true
+        so that no window is created.
+    */
+	_MASH_EXPORT MashVideo* CreateMashNullDevice();
+}
+
+#endif
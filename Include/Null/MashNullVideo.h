@@ -0,0 +1,135 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+
+#ifndef _MASH_NULL_VIDEO_H_
+#define _MASH_NULL_VIDEO_H_
+
+#include "MashVideoIntermediate.h"
+#include "MashArray.h"
+
+namespace mash
+{
+	enum eNULL_COMMAND_TYPE
+	{
+		aNULL_CMD_BEGIN_RENDER,
+		aNULL_CMD_END_RENDER,
+		aNULL_CMD_CLEAR_TARGET,
+		aNULL_CMD_SET_RENDER_TARGET,
+		aNULL_CMD_SET_VIEWPORT,
+		aNULL_CMD_SET_RASTERIZER_STATE,
+		aNULL_CMD_SET_BLEND_STATE,
+		aNULL_CMD_SET_VERTEX_FORMAT,
+		aNULL_CMD_SET_EFFECT,
+		aNULL_CMD_SET_PARAMETER,
+		aNULL_CMD_SET_TEXTURE,
+		aNULL_CMD_UPDATE_BUFFER,
+		aNULL_CMD_UPDATE_TEXTURE,
+		aNULL_CMD_DRAW_INDEXED,
+		aNULL_CMD_DRAW_VERTEX,
+		aNULL_CMD_DRAW_VERTEX_INSTANCED,
+		aNULL_CMD_DRAW_INDEXED_INSTANCED
+	};
+
+	/*!
+		A single command recorded by the null renderer.
+	*/
+	struct sNullCommand
+	{
+		eNULL_COMMAND_TYPE type;
+
+		/*!
+			Object the command operates on. This is the mesh buffer for draws,
+			the effect for effect changes, the parameter handle for parameter updates,
+			the texture for texture binds and updates, the vertex or index buffer
+			for buffer updates and the render surface for render target changes.
+			May be NULL.
+		*/
+		const void *object;
+
+		/*!
+			Draws : vertex count, index count, primitive count, instance count.
+			State changes : state index.
+			Clears : clear flags.
+			Parameter updates : size in bytes, element count.
+			Texture binds : texture id, texture slot.
+			Buffer and texture updates : size in bytes, lock type.
+		*/
+		uint32 args[4];
+
+		sNullCommand():type(aNULL_CMD_BEGIN_RENDER), object(0)
+		{
+			args[0] = args[1] = args[2] = args[3] = 0;
+		}
+	};
+
+	/*!
+		Per frame counters collected by the null renderer. These are
+		always collected, even when the command log is disabled.
+	*/
+	struct sNullFrameStats
+	{
+		uint32 drawCount;
+		uint32 primitiveCount;
+		uint32 instanceCount;
+
+		//! Rasterizer, blend, vertex format, viewport and render target changes.
+		uint32 stateChangeCount;
+		uint32 effectChangeCount;
+		uint32 parameterUpdateCount;
+		uint32 textureBindCount;
+		uint32 bufferUpdateCount;
+		uint32 bufferUpdateBytes;
+
+		sNullFrameStats():drawCount(0), primitiveCount(0), instanceCount(0), stateChangeCount(0),
+			effectChangeCount(0), parameterUpdateCount(0), textureBindCount(0), bufferUpdateCount(0),
+			bufferUpdateBytes(0){}
+	};
+
+	/*!
+		Renderer created from CreateMashNullDevice().
+
+		No GPU work is done. Instead, each call made to the renderer and its
+		resources is recorded so that tests and benchmarks can inspect exactly what
+		the engine submitted. The log is cleared at the start of each frame (BeginRender()),
+		so after EndRender() it holds the complete command stream of that frame.
+
+		Cast the renderer returned from MashDevice::GetRenderer() to this type to
+		access the log.
+	*/
+	class MashNullVideo : public MashVideoIntermediate
+	{
+	public:
+		MashNullVideo():MashVideoIntermediate(){}
+		virtual ~MashNullVideo(){}
+
+		//! Enables or disables the command log.
+		/*!
+			Frame statistics are still collected when disabled. Disabling
+			the log is useful for benchmarks where the cost of recording each
+			command should not be measured.
+
+			\param enable Enable or disable the log. Default is true.
+		*/
+		virtual void SetCommandLogEnabled(bool enable) = 0;
+
+		//! Returns true if commands are being recorded.
+		virtual bool GetCommandLogEnabled()const = 0;
+
+		//! Commands recorded since the last BeginRender() call.
+		virtual const MashArray<sNullCommand>& GetCommandLog()const = 0;
+
+		//! Clears the command log.
+		virtual void ClearCommandLog() = 0;
+
+		//! Statistics for the frame currently being rendered.
+		virtual const sNullFrameStats& GetCurrentFrameStats()const = 0;
+
+		//! Statistics for the last frame that completed with EndRender().
+		virtual const sNullFrameStats& GetLastFrameStats()const = 0;
+	};
+}
+
+#endif
@@ -0,0 +1,114 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+
+#ifndef _MASH_TEXTURE_COOKER_H_
+#define _MASH_TEXTURE_COOKER_H_
+
+#include "MashCompileSettings.h"
+#include "MashDataTypes.h"
+#include "MashEnum.h"
+
+namespace mash
+{
+	class MashFileManager;
+	class MashFileStream;
+
+	enum eTEXTURE_COOK_FORMAT
+	{
+		//! Uncompressed 32bit BGRA.
+		aTEXTURE_COOK_FORMAT_RGBA8,
+		//! Block compressed, no alpha. 4 bits per pixel.
+		aTEXTURE_COOK_FORMAT_DXT1,
+		//! Block compressed with alpha. 8 bits per pixel.
+		aTEXTURE_COOK_FORMAT_DXT5,
+		//! DXT5 if the source image has an alpha channel, otherwise DXT1.
+		aTEXTURE_COOK_FORMAT_AUTO_DXT
+	};
+
+	struct sTextureCookSettings
+	{
+		eTEXTURE_COOK_FORMAT format;
+
+		//! Stores a full mip chain in the file.
+		bool generateMipmaps;
+
+		//! Resizes the image up to the nearest power of two.
+		bool resizeToPowerOfTwo;
+
+		//! Flips the image vertically.
+		/*!
+			OpenGL expects images to be flipped. Set this to true for files loaded by
+			the OpenGL renderer and false for files loaded by the D3D10 renderer.
+		*/
+		bool invertY;
+
+		sTextureCookSettings():format(aTEXTURE_COOK_FORMAT_AUTO_DXT), generateMipmaps(true),
+			resizeToPowerOfTwo(true), invertY(true){}
+	};
+
+	//! Information about a cooked texture.
+	struct sTextureCookInfo
+	{
+		uint32 width;
+		uint32 height;
+		uint32 mipmapCount;
+		eTEXTURE_COOK_FORMAT format;
+
+		//! Size of all mip levels, not including the file header.
+		uint32 dataSizeInBytes;
+
+		sTextureCookInfo():width(0), height(0), mipmapCount(0), format(aTEXTURE_COOK_FORMAT_RGBA8), dataSizeInBytes(0){}
+	};
+
+	//! Converts an image into a DDS file that can be uploaded without any processing.
+	/*!
+		The usual texture loading path decodes the image, resizes it to a power of two,
+		flips it and generates mipmaps each time it is loaded. Cooking does this work once,
+		offline, and optionally block compresses the result to reduce memory.
+
+		Cooked files are standard DDS files so they can be loaded through MashVideo::GetTexture()
+		on any renderer. The OpenGL renderer uploads them directly. The D3D10 renderer loads them
+		through D3DX.
+
+		\param sourceData Image file data. Any format the renderer can load from file (png, jpg, tga, bmp, etc...).
+		\param sourceSizeInBytes Size of sourceData.
+		\param settings Cook settings.
+		\param out The DDS file will be appended to this stream.
+		\param info Optional. Filled with information about the cooked texture.
+		\return Ok on success, failed otherwise.
+	*/
+	_MASH_EXPORT eMASH_STATUS CookTexture(const void *sourceData, uint32 sourceSizeInBytes,
+		const sTextureCookSettings &settings, MashFileStream *out, sTextureCookInfo *info = 0);
+
+	//! Returns true if the data is a DDS file that can be uploaded to OpenGL without processing.
+	/*!
+		CookTexture() tags the files it writes in the reserved part of the DDS header.
+		Only tagged files that were flipped for OpenGL and store a full mip chain
+		are uploaded directly. Other DDS files are decoded, flipped and mipmapped
+		like any other image.
+
+		\param data DDS file data.
+		\param sizeInBytes Size of data.
+		\return True if the file can be uploaded directly.
+	*/
+	_MASH_EXPORT bool IsCookedTextureDirectUpload(const void *data, uint32 sizeInBytes);
+
+	//! Cooks an image file and saves the result to file.
+	/*!
+		See CookTexture().
+
+		\param fileManager Used to read and write the files.
+		\param sourceFile Image to cook.
+		\param outputFile Output file. This should have a .dds extension.
+		\param settings Cook settings.
+		\param info Optional. Filled with information about the cooked texture.
+		\return Ok on success, failed otherwise.
+	*/
+	_MASH_EXPORT eMASH_STATUS CookTextureFile(MashFileManager *fileManager, const int8 *sourceFile, const int8 *outputFile,
+		const sTextureCookSettings &settings, sTextureCookInfo *info = 0);
+}
+
+#endif
@@ -0,0 +1,640 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+
+/*
+    Times the engine's hot paths against their reference implementations and
+    prints the results. Nothing here can fail, correctness is covered by the
+    unit tests. Benchmarks that need a renderer run once the device has been
+    created.
+*/
+
+#include "MashInclude.h"
+
+#include "../SupportLib/MemoryAllocator/MashDefaultMemoryAllocator.h"
+#include "D3D10/MashD3D10Creation.h"
+#include "OpenGL3/MashOpenGL3Creation.h"
+#include "OpenGL3/MashTextureCooker.h"
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+
+#if defined (MASH_WINDOWS) && !defined(__MINGW32__)
+    #define USE_DIRECTX
+#endif
+
+using namespace mash;
+
+f64 ElapsedMs(clock_t start)
+{
+    return (f64)(clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+}
+
+namespace ContainerBenchmark
+{
+    void ArrayGrowth()
+    {
+        const uint32 count = 200000;
+        clock_t start = clock();
+        MashArray<MashStringc> strings;
+        for(uint32 i = 0; i < count; ++i)
+            strings.PushBack("a long string that will not fit in the string pool");
+
+        printf("Array of %d strings built in %.2fms\n", count, ElapsedMs(start));
+    }
+
+    void ListPush()
+    {
+        const uint32 count = 500000;
+        clock_t start = clock();
+        MashList<uint32, MashMemoryPoolSimple> heapList;
+        for(uint32 i = 0; i < count; ++i)
+            heapList.PushBack(i);
+        heapList.DeleteData();
+        const f64 heapTime = ElapsedMs(start);
+
+        start = clock();
+        MashList<uint32> pooledList;
+        for(uint32 i = 0; i < count; ++i)
+            pooledList.PushBack(i);
+        pooledList.DeleteData();
+
+        printf("List push : heap %.2fms, pooled %.2fms\n", heapTime, ElapsedMs(start));
+    }
+
+    void Run()
+    {
+        ArrayGrowth();
+        ListPush();
+    }
+}
+
+/*
+    Compares the compile time selected math backend (see MashCompileSettings.h)
+    against the scalar kernels.
+*/
+namespace MathBenchmark
+{
+    static const uint32 g_benchIterations = 1000000;
+
+    f32 RandomFloat()
+    {
+        return ((f32)rand() / (f32)RAND_MAX) * 4.0f - 2.0f;
+    }
+
+    void Print(const int8 *name, f64 scalarTime, clock_t simdStart)
+    {
+        printf("%s : scalar %.2fms, backend %.2fms\n", name, scalarTime, ElapsedMs(simdStart));
+    }
+
+    void MatrixMultiply()
+    {
+        MashMatrix4 a(false), b(false), scalarResult(false);
+        for(uint32 i = 0; i < 16; ++i)
+        {
+            a.v[i] = RandomFloat();
+            b.v[i] = RandomFloat();
+        }
+
+        MashMatrix4 result(false);
+        clock_t start = clock();
+        for(uint32 i = 0; i < g_benchIterations; ++i)
+        {
+            simd::MatrixMultiplyScalar(a.v, b.v, scalarResult.v);
+            a.v[i & 15] = scalarResult.v[0] * 0.0001f;
+        }
+        const f64 scalarTime = ElapsedMs(start);
+
+        start = clock();
+        for(uint32 i = 0; i < g_benchIterations; ++i)
+        {
+            result = a * b;
+            a.v[i & 15] = result.v[0] * 0.0001f;
+        }
+        Print("Matrix multiply", scalarTime, start);
+    }
+
+    void MatrixInverse()
+    {
+        MashMatrix4 a(MashQuaternion(0.7071f, 0.0f, 0.7071f, 0.0f), MashVector3(1.0f, 2.0f, 3.0f), MashVector3(2.0f, 2.0f, 2.0f));
+        MashMatrix4 scalarResult(a);
+        MashMatrix4 result(a);
+
+        clock_t start = clock();
+        for(uint32 i = 0; i < g_benchIterations; ++i)
+            simd::MatrixInverseScalar(scalarResult.v, scalarResult.v);
+        const f64 scalarTime = ElapsedMs(start);
+
+        start = clock();
+        for(uint32 i = 0; i < g_benchIterations; ++i)
+            result.Invert();
+        Print("Matrix inverse", scalarTime, start);
+    }
+
+    void QuaternionInterpolation()
+    {
+        MashQuaternion a, b, result, scalarResult;
+        a.SetEuler(10.0f, 45.0f, 0.0f);
+        b.SetEuler(-30.0f, 120.0f, 60.0f);
+
+        const f32 step = 1.0f / g_benchIterations;
+
+        clock_t start = clock();
+        for(uint32 i = 0; i < g_benchIterations; ++i)
+            simd::QuaternionSlerpScalar(a.v, b.v, i * step, scalarResult.v);
+        f64 scalarTime = ElapsedMs(start);
+
+        start = clock();
+        for(uint32 i = 0; i < g_benchIterations; ++i)
+            result.Slerp(a, b, i * step);
+        Print("Quaternion slerp", scalarTime, start);
+
+        start = clock();
+        for(uint32 i = 0; i < g_benchIterations; ++i)
+            simd::QuaternionNlerpScalar(a.v, b.v, i * step, scalarResult.v);
+        scalarTime = ElapsedMs(start);
+
+        start = clock();
+        for(uint32 i = 0; i < g_benchIterations; ++i)
+            result.Nlerp(a, b, i * step);
+        Print("Quaternion nlerp", scalarTime, start);
+    }
+
+    void VectorTransform()
+    {
+        MashMatrix4 m(MashQuaternion(0.7071f, 0.7071f, 0.0f, 0.0f), MashVector3(1.0f, 2.0f, 3.0f), MashVector3(1.0f, 2.0f, 3.0f));
+        MashVector3 point(4.0f, 5.0f, 6.0f);
+        MashVector3 result, scalarResult;
+
+        clock_t start = clock();
+        for(uint32 i = 0; i < g_benchIterations; ++i)
+        {
+            simd::TransformPointScalar(m.v, point.v, scalarResult.v);
+            point.x = scalarResult.z * 0.0001f;
+        }
+        const f64 scalarTime = ElapsedMs(start);
+
+        start = clock();
+        for(uint32 i = 0; i < g_benchIterations; ++i)
+        {
+            m.TransformVector(point, result);
+            point.x = result.z * 0.0001f;
+        }
+        Print("Vector transform", scalarTime, start);
+    }
+
+    void AABBTransform()
+    {
+        MashMatrix4 m(MashQuaternion(0.9238f, 0.0f, 0.3826f, 0.0f), MashVector3(10.0f, -2.0f, 3.0f), MashVector3(1.0f, 2.0f, 0.5f));
+        const MashAABB box(MashVector3(-1.0f, -2.0f, -3.0f), MashVector3(3.0f, 2.0f, 1.0f));
+        MashAABB result, scalarResult;
+
+        clock_t start = clock();
+        for(uint32 i = 0; i < g_benchIterations; ++i)
+            simd::AABBTransformScalar(m.v, box.min.v, box.max.v, scalarResult.min.v, scalarResult.max.v);
+        const f64 scalarTime = ElapsedMs(start);
+
+        start = clock();
+        for(uint32 i = 0; i < g_benchIterations; ++i)
+        {
+            result = box;
+            result.Transform(m);
+        }
+        Print("AABB transform", scalarTime, start);
+    }
+
+    void Run()
+    {
+        printf("Math kernels : %s\n", kernels::GetKernelBackendName());
+        MatrixMultiply();
+        MatrixInverse();
+        QuaternionInterpolation();
+        VectorTransform();
+        AABBTransform();
+    }
+}
+
+namespace LightClusterBenchmark
+{
+    f32 RandomValue()
+    {
+        return ((f32)rand() / (f32)RAND_MAX) * 4.0f - 2.0f;
+    }
+
+    void Run()
+    {
+        const uint32 lightCount = 4096;
+        MashArray<MashLightClusterGrid::sLightVolume> lights;
+        srand(2);
+        for(uint32 i = 0; i < lightCount; ++i)
+        {
+            MashLightClusterGrid::sLightVolume light;
+            light.type = aLIGHT_POINT;
+            light.position = MashVector3(RandomValue() * 50.0f, RandomValue() * 25.0f, 5.0f + ((RandomValue() + 2.0f) * 60.0f));
+            light.range = 2.0f + (RandomValue() + 2.0f);
+            light.direction = MashVector3(0.0f, 0.0f, 1.0f);
+            light.cosOuterCone = 0.0f;
+            lights.PushBack(light);
+        }
+
+        MashLightClusterGrid grid;
+        grid.SetProjection(math::DegsToRads(60.0f), 16.0f / 9.0f, 1.0f, 500.0f);
+
+        const uint32 frames = 20;
+        grid.SetMaxThreads(1);
+        clock_t start = clock();
+        for(uint32 i = 0; i < frames; ++i)
+            grid.Build(lights.Pointer(), lightCount);
+        const f64 singleTime = ElapsedMs(start);
+
+        grid.SetMaxThreads(0);
+        start = clock();
+        for(uint32 i = 0; i < frames; ++i)
+            grid.Build(lights.Pointer(), lightCount);
+        const f64 threadedTime = ElapsedMs(start);
+
+        //clock() is process time so the threaded time is total cpu time
+        printf("Light clusters (%d lights, %d indices) : single thread %.2fms, threaded cpu %.2fms per frame\n",
+               lightCount, grid.GetLightIndexCount(), singleTime / frames, threadedTime / frames);
+    }
+}
+
+namespace TextParserBenchmark
+{
+    void Run()
+    {
+        //generated COLLADA style mesh
+        const uint32 floatCount = 3000000;
+        const uint32 indexCount = 1500000;
+        MashArray<int8> document;
+        document.Reserve(floatCount * 12 + indexCount * 6 + 512);
+        int8 buffer[32];
+        const int8 *header = "<?xml version=\"1.0\"?>\n<COLLADA><library_geometries><geometry><mesh><source>"
+            "<float_array count=\"3000000\">\n";
+        document.Append(header, strlen(header));
+        srand(4);
+        for(uint32 i = 0; i < floatCount; ++i)
+        {
+            const int32 length = sprintf(buffer, ((i % 3) == 2) ? "%.6f\n" : "%.6f ", (((f64)rand() / RAND_MAX) - 0.5) * 200.0);
+            document.Append(buffer, length);
+        }
+
+        const int8 *middle = "</float_array></source><triangles count=\"500000\"><p>";
+        document.Append(middle, strlen(middle));
+        for(uint32 i = 0; i < indexCount; ++i)
+        {
+            const int32 length = sprintf(buffer, "%d ", (int32)(i % 65536));
+            document.Append(buffer, length);
+        }
+
+        const int8 *footer = "</p></triangles></mesh></geometry></library_geometries></COLLADA>";
+        document.Append(footer, strlen(footer) + 1);
+
+        MashArray<int8> documentOut;
+        documentOut.Resize(document.Size());
+        MashArray<const int8*> elementText;
+        const int8 *names[] = {"float_array", "p"};
+
+        clock_t start = clock();
+        text::ExtractElementText(document.Pointer(), names, 2, documentOut.Pointer(), elementText);
+        const f64 extractTime = ElapsedMs(start);
+
+        MashArray<f32> floats;
+        floats.Resize(floatCount);
+        MashArray<f32> expected;
+        expected.Resize(floatCount);
+        MashArray<int32> indices;
+        indices.Resize(indexCount);
+
+        start = clock();
+        text::ParseFloatArray(elementText[0], floats.Pointer(), floatCount);
+        text::ParseIntArray(elementText[1], indices.Pointer(), indexCount);
+        const f64 parseTime = ElapsedMs(start);
+
+        //the token copy and atof loop used before
+        start = clock();
+        const int8 *str = elementText[0];
+        uint32 tokenLength = 0;
+        uint32 expectedCount = 0;
+        for(;; ++str)
+        {
+            if ((*str == 0) || isspace(*str))
+            {
+                if ((tokenLength > 0) && (expectedCount < floatCount))
+                {
+                    buffer[tokenLength] = 0;
+                    expected[expectedCount++] = atof(buffer);
+                }
+                tokenLength = 0;
+
+                if (*str == 0)
+                    break;
+            }
+            else
+                buffer[tokenLength++] = *str;
+        }
+        const f64 atofTime = ElapsedMs(start);
+
+        printf("COLLADA arrays (%d floats, %d indices, %.1fMB) : extract %.2fms, parse %.2fms, atof floats %.2fms\n",
+               floatCount, indexCount, (f64)document.Size() / (1024.0 * 1024.0),
+               extractTime, parseTime, atofTime);
+    }
+}
+
+/*
+    Compares loading a source image through the default path against loading
+    the same image cooked. Needs a device so it runs from the game loop.
+*/
+namespace TextureLoadBenchmark
+{
+    void CreateTGA(uint32 width, uint32 height, MashArray<uint8> &out)
+    {
+        const uint8 header[18] = {0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            (uint8)(width & 0xff), (uint8)(width >> 8), (uint8)(height & 0xff), (uint8)(height >> 8), 32, 0x28};
+
+        out.Clear();
+        out.Insert(0, header, 18);
+        for(uint32 y = 0; y < height; ++y)
+        {
+            for(uint32 x = 0; x < width; ++x)
+            {
+                out.PushBack((uint8)x);
+                out.PushBack((uint8)y);
+                out.PushBack((uint8)(x ^ y));
+                out.PushBack(((x / 8) & 1) ? 255 : 128);
+            }
+        }
+    }
+
+    void Run(MashDevice *device)
+    {
+        MashFileManager *fileManager = device->GetFileManager();
+        MashArray<uint8> sourceImage;
+        CreateTGA(1000, 1000, sourceImage);
+        if (fileManager->WriteFile("cookerBenchmark.tga", aFILE_IO_BINARY, sourceImage.Pointer(), sourceImage.Size()) == aMASH_FAILED)
+            return;
+
+        sTextureCookSettings settings;
+#ifdef USE_DIRECTX
+        settings.invertY = false;
+#endif
+        sTextureCookInfo info;
+        if (CookTextureFile(fileManager, "cookerBenchmark.tga", "cookerBenchmark.dds", settings, &info) == aMASH_FAILED)
+            return;
+
+        //the default path holds a full uncompressed mip chain
+        uint32 uncookedSize = 0;
+        for(uint32 w = 1024, h = 1024; ; w = math::Max<uint32>(w / 2, 1), h = math::Max<uint32>(h / 2, 1))
+        {
+            uncookedSize += w * h * 4;
+            if ((w == 1) && (h == 1))
+                break;
+        }
+
+        MashVideo *renderer = device->GetRenderer();
+        MashTimer *timer = device->GetTimer();
+        const uint32 loadCount = 10;
+        uint64 uncookedTime = 0;
+        uint64 cookedTime = 0;
+        for(uint32 i = 0; i < loadCount; ++i)
+        {
+            uint64 start = timer->GetTimeSinceProgramStart();
+            MashTexture *texture = renderer->GetTexture("cookerBenchmark.tga");
+            uncookedTime += timer->GetTimeSinceProgramStart() - start;
+            if (texture)
+                renderer->RemoveTextureFromCache(texture);
+
+            start = timer->GetTimeSinceProgramStart();
+            texture = renderer->GetTexture("cookerBenchmark.dds");
+            cookedTime += timer->GetTimeSinceProgramStart() - start;
+            if (texture)
+                renderer->RemoveTextureFromCache(texture);
+        }
+
+        printf("Texture load x%d. Source : %llums, %u bytes. Cooked : %llums, %u bytes.\n", loadCount,
+            (unsigned long long)uncookedTime, uncookedSize, (unsigned long long)cookedTime, info.dataSizeInBytes);
+    }
+}
+
+/*
+    Times building a kd tree collider and casting rays against it one at a
+    time and as a batch.
+*/
+namespace ColliderBenchmark
+{
+    f32 RandomValue()
+    {
+        return ((f32)rand() / (f32)RAND_MAX) * 2.0f - 1.0f;
+    }
+
+    void Run(MashDevice *device)
+    {
+        MashSceneManager *sceneManager = device->GetSceneManager();
+        MashMaterial *material = device->GetRenderer()->GetMaterialManager()->GetStandardMaterial(MashMaterialManager::aSTANDARD_MATERIAL_DEFAULT_MESH);
+        if (!material)
+            return;
+
+        MashMesh *mesh = sceneManager->CreateStaticMesh();
+        if (sceneManager->GetMeshBuilder()->CreateSphere(mesh, 10.0f, 256, material->GetVertexDeclaration()) == aMASH_FAILED)
+        {
+            mesh->Drop();
+            return;
+        }
+
+        MashTriangleBuffer *triangleBuffer = sceneManager->CreateTriangleBuffer(mesh);
+        mesh->Drop();
+        if (!triangleBuffer)
+            return;
+
+        const uint32 builds = 5;
+        MashTriangleCollider *collider = 0;
+        clock_t start = clock();
+        for(uint32 i = 0; i < builds; ++i)
+        {
+            if (collider)
+                collider->Drop();
+
+            collider = sceneManager->CreateTriangleCollider(&triangleBuffer, 1, aTRIANGLE_COLLIDER_KD_TREE);
+        }
+        const f64 buildTime = ElapsedMs(start) / builds;
+        const uint32 triangleCount = triangleBuffer->GetTriangleCount();
+        triangleBuffer->Drop();
+
+        if (!collider)
+            return;
+
+        //rays start around the sphere and point roughly at it
+        const uint32 rayCount = 200000;
+        MashArray<MashRay> rays;
+        rays.Reserve(rayCount);
+        srand(5);
+        for(uint32 i = 0; i < rayCount; ++i)
+        {
+            MashVector3 origin(RandomValue(), RandomValue(), RandomValue());
+            origin.Normalize();
+            origin *= 20.0f;
+
+            MashVector3 dir = MashVector3(RandomValue() * 5.0f, RandomValue() * 5.0f, RandomValue() * 5.0f) - origin;
+            dir.Normalize();
+            rays.PushBack(MashRay(origin, dir));
+        }
+
+        const MashTransformState transform;
+        uint32 singleHits = 0;
+        start = clock();
+        for(uint32 i = 0; i < rayCount; ++i)
+        {
+            sTriPickResult result;
+            if (collider->GetClosestTriangle(rays[i], transform, result))
+                ++singleHits;
+        }
+        const f64 singleTime = ElapsedMs(start);
+
+        MashArray<sTriPickResult> results(rayCount);
+        start = clock();
+        const uint32 batchHits = collider->GetClosestTriangles(rays.Pointer(), rayCount, transform, results.Pointer());
+        const f64 batchTime = ElapsedMs(start);
+
+        collider->Drop();
+
+        printf("KD tree (%d triangles) : build %.2fms. Rays (%d, %d hits) : single %.0f rays/sec, batch %.0f rays/sec\n",
+            triangleCount, buildTime, rayCount, singleHits,
+            rayCount * 1000.0 / math::Max<f64>(singleTime, 0.001),
+            rayCount * 1000.0 / math::Max<f64>(batchTime, 0.001));
+
+        if (batchHits != singleHits)
+            printf("KD tree batch hit count mismatch : %d\n", batchHits);
+    }
+}
+
+/*
+    Compares loading a scene file saved with and without cooked meshes.
+*/
+namespace SceneLoadBenchmark
+{
+    uint64 TimeLoad(MashDevice *device, const int8 *fileName, uint32 loadCount)
+    {
+        MashSceneManager *sceneManager = device->GetSceneManager();
+        sLoadSceneSettings loadSettings;
+        uint64 time = 0;
+        for(uint32 i = 0; i < loadCount; ++i)
+        {
+            MashList<MashSceneNode*> rootNodes;
+            const uint64 start = device->GetTimer()->GetTimeSinceProgramStart();
+            sceneManager->LoadSceneFile(fileName, rootNodes, loadSettings);
+            time += device->GetTimer()->GetTimeSinceProgramStart() - start;
+            sceneManager->RemoveAllSceneNodes();
+        }
+
+        return time;
+    }
+
+    void Run(MashDevice *device)
+    {
+        MashSceneManager *sceneManager = device->GetSceneManager();
+        MashMaterial *material = device->GetRenderer()->GetMaterialManager()->GetStandardMaterial(MashMaterialManager::aSTANDARD_MATERIAL_DEFAULT_MESH);
+        if (!material)
+            return;
+
+        const uint32 entityCount = 16;
+        MashList<MashSceneNode*> rootNodes;
+        for(uint32 i = 0; i < entityCount; ++i)
+        {
+            MashMesh *mesh = sceneManager->CreateStaticMesh();
+            sceneManager->GetMeshBuilder()->CreateSphere(mesh, 10.0f, 64, material->GetVertexDeclaration());
+
+            MashModel *model = sceneManager->CreateModel();
+            model->Append(&mesh);
+            mesh->Drop();
+
+            MashStringc name;
+            sceneManager->GenerateUniqueSceneNodeName(name);
+            MashEntity *entity = sceneManager->AddEntity(0, model, name);
+            entity->SetMaterialToAllSubEntities(material);
+            model->Drop();
+            rootNodes.PushBack(entity);
+        }
+
+        sSaveSceneSettings saveSettings;
+        const eMASH_STATUS uncookedStatus = sceneManager->SaveSceneFile("sceneBenchmark.nss", rootNodes, saveSettings);
+        saveSettings.cookMeshes = true;
+        const eMASH_STATUS cookedStatus = sceneManager->SaveSceneFile("sceneBenchmarkCooked.nss", rootNodes, saveSettings);
+        sceneManager->RemoveAllSceneNodes();
+
+        if ((uncookedStatus == aMASH_FAILED) || (cookedStatus == aMASH_FAILED))
+            return;
+
+        const uint32 loadCount = 10;
+        const uint64 uncookedTime = TimeLoad(device, "sceneBenchmark.nss", loadCount);
+        const uint64 cookedTime = TimeLoad(device, "sceneBenchmarkCooked.nss", loadCount);
+
+        printf("Scene load x%d (%d entities). Source : %llums. Cooked : %llums.\n", loadCount, entityCount,
+            (unsigned long long)uncookedTime, (unsigned long long)cookedTime);
+    }
+}
+
+class MainLoop : public mash::MashGameLoop
+{
+private:
+    MashDevice *m_device;
+public:
+    MainLoop(mash::MashDevice *device):m_device(device){}
+    virtual ~MainLoop(){}
+
+    bool Initialise()
+    {
+        ColliderBenchmark::Run(m_device);
+        SceneLoadBenchmark::Run(m_device);
+        TextureLoadBenchmark::Run(m_device);
+
+        //nothing to render, exits the loop
+        return true;
+    }
+
+    bool Update(f32 dt)
+    {
+        return false;
+    }
+
+    void Render()
+    {
+    }
+};
+
+int main()
+{
+    ContainerBenchmark::Run();
+    MathBenchmark::Run();
+    LightClusterBenchmark::Run();
+    TextParserBenchmark::Run();
+
+    sMashDeviceSettings deviceSettings;
+#ifdef USE_DIRECTX
+    deviceSettings.rendererFunctPtr = CreateMashD3D10Device;
+#else
+    deviceSettings.rendererFunctPtr = CreateMashOpenGL3Device;
+#endif
+    deviceSettings.fullScreen = false;
+    deviceSettings.screenWidth = 800;
+    deviceSettings.screenHeight = 600;
+    deviceSettings.enableVSync = false;
+    deviceSettings.rootPaths.PushBack("../../../../../../Media/Materials");
+
+    MashDevice *device = CreateDevice(deviceSettings);
+    if (!device)
+        return 1;
+
+    device->SetWindowCaption("Benchmarks");
+
+    MainLoop *mainLoop = MASH_NEW_COMMON MainLoop(device);
+    device->SetGameLoop(mainLoop);
+    mainLoop->Drop();
+
+    device->Drop();
+
+    return 0;
+}
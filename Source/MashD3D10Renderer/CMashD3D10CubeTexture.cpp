@@ -83,7 +83,7 @@ namespace mash
 		return aUSAGE_DYNAMIC;
 	}
 
-	eMASH_STATUS CMashD3D10CubeTexture::Lock(eBUFFER_LOCK eType, void **pData, uint32 iLevel, uint32 iFace)
+	eMASH_STATUS CMashD3D10CubeTexture::Lock(eBUFFER_LOCK eType, void **pData, uint32 iLevel, uint32 iFace, uint32 *pRowPitch)
 	{
 		/*
 			Make sure this resource is not currently mapped as a shader input.
@@ -99,6 +99,10 @@ namespace mash
 
 		(*pData) = lockedTextureData.pData;
 
+		//rows can be padded by the driver
+		if (pRowPitch)
+			*pRowPitch = lockedTextureData.RowPitch;
+
 		return aMASH_OK;
 	}
 
@@ -39,7 +39,7 @@ namespace mash
 		~CMashD3D10CubeTexture();
 
 		MashTexture* Clone(const MashStringc &sName)const;
-		eMASH_STATUS Lock(eBUFFER_LOCK eType, void **pData, uint32 iLevel = 0, uint32 iFace = 0);
+		eMASH_STATUS Lock(eBUFFER_LOCK eType, void **pData, uint32 iLevel = 0, uint32 iFace = 0, uint32 *pRowPitch = 0);
 		eMASH_STATUS Unlock(uint32 iLevel = 0, uint32 iFace = 0);
 		eRESOURCE_TYPE GetType()const;
 		const MashStringc& GetName()const;
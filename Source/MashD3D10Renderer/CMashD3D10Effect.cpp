@@ -304,7 +304,7 @@ namespace mash
 		for(uint32 i = 0; i < aPROGRAM_UNKNOWN; ++i)
 		{
 			if (m_programs[i])
-				m_programs[i]->_OnUpdate(this, pSkinManager, pRenderInfo);
+				m_programs[i]->_OnUpdate(m_renderer, this, pSkinManager, pRenderInfo);
 		}
 	}
 
@@ -7,6 +7,7 @@
 
 #ifdef MASH_WINDOWS
 #include "CMashD3D10EffectProgram.h"
+#include "CMashD3D10Renderer.h"
 #include "MashHelper.h"
 #include "MashFileStream.h"
 #include "MashMaterialManager.h"
@@ -168,6 +169,12 @@ namespace mash
 		MashArray<sConstantBuffer>::Iterator cbIterEnd = m_constantBuffers.End();
 		for(; cbIter != cbIterEnd; ++cbIter)
 		{
+			if (cbIter->uploadedBuffer)
+			{
+				MASH_FREE(cbIter->uploadedBuffer);
+				cbIter->uploadedBuffer = 0;
+			}
+
 			if (cbIter->buffer)
 			{
 				MASH_FREE(cbIter->buffer);
@@ -661,7 +668,7 @@ namespace mash
 		};
 	}
 
-	void CMashD3D10EffectProgram::_OnUpdate(MashEffect *owner, MashMaterialManager *pSkinManager, const MashRenderInfo *pRenderInfo)
+	void CMashD3D10EffectProgram::_OnUpdate(CMashD3D10Renderer *renderer, MashEffect *owner, MashMaterialManager *pSkinManager, const MashRenderInfo *pRenderInfo)
 	{
 		const uint32 iAutoParameterCount = m_autoParameters.Size();
 		for(uint32 i = 0; i < iAutoParameterCount; ++i)
@@ -678,9 +685,30 @@ namespace mash
 		for(uint32 i = 0; i < bufferCount; ++i)
 		{
 			sConstantBuffer *buffer = &m_constantBuffers[i];
-			buffer->d3DBuffer->Map(D3D10_MAP_WRITE_DISCARD, 0, &data);
-			memcpy(data, buffer->buffer, buffer->bufferSize);
-			buffer->d3DBuffer->Unmap();
+
+			/*
+				Buffers holding only per frame or per material data will
+				usually be the same as the last upload, so the map is skipped.
+			*/
+			bool upload = true;
+			if (!buffer->uploadedBuffer)
+				buffer->uploadedBuffer = (uint8*)MASH_ALLOC_COMMON(buffer->bufferSize);
+			else if (memcmp(buffer->uploadedBuffer, buffer->buffer, buffer->bufferSize) == 0)
+				upload = false;
+
+			if (upload)
+			{
+				buffer->d3DBuffer->Map(D3D10_MAP_WRITE_DISCARD, 0, &data);
+				memcpy(data, buffer->buffer, buffer->bufferSize);
+				buffer->d3DBuffer->Unmap();
+
+				memcpy(buffer->uploadedBuffer, buffer->buffer, buffer->bufferSize);
+				renderer->_OnConstantDataUploaded(buffer->bufferSize);
+			}
+			else
+			{
+				renderer->_OnConstantUploadSkipped();
+			}
 
 			switch(m_programType)
 			{
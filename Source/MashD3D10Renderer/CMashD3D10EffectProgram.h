@@ -21,6 +21,7 @@ namespace mash
 	class MashEffect;
 	class MashMaterialManager;
 	class MashRenderInfo;
+	class CMashD3D10Renderer;
 
 	enum eMASH_D3D10_EFFECT_PARAM_TYPE
 	{
@@ -107,12 +108,14 @@ namespace mash
 		struct sConstantBuffer
 		{
 			uint8 *buffer;
+			//copy of the data last sent to d3DBuffer. Used to skip redundant maps.
+			uint8 *uploadedBuffer;
 			ID3D10Buffer *d3DBuffer;
 			uint32 bufferSize;
 			uint32 bufferSlot;
 
-			sConstantBuffer():buffer(0), d3DBuffer(0), bufferSize(0), bufferSlot(0){}
-			sConstantBuffer(const sConstantBuffer &c):buffer(c.buffer), d3DBuffer(c.d3DBuffer), bufferSize(c.bufferSize), bufferSlot(c.bufferSlot){}
+			sConstantBuffer():buffer(0), uploadedBuffer(0), d3DBuffer(0), bufferSize(0), bufferSlot(0){}
+			sConstantBuffer(const sConstantBuffer &c):buffer(c.buffer), uploadedBuffer(c.uploadedBuffer), d3DBuffer(c.d3DBuffer), bufferSize(c.bufferSize), bufferSlot(c.bufferSlot){}
 		};
 
 		MashArray<sConstantBuffer> m_constantBuffers;
@@ -139,7 +142,7 @@ namespace mash
 			uint32 macroCount, bool &isValid);
 
 		void _OnLoad(MashMaterialManager *pSkinManager, const MashRenderInfo *pRenderInfo);
-		void _OnUpdate(MashEffect *owner, MashMaterialManager *pSkinManager, const MashRenderInfo *pRenderInfo);
+		void _OnUpdate(CMashD3D10Renderer *renderer, MashEffect *owner, MashMaterialManager *pSkinManager, const MashRenderInfo *pRenderInfo);
 
 		ID3D10Blob* GetProgramIASignature();
 	};
@@ -1820,7 +1820,7 @@ namespace mash
 	}
 
 	eMASH_STATUS CMashD3D10Renderer::DrawVertexList(const MashMeshBuffer *buffer, uint32 iVertexCount,
-				uint32 iPrimitiveCount, ePRIMITIVE_TYPE ePrimType)
+				uint32 iPrimitiveCount, ePRIMITIVE_TYPE ePrimType, uint32 firstVertex)
 	{
 		MashVertex *vertexDeclaration = buffer->GetVertexDeclaration();
 		/*
@@ -1845,7 +1845,7 @@ namespace mash
 		ID3D10Buffer *vb[1] = {pD3DVertexBuffer->GetD3D10Buffer()};
 		m_pDevice->IASetVertexBuffers(0, 1, vb, &iStride, &iOffset);
 
-		m_pDevice->Draw(iVertexCount, 0);
+		m_pDevice->Draw(iVertexCount, firstVertex);
 		++m_currentDrawCount;
 
 		return aMASH_OK;
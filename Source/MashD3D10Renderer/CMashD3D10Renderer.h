@@ -183,7 +183,7 @@ namespace mash
 				uint32 iPrimitiveCount, ePRIMITIVE_TYPE ePrimType);
 
 		eMASH_STATUS DrawVertexList(const MashMeshBuffer *buffer, uint32 iVertexCount,
-				uint32 iPrimitiveCount, ePRIMITIVE_TYPE ePrimType);
+				uint32 iPrimitiveCount, ePRIMITIVE_TYPE ePrimType, uint32 firstVertex = 0);
 
 		eMASH_STATUS DrawVertexInstancedList(const MashMeshBuffer *buffer, uint32 iVertexCount,
 				uint32 iPrimitiveCount, ePRIMITIVE_TYPE ePrimType, uint32 instanceCount);
@@ -87,7 +87,7 @@ namespace mash
 		return pNewTexture;
 	}
 
-	eMASH_STATUS CMashD3D10Texture::Lock(eBUFFER_LOCK eType, void **pData, uint32 iLevel, uint32 iFace)
+	eMASH_STATUS CMashD3D10Texture::Lock(eBUFFER_LOCK eType, void **pData, uint32 iLevel, uint32 iFace, uint32 *pRowPitch)
 	{
 		/*
 			Make sure this resource is not currently mapped as a shader input.
@@ -105,6 +105,10 @@ namespace mash
 
 		(*pData) = lockedTextureData.pData;
 
+		//rows can be padded by the driver
+		if (pRowPitch)
+			*pRowPitch = lockedTextureData.RowPitch;
+
 		return aMASH_OK;
 	}
 
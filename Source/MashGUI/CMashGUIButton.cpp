@@ -35,6 +35,8 @@ namespace mash
 
 	void CMashGUIButton::SetSwitchState(bool isPressed)
 	{
+		MarkDirty();
+
 		if (m_isSwitch)
 		{
 			if (m_switchIsPressed != isPressed)
@@ -65,6 +67,9 @@ namespace mash
 	{
 		if (GetEventsEnabled())
 		{
+			const eBUTTON_STATE lastButtonState = m_buttonState;
+			const bool lastSwitchState = m_switchIsPressed;
+
 			if (eventData.action == aMOUSEEVENT_B1)
 			{
 				switch(eventData.isPressed)
@@ -166,11 +171,16 @@ namespace mash
 
 				};
 			}
+
+			if ((m_buttonState != lastButtonState) || (m_switchIsPressed != lastSwitchState))
+				MarkDirty();
 		}
 	}
 
 	void CMashGUIButton::SetText(const MashStringc &text)
 	{
+		MarkDirty();
+
 		m_textHandler.SetString(text);
 	}
 
@@ -184,6 +194,8 @@ namespace mash
 
 	void CMashGUIButton::SetButtonStyles(int32 elementId, eGUI_STYLE_ATTRIBUTE up, eGUI_STYLE_ATTRIBUTE down, eGUI_STYLE_ATTRIBUTE hover)
 	{
+		MarkDirty();
+
 		m_styleElement = elementId;
 		m_upStyle = up;
 		m_downStyle = down;
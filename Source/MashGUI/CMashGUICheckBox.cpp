@@ -25,6 +25,8 @@ namespace mash
 
 	void CMashGUICheckBox::SetChecked(bool bIsChecked)
 	{
+		MarkDirty();
+
 		if (bIsChecked != m_bIsChecked)
 		{
 			m_bIsChecked = bIsChecked;
@@ -17,6 +17,11 @@ namespace mash
 {
 	uint32 g_mashGUIMaxFontCharSize = 128;
 
+	//number of laid out strings kept per font
+	static const uint32 g_mashGUIFontLayoutCacheSize = 256;
+	//longer strings are laid out every time. Usually large multiline blocks that change often.
+	static const uint32 g_mashGUIFontLayoutCacheMaxLength = 256;
+
 	struct sCharsetData
 	{
 		int32 iCharacterCount;
@@ -24,14 +29,30 @@ namespace mash
 		int32 iCharacterSize;
 	};
 
+	bool CMashGUIFont::sTextLayoutKey::operator<(const sTextLayoutKey &other)const
+	{
+		if (width != other.width)
+			return width < other.width;
+		if (height != other.height)
+			return height < other.height;
+		if (alignment != other.alignment)
+			return alignment < other.alignment;
+		if (wordWrap != other.wordWrap)
+			return wordWrap < other.wordWrap;
+
+		return *text < *other.text;
+	}
+
 	CMashGUIFont::CMashGUIFont():m_iLineHeight(0),m_MaxCharacterHeight(0),
-		m_pTexture(0), m_spaceSize(0), m_charArray(0)
+		m_pTexture(0), m_spaceSize(0), m_charArray(0), m_layoutCacheFront(0), m_layoutCacheBack(0)
 	{
 		
 	}
 
 	CMashGUIFont::~CMashGUIFont()
 	{
+		ClearLayoutCache();
+
 		if (m_pTexture)
 		{
 			m_pTexture->Drop();
@@ -56,6 +77,9 @@ namespace mash
 			return aMASH_FAILED;
 		}
 
+		//glyph data is about to change
+		ClearLayoutCache();
+
 		pTexture->Grab();
 
 		if (m_pTexture)
@@ -418,32 +442,57 @@ namespace mash
 		}
 	}
 
-	eMASH_STATUS CMashGUIFont::DrawText(const MashStringc &text,  
-			bool bWordWrap, eFONT_ALIGNMENT eTextAlignment,
-			const MashVector2 &textOffset,
-			const mash::MashRectangle2 &drawingArea,
-			const mash::MashRectangle2 &clippingArea,			
-			mash::MashVertexPosTex::sMashVertexPosTex *pVerticesOut, uint32 &iVertexCountOut)
+	void CMashGUIFont::ClearLayoutCache()
 	{
-		iVertexCountOut = 0;
-		if (text.Empty())
-			return aMASH_OK;
+		std::map<sTextLayoutKey, sTextLayout*>::iterator iter = m_layoutCache.begin();
+		std::map<sTextLayoutKey, sTextLayout*>::iterator iterEnd = m_layoutCache.end();
+		for(; iter != iterEnd; ++iter)
+		{
+			MASH_DELETE_T(sTextLayout, iter->second);
+		}
 
-		const f32 texWidth = 1.0f / (f32)m_iTextureWidth;
-		const f32 texHeight = 1.0f / (f32)m_iTextureHeight;
+		m_layoutCache.clear();
+		m_layoutCacheFront = 0;
+		m_layoutCacheBack = 0;
+	}
 
-		sCachedStringData cacheData;
-		GenerateStringData(cacheData, text, bWordWrap, drawingArea);
+	void CMashGUIFont::UnlinkLayout(sTextLayout *layout)
+	{
+		if (layout->prev)
+			layout->prev->next = layout->next;
+		else
+			m_layoutCacheFront = layout->next;
 
-		mash::MashRectangle2 validatedClippingArea = clippingArea;
-		if (drawingArea.left > validatedClippingArea.left)
-			validatedClippingArea.left = drawingArea.left;
-		if (drawingArea.right < validatedClippingArea.right)
-			validatedClippingArea.right = drawingArea.right;
-		if (drawingArea.top > validatedClippingArea.top)
-			validatedClippingArea.top = drawingArea.top;
-		if (drawingArea.bottom < validatedClippingArea.bottom)
-			validatedClippingArea.bottom = drawingArea.bottom;
+		if (layout->next)
+			layout->next->prev = layout->prev;
+		else
+			m_layoutCacheBack = layout->prev;
+
+		layout->prev = 0;
+		layout->next = 0;
+	}
+
+	void CMashGUIFont::PushLayoutFront(sTextLayout *layout)
+	{
+		layout->prev = 0;
+		layout->next = m_layoutCacheFront;
+
+		if (m_layoutCacheFront)
+			m_layoutCacheFront->prev = layout;
+		else
+			m_layoutCacheBack = layout;
+
+		m_layoutCacheFront = layout;
+	}
+
+	void CMashGUIFont::BuildTextLayout(const MashStringc &text, bool bWordWrap, eFONT_ALIGNMENT eTextAlignment,
+			f32 width, f32 height, sTextLayout &out)
+	{
+		out.glyphs.Clear();
+		out.bounds = mash::MashRectangle2(0.0f, 0.0f, 0.0f, 0.0f);
+
+		sCachedStringData cacheData;
+		GenerateStringData(cacheData, text, bWordWrap, mash::MashRectangle2(0.0f, 0.0f, width, height));
 		
 		const uint32 lineCount = cacheData.lineData.Size();
 
@@ -455,26 +504,27 @@ namespace mash
 		case aRIGHT_CENTER:
 		case aLEFT_CENTER:
 			{
-				alignAdjustmentY = ((f32)(drawingArea.bottom - drawingArea.top) * 0.5f) - ((f32)(m_MaxCharacterHeight * lineCount) * 0.5f);
+				alignAdjustmentY = (height * 0.5f) - ((f32)(m_MaxCharacterHeight * lineCount) * 0.5f);
 				break;
 			}
 		case aBOTTOM_CENTER:
 		case aBOTTOM_LEFT:
 		case aBOTTOM_RIGHT:
 			{
-				alignAdjustmentY = (drawingArea.bottom - drawingArea.top) - (m_MaxCharacterHeight * lineCount);
+				alignAdjustmentY = height - (m_MaxCharacterHeight * lineCount);
 				break;
 			}
 		default:
 			{
-				uint32 maxLineCount = (drawingArea.bottom - drawingArea.top) / m_MaxCharacterHeight;
+				uint32 maxLineCount = height / m_MaxCharacterHeight;
 				if (lineCount > maxLineCount)
 					alignAdjustmentY = (f32)((lineCount - maxLineCount) * m_MaxCharacterHeight) * -1.0f;
 				break;
 			}
 		};
 
-		mash::MashVector2 tempVerts[6];
+		out.glyphs.Reserve(cacheData.allChars.Size());
+
 		uint32 currentCharCount = 0;
 		for(uint32 line = 0; line < lineCount; ++line)
 		{
@@ -486,14 +536,14 @@ namespace mash
 			case aBOTTOM_RIGHT:
 			case aTOP_RIGHT:
 				{
-					alignAdjustmentX = (drawingArea.right - drawingArea.left) - cacheData.lineData[line].lineWidth;
+					alignAdjustmentX = width - cacheData.lineData[line].lineWidth;
 					break;
 				}
 			case aTOP_CENTER:
 			case aBOTTOM_CENTER:
 			case aCENTER:
 				{
-					alignAdjustmentX = ((drawingArea.right - drawingArea.left) * 0.5f) - (cacheData.lineData[line].lineWidth * 0.5f);
+					alignAdjustmentX = (width * 0.5f) - (cacheData.lineData[line].lineWidth * 0.5f);
 					break;
 				}
 			default:
@@ -513,55 +563,169 @@ namespace mash
 				*/
 				if (currentChar->data)
 				{
-					mash::MashRectangle2 uv(currentChar->data->rectLeft,
+					sLayoutGlyph glyph;
+					glyph.uv = mash::MashRectangle2(currentChar->data->rectLeft,
 						currentChar->data->rectTop, 
 						currentChar->data->rectRight, 
 						currentChar->data->rectBottom);
 
 					f32 offset = currentChar->data->offsetFromTop;// * 0.5f;
-					mash::MashRectangle2 destRect(drawingArea.left + alignAdjustmentX + currentChar->localx,
-						drawingArea.top + alignAdjustmentY + offset + currentChar->localy,
-						drawingArea.left + alignAdjustmentX + currentChar->localx + (currentChar->data->rectRight - currentChar->data->rectLeft),
-						drawingArea.top + alignAdjustmentY + currentChar->localy + offset + (currentChar->data->rectBottom - currentChar->data->rectTop));
-
-					destRect.left += textOffset.x;
-					destRect.right += textOffset.x;
-					destRect.top += textOffset.y;
-					destRect.bottom += textOffset.y;
-
-					//do scissor test
-					if (!ScissorTest(validatedClippingArea, uv, destRect))
-					{
-						pVerticesOut[iVertexCountOut].texCoord.x = uv.left * texWidth;
-						pVerticesOut[iVertexCountOut].texCoord.y = uv.bottom * texHeight;
-						pVerticesOut[iVertexCountOut+1].texCoord.x = uv.left * texWidth;
-						pVerticesOut[iVertexCountOut+1].texCoord.y = uv.top * texHeight;
-						pVerticesOut[iVertexCountOut+2].texCoord.x = uv.right * texWidth;
-						pVerticesOut[iVertexCountOut+2].texCoord.y = uv.top * texHeight;
-
-						pVerticesOut[iVertexCountOut+3].texCoord.x = uv.left * texWidth;
-						pVerticesOut[iVertexCountOut+3].texCoord.y = uv.bottom * texHeight;
-						pVerticesOut[iVertexCountOut+4].texCoord.x = uv.right * texWidth;
-						pVerticesOut[iVertexCountOut+4].texCoord.y = uv.top * texHeight;
-						pVerticesOut[iVertexCountOut+5].texCoord.x = uv.right * texWidth;
-						pVerticesOut[iVertexCountOut+5].texCoord.y = uv.bottom * texHeight;
-
-						destRect.GetPointsAsTris(tempVerts);
-						for(uint32 pos = 0; pos < 6; ++pos)
-						{
-							pVerticesOut[iVertexCountOut+pos].position.x = (int32)(tempVerts[pos].x);
-							pVerticesOut[iVertexCountOut+pos].position.y = (int32)(tempVerts[pos].y);
-							pVerticesOut[iVertexCountOut+pos].position.z = (int32)0.1f;
-						}
+					glyph.destRect = mash::MashRectangle2(alignAdjustmentX + currentChar->localx,
+						alignAdjustmentY + offset + currentChar->localy,
+						alignAdjustmentX + currentChar->localx + (currentChar->data->rectRight - currentChar->data->rectLeft),
+						alignAdjustmentY + currentChar->localy + offset + (currentChar->data->rectBottom - currentChar->data->rectTop));
 
-						iVertexCountOut += 6;
-					}
+					if (out.glyphs.Empty())
+						out.bounds = glyph.destRect;
+					else
+						out.bounds.MergeGUI(glyph.destRect);
+
+					out.glyphs.PushBack(glyph);
 				}
 
 				++currentCharCount;
 			}
 		}
+	}
+
+	const CMashGUIFont::sTextLayout* CMashGUIFont::GetTextLayout(const MashStringc &text, bool bWordWrap, eFONT_ALIGNMENT eTextAlignment,
+			const mash::MashRectangle2 &drawingArea)
+	{
+		const f32 width = drawingArea.right - drawingArea.left;
+		const f32 height = drawingArea.bottom - drawingArea.top;
+
+		if (text.Size() > g_mashGUIFontLayoutCacheMaxLength)
+		{
+			BuildTextLayout(text, bWordWrap, eTextAlignment, width, height, m_uncachedLayout);
+			return &m_uncachedLayout;
+		}
+
+		sTextLayoutKey key;
+		key.text = &text;
+		key.width = width;
+		key.height = height;
+		key.alignment = eTextAlignment;
+		key.wordWrap = bWordWrap;
+
+		std::map<sTextLayoutKey, sTextLayout*>::iterator cacheIter = m_layoutCache.find(key);
+		if (cacheIter != m_layoutCache.end())
+		{
+			sTextLayout *layout = cacheIter->second;
+			if (layout != m_layoutCacheFront)
+			{
+				UnlinkLayout(layout);
+				PushLayoutFront(layout);
+			}
+
+			return layout;
+		}
+
+		sTextLayout *layout = 0;
+		if (m_layoutCache.size() >= g_mashGUIFontLayoutCacheSize)
+		{
+			//reuse the least recently used layout
+			layout = m_layoutCacheBack;
+			UnlinkLayout(layout);
+			m_layoutCache.erase(layout->key);
+		}
+		else
+		{
+			layout = MASH_NEW_T_COMMON(sTextLayout)();
+		}
+
+		BuildTextLayout(text, bWordWrap, eTextAlignment, width, height, *layout);
+
+		//the string is only copied when a new layout is cached
+		layout->text = text;
+		layout->key = key;
+		layout->key.text = &layout->text;
+		m_layoutCache.insert(std::make_pair(layout->key, layout));
+		PushLayoutFront(layout);
+
+		return layout;
+	}
+
+	eMASH_STATUS CMashGUIFont::DrawText(const MashStringc &text,  
+			bool bWordWrap, eFONT_ALIGNMENT eTextAlignment,
+			const MashVector2 &textOffset,
+			const mash::MashRectangle2 &drawingArea,
+			const mash::MashRectangle2 &clippingArea,			
+			mash::MashVertexPosTex::sMashVertexPosTex *pVerticesOut, uint32 &iVertexCountOut)
+	{
+		iVertexCountOut = 0;
+		if (text.Empty())
+			return aMASH_OK;
+
+		const f32 texWidth = 1.0f / (f32)m_iTextureWidth;
+		const f32 texHeight = 1.0f / (f32)m_iTextureHeight;
+
+		const sTextLayout *layout = GetTextLayout(text, bWordWrap, eTextAlignment, drawingArea);
+		if (layout->glyphs.Empty())
+			return aMASH_OK;
+
+		mash::MashRectangle2 validatedClippingArea = clippingArea;
+		if (drawingArea.left > validatedClippingArea.left)
+			validatedClippingArea.left = drawingArea.left;
+		if (drawingArea.right < validatedClippingArea.right)
+			validatedClippingArea.right = drawingArea.right;
+		if (drawingArea.top > validatedClippingArea.top)
+			validatedClippingArea.top = drawingArea.top;
+		if (drawingArea.bottom < validatedClippingArea.bottom)
+			validatedClippingArea.bottom = drawingArea.bottom;
+
+		const f32 translationX = drawingArea.left + textOffset.x;
+		const f32 translationY = drawingArea.top + textOffset.y;
+
+		/*
+			If the whole string is inside the clipping area then the glyphs
+			only need moving into place.
+		*/
+		const bool clippingNeeded = ((layout->bounds.left + translationX) < validatedClippingArea.left) ||
+			((layout->bounds.right + translationX) > validatedClippingArea.right) ||
+			((layout->bounds.top + translationY) < validatedClippingArea.top) ||
+			((layout->bounds.bottom + translationY) > validatedClippingArea.bottom);
+
+		mash::MashVector2 tempVerts[6];
+		const uint32 glyphCount = layout->glyphs.Size();
+		for(uint32 i = 0; i < glyphCount; ++i)
+		{
+			const sLayoutGlyph &glyph = layout->glyphs[i];
+
+			mash::MashRectangle2 uv = glyph.uv;
+			mash::MashRectangle2 destRect(glyph.destRect.left + translationX,
+				glyph.destRect.top + translationY,
+				glyph.destRect.right + translationX,
+				glyph.destRect.bottom + translationY);
+
+			//do scissor test
+			if (clippingNeeded && ScissorTest(validatedClippingArea, uv, destRect))
+				continue;
+
+			pVerticesOut[iVertexCountOut].texCoord.x = uv.left * texWidth;
+			pVerticesOut[iVertexCountOut].texCoord.y = uv.bottom * texHeight;
+			pVerticesOut[iVertexCountOut+1].texCoord.x = uv.left * texWidth;
+			pVerticesOut[iVertexCountOut+1].texCoord.y = uv.top * texHeight;
+			pVerticesOut[iVertexCountOut+2].texCoord.x = uv.right * texWidth;
+			pVerticesOut[iVertexCountOut+2].texCoord.y = uv.top * texHeight;
+
+			pVerticesOut[iVertexCountOut+3].texCoord.x = uv.left * texWidth;
+			pVerticesOut[iVertexCountOut+3].texCoord.y = uv.bottom * texHeight;
+			pVerticesOut[iVertexCountOut+4].texCoord.x = uv.right * texWidth;
+			pVerticesOut[iVertexCountOut+4].texCoord.y = uv.top * texHeight;
+			pVerticesOut[iVertexCountOut+5].texCoord.x = uv.right * texWidth;
+			pVerticesOut[iVertexCountOut+5].texCoord.y = uv.bottom * texHeight;
+
+			destRect.GetPointsAsTris(tempVerts);
+			for(uint32 pos = 0; pos < 6; ++pos)
+			{
+				pVerticesOut[iVertexCountOut+pos].position.x = (int32)(tempVerts[pos].x);
+				pVerticesOut[iVertexCountOut+pos].position.y = (int32)(tempVerts[pos].y);
+				pVerticesOut[iVertexCountOut+pos].position.z = (int32)0.1f;
+			}
+
+			iVertexCountOut += 6;
+		}
 	
 		return aMASH_OK;
 	}
-}
\ No newline at end of file
+}
@@ -9,6 +9,8 @@
 #include "MashGUIFont.h"
 #include <map>
 #include "MashArray.h"
+#include "MashRectangle2.h"
+#include "MashString.h"
 
 namespace mash
 {
@@ -50,6 +52,48 @@ namespace mash
 			MashArray<sLineData> lineData;
 		};
 
+		struct sLayoutGlyph
+		{
+			//relative to the top left of the drawing area
+			mash::MashRectangle2 destRect;
+			//in texels
+			mash::MashRectangle2 uv;
+		};
+
+		/*
+			The text is referenced rather than copied so lookups don't allocate.
+			Cached keys point at the string owned by their layout.
+		*/
+		struct sTextLayoutKey
+		{
+			const MashStringc *text;
+			f32 width;
+			f32 height;
+			eFONT_ALIGNMENT alignment;
+			bool wordWrap;
+
+			bool operator<(const sTextLayoutKey &other)const;
+		};
+
+		/*
+			Laid out and aligned string. Only needs translating to be drawn
+			unless it lies across the clipping area.
+		*/
+		struct sTextLayout
+		{
+			MashArray<sLayoutGlyph> glyphs;
+			mash::MashRectangle2 bounds;
+
+			MashStringc text;
+			sTextLayoutKey key;
+
+			//intrusive lru list, most recently used first
+			sTextLayout *prev;
+			sTextLayout *next;
+
+			sTextLayout():bounds(0.0f, 0.0f, 0.0f, 0.0f), prev(0), next(0){}
+		};
+
 	private:
 		sGlyphData *m_charArray;
 		uint16 m_iLineHeight;
@@ -63,6 +107,21 @@ namespace mash
 		mash::MashTexture *m_pTexture;
 		MashStringc m_fontFormatFile;
 
+		//least recently used layouts are reused when full
+		std::map<sTextLayoutKey, sTextLayout*> m_layoutCache;
+		sTextLayout *m_layoutCacheFront;
+		sTextLayout *m_layoutCacheBack;
+		//used for strings too long to cache
+		sTextLayout m_uncachedLayout;
+
+		void BuildTextLayout(const MashStringc &text, bool wordWrap, eFONT_ALIGNMENT textAlignment,
+			f32 width, f32 height, sTextLayout &out);
+		const sTextLayout* GetTextLayout(const MashStringc &text, bool wordWrap, eFONT_ALIGNMENT textAlignment,
+			const mash::MashRectangle2 &drawingArea);
+		void ClearLayoutCache();
+		void UnlinkLayout(sTextLayout *layout);
+		void PushLayoutFront(sTextLayout *layout);
+
 		bool ScissorTest(const mash::MashRectangle2 &clippingRect,
 			mash::MashRectangle2 &texCoords,
 			mash::MashRectangle2 &destRect)const;
@@ -7,7 +7,9 @@
 #define _C_MASH_GUI_FONT_BATCH_H_
 
 #include "MashReferenceCounter.h"
-#include "MashMeshBuffer.h"
+#include "MashTransientVertexBuffer.h"
+#include "MashArray.h"
+#include "MashVertex.h"
 #include "MashMaterial.h"
 #include "MashVector2.h"
 #include "MashAutoEffectParameter.h"
@@ -23,10 +25,8 @@ namespace mash
 	private:
 		MashVideo *m_pRenderer;
 		MashVertex *m_pVertexDeclaration;
-		MashMeshBuffer *m_meshBuffer;
-		uint8 *m_pVertexPtr;
-		int32 m_iCurrentReservedVertex;
-		int32 m_iCurrentVertexCount;
+		MashTransientVertexBuffer *m_transientBuffer;
+		MashArray<mash::MashVertexPosTex::sMashVertexPosTex> m_vertices;
 		MashMaterial *m_pMaterial;
 
 		mash::MashTexture *m_pCurrentTexture;
@@ -34,10 +34,6 @@ namespace mash
 
 		MashParamGUIFontColour *m_pFontColourEffectHandler;
 
-		eMASH_STATUS UnlockBuffers();
-		eMASH_STATUS LockBuffers();
-		eMASH_STATUS ResizeBuffers();
-
 		MashGUIManager *m_GUIManager;
 
 	public:
@@ -0,0 +1,125 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#include "CMashGUIHitTestGrid.h"
+#include "MashGUIComponent.h"
+#include "MashMathHelper.h"
+#include <cmath>
+
+namespace mash
+{
+	//cells per axis are clamped to this range
+	static const uint32 g_hitTestGridMinCells = 1;
+	static const uint32 g_hitTestGridMaxCells = 32;
+
+	CMashGUIHitTestGrid::CMashGUIHitTestGrid():MashMemoryObject(),
+		m_bounds(0.0f, 0.0f, 0.0f, 0.0f), m_cellCountX(0), m_cellCountY(0),
+		m_invCellWidth(0.0f), m_invCellHeight(0.0f)
+	{
+	}
+
+	bool CMashGUIHitTestGrid::GetCellRange(const mash::MashRectangle2 &rect, uint32 &minX, uint32 &minY, uint32 &maxX, uint32 &maxY)const
+	{
+		//culled components have a zero area region and can never be hit
+		if ((rect.right <= rect.left) || (rect.bottom <= rect.top))
+			return false;
+
+		if ((rect.right <= m_bounds.left) || (rect.left >= m_bounds.right) ||
+			(rect.bottom <= m_bounds.top) || (rect.top >= m_bounds.bottom))
+			return false;
+
+		minX = (uint32)math::Clamp<f32>(0.0f, (f32)(m_cellCountX - 1), (rect.left - m_bounds.left) * m_invCellWidth);
+		maxX = (uint32)math::Clamp<f32>(0.0f, (f32)(m_cellCountX - 1), (rect.right - m_bounds.left) * m_invCellWidth);
+		minY = (uint32)math::Clamp<f32>(0.0f, (f32)(m_cellCountY - 1), (rect.top - m_bounds.top) * m_invCellHeight);
+		maxY = (uint32)math::Clamp<f32>(0.0f, (f32)(m_cellCountY - 1), (rect.bottom - m_bounds.top) * m_invCellHeight);
+
+		return true;
+	}
+
+	void CMashGUIHitTestGrid::Build(const mash::MashRectangle2 &bounds, const MashList<MashGUIComponent*> &components)
+	{
+		m_bounds = bounds;
+		m_cellComponents.Clear();
+
+		const f32 width = m_bounds.right - m_bounds.left;
+		const f32 height = m_bounds.bottom - m_bounds.top;
+		if ((width <= 0.0f) || (height <= 0.0f))
+		{
+			m_cellCountX = 0;
+			m_cellCountY = 0;
+			m_cellStart.Clear();
+			return;
+		}
+
+		//roughly one component per cell
+		const uint32 cellsPerAxis = math::Clamp<uint32>(g_hitTestGridMinCells, g_hitTestGridMaxCells,
+			(uint32)ceil(sqrt((f32)components.Size())));
+
+		m_cellCountX = cellsPerAxis;
+		m_cellCountY = cellsPerAxis;
+		m_invCellWidth = (f32)m_cellCountX / width;
+		m_invCellHeight = (f32)m_cellCountY / height;
+
+		const uint32 cellCount = m_cellCountX * m_cellCountY;
+		m_cellStart.Resize(cellCount + 1);
+		m_cellCursor.Resize(cellCount);
+		for(uint32 i = 0; i <= cellCount; ++i)
+			m_cellStart[i] = 0;
+
+		uint32 minX, minY, maxX, maxY;
+
+		//count the components in each cell
+		MashList<MashGUIComponent*>::ConstIterator iter = components.Begin();
+		MashList<MashGUIComponent*>::ConstIterator end = components.End();
+		for(; iter != end; ++iter)
+		{
+			if (!GetCellRange((*iter)->GetAbsoluteClippedRegion(), minX, minY, maxX, maxY))
+				continue;
+
+			for(uint32 y = minY; y <= maxY; ++y)
+			{
+				for(uint32 x = minX; x <= maxX; ++x)
+					++m_cellStart[(y * m_cellCountX) + x + 1];
+			}
+		}
+
+		for(uint32 i = 0; i < cellCount; ++i)
+		{
+			m_cellStart[i + 1] += m_cellStart[i];
+			m_cellCursor[i] = m_cellStart[i];
+		}
+
+		m_cellComponents.Resize(m_cellStart[cellCount], 0);
+
+		//fill the cells. List order is kept so the front most component is first.
+		for(iter = components.Begin(); iter != end; ++iter)
+		{
+			if (!GetCellRange((*iter)->GetAbsoluteClippedRegion(), minX, minY, maxX, maxY))
+				continue;
+
+			for(uint32 y = minY; y <= maxY; ++y)
+			{
+				for(uint32 x = minX; x <= maxX; ++x)
+					m_cellComponents[m_cellCursor[(y * m_cellCountX) + x]++] = *iter;
+			}
+		}
+	}
+
+	uint32 CMashGUIHitTestGrid::GetCandidates(const mash::MashVector2 &point, MashGUIComponent *const **candidatesOut)const
+	{
+		if ((m_cellCountX == 0) || !m_bounds.IntersectsGUI(point))
+			return 0;
+
+		const uint32 x = (uint32)math::Clamp<f32>(0.0f, (f32)(m_cellCountX - 1), (point.x - m_bounds.left) * m_invCellWidth);
+		const uint32 y = (uint32)math::Clamp<f32>(0.0f, (f32)(m_cellCountY - 1), (point.y - m_bounds.top) * m_invCellHeight);
+		const uint32 cell = (y * m_cellCountX) + x;
+
+		const uint32 count = m_cellStart[cell + 1] - m_cellStart[cell];
+		if (count > 0)
+			*candidatesOut = &m_cellComponents[m_cellStart[cell]];
+
+		return count;
+	}
+}
@@ -0,0 +1,56 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#ifndef _C_MASH_GUI_HIT_TEST_GRID_H_
+#define _C_MASH_GUI_HIT_TEST_GRID_H_
+
+#include "MashMemoryObject.h"
+#include "MashArray.h"
+#include "MashList.h"
+#include "MashRectangle2.h"
+#include "MashVector2.h"
+
+namespace mash
+{
+	class MashGUIComponent;
+
+	/*
+		Uniform grid over the absolute clipped regions of a views children.
+		Used to find the few children under the cursor without testing them all.
+
+		Each cell stores the components that overlap it, in the same order as the
+		list passed to Build(). So the first hit in a cell is still the front most
+		component.
+	*/
+	class CMashGUIHitTestGrid : public MashMemoryObject
+	{
+	private:
+		mash::MashRectangle2 m_bounds;
+		uint32 m_cellCountX;
+		uint32 m_cellCountY;
+		f32 m_invCellWidth;
+		f32 m_invCellHeight;
+
+		//components for cell n are m_cellComponents[m_cellStart[n]] to m_cellComponents[m_cellStart[n+1]]
+		MashArray<uint32> m_cellStart;
+		MashArray<uint32> m_cellCursor;
+		MashArray<MashGUIComponent*> m_cellComponents;
+
+		bool GetCellRange(const mash::MashRectangle2 &rect, uint32 &minX, uint32 &minY, uint32 &maxX, uint32 &maxY)const;
+	public:
+		CMashGUIHitTestGrid();
+		~CMashGUIHitTestGrid(){}
+
+		void Build(const mash::MashRectangle2 &bounds, const MashList<MashGUIComponent*> &components);
+
+		/*
+			Returns the number of components that may contain the point. Components
+			are returned front to back.
+		*/
+		uint32 GetCandidates(const mash::MashVector2 &point, MashGUIComponent *const **candidatesOut)const;
+	};
+}
+
+#endif
@@ -15,13 +15,11 @@ namespace mash
 {
 	CMashGUILineBatch::CMashGUILineBatch(MashGUIManager *pGUIManager, 
 		MashVideo *pRenderer,
-		int32 iMaxVertexCount):
+		uint32 iMaxVertexCount):
 		m_pVertexDeclaration(0),
 		m_GUIManager(pGUIManager),
 		m_pRenderer(pRenderer),
-		m_meshBuffer(0),m_pVertexPtr(0),
-		m_iCurrentReservedVertex(6),
-		m_iCurrentVertexCount(0),
+		m_transientBuffer(0),
 		m_iMaxVertexCount(iMaxVertexCount),
 		m_currentColour(1.0f, 1.0f, 1.0f, 1.0f),
 		m_pMaterial(0)
@@ -36,12 +34,6 @@ namespace mash
 			m_pVertexDeclaration = 0;
 		}
 
-		if (m_meshBuffer)
-		{
-			m_meshBuffer->Drop();
-			m_meshBuffer = 0;
-		}
-
 		if (m_pMaterial)
 		{
 			m_pMaterial->Drop();
@@ -83,136 +75,35 @@ namespace mash
 
 		m_pVertexDeclaration->Grab();
 
-		ResizeBuffers();
-
-		return aMASH_OK;
-	}
-
-	eMASH_STATUS CMashGUILineBatch::UnlockBuffers()
-	{
-		if (m_pVertexPtr)
-		{
-			if (m_meshBuffer->GetVertexBuffer()->Unlock() == aMASH_FAILED)
-			{
-				return aMASH_FAILED;
-			}
-
-			m_pVertexPtr = 0;
-		}
-
-		return aMASH_OK;
-	}
-
-	eMASH_STATUS CMashGUILineBatch::LockBuffers()
-	{
-		if (!m_pVertexPtr)
-		{
-			if (m_meshBuffer->GetVertexBuffer()->Lock(mash::aLOCK_WRITE_DISCARD, (void**)(&m_pVertexPtr)) == aMASH_FAILED)
-			{
-				return aMASH_FAILED;
-			}
-
-			m_iCurrentVertexCount = 0;
-		}
-
-		return aMASH_OK;
-	}
-
-	eMASH_STATUS CMashGUILineBatch::ResizeBuffers()
-	{
-		if (UnlockBuffers() == aMASH_FAILED)
+		m_transientBuffer = m_pRenderer->GetTransientVertexBuffer(m_pVertexDeclaration);
+		if (!m_transientBuffer)
 		{
 			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
-						"Failed to unlock GUI buffer.", 
-						"CMashGUILineBatch::ResizeBuffers");
+						"Failed to get the transient vertex buffer.", 
+						"CMashGUILineBatch::Initialise");
 
 			return aMASH_FAILED;
 		}
 
-		if (!m_meshBuffer)
-		{
-			sVertexStreamInit streamData;
-			streamData.data = 0;
-			streamData.dataSizeInBytes = m_iCurrentReservedVertex * m_pVertexDeclaration->GetStreamSizeInBytes(0);
-			streamData.usage = aUSAGE_DYNAMIC;
-
-			m_meshBuffer = m_pRenderer->CreateMeshBuffer(&streamData, 1, m_pVertexDeclaration);
-		}
-		else
-		{
-			m_pVertexPtr = 0;
-			if (m_meshBuffer->ResizeVertexBuffers(0, m_iCurrentReservedVertex * sizeof(mash::MashVertexColour::sMashVertexColour), aUSAGE_DYNAMIC, false) == aMASH_FAILED)
-            {
-                MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
-                                 "Failed to resize vertex buffer.", 
-                                 "CMashGUILineBatch::ResizeBuffers");
-                
-				return aMASH_FAILED;
-            }
-		}
-
-		if (!m_meshBuffer)
-        {
-            MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
-                             "Mesh buffer failed to be created for GUI buffer.", 
-                             "CMashGUILineBatch::ResizeBuffers");
-            
-			return aMASH_FAILED;
-        }
-
-		m_iCurrentVertexCount = 0;
-        
-        return aMASH_OK;
+		return aMASH_OK;
 	}
 
 	eMASH_STATUS CMashGUILineBatch::Draw(const mash::MashVector2 &top, const mash::MashVector2 &bottom,
 			const mash::sMashColour &colour)
 	{
-		const int32 iVertexCount = 2;
+		const uint32 iVertexCount = 2;
 
-		int32 iNewCount = m_iCurrentVertexCount+iVertexCount;
-		if (iNewCount > m_iCurrentReservedVertex)
+		if ((m_vertices.Size() + iVertexCount) > m_iMaxVertexCount)
 		{
 			//render all the buffers so that render layer order is maintained
 			m_GUIManager->FlushBuffers();
-
-			//check if the buffer can grow
-			if (iNewCount < m_iMaxVertexCount)
-			{
-				m_iCurrentReservedVertex = iNewCount * 2;
-
-				if (m_iCurrentReservedVertex > m_iMaxVertexCount)
-					m_iCurrentReservedVertex = m_iMaxVertexCount;
-
-				//resize the buffers
-				if (ResizeBuffers() == aMASH_FAILED)
-				{
-					MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
-						"Mesh buffer resize failed.", 
-						"CMashGUILineBatch::Draw");
-
-					return aMASH_FAILED;
-				}
-			}
-		}
-
-		if (LockBuffers() == aMASH_FAILED)
-		{
-			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
-						"Failed to lock GUI buffer.", 
-						"CMashGUILineBatch::Draw");
-
-			return aMASH_FAILED;
 		}
 
 		mash::MashVertexColour::sMashVertexColour verts[2];
 		verts[0] = mash::MashVertexColour::sMashVertexColour(mash::MashVector3(top.x, top.y, 0.0f), colour);
 		verts[1] = mash::MashVertexColour::sMashVertexColour(mash::MashVector3(bottom.x, bottom.y, 0.0f), colour);
 
-		memcpy(&m_pVertexPtr[m_iCurrentVertexCount * sizeof(mash::MashVertexColour::sMashVertexColour)],
-			verts, sizeof(mash::MashVertexColour::sMashVertexColour) * iVertexCount);
-
-		m_iCurrentVertexCount += iVertexCount;
+		m_vertices.Append(verts, iVertexCount);
 
 		return aMASH_OK;
 	}
@@ -220,41 +111,12 @@ namespace mash
 	eMASH_STATUS CMashGUILineBatch::Draw(const mash::MashRectangle2 &rect,
 			const mash::sMashColour &colour)
 	{
-		const int32 iVertexCount = 8;
+		const uint32 iVertexCount = 8;
 
-		int32 iNewCount = m_iCurrentVertexCount+iVertexCount;
-		if (iNewCount > m_iCurrentReservedVertex)
+		if ((m_vertices.Size() + iVertexCount) > m_iMaxVertexCount)
 		{
 			//render all the buffers so that render layer order is maintained
 			m_GUIManager->FlushBuffers();
-
-			//check if the buffer can grow
-			if (iNewCount < m_iMaxVertexCount)
-			{
-				m_iCurrentReservedVertex = iNewCount * 2;
-
-				if (m_iCurrentReservedVertex > m_iMaxVertexCount)
-					m_iCurrentReservedVertex = m_iMaxVertexCount;
-
-				//resize the buffers
-				if (ResizeBuffers() == aMASH_FAILED)
-				{
-					MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
-						"Mesh buffer resize failed.",  
-						"CMashGUILineBatch::Draw");
-
-					return aMASH_FAILED;
-				}
-			}
-		}
-
-		if (LockBuffers() == aMASH_FAILED)
-		{
-			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
-						"Failed to lock GUI buffer.", 
-						"CMashGUILineBatch::Draw");
-
-			return aMASH_FAILED;
 		}
 
 		mash::MashVector3 positions[4];
@@ -276,36 +138,36 @@ namespace mash
 		verts[6] = mash::MashVertexColour::sMashVertexColour(positions[3], colour);
 		verts[7] = mash::MashVertexColour::sMashVertexColour(positions[0], colour);
 
-		memcpy(&m_pVertexPtr[m_iCurrentVertexCount * sizeof(mash::MashVertexColour::sMashVertexColour)],
-			verts, sizeof(mash::MashVertexColour::sMashVertexColour) * iVertexCount);
-
-		m_iCurrentVertexCount += iVertexCount;
+		m_vertices.Append(verts, iVertexCount);
 
 		return aMASH_OK;
 	}
 
 	eMASH_STATUS CMashGUILineBatch::Flush()
 	{
-		if (UnlockBuffers() == aMASH_FAILED)
-		{
-			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
-						"Failed to unlock GUI buffer.", 
-						"CMashGUILineBatch::Flush");
-
-			return aMASH_FAILED;
-		}
-
 		eMASH_STATUS status = aMASH_OK;
 
-		if (m_iCurrentVertexCount > 0)
+		if (!m_vertices.Empty())
 		{
+			const uint32 vertexCount = m_vertices.Size();
+			uint32 firstVertex = 0;
+			if (m_transientBuffer->Write(m_vertices.Pointer(), vertexCount, firstVertex) == aMASH_FAILED)
+			{
+				MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+							"Failed to fill GUI buffer.", 
+							"CMashGUILineBatch::Flush");
+
+				m_vertices.Clear();
+				return aMASH_FAILED;
+			}
+
 			if (m_pMaterial->OnSet() == aMASH_OK)
 			{
-				status = m_pRenderer->DrawVertexList(m_meshBuffer, m_iCurrentVertexCount,
-					m_iCurrentVertexCount / 2, aPRIMITIVE_LINE_LIST);
+				status = m_pRenderer->DrawVertexList(m_transientBuffer->GetMeshBuffer(), vertexCount,
+					vertexCount / 2, aPRIMITIVE_LINE_LIST, firstVertex);
 			}
 
-			m_iCurrentVertexCount = 0;
+			m_vertices.Clear();
 		}
 
 		return status;
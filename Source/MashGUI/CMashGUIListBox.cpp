@@ -17,7 +17,7 @@ namespace mash
 			int32 styleElement):MashGUIListBox(pGUIManager, pInputManager, pParent, destination),
 				m_iSelectedItem(-1), m_pScrollBar(0), m_iDoubleClickTimeLimit(500), m_iLastDoubleClickTime(0),
 				m_bUpdateNeeded(false), m_itemHeight(0.0f), m_styleElement(styleElement), m_itemIdCounter(0),
-				m_displayIcons(false)
+				m_displayIcons(false), m_firstVisibleItem(0), m_lastVisibleItem(0)
 				/*m_iSelectedItem(0)*/
 	{
 		/*
@@ -139,10 +139,31 @@ namespace mash
 		{
 			m_pScrollBar->SetRenderEnabled(false);
 		}
+
+		CalculateVisibleItemRange();
+	}
+
+	void CMashGUIListBox::CalculateVisibleItemRange()
+	{
+		if (m_itemHeight <= 0)
+			m_itemHeight = 1;
+
+		/*
+			Items all have the same height so the visible range can be found
+			directly from the scroll position.
+		*/
+		const f32 scrollValue = math::Max<f32>(0.0f, m_pScrollBar->GetSliderValue());
+		const mash::MashRectangle2 &rect = GetAbsoluteRegion();
+		const f32 visibleHeight = math::Max<f32>(0.0f, rect.bottom - rect.top);
+
+		m_firstVisibleItem = (uint32)(scrollValue / m_itemHeight);
+		m_lastVisibleItem = (uint32)((scrollValue + visibleHeight) / m_itemHeight) + 1;
 	}
 
 	void CMashGUIListBox::SetActiveItem(int32 id, bool sendConfirmedMessage)
 	{
+		MarkDirty();
+
 		sListBoxItem *item = GetItem(id);
 		if (item)
 		{
@@ -193,6 +214,8 @@ namespace mash
 
 	void CMashGUIListBox::SetItemHeight(uint32 height)
 	{
+		MarkDirty();
+
 		m_itemHeight = height;
 		m_bUpdateNeeded = true;//TODO : Make the changes immediate
 
@@ -201,6 +224,8 @@ namespace mash
 
 	void CMashGUIListBox::SetItemIcon(int32 id, mash::MashTexture *icon, const mash::MashRectangle2 *source)
 	{
+		MarkDirty();
+
 		sListBoxItem *item = GetItem(id);
 		if (item)
 		{
@@ -233,12 +258,16 @@ namespace mash
 
 	void CMashGUIListBox::SetItemIconRegion(const MashGUIRect &destination)
 	{
+		MarkDirty();
+
 		m_ItemIconDestination = destination;
 		m_bUpdateNeeded = true;
 	}
 
 	void CMashGUIListBox::SetItemTextRegion(const MashGUIRect &destination)
 	{
+		MarkDirty();
+
 		m_ItemTextDestination = destination;
 		m_bUpdateNeeded = true;
 	}
@@ -280,6 +309,8 @@ namespace mash
 
 	void CMashGUIListBox::SetItemText(int32 id, const MashStringc &text)
 	{
+		MarkDirty();
+
 		const uint32 itemCount = m_listBoxItems.Size();
 		for(uint32 i = 0; i < itemCount; ++i)
 		{
@@ -306,6 +337,8 @@ namespace mash
 
 	void CMashGUIListBox::SetItemIconSourceRegion(int32 id, const mash::MashRectangle2 &source)
 	{
+		MarkDirty();
+
 		MashGUIStyle *activeStyle = m_GUIManager->GetActiveGUIStyle();
 		MashGUIFont *activeFont = activeStyle->GetFont();
 		const uint32 itemCount = m_listBoxItems.Size();
@@ -375,8 +408,12 @@ namespace mash
 	{
 		if (positionChangeOnly)
 		{
-			const uint32 iItemCount = m_listBoxItems.Size();
-			for(uint32 i = 0; i < iItemCount; ++i)
+			/*
+				Items outside the visible range are left as they are. They will be
+				fully updated when they are scrolled into view.
+			*/
+			const uint32 lastItem = GetLastVisibleItem();
+			for(uint32 i = m_firstVisibleItem; i < lastItem; ++i)
 			{
 				sListBoxItem *pItem = &m_listBoxItems[i];
 				if (!pItem->bCulled)
@@ -399,8 +436,10 @@ namespace mash
 		{
 			MashGUIStyle *activeStyle = m_GUIManager->GetActiveGUIStyle();
 			MashGUIFont *activeFont = activeStyle->GetFont();
-			const uint32 iItemCount = m_listBoxItems.Size();
-			for(uint32 i = 0; i < iItemCount; ++i)
+
+			CalculateVisibleItemRange();
+			const uint32 lastItem = GetLastVisibleItem();
+			for(uint32 i = m_firstVisibleItem; i < lastItem; ++i)
 			{
 				UpdateItem(&m_listBoxItems[i], i, activeFont);
 			}
@@ -419,6 +458,9 @@ namespace mash
 	{
 		if (GetEventsEnabled())
 		{
+			const int32 lastSelectedItem = m_iSelectedItem;
+			const bool lastUpdateNeeded = m_bUpdateNeeded;
+
 			if (eventData.eventType == sInputEvent::aEVENTTYPE_MOUSE && m_hasFocus)
 			{
 				switch(eventData.action)
@@ -448,8 +490,12 @@ namespace mash
 							uint32 iNewClickTime = MashDevice::StaticDevice->GetTimer()->GetTimeSinceProgramStart();
 							mash::MashVector2 vMousePos = m_inputManager->GetCursorPosition();
 
-							const uint32 iItemCount = m_listBoxItems.Size();
-							for(uint32 i = 0; i < iItemCount; ++i)
+							//make sure item regions are current before testing them
+							if (m_bUpdateNeeded)
+								UpdateAllItems(false);
+
+							const uint32 lastItem = GetLastVisibleItem();
+							for(uint32 i = m_firstVisibleItem; i < lastItem; ++i)
 							{
 								sListBoxItem *pItem = &m_listBoxItems[i];
 
@@ -489,11 +535,16 @@ namespace mash
 					}
 				}
 			}
+
+			if ((m_iSelectedItem != lastSelectedItem) || (m_bUpdateNeeded && !lastUpdateNeeded))
+				MarkDirty();
 		}
 	}
 
 	void CMashGUIListBox::RemoveItem(int32 id) 
 	{
+		MarkDirty();
+
 		const uint32 itemCount = m_listBoxItems.Size();
 		for(uint32 i = 0; i < itemCount; ++i)
 		{
@@ -510,6 +561,8 @@ namespace mash
 
 	int32 CMashGUIListBox::AddItem(const MashStringc &text, int32 userValue, mash::MashTexture *pIcon, const mash::MashRectangle2 *iconDestRegion)
 	{
+		MarkDirty();
+
 		sListBoxItem newItem;
 
 		const int32 newId = m_itemIdCounter++;
@@ -596,6 +649,8 @@ namespace mash
 
 	void CMashGUIListBox::ClearAllItems()
 	{
+		MarkDirty();
+
 		MashArray<sListBoxItem>::Iterator lbIter = m_listBoxItems.Begin();
 		MashArray<sListBoxItem>::Iterator lbIterEnd = m_listBoxItems.End();
 		for(; lbIter != lbIterEnd; ++lbIter)
@@ -648,8 +703,8 @@ namespace mash
 
 			m_GUIManager->DrawSprite(m_absoluteRegion, m_absoluteClippedRegion, backgroundSkin, m_overrideTransparency);
 
-			const uint32 iItemCount = m_listBoxItems.Size();
-			for(uint32 i = 0; i < iItemCount; ++i)
+			const uint32 lastItem = GetLastVisibleItem();
+			for(uint32 i = m_firstVisibleItem; i < lastItem; ++i)
 			{
 				sListBoxItem *pItem = &m_listBoxItems[i];
 
@@ -691,7 +746,7 @@ namespace mash
 
 				iconSkin->baseColour = sMashColour(255, 255, 255, 255);
 
-				for(uint32 i = 0; i < iItemCount; ++i)
+				for(uint32 i = m_firstVisibleItem; i < lastItem; ++i)
 				{
 					sListBoxItem *pItem = &m_listBoxItems[i];
 
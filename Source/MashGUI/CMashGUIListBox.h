@@ -52,7 +52,16 @@ namespace mash
 		MashGUIScrollbarView *m_pScrollBar;
 		MashArray<sListBoxItem> m_listBoxItems;
 
+		/*
+			Only items within this range are positioned, drawn and tested for clicks.
+			The last item is exclusive and may be larger than the item count.
+		*/
+		uint32 m_firstVisibleItem;
+		uint32 m_lastVisibleItem;
+
 		void CalculateMaxVisibleItems();
+		void CalculateVisibleItemRange();
+		uint32 GetLastVisibleItem()const;
 
 		void OnSBValueChange(const sGUIEvent &eventData);
 		void UpdateItem(sListBoxItem *pItem, int32 itemPos, MashGUIFont *font);
@@ -138,6 +147,11 @@ namespace mash
 		return m_iSelectedItem;
 	}
 
+	inline uint32 CMashGUIListBox::GetLastVisibleItem()const
+	{
+		return math::Min<uint32>(m_lastVisibleItem, m_listBoxItems.Size());
+	}
+
 	inline eMASH_GUI_TYPE CMashGUIListBox::GetGUIType()const
 	{
 		return aGUI_LISTBOX;
@@ -10,6 +10,7 @@
 #include "CMashGUIFontBatch.h"
 #include "CMashGUILineBatch.h"
 #include "CMashGUIPrimitiveBatch.h"
+#include "CMashGUIRenderCache.h"
 #include "MashLog.h"
 
 #include "CMashGUIButton.h"
@@ -54,7 +55,8 @@ namespace mash
 	CMashGUIManager::CMashGUIManager():MashGUIManager(),
 		m_pRenderer(0), m_pFocus(0),
 		m_activeStyle(0),m_pFontBatch(0), m_pLineBatch(0), m_pRenderBatch(0), m_pPrimitiveBatch(0),
-		m_pMouseHoverComponent(0), m_beginDrawCalled(false), m_debugDrawColour(255, 255, 255, 255), m_pRootWindow(0)
+		m_pMouseHoverComponent(0), m_beginDrawCalled(false), m_debugDrawColour(255, 255, 255, 255), m_pRootWindow(0),
+		m_retainedDrawDepth(0), m_generatedVertexCount(0), m_reusedVertexCount(0)
 	{
 	}
 
@@ -115,6 +117,15 @@ namespace mash
 		}
 
 		ProcessDestroyList();
+
+		std::map<const MashGUIComponent*, CMashGUIRenderCache*>::iterator cacheIter = m_renderCaches.begin();
+		std::map<const MashGUIComponent*, CMashGUIRenderCache*>::iterator cacheIterEnd = m_renderCaches.end();
+		for(; cacheIter != cacheIterEnd; ++cacheIter)
+		{
+			MASH_DELETE cacheIter->second;
+		}
+
+		m_renderCaches.clear();
 	}
 
 	eMASH_STATUS CMashGUIManager::_Initialise(const mash::sMashDeviceSettings &settings, MashVideo *pRenderer, MashInputManager *pInputManager)
@@ -674,6 +685,8 @@ namespace mash
 			MashGUIUnit(0.0f, viewPort.x + viewPort.width),MashGUIUnit(0.0f, viewPort.y + viewPort.height));
 
 		m_pRootWindow->SetDestinationRegion(rect);
+
+		InvalidateRenderCaches();
 	}
 
 	void CMashGUIManager::_DestroyElement(MashGUIComponent *element)
@@ -915,6 +928,8 @@ namespace mash
 		if (m_pRootWindow)
 			m_pRootWindow->OnStyleChange(m_activeStyle);
 
+		InvalidateRenderCaches();
+
 		return aMASH_OK;
 	}
 
@@ -1052,6 +1067,11 @@ namespace mash
 			}
 		}
 		
+		/*
+			Hover and focus changes mark components dirty as they happen. Components
+			that change how they look in response to input mark themselves dirty
+			from OnEvent(), so mouse movement alone doesn't invalidate retained views.
+		*/
 		if (!skipMessage && m_pFocus)
 			m_pFocus->OnEvent(eventData);
 	}
@@ -1062,6 +1082,95 @@ namespace mash
 		m_pRenderBatch->Flush();
 		m_pFontBatch->Flush();
 		m_pLineBatch->Flush();
+
+		for(uint32 i = 0; i < m_recordingCaches.Size(); ++i)
+			m_recordingCaches[i]->AddFlush();
+	}
+
+	void CMashGUIManager::OnVerticesDrawn(uint32 vertexCount)
+	{
+		if (m_retainedDrawDepth > 0)
+			m_reusedVertexCount += vertexCount;
+		else
+			m_generatedVertexCount += vertexCount;
+	}
+
+	void CMashGUIManager::InvalidateRenderCaches()
+	{
+		std::map<const MashGUIComponent*, CMashGUIRenderCache*>::iterator cacheIter = m_renderCaches.begin();
+		std::map<const MashGUIComponent*, CMashGUIRenderCache*>::iterator cacheIterEnd = m_renderCaches.end();
+		for(; cacheIter != cacheIterEnd; ++cacheIter)
+		{
+			cacheIter->second->SetValid(false);
+		}
+	}
+
+	void CMashGUIManager::_BeginRetainedDraw(MashGUIComponent *owner)
+	{
+		CMashGUIRenderCache *cache = 0;
+		std::map<const MashGUIComponent*, CMashGUIRenderCache*>::iterator cacheIter = m_renderCaches.find(owner);
+		if (cacheIter == m_renderCaches.end())
+		{
+			cache = MASH_NEW_COMMON CMashGUIRenderCache();
+			m_renderCaches.insert(std::make_pair(owner, cache));
+		}
+		else
+		{
+			cache = cacheIter->second;
+			cache->Clear();
+		}
+
+		m_recordingCaches.PushBack(cache);
+	}
+
+	void CMashGUIManager::_EndRetainedDraw(MashGUIComponent *owner)
+	{
+		std::map<const MashGUIComponent*, CMashGUIRenderCache*>::iterator cacheIter = m_renderCaches.find(owner);
+		if (cacheIter == m_renderCaches.end())
+			return;
+
+		for(uint32 i = 0; i < m_recordingCaches.Size(); ++i)
+		{
+			if (m_recordingCaches[i] == cacheIter->second)
+			{
+				m_recordingCaches.Erase(i);
+				break;
+			}
+		}
+
+		cacheIter->second->SetValid(true);
+	}
+
+	bool CMashGUIManager::_DrawRetained(MashGUIComponent *owner)
+	{
+		std::map<const MashGUIComponent*, CMashGUIRenderCache*>::iterator cacheIter = m_renderCaches.find(owner);
+		if ((cacheIter == m_renderCaches.end()) || !cacheIter->second->IsValid())
+			return false;
+
+		++m_retainedDrawDepth;
+		cacheIter->second->Draw(this);
+		--m_retainedDrawDepth;
+
+		return true;
+	}
+
+	void CMashGUIManager::_ReleaseRetained(MashGUIComponent *owner)
+	{
+		std::map<const MashGUIComponent*, CMashGUIRenderCache*>::iterator cacheIter = m_renderCaches.find(owner);
+		if (cacheIter == m_renderCaches.end())
+			return;
+
+		for(uint32 i = 0; i < m_recordingCaches.Size(); ++i)
+		{
+			if (m_recordingCaches[i] == cacheIter->second)
+			{
+				m_recordingCaches.Erase(i);
+				break;
+			}
+		}
+
+		MASH_DELETE cacheIter->second;
+		m_renderCaches.erase(cacheIter);
 	}
 
 	eMASH_STATUS CMashGUIManager::BeginDraw()
@@ -1076,6 +1185,8 @@ namespace mash
 		m_sceneCamera->Enable2D(true);
 
 		m_beginDrawCalled = true;
+		m_generatedVertexCount = 0;
+		m_reusedVertexCount = 0;
 
 		return aMASH_OK;
 	}
@@ -1084,6 +1195,10 @@ namespace mash
 	{
 		if (m_beginDrawCalled)
 		{
+			//things like a text box caret change every frame
+			if (m_pFocus && m_pFocus->_RedrawEveryFrame())
+				m_pFocus->MarkDirty();
+
 			m_pRootWindow->Draw();
 		}
 	}
@@ -1109,6 +1224,8 @@ namespace mash
 		{
 			m_focusLockStack.Erase(iter);
 		}
+
+		_ReleaseRetained(component);
 	}
 
 	void CMashGUIManager::ProcessDestroyList()
@@ -1148,6 +1265,11 @@ namespace mash
 		if (m_pFontBatch)
 		{
 			m_pFontBatch->Draw(pVertices, iVertexCount, pTexture, fontColour);
+
+			for(uint32 i = 0; i < m_recordingCaches.Size(); ++i)
+				m_recordingCaches[i]->AddText(pVertices, iVertexCount, pTexture, fontColour);
+
+			OnVerticesDrawn(iVertexCount);
 		}
 	}
 
@@ -1157,6 +1279,11 @@ namespace mash
 		if (m_pPrimitiveBatch)
 		{
 			m_pPrimitiveBatch->Draw(rect, colour);
+
+			for(uint32 i = 0; i < m_recordingCaches.Size(); ++i)
+				m_recordingCaches[i]->AddSolidShape(rect, colour);
+
+			OnVerticesDrawn(6);
 		}
 	}
 
@@ -1165,6 +1292,11 @@ namespace mash
 		if (m_pPrimitiveBatch)
 		{
 			m_pPrimitiveBatch->Draw(vertices, vertexCount);
+
+			for(uint32 i = 0; i < m_recordingCaches.Size(); ++i)
+				m_recordingCaches[i]->AddSolidTriangles(vertices, vertexCount);
+
+			OnVerticesDrawn(vertexCount);
 		}
 	}
 
@@ -1174,6 +1306,11 @@ namespace mash
 		if (m_pLineBatch)
 		{
 			m_pLineBatch->Draw(rect, colour);
+
+			for(uint32 i = 0; i < m_recordingCaches.Size(); ++i)
+				m_recordingCaches[i]->AddBorder(rect, colour);
+
+			OnVerticesDrawn(8);
 		}
 	}
 
@@ -1183,6 +1320,11 @@ namespace mash
 		if (m_pLineBatch)
 		{
 			m_pLineBatch->Draw(top, bottom, colour);
+
+			for(uint32 i = 0; i < m_recordingCaches.Size(); ++i)
+				m_recordingCaches[i]->AddLine(top, bottom, colour);
+
+			OnVerticesDrawn(2);
 		}
 	}
 
@@ -1197,6 +1339,11 @@ namespace mash
 		if (m_pRenderBatch)
 		{
 			m_pRenderBatch->Draw(pVertices, iVertexCount, material, transparencyOverride);
+
+			for(uint32 i = 0; i < m_recordingCaches.Size(); ++i)
+				m_recordingCaches[i]->AddSprite(pVertices, iVertexCount, material, transparencyOverride);
+
+			OnVerticesDrawn(iVertexCount);
 		}
 	}
 
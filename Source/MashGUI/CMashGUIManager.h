@@ -16,6 +16,7 @@ namespace mash
 	class CMashGUIFontBatch;
 	class CMashGUILineBatch;
 	class CMashGUIPrimitiveBatch;
+	class CMashGUIRenderCache;
     class MashCamera;
 	class MashGUIFactory;
 
@@ -53,6 +54,17 @@ namespace mash
 		MashGUIView *m_pRootWindow;
 		mash::sMashColour m_debugDrawColour;
 
+		//retained view caches
+		std::map<const MashGUIComponent*, CMashGUIRenderCache*> m_renderCaches;
+		//caches currently being rebuilt. Nested retained views record into all of them.
+		MashArray<CMashGUIRenderCache*> m_recordingCaches;
+		uint32 m_retainedDrawDepth;
+		uint32 m_generatedVertexCount;
+		uint32 m_reusedVertexCount;
+
+		void OnVerticesDrawn(uint32 vertexCount);
+		void InvalidateRenderCaches();
+
 		void OnFocusLost(MashGUIComponent *elm);
 		void OnFocus(MashGUIComponent *elm);
 		void ProcessDestroyList();
@@ -123,6 +135,14 @@ namespace mash
 
 		void FlushBuffers();
 
+		uint32 GetGeneratedVertexCount()const;
+		uint32 GetReusedVertexCount()const;
+
+		void _BeginRetainedDraw(MashGUIComponent *owner);
+		void _EndRetainedDraw(MashGUIComponent *owner);
+		bool _DrawRetained(MashGUIComponent *owner);
+		void _ReleaseRetained(MashGUIComponent *owner);
+
 		void DrawSprite(const mash::MashVertexGUI::sMashVertexGUI *pVertices,
 			uint32 iVertexCount,
 			const MashGUISkin *skin,
@@ -183,6 +203,16 @@ namespace mash
 		return m_pRootWindow;
 	}
 
+	inline uint32 CMashGUIManager::GetGeneratedVertexCount()const
+	{
+		return m_generatedVertexCount;
+	}
+
+	inline uint32 CMashGUIManager::GetReusedVertexCount()const
+	{
+		return m_reusedVertexCount;
+	}
+
 	inline MashGUIComponent* CMashGUIManager::GetFocusedElement()
 	{
 		return m_pFocus;
@@ -80,6 +80,8 @@ namespace mash
 
 	void CMashGUIMenuBar::SetItemText(int32 id, const MashStringc &text)
 	{
+		MarkDirty();
+
 		sItem *selectedItem = GetItem(id);
 		if (!selectedItem)
 			return;
@@ -99,6 +101,8 @@ namespace mash
 
 	void CMashGUIMenuBar::RemoveItem(int32 id)
 	{
+		MarkDirty();
+
 		const uint32 itemCount = m_itemList.Size();
 		for(uint32 i = 0; i < itemCount; ++i)
 		{
@@ -127,6 +131,8 @@ namespace mash
 
 	int32 CMashGUIMenuBar::AddItem(const MashStringc &text, MashGUIPopupMenu *pSubMenu, int32 userValue)
 	{
+		MarkDirty();
+
 		if (!pSubMenu)
 			return -1;
 
@@ -373,6 +379,8 @@ namespace mash
 	{
 		if (GetEventsEnabled())
 		{
+			const int32 lastFocusedItemId = m_focusedItemId;
+
 			if (m_mouseHover && eventData.eventType == sInputEvent::aEVENTTYPE_MOUSE)
 			{
 				switch(eventData.action)
@@ -412,6 +420,9 @@ namespace mash
 					};
 				}
 			}
+
+			if (m_focusedItemId != lastFocusedItemId)
+				MarkDirty();
 		}
 	}
 }
\ No newline at end of file
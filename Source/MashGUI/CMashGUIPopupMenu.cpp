@@ -138,6 +138,8 @@ namespace mash
 
 	void CMashGUIPopupMenu::SetItemText(int32 id, const MashStringc &text)
 	{
+		MarkDirty();
+
 		sItem *selectedItem = (sItem*)GetItem(id);
 		if (!selectedItem)
 			return;
@@ -157,6 +159,8 @@ namespace mash
 
 	void CMashGUIPopupMenu::RemoveItem(int32 id)
 	{
+		MarkDirty();
+
 		const uint32 itemCount = m_itemList.Size();
 		for(uint32 i = 0; i < itemCount; ++i)
 		{
@@ -186,6 +190,8 @@ namespace mash
 
 	int32 CMashGUIPopupMenu::AddItem(const MashStringc &text, int32 returnValue/*, bool bIsChecked*/, MashGUIPopupMenu *pSubMenu)
 	{
+		MarkDirty();
+
 		MashGUIStyle *activeStyle = m_GUIManager->GetActiveGUIStyle();
 		sItem *newItem = MASH_NEW_T_COMMON(sItem);
 		newItem->textHandler.SetString(text);
@@ -334,6 +340,7 @@ namespace mash
 			m_destinationRegion.GetAbsoluteValue(m_parent->GetAbsoluteRegion(), m_absoluteRegion);
 			m_absoluteClippedRegion = m_absoluteRegion;
 			m_cullState = m_absoluteClippedRegion.ClipGUI(m_parent->GetAbsoluteClippedRegion());
+			MarkLayoutDirty();
 
 			f32 fCurrentHeight = m_absoluteRegion.top;
 			const uint32 fTextHeight = activeFont->GetMaxCharacterHeight();
@@ -459,6 +466,8 @@ namespace mash
 	{
 		if (GetEventsEnabled())
 		{
+			const int32 lastFocusedItem = m_focusedItem;
+
 			if (eventData.eventType == sInputEvent::aEVENTTYPE_MOUSE)
 			{
 				switch(eventData.action)
@@ -545,6 +554,9 @@ namespace mash
 			*/
 			if (m_pPopupOwner)
 				m_pPopupOwner->OnEvent(eventData);
+
+			if (m_focusedItem != lastFocusedItem)
+				MarkDirty();
 		}
 	}
 }
\ No newline at end of file
@@ -15,13 +15,11 @@ namespace mash
 {
 	CMashGUIPrimitiveBatch::CMashGUIPrimitiveBatch(MashGUIManager *pGUIManager, 
 		MashVideo *pRenderer,
-		int32 iMaxVertexCount):
+		uint32 iMaxVertexCount):
 		m_pVertexDeclaration(0),
 		m_GUIManager(pGUIManager),
 		m_pRenderer(pRenderer),
-		m_meshBuffer(0),m_pVertexPtr(0),
-		m_iCurrentReservedVertex(6),
-		m_iCurrentVertexCount(0),
+		m_transientBuffer(0),
 		m_iMaxVertexCount(iMaxVertexCount),
 		m_currentColour(1.0f, 1.0f, 1.0f, 1.0f),
 		m_pMaterial(0)
@@ -30,12 +28,6 @@ namespace mash
 
 	CMashGUIPrimitiveBatch::~CMashGUIPrimitiveBatch()
 	{
-		if (m_meshBuffer)
-		{
-			m_meshBuffer->Drop();
-			m_meshBuffer = 0;
-		}
-
 		if (m_pVertexDeclaration)
 		{
 			m_pVertexDeclaration->Drop();
@@ -83,129 +75,28 @@ namespace mash
 
 		m_pVertexDeclaration->Grab();
 
-		ResizeBuffers();
-
-		return aMASH_OK;
-	}
-
-	eMASH_STATUS CMashGUIPrimitiveBatch::UnlockBuffers()
-	{
-		if (m_pVertexPtr)
-		{
-			if (m_meshBuffer->GetVertexBuffer()->Unlock() == aMASH_FAILED)
-			{
-				return aMASH_FAILED;
-			}
-
-			m_pVertexPtr = 0;
-		}
-
-		return aMASH_OK;
-	}
-
-	eMASH_STATUS CMashGUIPrimitiveBatch::LockBuffers()
-	{
-		if (!m_pVertexPtr)
-		{
-			if (m_meshBuffer->GetVertexBuffer()->Lock(mash::aLOCK_WRITE_DISCARD, (void**)(&m_pVertexPtr)) == aMASH_FAILED)
-			{
-				return aMASH_FAILED;
-			}
-
-			m_iCurrentVertexCount = 0;
-		}
-
-		return aMASH_OK;
-	}
-
-	eMASH_STATUS CMashGUIPrimitiveBatch::ResizeBuffers()
-	{
-		if (UnlockBuffers() == aMASH_FAILED)
+		m_transientBuffer = m_pRenderer->GetTransientVertexBuffer(m_pVertexDeclaration);
+		if (!m_transientBuffer)
 		{
 			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
-						"Failed to unlock GUI buffer.", 
-						"CMashGUIPrimitiveBatch::ResizeBuffers");
+						"Failed to get the transient vertex buffer.", 
+						"CMashGUIPrimitiveBatch::Initialise");
 
 			return aMASH_FAILED;
 		}
 
-		if (!m_meshBuffer)
-		{
-			sVertexStreamInit streamData;
-			streamData.data = 0;
-			streamData.dataSizeInBytes = m_iCurrentReservedVertex * m_pVertexDeclaration->GetStreamSizeInBytes(0);
-			streamData.usage = aUSAGE_DYNAMIC;
-
-			m_meshBuffer = m_pRenderer->CreateMeshBuffer(&streamData, 1, m_pVertexDeclaration);
-		}
-		else
-		{
-			m_pVertexPtr = 0;
-			if (m_meshBuffer->ResizeVertexBuffers(0, m_iCurrentReservedVertex * sizeof(mash::MashVertexColour::sMashVertexColour), aUSAGE_DYNAMIC, false) == aMASH_FAILED)
-            {
-                MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
-                                 "Failed to resize vertex buffer.", 
-                                 "CMashGUIPrimitiveBatch::ResizeBuffers");
-                
-				return aMASH_FAILED;
-            }
-		}
-
-		if (!m_meshBuffer)
-        {
-            MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
-                             "Mesh buffer failed to be created for GUI buffer.", 
-                             "CMashGUIPrimitiveBatch::ResizeBuffers");
-            
-			return aMASH_FAILED;
-        }
-
-		m_iCurrentVertexCount = 0;
-        
-        return aMASH_OK;
+		return aMASH_OK;
 	}
 
 	eMASH_STATUS CMashGUIPrimitiveBatch::Draw(const mash::MashVertexColour::sMashVertexColour *vertices, uint32 vertexCount)
 	{
-		int32 iNewCount = m_iCurrentVertexCount+vertexCount;
-		if (iNewCount > m_iCurrentReservedVertex)
+		if ((m_vertices.Size() + vertexCount) > m_iMaxVertexCount)
 		{
 			//render all the buffers so that render layer order is maintained
 			m_GUIManager->FlushBuffers();
-
-			//check if the buffer can grow
-			if (iNewCount < m_iMaxVertexCount)
-			{
-				m_iCurrentReservedVertex = iNewCount * 2;
-
-				if (m_iCurrentReservedVertex > m_iMaxVertexCount)
-					m_iCurrentReservedVertex = m_iMaxVertexCount;
-
-				//resize the buffers
-				if (ResizeBuffers() == aMASH_FAILED)
-				{
-					MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
-						"Mesh buffer resize failed.", 
-						"CMashGUIPrimitiveBatch::Draw");
-
-					return aMASH_FAILED;
-				}
-			}
 		}
 
-		if (LockBuffers() == aMASH_FAILED)
-		{
-			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
-						"Failed to lock GUI buffer.", 
-						"CMashGUIPrimitiveBatch::Draw");
-
-			return aMASH_FAILED;
-		}
-
-		memcpy(&m_pVertexPtr[m_iCurrentVertexCount * sizeof(mash::MashVertexColour::sMashVertexColour)],
-			vertices, sizeof(mash::MashVertexColour::sMashVertexColour) * vertexCount);
-
-		m_iCurrentVertexCount += vertexCount;
+		m_vertices.Append(vertices, vertexCount);
         
         return aMASH_OK;
 	}
@@ -237,26 +128,29 @@ namespace mash
 
 	eMASH_STATUS CMashGUIPrimitiveBatch::Flush()
 	{
-		if (UnlockBuffers() == aMASH_FAILED)
-		{
-			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
-						"Failed to unlock GUI buffer.", 
-						"CMashGUIPrimitiveBatch::Flush");
-
-			return aMASH_FAILED;
-		}
-
 		eMASH_STATUS status = aMASH_OK;
 
-		if (m_iCurrentVertexCount > 0)
+		if (!m_vertices.Empty())
 		{
+			const uint32 vertexCount = m_vertices.Size();
+			uint32 firstVertex = 0;
+			if (m_transientBuffer->Write(m_vertices.Pointer(), vertexCount, firstVertex) == aMASH_FAILED)
+			{
+				MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+							"Failed to fill GUI buffer.", 
+							"CMashGUIPrimitiveBatch::Flush");
+
+				m_vertices.Clear();
+				return aMASH_FAILED;
+			}
+
 			if (m_pMaterial->OnSet() == aMASH_OK)
 			{
-				status = m_pRenderer->DrawVertexList(m_meshBuffer, m_iCurrentVertexCount,
-					m_iCurrentVertexCount / 3, aPRIMITIVE_TRIANGLE_LIST);
+				status = m_pRenderer->DrawVertexList(m_transientBuffer->GetMeshBuffer(), vertexCount,
+					vertexCount / 3, aPRIMITIVE_TRIANGLE_LIST, firstVertex);
 			}
 
-			m_iCurrentVertexCount = 0;
+			m_vertices.Clear();
 		}
 
 		return status;
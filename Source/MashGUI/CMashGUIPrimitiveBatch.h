@@ -7,7 +7,9 @@
 #define _C_MASH_GUI_PRIMITIVE_BATCH_H_
 
 #include "MashReferenceCounter.h"
-#include "MashMeshBuffer.h"
+#include "MashTransientVertexBuffer.h"
+#include "MashArray.h"
+#include "MashVertex.h"
 #include "MashMaterial.h"
 #include "MashVector2.h"
 #include "MashRectangle2.h"
@@ -22,26 +24,20 @@ namespace mash
 	{
 	private:
 		MashVideo *m_pRenderer;
-		MashMeshBuffer *m_meshBuffer;
+		MashTransientVertexBuffer *m_transientBuffer;
 		MashVertex *m_pVertexDeclaration;
-		uint8 *m_pVertexPtr;
-		int32 m_iCurrentReservedVertex;
-		int32 m_iCurrentVertexCount;
-		int32 m_iMaxVertexCount;
+		MashArray<mash::MashVertexColour::sMashVertexColour> m_vertices;
+		uint32 m_iMaxVertexCount;
 		MashMaterial *m_pMaterial;
 
 		mash::sMashColour4 m_currentColour;
 
-		eMASH_STATUS UnlockBuffers();
-		eMASH_STATUS LockBuffers();
-		eMASH_STATUS ResizeBuffers();
-
 		MashGUIManager *m_GUIManager;
 
 	public:
 		CMashGUIPrimitiveBatch(MashGUIManager *pGUIManager,
 			MashVideo *pRenderer, 
-			int32 iMaxVertexCount = 100000);
+			uint32 iMaxVertexCount = 100000);
 		~CMashGUIPrimitiveBatch();
 
 		eMASH_STATUS Initialise();
@@ -17,13 +17,11 @@ namespace mash
 {
 	CMashGUIRenderBatch::CMashGUIRenderBatch(MashGUIManager *pGUIManager, 
 		MashVideo *pRenderer,
-		int32 iMaxVertexCount):
+		uint32 iMaxVertexCount):
 		m_pVertexDeclaration(0),
 		m_GUIManager(pGUIManager),
 		m_pRenderer(pRenderer),
-		m_meshBuffer(0),m_pVertexPtr(0),
-		m_iCurrentReservedVertex(6),
-		m_iCurrentVertexCount(0),
+		m_transientBuffer(0),
 		m_iMaxVertexCount(iMaxVertexCount),
 		m_pMaterial(0),
 		m_pAlphaMaskThreshholdEffectHandler(0),
@@ -37,12 +35,6 @@ namespace mash
 
 	CMashGUIRenderBatch::~CMashGUIRenderBatch()
 	{
-		if (m_meshBuffer)
-		{
-			m_meshBuffer->Drop();
-			m_meshBuffer = 0;
-		}
-
 		if (m_pVertexDeclaration)
 		{
 			m_pVertexDeclaration->Drop();
@@ -109,7 +101,15 @@ namespace mash
 
 		m_pVertexDeclaration->Grab();
 
-		ResizeBuffers();
+		m_transientBuffer = m_pRenderer->GetTransientVertexBuffer(m_pVertexDeclaration);
+		if (!m_transientBuffer)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+						"Failed to get the transient vertex buffer.", 
+						"CMashGUIRenderBatch::Initialise");
+
+			return aMASH_FAILED;
+		}
 
 		if (m_pAlphaMaskThreshholdEffectHandler)
 			m_pAlphaMaskThreshholdEffectHandler->Drop();
@@ -150,83 +150,6 @@ namespace mash
 		return aMASH_OK;
 	}
 
-	eMASH_STATUS CMashGUIRenderBatch::UnlockBuffers()
-	{
-		if (m_pVertexPtr)
-		{
-			if (m_meshBuffer->GetVertexBuffer()->Unlock() == aMASH_FAILED)
-			{
-				return aMASH_FAILED;
-			}
-
-			m_pVertexPtr = 0;
-		}
-
-		return aMASH_OK;
-	}
-
-	eMASH_STATUS CMashGUIRenderBatch::LockBuffers()
-	{
-		if (!m_pVertexPtr)
-		{
-			if (m_meshBuffer->GetVertexBuffer()->Lock(mash::aLOCK_WRITE_DISCARD, (void**)(&m_pVertexPtr)) == aMASH_FAILED)
-			{
-				return aMASH_FAILED;
-			}
-
-			m_iCurrentVertexCount = 0;
-		}
-
-		return aMASH_OK;
-	}
-
-	eMASH_STATUS CMashGUIRenderBatch::ResizeBuffers()
-	{
-		if (UnlockBuffers() == aMASH_FAILED)
-		{
-			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
-						"Failed to unlock GUI buffer.", 
-						"CMashGUILineBatch::ResizeBuffers");
-
-			return aMASH_FAILED;
-		}
-
-		if (!m_meshBuffer)
-		{
-			sVertexStreamInit streamData;
-			streamData.data = 0;
-			streamData.dataSizeInBytes = m_iCurrentReservedVertex * m_pVertexDeclaration->GetStreamSizeInBytes(0);
-			streamData.usage = aUSAGE_DYNAMIC;
-
-			m_meshBuffer = m_pRenderer->CreateMeshBuffer(&streamData, 1, m_pVertexDeclaration);
-		}
-		else
-		{
-			m_pVertexPtr = 0;
-			if (m_meshBuffer->ResizeVertexBuffers(0, m_iCurrentReservedVertex * sizeof(mash::MashVertexGUI::sMashVertexGUI), aUSAGE_DYNAMIC, false) == aMASH_FAILED)
-            {
-                MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
-                                 "Failed to resize vertex buffer.", 
-                                 "CMashGUIRenderBatch::ResizeBuffers");
-                
-				return aMASH_FAILED;
-            }
-		}
-
-		if (!m_meshBuffer)
-        {
-            MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
-                             "Mesh buffer failed to be created for GUI buffer.", 
-                             "CMashGUIRenderBatch::ResizeBuffers");
-            
-			return aMASH_FAILED;
-        }
-
-		m_iCurrentVertexCount = 0;
-        
-        return aMASH_OK;
-	}
-
 	eMASH_STATUS CMashGUIRenderBatch::Draw(const mash::MashVertexGUI::sMashVertexGUI *pVertices,
 			uint32 iVertexCount,
 			const MashGUISkin *skin,
@@ -253,63 +176,35 @@ namespace mash
 			m_transparencyOverride = transparencyOverride;
 		}
 
-		uint32 iSizeNeeded = m_iCurrentVertexCount + iVertexCount;
-		if (iSizeNeeded > m_iCurrentReservedVertex)
+		if ((m_vertices.Size() + iVertexCount) > m_iMaxVertexCount)
 		{
+			//render all the buffers so that render layer order is maintained
 			m_GUIManager->FlushBuffers();
-
-			//check if the buffer can grow
-			if (m_iCurrentVertexCount < m_iMaxVertexCount)
-			{
-				m_iCurrentReservedVertex = iSizeNeeded * 2;
-
-				if (m_iCurrentReservedVertex > m_iMaxVertexCount)
-					m_iCurrentReservedVertex = m_iMaxVertexCount;
-
-				//resize the buffers
-				if (ResizeBuffers() == aMASH_FAILED)
-				{
-					MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
-						"Mesh buffer resize failed.", 
-						"CMashGUIRenderBatch::Draw");
-
-					return aMASH_FAILED;
-				}
-			}
-		}
-
-		if (LockBuffers() == aMASH_FAILED)
-		{
-			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
-						"Failed to lock GUI buffer.", 
-						"CMashGUIRenderBatch::Draw");
-
-			return aMASH_FAILED;
 		}
 
-		memcpy(&m_pVertexPtr[m_iCurrentVertexCount * sizeof(mash::MashVertexGUI::sMashVertexGUI)],
-			pVertices, sizeof(mash::MashVertexGUI::sMashVertexGUI) * iVertexCount);
-
-		m_iCurrentVertexCount += iVertexCount;
+		m_vertices.Append(pVertices, iVertexCount);
 
 		return aMASH_OK;
 	}
 
 	eMASH_STATUS CMashGUIRenderBatch::Flush()
 	{
-		if (UnlockBuffers() == aMASH_FAILED)
-		{
-			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
-						"Failed to unlock GUI buffer.", 
-						"CMashGUIRenderBatch::Flush");
-
-			return aMASH_FAILED;
-		}
-
 		eMASH_STATUS status = aMASH_OK;
 
-		if (m_iCurrentVertexCount > 0)
+		if (!m_vertices.Empty())
 		{
+			const uint32 vertexCount = m_vertices.Size();
+			uint32 firstVertex = 0;
+			if (m_transientBuffer->Write(m_vertices.Pointer(), vertexCount, firstVertex) == aMASH_FAILED)
+			{
+				MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+							"Failed to fill GUI buffer.", 
+							"CMashGUIRenderBatch::Flush");
+
+				m_vertices.Clear();
+				return aMASH_FAILED;
+			}
+
 			MashTechniqueInstance *activeTechnique = m_pMaterial->GetActiveTechnique();
 			if (activeTechnique)
 			{
@@ -336,11 +231,11 @@ namespace mash
 
 			if (m_pMaterial->OnSet())
 			{
-				m_pRenderer->DrawVertexList(m_meshBuffer, m_iCurrentVertexCount,
-					m_iCurrentVertexCount / 3, aPRIMITIVE_TRIANGLE_LIST);
+				m_pRenderer->DrawVertexList(m_transientBuffer->GetMeshBuffer(), vertexCount,
+					vertexCount / 3, aPRIMITIVE_TRIANGLE_LIST, firstVertex);
 			}
 
-			m_iCurrentVertexCount = 0;
+			m_vertices.Clear();
 		}
 
 		return status;
@@ -7,7 +7,9 @@
 #define _C_MASH_GUI_RENDER_BATCH_H_
 
 #include "MashReferenceCounter.h"
-#include "MashMeshBuffer.h"
+#include "MashTransientVertexBuffer.h"
+#include "MashArray.h"
+#include "MashVertex.h"
 #include "MashMaterial.h"
 #include "MashVector2.h"
 #include "MashGUISkin.h"
@@ -25,11 +27,9 @@ namespace mash
 	private:
 		MashVideo *m_pRenderer;
 		MashVertex *m_pVertexDeclaration;
-		MashMeshBuffer *m_meshBuffer;
-		uint8 *m_pVertexPtr;
-		int32 m_iCurrentReservedVertex;
-		int32 m_iCurrentVertexCount;
-		int32 m_iMaxVertexCount;
+		MashTransientVertexBuffer *m_transientBuffer;
+		MashArray<mash::MashVertexGUI::sMashVertexGUI> m_vertices;
+		uint32 m_iMaxVertexCount;
 		MashMaterial *m_pMaterial;
 
 		int32 m_alphaBlendState;
@@ -45,14 +45,10 @@ namespace mash
 		f32 m_alphaMaskThreshold;
 		sGUIOverrideTransparency m_transparencyOverride;
 
-		eMASH_STATUS UnlockBuffers();
-		eMASH_STATUS LockBuffers();
-		eMASH_STATUS ResizeBuffers();
-
 	public:
 		CMashGUIRenderBatch(MashGUIManager *pGUIManager,
 			MashVideo *pRenderer, 
-			int32 iMaxVertexCount = 100000);
+			uint32 iMaxVertexCount = 100000);
 		~CMashGUIRenderBatch();
 
 		eMASH_STATUS Initialise();
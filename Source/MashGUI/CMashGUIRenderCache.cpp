@@ -0,0 +1,148 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#include "CMashGUIRenderCache.h"
+#include "MashGUIManager.h"
+
+namespace mash
+{
+	CMashGUIRenderCache::CMashGUIRenderCache():MashMemoryObject(),
+		m_vertexCount(0), m_isValid(false)
+	{
+	}
+
+	void CMashGUIRenderCache::Clear()
+	{
+		//memory is kept for the next rebuild
+		m_commands.Clear();
+		m_spriteVertices.Clear();
+		m_textVertices.Clear();
+		m_solidVertices.Clear();
+		m_vertexCount = 0;
+		m_isValid = false;
+	}
+
+	void CMashGUIRenderCache::AddSprite(const MashVertexGUI::sMashVertexGUI *vertices, uint32 vertexCount,
+			const MashGUISkin *skin, const sGUIOverrideTransparency &transparencyOverride)
+	{
+		sCommand command;
+		command.type = aCOMMAND_SPRITE;
+		command.firstVertex = m_spriteVertices.Size();
+		command.vertexCount = vertexCount;
+		command.skin = skin;
+		command.transparencyOverride = transparencyOverride;
+		m_commands.PushBack(command);
+
+		m_spriteVertices.Append(vertices, vertexCount);
+		m_vertexCount += vertexCount;
+	}
+
+	void CMashGUIRenderCache::AddText(const MashVertexPosTex::sMashVertexPosTex *vertices, uint32 vertexCount,
+			MashTexture *texture, const sMashColour &fontColour)
+	{
+		sCommand command;
+		command.type = aCOMMAND_TEXT;
+		command.firstVertex = m_textVertices.Size();
+		command.vertexCount = vertexCount;
+		command.texture = texture;
+		command.colour = fontColour;
+		m_commands.PushBack(command);
+
+		m_textVertices.Append(vertices, vertexCount);
+		m_vertexCount += vertexCount;
+	}
+
+	void CMashGUIRenderCache::AddSolidTriangles(const MashVertexColour::sMashVertexColour *vertices, uint32 vertexCount)
+	{
+		sCommand command;
+		command.type = aCOMMAND_SOLID_TRIANGLES;
+		command.firstVertex = m_solidVertices.Size();
+		command.vertexCount = vertexCount;
+		m_commands.PushBack(command);
+
+		m_solidVertices.Append(vertices, vertexCount);
+		m_vertexCount += vertexCount;
+	}
+
+	void CMashGUIRenderCache::AddSolidShape(const MashRectangle2 &rect, const sMashColour &colour)
+	{
+		sCommand command;
+		command.type = aCOMMAND_SOLID_SHAPE;
+		command.vertexCount = 6;
+		command.rect = rect;
+		command.colour = colour;
+		m_commands.PushBack(command);
+
+		m_vertexCount += command.vertexCount;
+	}
+
+	void CMashGUIRenderCache::AddBorder(const MashRectangle2 &rect, const sMashColour &colour)
+	{
+		sCommand command;
+		command.type = aCOMMAND_BORDER;
+		command.vertexCount = 8;
+		command.rect = rect;
+		command.colour = colour;
+		m_commands.PushBack(command);
+
+		m_vertexCount += command.vertexCount;
+	}
+
+	void CMashGUIRenderCache::AddLine(const MashVector2 &start, const MashVector2 &end, const sMashColour &colour)
+	{
+		sCommand command;
+		command.type = aCOMMAND_LINE;
+		command.vertexCount = 2;
+		command.rect = MashRectangle2(start.x, start.y, end.x, end.y);
+		command.colour = colour;
+		m_commands.PushBack(command);
+
+		m_vertexCount += command.vertexCount;
+	}
+
+	void CMashGUIRenderCache::AddFlush()
+	{
+		//consecutive flushes do nothing
+		if (!m_commands.Empty() && (m_commands.Back().type == aCOMMAND_FLUSH))
+			return;
+
+		sCommand command;
+		command.type = aCOMMAND_FLUSH;
+		m_commands.PushBack(command);
+	}
+
+	void CMashGUIRenderCache::Draw(MashGUIManager *manager)const
+	{
+		const uint32 commandCount = m_commands.Size();
+		for(uint32 i = 0; i < commandCount; ++i)
+		{
+			const sCommand &command = m_commands[i];
+			switch(command.type)
+			{
+			case aCOMMAND_SPRITE:
+				manager->DrawSprite(&m_spriteVertices[command.firstVertex], command.vertexCount, command.skin, command.transparencyOverride);
+				break;
+			case aCOMMAND_TEXT:
+				manager->DrawText(&m_textVertices[command.firstVertex], command.vertexCount, command.texture, command.colour);
+				break;
+			case aCOMMAND_SOLID_TRIANGLES:
+				manager->DrawSolidTriangles(&m_solidVertices[command.firstVertex], command.vertexCount);
+				break;
+			case aCOMMAND_SOLID_SHAPE:
+				manager->DrawSolidShape(command.rect, command.colour);
+				break;
+			case aCOMMAND_BORDER:
+				manager->DrawBorder(command.rect, command.colour);
+				break;
+			case aCOMMAND_LINE:
+				manager->DrawLine(MashVector2(command.rect.left, command.rect.top), MashVector2(command.rect.right, command.rect.bottom), command.colour);
+				break;
+			case aCOMMAND_FLUSH:
+				manager->FlushBuffers();
+				break;
+			};
+		}
+	}
+}
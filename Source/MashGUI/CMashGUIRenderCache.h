@@ -0,0 +1,106 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#ifndef _C_MASH_GUI_RENDER_CACHE_H_
+#define _C_MASH_GUI_RENDER_CACHE_H_
+
+#include "MashMemoryObject.h"
+#include "MashArray.h"
+#include "MashVertex.h"
+#include "MashRectangle2.h"
+#include "MashGUITypes.h"
+
+namespace mash
+{
+	class MashGUIManager;
+	class MashGUISkin;
+	class MashTexture;
+
+	/*
+		Holds the draw calls made by a retained view and its children, in the
+		order they were made. Drawing the cache sends the same calls back to the
+		GUI manager without regenerating any geometry.
+
+		Skins and textures are not grabbed. The view is marked dirty
+		if anything that owns them changes.
+	*/
+	class CMashGUIRenderCache : public MashMemoryObject
+	{
+	private:
+		enum eCOMMAND
+		{
+			aCOMMAND_SPRITE,
+			aCOMMAND_TEXT,
+			aCOMMAND_SOLID_TRIANGLES,
+			aCOMMAND_SOLID_SHAPE,
+			aCOMMAND_BORDER,
+			aCOMMAND_LINE,
+			aCOMMAND_FLUSH
+		};
+
+		struct sCommand
+		{
+			eCOMMAND type;
+			uint32 firstVertex;
+			uint32 vertexCount;
+			const MashGUISkin *skin;
+			MashTexture *texture;
+			sMashColour colour;
+			sGUIOverrideTransparency transparencyOverride;
+			//borders and solid shapes. Lines store the start in left/top and the end in right/bottom.
+			MashRectangle2 rect;
+
+			sCommand():type(aCOMMAND_FLUSH), firstVertex(0), vertexCount(0), skin(0), texture(0){}
+		};
+
+		MashArray<sCommand> m_commands;
+		MashArray<MashVertexGUI::sMashVertexGUI> m_spriteVertices;
+		MashArray<MashVertexPosTex::sMashVertexPosTex> m_textVertices;
+		MashArray<MashVertexColour::sMashVertexColour> m_solidVertices;
+		uint32 m_vertexCount;
+		bool m_isValid;
+	public:
+		CMashGUIRenderCache();
+		~CMashGUIRenderCache(){}
+
+		void Clear();
+
+		void AddSprite(const MashVertexGUI::sMashVertexGUI *vertices, uint32 vertexCount,
+			const MashGUISkin *skin, const sGUIOverrideTransparency &transparencyOverride);
+		void AddText(const MashVertexPosTex::sMashVertexPosTex *vertices, uint32 vertexCount,
+			MashTexture *texture, const sMashColour &fontColour);
+		void AddSolidTriangles(const MashVertexColour::sMashVertexColour *vertices, uint32 vertexCount);
+		void AddSolidShape(const MashRectangle2 &rect, const sMashColour &colour);
+		void AddBorder(const MashRectangle2 &rect, const sMashColour &colour);
+		void AddLine(const MashVector2 &start, const MashVector2 &end, const sMashColour &colour);
+		void AddFlush();
+
+		//Sends all recorded calls to the manager.
+		void Draw(MashGUIManager *manager)const;
+
+		//Total vertices drawn by Draw().
+		uint32 GetVertexCount()const;
+
+		void SetValid(bool state);
+		bool IsValid()const;
+	};
+
+	inline uint32 CMashGUIRenderCache::GetVertexCount()const
+	{
+		return m_vertexCount;
+	}
+
+	inline void CMashGUIRenderCache::SetValid(bool state)
+	{
+		m_isValid = state;
+	}
+
+	inline bool CMashGUIRenderCache::IsValid()const
+	{
+		return m_isValid;
+	}
+}
+
+#endif
@@ -30,6 +30,9 @@ namespace mash
     
 	f32 CMashGUIScrollBar::MoveSliderByPixels(f32 value)
 	{
+		if (value != 0.0f)
+			MarkDirty();
+
 		f32 oldSliderValue = m_sliderValue;		
 		m_sliderPosition += value;
 
@@ -52,6 +55,8 @@ namespace mash
 
 	f32 CMashGUIScrollBar::SetSliderValue(f32 value)
 	{
+		MarkDirty();
+
 		value = math::Clamp<f32>(m_minValue, m_maxValue, value);
 
 		if (value == m_sliderValue)
@@ -85,6 +90,8 @@ namespace mash
 
 	void CMashGUIScrollBar::SetSliderMinMaxValues(f32 min, f32 max)
 	{
+		MarkDirty();
+
 		m_minValue = min;
 		m_maxValue = max;
 
@@ -99,6 +106,9 @@ namespace mash
 	{
 		if (GetEventsEnabled())
 		{
+			const eBUTTON lastSelectedButton = m_eSelectedButton;
+			const eBUTTON lastHoverButton = m_eMouseHoverButton;
+
 			if ((eventData.eventType == sInputEvent::aEVENTTYPE_MOUSE))
 			{
 				int32 mouseX, mouseY;
@@ -182,6 +192,9 @@ namespace mash
 					}
 				};
 			}
+
+			if ((m_eSelectedButton != lastSelectedButton) || (m_eMouseHoverButton != lastHoverButton))
+				MarkDirty();
 		}
 	}
 
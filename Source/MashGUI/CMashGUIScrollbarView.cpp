@@ -161,6 +161,9 @@ namespace mash
 
 	void CMashGUIScrollbarView::MoveSlider(f32 value)
 	{
+		if (value != 0.0f)
+			MarkDirty();
+
 		m_sliderPosition += value;
 		ResizeSlider();
 		f32 oldSliderValue = m_sliderValue;
@@ -221,6 +224,9 @@ namespace mash
 	{
 		if (GetEventsEnabled())
 		{
+			const eBUTTON lastSelectedButton = m_eSelectedButton;
+			const eBUTTON lastHoverButton = m_eMouseHoverButton;
+
 			if ((eventData.eventType == sInputEvent::aEVENTTYPE_MOUSE))
 			{
 				int32 mouseX, mouseY;
@@ -316,6 +322,9 @@ namespace mash
 					}
 				};
 			}
+
+			if ((m_eSelectedButton != lastSelectedButton) || (m_eMouseHoverButton != lastHoverButton))
+				MarkDirty();
 		}
 	}
 
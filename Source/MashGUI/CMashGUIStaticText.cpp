@@ -49,6 +49,8 @@ namespace mash
 
 	void CMashGUIStaticText::AddText(const MashStringc &text)
 	{
+		MarkDirty();
+
 		if (m_autoResizeToFitText)
 		{
 			m_fitToBoundsNeeded = true;
@@ -67,6 +69,8 @@ namespace mash
 
 	void CMashGUIStaticText::SetText(const MashStringc &text)
 	{
+		MarkDirty();
+
 		m_textHandler.SetString(text);
 	}
 
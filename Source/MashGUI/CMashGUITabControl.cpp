@@ -69,6 +69,8 @@ namespace mash
 
 	void CMashGUITabControl::SetActiveTabByID(int32 iTabID)
 	{
+		MarkDirty();
+
 		m_iActiveTab = iTabID;
 	}
 
@@ -171,6 +173,8 @@ namespace mash
 
 	int32 CMashGUITabControl::AddTab(const MashStringc &text)
 	{
+		MarkDirty();
+
 		const int32 iTabID = m_tabIDCount++;
 
 		MashGUIStyle *activeStyle = m_GUIManager->GetActiveGUIStyle();
@@ -243,6 +247,8 @@ namespace mash
 
 	void CMashGUITabControl::SetText(int32 id, const MashStringc &text)
 	{
+		MarkDirty();
+
 		sTab *activeTab = GetTab(id);
 		if (activeTab)
 		{
@@ -276,6 +282,8 @@ namespace mash
 
 	void CMashGUITabControl::RemoveTab(int32 id)
 	{
+		MarkDirty();
+
 		const uint32 tabCount = m_tabs.Size();
 		//dont remove the last element
 		if (tabCount == 1)
@@ -327,6 +335,8 @@ namespace mash
 	{
 		if (GetEventsEnabled())
 		{
+			const int32 lastHoverTab = m_iHoverTab;
+
 			if ((eventData.eventType == sInputEvent::aEVENTTYPE_MOUSE))
 			{
 				mash::MashVector2 vMousePos = m_inputManager->GetCursorPosition();
@@ -379,6 +389,9 @@ namespace mash
 					}
 				};
 			}
+
+			if (m_iHoverTab != lastHoverTab)
+				MarkDirty();
 		}
 	}
 
@@ -125,6 +125,8 @@ namespace mash
 
 	void CMashGUITextBox::SetWordWrap(bool bEnable)
 	{
+		MarkDirty();
+
 		m_textHandler.SetWordWrap(bEnable);
 	}
 
@@ -139,6 +141,8 @@ namespace mash
 
 	void CMashGUITextBox::SetText(const MashStringc &text)
 	{
+		MarkDirty();
+
 		//if this string has already been confirmed then dont do anything
 		if (m_lastConfirmedString == text)
 			return;
@@ -183,6 +187,7 @@ namespace mash
 
 	void CMashGUITextBox::SetCursorPos(uint32 iIndex)
 	{
+		MarkDirty();
 	}
 
 	void CMashGUITextBox::RemoveCharacters(uint32 iCount)
@@ -193,6 +198,8 @@ namespace mash
 
 	void CMashGUITextBox::SetTextColour(const sMashColour &colour)
 	{
+		MarkDirty();
+
 		m_backgroundSkin.fontColour = colour;
 	}
 
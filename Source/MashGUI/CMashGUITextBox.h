@@ -78,6 +78,7 @@ namespace mash
 		bool GetNumberButtonState()const;
 
 		void Draw();
+		bool _RedrawEveryFrame()const;
 		eMASH_GUI_TYPE GetGUIType()const;
 
 		int32 GetTextAsInt();
@@ -195,6 +196,12 @@ namespace mash
 	{
 		return aGUI_TEXT_BOX;
 	}
+
+	inline bool CMashGUITextBox::_RedrawEveryFrame()const
+	{
+		//the caret blinks while focused
+		return GetHasFocus();
+	}
 }
 #endif
 
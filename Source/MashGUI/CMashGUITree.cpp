@@ -13,6 +13,7 @@ namespace mash
 	const f32 g_buttonSize = 15.0f;
 	const f32 g_buttonTextGap = 10.0f;
 	const f32 g_itemGap = 2.0f;
+	const f32 g_rowHeight = g_buttonSize + g_itemGap;
 
 	CMashGUITree::CMashGUITree(MashGUIManager *pGUIManager,
 			MashInputManager *pInputManager,
@@ -20,7 +21,7 @@ namespace mash
 			const MashGUIRect &destination,
 			int32 styleElement):MashGUITree(pGUIManager, pInputManager, pParent, destination),
 			m_bUpdateNeeded(true), m_selectedItemId(-1), m_pVerticalScrollBar(0), m_pHorizontalScrollBar(0), m_itemCounter(0), m_iDoubleClickTimeLimit(400), m_iLastDoubleClickTime(0),
-			m_styleElement(styleElement)
+			m_styleElement(styleElement), m_firstVisibleRow(0), m_lastVisibleRow(0), m_rowOrigin(0.0f, 0.0f)
 	{
 		m_pVerticalScrollBar = m_GUIManager->_GetGUIFactory()->CreateScrollBarView(true, this);
 		m_pVerticalScrollBar->SetRenderEnabled(false);
@@ -74,6 +75,8 @@ namespace mash
 
 	void CMashGUITree::SetItemText(int32 id, const MashStringc &text)
 	{
+		MarkDirty();
+
 		sItem *selectedItem = GetItemById(&m_rootItem, id);
 		if (selectedItem)
 		{
@@ -85,6 +88,8 @@ namespace mash
 
 	void CMashGUITree::SetActiveItem(int32 id)
 	{
+		MarkDirty();
+
 		sItem *selectedItem = 0;
 		
 		if (id > -1)
@@ -135,16 +140,17 @@ namespace mash
 		}
 	}
 
-	CMashGUITree::sItem* CMashGUITree::CheckElementSelection(sItem *root, uint32 currentTime, const mash::MashVector2 &cursorPos)
+	CMashGUITree::sItem* CMashGUITree::CheckElementSelection(uint32 currentTime, const mash::MashVector2 &cursorPos)
 	{
-		const uint32 itemCount = root->children.Size();
-		for(uint32 i = 0; i < itemCount; ++i)
+		//only visible rows can be clicked
+		for(uint32 i = m_firstVisibleRow; i < m_lastVisibleRow; ++i)
 		{
-			if (root->children[i].textHandler.GetAbsoluteClippedRegion().IntersectsGUI(cursorPos))
+			sItem *item = m_rows[i].item;
+			if (item->textHandler.GetAbsoluteClippedRegion().IntersectsGUI(cursorPos))
 			{
-				if (m_selectedItemId != root->children[i].id)
+				if (m_selectedItemId != item->id)
 				{
-					m_selectedItemId = root->children[i].id;
+					m_selectedItemId = item->id;
 
 					sGUIEvent newGUIMsg;
 					
@@ -152,22 +158,16 @@ namespace mash
 					newGUIMsg.component = this;
 					ImmediateBroadcast(newGUIMsg);
 
-					return &root->children[i];
+					return item;
 				}
 				else
 				{
 					if ((currentTime - m_iLastDoubleClickTime) <= m_iDoubleClickTimeLimit)
 					{
 						//only expand if it has children
-						if (!root->children[i].children.Empty())
+						if (!item->children.Empty())
 						{
-							if (root->children[i].expand)
-								root->children[i].expand = false;
-							else
-							{
-								root->children[i].expand = true;
-							}
-
+							item->expand = !item->expand;
 							m_bUpdateNeeded = true;
 						}
 
@@ -177,34 +177,21 @@ namespace mash
 						newGUIMsg.component = this;
 						ImmediateBroadcast(newGUIMsg);
 
-						return &root->children[i];
+						return item;
 					}
 				}
 				break;
 			}
-			else if (root->children[i].expandButtonAbsRegion.IntersectsGUI(cursorPos))
+			else if (item->expandButtonAbsRegion.IntersectsGUI(cursorPos))
 			{
 				//only expand if it has children
-				if (!root->children[i].children.Empty())
+				if (!item->children.Empty())
 				{
-					if (root->children[i].expand)
-						root->children[i].expand = false;
-					else
-					{
-						root->children[i].expand = true;
-					}
-
+					item->expand = !item->expand;
 					m_bUpdateNeeded = true;
 				}
 
-				return &root->children[i];
-			}
-
-			if (root->children[i].expand)
-			{
-				sItem *selection = CheckElementSelection(&root->children[i], currentTime, cursorPos);
-				if (selection)
-					return selection;
+				return item;
 			}
 		}
 
@@ -215,6 +202,9 @@ namespace mash
 	{
 		if (GetEventsEnabled())
 		{
+			const int32 lastSelectedItem = m_selectedItemId;
+			const bool lastUpdateNeeded = m_bUpdateNeeded;
+
 			if (eventData.eventType == sInputEvent::aEVENTTYPE_MOUSE && m_hasFocus)
 			{
 				switch(eventData.action)
@@ -230,7 +220,11 @@ namespace mash
 							uint32 iNewClickTime = MashDevice::StaticDevice->GetTimer()->GetTimeSinceProgramStart();
 							mash::MashVector2 vMousePos = m_inputManager->GetCursorPosition();
 
-							CheckElementSelection(&m_rootItem, iNewClickTime, vMousePos);
+							//rows may point to removed items until the tree is updated
+							if (m_bUpdateNeeded)
+								UpdateTree(false);
+
+							CheckElementSelection(iNewClickTime, vMousePos);
 
 							//if f64 click was engaged then reset the counter to prevent following
 							//clicks to also act as a f64 click
@@ -242,6 +236,9 @@ namespace mash
 					}
 				}
 			}
+
+			if ((m_selectedItemId != lastSelectedItem) || (m_bUpdateNeeded && !lastUpdateNeeded))
+				MarkDirty();
 		}
 	}
 
@@ -321,11 +318,15 @@ namespace mash
 
 	void CMashGUITree::RemoveAllItems()
 	{
+		MarkDirty();
+
 		RemoveAllItems(&m_rootItem);
 	}
 
 	void CMashGUITree::RemoveItem(int32 id)
 	{
+		MarkDirty();
+
 		RemoveItem(&m_rootItem, id);
 	}
 
@@ -349,6 +350,8 @@ namespace mash
 
 	int32 CMashGUITree::AddItem(const MashStringc &text, int32 parentID, int32 userId)
 	{
+		MarkDirty();
+
 		MashGUIFont *activeFont = m_GUIManager->GetActiveGUIStyle()->GetFont();
 		if (parentID == -1)
 		{
@@ -467,50 +470,56 @@ namespace mash
 		root->textHandler.SetRegion(textAbsRegion, GetAbsoluteClippedRegion());
 	}
 
-	void CMashGUITree::OnResizeItems(sItem *root, MashGUIFont *font, mash::MashVector2 &topLeftPosition)
+	void CMashGUITree::BuildRows(sItem *root, f32 indent)
 	{
-		mash::MashRectangle2 textAbsRegion;
 		const uint32 iItemCount = root->children.Size();
 		for(uint32 i = 0; i < iItemCount; ++i)
 		{
-			root->children[i].expandButtonAbsRegion.left = topLeftPosition.x;
-			root->children[i].expandButtonAbsRegion.top = topLeftPosition.y;
-			root->children[i].expandButtonAbsRegion.right = topLeftPosition.x + g_buttonSize;
-			root->children[i].expandButtonAbsRegion.bottom = topLeftPosition.y + g_buttonSize;
+			m_rows.PushBack(sRow(&root->children[i], indent));
 
-			textAbsRegion.left = root->children[i].expandButtonAbsRegion.right + g_buttonTextGap;
-			textAbsRegion.top = topLeftPosition.y;
-			textAbsRegion.right = textAbsRegion.left + font->GetStringLength(root->children[i].textHandler.GetString().GetCString());
-			textAbsRegion.bottom = textAbsRegion.top + font->GetMaxCharacterHeight();
+			if (root->children[i].expand)
+				BuildRows(&root->children[i], indent + g_indent);
+		}
+	}
 
-			root->children[i].textHandler.SetRegion(textAbsRegion, GetAbsoluteClippedRegion());
+	void CMashGUITree::UpdateRow(const sRow &row, uint32 rowIndex, MashGUIFont *font)
+	{
+		sItem *item = row.item;
+		const f32 left = m_rowOrigin.x + row.indent;
+		const f32 top = m_rowOrigin.y + (rowIndex * g_rowHeight);
 
-			topLeftPosition.y = root->children[i].expandButtonAbsRegion.bottom + g_itemGap;
+		item->expandButtonAbsRegion.left = left;
+		item->expandButtonAbsRegion.top = top;
+		item->expandButtonAbsRegion.right = left + g_buttonSize;
+		item->expandButtonAbsRegion.bottom = top + g_buttonSize;
 
-			if (root->children[i].expand)
-			{
-				topLeftPosition.x += g_indent;
-				OnResizeItems(&root->children[i], font, topLeftPosition);
-				topLeftPosition.x -= g_indent;
-			}
-		}
+		mash::MashRectangle2 textAbsRegion;
+		textAbsRegion.left = item->expandButtonAbsRegion.right + g_buttonTextGap;
+		textAbsRegion.top = top;
+		textAbsRegion.right = textAbsRegion.left + font->GetStringLength(item->textHandler.GetString().GetCString());
+		textAbsRegion.bottom = textAbsRegion.top + font->GetMaxCharacterHeight();
+
+		item->textHandler.SetRegion(textAbsRegion, GetAbsoluteClippedRegion());
 	}
 
-	void CMashGUITree::UpdateItemPositionsOnly(sItem *root, f32 deltaX, f32 deltaY)
+	void CMashGUITree::UpdateItemPositionsOnly(f32 deltaX, f32 deltaY)
 	{
-		const uint32 iItemCount = root->children.Size();
-		for(uint32 i = 0; i < iItemCount; ++i)
+		m_rowOrigin.x += deltaX;
+		m_rowOrigin.y += deltaY;
+
+		/*
+			Rows outside the visible range are left as they are. They will be
+			fully updated when they are scrolled into view.
+		*/
+		for(uint32 i = m_firstVisibleRow; i < m_lastVisibleRow; ++i)
 		{
-			sItem *item = &root->children[i];
+			sItem *item = m_rows[i].item;
 			item->expandButtonAbsRegion.left += deltaX;
 			item->expandButtonAbsRegion.right += deltaX;
 			item->expandButtonAbsRegion.top += deltaY;
 			item->expandButtonAbsRegion.bottom += deltaY;
 
 			item->textHandler.AddPosition(deltaX, deltaY);
-
-			if (root->children[i].expand)
-				UpdateItemPositionsOnly(&root->children[i], deltaX, deltaY);
 		}
 	}
 
@@ -518,7 +527,7 @@ namespace mash
 	{
 		if (positionChangeOnly)
 		{
-			UpdateItemPositionsOnly(&m_rootItem, deltaX, deltaY);
+			UpdateItemPositionsOnly(deltaX, deltaY);
 		}
 		else
 		{
@@ -578,15 +587,29 @@ namespace mash
 				m_pHorizontalScrollBar->SetDualScrollEnabled(false);
 			}
 
-			mash::MashVector2 topLeftPosition(10.0f, 10.0f);
+			m_rowOrigin = mash::MashVector2(10.0f, 10.0f);
 			//add parent position
-			topLeftPosition.x += GetAbsoluteRegion().left;
-			topLeftPosition.y += GetAbsoluteRegion().top;
+			m_rowOrigin.x += GetAbsoluteRegion().left;
+			m_rowOrigin.y += GetAbsoluteRegion().top;
 			//add scroll bar
-			topLeftPosition.x -= m_pHorizontalScrollBar->GetSliderValue();
-			topLeftPosition.y -= m_pVerticalScrollBar->GetSliderValue();
+			m_rowOrigin.x -= m_pHorizontalScrollBar->GetSliderValue();
+			m_rowOrigin.y -= m_pVerticalScrollBar->GetSliderValue();
 
-			OnResizeItems(&m_rootItem, activeFont, topLeftPosition);
+			m_rows.Clear();
+			BuildRows(&m_rootItem, 0.0f);
+
+			/*
+				Rows have a fixed height so the visible range is found directly.
+				Only those rows have their text laid out.
+			*/
+			const f32 rowMaxHeight = math::Max<f32>(g_buttonSize, activeFont->GetMaxCharacterHeight());
+			const f32 firstRow = math::Max<f32>(0.0f, (GetAbsoluteRegion().top - m_rowOrigin.y - rowMaxHeight) / g_rowHeight);
+			const f32 lastRow = math::Max<f32>(0.0f, (GetAbsoluteRegion().bottom - m_rowOrigin.y) / g_rowHeight) + 1.0f;
+			m_firstVisibleRow = math::Min<uint32>((uint32)firstRow, m_rows.Size());
+			m_lastVisibleRow = math::Min<uint32>((uint32)lastRow, m_rows.Size());
+
+			for(uint32 i = m_firstVisibleRow; i < m_lastVisibleRow; ++i)
+				UpdateRow(m_rows[i], i, activeFont);
 		}
 
 		m_bUpdateNeeded = false;
@@ -603,32 +626,29 @@ namespace mash
 		UpdateTree(positionChangeOnly, deltaX, deltaY);
 	}
 
-	void CMashGUITree::DrawItems(sItem *root, MashGUISkin *activeItemSkin, MashGUISkin *inactiveItemSkin, MashGUISkin *expandButtonSkin, MashGUISkin *retractButtonSkin)
+	void CMashGUITree::DrawItems(MashGUISkin *activeItemSkin, MashGUISkin *inactiveItemSkin, MashGUISkin *expandButtonSkin, MashGUISkin *retractButtonSkin)
 	{
-		const uint32 itemCount = root->children.Size();
-		for(uint32 i = 0; i < itemCount; ++i)
+		for(uint32 i = m_firstVisibleRow; i < m_lastVisibleRow; ++i)
 		{
+			sItem *item = m_rows[i].item;
+
 			MashGUISkin *currentSkin = 0;
-			if (!root->children[i].expand)
+			if (!item->expand)
 				currentSkin = expandButtonSkin;
 			else
 				currentSkin = retractButtonSkin;
 
 			//draw button
-			if (!root->children[i].children.Empty())//only draw the button if this element has children
-				m_GUIManager->DrawSprite(root->children[i].expandButtonAbsRegion, GetAbsoluteClippedRegion(), currentSkin, m_overrideTransparency);
+			if (!item->children.Empty())//only draw the button if this element has children
+				m_GUIManager->DrawSprite(item->expandButtonAbsRegion, GetAbsoluteClippedRegion(), currentSkin, m_overrideTransparency);
 
-			if (root->children[i].id == m_selectedItemId)
+			if (item->id == m_selectedItemId)
 				currentSkin = activeItemSkin;
 			else
 				currentSkin = inactiveItemSkin;
 
 			//draw text
-			root->children[i].textHandler.Draw(m_GUIManager, currentSkin->fontColour, m_overrideTransparency);
-
-			//draw children
-			if (root->children[i].expand)
-				DrawItems(&root->children[i], activeItemSkin, inactiveItemSkin, expandButtonSkin, retractButtonSkin);
+			item->textHandler.Draw(m_GUIManager, currentSkin->fontColour, m_overrideTransparency);
 		}
 	}
 
@@ -653,7 +673,7 @@ namespace mash
 			/*
 				Skins are passed in so they are not being searched for, for each item.
 			*/
-			DrawItems(&m_rootItem, activeItemSkin, inactiveItemSkin, expandButtonSkin, retractButtonSkin);
+			DrawItems(activeItemSkin, inactiveItemSkin, expandButtonSkin, retractButtonSkin);
 
 			if (m_pHorizontalScrollBar->GetRenderEnabled())
 				m_pHorizontalScrollBar->Draw();
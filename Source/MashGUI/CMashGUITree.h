@@ -29,6 +29,16 @@ namespace mash
 			sItem():id(-1), userId(0), expand(false), expandButtonAbsRegion(0.0f, 0.0f, 0.0f, 0.0f){}
 		};
 
+		//an item that is shown because all its parents are expanded
+		struct sRow
+		{
+			sItem *item;
+			f32 indent;
+
+			sRow():item(0), indent(0.0f){}
+			sRow(sItem *_item, f32 _indent):item(_item), indent(_indent){}
+		};
+
 		int32 m_styleElement;
 
 		uint32 m_iLastDoubleClickTime;
@@ -42,14 +52,25 @@ namespace mash
 		int32 m_selectedItemId;
 		uint32 m_itemCounter;
 
+		/*
+			Expanded items flattened into rows. Rows have a fixed height so only rows
+			within [m_firstVisibleRow, m_lastVisibleRow) are positioned, drawn and tested for clicks.
+			Rebuilt when the tree is updated.
+		*/
+		MashArray<sRow> m_rows;
+		uint32 m_firstVisibleRow;
+		uint32 m_lastVisibleRow;
+		mash::MashVector2 m_rowOrigin;
+
 		sItem* GetItemByUserId(sItem *root, int32 id)const;
 		sItem* GetItemById(sItem *root, int32 id)const;
 		void OnResize(bool positionChangeOnly, f32 deltaX = 0, f32 deltaY = 0);
-		void UpdateItemPositionsOnly(sItem *root, f32 deltaX, f32 deltaY);
+		void UpdateItemPositionsOnly(f32 deltaX, f32 deltaY);
 		void OnResizeItemOnly(sItem *root, MashGUIFont *font);
-		void OnResizeItems(sItem *root, MashGUIFont *font, mash::MashVector2 &topLeftPosition);
-		void DrawItems(sItem *root, MashGUISkin *activeItemSkin, MashGUISkin *inactiveItemSkin, MashGUISkin *expandButtonSkin, MashGUISkin *retractButtonSkin);
-		sItem* CheckElementSelection(sItem *root, uint32 currentTime, const mash::MashVector2 &cursorPos);
+		void BuildRows(sItem *root, f32 indent);
+		void UpdateRow(const sRow &row, uint32 rowIndex, MashGUIFont *font);
+		void DrawItems(MashGUISkin *activeItemSkin, MashGUISkin *inactiveItemSkin, MashGUISkin *expandButtonSkin, MashGUISkin *retractButtonSkin);
+		sItem* CheckElementSelection(uint32 currentTime, const mash::MashVector2 &cursorPos);
 		void CalculateVerticalScrollDistance(sItem *root, MashGUIFont *font, f32 &distance);
 		void CalculateHorizontalScrollDistance(sItem *root, MashGUIFont *font, f32 &distance, f32 &indent);
 		bool RemoveItem(sItem *root, int32 id);
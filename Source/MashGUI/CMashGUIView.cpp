@@ -6,9 +6,13 @@
 #include "CMashGUIView.h"
 #include "MashGUICustomRender.h"
 #include "MashGUIManager.h"
+#include "CMashGUIHitTestGrid.h"
 
 namespace mash
 {
+	//views with fewer children than this are tested linearly
+	static const uint32 g_hitTestGridMinChildren = 16;
+
 	CMashGUIView::CMashGUIView(MashGUIManager *pGUIManager,
 			MashInputManager *pInputManager,
 			MashGUIComponent *pParent,
@@ -16,7 +20,8 @@ namespace mash
 			int32 styleElement):MashGUIView(pGUIManager, pInputManager, pParent, destination),
 			m_verticalScrollBar(0), m_horizontalScrollBar(0), m_renderBackground(true),
 			m_hscrollEnabled(true), m_vscrollEnabled(true), m_updateScrollbars(true), m_styleElement(styleElement),
-			m_customRenderer(0)
+			m_customRenderer(0), m_retainedMode(false), m_retainedDirty(true),
+			m_hitTestGrid(0), m_hitTestGridDirty(true)
 	{
 		m_verticalScrollBar = m_GUIManager->_GetGUIFactory()->CreateScrollBarView(true, this);
 		m_verticalScrollBar->SetRenderEnabled(false);
@@ -48,6 +53,12 @@ namespace mash
 			m_customRenderer->Drop();
 			m_customRenderer = 0;
 		}
+
+		if (m_hitTestGrid)
+		{
+			MASH_DELETE m_hitTestGrid;
+			m_hitTestGrid = 0;
+		}
 	}
 
 	void CMashGUIView::OnChildAlwaysOnTop(MashGUIComponent *component)
@@ -76,6 +87,8 @@ namespace mash
 
 		if (m_customRenderer)
 			m_customRenderer->Grab();
+
+		MarkDirty();
 	}
 
 	void CMashGUIView::OnStyleChange(MashGUIStyle *style)
@@ -175,13 +188,44 @@ namespace mash
 
 	void CMashGUIView::SetRenderBackgroundState(bool state)
 	{
+		if (state != m_renderBackground)
+			MarkDirty();
+
 		m_renderBackground = state;
 	}
 
+	void CMashGUIView::SetRetainedMode(bool enable)
+	{
+		if (enable == m_retainedMode)
+			return;
+
+		m_retainedMode = enable;
+		m_retainedDirty = true;
+
+		if (!m_retainedMode)
+			m_GUIManager->_ReleaseRetained(this);
+
+		//parent retained views hold this views old output
+		MarkDirty();
+	}
+
+	void CMashGUIView::OnRenderCacheDirty()
+	{
+		m_retainedDirty = true;
+	}
+
+	void CMashGUIView::OnHitTestDirty()
+	{
+		m_hitTestGridDirty = true;
+	}
+
 	void CMashGUIView::SetVerticalScrollState(bool state)
 	{
 		if (state != m_vscrollEnabled)
+		{
 			m_updateScrollbars = true;
+			MarkDirty();
+		}
 
 		m_vscrollEnabled = state;
 	}
@@ -189,7 +233,10 @@ namespace mash
 	void CMashGUIView::SetHorizontalScrollState(bool state)
 	{
 		if (state != m_hscrollEnabled)
+		{
 			m_updateScrollbars = true;
+			MarkDirty();
+		}
 
 		m_hscrollEnabled = state;
 	}
@@ -206,6 +253,8 @@ namespace mash
 				{
 					m_children.Erase(iter);
 					m_children.Insert(m_children.Begin(), pChild);
+					MarkDirty();
+					m_hitTestGridDirty = true;
 
 					if (pChild != m_verticalScrollBar && pChild != m_horizontalScrollBar)
 					{
@@ -232,6 +281,8 @@ namespace mash
 				{
 					m_children.Erase(iter);
 					m_children.Insert(m_children.End(), pChild);
+					MarkDirty();
+					m_hitTestGridDirty = true;
 					break;
 				}
 			}
@@ -298,20 +349,65 @@ namespace mash
 		_AddChild(pChild);
 	}
 
+	MashGUIComponent* CMashGUIView::GetClosestIntersectingChildFromGrid(const mash::MashVector2 &vScreenPos)
+	{
+		/*
+			The grid is rebuilt the next time it's needed after this view or one of
+			its children moves or resizes. Layout changes elsewhere in the gui and
+			mouse movement leave it untouched.
+		*/
+		if (!m_hitTestGrid)
+		{
+			m_hitTestGrid = MASH_NEW_COMMON CMashGUIHitTestGrid();
+			m_hitTestGridDirty = true;
+		}
+
+		if (m_hitTestGridDirty)
+		{
+			m_hitTestGrid->Build(m_absoluteClippedRegion, m_children);
+			m_hitTestGridDirty = false;
+		}
+
+		MashGUIComponent *const *candidates = 0;
+		const uint32 candidateCount = m_hitTestGrid->GetCandidates(vScreenPos, &candidates);
+		for(uint32 i = 0; i < candidateCount; ++i)
+		{
+			MashGUIComponent *pIntersects = candidates[i]->GetClosestIntersectingChild(vScreenPos, false);
+
+			if (pIntersects)
+				return pIntersects;
+		}
+
+		return 0;
+	}
+
 	MashGUIComponent* CMashGUIView::GetClosestIntersectingChild(const mash::MashVector2 &vScreenPos, bool bTestAllChildren)
 	{
 		//test children first
 		if (bTestAllChildren || (GetRenderEnabled() && GetCanHaveFocus() && (m_cullState != aCULL_CULLED)))
 		{
-			MashList<MashGUIComponent*>::Iterator iter = m_children.Begin();
-			MashList<MashGUIComponent*>::Iterator end = m_children.End();
-			for(; iter != end; ++iter)
+			/*
+				Children are clipped to this view so only those overlapping the
+				cursor need testing. Culled children are only tested when bTestAllChildren is set.
+			*/
+			if (!bTestAllChildren && (m_children.Size() >= g_hitTestGridMinChildren))
 			{
-				MashGUIComponent *pIntersects = (*iter)->GetClosestIntersectingChild(vScreenPos, bTestAllChildren);
-
+				MashGUIComponent *pIntersects = GetClosestIntersectingChildFromGrid(vScreenPos);
 				if (pIntersects)
 					return pIntersects;
 			}
+			else
+			{
+				MashList<MashGUIComponent*>::Iterator iter = m_children.Begin();
+				MashList<MashGUIComponent*>::Iterator end = m_children.End();
+				for(; iter != end; ++iter)
+				{
+					MashGUIComponent *pIntersects = (*iter)->GetClosestIntersectingChild(vScreenPos, bTestAllChildren);
+
+					if (pIntersects)
+						return pIntersects;
+				}
+			}
 			
 			//now test this rect
 			MashGUIComponent *pIntersects = MashGUIComponent::GetClosestIntersectingChild(vScreenPos, bTestAllChildren);
@@ -387,6 +483,8 @@ namespace mash
 
 				//update the scroll bar position
 				m_updateScrollbars = true;
+				MarkDirty();
+				m_hitTestGridDirty = true;
 
 				return pChild->Drop();
 			}
@@ -578,6 +676,8 @@ namespace mash
 		pChild->_SetParent(this);
 		pChild->UpdateRegion();
 		m_children.PushFront(pChild);
+		MarkDirty();
+		m_hitTestGridDirty = true;
 
 		if (pChild->GetAlwaysOnTop())
 			m_alwaysOnTopStack.PushBack(pChild);
@@ -677,6 +777,27 @@ namespace mash
     }
 
 	void CMashGUIView::Draw()
+	{
+		if (!m_retainedMode)
+		{
+			DrawView();
+			return;
+		}
+
+		if (!m_retainedDirty && m_GUIManager->_DrawRetained(this))
+			return;
+
+		/*
+			The flag is cleared before recording so that any changes made
+			during the draw cause a rebuild on the next frame.
+		*/
+		m_retainedDirty = false;
+		m_GUIManager->_BeginRetainedDraw(this);
+		DrawView();
+		m_GUIManager->_EndRetainedDraw(this);
+	}
+
+	void CMashGUIView::DrawView()
 	{
 		MashGUIComponent::Draw();
 
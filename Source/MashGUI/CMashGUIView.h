@@ -11,6 +11,8 @@
 
 namespace mash
 {
+	class CMashGUIHitTestGrid;
+
 	class CMashGUIView : public MashGUIView
 	{
 	private:
@@ -24,6 +26,13 @@ namespace mash
 		bool m_hscrollEnabled;
 		bool m_vscrollEnabled;
 
+		bool m_retainedMode;
+		bool m_retainedDirty;
+
+		//only built for views with many children
+		CMashGUIHitTestGrid *m_hitTestGrid;
+		bool m_hitTestGridDirty;
+
 		MashList<MashGUIComponent*> m_children;
 		MashList<MashGUIComponent*> m_alwaysOnTopStack;
 
@@ -42,6 +51,10 @@ namespace mash
 		void OnChildAlwaysOnTop(MashGUIComponent *component);
 		void OnRemoveChildAlwaysOnTop(MashGUIComponent *component);
 		void OnAddChildFromConstructor(MashGUIComponent *component);
+		void OnRenderCacheDirty();
+		void OnHitTestDirty();
+		void DrawView();
+		MashGUIComponent* GetClosestIntersectingChildFromGrid(const mash::MashVector2 &vScreenPos);
 	public:
 		CMashGUIView(MashGUIManager *pGUIManager,
 			MashInputManager *pInputManager,
@@ -62,6 +75,9 @@ namespace mash
 		void SetRenderBackgroundState(bool state);
 		bool GetRenderbackgroundState()const;
 
+		void SetRetainedMode(bool enable);
+		bool GetRetainedMode()const;
+
 		bool IsHorizontalScrollEnabled()const;
 		bool IsVerticalScrollEnabled()const;
         
@@ -103,6 +119,11 @@ namespace mash
 		return m_renderBackground;
 	}
 
+	inline bool CMashGUIView::GetRetainedMode()const
+	{
+		return m_retainedMode;
+	}
+
 	inline bool CMashGUIView::IsHorizontalScrollEnabled()const
 	{
 		return m_hscrollEnabled;
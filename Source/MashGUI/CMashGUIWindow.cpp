@@ -143,6 +143,8 @@ namespace mash
 
 	void CMashGUIWindow::SetTitleBarText(const MashStringc &text)
 	{
+		MarkDirty();
+
 		m_textHandler.SetString(text);
 	}
 
@@ -309,6 +311,9 @@ namespace mash
 	{
 		if (GetEventsEnabled())
 		{
+			const eWINDOW_BUTTONS lastHoverButton = m_hoverButton;
+			const eBUTTON_STATE lastButtonState = m_buttonState;
+
 			switch(eventData.action)
 			{
 			case aMOUSEEVENT_B1:
@@ -386,6 +391,9 @@ namespace mash
 					break;
 				}
 			};
+
+			if ((m_hoverButton != lastHoverButton) || (m_buttonState != lastButtonState))
+				MarkDirty();
 		}
 	}
 
@@ -90,6 +90,9 @@ namespace mash
 				uint32 iNewVertexBufferSize = m_font->CalculateVertexBufferSizeQuick(m_text.GetCString());
 				if ((!m_textVerticesPtr.Get() && (iNewVertexBufferSize > 0)) || (m_reservedVertexBufferSize < iNewVertexBufferSize))
 				{
+					//grow in larger steps so typing doesn't reallocate for every character
+					iNewVertexBufferSize = math::Max<uint32>(iNewVertexBufferSize, m_reservedVertexBufferSize * 2);
+
 					m_textVerticesPtr = (mash::MashVertexPosTex::sMashVertexPosTex*)MASH_ALLOC_COMMON(iNewVertexBufferSize);
 					m_reservedVertexBufferSize = iNewVertexBufferSize;
 				}
@@ -237,6 +240,26 @@ namespace mash
 			return;
 		}
 
+		/*
+			If the text and clipping area moved together then the clipped text
+			is the same and only needs translating.
+		*/
+		if (!m_caratEnabled && !(m_updateFlags & eTEXT_UPDATE_FLAG_FULL) && (m_currentTextVerticesCount > 0))
+		{
+			const f32 deltaX = absRect.left - m_absRegion.left;
+			const f32 deltaY = absRect.top - m_absRegion.top;
+			const mash::MashRectangle2 movedRegion(m_absRegion.left + deltaX, m_absRegion.top + deltaY,
+				m_absRegion.right + deltaX, m_absRegion.bottom + deltaY);
+			const mash::MashRectangle2 movedClippingRegion(m_absClippingRegion.left + deltaX, m_absClippingRegion.top + deltaY,
+				m_absClippingRegion.right + deltaX, m_absClippingRegion.bottom + deltaY);
+
+			if ((movedRegion == absRect) && (movedClippingRegion == clippingRect))
+			{
+				AddPosition(deltaX, deltaY);
+				return;
+			}
+		}
+
 		m_absRegion = absRect;
 		m_absClippingRegion = clippingRect;
 
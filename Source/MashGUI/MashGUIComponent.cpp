@@ -48,6 +48,7 @@ namespace mash
 		if (bHasFocus && !m_hasFocus && GetCanHaveFocus())
 		{
 			m_hasFocus = true;
+			MarkDirty();
 			OnFocusGained();
 
 			sGUIEvent newGUIMsg;
@@ -59,6 +60,7 @@ namespace mash
 		else if (!bHasFocus && m_hasFocus && GetCanHaveFocus())
 		{
 			m_hasFocus = false;
+			MarkDirty();
 			OnLostFocus();
 
 			sGUIEvent newGUIMsg;
@@ -77,6 +79,7 @@ namespace mash
 		if (bMouseHover && !m_mouseHover && GetCanHaveFocus())
 		{
 			m_mouseHover = true;
+			MarkDirty();
 
 			sGUIEvent newGUIMsg;
 			
@@ -89,6 +92,7 @@ namespace mash
 		else if (!bMouseHover && m_mouseHover && GetCanHaveFocus())
 		{
 			m_mouseHover = false;
+			MarkDirty();
 
 			sGUIEvent newGUIMsg;
 			
@@ -172,6 +176,7 @@ namespace mash
 		if (m_renderEnabled != bEnable)
 		{
 			m_renderEnabled = bEnable;
+			MarkDirty();
 
 			if (!m_renderEnabled)
 				m_GUIManager->OnHideElement(this);
@@ -262,6 +267,22 @@ namespace mash
 		m_overrideTransparency.alphaValue = alpha;
 		m_overrideTransparency.affectFontAlpha = affectFont;
 		m_overrideTransparency.alphaMaskThreshold = alphaMaskThreshold;
+
+		MarkDirty();
+	}
+
+	void MashGUIComponent::MarkDirty()
+	{
+		for(MashGUIComponent *component = this; component; component = component->m_parent)
+			component->OnRenderCacheDirty();
+	}
+
+	void MashGUIComponent::MarkLayoutDirty()
+	{
+		OnHitTestDirty();
+
+		if (m_parent)
+			m_parent->OnHitTestDirty();
 	}
 
 	/*
@@ -306,6 +327,9 @@ namespace mash
 		if (samePosition && sameHeight && sameWidth)
 			return;//no change
 
+		MarkDirty();
+		MarkLayoutDirty();
+
 		if (!sameWidth || !sameHeight || (sameParentPosition && m_cullState != aCULL_VISIBLE))
 		{
 			m_absoluteClippedRegion = newAbsClippedRegion;
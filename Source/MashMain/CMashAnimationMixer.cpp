@@ -42,7 +42,7 @@ namespace mash
 		}
 
 		m_animationSetsByLayer.Clear();
-		m_animationSetsByName.clear();
+		m_animationSetsByName.Clear();
 
 		m_pControllerManager->_RemoveAnimationMixer(this);
 
@@ -57,6 +57,18 @@ namespace mash
 		}
 	}
 
+	CMashAnimationMixer::sAnimationSet* CMashAnimationMixer::FindAnimationSet(const MashStringID &animationID)const
+	{
+		sAnimationSet *const *animationSet = m_animationSetsByName.Find(animationID);
+		return animationSet ? *animationSet : 0;
+	}
+
+	CMashAnimationMixer::sAnimationSet* CMashAnimationMixer::FindAnimationSet(const int8 *sName)const
+	{
+		sAnimationSet *const *animationSet = m_animationSetsByName.Find(sName);
+		return animationSet ? *animationSet : 0;
+	}
+
 	void CMashAnimationMixer::_UpdateFrameNumber(sAnimationSet *pSet)
 	{
 		const int32 iTotalFrameCount = pSet->frameLength;
@@ -139,84 +151,93 @@ namespace mash
 			return aMASH_FAILED;
 		}
 
-		MashStringc animationNameBuffer = "";
-		if (animationName)
-			animationNameBuffer = animationName;
+		//names are interned here so later lookups only compare ids
+		const MashStringID animationID(animationName);
 
-		std::map<MashStringc, sAnimationSet*>::iterator iter = m_animationSetsByName.find(animationNameBuffer);
-		if (iter == m_animationSetsByName.end())
+		sAnimationSet *animationSet = FindAnimationSet(animationID);
+		if (!animationSet)
 		{
-			sAnimationSet *pNewSet = MASH_NEW_T_COMMON(sAnimationSet)();
-			pNewSet->animationName = animationNameBuffer;
-			iter = m_animationSetsByName.insert(std::make_pair(animationNameBuffer, pNewSet)).first;
-			m_animationSetsByLayer.PushBack(pNewSet);
+			animationSet = MASH_NEW_T_COMMON(sAnimationSet)();
+			animationSet->animationID = animationID;
+			animationSet->animationName = animationID.GetString();
+			m_animationSetsByName.Insert(animationID, animationSet);
+			m_animationSetsByLayer.PushBack(animationSet);
 			m_animationSetsByLayer.Sort(sTrackSort());
 		}
 
-		iter->second->keyControllers.PushBack(controller);
+		animationSet->keyControllers.PushBack(controller);
 		controller->Grab();
 
 		const uint32 keyCount = controller->GetKeySet()->GetKeyCount();
 		//set up the key cache for predictive lookups.
 		//There is one element per animation.
-		iter->second->keyCache.PushBack(sAnimationKeyCache());
+		animationSet->keyCache.PushBack(sAnimationKeyCache());
 
 		//update animation frame length
 		const uint32 frameLength = controller->GetKeySet()->GetFrameFromKey(keyCount - 1);
-		if (frameLength > iter->second->frameLength)
-			iter->second->frameLength = frameLength;
+		if (frameLength > animationSet->frameLength)
+			animationSet->frameLength = frameLength;
 
 		return aMASH_OK;
 	}
 
 	eMASH_STATUS CMashAnimationMixer::SetReverse(const int8 *sName, bool bReversePlayback)
 	{
-		std::map<MashStringc, sAnimationSet*>::iterator iter = m_animationSetsByName.find(sName);
-		if (iter == m_animationSetsByName.end())
+		sAnimationSet *animationSet = FindAnimationSet(sName);
+		if (!animationSet)
 			return aMASH_FAILED;
 
-		if (iter->second->bReverse == bReversePlayback)
+		if (animationSet->bReverse == bReversePlayback)
 			return aMASH_OK;
 
 		//bounces uses the reverse value internally to bounce the animation. So it cant be set by the user in this case.
-		if (iter->second->eWrapMode == aWRAP_BOUNCE)
+		if (animationSet->eWrapMode == aWRAP_BOUNCE)
 			return aMASH_OK;
 
-		iter->second->bReverse = bReversePlayback;
+		animationSet->bReverse = bReversePlayback;
 
 		/*
 			This adjusts the start frame time so that the animation continues
 			smoothly in the opposite direction. For example, when making a character
 			walk forwards and backwards.
 		*/
-		if (iter->second->bReverse)
-			iter->second->iStartFrame = m_iCurrentFrame - (iter->second->frameLength - iter->second->iFrame);
+		if (animationSet->bReverse)
+			animationSet->iStartFrame = m_iCurrentFrame - (animationSet->frameLength - animationSet->iFrame);
 		else
-			iter->second->iStartFrame = m_iCurrentFrame - iter->second->iFrame;
+			animationSet->iStartFrame = m_iCurrentFrame - animationSet->iFrame;
 
 		return aMASH_OK;
 	}
 
 	eMASH_STATUS CMashAnimationMixer::Play(const int8 *sName, bool bStopAndResetAllTracks)
 	{
-		std::map<MashStringc, sAnimationSet*>::iterator playIter = m_animationSetsByName.find(sName);
-		if (playIter == m_animationSetsByName.end())
+		MashStringID animationID;
+		if (!MashStringID::Find(sName, animationID))
+			return aMASH_FAILED;
+
+		return Play(animationID, bStopAndResetAllTracks);
+	}
+
+	eMASH_STATUS CMashAnimationMixer::Play(const MashStringID &animationID, bool bStopAndResetAllTracks)
+	{
+		sAnimationSet *animationSet = FindAnimationSet(animationID);
+		if (!animationSet)
 			return aMASH_FAILED;
 
 		/*
 			Dont continue If this animation is already playing
 		*/
-		if (playIter->second->bPlay)
+		if (animationSet->bPlay)
 			return aMASH_OK;
 
-		playIter->second->bPlay = true;
-		playIter->second->iStartFrame = m_iCurrentFrame;
+		animationSet->bPlay = true;
+		animationSet->iStartFrame = m_iCurrentFrame;
 
 		MashList<sAnimationSet*>::Iterator iter = m_animationSetsByLayer.Begin();
 		MashList<sAnimationSet*>::Iterator end = m_animationSetsByLayer.End();
 		for(; iter != end; ++iter)
 		{
-			if (*iter == playIter->second)
+			if (*iter == animationSet)
 				continue;
 
 			else if (bStopAndResetAllTracks || (m_pTransitionTo && ((*iter)->iTrack == m_pTransitionTo->iTrack)))
@@ -249,11 +270,11 @@ namespace mash
 
 	eMASH_STATUS CMashAnimationMixer::ResetBackToStart(const int8 *sName)
 	{
-		std::map<MashStringc, sAnimationSet*>::iterator iter = m_animationSetsByName.find(sName);
-		if (iter == m_animationSetsByName.end())
+		sAnimationSet *animationSet = FindAnimationSet(sName);
+		if (!animationSet)
 			return aMASH_FAILED;
 
-		_ResetAnimationBackToStart(iter->second);
+		_ResetAnimationBackToStart(animationSet);
 
 		return aMASH_OK;
 	}
@@ -269,11 +290,20 @@ namespace mash
 
 	eMASH_STATUS CMashAnimationMixer::Stop(const int8 *sName, bool resetBackStart)
 	{
-		std::map<MashStringc, sAnimationSet*>::iterator iter = m_animationSetsByName.find(sName);
-		if (iter == m_animationSetsByName.end())
+		MashStringID animationID;
+		if (!MashStringID::Find(sName, animationID))
+			return aMASH_FAILED;
+
+		return Stop(animationID, resetBackStart);
+	}
+
+	eMASH_STATUS CMashAnimationMixer::Stop(const MashStringID &animationID, bool resetBackStart)
+	{
+		sAnimationSet *animationSet = FindAnimationSet(animationID);
+		if (!animationSet)
 			return aMASH_FAILED;
 
-		_Stop(iter->second, resetBackStart);
+		_Stop(animationSet, resetBackStart);
 
 		return aMASH_OK;
 	}
@@ -298,62 +328,89 @@ namespace mash
 
 	eMASH_STATUS CMashAnimationMixer::SetFrame(const int8 *sName, int32 iFrame)
 	{
-		std::map<MashStringc, sAnimationSet*>::iterator iter = m_animationSetsByName.find(sName);
-		if (iter == m_animationSetsByName.end())
+		MashStringID animationID;
+		if (!MashStringID::Find(sName, animationID))
+			return aMASH_FAILED;
+
+		return SetFrame(animationID, iFrame);
+	}
+
+	eMASH_STATUS CMashAnimationMixer::SetFrame(const MashStringID &animationID, int32 iFrame)
+	{
+		sAnimationSet *animationSet = FindAnimationSet(animationID);
+		if (!animationSet)
 			return aMASH_FAILED;
 
-		iter->second->iFrame = math::Clamp<int32>(0, iter->second->frameLength, iFrame);
+		animationSet->iFrame = math::Clamp<int32>(0, animationSet->frameLength, iFrame);
 		return aMASH_OK;
 	}
 
 	eMASH_STATUS CMashAnimationMixer::SetSpeed(const int8 *sName, f32 fSpeed)
 	{
-		std::map<MashStringc, sAnimationSet*>::iterator iter = m_animationSetsByName.find(sName);
-		if (iter == m_animationSetsByName.end())
+		MashStringID animationID;
+		if (!MashStringID::Find(sName, animationID))
+			return aMASH_FAILED;
+
+		return SetSpeed(animationID, fSpeed);
+	}
+
+	eMASH_STATUS CMashAnimationMixer::SetSpeed(const MashStringID &animationID, f32 fSpeed)
+	{
+		sAnimationSet *animationSet = FindAnimationSet(animationID);
+		if (!animationSet)
 			return aMASH_FAILED;
 
-		iter->second->fSpeed = fSpeed;
+		animationSet->fSpeed = fSpeed;
 
 		return aMASH_OK;
 	}
 
 	eMASH_STATUS CMashAnimationMixer::SetWeight(const int8 *sName, f32 fWeight)
 	{
-		std::map<MashStringc, sAnimationSet*>::iterator iter = m_animationSetsByName.find(sName);
-		if (iter == m_animationSetsByName.end())
+		MashStringID animationID;
+		if (!MashStringID::Find(sName, animationID))
+			return aMASH_FAILED;
+
+		return SetWeight(animationID, fWeight);
+	}
+
+	eMASH_STATUS CMashAnimationMixer::SetWeight(const MashStringID &animationID, f32 fWeight)
+	{
+		sAnimationSet *animationSet = FindAnimationSet(animationID);
+		if (!animationSet)
 			return aMASH_FAILED;
 
-		iter->second->fWeight = math::Clamp<f32>(0.0f, 1.0f, fWeight);
+		animationSet->fWeight = math::Clamp<f32>(0.0f, 1.0f, fWeight);
 		return aMASH_OK;
 	}
 
 	eMASH_STATUS CMashAnimationMixer::SetWrapMode(const int8 *sName, eANIMATION_WRAP_MODE mode)
 	{
-		std::map<MashStringc, sAnimationSet*>::iterator iter = m_animationSetsByName.find(sName);
-		if (iter == m_animationSetsByName.end())
+		sAnimationSet *animationSet = FindAnimationSet(sName);
+		if (!animationSet)
 			return aMASH_FAILED;
 
-		iter->second->eWrapMode = mode;
+		animationSet->eWrapMode = mode;
 		return aMASH_OK;
 	}
 
 	eMASH_STATUS CMashAnimationMixer::SetBlendMode(const int8 *sName, eANIMATION_BLEND_MODE mode)
 	{
-		std::map<MashStringc, sAnimationSet*>::iterator iter = m_animationSetsByName.find(sName);
-		if (iter == m_animationSetsByName.end())
+		sAnimationSet *animationSet = FindAnimationSet(sName);
+		if (!animationSet)
 			return aMASH_FAILED;
 
-		iter->second->eBlendMode = mode;
+		animationSet->eBlendMode = mode;
 		return aMASH_OK;
 	}
 
 	eMASH_STATUS CMashAnimationMixer::SetTrack(const int8 *sName, uint32 iTrack)
 	{
-		std::map<MashStringc, sAnimationSet*>::iterator iter = m_animationSetsByName.find(sName);
-		if (iter == m_animationSetsByName.end())
+		sAnimationSet *animationSet = FindAnimationSet(sName);
+		if (!animationSet)
 			return aMASH_FAILED;
 
-		iter->second->iTrack = iTrack;
+		animationSet->iTrack = iTrack;
 
 		//re-sort the track list
 		m_animationSetsByLayer.Sort(sTrackSort());
@@ -363,72 +420,99 @@ namespace mash
 
 	bool CMashAnimationMixer::GetIsPlaying(const int8 *sName)const
 	{
-		std::map<MashStringc, sAnimationSet*>::const_iterator iter = m_animationSetsByName.find(sName);
-		if (iter != m_animationSetsByName.end())
-			return iter->second->bPlay;
+		MashStringID animationID;
+		if (!MashStringID::Find(sName, animationID))
+			return false;
+
+		return GetIsPlaying(animationID);
+	}
+
+	bool CMashAnimationMixer::GetIsPlaying(const MashStringID &animationID)const
+	{
+		const sAnimationSet *animationSet = FindAnimationSet(animationID);
+		if (animationSet)
+			return animationSet->bPlay;
 
 		return false;
 	}
 
 	int32 CMashAnimationMixer::GetFrame(const int8 *sName)const
 	{
-		std::map<MashStringc, sAnimationSet*>::const_iterator iter = m_animationSetsByName.find(sName);
-		if (iter != m_animationSetsByName.end())
-			return iter->second->iFrame;
+		MashStringID animationID;
+		if (!MashStringID::Find(sName, animationID))
+			return 0;
+
+		return GetFrame(animationID);
+	}
+
+	int32 CMashAnimationMixer::GetFrame(const MashStringID &animationID)const
+	{
+		const sAnimationSet *animationSet = FindAnimationSet(animationID);
+		if (animationSet)
+			return animationSet->iFrame;
 
 		return 0;
 	}
 
 	f32 CMashAnimationMixer::GetSpeed(const int8 *sName)const
 	{
-		std::map<MashStringc, sAnimationSet*>::const_iterator iter = m_animationSetsByName.find(sName);
-		if (iter != m_animationSetsByName.end())
-			return iter->second->fSpeed;
+		const sAnimationSet *animationSet = FindAnimationSet(sName);
+		if (animationSet)
+			return animationSet->fSpeed;
 
 		return 0.0f;
 	}
 
 	int32 CMashAnimationMixer::GetFrameLength(const int8 *sName)const
 	{
-		std::map<MashStringc, sAnimationSet*>::const_iterator iter = m_animationSetsByName.find(sName);
-		if (iter != m_animationSetsByName.end())
-			return iter->second->frameLength;
+		const sAnimationSet *animationSet = FindAnimationSet(sName);
+		if (animationSet)
+			return animationSet->frameLength;
 
 		return 0;
 	}
 
 	f32 CMashAnimationMixer::GetWeight(const int8 *sName)const
 	{
-		std::map<MashStringc, sAnimationSet*>::const_iterator iter = m_animationSetsByName.find(sName);
-		if (iter != m_animationSetsByName.end())
-			return iter->second->fWeight;
+		MashStringID animationID;
+		if (!MashStringID::Find(sName, animationID))
+			return 0.0f;
+
+		return GetWeight(animationID);
+	}
+
+	f32 CMashAnimationMixer::GetWeight(const MashStringID &animationID)const
+	{
+		const sAnimationSet *animationSet = FindAnimationSet(animationID);
+		if (animationSet)
+			return animationSet->fWeight;
 
 		return 0.0f;
 	}
 
 	eANIMATION_WRAP_MODE CMashAnimationMixer::GetWrapMode(const int8 *sName)const
 	{
-		std::map<MashStringc, sAnimationSet*>::const_iterator iter = m_animationSetsByName.find(sName);
-		if (iter != m_animationSetsByName.end())
-			return iter->second->eWrapMode;
+		const sAnimationSet *animationSet = FindAnimationSet(sName);
+		if (animationSet)
+			return animationSet->eWrapMode;
 
 		return aWRAP_PLAYONCE;
 	}
 
 	eANIMATION_BLEND_MODE CMashAnimationMixer::GetBlendMode(const int8 *sName)const
 	{
-		std::map<MashStringc, sAnimationSet*>::const_iterator iter = m_animationSetsByName.find(sName);
-		if (iter != m_animationSetsByName.end())
-			return iter->second->eBlendMode;
+		const sAnimationSet *animationSet = FindAnimationSet(sName);
+		if (animationSet)
+			return animationSet->eBlendMode;
 
 		return aBLEND_BLEND;
 	}
 
 	uint32 CMashAnimationMixer::GetTrack(const int8 *sName)const
 	{
-		std::map<MashStringc, sAnimationSet*>::const_iterator iter = m_animationSetsByName.find(sName);
-		if (iter != m_animationSetsByName.end())
-			return iter->second->iTrack;
+		const sAnimationSet *animationSet = FindAnimationSet(sName);
+		if (animationSet)
+			return animationSet->iTrack;
 
 		return 0;
 	}
@@ -463,25 +547,34 @@ namespace mash
 
 	void CMashAnimationMixer::Transition(const int8 *sName, f32 fTransitionLength, bool bAffectAllTracks)
 	{
-		std::map<MashStringc, sAnimationSet*>::iterator mapNodeIter = m_animationSetsByName.find(sName);
-		if (mapNodeIter == m_animationSetsByName.end())
+		MashStringID animationID;
+		if (!MashStringID::Find(sName, animationID))
+			return;
+
+		Transition(animationID, fTransitionLength, bAffectAllTracks);
+	}
+
+	void CMashAnimationMixer::Transition(const MashStringID &animationID, f32 fTransitionLength, bool bAffectAllTracks)
+	{
+		sAnimationSet *animationSet = FindAnimationSet(animationID);
+		if (!animationSet)
 			return;
 
 		/*
 			Dont repeat a recent similar call
 		*/
-		if (m_bTransitionAcvtive && (m_pTransitionTo == mapNodeIter->second))
+		if (m_bTransitionAcvtive && (m_pTransitionTo == animationSet))
 			return;
 
 		//dont perform a transition on an animation thats already playing
-		if (mapNodeIter->second->bPlay == true && (mapNodeIter->second->fWeight == 1.0f))
+		if (animationSet->bPlay == true && (animationSet->fWeight == 1.0f))
 			return;
 
 		//dont allow transitioning into additive animations.
-		if (mapNodeIter->second->eBlendMode == aBLEND_ADDITIVE)
+		if (animationSet->eBlendMode == aBLEND_ADDITIVE)
 			return;
 
-		m_pTransitionTo = mapNodeIter->second;
+		m_pTransitionTo = animationSet;
 
 		m_pTransitionTo->bPlay = true;
 
@@ -510,17 +603,17 @@ namespace mash
 
 	void CMashAnimationMixer::RemoveAnimationSet(const int8 *sName)
 	{
-		std::map<MashStringc, sAnimationSet*>::iterator mapNodeIter = m_animationSetsByName.find(sName);
-		if (mapNodeIter == m_animationSetsByName.end())
+		sAnimationSet *animationSet = FindAnimationSet(sName);
+		if (!animationSet)
 			return;
 
-		m_animationSetsByName.erase(mapNodeIter);
+		m_animationSetsByName.Erase(animationSet->animationID);
 
 		MashList<sAnimationSet*>::Iterator iter = m_animationSetsByLayer.Begin();
 		MashList<sAnimationSet*>::Iterator end = m_animationSetsByLayer.End();
 		for(; iter != end; ++iter)
 		{
-			if (mapNodeIter->second == *iter)
+			if (animationSet == *iter)
 			{
 				m_animationSetsByLayer.Erase(iter);
 				break;
@@ -530,8 +623,8 @@ namespace mash
 
 	void CMashAnimationMixer::SetCallbackTrigger(const int8 *animation, int32 frame, int32 userData)
 	{
-		std::map<MashStringc, sAnimationSet*>::iterator iter = m_animationSetsByName.find(animation);
-		if (iter == m_animationSetsByName.end())
+		sAnimationSet *animationSet = FindAnimationSet(animation);
+		if (!animationSet)
 			return;
 
 		sAnimationEvent newEvent;
@@ -540,7 +633,7 @@ namespace mash
 		newEvent.frame = frame;
 		newEvent.userData = userData;
 
-		iter->second->callbackFrames.PushBack(newEvent);
+		animationSet->callbackFrames.PushBack(newEvent);
 	}
 
 	void CMashAnimationMixer::SetCallbackHandler(MashAnimationEventFunctor callback)
@@ -8,7 +8,7 @@
 #define _CMASH_ANIMATION_MIXER_H_
 
 #include "MashAnimationMixer.h"
-#include <map>
+#include "MashStringIDMap.h"
 #include "MashList.h"
 #include "MashAnimationController.h"
 
@@ -54,6 +54,7 @@ namespace mash
 		struct sAnimationSet
 		{
 			MashStringc animationName;
+			MashStringID animationID;
 
 			MashArray<MashKeyController*> keyControllers;
 			MashArray<sAnimationEvent> callbackFrames;
@@ -164,7 +165,7 @@ namespace mash
 
 		//! Holds the animation sets. Sorted differently for speed.
 		MashList<sAnimationSet*> m_animationSetsByLayer;
-		std::map<MashStringc, sAnimationSet*> m_animationSetsByName;
+		MashStringIDMap<sAnimationSet*> m_animationSetsByName;
 
 		//! The controller manager.
 		MashControllerManager *m_pControllerManager;
@@ -187,6 +188,9 @@ namespace mash
 		void _ResetAnimationBackToStart(sAnimationSet *set);
 		void _Stop(sAnimationSet *set, bool resetBackStart);
 
+		sAnimationSet* FindAnimationSet(const MashStringID &animationID)const;
+		sAnimationSet* FindAnimationSet(const int8 *sName)const;
+
 	public:
 		//! Constructor.
 		CMashAnimationMixer(MashControllerManager *pControllerManager/*, int32 id*/);
@@ -234,6 +238,7 @@ namespace mash
 					the same track as the one being faded in.
 		*/
 		virtual void Transition(const int8 *sName, f32 fTransitionLength = 0.4f, bool bAffectAllTracks = false); 
+		virtual void Transition(const MashStringID &animationID, f32 fTransitionLength = 0.4f, bool bAffectAllTracks = false);
 		
 		//! Play a particular animation set.
 		/*!
@@ -245,6 +250,7 @@ namespace mash
 			\return OK if no errors occured. FAILED otherwise.
 		*/
 		virtual eMASH_STATUS Play(const int8 *sName, bool bStopAndResetAllTracks = false);
+		virtual eMASH_STATUS Play(const MashStringID &animationID, bool bStopAndResetAllTracks = false);
 
 		//! Stop an animation set from playing.
 		/*!
@@ -252,6 +258,7 @@ namespace mash
 			\return OK if no errors occured. FAILED otherwise.
 		*/
 		virtual eMASH_STATUS Stop(const int8 *sName, bool resetBackStart = false);
+		virtual eMASH_STATUS Stop(const MashStringID &animationID, bool resetBackStart = false);
 
 		//! Stop all animation sets from playing.
 		/*!
@@ -275,6 +282,7 @@ namespace mash
 			\return OK if no errors occured. FAILED otherwise.
 		*/
 		virtual eMASH_STATUS SetSpeed(const int8 *sName, f32 fSpeed);
+		virtual eMASH_STATUS SetSpeed(const MashStringID &animationID, f32 fSpeed);
 
 		//! Only useful if Play is false. Sets the current frame.
 		/*!
@@ -286,6 +294,7 @@ namespace mash
 			\return OK if no errors occured. FAILED otherwise.
 		*/
 		virtual eMASH_STATUS SetFrame(const int8 *sName, int32 iFrame);
+		virtual eMASH_STATUS SetFrame(const MashStringID &animationID, int32 iFrame);
 		/*
 			Setting the weight affects blending when two or more animations
 			are playing. Weight will have no affect with only 1 animation
@@ -303,6 +312,7 @@ namespace mash
 			\return OK if no errors occured. FAILED otherwise.
 		*/
 		virtual eMASH_STATUS SetWeight(const int8 *sName, f32 fWeight);
+		virtual eMASH_STATUS SetWeight(const MashStringID &animationID, f32 fWeight);
 
 		//! Sets the wrap mode.
 		/*!
@@ -340,6 +350,7 @@ namespace mash
 			\return True if the animation set is playing. False otherwise.
 		*/
 		virtual bool GetIsPlaying(const int8 *sName)const;
+		virtual bool GetIsPlaying(const MashStringID &animationID)const;
 
 		//! Returns the current frame.
 		/*!
@@ -347,6 +358,7 @@ namespace mash
 			\return Current frame.
 		*/
 		virtual int32 GetFrame(const int8 *sName)const;
+		virtual int32 GetFrame(const MashStringID &animationID)const;
 
 		//! Returns the speed.
 		/*!
@@ -361,6 +373,7 @@ namespace mash
 			\return Animation weight.
 		*/
 		virtual f32 GetWeight(const int8 *sName)const;
+		virtual f32 GetWeight(const MashStringID &animationID)const;
 
 		//! Returns the wrap mode.
 		/*!
@@ -15,6 +15,7 @@
 #include "MashLog.h"
 #include "MashTexture.h"
 #include "MashHelper.h"
+#include "MashMathKernels.h"
 namespace mash
 {
 	CMashCPUParticleSystem::CMashCPUParticleSystem(MashSceneNode *parent, 
@@ -26,10 +27,10 @@ namespace mash
 			bool isCustomParticleSystem,
 			bool isMaterialInstanced,
 			const sParticleSettings &settings):CMashParticleSystemIntermediate(parent, pSceneManager, sName, material, isCustomParticleSystem, isMaterialInstanced),m_pRenderer(pRenderer),
-			m_pMaterial(material), m_destinationTime(0.0f), m_startTime(0.0f), m_currentInterpolatedTime(0.0f),
-			m_particles(0), m_nextAvaliableParticle(0),
-			m_particleType(particleType), m_meshBuffer(0),
-			 m_deadParticleIndexList(0), m_activeParticleCount(0), m_positionElementLocation(mash::math::MaxUInt32()),
+			m_destinationTime(0.0f), m_startTime(0.0f), m_currentInterpolatedTime(0.0f), m_pMaterial(material),
+			m_transientBuffer(0), m_firstVertex(0),
+			m_nextAvaliableParticle(0), m_activeParticleCount(0), m_deadParticleIndexList(0), m_particles(0),
+			m_particleType(particleType), m_positionElementLocation(mash::math::MaxUInt32()),
 			m_positionElementSize(mash::math::MaxUInt32()), m_colourElementLocation(mash::math::MaxUInt32()), m_colourElementSize(mash::math::MaxUInt32()),
 			m_texcoordElementLocation(mash::math::MaxUInt32()), m_texcoordElementSize(mash::math::MaxUInt32())
 	{
@@ -60,17 +61,13 @@ namespace mash
 			}
 		}
 
+		m_transientBuffer = m_pRenderer->GetTransientVertexBuffer(material->GetVertexDeclaration());
+
 		SetParticleSettings(settings);
 	}
 
 	CMashCPUParticleSystem::~CMashCPUParticleSystem()
 	{
-		if (m_meshBuffer)
-		{
-			m_meshBuffer->Drop();
-			m_meshBuffer = 0;
-		}
-
 		if (m_particles)
 		{
 			MASH_FREE(m_particles);
@@ -95,8 +92,6 @@ namespace mash
 	{
 		if (newCount > oldCount)
 		{
-			const uint32 verticesPerParticle = 6;
-
 			if (m_particles)
 			{
 				MASH_FREE(m_particles);
@@ -109,8 +104,6 @@ namespace mash
 				m_deadParticleIndexList = 0;
 			}
 
-			uint32 totalVertexCount = m_particleSettings.maxParticleCount * verticesPerParticle;
-
 			//resize particle array
 			m_particles = MASH_ALLOC_T_COMMON(sParticle, m_particleSettings.maxParticleCount);
 			if (!m_particles)
@@ -119,23 +112,11 @@ namespace mash
 				m_particleSettings.maxParticleCount = 0;
 			}
 
-			if (!m_meshBuffer)
+			//vertices are written to the shared transient buffer when drawn
+			if (!m_transientBuffer)
 			{
-				sVertexStreamInit streamData;
-				streamData.data = 0;
-				streamData.dataSizeInBytes = totalVertexCount * m_pMaterial->GetVertexDeclaration()->GetStreamSizeInBytes(0);
-				streamData.usage = aUSAGE_DYNAMIC;
-
-				m_meshBuffer = m_pRenderer->CreateMeshBuffer(&streamData, 1, m_pMaterial->GetVertexDeclaration());
-				if (!m_meshBuffer)
-				{
-					//error!
-					m_particleSettings.maxParticleCount = 0;
-				}
-			}
-			else
-			{
-				m_meshBuffer->ResizeVertexBuffers(0, totalVertexCount * m_pMaterial->GetVertexDeclaration()->GetStreamSizeInBytes(0));
+				//error!
+				m_particleSettings.maxParticleCount = 0;
 			}
 
 			m_deadParticleIndexList = MASH_ALLOC_T_COMMON(int32, m_particleSettings.maxParticleCount);
@@ -269,7 +250,7 @@ namespace mash
 		if (m_activeParticleCount > 0)
 		{
 			uint8 *charVertices = 0;
-			if (m_meshBuffer->GetVertexBuffer()->Lock(mash::aLOCK_WRITE_DISCARD, (void**)(&charVertices)) == aMASH_FAILED)
+			if (m_transientBuffer->Lock(m_particleSettings.maxParticleCount * 6, (void**)(&charVertices)) == aMASH_FAILED)
 			{
                 MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
                                  "Failed to fill particle buffer.", 
@@ -290,15 +271,13 @@ namespace mash
 
 			uint32 shaderCornerIndex[] = {0, 1, 3, 1, 2, 3};
 
-			sMashColour vertexColour;
-			mash::MashVector3 vertexWorldPosition;
-			mash::MashVector3 tempPosition;
-			mash::MashVector3 tempTexcoord;
 			mash::MashMatrix4 viewMatrix = m_pRenderer->GetRenderInfo()->GetCamera()->GetView();
 			viewMatrix.Invert();
 			uint32 vertexSize = m_pMaterial->GetVertexDeclaration()->GetStreamSizeInBytes(0);
 
-			uint32 activeParticleVertices = 0;
+			m_billboards.Clear();
+			m_billboardCorners.Clear();
+
 			sParticle *cpuParticle = 0;
 			for(uint32 i = 0; i <  m_particleSettings.maxParticleCount; ++i)
 			{
@@ -308,7 +287,8 @@ namespace mash
 					f32 timeElapseSinceCreation = m_currentInterpolatedTime - cpuParticle->timeCreated;
 					f32 normalizedAge = timeElapseSinceCreation / (cpuParticle->destroyTime - cpuParticle->timeCreated);
 
-					vertexColour = cpuParticle->startColour.Lerp(cpuParticle->endColour, normalizedAge).ToColour();
+					sBillboard billboard;
+					billboard.colour = cpuParticle->startColour.Lerp(cpuParticle->endColour, normalizedAge).ToColour();
 
 					f32 rotationAmount = cpuParticle->rotation * normalizedAge;
 					f32 s = sin(rotationAmount);
@@ -316,45 +296,57 @@ namespace mash
 
 					f32 scale = math::Lerp(cpuParticle->startScale, cpuParticle->endScale, normalizedAge);
 
-					vertexWorldPosition = cpuParticle->position + (cpuParticle->velocity * timeElapseSinceCreation);
-					vertexWorldPosition += m_particleSettings.gravity * 0.5f * timeElapseSinceCreation * timeElapseSinceCreation;
+					billboard.position = cpuParticle->position + (cpuParticle->velocity * timeElapseSinceCreation);
+					billboard.position += m_particleSettings.gravity * 0.5f * timeElapseSinceCreation * timeElapseSinceCreation;
+					m_billboards.PushBack(billboard);
 
-					for(uint32 vert = 0; vert < 6; ++vert)
+					for(uint32 corner = 0; corner < 4; ++corner)
 					{
 						//scale
-						tempPosition.x = primtiveCorners[shaderCornerIndex[vert]].x * scale;
-						tempPosition.y = primtiveCorners[shaderCornerIndex[vert]].y * scale;
-						tempPosition.z = 0.0f;
+						f32 x = primtiveCorners[corner].x * scale;
+						f32 y = primtiveCorners[corner].y * scale;
 						/*
 							//produces an old school twinkle effect
 							tempPosition.x = c * tempPosition.x - s * tempPosition.y;
 							tempPosition.y  = s * tempPosition.x + c * tempPosition.y;
 						*/
 						//rotate
-						f32 rotX = c * tempPosition.x - s * tempPosition.y;
-						f32 rotY  = s * tempPosition.x + c * tempPosition.y;
-						tempPosition.x = rotX;
-						tempPosition.y = rotY;
-						//billboard
-						tempPosition = viewMatrix.TransformRotation(tempPosition);
-						//world position
-						tempPosition.x += vertexWorldPosition.x;
-						tempPosition.y += vertexWorldPosition.y;
-						tempPosition.z += vertexWorldPosition.z;
-
-						if (m_positionElementLocation != mash::math::MaxUInt32())
-							memcpy(&charVertices[(activeParticleVertices * vertexSize) + m_positionElementLocation], tempPosition.v, m_positionElementSize);
-						if (m_colourElementLocation != mash::math::MaxUInt32())
-							memcpy(&charVertices[(activeParticleVertices * vertexSize) + m_colourElementLocation], &vertexColour.colour, m_colourElementSize);
-						if (m_texcoordElementLocation != mash::math::MaxUInt32())
-							memcpy(&charVertices[(activeParticleVertices * vertexSize) + m_texcoordElementLocation], particleTextureCoords[shaderCornerIndex[vert]].v, m_texcoordElementSize);
-						
-						++activeParticleVertices;
+						m_billboardCorners.PushBack(mash::MashVector3(c * x - s * y, s * x + c * y, 0.0f));
 					}
 				}
 			}
 
-			if (m_meshBuffer->GetVertexBuffer()->Unlock() == aMASH_FAILED)
+			//billboard all corners in one pass
+			const uint32 billboardCount = m_billboards.Size();
+			if (billboardCount > 0)
+			{
+				mash::MashVector3 *corners = m_billboardCorners.Pointer();
+				kernels::TransformVectors(viewMatrix, corners, sizeof(mash::MashVector3), corners, sizeof(mash::MashVector3), billboardCount * 4);
+			}
+
+			uint32 activeParticleVertices = 0;
+			mash::MashVector3 tempPosition;
+			for(uint32 i = 0; i < billboardCount; ++i)
+			{
+				const sBillboard &billboard = m_billboards[i];
+				const mash::MashVector3 *corners = &m_billboardCorners[i * 4];
+				for(uint32 vert = 0; vert < 6; ++vert)
+				{
+					//world position
+					tempPosition = corners[shaderCornerIndex[vert]] + billboard.position;
+
+					if (m_positionElementLocation != mash::math::MaxUInt32())
+						memcpy(&charVertices[(activeParticleVertices * vertexSize) + m_positionElementLocation], tempPosition.v, m_positionElementSize);
+					if (m_colourElementLocation != mash::math::MaxUInt32())
+						memcpy(&charVertices[(activeParticleVertices * vertexSize) + m_colourElementLocation], &billboard.colour.colour, m_colourElementSize);
+					if (m_texcoordElementLocation != mash::math::MaxUInt32())
+						memcpy(&charVertices[(activeParticleVertices * vertexSize) + m_texcoordElementLocation], particleTextureCoords[shaderCornerIndex[vert]].v, m_texcoordElementSize);
+					
+					++activeParticleVertices;
+				}
+			}
+
+			if (m_transientBuffer->Unlock(activeParticleVertices, m_firstVertex) == aMASH_FAILED)
 			{
                 MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
                                  "Failed to fill particle buffer.", 
@@ -392,10 +384,11 @@ namespace mash
 			{
 				if (m_pMaterial->OnSet())
 				{
-					m_pRenderer->DrawVertexList(m_meshBuffer, 
-						GetVertexCount(),
-						GetPrimitiveCount(),
-						aPRIMITIVE_TRIANGLE_LIST);
+					m_pRenderer->DrawVertexList(m_transientBuffer->GetMeshBuffer(), 
+						activeParticleVertices,
+						activeParticleVertices / 3,
+						aPRIMITIVE_TRIANGLE_LIST,
+						m_firstVertex);
 				}
 			}
 		}
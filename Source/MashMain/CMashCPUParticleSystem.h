@@ -10,6 +10,8 @@
 #include "MashTypes.h"
 #include "MashGeometryBatch.h"
 #include "MashMeshBuffer.h"
+#include "MashTransientVertexBuffer.h"
+#include "MashArray.h"
 
 namespace mash
 {
@@ -28,6 +30,13 @@ namespace mash
 			sMashColour4 endColour;
 		};
 
+		//per particle data that is the same for all 4 billboard corners
+		struct sBillboard
+		{
+			mash::MashVector3 position;
+			sMashColour colour;
+		};
+
 	private:
 		mash::MashVideo *m_pRenderer;
 		f32 m_destinationTime;
@@ -35,7 +44,8 @@ namespace mash
 		f32 m_currentInterpolatedTime;
 		MashMaterial *m_pMaterial;
 
-		MashMeshBuffer *m_meshBuffer;
+		MashTransientVertexBuffer *m_transientBuffer;
+		uint32 m_firstVertex;
 
 		uint32 m_nextAvaliableParticle;
 		uint32 m_activeParticleCount;
@@ -51,6 +61,10 @@ namespace mash
 		uint32 m_texcoordElementLocation;
 		uint32 m_texcoordElementSize;
 
+		//held here so that draws don't allocate memory each frame
+		MashArray<sBillboard> m_billboards;
+		MashArray<mash::MashVector3> m_billboardCorners;
+
 		void ResizeParticleArray();
 		void OnPassCullImpl(f32 interpolateAmount);
 
@@ -88,7 +102,9 @@ namespace mash
 		uint32 GetNodeType()const;
 
 		///////////renderable stuff//////////////////
-		MashMeshBuffer* GetMeshBuffer()const{return m_meshBuffer;}
+		MashMeshBuffer* GetMeshBuffer()const{return m_transientBuffer ? m_transientBuffer->GetMeshBuffer() : 0;}
+		//first vertex in GetMeshBuffer() written by the last call to Draw()
+		uint32 GetFirstVertex()const{return m_firstVertex;}
 		int32 GetPrimitiveType()const;
 		uint32 GetPrimitiveCount()const;
 		uint32 GetVertexCount()const;
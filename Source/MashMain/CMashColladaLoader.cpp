@@ -26,6 +26,10 @@
 #include "MashHelper.h"
 #include "MashModel.h"
 #include "MashFileManager.h"
+#include "MashFileStream.h"
+#include "MashTimer.h"
+#include "CMashXMLReader.h"
+#include "MashTextParser.h"
 #include "MashGenericArray.h"
 #include "MashStringHelper.h"
 #include "MashLog.h"
@@ -35,99 +39,50 @@ namespace mash
 {
 	static const uint32 g_MemPoolTypeSize = 160000000;
 
-	CMashColladaLoader::CMashColladaLoader():m_memoryPool(g_MemPoolTypeSize)
+	//number arrays are kept out of the xml tree and parsed straight from the file text
+	static const int8 *const g_colladaArrayElements[] = {"float_array", "int_array", "bool_array", "p", "v", "vcount"};
+	static const uint32 g_colladaArrayElementCount = sizeof(g_colladaArrayElements) / sizeof(const int8*);
+
+	CMashColladaLoader::CMashColladaLoader():m_memoryPool(g_MemPoolTypeSize), m_device(0), m_filename(),
+		m_fileStream(0), m_xmlReader(0), m_upAxis(aFILE_UP_AXIS_Y),
+		m_modelMap(std::less<MashStringc>(), meshAlloc(&m_memoryPool)),
+		m_sourceMap(std::less<MashStringc>(), sourceAlloc(&m_memoryPool)),
+		m_skinControllers(std::less<MashStringc>(), skinControllerAlloc(&m_memoryPool)),
+		m_animSamplerMap(std::less<MashStringc>(), animSampleAlloc(&m_memoryPool)),
+		m_animChannelMap(std::less<MashStringc>(), animChannelAlloc(&m_memoryPool)),
+		m_lightMap(std::less<MashStringc>(), lightAlloc(&m_memoryPool)),
+		m_nodes(), m_parsed(false), m_parseTime(0), m_buildTime(0)
 	{
 		
 	}
 
+	CMashColladaLoader::~CMashColladaLoader()
+	{
+		ReleaseParseData();
+	}
+
 	void CMashColladaLoader::ConvertTextArrayToElements(const int8 *str, sVariableArray &out, uint32 writeOffset, uint32 *elementsWritten)
 	{
 		if (elementsWritten)
 			*elementsWritten = 0;
 
-		uint32 currentIndex = 0;
-		const uint32 maxBufferCount = 20;
-		int8 currentNumberBuffer[maxBufferCount];//data shouldn't exceed this
-		uint32 currentNumberBufferIndex = 0;
-		uint32 arrayIndex = 0;
-
-		if (!str)
+		if (!str || (out.count <= 0) || (writeOffset >= (uint32)out.count))
 			return;
 
-		if ((out.count == 0) || (str[0] == 0))
-			return;
+		const uint32 maxCount = (uint32)out.count - writeOffset;
+		uint32 arrayIndex = 0;
 
-		while(str[currentIndex] != 0)
+		switch(out.type)
 		{
-			if (isspace(str[currentIndex]) && (currentNumberBufferIndex > 0))
-			{
-				//null terminator
-				currentNumberBuffer[currentNumberBufferIndex] = 0;
-
-				MASH_ASSERT((writeOffset + arrayIndex) < out.count);
-
-				switch(out.type)
-				{
-				case aARRAY_DATA_SOURCE_FLOAT:
-					out.f[writeOffset + arrayIndex] = atof(currentNumberBuffer);
-					++arrayIndex;
-					break;
-				case aARRAY_DATA_SOURCE_INT:
-					out.i[writeOffset + arrayIndex] = atoi(currentNumberBuffer);
-					++arrayIndex;
-					break;
-				case aARRAY_DATA_SOURCE_BOOL:
-					{
-						if (currentNumberBuffer[0] == 't')
-							out.b[writeOffset + arrayIndex] = true;
-						else
-							out.b[writeOffset + arrayIndex] = false;
-
-						++arrayIndex;
-					}
-					break;
-				}
-
-				currentNumberBufferIndex = 0;
-			}
-			else
-			{
-				MASH_ASSERT(currentNumberBufferIndex < maxBufferCount);
-				currentNumberBuffer[currentNumberBufferIndex++] = str[currentIndex];
-			}
-
-			++currentIndex;
-		}
-
-		//grab the last number
-		if (currentNumberBufferIndex > 0)
-		{
-			//null terminator
-			currentNumberBuffer[currentNumberBufferIndex] = 0;
-
-			MASH_ASSERT((writeOffset + arrayIndex) < out.count);
-
-			switch(out.type)
-			{
-			case aARRAY_DATA_SOURCE_FLOAT:
-				out.f[writeOffset + arrayIndex] = atof(currentNumberBuffer);
-				++arrayIndex;
-				break;
-			case aARRAY_DATA_SOURCE_INT:
-				out.i[writeOffset + arrayIndex] = atoi(currentNumberBuffer);
-				++arrayIndex;
-				break;
-			case aARRAY_DATA_SOURCE_BOOL:
-				{
-					if (currentNumberBuffer[0] == 't')
-						out.b[writeOffset + arrayIndex] = true;
-					else
-						out.b[writeOffset + arrayIndex] = false;
-
-					++arrayIndex;
-				}
-				break;
-			}
+		case aARRAY_DATA_SOURCE_FLOAT:
+			arrayIndex = text::ParseFloatArray(str, &out.f[writeOffset], maxCount);
+			break;
+		case aARRAY_DATA_SOURCE_INT:
+			arrayIndex = text::ParseIntArray(str, &out.i[writeOffset], maxCount);
+			break;
+		case aARRAY_DATA_SOURCE_BOOL:
+			arrayIndex = text::ParseBoolArray(str, &out.b[writeOffset], maxCount);
+			break;
 		}
 
 		if (elementsWritten)
@@ -460,42 +415,7 @@ namespace mash
 
 	void CMashColladaLoader::GetFloatsFromArray(const int8 *str, f32 *floatAry, uint32 floatCount)
 	{
-		uint32 currentIndex = 0;
-		int8 currentNumberBuffer[20];//data shouldn't exceed this
-		uint32 currentNumberBufferIndex = 0;
-		uint32 arrayIndex = 0;
-
-		if (!str || (str[0] == 0))
-			return;
-
-		while(str[currentIndex] != 0)
-		{
-			if (isspace(str[currentIndex]) && (currentNumberBufferIndex > 0))
-			{
-				//null terminator
-				currentNumberBuffer[currentNumberBufferIndex] = 0;
-
-				MASH_ASSERT(arrayIndex < floatCount);
-				floatAry[arrayIndex++] = atof(currentNumberBuffer);
-
-				currentNumberBufferIndex = 0;
-			}
-			else
-			{
-				currentNumberBuffer[currentNumberBufferIndex++] = str[currentIndex];
-			}
-
-			++currentIndex;
-		}
-
-		//grab the last number
-		if (currentNumberBufferIndex > 0)
-		{
-			//null terminator
-			currentNumberBuffer[currentNumberBufferIndex] = 0;
-			MASH_ASSERT(arrayIndex < floatCount);
-			floatAry[arrayIndex++] = atof(currentNumberBuffer);
-		}
+		text::ParseFloatArray(str, floatAry, floatCount);
 	}
 
 	const int8* CMashColladaLoader::RemoveStringHash(const int8 *s)
@@ -1557,7 +1477,8 @@ namespace mash
 
 				uint32 meshFlags = MashMeshBuilder::aMESH_UPDATE_FILL_MESH | 
 					MashMeshBuilder::aMESH_UPDATE_CHANGE_VERTEX_FORMAT | 
-					MashMeshBuilder::aMESH_UPDATE_WELD;
+					MashMeshBuilder::aMESH_UPDATE_WELD |
+					MashMeshBuilder::aMESH_UPDATE_OPTIMISE;
 
 				if (newMesh.indexCount < 65535)
 					meshFlags |= MashMeshBuilder::aMESH_UPDATE_16BIT_INDICES;
@@ -1956,7 +1877,7 @@ namespace mash
 		}
 	}
 
-	void CMashColladaLoader::ReadLibraryControllers(MashXMLReader *xmlReader, eFILE_UP_AXIS upAxis, MashDevice *device, std::map<MashStringc, sSource, std::less<MashStringc>, sourceAlloc > &sourceMap, std::map<MashStringc, sSkinController, std::less<MashStringc>, skinControllerAlloc > &skinControllers)
+	void CMashColladaLoader::ReadLibraryControllers(MashXMLReader *xmlReader, eFILE_UP_AXIS upAxis, std::map<MashStringc, sSource, std::less<MashStringc>, sourceAlloc > &sourceMap, std::map<MashStringc, sSkinController, std::less<MashStringc>, skinControllerAlloc > &skinControllers)
 	{
 		if (xmlReader->MoveToFirstChild("controller"))
 		{
@@ -1971,7 +1892,8 @@ namespace mash
 						sSkinController newSkinController;
 						newSkinController.id = controllerId;
 						newSkinController.geomOwner = RemoveStringHash(xmlReader->GetAttributeRaw("source"));
-						newSkinController.engineSkin = device->GetSceneManager()->CreateSkin();
+						//created in Build()
+						newSkinController.engineSkin = 0;
 
 						if (xmlReader->MoveToFirstChild("bind_shape_matrix"))
 						{
@@ -2120,31 +2042,60 @@ namespace mash
 		}
 	}
 
-	eMASH_STATUS CMashColladaLoader::Load(MashDevice *device, const MashStringc &filename, MashList<mash::MashSceneNode*> &rootNodes, const sLoadSceneSettings &loadSettings)
+	eMASH_STATUS CMashColladaLoader::Open(MashDevice *device, const MashStringc &filename)
 	{
 		//clear any previously loaded data
+		ReleaseParseData();
 		m_memoryPool.Clear();
 
-		MashXMLReader *xmlReader = device->GetFileManager()->CreateXMLReader(filename.GetCString());
+		m_device = device;
+		m_filename = filename;
+		m_parseTime = 0;
+		m_buildTime = 0;
 
-		if (!xmlReader)
+		m_fileStream = device->GetFileManager()->CreateFileStream();
+		if (m_fileStream->LoadFile(filename.GetCString(), aFILE_IO_TEXT) == aMASH_FAILED)
 		{
 			MASH_WRITE_TO_LOG_EX(MashLog::aERROR_LEVEL_ERROR,
-						"CMashColladaLoader::Load",
-						"Collada file not found.",
+						"CMashColladaLoader::Open",
+						"Collada file '%s' not found.",
 						filename.GetCString());
 
+			m_fileStream->Destroy();
+			m_fileStream = 0;
 			return aMASH_FAILED;
 		}
 
+		return aMASH_OK;
+	}
+
+	eMASH_STATUS CMashColladaLoader::Parse()
+	{
+		if (!m_fileStream || m_parsed)
+			return aMASH_FAILED;
+
+		const uint64 parseStartTime = m_device->GetTimer()->GetTimeSinceProgramStart();
+
 		MASH_WRITE_TO_LOG_EX(MashLog::aERROR_LEVEL_INFORMATION, 
-					"CMashColladaLoader::Load",
+					"CMashColladaLoader::Parse",
 					"Started to load Collada file '%s'.",
-					filename.GetCString());
+					m_filename.GetCString());
+
+		m_xmlReader = MASH_NEW_COMMON CMashXMLReader(m_device->GetFileManager());
+		if (!m_xmlReader->LoadText((const int8*)m_fileStream->GetData(), g_colladaArrayElements, g_colladaArrayElementCount))
+		{
+			MASH_WRITE_TO_LOG_EX(MashLog::aERROR_LEVEL_ERROR,
+						"CMashColladaLoader::Parse",
+						"Collada file '%s' contains no elements.",
+						m_filename.GetCString());
+
+			return aMASH_FAILED;
+		}
 
-		sFileData fileData;
+		MashXMLReader *xmlReader = m_xmlReader;
 		MashStringc stringBuffer;
-		
+
+		m_upAxis = aFILE_UP_AXIS_Y;
 		if (xmlReader->MoveToFirstChild("asset"))
 		{
 			if (xmlReader->MoveToFirstChild("up_axis"))
@@ -2153,56 +2104,66 @@ namespace mash
 				xmlReader->GetText(stringBuffer);
 
 				if (strcmp(stringBuffer.GetCString(), "Z_UP") == 0)
-					fileData.upAxis = aFILE_UP_AXIS_Z;
+					m_upAxis = aFILE_UP_AXIS_Z;
 				else if (strcmp(stringBuffer.GetCString(), "Y_UP") == 0)
-					fileData.upAxis = aFILE_UP_AXIS_Y;
+					m_upAxis = aFILE_UP_AXIS_Y;
 				else
-					fileData.upAxis = aFILE_UP_AXIS_X;
+					m_upAxis = aFILE_UP_AXIS_X;
 
 				xmlReader->PopChild();
 			}
 		}
 
-		std::less<MashStringc> cmp;
-		std::map<MashStringc, sMesh*, std::less<MashStringc>, meshAlloc > modelMap(cmp, meshAlloc(&m_memoryPool));
-		std::map<MashStringc, sSource, std::less<MashStringc>, sourceAlloc > sourceMap(cmp, sourceAlloc(&m_memoryPool));
-
-		std::map<MashStringc, sSkinController, std::less<MashStringc>, skinControllerAlloc > skinControllers(cmp, skinControllerAlloc(&m_memoryPool));
-
-		MashList<sNode> nodes;
-
-		std::map<MashStringc, sAnimSampler, std::less<MashStringc>, animSampleAlloc > animSamplerMap(cmp, animSampleAlloc(&m_memoryPool));
-		std::map<MashStringc, sAnimChannel, std::less<MashStringc>, animChannelAlloc > animChannelMap(cmp, animChannelAlloc(&m_memoryPool));
-
-		std::map<MashStringc, sLightData, std::less<MashStringc>, lightAlloc > lightMap(cmp, lightAlloc(&m_memoryPool));
 		if (xmlReader->MoveToNextSibling())
 		{
 			do
 			{
 				if (strcmp(xmlReader->GetNameRaw(), "library_geometries") == 0)
 				{
-					ReadLibraryGeometry(xmlReader, fileData.upAxis, modelMap, sourceMap);
+					ReadLibraryGeometry(xmlReader, m_upAxis, m_modelMap, m_sourceMap);
 				}
 				else if (strcmp(xmlReader->GetNameRaw(), "library_controllers") == 0)
 				{
-					ReadLibraryControllers(xmlReader, fileData.upAxis, device, sourceMap, skinControllers);
+					ReadLibraryControllers(xmlReader, m_upAxis, m_sourceMap, m_skinControllers);
 				}
 				else if (strcmp(xmlReader->GetNameRaw(), "library_visual_scenes") == 0)
 				{
-					ReadLibraryVisualScene(xmlReader, fileData.upAxis, nodes);
+					ReadLibraryVisualScene(xmlReader, m_upAxis, m_nodes);
 				}
 				else if (strcmp(xmlReader->GetNameRaw(), "library_animations") == 0)
 				{
-					ReadLibraryAnimation(xmlReader, fileData.upAxis, sourceMap, animSamplerMap, animChannelMap);
+					ReadLibraryAnimation(xmlReader, m_upAxis, m_sourceMap, m_animSamplerMap, m_animChannelMap);
 				}
 				else if (strcmp(xmlReader->GetNameRaw(), "library_lights") == 0)
 				{
-					ReadLibraryLights(xmlReader, fileData.upAxis, lightMap);
+					ReadLibraryLights(xmlReader, m_upAxis, m_lightMap);
 				}
 
 			}while(xmlReader->MoveToNextSibling());
 		}
 
+		m_parsed = true;
+		m_parseTime = (uint32)(m_device->GetTimer()->GetTimeSinceProgramStart() - parseStartTime);
+
+		return aMASH_OK;
+	}
+
+	eMASH_STATUS CMashColladaLoader::Build(MashList<mash::MashSceneNode*> &rootNodes, const sLoadSceneSettings &loadSettings)
+	{
+		if (!m_parsed)
+		{
+			ReleaseParseData();
+			return aMASH_FAILED;
+		}
+
+		const uint64 buildStartTime = m_device->GetTimer()->GetTimeSinceProgramStart();
+
+		//skins are created here so Parse() doesn't need the scene manager
+		std::map<MashStringc, sSkinController, std::less<MashStringc>, skinControllerAlloc >::iterator skinControllerIter = m_skinControllers.begin();
+		std::map<MashStringc, sSkinController, std::less<MashStringc>, skinControllerAlloc >::iterator skinControllerIterEnd = m_skinControllers.end();
+		for(; skinControllerIter != skinControllerIterEnd; ++skinControllerIter)
+			skinControllerIter->second.engineSkin = m_device->GetSceneManager()->CreateSkin();
+
 		mash::MashDummy *rootNode = 0;
 
 		if (loadSettings.createRootNode)
@@ -2211,8 +2172,8 @@ namespace mash
 				Get file name, minus the extension
 			*/
 			MashStringc rootNodeName = "";
-            GetFileName(filename.GetCString(), rootNodeName);
-			rootNode = device->GetSceneManager()->AddDummy(0, rootNodeName.GetCString());
+            GetFileName(m_filename.GetCString(), rootNodeName);
+			rootNode = m_device->GetSceneManager()->AddDummy(0, rootNodeName.GetCString());
 
 			rootNodes.PushBack(rootNode);
 		}
@@ -2224,19 +2185,19 @@ namespace mash
 			Convert data to engine objects
 		*/
 		MashStringc nameBuffer;
-		tdNodeListIter nodeIter = nodes.Begin();
-		tdNodeListIter nodeIterEnd = nodes.End();
+		tdNodeListIter nodeIter = m_nodes.Begin();
+		tdNodeListIter nodeIterEnd = m_nodes.End();
 		for(; nodeIter != nodeIterEnd; ++nodeIter)
 		{
 			if (!nodeIter->decodedName.Empty())
 				nameBuffer = nodeIter->decodedName;
 			else
-				device->GetSceneManager()->GenerateUniqueSceneNodeName(nameBuffer);
+				m_device->GetSceneManager()->GenerateUniqueSceneNodeName(nameBuffer);
 
 			if (nodeIter->nodeType == aCOLLADA_NODE_TYPE_JOINT)
 			{
 				//create bone
-				MashBone *bone = device->GetSceneManager()->AddBone(0, nameBuffer);
+				MashBone *bone = m_device->GetSceneManager()->AddBone(0, nameBuffer);
 				nodeIter->engineNode = bone;
 			}
 			else
@@ -2244,8 +2205,8 @@ namespace mash
 				sSkinController *skinController = 0;
 				if (nodeIter->controllerName)
 				{
-					std::map<MashStringc, sSkinController, std::less<MashStringc>, skinControllerAlloc >::iterator skinIter = skinControllers.find(nodeIter->controllerName);
-					if (skinIter != skinControllers.end())
+					std::map<MashStringc, sSkinController, std::less<MashStringc>, skinControllerAlloc >::iterator skinIter = m_skinControllers.find(nodeIter->controllerName);
+					if (skinIter != m_skinControllers.end())
 						skinController = &skinIter->second;
 
 					/*
@@ -2257,13 +2218,13 @@ namespace mash
 
 				if (nodeIter->geometryName)
 				{
-					std::map<MashStringc, sMesh*, std::less<MashStringc>, meshAlloc >::iterator mIter = modelMap.find(nodeIter->geometryName);
+					std::map<MashStringc, sMesh*, std::less<MashStringc>, meshAlloc >::iterator mIter = m_modelMap.find(nodeIter->geometryName);
 					/*
 						Models with lods > 0 will not be stored by name in this list. Lods > 0 are 
 						collapesed into lod 0. Therefore nodes that reference a model with lod > 0
 						will not be created
 					*/
-					if (mIter != modelMap.end())
+					if (mIter != m_modelMap.end())
 					{
 						MashModel *model = mIter->second->engineModel;
 						if (!model)
@@ -2274,13 +2235,13 @@ namespace mash
 							else
 								geometryOffsetTransform = nodeIter->geometryOffsetTransform;
 
-							model = CreateModel(device, fileData.upAxis, mIter->second, skinController, geometryOffsetTransform, loadSettings);
+							model = CreateModel(m_device, m_upAxis, mIter->second, skinController, geometryOffsetTransform, loadSettings);
 							mIter->second->engineModel = model;
 						}
 
 						if (model)
 						{
-							MashEntity *entity = device->GetSceneManager()->AddEntity(0, model, nameBuffer);
+							MashEntity *entity = m_device->GetSceneManager()->AddEntity(0, model, nameBuffer);
 							nodeIter->engineNode = entity;
 
 							entity->SetModel(model);
@@ -2303,18 +2264,19 @@ namespace mash
 								{
 									MashMaterial *material = 0;
 									if (meshHead->meshArray[subMeshIndex].materialName)
-										material = device->GetRenderer()->GetMaterialManager()->FindMaterial(meshHead->meshArray[subMeshIndex].materialName);
+										material = m_device->GetRenderer()->GetMaterialManager()->FindMaterial(meshHead->meshArray[subMeshIndex].materialName);
 
 									if (!material)
-										material = device->GetRenderer()->GetMaterialManager()->GetStandardMaterial(MashMaterialManager::aSTANDARD_MATERIAL_DEFAULT_MESH);
+										material = m_device->GetRenderer()->GetMaterialManager()->GetStandardMaterial(MashMaterialManager::aSTANDARD_MATERIAL_DEFAULT_MESH);
 
 									if (!material)
 									{
 										MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR,
 												"Failed to load material for mesh.",
-												"CMashColladaLoader::Load");
+												"CMashColladaLoader::Build");
 
 										//TODO : Break better
+										ReleaseParseData();
 										return aMASH_FAILED;
 									}
 
@@ -2330,23 +2292,23 @@ namespace mash
 				else if (nodeIter->lightName)
 				{
 					//create light
-					std::map<MashStringc, sLightData, std::less<MashStringc>, lightAlloc >::iterator lightIter = lightMap.find(nodeIter->lightName);
-					if (lightIter != lightMap.end())
+					std::map<MashStringc, sLightData, std::less<MashStringc>, lightAlloc >::iterator lightIter = m_lightMap.find(nodeIter->lightName);
+					if (lightIter != m_lightMap.end())
 					{
-						MashLight *light = device->GetSceneManager()->AddLight(0, nameBuffer, lightIter->second.lightType, aLIGHT_RENDERER_FORWARD, false);
+						MashLight *light = m_device->GetSceneManager()->AddLight(0, nameBuffer, lightIter->second.lightType, aLIGHT_RENDERER_FORWARD, false);
 						nodeIter->engineNode = light;
 					}
 				}
 				else if (nodeIter->cameraName)
 				{
 					//create camera
-					MashCamera *camera = device->GetSceneManager()->AddCamera(0, nameBuffer);
+					MashCamera *camera = m_device->GetSceneManager()->AddCamera(0, nameBuffer);
 					nodeIter->engineNode = camera;
 				}
 				else
 				{
 					//create dummy
-					MashDummy *dummy = device->GetSceneManager()->AddDummy(0, nameBuffer);
+					MashDummy *dummy = m_device->GetSceneManager()->AddDummy(0, nameBuffer);
 					nodeIter->engineNode = dummy;
 				}
 			}
@@ -2357,10 +2319,10 @@ namespace mash
 				newSceneNode->SetTransformation(nodeIter->localTransform, true);
 
 				//set up animations
-				std::map<MashStringc, sAnimChannel, std::less<MashStringc>, animChannelAlloc >::iterator animChannelIter = animChannelMap.find(nodeIter->id);
-				if (animChannelIter != animChannelMap.end())
+				std::map<MashStringc, sAnimChannel, std::less<MashStringc>, animChannelAlloc >::iterator animChannelIter = m_animChannelMap.find(nodeIter->id);
+				if (animChannelIter != m_animChannelMap.end())
 				{
-					MashAnimationBuffer *animBuffer = CreateAnimationBuffer(device, &animChannelIter->second, &(*nodeIter), loadSettings.frameRate);
+					MashAnimationBuffer *animBuffer = CreateAnimationBuffer(m_device, &animChannelIter->second, &(*nodeIter), loadSettings.frameRate);
 					newSceneNode->SetAnimationBuffer(animBuffer);
 					animBuffer->Drop();
 				}
@@ -2368,8 +2330,8 @@ namespace mash
 		}
 
 		//link up parents
-		nodeIter = nodes.Begin();
-		nodeIterEnd = nodes.End();
+		nodeIter = m_nodes.Begin();
+		nodeIterEnd = m_nodes.End();
 		for(; nodeIter != nodeIterEnd; ++nodeIter)
 		{
 			if (nodeIter->engineNode)
@@ -2390,8 +2352,8 @@ namespace mash
 			}
 		}
 
-		std::map<MashStringc, sSkinController, std::less<MashStringc>, skinControllerAlloc >::iterator skinControllerIter = skinControllers.begin();
-		std::map<MashStringc, sSkinController, std::less<MashStringc>, skinControllerAlloc >::iterator skinControllerIterEnd = skinControllers.end();
+		skinControllerIter = m_skinControllers.begin();
+		skinControllerIterEnd = m_skinControllers.end();
 		for(; skinControllerIter != skinControllerIterEnd; ++skinControllerIter)
 		{
 			if (skinControllerIter->second.engineSkin)
@@ -2434,8 +2396,8 @@ namespace mash
 								sNode *jointNode = 0;
 								const int8 *jointName = &nonConstJointStringArray[stringStart];
 
-								nodeIter = nodes.Begin();
-								nodeIterEnd = nodes.End();
+								nodeIter = m_nodes.Begin();
+								nodeIterEnd = m_nodes.End();
 								for(; nodeIter != nodeIterEnd; ++nodeIter)
 								{
 									if (nodeIter->engineNode && (nodeIter->engineNode->GetNodeType() == aNODETYPE_BONE))
@@ -2454,7 +2416,7 @@ namespace mash
 								if (jointNode)
 								{
 									memcpy(invBindPose.v, &bindPoseArray->varaibleArray.f[currentBoneIndex * bindPoseArray->stride], sizeof(f32) * bindPoseStride);
-									ConvertMatrix(fileData.upAxis, invBindPose);
+									ConvertMatrix(m_upAxis, invBindPose);
 									MashBone *boneSceneNode = (MashBone*)jointNode->engineNode;
 									boneSceneNode->SetWorldBindPose(invBindPose, true);
 
@@ -2476,8 +2438,22 @@ namespace mash
 			}
 		}
 
-		std::map<MashStringc, sMesh*, std::less<MashStringc>, meshAlloc >::iterator modelMapIter = modelMap.begin();
-		std::map<MashStringc, sMesh*, std::less<MashStringc>, meshAlloc >::iterator modelMapIterEnd = modelMap.end();
+		ReleaseParseData();
+
+		m_buildTime = (uint32)(m_device->GetTimer()->GetTimeSinceProgramStart() - buildStartTime);
+
+		MASH_WRITE_TO_LOG_EX(MashLog::aERROR_LEVEL_INFORMATION, 
+					"CMashColladaLoader::Build",
+					"Collada load succeeded for file '%s'. Parsed in '%u' ms, built in '%u' ms.",
+					m_filename.GetCString(), m_parseTime, m_buildTime);
+
+		return aMASH_OK;
+	}
+
+	void CMashColladaLoader::ReleaseParseData()
+	{
+		std::map<MashStringc, sMesh*, std::less<MashStringc>, meshAlloc >::iterator modelMapIter = m_modelMap.begin();
+		std::map<MashStringc, sMesh*, std::less<MashStringc>, meshAlloc >::iterator modelMapIterEnd = m_modelMap.end();
 		for(; modelMapIter != modelMapIterEnd; ++modelMapIter)
 		{
 			if (modelMapIter->second)
@@ -2499,10 +2475,10 @@ namespace mash
 			}
 		}
 
-		modelMap.clear();
+		m_modelMap.clear();
 
-		std::map<MashStringc, sSource, std::less<MashStringc>, sourceAlloc >::iterator sourceMapIter = sourceMap.begin();
-		std::map<MashStringc, sSource, std::less<MashStringc>, sourceAlloc >::iterator sourceMapIterEnd = sourceMap.end();
+		std::map<MashStringc, sSource, std::less<MashStringc>, sourceAlloc >::iterator sourceMapIter = m_sourceMap.begin();
+		std::map<MashStringc, sSource, std::less<MashStringc>, sourceAlloc >::iterator sourceMapIterEnd = m_sourceMap.end();
 		for(; sourceMapIter != sourceMapIterEnd; ++sourceMapIter)
 		{
 			//names arnt allocated into new memory
@@ -2512,32 +2488,54 @@ namespace mash
 			}
 		}
 
-		sourceMap.clear();
+		m_sourceMap.clear();
 
-		skinControllerIter = skinControllers.begin();
-		skinControllerIterEnd = skinControllers.end();
+		std::map<MashStringc, sSkinController, std::less<MashStringc>, skinControllerAlloc >::iterator skinControllerIter = m_skinControllers.begin();
+		std::map<MashStringc, sSkinController, std::less<MashStringc>, skinControllerAlloc >::iterator skinControllerIterEnd = m_skinControllers.end();
 		for(; skinControllerIter != skinControllerIterEnd; ++skinControllerIter)
 		{
 			if (skinControllerIter->second.engineSkin)
 				skinControllerIter->second.engineSkin->Drop();
 
 			if (skinControllerIter->second.vertexBoneCounts.f)
-				m_memoryPool.FreeMemory(skinControllerIter->second.vertexBoneCounts.f););
+				m_memoryPool.FreeMemory(skinControllerIter->second.vertexBoneCounts.f);
 
 			if (skinControllerIter->second.vertexBoneWeightIndices.f)
-				m_memoryPool.FreeMemory(skinControllerIter->second.vertexBoneWeightIndices.f););
+				m_memoryPool.FreeMemory(skinControllerIter->second.vertexBoneWeightIndices.f);
 		}
 
-		xmlReader->Destroy();
+		m_skinControllers.clear();
+		m_animSamplerMap.clear();
+		m_animChannelMap.clear();
+		m_lightMap.clear();
+		m_nodes.Clear();
 
-		MASH_WRITE_TO_LOG_EX(MashLog::aERROR_LEVEL_INFORMATION, 
-					"CMashColladaLoader::Load",
-					"Collada load succeeded for file '%s'.",
-					filename.GetCString());
+		if (m_xmlReader)
+		{
+			m_xmlReader->Destroy();
+			m_xmlReader = 0;
+		}
 
-		return aMASH_OK;
+		if (m_fileStream)
+		{
+			m_fileStream->Destroy();
+			m_fileStream = 0;
+		}
+
+		m_parsed = false;
+	}
+
+	eMASH_STATUS CMashColladaLoader::Load(MashDevice *device, const MashStringc &filename, MashList<mash::MashSceneNode*> &rootNodes, const sLoadSceneSettings &loadSettings)
+	{
+		if (Open(device, filename) == aMASH_FAILED)
+			return aMASH_FAILED;
+
+		if (Parse() == aMASH_FAILED)
+		{
+			ReleaseParseData();
+			return aMASH_FAILED;
+		}
 
-		//library_geometries
+		return Build(rootNodes, loadSettings);
 	}
 }
-	
@@ -17,6 +17,7 @@
 #include "MashMatrix4.h"
 #include "MashMemoryPool.h"
 #include "CMashSTLMapAllocator.h"
+#include "MashJob.h"
 
 namespace mash
 {
@@ -27,6 +28,8 @@ namespace mash
 	class MashSkin;
 	class MashAnimationBuffer;
 	class MashDevice;
+	class MashFileStream;
+	class CMashXMLReader;
 
 	const uint32 g_maxColladaAccessorParams = 16;
 
@@ -94,11 +97,6 @@ namespace mash
 			aNAME_FLAG_LOD = 1
 		};
 
-		struct sFileData
-		{
-			eFILE_UP_AXIS upAxis;
-		};
-
 		struct sVariableArray
 		{
 			union
@@ -257,7 +255,7 @@ namespace mash
 
 		void ReadLibraryLights(MashXMLReader *xmlReader, eFILE_UP_AXIS upAxis, std::map<MashStringc, sLightData, std::less<MashStringc>, lightAlloc > &lightMap);
 		void ReadLibraryGeometry(MashXMLReader *xmlReader, eFILE_UP_AXIS upAxis, std::map<MashStringc, sMesh*, std::less<MashStringc>, meshAlloc > &modelMap, std::map<MashStringc, sSource, std::less<MashStringc>, sourceAlloc > &sourceMap);
-		void ReadLibraryControllers(MashXMLReader *xmlReader, eFILE_UP_AXIS upAxis, MashDevice *device, std::map<MashStringc, sSource, std::less<MashStringc>, sourceAlloc > &sourceMap, std::map<MashStringc, sSkinController, std::less<MashStringc>, skinControllerAlloc > &skinControllers);
+		void ReadLibraryControllers(MashXMLReader *xmlReader, eFILE_UP_AXIS upAxis, std::map<MashStringc, sSource, std::less<MashStringc>, sourceAlloc > &sourceMap, std::map<MashStringc, sSkinController, std::less<MashStringc>, skinControllerAlloc > &skinControllers);
 		void ReadLibraryVisualScene(MashXMLReader *xmlReader, eFILE_UP_AXIS upAxis, MashList<sNode> &nodes);
 		void ReadLibraryAnimation(MashXMLReader *xmlReader, eFILE_UP_AXIS upAxis, std::map<MashStringc, sSource, std::less<MashStringc>, sourceAlloc > &sourceMap, std::map<MashStringc, sAnimSampler, std::less<MashStringc>, animSampleAlloc > &animSamplerMap, std::map<MashStringc, sAnimChannel, std::less<MashStringc>, animChannelAlloc > &animChannelMap);
 		void ReadAnimationData(MashXMLReader *xmlReader, eFILE_UP_AXIS upAxis,  std::map<MashStringc, sAnimSampler, std::less<MashStringc>, animSampleAlloc > &animSamplerMap, std::map<MashStringc, sAnimChannel, std::less<MashStringc>, animChannelAlloc > &animChannelMap, std::map<MashStringc, sSource, std::less<MashStringc>, sourceAlloc > &sourceMap);
@@ -286,13 +284,69 @@ namespace mash
 		void ConvertTextArrayToElements(const int8 *str, sVariableArray &out, uint32 writeOffset = 0, uint32 *elementsWritten = 0);
 		void GetInputSemanticData(MashXMLReader *xmlNode, std::map<MashStringc, sSource, std::less<MashStringc>, sourceAlloc > &sourceMap, MashList<sInputData> &out, MashList<sInputData> *vertexInputs);
 		void DecodeName(const int8 *str, MashStringc &nameOut, int32 &bitFlagOut, int32 &flagIdOut);
+		void ReleaseParseData();
 
 		MemPoolType m_memoryPool;
+
+		/*
+			Data held between Parse() and Build(). Names and ids point into
+			the xml document so the reader is kept until the build is done.
+		*/
+		MashDevice *m_device;
+		MashStringc m_filename;
+		MashFileStream *m_fileStream;
+		CMashXMLReader *m_xmlReader;
+		eFILE_UP_AXIS m_upAxis;
+		std::map<MashStringc, sMesh*, std::less<MashStringc>, meshAlloc > m_modelMap;
+		std::map<MashStringc, sSource, std::less<MashStringc>, sourceAlloc > m_sourceMap;
+		std::map<MashStringc, sSkinController, std::less<MashStringc>, skinControllerAlloc > m_skinControllers;
+		std::map<MashStringc, sAnimSampler, std::less<MashStringc>, animSampleAlloc > m_animSamplerMap;
+		std::map<MashStringc, sAnimChannel, std::less<MashStringc>, animChannelAlloc > m_animChannelMap;
+		std::map<MashStringc, sLightData, std::less<MashStringc>, lightAlloc > m_lightMap;
+		MashList<sNode> m_nodes;
+		bool m_parsed;
+
+		uint32 m_parseTime;
+		uint32 m_buildTime;
 	public:
 		CMashColladaLoader();
-		~CMashColladaLoader(){}
+		~CMashColladaLoader();
+
+		/*
+			Loading is split into three steps so many files can be parsed at once.
+			Open() and Build() use the file manager and scene manager so must be
+			called from the main thread. Parse() only touches data owned by this
+			loader and may be called from a worker thread.
+		*/
+		eMASH_STATUS Open(MashDevice *device, const MashStringc &filename);
+		eMASH_STATUS Parse();
+		eMASH_STATUS Build(MashList<mash::MashSceneNode*> &rootNodes, const sLoadSceneSettings &loadSettings);
 
+		//Open(), Parse() then Build()
 		eMASH_STATUS Load(MashDevice *device, const MashStringc &filename, MashList<mash::MashSceneNode*> &rootNodes, const sLoadSceneSettings &loadSettings);
+
+		const MashStringc& GetFilename()const{return m_filename;}
+		//time in ms taken by the last Parse()
+		uint32 GetParseTime()const{return m_parseTime;}
+		//time in ms taken by the last Build()
+		uint32 GetBuildTime()const{return m_buildTime;}
+	};
+
+	/*
+		Runs CMashColladaLoader::Parse() for a loader that has been opened.
+	*/
+	class CMashColladaParseJob : public MashJob
+	{
+	public:
+		CMashColladaLoader *loader;
+		eMASH_STATUS status;
+
+		CMashColladaParseJob():MashJob(), loader(0), status(aMASH_FAILED){}
+
+		void Run()
+		{
+			status = loader->Parse();
+		}
 	};
 }
 
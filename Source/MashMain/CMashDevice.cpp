@@ -17,6 +17,7 @@
 #include "MashMaterialBuilder.h"
 #include "Mash.h"
 #include "MashMemoryManager.h"
+#include "MashJob.h"
 
 namespace mash
 {
@@ -117,7 +118,7 @@ namespace mash
 			m_pRenderer = 0;
 		}
 
-		
+		jobs::ReleaseWorkerThreads();
 
 		CMashMemoryTracker::Instance()->OutputMemoryLog();
 		MashMemoryManager::DestroyInstance();
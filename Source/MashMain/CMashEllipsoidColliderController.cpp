@@ -4,18 +4,24 @@
 // For license and distribution see Mash.h
 //-------------------------------------------------------------------------
 #include "CMashEllipsoidColliderController.h"
+#include "CMashEllipsoidColliderManager.h"
 #include "MashTriangleCollider.h"
 #include "MashTriangleBuffer.h"
 #include "MashSceneNode.h"
 #include "MashPlane.h"
+#include "MashMathKernels.h"
 
 namespace mash
 {
+	static const f32 g_veryCloseDistance = 0.005f;
+
 	CMashEllipsoidColliderController::CMashEllipsoidColliderController(MashSceneNode *sceneNode, 
 			MashSceneNode *collisionScene, 
 			const MashVector3 &radius,
-			const MashVector3 &gravity):MashEllipsoidColliderController(),
-		m_collisionScene(collisionScene), m_radius(radius), m_gravity(gravity)
+			const MashVector3 &gravity,
+			CMashEllipsoidColliderManager *manager):MashEllipsoidColliderController(),
+		m_collisionScene(collisionScene), m_radius(radius), m_gravity(gravity), m_manager(manager),
+		m_useTriangleCache(true), m_deferStep(true)
 	{
 		if (sceneNode)//should always be provided
 			m_lastPosition = sceneNode->GetUpdatedWorldTransformState().translation;
@@ -352,15 +358,15 @@ namespace mash
 				if (collisionPacket.aabb.Intersects(node->GetWorldBoundingBox()))
 				{
 					collider->GetIntersectingTriangles(collisionPacket.aabb, node->GetWorldTransformState(), m_collidingTriangleBuffer);
-					MashArray<sIntersectingTriangleResult>::Iterator iter = m_collidingTriangleBuffer.Begin();
-					MashArray<sIntersectingTriangleResult>::Iterator iterEnd = m_collidingTriangleBuffer.End();
-					for(; iter != iterEnd; ++iter)
-					{
-						const MashTriangleBuffer *triBuffer = collider->GetTriangleBuffer(iter->bufferIndex);
-						CheckTriangle(collisionPacket, node->GetWorldTransformState().Transform(triBuffer->GetPoint(iter->triangleIndex, 0)) / collisionPacket.eRadius, 
-							node->GetWorldTransformState().Transform(triBuffer->GetPoint(iter->triangleIndex, 1)) / collisionPacket.eRadius,
-							node->GetWorldTransformState().Transform(triBuffer->GetPoint(iter->triangleIndex, 2)) / collisionPacket.eRadius);
-					}
+
+					const MashVector3 invRadius(1.0f / collisionPacket.eRadius.x, 1.0f / collisionPacket.eRadius.y, 1.0f / collisionPacket.eRadius.z);
+					m_nodeTriangleBuffer.Clear();
+					AppendESpaceTriangles(collider, node->GetWorldTransformState(), invRadius, m_nodeTriangleBuffer);
+
+					const uint32 pointCount = m_nodeTriangleBuffer.Size();
+					const MashVector3 *points = m_nodeTriangleBuffer.Pointer();
+					for(uint32 i = 0; i < pointCount; i += 3)
+						CheckTriangle(collisionPacket, points[i], points[i+1], points[i+2]);
 				}
 			}
 		}
@@ -379,7 +385,7 @@ namespace mash
 		// All hard-coded distances in this function is
 		// scaled to fit the setting above..
 		//f32 unitScale = unitsPerMeter / 100.0f;
-		f32 veryCloseDistance = 0.005f;// * unitScale;
+		f32 veryCloseDistance = g_veryCloseDistance;// * unitScale;
 		// do we need to worry?
 		if (collisionRecursionDepth > 5)
 			return pos;
@@ -400,7 +406,10 @@ namespace mash
 		// Application specific!!
 		//world->checkCollision(collisionPackage);
 
-		CollideWithWorldTriangles(thisSceneNode, collisionPackage, m_collisionScene);
+		if (m_useTriangleCache)
+			CollideWithCachedTriangles(collisionPackage);
+		else
+			CollideWithWorldTriangles(thisSceneNode, collisionPackage, m_collisionScene);
 
 		// If no collision we just move along the velocity
 		if (collisionPackage.foundCollision == false) 
@@ -452,16 +461,162 @@ namespace mash
 		return CollideWithWorld(thisSceneNode, collisionPackage, newBasePoint, newVelocityVector);
 	}
 
+	void CMashEllipsoidColliderController::CollideWithCachedTriangles(CollisionPacket &collisionPacket)
+	{
+		const uint32 pointCount = m_eSpaceTriangles.Size();
+		const MashVector3 *points = m_eSpaceTriangles.Pointer();
+		for(uint32 i = 0; i < pointCount; i += 3)
+		{
+			CheckTriangle(collisionPacket, points[i], points[i+1], points[i+2]);
+		}
+	}
+
+	void CMashEllipsoidColliderController::GetColliderNodes(MashSceneNode *node, const MashAABB &bounds, MashArray<MashSceneNode*> &out)
+	{
+		if (node->GetTriangleCollider() && bounds.Intersects(node->GetWorldBoundingBox()))
+			out.PushBack(node);
+
+		//skip whole branches that are out of reach
+		if (bounds.Intersects(node->GetTotalBoundingBox()))
+		{
+			MashList<MashSceneNode*>::ConstIterator nodeIter = node->GetChildren().Begin();
+			MashList<MashSceneNode*>::ConstIterator nodeIterEnd = node->GetChildren().End();
+			for(; nodeIter != nodeIterEnd; ++nodeIter)
+			{
+				GetColliderNodes(*nodeIter, bounds, out);
+			}
+		}
+	}
+
+	void CMashEllipsoidColliderController::GetSweptBounds(MashSceneNode *sceneNode, MashAABB &out)const
+	{
+		/*
+			Each slide iteration moves along a projection of the remaining move, so the
+			whole move stays close to the start position. The move length is doubled to keep
+			the bounds conservative, plus one for the ellipsoid itself.
+		*/
+		const MashVector3 eSpaceVelocity = (sceneNode->GetUpdatedWorldTransformState().translation - m_lastPosition) / m_radius;
+		const MashVector3 eSpaceGravity = m_gravity / m_radius;
+		const f32 extent = ((eSpaceVelocity.Length() + eSpaceGravity.Length()) * 2.0f) + 1.0f + g_veryCloseDistance;
+		const MashVector3 worldExtent = MashVector3(extent, extent, extent) * m_radius;
+
+		out.min = m_lastPosition - worldExtent;
+		out.max = m_lastPosition + worldExtent;
+	}
+
+	void CMashEllipsoidColliderController::CacheTriangles(MashSceneNode *thisSceneNode, const MashAABB &sweptBounds, MashSceneNode * const *colliderNodes, uint32 colliderNodeCount)
+	{
+		m_eSpaceTriangles.Clear();
+
+		const MashVector3 invRadius(1.0f / m_radius.x, 1.0f / m_radius.y, 1.0f / m_radius.z);
+		for(uint32 i = 0; i < colliderNodeCount; ++i)
+		{
+			MashSceneNode *node = colliderNodes[i];
+
+			//dont test self
+			if (node == thisSceneNode)
+				continue;
+
+			//the node list may have been built from bounds that cover many controllers
+			if (!sweptBounds.Intersects(node->GetWorldBoundingBox()))
+				continue;
+
+			const MashTriangleCollider *collider = node->GetTriangleCollider();
+			m_collidingTriangleBuffer.Clear();
+			collider->GetIntersectingTriangles(sweptBounds, node->GetWorldTransformState(), m_collidingTriangleBuffer);
+
+			AppendESpaceTriangles(collider, node->GetWorldTransformState(), invRadius, m_eSpaceTriangles);
+		}
+	}
+
+	void CMashEllipsoidColliderController::AppendESpaceTriangles(const MashTriangleCollider *collider, const MashTransformState &worldTransform, const MashVector3 &invRadius, MashArray<MashVector3> &out)
+	{
+		//gather the local points of the triangles found in m_collidingTriangleBuffer
+		const uint32 firstPoint = out.Size();
+		MashArray<sIntersectingTriangleResult>::Iterator iter = m_collidingTriangleBuffer.Begin();
+		MashArray<sIntersectingTriangleResult>::Iterator iterEnd = m_collidingTriangleBuffer.End();
+		for(; iter != iterEnd; ++iter)
+		{
+			const MashTriangleBuffer *triBuffer = collider->GetTriangleBuffer(iter->bufferIndex);
+			out.PushBack(triBuffer->GetPoint(iter->triangleIndex, 0));
+			out.PushBack(triBuffer->GetPoint(iter->triangleIndex, 1));
+			out.PushBack(triBuffer->GetPoint(iter->triangleIndex, 2));
+		}
+
+		const uint32 pointCount = out.Size() - firstPoint;
+		if (pointCount == 0)
+			return;
+
+		//world transform followed by the eSpace scale, in one pass
+		MashMatrix4 toESpace(worldTransform.orientation, worldTransform.translation, worldTransform.scale);
+		for(uint32 row = 0; row < 4; ++row)
+		{
+			toESpace.m[row][0] *= invRadius.x;
+			toESpace.m[row][1] *= invRadius.y;
+			toESpace.m[row][2] *= invRadius.z;
+		}
+
+		MashVector3 *points = &out[firstPoint];
+		kernels::TransformPoints(toESpace, points, sizeof(MashVector3), points, sizeof(MashVector3), pointCount);
+	}
+
+	void CMashEllipsoidColliderController::_StepCached(MashSceneNode *sceneNode, const MashAABB &sweptBounds, MashSceneNode * const *colliderNodes, uint32 colliderNodeCount)
+	{
+		CacheTriangles(sceneNode, sweptBounds, colliderNodes, colliderNodeCount);
+		Step(sceneNode);
+	}
+
+	MashVector3 CMashEllipsoidColliderController::_MoveCached(MashSceneNode *sceneNode, 
+			const MashVector3 &targetPosition, 
+			const MashAABB &sweptBounds, 
+			MashSceneNode * const *colliderNodes, 
+			uint32 colliderNodeCount)
+	{
+		CacheTriangles(sceneNode, sweptBounds, colliderNodes, colliderNodeCount);
+		return Move(sceneNode, targetPosition);
+	}
+
     void CMashEllipsoidColliderController::OnNodeUpdate(MashSceneNode *sceneNode, f32 dt)
     {
         if (dt == 0.0f)
 			return;
 
+		if (!m_useTriangleCache)
+		{
+			Step(sceneNode);
+			return;
+		}
+
+		//the manager will step this controller once all node callbacks have been called
+		if (m_manager && m_deferStep)
+		{
+			m_manager->_QueueStep(this, sceneNode);
+			return;
+		}
+
+		MashAABB sweptBounds;
+		GetSweptBounds(sceneNode, sweptBounds);
+
+		m_colliderNodeBuffer.Clear();
+		if (m_collisionScene)
+			GetColliderNodes(m_collisionScene, sweptBounds, m_colliderNodeBuffer);
+
+		_StepCached(sceneNode, sweptBounds, m_colliderNodeBuffer.Pointer(), m_colliderNodeBuffer.Size());
+	}
+
+	void CMashEllipsoidColliderController::Step(MashSceneNode *sceneNode)
+	{
+		const MashVector3 finalPosition = Move(sceneNode, sceneNode->GetUpdatedWorldTransformState().translation);
+		sceneNode->SetPosition(finalPosition);
+	}
+
+	MashVector3 CMashEllipsoidColliderController::Move(MashSceneNode *sceneNode, const MashVector3 &targetPosition)
+	{
 		CollisionPacket collisionPacket;
 
 		collisionPacket.eRadius = m_radius;
 		collisionPacket.R3Position = m_lastPosition;
-		collisionPacket.R3Velocity = (sceneNode->GetUpdatedWorldTransformState().translation - m_lastPosition);
+		collisionPacket.R3Velocity = (targetPosition - m_lastPosition);
 
 		MashVector3 eSpacePosition = collisionPacket.R3Position / collisionPacket.eRadius;
 		MashVector3 eSpaceVelocity = collisionPacket.R3Velocity / collisionPacket.eRadius;
@@ -485,7 +640,7 @@ namespace mash
 
 		m_lastPosition = finalPosition;
 
-		sceneNode->SetPosition(finalPosition);
+		return finalPosition;
     }
     
 }
\ No newline at end of file
@@ -15,6 +15,9 @@
 namespace mash
 {
     struct sIntersectingTriangleResult;
+    class CMashEllipsoidColliderManager;
+    class MashTriangleCollider;
+    class MashTransformState;
     
 	class CMashEllipsoidColliderController : public MashEllipsoidColliderController
 	{
@@ -55,16 +58,34 @@ namespace mash
 
 		MashVector3 CollideWithWorld(MashSceneNode *thisSceneNode, CollisionPacket &collisionPackage, const MashVector3 &pos, const MashVector3 &vel);
 		void CollideWithWorldTriangles(MashSceneNode *thisSceneNode, CollisionPacket &collisionPacket, MashSceneNode *node);
+		void CollideWithCachedTriangles(CollisionPacket &collisionPacket);
+		void CacheTriangles(MashSceneNode *thisSceneNode, const MashAABB &sweptBounds, MashSceneNode * const *colliderNodes, uint32 colliderNodeCount);
+		void AppendESpaceTriangles(const MashTriangleCollider *collider, const MashTransformState &worldTransform, const MashVector3 &invRadius, MashArray<MashVector3> &out);
+		void Step(MashSceneNode *sceneNode);
+		//resolves a move from the last position to targetPosition. Doesn't touch the node.
+		MashVector3 Move(MashSceneNode *sceneNode, const MashVector3 &targetPosition);
 
 		MashVector3 m_lastPosition;
 		uint32 collisionRecursionDepth;
 		MashVector3 m_radius;
 		MashVector3 m_gravity;
+
+		CMashEllipsoidColliderManager *m_manager;
+		bool m_useTriangleCache;
+		bool m_deferStep;
+
+		//eSpace triangles for the current move, 3 points per triangle
+		MashArray<MashVector3> m_eSpaceTriangles;
+		//eSpace triangles of a single node when not using the cache
+		MashArray<MashVector3> m_nodeTriangleBuffer;
+		//used when stepping without a manager
+		MashArray<MashSceneNode*> m_colliderNodeBuffer;
     public:
         CMashEllipsoidColliderController(MashSceneNode *sceneNode, 
 			MashSceneNode *collisionScene,
 			const MashVector3 &radius,
-			const MashVector3 &gravity);
+			const MashVector3 &gravity,
+			CMashEllipsoidColliderManager *manager = 0);
         
         ~CMashEllipsoidColliderController();
         
@@ -72,12 +93,64 @@ namespace mash
         
 		void SetCollisionScene(MashSceneNode *collisionScene);
 		MashSceneNode* GetCollisionScene()const;
+
+		void SetUseTriangleCache(bool enable);
+		bool GetUseTriangleCache()const;
+
+		void SetDeferStep(bool enable);
+		bool GetDeferStep()const;
+
+		/*
+			Returns the world space bounds that may be touched by this controllers
+			next move, including gravity.
+		*/
+		void GetSweptBounds(MashSceneNode *sceneNode, MashAABB &out)const;
+
+		/*
+			Steps the controller using triangles from the given list of nodes
+			only. Used by the manager once it has walked the collision scene.
+		*/
+		void _StepCached(MashSceneNode *sceneNode, const MashAABB &sweptBounds, MashSceneNode * const *colliderNodes, uint32 colliderNodeCount);
+
+		/*
+			Same as _StepCached() but the node is not moved. The final position is
+			returned so the manager can apply it later. Only reads shared scene data
+			so different controllers may call this from different threads.
+		*/
+		MashVector3 _MoveCached(MashSceneNode *sceneNode, 
+			const MashVector3 &targetPosition, 
+			const MashAABB &sweptBounds, 
+			MashSceneNode * const *colliderNodes, 
+			uint32 colliderNodeCount);
+
+		//Appends all nodes with triangle colliders whos bounds intersect the given bounds.
+		static void GetColliderNodes(MashSceneNode *node, const MashAABB &bounds, MashArray<MashSceneNode*> &out);
 	};
 
 	inline MashSceneNode* CMashEllipsoidColliderController::GetCollisionScene()const
 	{
 		return m_collisionScene;
 	}
+
+	inline void CMashEllipsoidColliderController::SetUseTriangleCache(bool enable)
+	{
+		m_useTriangleCache = enable;
+	}
+
+	inline bool CMashEllipsoidColliderController::GetUseTriangleCache()const
+	{
+		return m_useTriangleCache;
+	}
+
+	inline void CMashEllipsoidColliderController::SetDeferStep(bool enable)
+	{
+		m_deferStep = enable;
+	}
+
+	inline bool CMashEllipsoidColliderController::GetDeferStep()const
+	{
+		return m_deferStep;
+	}
 }
 
 #endif
\ No newline at end of file
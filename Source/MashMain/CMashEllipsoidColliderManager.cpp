@@ -0,0 +1,155 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#include "CMashEllipsoidColliderManager.h"
+#include "CMashEllipsoidColliderController.h"
+#include "MashSceneNode.h"
+#include "MashJob.h"
+#include "MashMathHelper.h"
+#include <algorithm>
+
+namespace mash
+{
+	static const uint32 g_ellipsoidMinStepsPerJob = 4;
+	static const uint32 g_ellipsoidMaxJobs = 16;
+
+	class CMashEllipsoidColliderManager::CMoveJob : public MashJob
+	{
+	public:
+		CMashEllipsoidColliderManager *manager;
+		uint32 first;
+		uint32 last;
+
+		CMoveJob():MashJob(), manager(0), first(0), last(0){}
+
+		void Run()
+		{
+			manager->_MoveRange(first, last);
+		}
+	};
+
+	CMashEllipsoidColliderManager::CMashEllipsoidColliderManager():MashReferenceCounter()
+	{
+
+	}
+
+	CMashEllipsoidColliderManager::~CMashEllipsoidColliderManager()
+	{
+		const uint32 queuedCount = m_queuedSteps.Size();
+		for(uint32 i = 0; i < queuedCount; ++i)
+		{
+			m_queuedSteps[i].controller->Drop();
+			m_queuedSteps[i].sceneNode->Drop();
+		}
+	}
+
+	void CMashEllipsoidColliderManager::_QueueStep(CMashEllipsoidColliderController *controller, MashSceneNode *sceneNode)
+	{
+		//held until stepped incase a callback removes the node this frame
+		controller->Grab();
+		sceneNode->Grab();
+
+		sQueuedStep step;
+		step.controller = controller;
+		step.sceneNode = sceneNode;
+		step.collisionScene = controller->GetCollisionScene();
+		m_queuedSteps.PushBack(step);
+	}
+
+	void CMashEllipsoidColliderManager::Update()
+	{
+		const uint32 queuedCount = m_queuedSteps.Size();
+		if (queuedCount == 0)
+			return;
+
+		/*
+			Bounds are gathered before any controller is moved so the results
+			do not depend on the order controllers were queued in. This also
+			brings each node transform up to date before any jobs read it.
+		*/
+		for(uint32 i = 0; i < queuedCount; ++i)
+		{
+			sQueuedStep &step = m_queuedSteps[i];
+			step.targetPosition = step.sceneNode->GetUpdatedWorldTransformState().translation;
+			step.controller->GetSweptBounds(step.sceneNode, step.sweptBounds);
+		}
+
+		//group controllers by collision scene
+		std::stable_sort(m_queuedSteps.Pointer(), m_queuedSteps.Pointer() + queuedCount);
+
+		m_colliderNodes.Clear();
+		uint32 groupStart = 0;
+		while(groupStart < queuedCount)
+		{
+			MashSceneNode *collisionScene = m_queuedSteps[groupStart].collisionScene;
+			MashAABB groupBounds = m_queuedSteps[groupStart].sweptBounds;
+
+			uint32 groupEnd = groupStart + 1;
+			for(; (groupEnd < queuedCount) && (m_queuedSteps[groupEnd].collisionScene == collisionScene); ++groupEnd)
+				groupBounds.Merge(m_queuedSteps[groupEnd].sweptBounds);
+
+			//one walk of the scene for the whole group
+			const uint32 firstColliderNode = m_colliderNodes.Size();
+			if (collisionScene)
+				CMashEllipsoidColliderController::GetColliderNodes(collisionScene, groupBounds, m_colliderNodes);
+
+			for(uint32 i = groupStart; i < groupEnd; ++i)
+			{
+				m_queuedSteps[i].firstColliderNode = firstColliderNode;
+				m_queuedSteps[i].colliderNodeCount = m_colliderNodes.Size() - firstColliderNode;
+			}
+
+			groupStart = groupEnd;
+		}
+
+		const uint32 jobCount = math::Min<uint32>(math::Min<uint32>(jobs::GetHardwareThreadCount(), g_ellipsoidMaxJobs), 
+			queuedCount / g_ellipsoidMinStepsPerJob);
+
+		if (jobCount <= 1)
+		{
+			_MoveRange(0, queuedCount);
+		}
+		else
+		{
+			CMoveJob moveJobs[g_ellipsoidMaxJobs];
+			MashJob *jobList[g_ellipsoidMaxJobs];
+			const uint32 stepsPerJob = (queuedCount + jobCount - 1) / jobCount;
+			for(uint32 i = 0; i < jobCount; ++i)
+			{
+				moveJobs[i].manager = this;
+				moveJobs[i].first = math::Min<uint32>(i * stepsPerJob, queuedCount);
+				moveJobs[i].last = math::Min<uint32>(moveJobs[i].first + stepsPerJob, queuedCount);
+				jobList[i] = &moveJobs[i];
+			}
+
+			jobs::RunJobs(jobList, jobCount);
+		}
+
+		for(uint32 i = 0; i < queuedCount; ++i)
+			m_queuedSteps[i].sceneNode->SetPosition(m_queuedSteps[i].finalPosition);
+
+		for(uint32 i = 0; i < queuedCount; ++i)
+		{
+			m_queuedSteps[i].controller->Drop();
+			m_queuedSteps[i].sceneNode->Drop();
+		}
+
+		m_queuedSteps.Clear();
+	}
+
+	void CMashEllipsoidColliderManager::_MoveRange(uint32 first, uint32 last)
+	{
+		MashSceneNode * const *colliderNodes = m_colliderNodes.Pointer();
+		for(uint32 i = first; i < last; ++i)
+		{
+			sQueuedStep &step = m_queuedSteps[i];
+			step.finalPosition = step.controller->_MoveCached(step.sceneNode, 
+				step.targetPosition, 
+				step.sweptBounds, 
+				colliderNodes + step.firstColliderNode, 
+				step.colliderNodeCount);
+		}
+	}
+}
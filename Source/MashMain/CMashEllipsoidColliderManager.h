@@ -0,0 +1,67 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#ifndef _C_MASH_ELLIPSOID_COLLIDER_MANAGER_H_
+#define _C_MASH_ELLIPSOID_COLLIDER_MANAGER_H_
+
+#include "MashReferenceCounter.h"
+#include "MashAABB.h"
+#include "MashArray.h"
+
+namespace mash
+{
+	class MashSceneNode;
+	class CMashEllipsoidColliderController;
+
+	/*
+		Steps all ellipsoid controllers that use the triangle cache together.
+		Controllers queue themselves from their node callback, then once all
+		callbacks have been called the queue is processed. Controllers that share
+		a collision scene also share a single walk of that scene.
+
+		Moves are resolved before any node is moved. Node transforms are only
+		read while resolving, so large queues are split into jobs. The results
+		are then applied to the nodes in queue order.
+	*/
+	class CMashEllipsoidColliderManager : public MashReferenceCounter
+	{
+	private:
+		struct sQueuedStep
+		{
+			CMashEllipsoidColliderController *controller;
+			MashSceneNode *sceneNode;
+			MashSceneNode *collisionScene;
+			MashAABB sweptBounds;
+			MashVector3 targetPosition;
+			MashVector3 finalPosition;
+			//range within m_colliderNodes
+			uint32 firstColliderNode;
+			uint32 colliderNodeCount;
+
+			bool operator<(const sQueuedStep &other)const
+			{
+				return collisionScene < other.collisionScene;
+			}
+		};
+
+		class CMoveJob;
+
+		MashArray<sQueuedStep> m_queuedSteps;
+		MashArray<MashSceneNode*> m_colliderNodes;
+
+		void _MoveRange(uint32 first, uint32 last);
+	public:
+		CMashEllipsoidColliderManager();
+		~CMashEllipsoidColliderManager();
+
+		//Steps all queued controllers.
+		void Update();
+
+		//Called by controllers from their node callback.
+		void _QueueStep(CMashEllipsoidColliderController *controller, MashSceneNode *sceneNode);
+	};
+}
+
+#endif
@@ -84,6 +84,7 @@ namespace mash
 		}
 
 		pNewEntity->m_lodDistances = m_lodDistances;
+		pNewEntity->m_lodScreenSizes = m_lodScreenSizes;
         
         if (m_skin)
         {
@@ -147,6 +148,9 @@ namespace mash
 			m_lodDistances.Resize(lodCount, 0);
 		}
 
+		if (m_lodScreenSizes.Size() != lodCount)
+			m_lodScreenSizes.Resize(lodCount, 0.0f);
+
 		m_currentLod = 0;
 
 		if (model)
@@ -175,27 +179,67 @@ namespace mash
 
 	void CMashEntityEx::OnPassCullImpl(f32 interpolateAmount)
 	{
-		mash::MashVector3 cameraPosition = m_sceneManager->GetActiveCamera()->GetWorldTransformState().translation;
+		MashCamera *camera = m_sceneManager->GetActiveCamera();
+		mash::MashVector3 cameraPosition = camera->GetWorldTransformState().translation;
 
-		uint32 distanceFromCamera = (int32)collision::GetDistanceToAABB(cameraPosition, GetWorldBoundingBox());
+		const mash::MashAABB &worldBounds = GetWorldBoundingBox();
+		uint32 distanceFromCamera = (int32)collision::GetDistanceToAABB(cameraPosition, worldBounds);
 
 		//update mesh lod
 		uint32 lodCount = m_subEntityLodList.Size();
 		if (lodCount > 1)
 		{
 			m_currentLod = 0;
-			for(uint32 i = 0; i < lodCount; ++i)
+
+			bool useScreenSize = false;
+			for(uint32 i = 1; i < lodCount; ++i)
 			{
-				/*
-					The check for 0 is so that the first (best) lod is always used
-					if the distances have not been initialised.
-				*/
-				if ((distanceFromCamera > m_lodDistances[i]) && (m_lodDistances[i] != 0))
+				if (m_lodScreenSizes[i] != 0.0f)
 				{
-					m_currentLod = i;
+					useScreenSize = true;
 					break;
 				}
 			}
+
+			/*
+				Lods are searched from the lowest detail down so the furthest
+				lod the entity has passed is selected.
+			*/
+			if (useScreenSize)
+			{
+				const f32 radius = (worldBounds.max - worldBounds.min).Length() * 0.5f;
+				const f32 centerDistance = cameraPosition.GetDistanceTo(worldBounds.GetCenter());
+				const f32 halfHeight = centerDistance * tan(camera->GetFOV() * 0.5f);
+
+				//the first lod is used when the bounds fill the view
+				if (halfHeight > radius)
+				{
+					const f32 screenSize = radius / halfHeight;
+					for(uint32 i = lodCount - 1; i > 0; --i)
+					{
+						if ((m_lodScreenSizes[i] != 0.0f) && (screenSize < m_lodScreenSizes[i]))
+						{
+							m_currentLod = i;
+							break;
+						}
+					}
+				}
+			}
+			else
+			{
+				for(uint32 i = lodCount - 1; i > 0; --i)
+				{
+					/*
+						The check for 0 is so that the first (best) lod is always used
+						if the distances have not been initialised.
+					*/
+					if ((distanceFromCamera > m_lodDistances[i]) && (m_lodDistances[i] != 0))
+					{
+						m_currentLod = i;
+						break;
+					}
+				}
+			}
 		}
 
 		uint32 subEntityCount = m_subEntityLodList[m_currentLod].Size();
@@ -287,6 +331,43 @@ namespace mash
 		return aMASH_OK;
 	}
 
+	eMASH_STATUS CMashEntityEx::SetLodScreenSize(uint32 lod, f32 screenSize)
+	{
+		if (lod == 0)
+			return aMASH_OK;
+
+		if (m_lodScreenSizes.Empty())
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_WARNING, 
+					"The model given does not have any lods so a lod screen size could not be set.", 
+					"CMashEntityEx::SetLodScreenSize");
+
+			return aMASH_OK;
+		}
+
+		if (lod >= m_lodScreenSizes.Size())
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+					"Lod index is greater than the number of lods within the given model.", 
+					"CMashEntityEx::SetLodScreenSize");
+
+			return aMASH_FAILED;
+		}
+
+		if ((screenSize != 0.0f) && (m_lodScreenSizes[lod - 1] != 0.0f) && (m_lodScreenSizes[lod - 1] <= screenSize))
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+					"Lod screen sizes must be added in descending order.", 
+					"CMashEntityEx::SetLodScreenSize");
+
+			return aMASH_FAILED;
+		}
+
+		m_lodScreenSizes[lod] = screenSize;
+
+		return aMASH_OK;
+	}
+
 	const mash::MashTriangleCollider* CMashEntityEx::GetTriangleCollider()const
 	{
 		return m_model->GetTriangleCollider();
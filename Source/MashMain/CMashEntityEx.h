@@ -22,6 +22,7 @@ namespace mash
 
 		MashArray<MashArray<CMashSubEntity*> > m_subEntityLodList;
 		MashArray<uint32> m_lodDistances;
+		MashArray<f32> m_lodScreenSizes;
 		MashModel *m_model;
 		uint32 m_currentLod;
 
@@ -57,6 +58,8 @@ namespace mash
 		uint32 GetSubEntityCount(uint32 lod)const;
 		eMASH_STATUS SetLodDistance(uint32 lod, uint32 distance);
 		const MashArray<uint32>& GetLodDistances()const;
+		eMASH_STATUS SetLodScreenSize(uint32 lod, f32 screenSize);
+		const MashArray<f32>& GetLodScreenSizes()const;
 
 		MashSkin* GetSkin()const;
 		void SetSkin(MashSkin *skin);
@@ -75,6 +78,11 @@ namespace mash
 		return m_lodDistances;
 	}
 
+	inline const MashArray<f32>& CMashEntityEx::GetLodScreenSizes()const
+	{
+		return m_lodScreenSizes;
+	}
+
 	inline MashSkin* CMashEntityEx::GetSkin()const
 	{
 		return m_skin;
@@ -9,10 +9,8 @@
 #include "MashLog.h"
 namespace mash
 {
-	CMashInputManager::sPlayer::sPlayer():eventHelper()
+	CMashInputManager::sPlayer::sPlayer():currentContext(0), controller(-1), eventHelper(0)
 	{
-		currentContext = controllerMapMemory.end();
-		controller = -1;
 	}
 
 	CMashInputManager::sPlayer::~sPlayer()
@@ -36,9 +34,9 @@ namespace mash
 	void CMashInputManager::sPlayer::OnEvent(const sInputEvent &eventData)
 	{
 		//TODO : This 'if' can probably go. There should always be a current context
-		if (currentContext != controllerMapMemory.end())
+		if (currentContext)
 		{
-			sPlayerAction *playerAction = currentContext->second[eventData.action];
+			sPlayerAction *playerAction = (*currentContext)[eventData.action];
 
 			//only if an action has been set
 			if (playerAction)
@@ -72,11 +70,15 @@ namespace mash
 
 	void CMashInputManager::sPlayer::DeleteActionMap()
 	{
-		std::map<MashStringc, MashArray<sPlayerAction*> >::iterator actionListIter = contextActions.begin();
-		for(; actionListIter != contextActions.end(); ++actionListIter)
+		const uint32 contextSlotCount = contextActions.GetSlotCount();
+		for(uint32 i = 0; i < contextSlotCount; ++i)
 		{
-			MashArray<sPlayerAction*>::Iterator actionIter = actionListIter->second.Begin();
-			for(; actionIter != actionListIter->second.End(); ++actionIter)
+			if (!contextActions.IsSlotUsed(i))
+				continue;
+
+			MashArray<sPlayerAction*> &actionList = contextActions.GetSlotValue(i);
+			MashArray<sPlayerAction*>::Iterator actionIter = actionList.Begin();
+			for(; actionIter != actionList.End(); ++actionIter)
 			{
 				if (*actionIter)
 				{
@@ -86,18 +88,19 @@ namespace mash
 			}
 		}
 
-		contextActions.clear();
-		controllerMapMemory.clear();
-		currentContext = controllerMapMemory.end();
+		contextActions.Clear();
+		controllerMapMemory.Clear();
+		currentContext = 0;
+		currentContextID = MashStringID();
 	}
 
-	void CMashInputManager::sPlayer::SetActionCallback(const MashStringc &context, uint32 action, const MashEventFunctor &callback)
+	void CMashInputManager::sPlayer::SetActionCallback(const MashStringID &context, uint32 action, const MashEventFunctor &callback)
 	{
-		std::map<MashStringc, MashArray<sPlayerAction*> >::iterator actionListIter = contextActions.find(context);
-		if (actionListIter != contextActions.end())
+		MashArray<sPlayerAction*> *actionList = contextActions.Find(context);
+		if (actionList)
 		{
-			MashArray<sPlayerAction*>::Iterator actionIter = actionListIter->second.Begin();
-			for(; actionIter != actionListIter->second.End(); ++actionIter)
+			MashArray<sPlayerAction*>::Iterator actionIter = actionList->Begin();
+			for(; actionIter != actionList->End(); ++actionIter)
 			{
 				if ((*actionIter)->actionID == action)
 				{
@@ -112,43 +115,58 @@ namespace mash
 		Inserts the action and/or context if not found.
 	*/
 	//should be called SetActionKeys...
-	void CMashInputManager::sPlayer::SetKeyActions(const MashArray<eINPUT_EVENT> &keysForAction, const MashStringc &context, uint32 action, MashEventFunctor callback)
+	void CMashInputManager::sPlayer::SetKeyActions(const MashArray<eINPUT_EVENT> &keysForAction, const MashStringID &context, uint32 action, MashEventFunctor callback)
 	{
 		//first reset old values
 
 		/*
 			Create the context if it has not yet been created
 		*/
-		std::map<MashStringc, MashArray<sPlayerAction*> >::iterator actionListIter = contextActions.find(context);
-		if (actionListIter == contextActions.end())
-			actionListIter = contextActions.insert(std::make_pair(context, MashArray<sPlayerAction*>())).first;
+		MashArray<sPlayerAction*> *actionList = contextActions.Find(context);
+		if (!actionList)
+		{
+			contextActions.Insert(context, MashArray<sPlayerAction*>());
+			actionList = contextActions.Find(context);
+		}
+
+		//create the callback table for this context if needed
+		MashArray<sPlayerAction*> *callbackTable = controllerMapMemory.Find(context);
+		if (!callbackTable)
+		{
+			controllerMapMemory.Insert(context, MashArray<sPlayerAction*>(aKEYEVENT_SIZE, 0));
+			callbackTable = controllerMapMemory.Find(context);
+
+			//the insert may have moved the current context
+			if (currentContext)
+				currentContext = controllerMapMemory.Find(currentContextID);
+		}
 
 		/*
 			Loop through and find any actions previously created with the same ID.
 			If a match is found then we zero out any previous key data set.
 		*/
 		MashArray<eINPUT_EVENT>::Iterator key;
-		MashArray<sPlayerAction*>::Iterator actionIter = actionListIter->second.Begin();
-		for(; actionIter != actionListIter->second.End(); ++actionIter)
+		MashArray<sPlayerAction*>::Iterator actionIter = actionList->Begin();
+		for(; actionIter != actionList->End(); ++actionIter)
 		{
 			if ((*actionIter)->actionID == action)
 			{
 				key = (*actionIter)->keysForAction.Begin();
 				for(; key != (*actionIter)->keysForAction.End(); ++key)
 				{
-					controllerMapMemory[context][*key] = 0;
+					(*callbackTable)[*key] = 0;
 				}
 				break;
 			}
 		}
 
 		//if the action didnt exist before then create it now. Note the break in the previous loop.
-		if (actionIter == actionListIter->second.End())
+		if (actionIter == actionList->End())
 		{
 			sPlayerAction *newAction = MASH_NEW_T_COMMON(sPlayerAction);
 			newAction->actionID = action;
-			actionListIter->second.PushBack(newAction);
-			actionIter = actionListIter->second.End() - 1;
+			actionList->PushBack(newAction);
+			actionIter = actionList->End() - 1;
 		}
 
 		//set the new data
@@ -156,16 +174,18 @@ namespace mash
 		(*actionIter)->keysForAction = keysForAction;
 
 		//relink callbacks
-		actionListIter = controllerMapMemory.insert(std::make_pair(context, MashArray<sPlayerAction*>(aKEYEVENT_SIZE, 0))).first;
 		key = (*actionIter)->keysForAction.Begin();
 		for(; key != (*actionIter)->keysForAction.End(); ++key)
 		{
-			actionListIter->second[*key] = *actionIter;
+			(*callbackTable)[*key] = *actionIter;
 		}
 
 		//set default context if needed
-		if (currentContext == controllerMapMemory.end())
-			currentContext = actionListIter;
+		if (!currentContext)
+		{
+			currentContext = callbackTable;
+			currentContextID = context;
+		}
 	}
 
 	CMashInputManager::CMashInputManager():MashInputManager(), m_sendMouseXZeroMsg(false), m_sendMouseYZeroMsg(false),
@@ -346,7 +366,7 @@ namespace mash
 
 	int32 CMashInputManager::AddContextChangeCallback(uint32 playerId, const MashStringc &contextName, MashEventFunctor callback)
 	{
-		m_contextChangeCallbacks.PushBack(sContextChangeCallback(playerId, contextName, callback));
+		m_contextChangeCallbacks.PushBack(sContextChangeCallback(playerId, MashStringID(contextName), callback));
 		return m_contextChangeCallbacks.Back().han;
 	}
 
@@ -472,12 +492,13 @@ namespace mash
 		//check for key clashes from previously set actions
 
 		//We are only interested in a matching context. Clashes in other context are valid
-		std::map<MashStringc, MashArray<sPlayerAction*> >::iterator actionListIter = player->contextActions.find(context);
-		if (actionListIter != player->contextActions.end())
+		const MashStringID contextID(context);
+		MashArray<sPlayerAction*> *actionList = player->contextActions.Find(contextID);
+		if (actionList)
 		{
 			//for each action look at the keys set
-			MashArray<sPlayerAction*>::Iterator actionIter = actionListIter->second.Begin();
-			for(; actionIter != actionListIter->second.End(); ++actionIter)
+			MashArray<sPlayerAction*>::Iterator actionIter = actionList->Begin();
+			for(; actionIter != actionList->End(); ++actionIter)
 			{
 				//we dont need to check the same action if already set cause we are about to overwrite it
 				if ((*actionIter)->actionID != actionID)
@@ -504,8 +525,8 @@ namespace mash
 		//only set if there was no clashes.
 		if (m_lastKeyClashes.Empty())
 		{
-			player->SetKeyActions(keysForAction, context, actionID, callback);
-			SetCurrentPlayerContext(playerID, context);
+			player->SetKeyActions(keysForAction, contextID, actionID, callback);
+			SetCurrentPlayerContext(playerID, contextID);
 		}
 		else
 		{
@@ -588,6 +609,24 @@ namespace mash
 	}
 
 	eMASH_STATUS CMashInputManager::SetCurrentPlayerContext(uint32 playerID, const MashStringc &context)
+	{
+		MashStringID contextID;
+		if (!MashStringID::Find(context.GetCString(), contextID))
+		{
+			//the context cannot exist if its name was never interned
+			if (playerID < m_players.Size())
+			{
+				m_players[playerID]->currentContext = 0;
+				m_players[playerID]->currentContextID = MashStringID();
+			}
+
+			return aMASH_FAILED;
+		}
+
+		return SetCurrentPlayerContext(playerID, contextID);
+	}
+
+	eMASH_STATUS CMashInputManager::SetCurrentPlayerContext(uint32 playerID, const MashStringID &context)
 	{
 #ifdef MASH_DEBUG
 			if (playerID >= m_players.Size())
@@ -598,14 +637,15 @@ namespace mash
 #endif
 
 		sPlayer *player = m_players[playerID];
-		MashStringc oldContext;
+		MashStringID oldContext;
 		
 		//make sure last context is valid.
-		if (player->currentContext != player->controllerMapMemory.end())
-			oldContext = player->currentContext->first;
+		if (player->currentContext)
+			oldContext = player->currentContextID;
 
-		player->currentContext = player->controllerMapMemory.find(context);
-		if (player->currentContext != player->controllerMapMemory.end())
+		player->currentContext = player->controllerMapMemory.Find(context);
+		player->currentContextID = player->currentContext ? context : MashStringID();
+		if (player->currentContext)
 		{
 			const uint32 c = m_contextChangeCallbacks.Size();
 			for(uint32 i = 0; i < c; ++i)
@@ -651,7 +691,7 @@ namespace mash
 			}
 #endif
 
-		m_players[playerID]->SetActionCallback(context, actionID, callback);
+		m_players[playerID]->SetActionCallback(MashStringID(context), actionID, callback);
 	}
 
 	void CMashInputManager::CreateDefaultActionMap(uint32 playerID, const MashStringc &context, MashEventFunctor callback)
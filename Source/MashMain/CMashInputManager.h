@@ -10,7 +10,7 @@
 #include "MashVector2.h"
 #include "MashRectangle2.h"
 #include "MashTypes.h"
-#include <map>
+#include "MashStringIDMap.h"
 #include <bitset>
 namespace mash
 {
@@ -53,7 +53,7 @@ namespace mash
 				by the user. For example, under the context "play" you might
 				have the actions "move horizontal", "move vertical", etc...
 			*/
-			std::map<MashStringc, MashArray<sPlayerAction*> > contextActions;
+			MashStringIDMap<MashArray<sPlayerAction*> > contextActions;
 
 			/*
 				For each context, there is one pointer slot created for each
@@ -62,12 +62,14 @@ namespace mash
 				For example, the events 'A', 'D', 'LT', 'RT', may all point
 				back to the "move horizontal" action.
 			*/
-			std::map<MashStringc, MashArray<sPlayerAction*> > controllerMapMemory;
+			MashStringIDMap<MashArray<sPlayerAction*> > controllerMapMemory;
 
 			/*
-				Direct pointer for speed.
+				Direct pointer for speed. This points into controllerMapMemory
+				so it must be refreshed whenever a context is inserted.
 			*/
-			std::map<MashStringc, MashArray<sPlayerAction*> >::iterator currentContext;
+			MashArray<sPlayerAction*> *currentContext;
+			MashStringID currentContextID;
 
 			int32 controller;
 			sPlayerHelper *eventHelper;
@@ -77,12 +79,12 @@ namespace mash
 			void OnUpdateEventHelper();
 			void OnEvent(const sInputEvent &eventData);
 			void DeleteActionMap();
-			void SetActionCallback(const MashStringc &context, uint32 action, const MashEventFunctor &callback);
+			void SetActionCallback(const MashStringID &context, uint32 action, const MashEventFunctor &callback);
 			/*
 				Inserts the action and/or context if not found.
 			*/
 			//should be called SetActionKeys...
-			void SetKeyActions(const MashArray<eINPUT_EVENT> &keysForAction, const MashStringc &context, uint32 action, MashEventFunctor callback = MashEventFunctor());
+			void SetKeyActions(const MashArray<eINPUT_EVENT> &keysForAction, const MashStringID &context, uint32 action, MashEventFunctor callback = MashEventFunctor());
 		};
 
 		struct sController
@@ -115,10 +117,10 @@ namespace mash
 		{
 			MashEventFunctor contextCallback;
 			int32 han;
-			MashStringc contextName;
+			MashStringID contextName;
 			uint32 playerId;
 
-			sContextChangeCallback(uint32 pid, const MashStringc &name, MashEventFunctor _c):contextCallback(_c),
+			sContextChangeCallback(uint32 pid, const MashStringID &name, MashEventFunctor _c):contextCallback(_c),
 				contextName(name), playerId(pid)
 			{
 				static int32 nexthandle = 0;
@@ -173,6 +175,7 @@ namespace mash
 		uint32 GetControllerCount()const;
 
 		eMASH_STATUS SetCurrentPlayerContext(uint32 playerID, const MashStringc &context);
+		eMASH_STATUS SetCurrentPlayerContext(uint32 playerID, const MashStringID &context);
 
 		void CreateDefaultActionMap(uint32 playerID, const MashStringc &context, MashEventFunctor callback = MashEventFunctor());
 		void ResetPlayerAcionMap(uint32 playerID);
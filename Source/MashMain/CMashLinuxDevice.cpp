@@ -4,6 +4,7 @@
 // For license and distribution see Mash.h
 //-------------------------------------------------------------------------
 #include "CMashLinuxDevice.h"
+#include "CMashNullDevice.h"
 
 #include "MashCompileSettings.h"
 #ifdef MASH_LINUX
@@ -1380,6 +1381,9 @@ namespace mash
         if (settings.enableDeferredRender)
             settings.antiAliasType = aANTIALIAS_TYPE_NONE;
 
+        if (settings.headless)
+            return _CreateNullDevice(settings);
+
         CMashLinuxDevice *device = MASH_NEW_COMMON CMashLinuxDevice(settings.debugFilePath);
         if (device->Initialise(settings) == aMASH_FAILED)
         {
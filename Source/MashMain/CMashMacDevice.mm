@@ -5,6 +5,7 @@
 //-------------------------------------------------------------------------
 
 #include "CMashMacDevice.h"
+#include "CMashNullDevice.h"
 #ifdef MASH_APPLE
 
 #import "AppDelegate.h"
@@ -910,6 +911,9 @@ namespace mash
 		*/
 		if (settings.enableDeferredRender)
 			settings.antiAliasType = aANTIALIAS_TYPE_NONE;
+
+		if (settings.headless)
+			return _CreateNullDevice(settings);
         
 		CMashMacDevice *device = MASH_NEW_COMMON CMashMacDevice(settings.debugFilePath);
         
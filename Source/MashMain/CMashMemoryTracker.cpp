@@ -17,12 +17,20 @@ namespace mash
 
 	CMashMemoryTracker::CMashMemoryTracker():m_trackingEnabled(false)
 	{
-
+#ifdef MASH_WINDOWS
+		InitializeCriticalSection(&m_lock);
+#else
+		pthread_mutex_init(&m_lock, 0);
+#endif
 	}
 
 	CMashMemoryTracker::~CMashMemoryTracker()
 	{
-
+#ifdef MASH_WINDOWS
+		DeleteCriticalSection(&m_lock);
+#else
+		pthread_mutex_destroy(&m_lock);
+#endif
 	}
 
 	void CMashMemoryTracker::DestroyInstance()
@@ -56,7 +64,9 @@ namespace mash
 			newAlloc.iLineNumber = iLine;
 			newAlloc.sFunc = sFunc;
 
+			Lock();
 			m_allocations[p] = newAlloc;
+			Unlock();
 		}
 #endif
 	}
@@ -66,11 +76,13 @@ namespace mash
 #ifdef MASH_MEMORY_TRACKING_ENABLED
 		if (m_trackingEnabled)
 		{
+			Lock();
 			std::map<void*, sAllocation>::iterator iter = m_allocations.find(p);
 			if (iter != m_allocations.end())
 			{
 				m_allocations.erase(iter);
 			}
+			Unlock();
 		}
 #endif
 	}
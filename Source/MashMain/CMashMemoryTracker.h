@@ -12,6 +12,12 @@
 #include <string>
 #include "MashDataTypes.h"
 
+#ifdef MASH_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
 namespace mash
 {
 	class CMashMemoryTracker
@@ -34,6 +40,17 @@ namespace mash
 
 		bool m_trackingEnabled;
 		static CMashMemoryTracker *m_pInstance;
+
+		//allocations may come from worker threads
+#ifdef MASH_WINDOWS
+		CRITICAL_SECTION m_lock;
+		void Lock(){EnterCriticalSection(&m_lock);}
+		void Unlock(){LeaveCriticalSection(&m_lock);}
+#else
+		pthread_mutex_t m_lock;
+		void Lock(){pthread_mutex_lock(&m_lock);}
+		void Unlock(){pthread_mutex_unlock(&m_lock);}
+#endif
 		
 	protected:
 		CMashMemoryTracker();
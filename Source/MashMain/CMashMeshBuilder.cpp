@@ -11,12 +11,33 @@
 #include "MashVector3.h"
 #include "MashMatrix4.h"
 #include "MashAABB.h"
+#include "MashMathKernels.h"
 #include "MashQuaternion.h"
 #include "MashMesh.h"
 #include "MashSkin.h"
 #include "MashHelper.h"
+#include "MashModel.h"
+#include "MashDevice.h"
+#include "MashSceneManager.h"
+#include "MashStaticMesh.h"
+#include "CMashMeshSimplifier.h"
 namespace mash
 {
+	/*
+		Vertex cache optimisation based on Tom Forsyth's "Linear-Speed Vertex Cache Optimisation".
+	*/
+	static const uint32 g_vertexCacheSimSize = 32;
+	static const f32 g_vertexCacheDecayPower = 1.5f;
+	static const f32 g_vertexCacheLastTriScore = 0.75f;
+	static const f32 g_vertexCacheValenceBoostScale = 2.0f;
+	static const f32 g_vertexCacheValenceBoostPower = 0.5f;
+
+	//used to report before and after results
+	static const uint32 g_vertexCacheReportSize = 16;
+
+	//clusters smaller than this will not be split during overdraw optimisation
+	static const uint32 g_overdrawMinClusterSize = 32;
+
 	CMashMeshBuilder::CMashMeshBuilder(mash::MashVideo *pRenderDevice)
 	{
 		m_pRenderDevice = pRenderDevice;
@@ -445,14 +466,7 @@ namespace mash
 			}
 		}
 
-		for(uint32 i = 0; i < iVertexCount; ++i)
-		{
-			//get position data
-			mash::MashVector3 vPosition;
-			memcpy(vPosition.v, &pVertices[(i * iVertexSizeInBytes) + iPositionStride], sizeof(mash::MashVector3));
-
-			boundingBox.Add(vPosition);
-		}
+		kernels::ComputeBounds(&pVertices[iPositionStride], iVertexSizeInBytes, iVertexCount, boundingBox);
 
 		boundingBox.Repair();
 
@@ -511,8 +525,7 @@ namespace mash
 				normalsOut[index2] += normal;
 			}
 
-			for(uint32 i = 0; i < vertexCount; ++i)
-				normalsOut[i].Normalize();
+			kernels::NormalizeVectors(normalsOut.Pointer(), sizeof(mash::MashVector3), vertexCount);
 		}
 	}
 
@@ -560,8 +573,7 @@ namespace mash
 				newNormals[index2] += normal;
 			}
 
-			for(uint32 i = 0; i < vertexCount; ++i)
-				newNormals[i].Normalize();
+			kernels::NormalizeVectors(newNormals.Pointer(), sizeof(mash::MashVector3), vertexCount);
 			
 			for(uint32 i = 0; i < vertexCount; ++i)
 			{
@@ -643,9 +655,10 @@ namespace mash
 				mash::MashVector3 *normal = (mash::MashVector3*)&vertexData[(i * vertexStreamSize) + normalElmLocation];
 
 				newTangents[i] -= (*normal) * newTangents[i].Dot(*normal);
-				newTangents[i].Normalize();
 			}
 
+			kernels::NormalizeVectors(newTangents.Pointer(), sizeof(mash::MashVector3), vertexCount);
+
 			for(uint32 i = 0; i < vertexCount; ++i)
 			{
 				uint8 *data = (uint8*)&vertexData[(i * vertexStreamSize) + tangentElmLocation];
@@ -1096,6 +1109,51 @@ namespace mash
 			updateNeeded = true;
 		}
 
+		if ((flags & aMESH_UPDATE_OPTIMISE) && (mesh->primitiveType == aPRIMITIVE_TRIANGLE_LIST))
+		{
+			const uint32 vertexStride = toVertex->GetStreamSizeInBytes(0);
+
+			f32 acmrBefore, atvrBefore;
+			CalculateVertexCacheStats(generatedIndices.Pointer(), generatedIndices.Size(), generatedVertexCount, g_vertexCacheReportSize, acmrBefore, atvrBefore);
+
+			/*
+				Vertices are reordered so make sure we aren't writing
+				into the users data.
+			*/
+			if (!vertexDataGenerated)
+			{
+				uint8 *vertexCopy = (uint8*)MASH_ALLOC_COMMON(vertexStride * generatedVertexCount);
+				memcpy(vertexCopy, generatedVertices, vertexStride * generatedVertexCount);
+				generatedVertices = vertexCopy;
+				vertexDataGenerated = true;
+			}
+
+			if (generatedBoneWeights && generatedBoneIndices && !boneDataGenerated)
+			{
+				mash::MashVector4 *boneWeightCopy = MASH_ALLOC_T_COMMON(mash::MashVector4, generatedVertexCount);
+				mash::MashVector4 *boneIndexCopy = MASH_ALLOC_T_COMMON(mash::MashVector4, generatedVertexCount);
+				memcpy(boneWeightCopy, generatedBoneWeights, sizeof(mash::MashVector4) * generatedVertexCount);
+				memcpy(boneIndexCopy, generatedBoneIndices, sizeof(mash::MashVector4) * generatedVertexCount);
+				generatedBoneWeights = boneWeightCopy;
+				generatedBoneIndices = boneIndexCopy;
+				boneDataGenerated = true;
+			}
+
+			OptimiseVertexCache(generatedIndices, generatedVertexCount);
+			OptimiseOverdraw(generatedVertices, generatedVertexCount, toVertex, generatedIndices);
+			OptimiseVertexFetch(generatedVertices, generatedVertexCount, vertexStride, generatedBoneWeights, generatedBoneIndices, generatedIndices);
+
+			f32 acmrAfter, atvrAfter;
+			CalculateVertexCacheStats(generatedIndices.Pointer(), generatedIndices.Size(), generatedVertexCount, g_vertexCacheReportSize, acmrAfter, atvrAfter);
+
+			MASH_WRITE_TO_LOG_EX(MashLog::aERROR_LEVEL_INFORMATION, 
+				"CMashMeshBuilder::UpdateMesh",
+				"Mesh optimised. ACMR %.3f -> %.3f. ATVR %.3f -> %.3f.",
+				acmrBefore, acmrAfter, atvrBefore, atvrAfter);
+
+			updateNeeded = true;
+		}
+
 		/*
 			We convert the indices to 16bit if the flag is set, or if
 			the mesh was originally set to 16bit
@@ -1403,6 +1461,674 @@ namespace mash
 						"Vertex format conversion succeeded",
 						"CMashMeshBuilder::ChangeVertexFormat");
 
+		return aMASH_OK;
+	}
+	static f32 ForsythVertexScore(int32 cachePosition, uint32 remainingTriangles)
+	{
+		//this vertex has no more triangles to draw
+		if (remainingTriangles == 0)
+			return -1.0f;
+
+		f32 score = 0.0f;
+		if (cachePosition >= 0)
+		{
+			/*
+				Vertices used by the last triangle get a fixed score so that the
+				next triangle doesn't simply reuse the same edge.
+			*/
+			if (cachePosition < 3)
+			{
+				score = g_vertexCacheLastTriScore;
+			}
+			else
+			{
+				const f32 scaler = 1.0f / (f32)(g_vertexCacheSimSize - 3);
+				score = 1.0f - (f32)(cachePosition - 3) * scaler;
+				score = powf(score, g_vertexCacheDecayPower);
+			}
+		}
+
+		//boost vertices with few triangles left so lone triangles are not left till the end
+		score += g_vertexCacheValenceBoostScale * powf((f32)remainingTriangles, -g_vertexCacheValenceBoostPower);
+
+		return score;
+	}
+
+	void CMashMeshBuilder::CalculateVertexCacheStats(const uint32 *indices, 
+		uint32 indexCount, 
+		uint32 vertexCount, 
+		uint32 cacheSize, 
+		f32 &acmrOut, 
+		f32 &atvrOut)
+	{
+		acmrOut = 0.0f;
+		atvrOut = 0.0f;
+
+		const uint32 triangleCount = indexCount / 3;
+		if ((triangleCount == 0) || (vertexCount == 0) || (cacheSize == 0))
+			return;
+
+		//simulated FIFO cache. Each vertex stores the time it entered the cache.
+		MashArray<uint32> cacheTimeStamps(vertexCount, 0);
+		uint32 currentTime = cacheSize + 1;
+		uint32 cacheMisses = 0;
+		for(uint32 i = 0; i < (triangleCount * 3); ++i)
+		{
+			const uint32 index = indices[i];
+			if ((currentTime - cacheTimeStamps[index]) > cacheSize)
+			{
+				cacheTimeStamps[index] = currentTime++;
+				++cacheMisses;
+			}
+		}
+
+		acmrOut = (f32)cacheMisses / (f32)triangleCount;
+		atvrOut = (f32)cacheMisses / (f32)vertexCount;
+	}
+
+	eMASH_STATUS CMashMeshBuilder::CalculateVertexCacheStats(const MashMesh *mesh, uint32 cacheSize, f32 &acmrOut, f32 &atvrOut)const
+	{
+		acmrOut = 0.0f;
+		atvrOut = 0.0f;
+
+		if (!mesh || (mesh->GetPrimitiveType() != aPRIMITIVE_TRIANGLE_LIST))
+			return aMASH_FAILED;
+
+		MashArray<uint32> indices;
+		GenerateIndicesIfNeeded((const uint8*)mesh->GetRawIndices().Pointer(),
+			mesh->GetIndexCount(),
+			mesh->GetIndexFormat(),
+			mesh->GetVertexCount(),
+			indices);
+
+		if (indices.Empty())
+			return aMASH_FAILED;
+
+		CalculateVertexCacheStats(indices.Pointer(), indices.Size(), mesh->GetVertexCount(), cacheSize, acmrOut, atvrOut);
+		return aMASH_OK;
+	}
+
+	void CMashMeshBuilder::OptimiseVertexCache(MashArray<uint32> &indices, uint32 vertexCount)const
+	{
+		const uint32 triangleCount = indices.Size() / 3;
+		if ((triangleCount == 0) || (vertexCount == 0))
+			return;
+
+		struct sVertexCacheData
+		{
+			int32 cachePosition;
+			f32 score;
+			uint32 remainingTriangles;
+			uint32 triangleListStart;
+		};
+
+		sVertexCacheData *vertexData = MASH_ALLOC_T_COMMON(sVertexCacheData, vertexCount);
+		for(uint32 i = 0; i < vertexCount; ++i)
+		{
+			vertexData[i].cachePosition = -1;
+			vertexData[i].score = 0.0f;
+			vertexData[i].remainingTriangles = 0;
+			vertexData[i].triangleListStart = 0;
+		}
+
+		for(uint32 i = 0; i < (triangleCount * 3); ++i)
+			++vertexData[indices[i]].remainingTriangles;
+
+		//build a flat vertex to triangle adjacency list
+		uint32 runningTotal = 0;
+		for(uint32 i = 0; i < vertexCount; ++i)
+		{
+			vertexData[i].triangleListStart = runningTotal;
+			runningTotal += vertexData[i].remainingTriangles;
+			vertexData[i].score = ForsythVertexScore(-1, vertexData[i].remainingTriangles);
+		}
+
+		uint32 *vertexTriangles = MASH_ALLOC_T_COMMON(uint32, triangleCount * 3);
+		uint32 *vertexTriangleFill = MASH_ALLOC_T_COMMON(uint32, vertexCount);
+		memset(vertexTriangleFill, 0, sizeof(uint32) * vertexCount);
+		for(uint32 tri = 0; tri < triangleCount; ++tri)
+		{
+			for(uint32 v = 0; v < 3; ++v)
+			{
+				const uint32 index = indices[(tri * 3) + v];
+				vertexTriangles[vertexData[index].triangleListStart + vertexTriangleFill[index]++] = tri;
+			}
+		}
+
+		MASH_FREE(vertexTriangleFill);
+
+		f32 *triangleScores = MASH_ALLOC_T_COMMON(f32, triangleCount);
+		bool *triangleEmitted = MASH_ALLOC_T_COMMON(bool, triangleCount);
+		for(uint32 tri = 0; tri < triangleCount; ++tri)
+		{
+			triangleEmitted[tri] = false;
+			triangleScores[tri] = vertexData[indices[tri * 3]].score + 
+				vertexData[indices[(tri * 3) + 1]].score + 
+				vertexData[indices[(tri * 3) + 2]].score;
+		}
+
+		MashArray<uint32> newIndices;
+		newIndices.Reserve(triangleCount * 3);
+
+		//the cache holds 3 extra entries for the vertices pushed out by the newest triangle
+		uint32 cache[g_vertexCacheSimSize + 3];
+		uint32 newCache[g_vertexCacheSimSize + 3];
+		uint32 cacheCount = 0;
+
+		uint32 bestTriangle = mash::math::MaxUInt32();
+		f32 bestScore = -1.0f;
+		uint32 nextUnemittedTriangle = 0;
+
+		for(uint32 emitted = 0; emitted < triangleCount; ++emitted)
+		{
+			/*
+				If the cache didn't supply a triangle then grab the next one available. Scanning
+				the whole list for the best score here is quadratic and rarely worth it.
+			*/
+			if (bestTriangle == mash::math::MaxUInt32())
+			{
+				while(triangleEmitted[nextUnemittedTriangle])
+					++nextUnemittedTriangle;
+
+				bestTriangle = nextUnemittedTriangle;
+			}
+
+			triangleEmitted[bestTriangle] = true;
+
+			uint32 newCacheCount = 0;
+			for(uint32 v = 0; v < 3; ++v)
+			{
+				const uint32 index = indices[(bestTriangle * 3) + v];
+				newIndices.PushBack(index);
+
+				//remove this triangle from the vertex adjacency list
+				sVertexCacheData &vertex = vertexData[index];
+				uint32 *triangleList = &vertexTriangles[vertex.triangleListStart];
+				for(uint32 t = 0; t < vertex.remainingTriangles; ++t)
+				{
+					if (triangleList[t] == bestTriangle)
+					{
+						triangleList[t] = triangleList[vertex.remainingTriangles - 1];
+						break;
+					}
+				}
+
+				--vertex.remainingTriangles;
+				newCache[newCacheCount++] = index;
+			}
+
+			//append the old cache entries that were not used by this triangle
+			for(uint32 c = 0; c < cacheCount; ++c)
+			{
+				const uint32 index = cache[c];
+				if ((index != newCache[0]) && (index != newCache[1]) && (index != newCache[2]))
+					newCache[newCacheCount++] = index;
+			}
+
+			cacheCount = newCacheCount;
+			for(uint32 c = 0; c < cacheCount; ++c)
+			{
+				cache[c] = newCache[c];
+
+				sVertexCacheData &vertex = vertexData[cache[c]];
+				vertex.cachePosition = (c < g_vertexCacheSimSize) ? (int32)c : -1;
+				vertex.score = ForsythVertexScore(vertex.cachePosition, vertex.remainingTriangles);
+			}
+
+			//update the triangles affected by the cache change and find the next best triangle
+			bestTriangle = mash::math::MaxUInt32();
+			bestScore = -1.0f;
+			for(uint32 c = 0; c < cacheCount; ++c)
+			{
+				const sVertexCacheData &vertex = vertexData[cache[c]];
+				const uint32 *triangleList = &vertexTriangles[vertex.triangleListStart];
+				for(uint32 t = 0; t < vertex.remainingTriangles; ++t)
+				{
+					const uint32 tri = triangleList[t];
+					const f32 score = vertexData[indices[tri * 3]].score + 
+						vertexData[indices[(tri * 3) + 1]].score + 
+						vertexData[indices[(tri * 3) + 2]].score;
+
+					triangleScores[tri] = score;
+					if (score > bestScore)
+					{
+						bestScore = score;
+						bestTriangle = tri;
+					}
+				}
+			}
+
+			//vertices pushed out of the cache are no longer tracked
+			if (cacheCount > g_vertexCacheSimSize)
+				cacheCount = g_vertexCacheSimSize;
+		}
+
+		indices = newIndices;
+
+		MASH_FREE(triangleEmitted);
+		MASH_FREE(triangleScores);
+		MASH_FREE(vertexTriangles);
+		MASH_FREE(vertexData);
+	}
+
+	void CMashMeshBuilder::OptimiseOverdraw(const uint8 *vertices, 
+		uint32 vertexCount,
+		const MashVertex *vertex,
+		MashArray<uint32> &indices)const
+	{
+		/*
+			Based on "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw" by Sander,
+			Nehab and Barczak. The cache optimised list is split into clusters at cache flush points.
+			Clusters facing away from the mesh centre are drawn first so they occlude the rest.
+		*/
+		const uint32 triangleCount = indices.Size() / 3;
+		if (triangleCount < (g_overdrawMinClusterSize * 2))
+			return;
+
+		uint32 positionLocation = 0;
+		uint32 positionSize = 0;
+		if (!GetVertexElementData(vertex, aDECLUSAGE_POSITION, sizeof(mash::MashVector3), positionLocation, positionSize))
+			return;
+
+		const uint32 vertexStride = vertex->GetStreamSizeInBytes(0);
+
+		struct sCluster
+		{
+			uint32 start;
+			uint32 triangleCount;
+			f32 sortKey;
+
+			bool operator<(const sCluster &other)const
+			{
+				return sortKey > other.sortKey;
+			}
+		};
+
+		//split the list wherever a triangle misses on all 3 vertices
+		MashArray<sCluster> clusters;
+		MashArray<uint32> cacheTimeStamps(vertexCount, 0);
+		uint32 currentTime = g_vertexCacheReportSize + 1;
+		sCluster currentCluster;
+		currentCluster.start = 0;
+		currentCluster.triangleCount = 0;
+		currentCluster.sortKey = 0.0f;
+		for(uint32 tri = 0; tri < triangleCount; ++tri)
+		{
+			uint32 misses = 0;
+			for(uint32 v = 0; v < 3; ++v)
+			{
+				const uint32 index = indices[(tri * 3) + v];
+				if ((currentTime - cacheTimeStamps[index]) > g_vertexCacheReportSize)
+				{
+					cacheTimeStamps[index] = currentTime++;
+					++misses;
+				}
+			}
+
+			if ((misses == 3) && (currentCluster.triangleCount >= g_overdrawMinClusterSize))
+			{
+				clusters.PushBack(currentCluster);
+				currentCluster.start = tri;
+				currentCluster.triangleCount = 0;
+			}
+
+			++currentCluster.triangleCount;
+		}
+
+		clusters.PushBack(currentCluster);
+
+		if (clusters.Size() < 2)
+			return;
+
+		mash::MashVector3 meshCentre(0.0f, 0.0f, 0.0f);
+		for(uint32 i = 0; i < vertexCount; ++i)
+		{
+			mash::MashVector3 position(0.0f, 0.0f, 0.0f);
+			memcpy(position.v, &vertices[(i * vertexStride) + positionLocation], positionSize);
+			meshCentre += position;
+		}
+
+		meshCentre /= (f32)vertexCount;
+
+		const uint32 clusterCount = clusters.Size();
+		for(uint32 c = 0; c < clusterCount; ++c)
+		{
+			mash::MashVector3 clusterCentre(0.0f, 0.0f, 0.0f);
+			mash::MashVector3 clusterNormal(0.0f, 0.0f, 0.0f);
+			f32 clusterArea = 0.0f;
+
+			const uint32 end = clusters[c].start + clusters[c].triangleCount;
+			for(uint32 tri = clusters[c].start; tri < end; ++tri)
+			{
+				mash::MashVector3 p[3];
+				for(uint32 v = 0; v < 3; ++v)
+				{
+					p[v].Zero();
+					memcpy(p[v].v, &vertices[(indices[(tri * 3) + v] * vertexStride) + positionLocation], positionSize);
+				}
+
+				//the cross product length is twice the triangle area so it weights everything by area
+				mash::MashVector3 normal = (p[1] - p[0]).Cross(p[2] - p[0]);
+				const f32 area = normal.Length();
+				clusterNormal += normal;
+				clusterCentre += ((p[0] + p[1] + p[2]) / 3.0f) * area;
+				clusterArea += area;
+			}
+
+			if (clusterArea > 0.0f)
+				clusterCentre /= clusterArea;
+
+			clusterNormal.Normalize();
+			clusters[c].sortKey = (clusterCentre - meshCentre).Dot(clusterNormal);
+		}
+
+		//stable so clusters with equal keys keep their cache friendly order
+		std::stable_sort(clusters.Pointer(), clusters.Pointer() + clusters.Size());
+
+		MashArray<uint32> newIndices;
+		newIndices.Reserve(triangleCount * 3);
+		for(uint32 c = 0; c < clusterCount; ++c)
+			newIndices.Append(&indices[clusters[c].start * 3], clusters[c].triangleCount * 3);
+
+		indices = newIndices;
+	}
+
+	void CMashMeshBuilder::OptimiseVertexFetch(uint8 *vertices,
+		uint32 vertexCount,
+		uint32 vertexStride,
+		mash::MashVector4 *boneWeights,
+		mash::MashVector4 *boneIndices,
+		MashArray<uint32> &indices)const
+	{
+		/*
+			Vertices are reordered in the order they are first referenced
+			by the index buffer so that memory is fetched linearly.
+		*/
+		MashArray<uint32> remap(vertexCount, mash::math::MaxUInt32());
+		uint32 nextVertex = 0;
+		const uint32 indexCount = indices.Size();
+		for(uint32 i = 0; i < indexCount; ++i)
+		{
+			uint32 &newIndex = remap[indices[i]];
+			if (newIndex == mash::math::MaxUInt32())
+				newIndex = nextVertex++;
+
+			indices[i] = newIndex;
+		}
+
+		//unreferenced vertices are kept at the end of the buffer
+		for(uint32 i = 0; i < vertexCount; ++i)
+		{
+			if (remap[i] == mash::math::MaxUInt32())
+				remap[i] = nextVertex++;
+		}
+
+		uint8 *vertexCopy = (uint8*)MASH_ALLOC_COMMON(vertexStride * vertexCount);
+		memcpy(vertexCopy, vertices, vertexStride * vertexCount);
+		for(uint32 i = 0; i < vertexCount; ++i)
+			memcpy(&vertices[remap[i] * vertexStride], &vertexCopy[i * vertexStride], vertexStride);
+
+		MASH_FREE(vertexCopy);
+
+		if (boneWeights && boneIndices)
+		{
+			mash::MashVector4 *boneCopy = MASH_ALLOC_T_COMMON(mash::MashVector4, vertexCount);
+
+			memcpy(boneCopy, boneWeights, sizeof(mash::MashVector4) * vertexCount);
+			for(uint32 i = 0; i < vertexCount; ++i)
+				boneWeights[remap[i]] = boneCopy[i];
+
+			memcpy(boneCopy, boneIndices, sizeof(mash::MashVector4) * vertexCount);
+			for(uint32 i = 0; i < vertexCount; ++i)
+				boneIndices[remap[i]] = boneCopy[i];
+
+			MASH_FREE(boneCopy);
+		}
+	}
+	eMASH_STATUS CMashMeshBuilder::SimplifyMesh(MashMesh *destinationMesh, 
+			const MashMesh *sourceMesh, 
+			f32 triangleRatio, 
+			f32 maxError, 
+			f32 *errorOut)const
+	{
+		if (errorOut)
+			*errorOut = 0.0f;
+
+		if (!destinationMesh || !sourceMesh || (destinationMesh == sourceMesh))
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+				"Invalid source or destination mesh.", 
+				"CMashMeshBuilder::SimplifyMesh");
+
+			return aMASH_FAILED;
+		}
+
+		if (sourceMesh->GetPrimitiveType() != aPRIMITIVE_TRIANGLE_LIST)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+				"Only triangle lists can be simplified.", 
+				"CMashMeshBuilder::SimplifyMesh");
+
+			return aMASH_FAILED;
+		}
+
+		const MashVertex *vertexDecl = sourceMesh->GetVertexDeclaration();
+		const uint8 *sourceVertices = (const uint8*)sourceMesh->GetRawVertices().Pointer();
+		const uint32 sourceVertexCount = sourceMesh->GetVertexCount();
+		if (!vertexDecl || !sourceVertices || (sourceVertexCount == 0))
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+				"Source mesh has no initialise data. Make sure the meshes initialise data is saved.", 
+				"CMashMeshBuilder::SimplifyMesh");
+
+			return aMASH_FAILED;
+		}
+
+		CMashMeshSimplifier::sInput input;
+		input.vertices = sourceVertices;
+		input.vertexCount = sourceVertexCount;
+		input.vertexStride = vertexDecl->GetStreamSizeInBytes(0);
+
+		if (!GetVertexElementData(vertexDecl, aDECLUSAGE_POSITION, sizeof(mash::MashVector3), input.positionLocation, input.positionSize))
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+				"Source mesh vertices contain no positions.", 
+				"CMashMeshBuilder::SimplifyMesh");
+
+			return aMASH_FAILED;
+		}
+
+		if (!GetVertexElementData(vertexDecl, aDECLUSAGE_NORMAL, sizeof(mash::MashVector3), input.normalLocation, input.normalSize))
+			input.normalSize = 0;
+
+		input.boneWeights = sourceMesh->GetBoneWeights();
+		input.boneIndices = sourceMesh->GetBoneIndices();
+
+		MashArray<uint32> sourceIndices;
+		GenerateIndicesIfNeeded((const uint8*)sourceMesh->GetRawIndices().Pointer(),
+			sourceMesh->GetIndexCount(),
+			sourceMesh->GetIndexFormat(),
+			sourceVertexCount,
+			sourceIndices);
+
+		input.indices = sourceIndices.Pointer();
+		input.indexCount = sourceIndices.Size();
+
+		triangleRatio = math::Clamp<f32>(0.0f, 1.0f, triangleRatio);
+		const uint32 targetIndexCount = ((uint32)((input.indexCount / 3) * triangleRatio)) * 3;
+
+		MashArray<uint32> simplifiedIndices;
+		const f32 error = CMashMeshSimplifier::Simplify(input, targetIndexCount, maxError, simplifiedIndices);
+
+		if (simplifiedIndices.Empty())
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+				"Mesh was simplified to zero triangles.", 
+				"CMashMeshBuilder::SimplifyMesh");
+
+			return aMASH_FAILED;
+		}
+
+		/*
+			Compact the vertices so only those still referenced are kept.
+			The order of the remaining vertices is maintained.
+		*/
+		const uint32 notUsed = mash::math::MaxUInt32();
+		MashArray<uint32> vertexRemap(sourceVertexCount, notUsed);
+		const uint32 simplifiedIndexCount = simplifiedIndices.Size();
+		for(uint32 i = 0; i < simplifiedIndexCount; ++i)
+			vertexRemap[simplifiedIndices[i]] = 0;
+
+		uint32 newVertexCount = 0;
+		for(uint32 i = 0; i < sourceVertexCount; ++i)
+		{
+			if (vertexRemap[i] != notUsed)
+				vertexRemap[i] = newVertexCount++;
+		}
+
+		const uint32 vertexStride = input.vertexStride;
+		uint8 *newVertices = MASH_ALLOC_T_COMMON(uint8, newVertexCount * vertexStride);
+		mash::MashVector4 *newBoneWeights = 0;
+		mash::MashVector4 *newBoneIndices = 0;
+		if (input.boneWeights && input.boneIndices)
+		{
+			newBoneWeights = MASH_ALLOC_T_COMMON(mash::MashVector4, newVertexCount);
+			newBoneIndices = MASH_ALLOC_T_COMMON(mash::MashVector4, newVertexCount);
+		}
+
+		for(uint32 i = 0; i < sourceVertexCount; ++i)
+		{
+			const uint32 newIndex = vertexRemap[i];
+			if (newIndex == notUsed)
+				continue;
+
+			memcpy(&newVertices[newIndex * vertexStride], &sourceVertices[i * vertexStride], vertexStride);
+
+			if (newBoneWeights)
+			{
+				newBoneWeights[newIndex] = input.boneWeights[i];
+				newBoneIndices[newIndex] = input.boneIndices[i];
+			}
+		}
+
+		for(uint32 i = 0; i < simplifiedIndexCount; ++i)
+			simplifiedIndices[i] = vertexRemap[simplifiedIndices[i]];
+
+		//keep 16 bit indices if the source used them
+		eFORMAT indexFormat = aFORMAT_R32_UINT;
+		MashArray<uint16> indices16;
+		const void *newIndices = simplifiedIndices.Pointer();
+		if (sourceMesh->GetIndexFormat() == aFORMAT_R16_UINT)
+		{
+			indexFormat = aFORMAT_R16_UINT;
+			indices16.Resize(simplifiedIndexCount);
+			for(uint32 i = 0; i < simplifiedIndexCount; ++i)
+				indices16[i] = (uint16)simplifiedIndices[i];
+
+			newIndices = indices16.Pointer();
+		}
+
+		eMASH_STATUS status = destinationMesh->SetGeometry(newVertices, 
+			newVertexCount, 
+			vertexDecl, 
+			newIndices, 
+			simplifiedIndexCount, 
+			indexFormat, 
+			aPRIMITIVE_TRIANGLE_LIST, 
+			simplifiedIndexCount / 3, 
+			false);
+
+		if (status == aMASH_OK)
+		{
+			//the lod should cull with the same bounds as the source
+			destinationMesh->SetBoundingBox(sourceMesh->GetBoundingBox());
+			destinationMesh->SetSaveInitialiseDataFlags(sourceMesh->GetSaveInitialiseDataFlags());
+
+			if (newBoneWeights)
+			{
+				destinationMesh->SetBoneWeights(newBoneWeights, newVertexCount);
+				destinationMesh->SetBoneIndices(newBoneIndices, newVertexCount);
+			}
+
+			if (errorOut)
+				*errorOut = error;
+		}
+		else
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+				"Failed to set simplified geometry.", 
+				"CMashMeshBuilder::SimplifyMesh");
+		}
+
+		MASH_FREE(newVertices);
+
+		if (newBoneWeights)
+		{
+			MASH_FREE(newBoneWeights);
+			MASH_FREE(newBoneIndices);
+		}
+
+		return status;
+	}
+
+	eMASH_STATUS CMashMeshBuilder::GenerateLods(MashModel *model, 
+			uint32 lodCount, 
+			f32 triangleRatioPerLod, 
+			f32 maxError)const
+	{
+		if (!model || (model->GetLodCount() == 0))
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+				"Model must contain at least one lod.", 
+				"CMashMeshBuilder::GenerateLods");
+
+			return aMASH_FAILED;
+		}
+
+		if ((triangleRatioPerLod <= 0.0f) || (triangleRatioPerLod >= 1.0f))
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+				"Triangle ratio per lod must be between 0 and 1.", 
+				"CMashMeshBuilder::GenerateLods");
+
+			return aMASH_FAILED;
+		}
+
+		MashSceneManager *sceneManager = MashDevice::StaticDevice->GetSceneManager();
+		const uint32 meshCount = model->GetMeshCount(0);
+		MashArray<MashMesh*> lodMeshes(meshCount, 0);
+
+		f32 triangleRatio = 1.0f;
+		for(uint32 lod = 0; lod < lodCount; ++lod)
+		{
+			triangleRatio *= triangleRatioPerLod;
+
+			for(uint32 i = 0; i < meshCount; ++i)
+			{
+				lodMeshes[i] = sceneManager->CreateStaticMesh();
+				if (SimplifyMesh(lodMeshes[i], model->GetMesh(i, 0), triangleRatio, maxError) == aMASH_FAILED)
+				{
+					for(uint32 j = 0; j <= i; ++j)
+						lodMeshes[j]->Drop();
+
+					MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+						"Failed to simplify lod mesh.", 
+						"CMashMeshBuilder::GenerateLods");
+
+					return aMASH_FAILED;
+				}
+			}
+
+			eMASH_STATUS status = model->Append(lodMeshes.Pointer(), meshCount);
+
+			//the model holds its own reference
+			for(uint32 i = 0; i < meshCount; ++i)
+				lodMeshes[i]->Drop();
+
+			if (status == aMASH_FAILED)
+				return aMASH_FAILED;
+		}
+
 		return aMASH_OK;
 	}
 }
\ No newline at end of file
@@ -104,6 +104,27 @@ namespace mash
 			uint32 &flagsOut,
 			uint8 **generatedVertices)const;
 
+		void OptimiseVertexCache(MashArray<uint32> &indices, uint32 vertexCount)const;
+
+		void OptimiseOverdraw(const uint8 *vertices, 
+			uint32 vertexCount,
+			const MashVertex *vertex,
+			MashArray<uint32> &indices)const;
+
+		void OptimiseVertexFetch(uint8 *vertices,
+			uint32 vertexCount,
+			uint32 vertexStride,
+			mash::MashVector4 *boneWeights,
+			mash::MashVector4 *boneIndices,
+			MashArray<uint32> &indices)const;
+
+		static void CalculateVertexCacheStats(const uint32 *indices, 
+			uint32 indexCount, 
+			uint32 vertexCount, 
+			uint32 cacheSize, 
+			f32 &acmrOut, 
+			f32 &atvrOut);
+
 		static uint32 PositionHashingFunction(const mash::MashVector3 &item);
 		static uint32 MeshConvHashingFunction(const MashVertexMeshConversion::sMashVertexMeshConversion &item);
 
@@ -154,6 +175,19 @@ namespace mash
 			const void *pVertexList,
 			uint32 iVertexCount,
 			mash::MashAABB &boundingBox)const;
+
+		eMASH_STATUS CalculateVertexCacheStats(const MashMesh *mesh, uint32 cacheSize, f32 &acmrOut, f32 &atvrOut)const;
+
+		eMASH_STATUS SimplifyMesh(MashMesh *destinationMesh, 
+			const MashMesh *sourceMesh, 
+			f32 triangleRatio, 
+			f32 maxError = mash::math::MaxFloat(), 
+			f32 *errorOut = 0)const;
+
+		eMASH_STATUS GenerateLods(MashModel *model, 
+			uint32 lodCount, 
+			f32 triangleRatioPerLod = 0.5f, 
+			f32 maxError = mash::math::MaxFloat())const;
 	};
 }
 
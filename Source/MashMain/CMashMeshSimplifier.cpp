@@ -0,0 +1,426 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#include "CMashMeshSimplifier.h"
+#include "MashMathHelper.h"
+#include "MashMemory.h"
+#include <algorithm>
+#include <cstring>
+
+namespace mash
+{
+	/*
+		Collapses between vertices whose normals are further apart than
+		this will not be performed.
+	*/
+	static const f32 g_simplifyMinNormalDot = 0.0f;
+
+	void CMashMeshSimplifier::sQuadric::AddPlane(f64 a, f64 b, f64 c, f64 d)
+	{
+		a2 += a * a; ab += a * b; ac += a * c; ad += a * d;
+		b2 += b * b; bc += b * c; bd += b * d;
+		c2 += c * c; cd += c * d;
+		d2 += d * d;
+	}
+
+	void CMashMeshSimplifier::sQuadric::Add(const sQuadric &other)
+	{
+		a2 += other.a2; ab += other.ab; ac += other.ac; ad += other.ad;
+		b2 += other.b2; bc += other.bc; bd += other.bd;
+		c2 += other.c2; cd += other.cd;
+		d2 += other.d2;
+	}
+
+	f64 CMashMeshSimplifier::sQuadric::Evaluate(const mash::MashVector3 &p)const
+	{
+		const f64 x = p.x;
+		const f64 y = p.y;
+		const f64 z = p.z;
+
+		//v^T * Q * v
+		const f64 result = (a2 * x * x) + (2.0 * ab * x * y) + (2.0 * ac * x * z) + (2.0 * ad * x) +
+			(b2 * y * y) + (2.0 * bc * y * z) + (2.0 * bd * y) +
+			(c2 * z * z) + (2.0 * cd * z) +
+			d2;
+
+		//rounding can produce small negative values
+		return (result > 0.0) ? result : 0.0;
+	}
+
+	void CMashMeshSimplifier::GetPosition(const sInput &input, uint32 vertex, mash::MashVector3 &out)
+	{
+		out.Zero();
+		memcpy(out.v, &input.vertices[(vertex * input.vertexStride) + input.positionLocation], input.positionSize);
+	}
+
+	void CMashMeshSimplifier::GetNormal(const sInput &input, uint32 vertex, mash::MashVector3 &out)
+	{
+		out.Zero();
+		if (input.normalSize > 0)
+			memcpy(out.v, &input.vertices[(vertex * input.vertexStride) + input.normalLocation], input.normalSize);
+	}
+
+	uint32 CMashMeshSimplifier::GetDominantBone(const sInput &input, uint32 vertex)
+	{
+		const mash::MashVector4 &weights = input.boneWeights[vertex];
+		uint32 dominant = 0;
+		for(uint32 i = 1; i < 4; ++i)
+		{
+			if (weights.v[i] > weights.v[dominant])
+				dominant = i;
+		}
+
+		return (uint32)input.boneIndices[vertex].v[dominant];
+	}
+
+	void CMashMeshSimplifier::LockSeamAndBorderVertices(const sInput &input, MashArray<bool> &lockedOut)
+	{
+		lockedOut.Resize(input.vertexCount, false);
+
+		/*
+			Sort the vertices by position so vertices that share a position are
+			next to each other. These are split vertices (uv seams, hard edges).
+		*/
+		struct sPositionSort
+		{
+			const sInput *input;
+
+			bool operator()(uint32 a, uint32 b)const
+			{
+				mash::MashVector3 pa, pb;
+				CMashMeshSimplifier::GetPosition(*input, a, pa);
+				CMashMeshSimplifier::GetPosition(*input, b, pb);
+				if (pa.x != pb.x)
+					return pa.x < pb.x;
+				if (pa.y != pb.y)
+					return pa.y < pb.y;
+				return pa.z < pb.z;
+			}
+		};
+
+		MashArray<uint32> sortedVertices(input.vertexCount, 0);
+		for(uint32 i = 0; i < input.vertexCount; ++i)
+			sortedVertices[i] = i;
+
+		sPositionSort positionSort;
+		positionSort.input = &input;
+		std::sort(sortedVertices.Pointer(), sortedVertices.Pointer() + sortedVertices.Size(), positionSort);
+
+		for(uint32 i = 1; i < input.vertexCount; ++i)
+		{
+			mash::MashVector3 a, b;
+			GetPosition(input, sortedVertices[i - 1], a);
+			GetPosition(input, sortedVertices[i], b);
+			if (a == b)
+			{
+				lockedOut[sortedVertices[i - 1]] = true;
+				lockedOut[sortedVertices[i]] = true;
+			}
+		}
+
+		/*
+			An edge used by only one triangle is a border edge. Edges are
+			stored with the smaller index first so both directions match.
+		*/
+		struct sEdge
+		{
+			uint32 a;
+			uint32 b;
+
+			bool operator<(const sEdge &other)const
+			{
+				return (a != other.a) ? (a < other.a) : (b < other.b);
+			}
+
+			bool operator==(const sEdge &other)const
+			{
+				return (a == other.a) && (b == other.b);
+			}
+		};
+
+		const uint32 triangleCount = input.indexCount / 3;
+		MashArray<sEdge> edges;
+		edges.Reserve(triangleCount * 3);
+		for(uint32 tri = 0; tri < triangleCount; ++tri)
+		{
+			for(uint32 e = 0; e < 3; ++e)
+			{
+				const uint32 i0 = input.indices[(tri * 3) + e];
+				const uint32 i1 = input.indices[(tri * 3) + ((e + 1) % 3)];
+
+				sEdge edge;
+				edge.a = math::Min<uint32>(i0, i1);
+				edge.b = math::Max<uint32>(i0, i1);
+				edges.PushBack(edge);
+			}
+		}
+
+		std::sort(edges.Pointer(), edges.Pointer() + edges.Size());
+
+		const uint32 edgeCount = edges.Size();
+		uint32 runStart = 0;
+		for(uint32 i = 1; i <= edgeCount; ++i)
+		{
+			if ((i == edgeCount) || !(edges[i] == edges[runStart]))
+			{
+				if ((i - runStart) == 1)
+				{
+					lockedOut[edges[runStart].a] = true;
+					lockedOut[edges[runStart].b] = true;
+				}
+
+				runStart = i;
+			}
+		}
+	}
+
+	bool CMashMeshSimplifier::CollapseFlipsTriangles(const sInput &input,
+		const MashArray<uint32> &indices,
+		const uint32 *vertexTriangles,
+		uint32 triangleCount,
+		uint32 from,
+		uint32 to)
+	{
+		mash::MashVector3 toPosition;
+		GetPosition(input, to, toPosition);
+
+		for(uint32 t = 0; t < triangleCount; ++t)
+		{
+			const uint32 tri = vertexTriangles[t];
+			const uint32 i0 = indices[tri * 3];
+			const uint32 i1 = indices[(tri * 3) + 1];
+			const uint32 i2 = indices[(tri * 3) + 2];
+
+			//triangles containing both vertices will be removed
+			if ((i0 == to) || (i1 == to) || (i2 == to))
+				continue;
+
+			mash::MashVector3 p[3];
+			GetPosition(input, i0, p[0]);
+			GetPosition(input, i1, p[1]);
+			GetPosition(input, i2, p[2]);
+
+			const mash::MashVector3 oldNormal = (p[1] - p[0]).Cross(p[2] - p[0]);
+
+			if (i0 == from)
+				p[0] = toPosition;
+			else if (i1 == from)
+				p[1] = toPosition;
+			else
+				p[2] = toPosition;
+
+			const mash::MashVector3 newNormal = (p[1] - p[0]).Cross(p[2] - p[0]);
+
+			if (oldNormal.Dot(newNormal) <= 0.0f)
+				return true;
+		}
+
+		return false;
+	}
+
+	f32 CMashMeshSimplifier::Simplify(const sInput &input, uint32 targetIndexCount, f32 maxError, MashArray<uint32> &indicesOut)
+	{
+		indicesOut.Clear();
+		indicesOut.Append(input.indices, input.indexCount);
+
+		const uint32 vertexCount = input.vertexCount;
+		uint32 triangleCount = input.indexCount / 3;
+		const uint32 targetTriangleCount = targetIndexCount / 3;
+
+		if ((triangleCount <= targetTriangleCount) || (vertexCount == 0))
+			return 0.0f;
+
+		//compare against squared errors
+		const f64 maxCost = (maxError < math::MaxFloat()) ? ((f64)maxError * (f64)maxError) : (f64)math::MaxFloat();
+
+		MashArray<bool> lockedVertices;
+		LockSeamAndBorderVertices(input, lockedVertices);
+
+		//each vertex stores the planes of the triangles around it
+		MashArray<sQuadric> quadrics(vertexCount, sQuadric());
+		for(uint32 tri = 0; tri < triangleCount; ++tri)
+		{
+			const uint32 i0 = indicesOut[tri * 3];
+			const uint32 i1 = indicesOut[(tri * 3) + 1];
+			const uint32 i2 = indicesOut[(tri * 3) + 2];
+
+			mash::MashVector3 p0, p1, p2;
+			GetPosition(input, i0, p0);
+			GetPosition(input, i1, p1);
+			GetPosition(input, i2, p2);
+
+			mash::MashVector3 normal = (p1 - p0).Cross(p2 - p0);
+			if (normal.Length() <= 0.0f)
+				continue;
+
+			normal.Normalize();
+			const f32 d = -normal.Dot(p0);
+
+			quadrics[i0].AddPlane(normal.x, normal.y, normal.z, d);
+			quadrics[i1].AddPlane(normal.x, normal.y, normal.z, d);
+			quadrics[i2].AddPlane(normal.x, normal.y, normal.z, d);
+		}
+
+		f64 largestCost = 0.0;
+
+		MashArray<uint32> vertexTriangleStart(vertexCount + 1, 0);
+		MashArray<uint32> vertexTriangles;
+		MashArray<uint32> remap(vertexCount, 0);
+		MashArray<bool> touched(vertexCount, false);
+		MashArray<sCollapse> collapses;
+
+		while(triangleCount > targetTriangleCount)
+		{
+			/*
+				Build a vertex to triangle list for the current indices.
+			*/
+			memset(vertexTriangleStart.Pointer(), 0, sizeof(uint32) * vertexTriangleStart.Size());
+			for(uint32 i = 0; i < (triangleCount * 3); ++i)
+				++vertexTriangleStart[indicesOut[i] + 1];
+
+			for(uint32 i = 1; i <= vertexCount; ++i)
+				vertexTriangleStart[i] += vertexTriangleStart[i - 1];
+
+			vertexTriangles.Resize(triangleCount * 3, 0);
+			MashArray<uint32> fill(vertexCount, 0);
+			for(uint32 tri = 0; tri < triangleCount; ++tri)
+			{
+				for(uint32 v = 0; v < 3; ++v)
+				{
+					const uint32 index = indicesOut[(tri * 3) + v];
+					vertexTriangles[vertexTriangleStart[index] + fill[index]++] = tri;
+				}
+			}
+
+			/*
+				Gather every possible half edge collapse and its cost.
+			*/
+			collapses.Clear();
+			for(uint32 tri = 0; tri < triangleCount; ++tri)
+			{
+				for(uint32 e = 0; e < 3; ++e)
+				{
+					const uint32 from = indicesOut[(tri * 3) + e];
+					const uint32 to = indicesOut[(tri * 3) + ((e + 1) % 3)];
+
+					for(uint32 dir = 0; dir < 2; ++dir)
+					{
+						const uint32 collapseFrom = (dir == 0) ? from : to;
+						const uint32 collapseTo = (dir == 0) ? to : from;
+
+						if (lockedVertices[collapseFrom] || (collapseFrom == collapseTo))
+							continue;
+
+						if (input.normalSize > 0)
+						{
+							mash::MashVector3 fromNormal, toNormal;
+							GetNormal(input, collapseFrom, fromNormal);
+							GetNormal(input, collapseTo, toNormal);
+							if (fromNormal.Dot(toNormal) < g_simplifyMinNormalDot)
+								continue;
+						}
+
+						//keep vertices attached to the same bone so skinned lods deform the same
+						if (input.boneWeights && input.boneIndices)
+						{
+							if (GetDominantBone(input, collapseFrom) != GetDominantBone(input, collapseTo))
+								continue;
+						}
+
+						mash::MashVector3 toPosition;
+						GetPosition(input, collapseTo, toPosition);
+
+						sQuadric merged = quadrics[collapseFrom];
+						merged.Add(quadrics[collapseTo]);
+						const f64 cost = merged.Evaluate(toPosition);
+						if (cost > maxCost)
+							continue;
+
+						sCollapse collapse;
+						collapse.from = collapseFrom;
+						collapse.to = collapseTo;
+						collapse.cost = (f32)cost;
+						collapses.PushBack(collapse);
+					}
+				}
+			}
+
+			if (collapses.Empty())
+				break;
+
+			std::sort(collapses.Pointer(), collapses.Pointer() + collapses.Size());
+
+			for(uint32 i = 0; i < vertexCount; ++i)
+			{
+				remap[i] = i;
+				touched[i] = false;
+			}
+
+			/*
+				Perform the cheapest collapses. Vertices around a collapse are marked as
+				touched so that no other collapse this pass can invalidate the flip test.
+			*/
+			uint32 remainingTriangles = triangleCount;
+			uint32 collapseCount = 0;
+			const uint32 totalCollapses = collapses.Size();
+			for(uint32 c = 0; (c < totalCollapses) && (remainingTriangles > targetTriangleCount); ++c)
+			{
+				const sCollapse &collapse = collapses[c];
+				if (touched[collapse.from] || touched[collapse.to])
+					continue;
+
+				const uint32 *fromTriangles = &vertexTriangles[vertexTriangleStart[collapse.from]];
+				const uint32 fromTriangleCount = vertexTriangleStart[collapse.from + 1] - vertexTriangleStart[collapse.from];
+
+				if (CollapseFlipsTriangles(input, indicesOut, fromTriangles, fromTriangleCount, collapse.from, collapse.to))
+					continue;
+
+				for(uint32 t = 0; t < fromTriangleCount; ++t)
+				{
+					const uint32 tri = fromTriangles[t];
+					for(uint32 v = 0; v < 3; ++v)
+					{
+						const uint32 index = indicesOut[(tri * 3) + v];
+						touched[index] = true;
+						if (index == collapse.to)
+							--remainingTriangles;
+					}
+				}
+
+				remap[collapse.from] = collapse.to;
+				quadrics[collapse.to].Add(quadrics[collapse.from]);
+
+				if (collapse.cost > largestCost)
+					largestCost = collapse.cost;
+
+				++collapseCount;
+			}
+
+			if (collapseCount == 0)
+				break;
+
+			//apply the collapses and remove degenerate triangles
+			uint32 newIndexCount = 0;
+			for(uint32 tri = 0; tri < triangleCount; ++tri)
+			{
+				const uint32 i0 = remap[indicesOut[tri * 3]];
+				const uint32 i1 = remap[indicesOut[(tri * 3) + 1]];
+				const uint32 i2 = remap[indicesOut[(tri * 3) + 2]];
+
+				if ((i0 == i1) || (i1 == i2) || (i0 == i2))
+					continue;
+
+				indicesOut[newIndexCount++] = i0;
+				indicesOut[newIndexCount++] = i1;
+				indicesOut[newIndexCount++] = i2;
+			}
+
+			indicesOut.Resize(newIndexCount);
+			triangleCount = newIndexCount / 3;
+		}
+
+		return (f32)sqrt(largestCost);
+	}
+}
@@ -0,0 +1,104 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#ifndef _C_MASH_MESH_SIMPLIFIER_H_
+#define _C_MASH_MESH_SIMPLIFIER_H_
+
+#include "MashCompileSettings.h"
+#include "MashDataTypes.h"
+#include "MashArray.h"
+#include "MashVector3.h"
+#include "MashVector4.h"
+
+namespace mash
+{
+	/*
+		Reduces the triangle count of an indexed triangle list using quadric error
+		metric half edge collapses. Vertices are never moved, a vertex is only ever
+		collapsed onto one of its neighbours. This means normals, texture coordinates
+		and bone weights of the remaining vertices are untouched.
+
+		Vertices that share a position with another vertex (uv seams and hard normal
+		edges) and vertices on open borders are locked so these features are preserved.
+	*/
+	class CMashMeshSimplifier
+	{
+	public:
+		struct sInput
+		{
+			const uint8 *vertices;
+			uint32 vertexCount;
+			uint32 vertexStride;
+
+			uint32 positionLocation;
+			uint32 positionSize;
+
+			//normal size can be 0 if the vertex contains no normals
+			uint32 normalLocation;
+			uint32 normalSize;
+
+			//may be null
+			const mash::MashVector4 *boneWeights;
+			const mash::MashVector4 *boneIndices;
+
+			const uint32 *indices;
+			uint32 indexCount;
+
+			sInput():vertices(0), vertexCount(0), vertexStride(0), positionLocation(0), positionSize(0),
+				normalLocation(0), normalSize(0), boneWeights(0), boneIndices(0), indices(0), indexCount(0){}
+		};
+
+	private:
+		struct sQuadric
+		{
+			f64 a2, ab, ac, ad;
+			f64 b2, bc, bd;
+			f64 c2, cd;
+			f64 d2;
+
+			sQuadric():a2(0.0), ab(0.0), ac(0.0), ad(0.0), b2(0.0), bc(0.0), bd(0.0), c2(0.0), cd(0.0), d2(0.0){}
+
+			void AddPlane(f64 a, f64 b, f64 c, f64 d);
+			void Add(const sQuadric &other);
+			f64 Evaluate(const mash::MashVector3 &p)const;
+		};
+
+		struct sCollapse
+		{
+			uint32 from;
+			uint32 to;
+			f32 cost;
+
+			bool operator<(const sCollapse &other)const
+			{
+				return cost < other.cost;
+			}
+		};
+
+		static void GetPosition(const sInput &input, uint32 vertex, mash::MashVector3 &out);
+		static void GetNormal(const sInput &input, uint32 vertex, mash::MashVector3 &out);
+		static uint32 GetDominantBone(const sInput &input, uint32 vertex);
+		static void LockSeamAndBorderVertices(const sInput &input, MashArray<bool> &lockedOut);
+		static bool CollapseFlipsTriangles(const sInput &input,
+			const MashArray<uint32> &indices,
+			const uint32 *vertexTriangles,
+			uint32 triangleCount,
+			uint32 from,
+			uint32 to);
+
+	public:
+		//! Simplifies a mesh.
+		/*!
+			\param input Mesh data.
+			\param targetIndexCount Simplification stops when the index count is at or below this value.
+			\param maxError Collapses with an error greater than this will not be performed.
+			\param indicesOut Simplified index list. This references the original vertices.
+			\return Largest error of any collapse performed. This is in the same units as the vertex positions.
+		*/
+		static f32 Simplify(const sInput &input, uint32 targetIndexCount, f32 maxError, MashArray<uint32> &indicesOut);
+	};
+}
+
+#endif
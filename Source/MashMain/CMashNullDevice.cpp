@@ -0,0 +1,131 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#include "CMashNullDevice.h"
+#include "MashCompileSettings.h"
+#include "CMashInputManager.h"
+#include "MashLog.h"
+
+#ifdef MASH_WINDOWS
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+namespace mash
+{
+	CMashNullDevice::CMashNullDevice(const MashStringc &debugFilePath):CMashDevice(debugFilePath),
+		m_windowSizeX(0), m_windowSizeY(0), m_lockMouse(false), m_mouseCursorHidden(false)
+	{
+	}
+
+	CMashNullDevice::~CMashNullDevice()
+	{
+	}
+
+	eMASH_STATUS CMashNullDevice::Initialise(const mash::sMashDeviceSettings &settings)
+	{
+		m_windowSizeX = settings.screenWidth;
+		m_windowSizeY = settings.screenHeight;
+
+		MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_INFORMATION, 
+			"Headless device created. No window will be opened.", 
+			"CMashNullDevice::Initialise");
+
+		return aMASH_OK;
+	}
+
+	eMASH_STATUS CMashNullDevice::LoadComponents(const mash::sMashDeviceSettings &settings)
+	{
+		if (CMashDevice::LoadComponents(settings) == aMASH_FAILED)
+			return aMASH_FAILED;
+
+		//so that input can be injected by tests
+		m_pInputManager->_CreateController(aINPUTCONTROLLER_KEYBOARD_MOUSE, true);
+
+		return aMASH_OK;
+	}
+
+	bool CMashNullDevice::PollMessages()
+	{
+		//nothing to process. The game loop only ends when requested by the user.
+		return false;
+	}
+
+	void CMashNullDevice::SyncInputDeviceWithCurrentState()
+	{
+	}
+
+	void CMashNullDevice::SetWindowCaption(const int8 *text)
+	{
+	}
+
+	void CMashNullDevice::GetWindowSize(uint32 &x, uint32 &y)const
+	{
+		x = m_windowSizeX;
+		y = m_windowSizeY;
+	}
+
+	void CMashNullDevice::_Draw()
+	{
+	}
+
+	void CMashNullDevice::LockMouseToScreenCenter(bool state)
+	{
+		m_lockMouse = state;
+	}
+
+	void CMashNullDevice::HideMouseCursor(bool state)
+	{
+		m_mouseCursorHidden = state;
+	}
+
+	void CMashNullDevice::Sleep(uint32 ms)const
+	{
+#ifdef MASH_WINDOWS
+		::Sleep(ms);
+#else
+		struct timespec ts;
+		if (ms > 0)
+		{
+			ts.tv_sec = (time_t)(ms / 1000);
+			ts.tv_nsec = (long)(ms % 1000) * 1000000;
+		}
+		else
+		{
+			ts.tv_sec = 0;
+			ts.tv_nsec = 1;
+		}
+
+		nanosleep(&ts, NULL);
+#endif
+	}
+
+	MashDevice* _CreateNullDevice(mash::sMashDeviceSettings &settings)
+	{
+		CMashNullDevice *device = MASH_NEW_COMMON CMashNullDevice(settings.debugFilePath);
+		if (device->Initialise(settings) == aMASH_FAILED)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR,
+				"Failed to initialise device.",
+				"CMashNullDevice::_CreateNullDevice");
+
+			MASH_DELETE device;
+			return 0;
+		}
+
+		if (device->LoadComponents(settings) == aMASH_FAILED)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR,
+				"Failed to load components.",
+				"CMashNullDevice::_CreateNullDevice");
+
+			MASH_DELETE device;
+			return 0;
+		}
+
+		return device;
+	}
+}
@@ -0,0 +1,71 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#ifndef _CMASH_NULL_DEVICE_H_
+#define _CMASH_NULL_DEVICE_H_
+
+#include "CMashDevice.h"
+
+namespace mash
+{
+	/*
+		Device created when sMashDeviceSettings::headless is set.
+		No window is created and no OS messages are processed. 
+		Input can still be injected through the input manager.
+	*/
+	class CMashNullDevice : public CMashDevice
+	{
+	protected:
+		bool PollMessages();
+		void SyncInputDeviceWithCurrentState();
+	private:
+		uint32 m_windowSizeX;
+		uint32 m_windowSizeY;
+		bool m_lockMouse;
+		bool m_mouseCursorHidden;
+	public:
+		CMashNullDevice(const MashStringc &debugFilePath);
+		~CMashNullDevice();
+
+		eMASH_STATUS Initialise(const mash::sMashDeviceSettings &settings);
+		eMASH_STATUS LoadComponents(const mash::sMashDeviceSettings &settings);
+
+		void SetWindowCaption(const int8 *text);
+		void GetWindowSize(uint32 &x, uint32 &y)const;
+		void _Draw();
+
+		void LockMouseToScreenCenter(bool state);
+		bool IsMouseLockedToScreenCenter()const;
+
+		void HideMouseCursor(bool state);
+		bool IsMouseCursorHidden()const;
+		void Sleep(uint32 ms)const;
+
+		eMASH_DEVICE_TYPE GetDeviceType()const;
+	};
+
+	/*
+		Called from the platform CreateDevice() functions when
+		sMashDeviceSettings::headless is set.
+	*/
+	MashDevice* _CreateNullDevice(mash::sMashDeviceSettings &settings);
+
+	inline bool CMashNullDevice::IsMouseLockedToScreenCenter()const
+	{
+		return m_lockMouse;
+	}
+
+	inline bool CMashNullDevice::IsMouseCursorHidden()const
+	{
+		return m_mouseCursorHidden;
+	}
+
+	inline eMASH_DEVICE_TYPE CMashNullDevice::GetDeviceType()const
+	{
+		return aDEVICE_TYPE_NULL;
+	}
+}
+
+#endif
@@ -18,8 +18,8 @@ namespace mash
 	CMashGeometryBatch::CMashGeometryBatch(MashVideo *pRenderer):MashGeometryBatch(),
 		m_pRenderer(pRenderer),
 		m_iVertexCount(0), m_iPrimitiveType(aPRIMITIVE_TRIANGLE_LIST), 
-		m_bInitialised(false), m_iCurrentBufferSizeInBytes(0),
-		m_meshBuffer(0), m_pMaterial(0), m_commitNeeded(false)
+		m_pMaterial(0), m_meshBuffer(0), m_transientBuffer(0),
+		m_commitNeeded(false), m_bInitialised(false)
 	{
 	
 	}
@@ -57,6 +57,19 @@ namespace mash
 		m_eBatchType = eBatchType;
 		m_cachedPoints.Clear();
 
+		if (m_eBatchType == aDYNAMIC)
+		{
+			m_transientBuffer = m_pRenderer->GetTransientVertexBuffer(m_pMaterial->GetVertexDeclaration());
+			if (!m_transientBuffer)
+			{
+				MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+							"Failed to get the transient vertex buffer",
+							"CMashGeometryBatch::Initialise");
+
+				return aMASH_FAILED;
+			}
+		}
+
 		m_bInitialised = true;
 
 		return aMASH_OK;
@@ -109,56 +122,34 @@ namespace mash
 			return aMASH_FAILED;
 		}
 
-		if (m_commitNeeded)
+		MashMeshBuffer *meshBuffer = m_meshBuffer;
+		uint32 firstVertex = 0;
+
+		if (m_eBatchType == aDYNAMIC)
+		{
+			//dynamic data is written to the shared transient buffer each flush
+			if (m_transientBuffer->Write(m_cachedPoints.Pointer(), m_iVertexCount, firstVertex) == aMASH_FAILED)
+			{
+				m_cachedPoints.Clear();
+				m_iVertexCount = 0;
+				return aMASH_FAILED;
+			}
+
+			m_cachedPoints.Clear();//flush the buffer
+			meshBuffer = m_transientBuffer->GetMeshBuffer();
+		}
+		else if (m_commitNeeded)
 		{
 			if (!m_meshBuffer)
 			{
 				sVertexStreamInit streamData;
 				streamData.dataSizeInBytes = m_cachedPoints.GetCurrentSize();
-
-				if (m_eBatchType == CMashGeometryBatch::aDYNAMIC)
-				{
-					streamData.usage = aUSAGE_DYNAMIC;
-					streamData.data = m_cachedPoints.Pointer();
-				}
-				else
-				{
-					streamData.usage = aUSAGE_STATIC;
-					streamData.data = m_cachedPoints.Pointer();
-				}
+				streamData.usage = aUSAGE_STATIC;
+				streamData.data = m_cachedPoints.Pointer();
 
 				m_meshBuffer = m_pRenderer->CreateMeshBuffer(&streamData, 1, m_pMaterial->GetVertexDeclaration());
-
-                if (m_eBatchType == CMashGeometryBatch::aSTATIC)
-                    m_cachedPoints.DeleteData();
-
-				m_iCurrentBufferSizeInBytes = streamData.dataSizeInBytes;
-			}
-			else if (m_eBatchType == CMashGeometryBatch::aDYNAMIC)//only update dynamic buffers
-			{
-				uint32 sizeNeeded = m_cachedPoints.GetCurrentSize();
-				if (sizeNeeded > m_iCurrentBufferSizeInBytes)
-				{
-					if (m_meshBuffer->ResizeVertexBuffers(0, sizeNeeded, aUSAGE_DYNAMIC, false) == aMASH_FAILED)
-						return aMASH_FAILED;
-
-					m_iCurrentBufferSizeInBytes = sizeNeeded;
-				}
-
-				int8 *vertexPtr = 0;
-				if (m_meshBuffer->GetVertexBuffer()->Lock(mash::aLOCK_WRITE_DISCARD, (void**)(&vertexPtr)) == aMASH_FAILED)
-				{
-					return aMASH_FAILED;
-				}
-
-				memcpy(vertexPtr, m_cachedPoints.Pointer(), m_cachedPoints.GetCurrentSize());
-
-				if (m_meshBuffer->GetVertexBuffer()->Unlock() == aMASH_FAILED)
-				{
-					return aMASH_FAILED;
-				}
-
-				m_cachedPoints.Clear();//flush the buffer
+				m_cachedPoints.DeleteData();
+				meshBuffer = m_meshBuffer;
 			}
 
 			m_commitNeeded = false;
@@ -168,9 +159,9 @@ namespace mash
 
 		if (m_pMaterial->OnSet() == aMASH_OK)
 		{
-			status = m_pRenderer->DrawVertexList(m_meshBuffer, m_iVertexCount,
+			status = m_pRenderer->DrawVertexList(meshBuffer, m_iVertexCount,
 				GetPrimitiveCount(),
-				m_iPrimitiveType);
+				m_iPrimitiveType, firstVertex);
 		}
 
 		if (m_eBatchType == aDYNAMIC)
@@ -10,6 +10,7 @@
 #include "MashTypes.h"
 #include "MashGenericArray.h"
 #include "MashMeshBuffer.h"
+#include "MashTransientVertexBuffer.h"
 
 namespace mash
 {
@@ -24,10 +25,10 @@ namespace mash
 		uint32 m_iVertexCount;
 		ePRIMITIVE_TYPE m_iPrimitiveType;
 		MashMaterial *m_pMaterial;
+		//static batches only
 		MashMeshBuffer *m_meshBuffer;
-
-		//expressed in bytes
-		uint32 m_iCurrentBufferSizeInBytes;
+		//dynamic batches only
+		MashTransientVertexBuffer *m_transientBuffer;
 
 		MashGenericArray m_cachedPoints;
 		bool m_commitNeeded;
@@ -19,6 +19,7 @@
 #include "MashEffect.h"
 #include "MashSkin.h"
 #include "MashTechnique.h"
+#include "MashVector4.h"
 namespace mash
 {
 	class CMashRenderInfo : public MashRenderInfo
@@ -34,6 +35,8 @@ namespace mash
 		uint32 m_iBonePaletteMaxCount;
 		uint32 m_currentBonePaletteCount;
 		MashSkin *m_skin;
+		MashSkinPaletteBuffer *m_skinPaletteBuffer;
+		uint32 m_bonePaletteOffset;
 		MashParticleSystem *m_particleSystem;
 
 		uint32 m_iLightBufferSizeInBytes;
@@ -41,6 +44,11 @@ namespace mash
 		MashLight *m_pLight;
 		MashShadowCaster *m_pShadowCaster;
 
+		const MashLightClusterGrid *m_lightClusterGrid;
+		MashTexture *m_lightClusterTexture;
+		const MashTextureState *m_lightClusterTextureState;
+		MashVector4 m_lightClusterLayout;
+
 		/*
 			TODO : Is there a way we can just access these
 			from the renderer?
@@ -76,6 +84,12 @@ namespace mash
 			m_pShadowCaster(0),
 			m_particleSystem(0),
 			m_skin(0),
+			m_skinPaletteBuffer(0),
+			m_bonePaletteOffset(0),
+			m_lightClusterGrid(0),
+			m_lightClusterTexture(0),
+			m_lightClusterTextureState(0),
+			m_lightClusterLayout(0.0f, 0.0f, 0.0f, 0.0f),
 			m_vertex(0)
 		{
 		}
@@ -101,6 +115,10 @@ namespace mash
 		void SetSkin(MashSkin *skin);
 		MashSkin* GetSkin()const;
 
+		void SetSkinPaletteBuffer(MashSkinPaletteBuffer *buffer, uint32 offset);
+		MashSkinPaletteBuffer* GetSkinPaletteBuffer()const;
+		uint32 GetBonePaletteOffset()const;
+
 		void SetCurrentBonePaletteSize(uint32 boneCount);
 		void SetBonePaletteMinimumSize(uint32 boneCount);
 
@@ -137,6 +155,11 @@ namespace mash
 
 		void SetLightBuffer(const sMashLight *lightArray, uint32 count);
 
+		void SetLightClusters(const MashLightClusterGrid *grid, MashTexture *texture, const MashTextureState *textureState, const MashVector4 &layout);
+		const MashLightClusterGrid* GetLightClusterGrid()const;
+		MashTexture* GetLightClusterTexture(const MashTextureState **textureStateOut = 0)const;
+		const MashVector4& GetLightClusterLayout()const;
+
 		void SetVertex(MashVertex *vertexDecl);
 		MashVertex* GetVertex()const;
 	};
@@ -161,6 +184,22 @@ namespace mash
 		return m_skin;	
 	}
 
+	inline void CMashRenderInfo::SetSkinPaletteBuffer(MashSkinPaletteBuffer *buffer, uint32 offset)
+	{
+		m_skinPaletteBuffer = buffer;
+		m_bonePaletteOffset = offset;
+	}
+
+	inline MashSkinPaletteBuffer* CMashRenderInfo::GetSkinPaletteBuffer()const
+	{
+		return m_skinPaletteBuffer;
+	}
+
+	inline uint32 CMashRenderInfo::GetBonePaletteOffset()const
+	{
+		return m_bonePaletteOffset;
+	}
+
 	inline void CMashRenderInfo::SetParticleSystem(MashParticleSystem *particleSystem)
 	{
 		m_particleSystem = particleSystem;
@@ -187,6 +226,32 @@ namespace mash
 		return m_pShadowCaster;
 	}
 
+	inline void CMashRenderInfo::SetLightClusters(const MashLightClusterGrid *grid, MashTexture *texture, const MashTextureState *textureState, const MashVector4 &layout)
+	{
+		m_lightClusterGrid = grid;
+		m_lightClusterTexture = texture;
+		m_lightClusterTextureState = textureState;
+		m_lightClusterLayout = layout;
+	}
+
+	inline const MashLightClusterGrid* CMashRenderInfo::GetLightClusterGrid()const
+	{
+		return m_lightClusterGrid;
+	}
+
+	inline MashTexture* CMashRenderInfo::GetLightClusterTexture(const MashTextureState **textureStateOut)const
+	{
+		if (textureStateOut)
+			*textureStateOut = m_lightClusterTextureState;
+
+		return m_lightClusterTexture;
+	}
+
+	inline const MashVector4& CMashRenderInfo::GetLightClusterLayout()const
+	{
+		return m_lightClusterLayout;
+	}
+
 	inline MashLight* CMashRenderInfo::GetLight()const
 	{
 		return m_pLight;
@@ -0,0 +1,164 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+
+#ifndef _C_MASH_RENDER_QUEUE_H_
+#define _C_MASH_RENDER_QUEUE_H_
+
+#include "MashArray.h"
+#include "MashRenderable.h"
+#include "MashMaterial.h"
+#include "MashTechniqueInstance.h"
+#include "MashCamera.h"
+
+namespace mash
+{
+	/*
+		Renderables collected for a single pass. Entries are stored in a flat
+		array that keeps its memory between frames, so once the scene is stable
+		filling the queue doesn't allocate.
+	*/
+	class CMashRenderQueue
+	{
+	public:
+		struct sEntry
+		{
+			MashRenderable *renderable;
+
+			/*
+				Solid objects are sorted by technique render key only.
+				Transparent objects use,
+				First 32bits = technique render key
+				Second 32bits = current depth in view space
+			*/
+			uint64 sortKey;
+			f32 depth;
+
+			//forward lights for this object, see CMashSceneManager::SetForwardLightInfluenceEnabled()
+			uint32 lightSlot;
+			uint32 lightCount;
+
+			//insertion order, keeps equal keys in the order they were added
+			uint32 order;
+
+			bool operator<(const sEntry &other)const
+			{
+				if (sortKey != other.sortKey)
+					return sortKey < other.sortKey;
+
+				return order < other.order;
+			}
+		};
+	private:
+		enum
+		{
+			//below this an insertion sort is faster than std::sort
+			aINSERTION_SORT_COUNT = 32
+		};
+
+		MashArray<sEntry> m_entries;
+		uint32 m_allocationCount;
+
+		void _PushBack(const sEntry &entry)
+		{
+			if (m_entries.Size() == m_entries.ReservedSize())
+				++m_allocationCount;
+
+			m_entries.PushBack(entry);
+		}
+	public:
+		CMashRenderQueue():m_entries(), m_allocationCount(0){}
+		~CMashRenderQueue(){}
+
+		void AddSolid(MashRenderable *renderable, uint32 lightSlot = 0, uint32 lightCount = 0)
+		{
+			sEntry entry;
+			entry.renderable = renderable;
+			entry.sortKey = renderable->GetMaterial()->GetActiveTechnique()->GetRenderKey();
+			entry.depth = 0.0f;
+			entry.lightSlot = lightSlot;
+			entry.lightCount = lightCount;
+			entry.order = m_entries.Size();
+			_PushBack(entry);
+		}
+
+		void AddTransparent(MashRenderable *renderable, const MashCamera *camera, uint32 lightSlot = 0, uint32 lightCount = 0)
+		{
+			sEntry entry;
+			entry.renderable = renderable;
+			entry.depth = camera->GetDistanceToBox(renderable->GetWorldBoundingBox());
+			uint64 materialKey = renderable->GetMaterial()->GetActiveTechnique()->GetRenderKey();
+			entry.sortKey = (materialKey << 32UL) | (uint32)entry.depth;
+			entry.lightSlot = lightSlot;
+			entry.lightCount = lightCount;
+			entry.order = m_entries.Size();
+			_PushBack(entry);
+		}
+
+		void Sort()
+		{
+			const uint32 count = m_entries.Size();
+			if (count < 2)
+				return;
+
+			if (count <= aINSERTION_SORT_COUNT)
+			{
+				sEntry *entries = m_entries.Pointer();
+				for(uint32 i = 1; i < count; ++i)
+				{
+					sEntry current = entries[i];
+					int32 j = (int32)i - 1;
+					for(; (j >= 0) && (current.sortKey < entries[j].sortKey); --j)
+						entries[j + 1] = entries[j];
+
+					entries[j + 1] = current;
+				}
+			}
+			else
+			{
+				//std::sort isn't stable, the insertion order in each entry breaks ties
+				m_entries.Sort();
+			}
+		}
+
+		void Draw()const
+		{
+			const uint32 count = m_entries.Size();
+			const sEntry *entries = m_entries.Pointer();
+			for(uint32 i = 0; i < count; ++i)
+				entries[i].renderable->Draw();
+		}
+
+		//keeps memory for the next frame
+		void Clear()
+		{
+			m_entries.Clear();
+			m_allocationCount = 0;
+		}
+
+		bool Empty()const
+		{
+			return m_entries.Empty();
+		}
+
+		uint32 Size()const
+		{
+			return m_entries.Size();
+		}
+
+		const sEntry* GetEntries()const
+		{
+			return m_entries.Pointer();
+		}
+
+		//number of times the queue had to grow since the last Clear()
+		uint32 GetAllocationCount()const
+		{
+			return m_allocationCount;
+		}
+	};
+}
+
+#endif
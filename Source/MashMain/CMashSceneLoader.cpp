@@ -32,6 +32,7 @@
 #include "MashString.h"
 #include "MashStringHelper.h"
 #include "MashKeySet.h"
+#include "MashTimer.h"
 namespace mash
 {
 	const int8 ROOT_NODE_NAME[] = "Scene Root";
@@ -101,26 +102,36 @@ namespace mash
 				memcpy(&currentMesh->staticData, &data[currentLocation], sizeof(sMeshStatic));
 				currentLocation += sizeof(sMeshStatic);
                 
-				//allocate memory for jth mesh geometry 
 				uint32 totalVertexBufferSize = currentMesh->staticData.vertexStride * currentMesh->staticData.vertexCount;
-				currentMesh->vertices = (int8*)m_memoryPool.GetMemory(totalVertexBufferSize);
-				//grab jth meshes geometry data
-				memcpy(currentMesh->vertices, &data[currentLocation], totalVertexBufferSize);
-				currentLocation += totalVertexBufferSize;
-				
-				//grab index information
-				currentMesh->indices = 0;
+				uint32 totalIndexBufferSize = sizeof(uint32) * currentMesh->staticData.indexCount;
 				if (currentMesh->staticData.indexFormat == aFORMAT_R16_UINT)
+					totalIndexBufferSize = sizeof(uint16) * currentMesh->staticData.indexCount;
+
+				if (loadData.isCookedFile)
 				{
-					currentMesh->indices = (int8*)m_memoryPool.GetMemory(sizeof(uint16) * currentMesh->staticData.indexCount);
-					memcpy(currentMesh->indices, &data[currentLocation], sizeof(uint16) * currentMesh->staticData.indexCount);
-					currentLocation += sizeof(uint16) * currentMesh->staticData.indexCount;
+					/*
+						Cooked geometry is already in its final format so it is
+						referenced straight from the file data. The file data stays alive
+						until all models have been created.
+					*/
+					currentMesh->vertices = (int8*)&data[currentLocation];
+					currentLocation += totalVertexBufferSize;
+
+					currentMesh->indices = (int8*)&data[currentLocation];
+					currentLocation += totalIndexBufferSize;
 				}
 				else
 				{
-					currentMesh->indices = (int8*)m_memoryPool.GetMemory(sizeof(uint32) * currentMesh->staticData.indexCount);
-					memcpy(currentMesh->indices, &data[currentLocation], sizeof(uint32) * currentMesh->staticData.indexCount);
-					currentLocation += sizeof(uint32) * currentMesh->staticData.indexCount;
+					//allocate memory for jth mesh geometry 
+					currentMesh->vertices = (int8*)m_memoryPool.GetMemory(totalVertexBufferSize);
+					//grab jth meshes geometry data
+					memcpy(currentMesh->vertices, &data[currentLocation], totalVertexBufferSize);
+					currentLocation += totalVertexBufferSize;
+
+					//grab index information
+					currentMesh->indices = (int8*)m_memoryPool.GetMemory(totalIndexBufferSize);
+					memcpy(currentMesh->indices, &data[currentLocation], totalIndexBufferSize);
+					currentLocation += totalIndexBufferSize;
 				}
 
 				//grab bones' vertex influences
@@ -462,13 +473,13 @@ namespace mash
 
 		if (loadedParticleData.particleStatic.diffuseTextureFileId != -1)
 		{
-
-			mash::MashTexture *texture = pDevice->GetRenderer()->GetTexture(loadedData.stringMap[loadedParticleData.particleStatic.diffuseTextureFileId]);
 			mash::MashTextureState *textureState = 0;
 			if (loadedParticleData.particleStatic.diffuseSamplerFileId != -1)
 				textureState = loadedData.samplerStateMap[loadedParticleData.particleStatic.diffuseSamplerFileId];
 
-			particleSystem->SetDiffuseTexture(texture, textureState);
+			//set in LoadParticleTextures()
+			loadedData.particleTextures.PushBack(sParticleTextureData(particleSystem, 
+				loadedParticleData.particleStatic.diffuseTextureFileId, textureState));
 		}
 
 		switch(loadedParticleData.particleStatic.emitterType)
@@ -877,6 +888,26 @@ namespace mash
 		return aMASH_OK;
 	}
 
+	void CMashSceneLoader::LoadParticleTextures(MashDevice *pDevice, sLoadedData &loadData)
+	{
+		const uint32 particleTextureCount = loadData.particleTextures.Size();
+		if (particleTextureCount == 0)
+			return;
+
+		MashArray<MashStringc> textureFiles(particleTextureCount);
+		for(uint32 i = 0; i < particleTextureCount; ++i)
+			textureFiles[i] = loadData.stringMap[loadData.particleTextures[i].textureStringId];
+
+		MashArray<MashTexture*> textures(particleTextureCount, 0);
+		pDevice->GetRenderer()->GetTextures(textureFiles.Pointer(), particleTextureCount, textures.Pointer());
+
+		for(uint32 i = 0; i < particleTextureCount; ++i)
+		{
+			const sParticleTextureData &particleTexture = loadData.particleTextures[i];
+			particleTexture.particleSystem->SetDiffuseTexture(textures[i], particleTexture.textureState);
+		}
+	}
+
 	eMASH_STATUS CMashSceneLoader::LoadAnimationMixer(MashDevice *pDevice, 
 		sLoadedData &loadData,
 		const uint8 *data, 
@@ -1085,6 +1116,11 @@ namespace mash
 		memcpy(&fileHeader, &fileData[currentLocation], sizeof(CMashSceneLoader::sFileHeader));
 		currentLocation += sizeof(CMashSceneLoader::sFileHeader);
 
+		loadedData.isCookedFile = (fileHeader.version >= g_sceneFileCookedVersion);
+#ifdef MASH_LOG_ENABLED
+		const uint64 loadStartTime = pDevice->GetTimer()->GetTimeSinceProgramStart();
+#endif
+
 		//load string map
 		for(uint32 i = 0; i < fileHeader.stringCount; ++i)
 		{
@@ -1265,6 +1301,8 @@ namespace mash
 			LoadAnimationMixer(pDevice, loadedData, fileData, currentLocation);
 		}
 
+		LoadParticleTextures(pDevice, loadedData);
+
 		pWriter->Destroy();
 
 		mash::MashDummy *rootNode = 0;
@@ -1328,8 +1366,10 @@ namespace mash
 		{
 			MASH_WRITE_TO_LOG_EX(MashLog::aERROR_LEVEL_INFORMATION, 
 						"CMashSceneLoader::SceneFileLoader",
-						"Scene load succeeded for file '%s'.",
-						fileName);
+						"Scene load succeeded for file '%s' in '%u' ms. Cooked : %s.",
+						fileName, 
+						(uint32)(pDevice->GetTimer()->GetTimeSinceProgramStart() - loadStartTime),
+						loadedData.isCookedFile ? "true" : "false");
 		}
 		else
 		{
@@ -35,9 +35,17 @@ namespace mash
 
 	class MashSceneNode;
 	class MashModel;
+	class MashParticleSystem;
 
 	const uint32 iMAX_STRING_LENGTH = 256;
 
+	/*
+		Scene file versions. Cooked files hold mesh data that is already in
+		the vertex format of the material it was saved with.
+	*/
+	const f32 g_sceneFileVersion = 0.0f;
+	const f32 g_sceneFileCookedVersion = 1.0f;
+
 	/*
 		This class can be created without factory.
 	*/	
@@ -426,6 +434,25 @@ namespace mash
 				parentFileId(_parentFileId){}
 		};
 
+		/*
+			Particle textures are loaded together after all nodes are
+			created so they can be decoded in parallel.
+		*/
+		struct sParticleTextureData
+		{
+			MashParticleSystem *particleSystem;
+			int32 textureStringId;
+			MashTextureState *textureState;
+
+			sParticleTextureData():particleSystem(0), textureStringId(-1), textureState(0){}
+
+			sParticleTextureData(MashParticleSystem *_particleSystem,
+				int32 _textureStringId,
+				MashTextureState *_textureState):particleSystem(_particleSystem),
+				textureStringId(_textureStringId),
+				textureState(_textureState){}
+		};
+
 		typedef MashMemoryPool<sMashMemoryPoolError, sMashAllocAllocatorFunctor, sMashFreeDeallocatorFunctor> MemPoolType;
 
 		typedef CMashSTLMapAllocator<std::pair<const int32, sSceneNodeData>, MemPoolType> sceneNodeAlloc;
@@ -456,7 +483,13 @@ namespace mash
 			std::map<int32, sModelContainer, std::less<int32>, modelAlloc > modelMap;
 			std::map<int32, MashTriangleBuffer*, std::less<int32>, triangleBufferAlloc > triangleBufferMap;
 			std::map<int32, MashTriangleCollider*, std::less<int32>, triangleColliderAlloc > triangleColliderMap;
+			MashArray<sParticleTextureData> particleTextures;
 
+			/*
+				If true, mesh data is referenced directly from the file data
+				rather than copied into the memory pool.
+			*/
+			bool isCookedFile;
 			
 			sLoadedData(CMashSceneLoader::MemPoolType *pool):sceneNodeMap(std::less<int32>(), sceneNodeAlloc(pool)),
 				stringMap(std::less<int32>(), stringAlloc(pool)),
@@ -469,7 +502,8 @@ namespace mash
 				skinMap(std::less<int32>(), skinAlloc(pool)),
 				modelMap(std::less<int32>(), modelAlloc(pool)),
 				triangleBufferMap(std::less<int32>(), triangleBufferAlloc(pool)),
-				triangleColliderMap(std::less<int32>(), triangleColliderAlloc(pool)){}
+				triangleColliderMap(std::less<int32>(), triangleColliderAlloc(pool)),
+				isCookedFile(false){}
 
 			~sLoadedData(){DropAllData();}
 			
@@ -534,6 +568,8 @@ namespace mash
 			const uint8 *data, 
 			uint32 &currentLocation);
 
+		void LoadParticleTextures(MashDevice *pDevice, sLoadedData &loadData);
+
 		MashModel* ReadModelData(MashDevice *pDevice, const sFileHeader *fileHeader, const uint8 *data, const int8 *modelName, MashEffect *vertexProgram);
 
 		void ReadEntityData(const uint8 *data, uint32 &location, sEntity *entity);
@@ -24,6 +24,7 @@
 #include "CMashMeshParticleSystem.h"
 #include "CMashCPUParticleSystem.h"
 #include "CMashSkin.h"
+#include "CMashSkinPaletteBuffer.h"
 #include "CMashStaticDecal.h"
 #include "CMashDynamicDecal.h"
 #include "MashRenderInfo.h"
@@ -52,6 +53,7 @@
 #include "CMashFreeCameraController.h"
 #include "CMashCharacterMovementController.h"
 #include "CMashEllipsoidColliderController.h"
+#include "CMashEllipsoidColliderManager.h"
 #include "MashTimer.h"
 #include "CMashTriColliderKDTree.h"
 
@@ -65,6 +67,9 @@
 
 namespace mash
 {
+	//width of the light cluster texture in texels
+	static const uint32 g_lightClusterTextureWidth = 1024;
+
 	bool SortNodesByPointer(const MashSceneNode *a, const MashSceneNode *b)
 	{
 		return (a < b);
@@ -119,6 +124,20 @@ namespace mash
 		m_castTransparentObjectShadows(false),
 		m_isSceneInitializing(false),
 		m_customViewportRT(0),
+		m_lightClusterGrid(),
+		m_lightClusterTexture(0),
+		m_lightClusterTextureState(0),
+		m_lightClusterTextureRowCount(0),
+		m_deferredTiledLightingEnabled(false),
+		m_deferredLightTileSize(64),
+		m_deferredLightTiles(),
+		m_lightInfluenceEnabled(false),
+		m_maxLightsPerObject(4),
+		m_lightInfluenceIndex(),
+		m_lightInfluenceIndexSize(0),
+		m_forwardLightSlotAllocationCount(0),
+		m_forwardLocalLightCount(0),
+		m_ellipsoidColliderManager(0),
         m_pRenderKeyHashFunction(0)
 	{
 		m_pCurrentSceneNode = 0;
@@ -132,6 +151,7 @@ namespace mash
 		}
 
 		memset(m_pGBufferLighting, 0, sizeof(m_pGBufferLighting));
+		memset(m_pGBufferTiledLighting, 0, sizeof(m_pGBufferTiledLighting));
 
 		memset(&m_sceneRenderInfo, 0, sizeof(sSceneRenderInfo));
 
@@ -167,6 +187,12 @@ namespace mash
 				m_pGBufferLighting[i]->Drop();
 				m_pGBufferLighting[i] = 0;
 			}
+
+			if (m_pGBufferTiledLighting[i])
+			{
+				m_pGBufferTiledLighting[i]->Drop();
+				m_pGBufferTiledLighting[i] = 0;
+			}
 		}
 
 		if (m_pFinalMaterial)
@@ -187,6 +213,18 @@ namespace mash
 			m_pPrimitiveBatch = 0;
 		}
 
+		if (m_lightClusterTexture)
+		{
+			m_pRenderer->RemoveTextureFromCache(m_lightClusterTexture);
+			m_lightClusterTexture = 0;
+		}
+
+		if (m_lightClusterTextureState)
+		{
+			m_lightClusterTextureState->Drop();
+			m_lightClusterTextureState = 0;
+		}
+
 		if (m_shadowCasters[aLIGHT_DIRECTIONAL].caster)
 		{
 			m_shadowCasters[aLIGHT_DIRECTIONAL].caster->Drop();
@@ -222,6 +260,12 @@ namespace mash
 			m_pControllerManager->Drop();
 			m_pControllerManager = 0;
 		}
+
+		if (m_ellipsoidColliderManager)
+		{
+			m_ellipsoidColliderManager->Drop();
+			m_ellipsoidColliderManager = 0;
+		}
 	}
 
 	eMASH_STATUS CMashSceneManager::_Initialise(mash::MashVideo *pRenderer, mash::MashInputManager *pInputManager, const mash::sMashDeviceSettings &settings)
@@ -231,6 +275,7 @@ namespace mash
         
 		m_pMeshBuilder = MASH_NEW_COMMON CMashMeshBuilder(m_pRenderer);
 		m_pControllerManager = MASH_NEW_COMMON CMashControllerManager();
+		m_ellipsoidColliderManager = MASH_NEW_COMMON CMashEllipsoidColliderManager();
 
 		//load primitive batch
 		MashMaterialManager *pSkinManager = pRenderer->GetMaterialManager();
@@ -291,6 +336,8 @@ namespace mash
 		m_lookatTrackers.Clear();
 		m_forwardRenderedLightList.Clear();
         m_callbackNodes.Clear();
+		m_lightInfluenceIndex.Clear();
+		m_lightInfluenceIndexSize = 0;
 
 		if (m_forwardLightBuffer)
 		{
@@ -474,6 +521,33 @@ namespace mash
 			}
 			m_pGBufferClearMaterial->Grab();
 
+			/*
+				Tiled lighting materials are optional. If they fail to load then
+				all lights are drawn one pass at a time.
+			*/
+			const MashMaterialManager::eSTANDARD_MATERIAL tiledMaterials[g_gbufferLightingType] = {
+				MashMaterialManager::aSTANDARD_MATERIAL_GBUFFER_TILED_POINT_LIGHT,
+				MashMaterialManager::aSTANDARD_MATERIAL_GBUFFER_TILED_SPOT_LIGHT,
+				MashMaterialManager::aSTANDARD_MATERIAL_GBUFFER_TILED_DIR_LIGHT};
+
+			for(uint32 i = 0; i < g_gbufferLightingType; ++i)
+			{
+				if (m_pGBufferTiledLighting[i])
+					continue;
+
+				m_pGBufferTiledLighting[i] = pSkinManager->GetStandardMaterial(tiledMaterials[i]);
+				if (m_pGBufferTiledLighting[i])
+				{
+					m_pGBufferTiledLighting[i]->Grab();
+				}
+				else
+				{
+					MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_WARNING,
+						"Failed to get gbuffer tiled lighting material. Tiled deferred lighting will be disabled.",
+						"CMashSceneManager::CreateGBuffer");
+				}
+			}
+
 			//set up gbuffer texture targets
 			MashRenderInfo *pRenderInfo = m_pRenderer->GetRenderInfo();
 
@@ -505,6 +579,16 @@ namespace mash
 					return aMASH_FAILED;
 				if (m_pGBufferClearMaterial->CompileTechniques(fileManager, this, aMATERIAL_COMPILER_EVERYTHING) == aMASH_FAILED)
 					return aMASH_FAILED;
+
+				//tiled lighting falls back to per light passes if these fail
+				for(uint32 i = 0; i < g_gbufferLightingType; ++i)
+				{
+					if (m_pGBufferTiledLighting[i] && (m_pGBufferTiledLighting[i]->CompileTechniques(fileManager, this, aMATERIAL_COMPILER_EVERYTHING) == aMASH_FAILED))
+					{
+						m_pGBufferTiledLighting[i]->Drop();
+						m_pGBufferTiledLighting[i] = 0;
+					}
+				}
 				m_pRenderer->GetMaterialManager()->_EndBatchMaterialCompile();
 			}
 
@@ -921,6 +1005,46 @@ namespace mash
 		}
 	}
 
+	void CMashSceneManager::SetForwardLightInfluenceEnabled(bool enable, uint32 maxLightsPerObject)
+	{
+		m_lightInfluenceEnabled = enable;
+		m_maxLightsPerObject = math::Min<uint32>(maxLightsPerObject, g_maxForwardLightsPerObject);
+	}
+
+	void CMashSceneManager::_UpdateLightInfluenceIndex()
+	{
+		/*
+			Lights are only rehashed by the index when they move into new cells so
+			this is cheap for lights that haven't moved.
+		*/
+		const uint32 lightCount = m_forwardRenderedLightList.Size();
+		for(uint32 i = 0; i < lightCount; ++i)
+		{
+			const MashLight *light = m_forwardRenderedLightList[i];
+			if (light->IsLightEnabled() && (light->GetLightType() != aLIGHT_DIRECTIONAL))
+			{
+				const sMashLight *lightData = light->GetLightData();
+				const f32 intensity = math::Max<f32>(lightData->diffuse.r, lightData->diffuse.g, lightData->diffuse.b);
+				m_lightInfluenceIndex.SetLight(i, light->GetRenderTransformState().translation, lightData->range, lightData->atten, intensity);
+			}
+			else
+			{
+				m_lightInfluenceIndex.RemoveLight(i);
+			}
+		}
+
+		for(uint32 i = lightCount; i < m_lightInfluenceIndexSize; ++i)
+			m_lightInfluenceIndex.RemoveLight(i);
+
+		m_lightInfluenceIndexSize = lightCount;
+	}
+
+	void CMashSceneManager::SetDeferredTiledLightingEnabled(bool enable, uint32 tileSize)
+	{
+		m_deferredTiledLightingEnabled = enable;
+		m_deferredLightTileSize = (tileSize < 8) ? 8 : tileSize;
+	}
+
 	void CMashSceneManager::_AddForwardRenderedLight(MashLight *light, bool setAsMain)
 	{
 		bool found = false;
@@ -1130,7 +1254,7 @@ namespace mash
 			const MashVector3 &radius,
 			const MashVector3 &gravity)
 	{
-		MashEllipsoidColliderController *controller = MASH_NEW_COMMON CMashEllipsoidColliderController(character, collisionScene, radius, gravity);
+		MashEllipsoidColliderController *controller = MASH_NEW_COMMON CMashEllipsoidColliderController(character, collisionScene, radius, gravity, m_ellipsoidColliderManager);
 
 		MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_INFORMATION, 
                          "Ellipsoid collision controller created.", 
@@ -1407,6 +1531,11 @@ namespace mash
 					customMaterialName = material->GetMaterialName() + "_PixelLighting";
 					break;
 				}
+			case aLIGHT_TYPE_CLUSTERED:
+				{
+					customMaterialName = material->GetMaterialName() + "_ClusteredLighting";
+					break;
+				}
 			case aLIGHT_TYPE_DEFERRED:
 				{
 					customMaterialName = material->GetMaterialName() + "_VertexLighting";
@@ -1689,38 +1818,110 @@ namespace mash
 	{
 		MashStringc fileExt;
 		CMashSceneLoader *setFileStream = 0;
-		CMashColladaLoader *colladaLoader = 0;
 
-		eMASH_STATUS status = aMASH_OK;
 		const uint32 filenameCount = filenames.Size();
-		for(uint32 i = 0; i < filenameCount; ++i)
+		uint32 maxLoadThreads = (loadSettings.maxLoadThreads == 0) ? jobs::GetHardwareThreadCount() : loadSettings.maxLoadThreads;
+		if (maxLoadThreads > filenameCount)
+			maxLoadThreads = filenameCount;
+
+		/*
+			COLLADA files are loaded in batches of up to maxLoadThreads files. Each batch
+			is parsed in parallel then built here in the order the files were given, so
+			the resulting scene is the same however many threads are used. Loaders are
+			kept between batches so their memory pools are reused.
+		*/
+		MashArray<CMashColladaLoader*> colladaLoaders;
+		MashArray<CMashColladaParseJob*> parseJobs;
+		MashArray<MashJob*> jobList;
+		uint32 colladaFileCount = 0;
+#ifdef MASH_LOG_ENABLED
+		const uint64 loadStartTime = MashDevice::StaticDevice->GetTimer()->GetTimeSinceProgramStart();
+#endif
+
+		eMASH_STATUS status = aMASH_OK;
+		uint32 i = 0;
+		while(i < filenameCount)
 		{
 			fileExt.Clear();
 			GetFileExtention(filenames[i].GetCString(), fileExt);
 
 			if (scriptreader::CompareStrings(fileExt.GetCString(), "dae"))
 			{
-				if (!colladaLoader)
-					colladaLoader = MASH_NEW_COMMON CMashColladaLoader();
+				//file io isn't thread safe so files are opened here
+				uint32 batchSize = 0;
+				jobList.Clear();
+				for(; (i < filenameCount) && (batchSize < maxLoadThreads); ++i)
+				{
+					fileExt.Clear();
+					GetFileExtention(filenames[i].GetCString(), fileExt);
+					if (!scriptreader::CompareStrings(fileExt.GetCString(), "dae"))
+						break;
+
+					if (colladaLoaders.Size() == batchSize)
+					{
+						colladaLoaders.PushBack(MASH_NEW_COMMON CMashColladaLoader());
+						parseJobs.PushBack(MASH_NEW_COMMON CMashColladaParseJob());
+						parseJobs.Back()->loader = colladaLoaders.Back();
+					}
+
+					++colladaFileCount;
+					if (colladaLoaders[batchSize]->Open(MashDevice::StaticDevice, filenames[i]) == aMASH_FAILED)
+					{
+						status = aMASH_FAILED;
+						continue;
+					}
+
+					jobList.PushBack(parseJobs[batchSize]);
+					++batchSize;
+				}
 
-				if (colladaLoader->Load(MashDevice::StaticDevice, filenames[i], rootNodes, loadSettings) == aMASH_FAILED)
-					status = aMASH_FAILED;
+				if (batchSize == 1)
+					parseJobs[0]->Run();
+				else if (batchSize > 1)
+					jobs::RunJobs(jobList.Pointer(), batchSize, maxLoadThreads);
+
+				for(uint32 j = 0; j < batchSize; ++j)
+				{
+					if (parseJobs[j]->status == aMASH_FAILED)
+						status = aMASH_FAILED;
+					else if (colladaLoaders[j]->Build(rootNodes, loadSettings) == aMASH_FAILED)
+						status = aMASH_FAILED;
+				}
 			}
-			else if(scriptreader::CompareStrings(fileExt.GetCString(), "nss"))
+			else
 			{
-				if (!setFileStream)
-					setFileStream = MASH_NEW_T_COMMON(CMashSceneLoader)();
+				if(scriptreader::CompareStrings(fileExt.GetCString(), "nss"))
+				{
+					if (!setFileStream)
+						setFileStream = MASH_NEW_T_COMMON(CMashSceneLoader)();
+
+					if (setFileStream->LoadSETFile(MashDevice::StaticDevice, filenames[i].GetCString(), rootNodes, loadSettings) == aMASH_FAILED)
+						status = aMASH_FAILED;
+				}
 
-				if (setFileStream->LoadSETFile(MashDevice::StaticDevice, filenames[i].GetCString(), rootNodes, loadSettings) == aMASH_FAILED)
-					status = aMASH_FAILED;
+				++i;
 			}
 		}
 
+		if (colladaFileCount > 1)
+		{
+			MASH_WRITE_TO_LOG_EX(MashLog::aERROR_LEVEL_INFORMATION, 
+					"CMashSceneManager::LoadSceneFile",
+					"Loaded '%u' Collada files in '%u' ms using up to '%u' threads.",
+					colladaFileCount, 
+					(uint32)(MashDevice::StaticDevice->GetTimer()->GetTimeSinceProgramStart() - loadStartTime),
+					maxLoadThreads);
+		}
+
 		if (setFileStream)
 			MASH_DELETE_T(CMashSceneLoader, setFileStream);
 
-		if (colladaLoader)
-			MASH_DELETE_T(CMashColladaLoader, colladaLoader);
+		const uint32 colladaLoaderCount = colladaLoaders.Size();
+		for(uint32 j = 0; j < colladaLoaderCount; ++j)
+		{
+			MASH_DELETE parseJobs[j];
+			MASH_DELETE_T(CMashColladaLoader, colladaLoaders[j]);
+		}
 
 		return status;
 	}
@@ -2044,6 +2245,11 @@ namespace mash
 		return MASH_NEW_COMMON CMashSkin(m_pRenderer);
 	}
 
+	MashSkinPaletteBuffer* CMashSceneManager::CreateSkinPaletteBuffer()
+	{
+		return MASH_NEW_COMMON CMashSkinPaletteBuffer(m_pRenderer);
+	}
+
 	MashBone* CMashSceneManager::AddBone(MashSceneNode *parent,
 		const MashStringc &name)
 	{
@@ -2116,6 +2322,11 @@ namespace mash
 					customMaterialName = material->GetMaterialName() + "_PixelLighting";
 					break;
 				}
+			case aLIGHT_TYPE_CLUSTERED:
+				{
+					customMaterialName = material->GetMaterialName() + "_ClusteredLighting";
+					break;
+				}
 			case aLIGHT_TYPE_DEFERRED:
 				{
 					customMaterialName = material->GetMaterialName() + "_VertexLighting";
@@ -2274,6 +2485,15 @@ namespace mash
 
 				if (m_rebuildShaderState & aREBUILD_DEFERRED_SPOT_SHADER)
 					m_pGBufferLighting[mash::aLIGHT_SPOT]->CompileTechniques(fileManager, this, aMATERIAL_COMPILER_EVERYTHING, 0, 0);
+
+				if (m_pGBufferTiledLighting[mash::aLIGHT_DIRECTIONAL] && (m_rebuildShaderState & aREBUILD_DEFERRED_DIR_SHADER))
+					m_pGBufferTiledLighting[mash::aLIGHT_DIRECTIONAL]->CompileTechniques(fileManager, this, aMATERIAL_COMPILER_EVERYTHING, 0, 0);
+
+				if (m_pGBufferTiledLighting[mash::aLIGHT_POINT] && (m_rebuildShaderState & aREBUILD_DEFERRED_POINT_SHADER))
+					m_pGBufferTiledLighting[mash::aLIGHT_POINT]->CompileTechniques(fileManager, this, aMATERIAL_COMPILER_EVERYTHING, 0, 0);
+
+				if (m_pGBufferTiledLighting[mash::aLIGHT_SPOT] && (m_rebuildShaderState & aREBUILD_DEFERRED_SPOT_SHADER))
+					m_pGBufferTiledLighting[mash::aLIGHT_SPOT]->CompileTechniques(fileManager, this, aMATERIAL_COMPILER_EVERYTHING, 0, 0);
 			}
 
 			if (m_rebuildShaderState & aREBUILD_FORWARD_RENDERED_SCENE)
@@ -2332,6 +2552,9 @@ namespace mash
 		{
 			m_callbackNodes[i]->_UpdateCallbacks(dt);
 		}
+
+		//ellipsoid controllers queue themselves from their callbacks
+		m_ellipsoidColliderManager->Update();
         
         m_pControllerManager->Update(dt);
 	}
@@ -2578,10 +2801,7 @@ namespace mash
 				return aMASH_FAILED;
 			}
             
-			MashList<sSolidRenderable>::Iterator iter = m_shadowRenderables.Begin();
-			MashList<sSolidRenderable>::Iterator end = m_shadowRenderables.End();
-			for(; iter != end; ++iter)
-				iter->pRenderable->Draw();
+			m_shadowRenderables.Draw();
 
 			_FlushRenderableBatches();
 		}
@@ -2618,19 +2838,33 @@ namespace mash
 			{
 				if (IsTransparentObjectShadowCastingEnabled())
 				{
-					m_shadowRenderables.PushBack(sSolidRenderable(pRenderable));
+					m_shadowRenderables.AddSolid(pRenderable);
 					++m_sceneRenderInfo.shadowObjectCount;
 				}
 			}
 			else
 			{
-				m_shadowRenderables.PushBack(sSolidRenderable(pRenderable));
+				m_shadowRenderables.AddSolid(pRenderable);
 				++m_sceneRenderInfo.shadowObjectCount;
 			}
 			
 		}
 		else
 		{
+			//pick the lights for forward rendered objects
+			uint32 lightSlot = 0;
+			uint32 lightCount = 0;
+			if (_IsLightInfluenceActive() && (activeTechnique->GetRenderPass(this) != aPASS_DEFERRED))
+			{
+				uint32 lights[g_maxForwardLightsPerObject];
+				lightSlot = m_forwardLightSlots.Size();
+				lightCount = m_lightInfluenceIndex.GetInfluences(pRenderable->GetWorldBoundingBox(), m_maxLightsPerObject, lights);
+				if ((lightSlot + lightCount) > m_forwardLightSlots.ReservedSize())
+					++m_forwardLightSlotAllocationCount;
+
+				m_forwardLightSlots.Append(lights, lightCount);
+			}
+
 			switch(pass)
 			{
 			case aHLPASS_SCENE:
@@ -2638,19 +2872,19 @@ namespace mash
 				{
 					case aPASS_SOLID:
 						{
-							m_solidRenderables.PushBack(sSolidRenderable(pRenderable));
+							m_solidRenderables.AddSolid(pRenderable, lightSlot, lightCount);
 							++m_sceneRenderInfo.forwardRenderedSolidObjectCount;
 							break;
 						}
 					case aPASS_TRANSPARENT:
 						{
-							m_transparentRenderables.PushBack(sTransparentRenderable(pRenderable, m_pActiveCamera));
+							m_transparentRenderables.AddTransparent(pRenderable, m_pActiveCamera, lightSlot, lightCount);
 							++m_sceneRenderInfo.forwardRenderedTransparentObjectCount;
 							break;
 						}
 					case aPASS_DEFERRED:
 						{
-							m_deferredRenderables.PushBack(sSolidRenderable(pRenderable));
+							m_deferredRenderables.AddSolid(pRenderable);
 							++m_sceneRenderInfo.deferredObjectSolidCount;
 							break;
 						}
@@ -2661,19 +2895,19 @@ namespace mash
 					{
 					case aPASS_SOLID:
 						{
-							m_solidParticles.PushBack(sSolidRenderable(pRenderable));
+							m_solidParticles.AddSolid(pRenderable, lightSlot, lightCount);
 							++m_sceneRenderInfo.forwardRenderedSolidObjectCount;
 							break;
 						}
 					case aPASS_TRANSPARENT:
 						{
-							m_transparentParticles.PushBack(sTransparentRenderable(pRenderable, m_pActiveCamera));
+							m_transparentParticles.AddTransparent(pRenderable, m_pActiveCamera, lightSlot, lightCount);
 							++m_sceneRenderInfo.forwardRenderedTransparentObjectCount;
 							break;
 						}
 					case aPASS_DEFERRED:
 						{
-							m_deferredParticles.PushBack(sSolidRenderable(pRenderable));
+							m_deferredParticles.AddSolid(pRenderable);
 							++m_sceneRenderInfo.deferredObjectSolidCount;
 							break;
 						}
@@ -2684,19 +2918,19 @@ namespace mash
 					{
 					case aPASS_SOLID:
 						{
-							m_solidDecals.PushBack(sSolidRenderable(pRenderable));
+							m_solidDecals.AddSolid(pRenderable, lightSlot, lightCount);
 							++m_sceneRenderInfo.forwardRenderedSolidObjectCount;
 							break;
 						}
 					case aPASS_TRANSPARENT:
 						{
-							m_transparentDecals.PushBack(sTransparentRenderable(pRenderable, m_pActiveCamera));
+							m_transparentDecals.AddTransparent(pRenderable, m_pActiveCamera, lightSlot, lightCount);
 							++m_sceneRenderInfo.forwardRenderedTransparentObjectCount;
 							break;
 						}
 					case aPASS_DEFERRED:
 						{
-							m_deferredDecals.PushBack(sSolidRenderable(pRenderable));
+							m_deferredDecals.AddSolid(pRenderable);
 							++m_sceneRenderInfo.deferredObjectSolidCount;
 							break;
 						}
@@ -2712,6 +2946,10 @@ namespace mash
 		m_sceneRenderInfo.forwardRenderedSolidObjectCount = 0;
 		m_sceneRenderInfo.forwardRenderedTransparentObjectCount = 0;
 		m_sceneRenderInfo.shadowObjectCount = 0;
+		m_sceneRenderInfo.renderQueueAllocationCount = 0;
+		m_sceneRenderInfo.deferredLightPassCount = 0;
+		m_sceneRenderInfo.deferredLightPassesSaved = 0;
+		m_sceneRenderInfo.forwardLightsSkipped = 0;
 
 		if (!m_pActiveCamera)
 		{
@@ -2722,6 +2960,10 @@ namespace mash
 			return aMASH_FAILED;
 		}
 
+		//must be up to date before objects are added to the render queues
+		if (_IsLightInfluenceActive())
+			_UpdateLightInfluenceIndex();
+
 		//make sure the camera is fully updated
         /*
             This is done here so that any internal data waiting on cull pass
@@ -2779,7 +3021,19 @@ namespace mash
 			if (!isForwardRendererEmpty)
 				DrawForwardRenderedScene();
 
-			//clear render buckets.
+			m_sceneRenderInfo.renderQueueAllocationCount = m_solidRenderables.GetAllocationCount() +
+				m_transparentRenderables.GetAllocationCount() +
+				m_solidDecals.GetAllocationCount() +
+				m_transparentDecals.GetAllocationCount() +
+				m_solidParticles.GetAllocationCount() +
+				m_transparentParticles.GetAllocationCount() +
+				m_deferredRenderables.GetAllocationCount() +
+				m_deferredDecals.GetAllocationCount() +
+				m_deferredParticles.GetAllocationCount() +
+				m_shadowRenderables.GetAllocationCount() +
+				m_forwardLightSlotAllocationCount;
+
+			//clear render buckets. Memory is kept for the next frame.
 			m_solidRenderables.Clear();
 			m_transparentRenderables.Clear();
 			m_solidDecals.Clear();
@@ -2791,6 +3045,8 @@ namespace mash
 			m_deferredParticles.Clear();
 			m_batchFlushList.Clear();
 			m_shadowRenderables.Clear();
+			m_forwardLightSlots.Clear();
+			m_forwardLightSlotAllocationCount = 0;
 			m_currentRenderSceneLightList.Clear();
 
 			m_shadowSceneBounds.min = MashVector3(mash::math::MaxInt32(), mash::math::MaxInt32(), mash::math::MaxInt32());
@@ -2800,6 +3056,157 @@ namespace mash
 		return aMASH_OK;
 	}
 
+	eMASH_STATUS CMashSceneManager::_UpdateLightClusters()
+	{
+		MashRenderInfo *renderInfo = m_pRenderer->GetRenderInfo();
+		renderInfo->SetLightClusters(0, 0, 0, MashVector4(0.0f, 0.0f, 0.0f, 0.0f));
+
+		if (!m_pActiveCamera)
+			return aMASH_OK;
+
+		m_lightClusterGrid.SetProjection(m_pActiveCamera->GetFOV(), m_pActiveCamera->GetAspect(), 
+			m_pActiveCamera->GetNear(), m_pActiveCamera->GetFar());
+
+		const uint32 lightCount = m_currentRenderSceneLightList.Size();
+		m_lightClusterGrid.Build(m_currentRenderSceneLightList.Pointer(), lightCount);
+
+		/*
+			Texture layout, all data is float4,
+			[light data][cluster records][light indices]
+			Light data is sMashLight for each light in the cluster grid.
+			Cluster records are (offset, count, 0, 0).
+			Light indices are packed 4 per texel.
+		*/
+		const uint32 texelSize = sizeof(f32) * 4;
+		const uint32 texelsPerLight = (sizeof(sMashLight) + texelSize - 1) / texelSize;
+		const uint32 clusterCount = m_lightClusterGrid.GetClusterCount();
+		const uint32 indexCount = m_lightClusterGrid.GetLightIndexCount();
+		const uint32 clusterStart = lightCount * texelsPerLight;
+		const uint32 indexStart = clusterStart + clusterCount;
+		const uint32 texelCount = indexStart + ((indexCount + 3) / 4);
+		const uint32 rowCount = (texelCount + g_lightClusterTextureWidth - 1) / g_lightClusterTextureWidth;
+
+		if (!m_lightClusterTextureState)
+		{
+			//data must not be filtered
+			sSamplerState state;
+			state.type = aSAMPLER2D;
+			state.filter = aFILTER_MIN_MAG_MIP_POINT;
+			state.uMode = aTEXTURE_ADDRESS_CLAMP;
+			state.vMode = aTEXTURE_ADDRESS_CLAMP;
+			m_lightClusterTextureState = m_pRenderer->AddSamplerState(state);
+			if (!m_lightClusterTextureState)
+			{
+				MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR,
+					"Failed to create light cluster sampler state.",
+					"CMashSceneManager::_UpdateLightClusters");
+
+				return aMASH_FAILED;
+			}
+
+			m_lightClusterTextureState->Grab();
+		}
+
+		if (!m_lightClusterTexture || (rowCount > m_lightClusterTextureRowCount))
+		{
+			if (m_lightClusterTexture)
+			{
+				m_pRenderer->RemoveTextureFromCache(m_lightClusterTexture);
+				m_lightClusterTexture = 0;
+			}
+
+			//grow in powers of two so changing light counts don't recreate the texture each frame
+			uint32 newRowCount = (m_lightClusterTextureRowCount > 0) ? m_lightClusterTextureRowCount : 1;
+			while(newRowCount < rowCount)
+				newRowCount *= 2;
+
+			m_lightClusterTexture = m_pRenderer->AddTexture("", g_lightClusterTextureWidth, newRowCount, false, aUSAGE_DYNAMIC, aFORMAT_RGBA32_FLOAT);
+			if (!m_lightClusterTexture)
+			{
+				m_lightClusterTextureRowCount = 0;
+
+				MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR,
+					"Failed to create light cluster texture.",
+					"CMashSceneManager::_UpdateLightClusters");
+
+				return aMASH_FAILED;
+			}
+
+			m_lightClusterTextureRowCount = newRowCount;
+		}
+
+		void *textureData = 0;
+		uint32 rowPitch = 0;
+		if (m_lightClusterTexture->Lock(aLOCK_WRITE_DISCARD, &textureData, 0, 0, &rowPitch) == aMASH_FAILED)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR,
+				"Failed to lock light cluster texture.",
+				"CMashSceneManager::_UpdateLightClusters");
+
+			return aMASH_FAILED;
+		}
+
+		//data is written linearly so padded rows are filled from a packed copy after
+		const uint32 rowSize = g_lightClusterTextureWidth * texelSize;
+		f32 *texels = (f32*)textureData;
+		if (rowPitch != rowSize)
+		{
+			m_lightClusterPaddedRowData.Resize(rowCount * g_lightClusterTextureWidth * 4);
+			texels = m_lightClusterPaddedRowData.Pointer();
+		}
+
+		for(uint32 i = 0; i < lightCount; ++i)
+		{
+			f32 *lightTexels = texels + (i * texelsPerLight * 4);
+			memset(lightTexels, 0, texelsPerLight * texelSize);
+
+			const MashLight *light = m_currentRenderSceneLightList[i];
+			if (light->IsLightEnabled())
+				memcpy(lightTexels, light->GetLightData(), sizeof(sMashLight));
+		}
+
+		const MashLightClusterGrid::sCluster *clusters = m_lightClusterGrid.GetClusters();
+		f32 *clusterTexels = texels + (clusterStart * 4);
+		for(uint32 i = 0; i < clusterCount; ++i)
+		{
+			clusterTexels[(i * 4)] = (f32)clusters[i].offset;
+			clusterTexels[(i * 4) + 1] = (f32)clusters[i].count;
+			clusterTexels[(i * 4) + 2] = 0.0f;
+			clusterTexels[(i * 4) + 3] = 0.0f;
+		}
+
+		const uint32 *indices = m_lightClusterGrid.GetLightIndices();
+		f32 *indexTexels = texels + (indexStart * 4);
+		for(uint32 i = 0; i < indexCount; ++i)
+			indexTexels[i] = (f32)indices[i];
+
+		//pad the last texel
+		for(uint32 i = indexCount; i < ((indexCount + 3) & ~3); ++i)
+			indexTexels[i] = 0.0f;
+
+		if (rowPitch != rowSize)
+		{
+			uint8 *row = (uint8*)textureData;
+			for(uint32 i = 0; i < rowCount; ++i)
+			{
+				memcpy(row, texels + (i * g_lightClusterTextureWidth * 4), rowSize);
+				row += rowPitch;
+			}
+		}
+
+		if (m_lightClusterTexture->Unlock() == aMASH_FAILED)
+			return aMASH_FAILED;
+
+		const MashVector4 layout((f32)clusterStart, 
+			(f32)indexStart, 
+			1.0f / (f32)g_lightClusterTextureWidth, 
+			1.0f / (f32)m_lightClusterTextureRowCount);
+
+		renderInfo->SetLightClusters(&m_lightClusterGrid, m_lightClusterTexture, m_lightClusterTextureState, layout);
+
+		return aMASH_OK;
+	}
+
 	eMASH_STATUS CMashSceneManager::DrawForwardRenderedScene()
 	{
 		//sort render buckets
@@ -2842,7 +3249,31 @@ namespace mash
 		}
 
 		m_pRenderer->GetRenderInfo()->SetLightBuffer(m_forwardLightBuffer, forwardLightCount);
+
+		if (_IsLightInfluenceActive())
+		{
+			/*
+				Objects start with all point and spot lights turned off. The lights
+				assigned to an object are turned on while it's drawn.
+			*/
+			m_forwardObjectLightBuffer.Resize(forwardLightCount);
+			m_forwardLocalLightCount = 0;
+			for(uint32 i = 0; i < forwardLightCount; ++i)
+			{
+				m_forwardObjectLightBuffer[i] = m_forwardLightBuffer[i];
+				if (m_forwardRenderedLightList[i]->GetLightType() != aLIGHT_DIRECTIONAL)
+				{
+					m_forwardObjectLightBuffer[i].range = 0.0f;
+					++m_forwardLocalLightCount;
+				}
+			}
+		}
 		
+		if (m_preferredLightingMode == aLIGHT_TYPE_CLUSTERED)
+			_UpdateLightClusters();
+		else
+			m_pRenderer->GetRenderInfo()->SetLightClusters(0, 0, 0, MashVector4(0.0f, 0.0f, 0.0f, 0.0f));
+
 		/*
 			Set up the main light and do shadow map pass.
 
@@ -2918,18 +3349,12 @@ namespace mash
 		*/
 
 		//draw solid objects
-		MashList<sSolidRenderable>::Iterator iter = m_solidRenderables.Begin();
-		MashList<sSolidRenderable>::Iterator end = m_solidRenderables.End();
-		for(; iter != end; ++iter)
-			iter->pRenderable->Draw();
+		_DrawForwardQueue(m_solidRenderables);
 
 		_FlushRenderableBatches();
 		
 		//draw solid particles
-		iter = m_solidParticles.Begin();
-		end = m_solidParticles.End();
-		for(; iter != end; ++iter)
-			iter->pRenderable->Draw();
+		_DrawForwardQueue(m_solidParticles);
 
 		_FlushRenderableBatches();
 
@@ -2937,17 +3362,11 @@ namespace mash
 		if (!m_solidDecals.Empty() || !m_transparentDecals.Empty())
 		{
 			//render decals
-			MashList<sSolidRenderable>::Iterator solidDecalIter = m_solidDecals.Begin();
-			MashList<sSolidRenderable>::Iterator solidDecalEnd = m_solidDecals.End();
-			for(; solidDecalIter != solidDecalEnd; ++solidDecalIter)
-				solidDecalIter->pRenderable->Draw();
+			_DrawForwardQueue(m_solidDecals);
 
 			_FlushRenderableBatches();
 
-			MashList<sTransparentRenderable>::Iterator transDecalIter = m_transparentDecals.Begin();
-			MashList<sTransparentRenderable>::Iterator transDecalEnd = m_transparentDecals.End();
-			for(; transDecalIter != transDecalEnd; ++transDecalIter)
-				transDecalIter->pRenderable->Draw();
+			_DrawForwardQueue(m_transparentDecals);
 
 			_FlushRenderableBatches();
 		}
@@ -2958,24 +3377,260 @@ namespace mash
 		*/
 
 		//draw transparent objects
-		MashList<sTransparentRenderable>::Iterator transparentIter = m_transparentRenderables.Begin();
-		MashList<sTransparentRenderable>::Iterator transparentEnd = m_transparentRenderables.End();
-		for(; transparentIter != transparentEnd; ++transparentIter)
-			transparentIter->pRenderable->Draw();
+		_DrawForwardQueue(m_transparentRenderables);
 
 		_FlushRenderableBatches();
 
 		//draw transparent particles
-		transparentIter = m_transparentParticles.Begin();
-		transparentEnd = m_transparentParticles.End();
-		for(; transparentIter != transparentEnd; ++transparentIter)
-			transparentIter->pRenderable->Draw();
+		_DrawForwardQueue(m_transparentParticles);
 
 		_FlushRenderableBatches();
 
 		return aMASH_OK;
 	}
 
+	void CMashSceneManager::_DrawForwardQueue(const CMashRenderQueue &queue)
+	{
+		if (!_IsLightInfluenceActive())
+		{
+			queue.Draw();
+			return;
+		}
+
+		MashRenderInfo *renderInfo = m_pRenderer->GetRenderInfo();
+		const uint32 forwardLightCount = m_forwardRenderedLightList.Size();
+		sMashLight *objectLights = m_forwardObjectLightBuffer.Pointer();
+		const uint32 *slots = m_forwardLightSlots.Pointer();
+
+		const CMashRenderQueue::sEntry *entries = queue.GetEntries();
+		const uint32 entryCount = queue.Size();
+		for(uint32 i = 0; i < entryCount; ++i)
+		{
+			const CMashRenderQueue::sEntry &entry = entries[i];
+
+			/*
+				Batched objects are drawn when the batch is flushed, after this loop,
+				so they use the full light buffer.
+			*/
+			if (entry.renderable->GetMaterial()->GetCustomRenderPath())
+			{
+				renderInfo->SetLightBuffer(m_forwardLightBuffer, forwardLightCount);
+				entry.renderable->Draw();
+				continue;
+			}
+
+			//lights removed since the cull are skipped
+			const uint32 *objectSlots = slots + entry.lightSlot;
+			for(uint32 j = 0; j < entry.lightCount; ++j)
+			{
+				if (objectSlots[j] < forwardLightCount)
+					objectLights[objectSlots[j]].range = m_forwardLightBuffer[objectSlots[j]].range;
+			}
+
+			renderInfo->SetLightBuffer(objectLights, forwardLightCount);
+			entry.renderable->Draw();
+
+			for(uint32 j = 0; j < entry.lightCount; ++j)
+			{
+				if (objectSlots[j] < forwardLightCount)
+					objectLights[objectSlots[j]].range = 0.0f;
+			}
+
+			if (m_forwardLocalLightCount > entry.lightCount)
+				m_sceneRenderInfo.forwardLightsSkipped += m_forwardLocalLightCount - entry.lightCount;
+		}
+
+		renderInfo->SetLightBuffer(m_forwardLightBuffer, forwardLightCount);
+	}
+
+	void CMashSceneManager::_CalculateDeferredTileDepths(const CMashRenderQueue &queue, uint32 tilesX, uint32 tilesY)
+	{
+		/*
+			The depth buffer can't be read back without stalling so tile depth
+			ranges are estimated from the view space bounds of everything
+			written to the gbuffer. This is conservative, a tile may be given a
+			larger range than the pixels within it.
+		*/
+		const MashMatrix4 &view = m_pActiveCamera->GetView();
+		const f32 zNear = m_pActiveCamera->GetNear();
+		const f32 zFar = m_pActiveCamera->GetFar();
+		const f32 tanHalfFovY = tanf(m_pActiveCamera->GetFOV() * 0.5f);
+		const f32 tanHalfFovX = tanHalfFovY * m_pActiveCamera->GetAspect();
+
+		f32 *minDepths = m_deferredTileMinDepth.Pointer();
+		f32 *maxDepths = m_deferredTileMaxDepth.Pointer();
+
+		MashAABB viewBounds;
+		const CMashRenderQueue::sEntry *entries = queue.GetEntries();
+		const uint32 entryCount = queue.Size();
+		for(uint32 i = 0; i < entryCount; ++i)
+		{
+			entries[i].renderable->GetWorldBoundingBox().Transform(view, viewBounds);
+
+			if ((viewBounds.max.z < zNear) || (viewBounds.min.z > zFar))
+				continue;
+
+			const f32 minZ = (viewBounds.min.z > zNear) ? viewBounds.min.z : zNear;
+			const f32 maxZ = (viewBounds.max.z < zFar) ? viewBounds.max.z : zFar;
+
+			uint32 firstX = 0;
+			uint32 lastX = tilesX - 1;
+			uint32 firstY = 0;
+			uint32 lastY = tilesY - 1;
+
+			//boxes crossing the near plane may cover any part of the screen
+			if (viewBounds.min.z > zNear)
+			{
+				//smallest and largest x/z and y/z over the box
+				f32 ndcMinX = ((viewBounds.min.x < 0.0f) ? viewBounds.min.x / minZ : viewBounds.min.x / maxZ) / tanHalfFovX;
+				f32 ndcMaxX = ((viewBounds.max.x > 0.0f) ? viewBounds.max.x / minZ : viewBounds.max.x / maxZ) / tanHalfFovX;
+				f32 ndcMinY = ((viewBounds.min.y < 0.0f) ? viewBounds.min.y / minZ : viewBounds.min.y / maxZ) / tanHalfFovY;
+				f32 ndcMaxY = ((viewBounds.max.y > 0.0f) ? viewBounds.max.y / minZ : viewBounds.max.y / maxZ) / tanHalfFovY;
+
+				if ((ndcMaxX < -1.0f) || (ndcMinX > 1.0f) || (ndcMaxY < -1.0f) || (ndcMinY > 1.0f))
+					continue;
+
+				ndcMinX = math::Clamp<f32>(-1.0f, 1.0f, ndcMinX);
+				ndcMaxX = math::Clamp<f32>(-1.0f, 1.0f, ndcMaxX);
+				ndcMinY = math::Clamp<f32>(-1.0f, 1.0f, ndcMinY);
+				ndcMaxY = math::Clamp<f32>(-1.0f, 1.0f, ndcMaxY);
+
+				firstX = math::Min<uint32>((uint32)((ndcMinX * 0.5f + 0.5f) * tilesX), tilesX - 1);
+				lastX = math::Min<uint32>((uint32)((ndcMaxX * 0.5f + 0.5f) * tilesX), tilesX - 1);
+				firstY = math::Min<uint32>((uint32)((ndcMinY * 0.5f + 0.5f) * tilesY), tilesY - 1);
+				lastY = math::Min<uint32>((uint32)((ndcMaxY * 0.5f + 0.5f) * tilesY), tilesY - 1);
+			}
+
+			for(uint32 y = firstY; y <= lastY; ++y)
+			{
+				for(uint32 x = firstX; x <= lastX; ++x)
+				{
+					const uint32 tile = (y * tilesX) + x;
+					if (minZ < minDepths[tile])
+						minDepths[tile] = minZ;
+					if (maxZ > maxDepths[tile])
+						maxDepths[tile] = maxZ;
+				}
+			}
+		}
+	}
+
+	void CMashSceneManager::_DrawDeferredTiledLights(const sMashViewPort &viewport)
+	{
+		const uint32 tiledLightCount = m_deferredTiledLights.Size();
+		if (tiledLightCount == 0)
+			return;
+
+		if ((viewport.width <= 0) || (viewport.height <= 0))
+			return;
+
+		const uint32 tilesX = ((uint32)viewport.width + m_deferredLightTileSize - 1) / m_deferredLightTileSize;
+		const uint32 tilesY = ((uint32)viewport.height + m_deferredLightTileSize - 1) / m_deferredLightTileSize;
+
+		m_deferredLightTiles.SetGridSize(tilesX, tilesY, g_deferredLightTileSlices);
+		m_deferredLightTiles.SetProjection(m_pActiveCamera->GetFOV(), m_pActiveCamera->GetAspect(), 
+			m_pActiveCamera->GetNear(), m_pActiveCamera->GetFar());
+		m_deferredLightTiles.Build(m_deferredTiledLights.Pointer(), tiledLightCount);
+
+		const uint32 tileCount = tilesX * tilesY;
+		m_deferredTileMinDepth.Resize(tileCount);
+		m_deferredTileMaxDepth.Resize(tileCount);
+		for(uint32 i = 0; i < tileCount; ++i)
+		{
+			m_deferredTileMinDepth[i] = math::MaxFloat();
+			m_deferredTileMaxDepth[i] = math::MinFloat();
+		}
+
+		_CalculateDeferredTileDepths(m_deferredRenderables, tilesX, tilesY);
+		_CalculateDeferredTileDepths(m_deferredParticles, tilesX, tilesY);
+		_CalculateDeferredTileDepths(m_deferredDecals, tilesX, tilesY);
+
+		//unused batch slots are filled with a light that adds nothing
+		sMashLight nullLight = sMashLight();
+		nullLight.direction = MashVector3(0.0f, 0.0f, 1.0f);
+		nullLight.viewSpaceDirection = MashVector3(0.0f, 0.0f, 1.0f);
+		nullLight.atten = MashVector3(0.0f, 0.0f, 1.0f);
+
+		MashVector2 rtDim = m_pGBufferRT->GetDimentions();
+		mash::MashRectangle2 zoomRegion((f32)viewport.x / rtDim.x, (f32)viewport.y / rtDim.y, 
+			((f32)viewport.x + viewport.width) / rtDim.x, ((f32)viewport.y + viewport.height) / rtDim.y);
+
+		MashRenderInfo *renderInfo = m_pRenderer->GetRenderInfo();
+		uint32 passCount = 0;
+
+		for(uint32 y = 0; y < tilesY; ++y)
+		{
+			for(uint32 x = 0; x < tilesX; ++x)
+			{
+				const uint32 tile = (y * tilesX) + x;
+
+				//nothing was written to this tile
+				if (m_deferredTileMinDepth[tile] > m_deferredTileMaxDepth[tile])
+					continue;
+
+				const uint32 tileLightCount = m_deferredLightTiles.GetTileLights(x, y, 
+					m_deferredTileMinDepth[tile], m_deferredTileMaxDepth[tile], m_deferredTileLightIndices);
+
+				if (tileLightCount == 0)
+					continue;
+
+				//tile row 0 is the bottom of the viewport
+				const mash::MashRectangle2 region((f32)x / tilesX, 1.0f - ((f32)(y + 1) / tilesY), 
+					(f32)(x + 1) / tilesX, 1.0f - ((f32)y / tilesY));
+
+				const mash::MashRectangle2 texCoords(math::Lerp(zoomRegion.left, zoomRegion.right, region.left), 
+					math::Lerp(zoomRegion.top, zoomRegion.bottom, region.top),
+					math::Lerp(zoomRegion.left, zoomRegion.right, region.right),
+					math::Lerp(zoomRegion.top, zoomRegion.bottom, region.bottom));
+
+				for(uint32 lightType = 0; lightType < g_gbufferLightingType; ++lightType)
+				{
+					uint32 current = 0;
+					while(current < tileLightCount)
+					{
+						MashLight *firstLight = 0;
+						uint32 batchCount = 0;
+						for(; (current < tileLightCount) && (batchCount < g_deferredTiledLightBatchSize); ++current)
+						{
+							MashLight *light = m_deferredTiledLights[m_deferredTileLightIndices[current]];
+							if (light->GetLightType() != (eLIGHTTYPE)lightType)
+								continue;
+
+							if (!firstLight)
+								firstLight = light;
+
+							m_deferredTiledLightBatch[batchCount++] = *light->GetLightData();
+						}
+
+						if (batchCount == 0)
+							break;
+
+						for(uint32 i = batchCount; i < g_deferredTiledLightBatchSize; ++i)
+							m_deferredTiledLightBatch[i] = nullLight;
+
+						renderInfo->SetLight(firstLight);
+						renderInfo->SetLightBuffer(m_deferredTiledLightBatch, g_deferredTiledLightBatchSize);
+
+						if (m_pGBufferTiledLighting[lightType]->OnSet() == aMASH_OK)
+						{
+							m_pRenderer->DrawQuadRegion(region, texCoords);
+							++passCount;
+						}
+					}
+				}
+			}
+		}
+
+		m_sceneRenderInfo.deferredLightPassCount += passCount;
+
+		/*
+			Compared to one full screen pass per light. A few lights spread over
+			many tiles can take more passes than that, which counts as none saved.
+		*/
+		if (tiledLightCount > passCount)
+			m_sceneRenderInfo.deferredLightPassesSaved += tiledLightCount - passCount;
+	}
+
 	eMASH_STATUS CMashSceneManager::DrawDeferredScene()
 	{
 		if (!m_deferredRendererValid)
@@ -3029,18 +3684,12 @@ namespace mash
         m_pRenderer->SetViewport(originalViewport);
 
 		//draw solid objects
-		MashList<sSolidRenderable>::Iterator iter = m_deferredRenderables.Begin();
-		MashList<sSolidRenderable>::Iterator end = m_deferredRenderables.End();
-		for(; iter != end; ++iter)
-			iter->pRenderable->Draw();
+		m_deferredRenderables.Draw();
 
 		_FlushRenderableBatches();
 		
 		//draw solid particles
-		iter = m_deferredParticles.Begin();
-		end = m_deferredParticles.End();
-		for(; iter != end; ++iter)
-			iter->pRenderable->Draw();
+		m_deferredParticles.Draw();
 
 		_FlushRenderableBatches();
 
@@ -3048,10 +3697,7 @@ namespace mash
 		if (!m_deferredDecals.Empty())
 		{
 			//render decals
-			MashList<sSolidRenderable>::Iterator solidDecalIter = m_deferredDecals.Begin();
-			MashList<sSolidRenderable>::Iterator solidDecalEnd = m_deferredDecals.End();
-			for(; solidDecalIter != solidDecalEnd; ++solidDecalIter)
-				solidDecalIter->pRenderable->Draw();
+			m_deferredDecals.Draw();
 
 			_FlushRenderableBatches();
 		}
@@ -3061,10 +3707,29 @@ namespace mash
 		m_pRenderer->ClearTarget(mash::aCLEAR_TARGET, mash::sMashColour4(0.0f, 0.0f, 0.0f, 0.0f), 1.0f);
         m_pRenderer->SetViewport(originalViewport);
 
+		/*
+			Lights without shadows can be batched over screen tiles. Shadowed lights
+			still need their own shadow map so they are drawn one at a time.
+		*/
+		const bool drawTiledLights = m_deferredTiledLightingEnabled && m_pActiveCamera &&
+			m_pGBufferTiledLighting[mash::aLIGHT_DIRECTIONAL] &&
+			m_pGBufferTiledLighting[mash::aLIGHT_SPOT] &&
+			m_pGBufferTiledLighting[mash::aLIGHT_POINT];
+
+		m_deferredTiledLights.Clear();
+
 		for(int32 i = 0 ; i < m_currentRenderSceneLightList.Size(); ++i)
 		{
-			//set main light
 			MashLight *pLight = m_currentRenderSceneLightList[i];
+			if (drawTiledLights && !pLight->IsShadowsEnabled())
+			{
+				if (pLight->IsLightEnabled())
+					m_deferredTiledLights.PushBack(pLight);
+
+				continue;
+			}
+
+			//set main light
 			m_pRenderer->GetRenderInfo()->SetLight(pLight);
 			m_pRenderer->GetRenderInfo()->SetLightBuffer(pLight->GetLightData(), 1);
 
@@ -3133,9 +3798,13 @@ namespace mash
 					((f32)originalViewport.x + originalViewport.width) / rtDim.x, ((f32)originalViewport.y + originalViewport.height) / rtDim.y);
 
 				m_pRenderer->DrawFullScreenQuadTexCoords(zoomRegion);
+				++m_sceneRenderInfo.deferredLightPassCount;
 			}
 		}
 
+		if (drawTiledLights)
+			_DrawDeferredTiledLights(originalViewport);
+
 		if (pOriginalTarget)
 			m_pRenderer->SetRenderTarget(pOriginalTarget);
 		else
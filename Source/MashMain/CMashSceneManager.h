@@ -20,6 +20,9 @@
 #include "MashRenderable.h"
 #include "MashCamera.h"
 #include "MashGeometryBatch.h"
+#include "CMashRenderQueue.h"
+#include "MashLightClusterGrid.h"
+#include "MashLightInfluenceIndex.h"
 
 namespace mash
 {
@@ -36,66 +39,20 @@ namespace mash
 	class MashDecal;
 
 	const uint32 g_gbufferLightingType = 3;
+	//must match the light array size in the tiled gbuffer lighting effects
+	const uint32 g_deferredTiledLightBatchSize = 8;
+	const uint32 g_deferredLightTileSlices = 16;
+	const uint32 g_maxForwardLightsPerObject = 16;
 	
 	class CMashModel;
 	class MashModel;
 	class MashGeometryBatch;
+	class CMashEllipsoidColliderManager;
 
 	class CMashSceneManager : public MashSceneManager
 	{
 	private:
 
-		struct sSolidRenderable
-		{
-			mash::MashRenderable *pRenderable;
-            uint32 renderKey;
-
-			bool operator<(const sSolidRenderable &other)const
-			{
-                return renderKey < other.renderKey;
-			}
-
-            //TODO : Perhaps also store the material so it doesnt hae to be accesed when sorted.
-			sSolidRenderable(mash::MashRenderable *_pRenderable):pRenderable(_pRenderable),
-                renderKey(pRenderable->GetMaterial()->GetActiveTechnique()->GetRenderKey())
-			{
-			}
-
-			sSolidRenderable():pRenderable(0), renderKey(0){}
-		};
-
-		struct sTransparentRenderable
-		{
-			mash::MashRenderable *pRenderable;
-
-			/*
-				The render key for a transparent object is made up from the render
-				key from the current technique and the objects depth.
-				The key is made up from,
-				First 32bits = current depth in view space
-				Second 32bits = technique render key
-
-				The current depth is placed at the beginning of the key
-				so that it is given priority when sorting transparent obejcts.
-			*/
-			uint64 m_iRenderKey;
-
-			bool operator<(const sTransparentRenderable &other)const
-			{
-				return m_iRenderKey < other.m_iRenderKey;
-			}
-
-			sTransparentRenderable(mash::MashRenderable *_pRenderable,
-				const mash::MashCamera *pCamera):pRenderable(_pRenderable)
-			{
-				uint32 iViewDistance = (uint32)pCamera->GetDistanceToBox(_pRenderable->GetWorldBoundingBox());
-				uint64 iMaterialKey = _pRenderable->GetMaterial()->GetActiveTechnique()->GetRenderKey();
-				m_iRenderKey = (iMaterialKey << 32UL)|(iViewDistance);
-			}
-
-			sTransparentRenderable():pRenderable(0){}
-		};
-
 		struct sShadowData
 		{
 			eSHADOW_MAP_FORMAT textureFormat;
@@ -140,6 +97,8 @@ namespace mash
 		MashRenderSurface *m_customViewportRT;
 
 		MashMaterial *m_pGBufferLighting[g_gbufferLightingType];
+		//lights batched over screen tiles, see SetDeferredTiledLightingEnabled()
+		MashMaterial *m_pGBufferTiledLighting[g_gbufferLightingType];
 		MashMaterial *m_pFinalMaterial;
 		MashMaterial *m_pGBufferClearMaterial;
 		////used for the line renderer
@@ -147,22 +106,22 @@ namespace mash
         
 		mash::eRENDER_STAGE m_eRenderPass;
 
-		MashList<sSolidRenderable> m_solidRenderables;
-		MashList<sTransparentRenderable> m_transparentRenderables;
+		CMashRenderQueue m_solidRenderables;
+		CMashRenderQueue m_transparentRenderables;
 
-		MashList<sSolidRenderable> m_solidDecals;
-		MashList<sTransparentRenderable> m_transparentDecals;
+		CMashRenderQueue m_solidDecals;
+		CMashRenderQueue m_transparentDecals;
 
-		MashList<sSolidRenderable> m_solidParticles;
-		MashList<sTransparentRenderable> m_transparentParticles;
+		CMashRenderQueue m_solidParticles;
+		CMashRenderQueue m_transparentParticles;
 
 		//no transparent pass for deferred renderer
-		MashList<sSolidRenderable> m_deferredRenderables;
-		MashList<sSolidRenderable> m_deferredDecals;
-		MashList<sSolidRenderable> m_deferredParticles;
+		CMashRenderQueue m_deferredRenderables;
+		CMashRenderQueue m_deferredDecals;
+		CMashRenderQueue m_deferredParticles;
 
 		MashArray<MashLight*> m_currentRenderSceneLightList;
-		MashList<sSolidRenderable> m_shadowRenderables;
+		CMashRenderQueue m_shadowRenderables;
 		mash::MashAABB m_shadowSceneBounds;
 
 		MashArray<mash::MashSceneNode*> m_lookatTrackers;
@@ -198,6 +157,36 @@ namespace mash
 		uint32 m_reservedForwardLightBufferElements;
 		eLIGHTING_TYPE m_preferredLightingMode;//TODO : Add access methods
 
+		//clustered lighting data, only updated for aLIGHT_TYPE_CLUSTERED
+		MashLightClusterGrid m_lightClusterGrid;
+		MashTexture *m_lightClusterTexture;
+		MashTextureState *m_lightClusterTextureState;
+		uint32 m_lightClusterTextureRowCount;
+		MashArray<f32> m_lightClusterPaddedRowData;
+
+		bool m_deferredTiledLightingEnabled;
+		uint32 m_deferredLightTileSize;
+		MashLightClusterGrid m_deferredLightTiles;
+		MashArray<MashLight*> m_deferredTiledLights;
+		MashArray<f32> m_deferredTileMinDepth;
+		MashArray<f32> m_deferredTileMaxDepth;
+		MashArray<uint32> m_deferredTileLightIndices;
+		sMashLight m_deferredTiledLightBatch[g_deferredTiledLightBatchSize];
+
+		/*
+			Forward light selection. Index ids are forward light list indices.
+			Each queued forward object has a range in m_forwardLightSlots.
+		*/
+		bool m_lightInfluenceEnabled;
+		uint32 m_maxLightsPerObject;
+		MashLightInfluenceIndex m_lightInfluenceIndex;
+		uint32 m_lightInfluenceIndexSize;
+		MashArray<uint32> m_forwardLightSlots;
+		uint32 m_forwardLightSlotAllocationCount;
+		//forward light buffer with point and spot lights turned off
+		MashArray<sMashLight> m_forwardObjectLightBuffer;
+		uint32 m_forwardLocalLightCount;
+
 		sShadowCaster m_shadowCasters[aLIGHT_TYPE_COUNT];
 
 		MashCullTechnique *m_activeSceneCullTechnique;
@@ -226,6 +215,7 @@ namespace mash
 		MashMeshBuilder *m_pMeshBuilder;
 
 		MashControllerManager *m_pControllerManager;
+		CMashEllipsoidColliderManager *m_ellipsoidColliderManager;
 
 		/*
 			This points to the scene node that is currently
@@ -239,6 +229,12 @@ namespace mash
 
 		virtual eMASH_STATUS DrawDeferredScene();
 		eMASH_STATUS DrawForwardRenderedScene();
+		eMASH_STATUS _UpdateLightClusters();
+		void _CalculateDeferredTileDepths(const CMashRenderQueue &queue, uint32 tilesX, uint32 tilesY);
+		void _DrawDeferredTiledLights(const sMashViewPort &viewport);
+		bool _IsLightInfluenceActive()const;
+		void _UpdateLightInfluenceIndex();
+		void _DrawForwardQueue(const CMashRenderQueue &queue);
 
 		void DefaultSceneCull(MashSceneNode *root);
 		void _FlushRenderableBatches();
@@ -279,6 +275,7 @@ namespace mash
 		MashSkin *skin = 0);
 
 	MashSkin* CreateSkin();
+	MashSkinPaletteBuffer* CreateSkinPaletteBuffer();
         
         MashSkin* _CreateSkinInstance(MashSkin *instanceFrom);
         MashSceneNode* AddInstance(MashSceneNode *instanceFrom, MashSceneNode *parent, const MashStringc &instanceName, bool createSkinInstances = true);
@@ -295,6 +292,8 @@ namespace mash
 	mash::MashTexture* GetDeferredLightingSpecularMap()const;
         
         bool IsDeferredRendererInitialised()const;
+		void SetDeferredTiledLightingEnabled(bool enable, uint32 tileSize = 64);
+		bool GetDeferredTiledLightingEnabled()const;
 
 		/*
 			return MashMesh : This pointer MUST be dropped when you are finished with it.
@@ -405,6 +404,10 @@ namespace mash
 
 		eLIGHTING_TYPE GetPreferredLightingMode()const;
 		void SetPreferredLightingMode(eLIGHTING_TYPE type);
+		MashLightClusterGrid* GetLightClusterGrid();
+		void SetForwardLightInfluenceEnabled(bool enable, uint32 maxLightsPerObject = 4);
+		bool GetForwardLightInfluenceEnabled()const;
+		MashLightInfluenceIndex* GetLightInfluenceIndex();
 
 		virtual eMASH_STATUS SetActiveCamera(MashCamera *pCamera);
 		virtual MashCamera* GetActiveCamera();
@@ -455,6 +458,11 @@ namespace mash
 		void _OnPostResolutionChange();
 	};
     
+	inline bool CMashSceneManager::GetDeferredTiledLightingEnabled()const
+	{
+		return m_deferredTiledLightingEnabled;
+	}
+
     inline bool CMashSceneManager::IsDeferredRendererInitialised()const
     {
         return m_deferredRendererValid;
@@ -475,6 +483,26 @@ namespace mash
 		return m_preferredLightingMode;
 	}
 
+	inline MashLightClusterGrid* CMashSceneManager::GetLightClusterGrid()
+	{
+		return &m_lightClusterGrid;
+	}
+
+	inline bool CMashSceneManager::GetForwardLightInfluenceEnabled()const
+	{
+		return m_lightInfluenceEnabled;
+	}
+
+	inline MashLightInfluenceIndex* CMashSceneManager::GetLightInfluenceIndex()
+	{
+		return &m_lightInfluenceIndex;
+	}
+
+	inline bool CMashSceneManager::_IsLightInfluenceActive()const
+	{
+		return m_lightInfluenceEnabled && (m_preferredLightingMode != aLIGHT_TYPE_CLUSTERED);
+	}
+
 	inline const MashArray<MashLight*>& CMashSceneManager::GetForwardRenderedLightList()const
 	{
 		return m_forwardRenderedLightList;
@@ -9,6 +9,8 @@
 #include "MashCamera.h"
 #include "MashLight.h"
 #include "MashMesh.h"
+#include "MashMeshBuilder.h"
+#include "MashStaticMesh.h"
 #include "MashModel.h"
 #include "MashSubEntity.h"
 #include "MashEntity.h"
@@ -97,7 +99,7 @@ namespace mash
 		return newId;
 	}
 
-	int32 CMashSceneWriter::sFileOutputData::MapModel(MashModel *model)
+	int32 CMashSceneWriter::sFileOutputData::MapModel(MashModel *model, MashEntity *owner)
 	{
 		if (!model)
 			return -1;
@@ -108,7 +110,7 @@ namespace mash
 
 		int32 newId = nextFileID++;
 		modelMap.insert(std::make_pair(model, newId));
-		writer->WriteModel(newId, model, *this);
+		writer->WriteModel(newId, model, owner, *this);
 		return newId;
 	}
 
@@ -546,7 +548,7 @@ namespace mash
 		//skeleton id
 		outputData.sceneNodeData.AppendInt(outputData.MapSkin(entity->GetSkin()));
 		//model file id
-		outputData.sceneNodeData.AppendInt(outputData.MapModel(entity->GetModel()));
+		outputData.sceneNodeData.AppendInt(outputData.MapModel(entity->GetModel(), entity));
 		
 		//sub entity count
 		int32 lodCount = entity->GetLodCount();
@@ -633,7 +635,49 @@ namespace mash
 			outputData.vertexData.Append(vertex->GetVertexElements(), sizeof(sMashVertexElement) * vertex->GetVertexElementCount());
 	}
 
-	void CMashSceneWriter::WriteModel(int32 fileID, MashModel *model, sFileOutputData &outputData)
+	MashMesh* CMashSceneWriter::CookMesh(MashMesh *mesh, MashMaterial *material, sFileOutputData &outputData)
+	{
+		if (!material || mesh->GetRawVertices().Empty() || mesh->GetRawIndices().Empty())
+			return 0;
+
+		MashVertex *materialVertexDecl = material->GetVertexDeclaration();
+		const MashVertex *meshVertexDecl = mesh->GetVertexDeclaration();
+		if (!materialVertexDecl)
+			return 0;
+
+		MashMeshBuilder::sMesh meshData;
+		meshData.vertices = (const uint8*)mesh->GetRawVertices().Pointer();
+		meshData.vertexCount = mesh->GetVertexCount();
+		meshData.indices = (const uint8*)mesh->GetRawIndices().Pointer();
+		meshData.indexCount = mesh->GetIndexCount();
+		meshData.indexFormat = mesh->GetIndexFormat();
+		meshData.primitiveType = mesh->GetPrimitiveType();
+		meshData.boneWeightArray = mesh->GetBoneWeights();
+		meshData.boneIndexArray = mesh->GetBoneIndices();
+		meshData.currentVertexElements = meshVertexDecl->GetVertexElements();
+		meshData.currentVertexElementCount = meshVertexDecl->GetVertexElementCount();
+
+		uint32 meshFlags = MashMeshBuilder::aMESH_UPDATE_FILL_MESH | 
+			MashMeshBuilder::aMESH_UPDATE_OPTIMISE;
+
+		if (!materialVertexDecl->IsEqual(meshVertexDecl->GetVertexElements(), meshVertexDecl->GetVertexElementCount(), 0))
+			meshFlags |= MashMeshBuilder::aMESH_UPDATE_CHANGE_VERTEX_FORMAT;
+
+		MashMesh *cookedMesh = outputData.sceneManager->CreateStaticMesh();
+		if (outputData.sceneManager->GetMeshBuilder()->UpdateMeshEx(cookedMesh, &meshData, materialVertexDecl, meshFlags) == aMASH_FAILED)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_WARNING, 
+				"Failed to cook mesh. The mesh will be saved in its current format.", 
+				"CMashSceneWriter::CookMesh");
+
+			cookedMesh->Drop();
+			return 0;
+		}
+
+		return cookedMesh;
+	}
+
+	void CMashSceneWriter::WriteModel(int32 fileID, MashModel *model, MashEntity *owner, sFileOutputData &outputData)
 	{
 		//file id
 		outputData.modelData.Append(&fileID, sizeof(int32));
@@ -655,6 +699,19 @@ namespace mash
 			{
 				MashMesh *mesh = model->GetMesh(meshIndex, lod);
 
+				/*
+					Cooked meshes are optimised and written in the vertex format of the
+					material they will be rendered with so no conversion is needed on load.
+					Bounds, bone data and triangle buffers are taken from the original mesh.
+				*/
+				MashMesh *cookedMesh = 0;
+				if (outputData.cookMeshes && owner && (lod < owner->GetLodCount()) && (meshIndex < owner->GetSubEntityCount(lod)))
+					cookedMesh = CookMesh(mesh, owner->GetSubEntity(meshIndex, lod)->GetMaterial(), outputData);
+
+				const MashMesh *sourceMesh = mesh;
+				if (cookedMesh)
+					mesh = cookedMesh;
+
 				const MashVertex *vertex = mesh->GetVertexDeclaration();
 				//name
                 outputData.modelData.AppendInt(noName);
@@ -691,13 +748,13 @@ namespace mash
 				outputData.modelData.AppendInt(mesh->GetPrimitiveCount());
 
 				//bb min
-				outputData.modelData.Append(mesh->GetBoundingBox().min.v, sizeof(mash::MashVector3));
+				outputData.modelData.Append(sourceMesh->GetBoundingBox().min.v, sizeof(mash::MashVector3));
 				//bb max
-				outputData.modelData.Append(mesh->GetBoundingBox().max.v, sizeof(mash::MashVector3));
+				outputData.modelData.Append(sourceMesh->GetBoundingBox().max.v, sizeof(mash::MashVector3));
 
 				//triangle buffer
-				if (mesh->GetTriangleBuffer())
-					outputData.modelData.AppendInt(outputData.MapTriangleBuffer(mesh->GetTriangleBuffer()));
+				if (sourceMesh->GetTriangleBuffer())
+					outputData.modelData.AppendInt(outputData.MapTriangleBuffer(sourceMesh->GetTriangleBuffer()));
 				else
 					outputData.modelData.AppendInt(-1);
 
@@ -714,6 +771,9 @@ namespace mash
 					outputData.modelData.Append(mesh->GetBoneWeights()[0].v, sizeof(MashVector4) * mesh->GetVertexCount());
 					outputData.modelData.Append(mesh->GetBoneIndices()[0].v, sizeof(MashVector4) * mesh->GetVertexCount());
 				}
+
+				if (cookedMesh)
+					cookedMesh->Drop();
 			}
 		}
 	}
@@ -827,6 +887,8 @@ namespace mash
 	eMASH_STATUS CMashSceneWriter::SaveScene(MashDevice *pDevice, const MashStringc &filename, const MashList<mash::MashSceneNode*> &rootNodes, const sSaveSceneSettings &saveData)
 	{
 		sFileOutputData outputData(this);
+		outputData.cookMeshes = saveData.cookMeshes;
+		outputData.sceneManager = pDevice->GetSceneManager();
 
 		MashList<MashSceneNode*>::ConstIterator rootNodesIter = rootNodes.Begin();
 		MashList<MashSceneNode*>::ConstIterator rootNodesIterEnd = rootNodes.End();
@@ -844,7 +906,7 @@ namespace mash
 	eMASH_STATUS CMashSceneWriter::_SaveScene(MashDevice *pDevice, const MashStringc &filename, sFileOutputData &outputData, const sSaveSceneSettings &saveData)
 	{
 		sFileHeader fileHeader;
-		fileHeader.version = 0.0f;
+		fileHeader.version = saveData.cookMeshes ? g_sceneFileCookedVersion : g_sceneFileVersion;
 		fileHeader.stringCount = outputData.stringMap.size();
 		fileHeader.modelCount = outputData.modelMap.size();
 		fileHeader.sceneNodeCount = outputData.sceneNodeMap.size();
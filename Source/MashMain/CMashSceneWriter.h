@@ -16,6 +16,10 @@
 #include "MashList.h"
 namespace mash
 {
+	class MashEntity;
+	class MashMesh;
+	class MashSceneManager;
+
 	class CMashSceneWriter : public CMashSceneLoader
 	{
 	private:
@@ -40,6 +44,13 @@ namespace mash
 
 			int32 nextFileID;
 
+			/*
+				Set when meshes should be converted into their materials vertex
+				format before being written.
+			*/
+			bool cookMeshes;
+			MashSceneManager *sceneManager;
+
 			//scene nodes need to be preprocessed
 			std::map<MashSceneNode*, int32> sceneNodeMap;
 
@@ -60,7 +71,7 @@ namespace mash
 			int32 MapAnimationBuffer(MashAnimationBuffer *buffer);
 			int32 MapAnimationMixer(MashAnimationMixer *mixer);
 			int32 MapSkin(MashSkin *skin);
-			int32 MapModel(MashModel *model);
+			int32 MapModel(MashModel *model, MashEntity *owner = 0);
 			int32 MapSamplerState(MashTextureState *state);
 			int32 MapRasterizerState(int32 state, MashVideo *renderer);
 			int32 MapBlendState(int32 state, MashVideo *renderer);
@@ -68,7 +79,7 @@ namespace mash
 			int32 MapTriangleBuffer(MashTriangleBuffer *triangleBuffer);
 			int32 MapTriangleCollider(MashTriangleCollider *triangleCollider);
 
-			sFileOutputData(CMashSceneWriter *_writer):nextFileID(0), writer(_writer){}
+			sFileOutputData(CMashSceneWriter *_writer):writer(_writer), nextFileID(0), cookMeshes(false), sceneManager(0){}
 		};
 
 		eMASH_STATUS _SaveScene(MashDevice *pDevice, 
@@ -91,7 +102,8 @@ namespace mash
 		void WriteRasterizerState(int32 fileID, int32 state, MashVideo *renderer, sFileOutputData &outputData);
 		void WriteBlendState(int32 fileID, int32 state, MashVideo *renderer, sFileOutputData &outputData);
 		void WriteVertex(int32 fileID, MashVertex *vertex, sFileOutputData &outputData);
-		void WriteModel(int32 fileID, MashModel *model, sFileOutputData &outputData);
+		void WriteModel(int32 fileID, MashModel *model, MashEntity *owner, sFileOutputData &outputData);
+		MashMesh* CookMesh(MashMesh *mesh, MashMaterial *material, sFileOutputData &outputData);
 		void WriteSkin(int32 fileID, MashSkin *skin, sFileOutputData &outputData);
 
 		void WriteSceneNode(int32 fileId, MashDevice *pDevice, MashSceneNode *root, sFileOutputData &outputData, const sSaveSceneSettings &saveData);
@@ -9,6 +9,7 @@
 #include "MashTimer.h"
 #include "MashBone.h"
 #include "MashLog.h"
+#include "MashSkinPaletteBuffer.h"
 namespace mash
 {
 	MashBone* CMashSkin::FindNewInstance(const MashBone *originalBone, MashSceneNode *root)
@@ -33,7 +34,7 @@ namespace mash
 	}
 
 	CMashSkin::CMashSkin(MashVideo *renderer):MashSkin(), m_renderer(renderer), m_bonePaletteSize(0),
-		m_lastRenderFrame(mash::math::MaxUInt32())
+		m_lastRenderFrame(mash::math::MaxUInt32()), m_paletteBuffer(0), m_paletteOffset(0)
 	{
 		
 	}
@@ -85,6 +86,9 @@ namespace mash
                                     boneIter->node->GetNodeName().GetCString());
 			}
 		}
+
+		if (m_paletteBuffer)
+			m_paletteBuffer->_OnSkinChange();
     }
 
 	void CMashSkin::AddBone(MashBone *bone, uint32 boneId)
@@ -112,10 +116,28 @@ namespace mash
 		m_skinningBones.PushBack(newSkinningBone);
 
 		bone->Grab();
+
+		if (m_paletteBuffer)
+			m_paletteBuffer->_OnSkinChange();
 	}
 
 	void CMashSkin::OnRender()
 	{
+		/*
+			Skins in a palette buffer are all computed together, once per frame, the
+			first time any of them are rendered.
+		*/
+		if (m_paletteBuffer)
+		{
+			m_paletteBuffer->Update();
+			m_renderer->GetRenderInfo()->SetCurrentBonePaletteSize(m_bonePaletteSize);
+			m_renderer->GetRenderInfo()->SetSkinPaletteBuffer(m_paletteBuffer, m_paletteOffset);
+			m_renderer->GetRenderInfo()->SetSkin(this);
+			return;
+		}
+
+		m_renderer->GetRenderInfo()->SetSkinPaletteBuffer(0, 0);
+
 		/*
 			This assumes the bone palette has already been initialised to at least
 			the length of the bone count.
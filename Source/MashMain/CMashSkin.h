@@ -17,6 +17,8 @@ namespace mash
 		MashArray<sBone> m_skinningBones;
 		uint32 m_bonePaletteSize;
 		uint32 m_lastRenderFrame;
+		MashSkinPaletteBuffer *m_paletteBuffer;
+		uint32 m_paletteOffset;
 
 		MashBone* FindNewInstance(const MashBone *originalBone, MashSceneNode *root);
 	public:
@@ -44,8 +46,28 @@ namespace mash
 		const MashArray<sBone>& GetBones()const;
 		void AddBone(MashBone *bone, uint32 boneId);
 		void OnRender();
+
+		MashSkinPaletteBuffer* GetPaletteBuffer()const;
+		uint32 GetPaletteOffset()const;
+		void _SetPaletteBuffer(MashSkinPaletteBuffer *buffer, uint32 offset);
 	};
 
+	inline MashSkinPaletteBuffer* CMashSkin::GetPaletteBuffer()const
+	{
+		return m_paletteBuffer;
+	}
+
+	inline uint32 CMashSkin::GetPaletteOffset()const
+	{
+		return m_paletteOffset;
+	}
+
+	inline void CMashSkin::_SetPaletteBuffer(MashSkinPaletteBuffer *buffer, uint32 offset)
+	{
+		m_paletteBuffer = buffer;
+		m_paletteOffset = offset;
+	}
+
 	inline uint32 CMashSkin::GetBonePaletteLength()const
 	{
 		return m_bonePaletteSize;
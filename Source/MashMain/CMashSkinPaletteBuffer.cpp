@@ -0,0 +1,275 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#include "CMashSkinPaletteBuffer.h"
+#include "MashSkin.h"
+#include "MashBone.h"
+#include "MashVideo.h"
+#include "MashTexture.h"
+#include "MashDevice.h"
+#include "MashTimer.h"
+#include "MashLog.h"
+#include "MashMathHelper.h"
+#include <cstring>
+
+namespace mash
+{
+	/*
+		Each matrix is 4 RGBA32 texels. 256 matrices gives a 1024 texel wide
+		texture, which is supported by all targeted hardware.
+	*/
+	static const uint32 g_skinPaletteMatricesPerRow = 256;
+
+	CMashSkinPaletteBuffer::CMashSkinPaletteBuffer(MashVideo *renderer):MashSkinPaletteBuffer(),
+		m_renderer(renderer), m_paletteSize(0), m_texture(0), m_textureState(0), m_textureRowCount(0),
+		m_lastUpdateFrame(mash::math::MaxUInt32()), m_bonesDirty(false)
+	{
+	}
+
+	CMashSkinPaletteBuffer::~CMashSkinPaletteBuffer()
+	{
+		RemoveAllSkins();
+
+		if (m_texture)
+		{
+			m_renderer->RemoveTextureFromCache(m_texture);
+			m_texture = 0;
+		}
+
+		if (m_textureState)
+		{
+			m_textureState->Drop();
+			m_textureState = 0;
+		}
+	}
+
+	eMASH_STATUS CMashSkinPaletteBuffer::AddSkin(MashSkin *skin)
+	{
+		if (!skin)
+			return aMASH_FAILED;
+
+		if (skin->GetPaletteBuffer())
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_WARNING,
+				"Skin already belongs to a palette buffer.",
+				"CMashSkinPaletteBuffer::AddSkin");
+
+			return aMASH_FAILED;
+		}
+
+		skin->Grab();
+		skin->_SetPaletteBuffer(this, 0);
+		m_skins.PushBack(skin);
+
+		UpdateSkinOffsets();
+
+		return aMASH_OK;
+	}
+
+	void CMashSkinPaletteBuffer::RemoveSkin(MashSkin *skin)
+	{
+		const uint32 skinCount = m_skins.Size();
+		for(uint32 i = 0; i < skinCount; ++i)
+		{
+			if (m_skins[i] == skin)
+			{
+				skin->_SetPaletteBuffer(0, 0);
+				skin->Drop();
+				m_skins.Erase(i);
+
+				UpdateSkinOffsets();
+				return;
+			}
+		}
+	}
+
+	void CMashSkinPaletteBuffer::RemoveAllSkins()
+	{
+		const uint32 skinCount = m_skins.Size();
+		for(uint32 i = 0; i < skinCount; ++i)
+		{
+			m_skins[i]->_SetPaletteBuffer(0, 0);
+			m_skins[i]->Drop();
+		}
+
+		m_skins.Clear();
+		UpdateSkinOffsets();
+	}
+
+	void CMashSkinPaletteBuffer::_OnSkinChange()
+	{
+		UpdateSkinOffsets();
+	}
+
+	void CMashSkinPaletteBuffer::UpdateSkinOffsets()
+	{
+		uint32 offset = 0;
+		const uint32 skinCount = m_skins.Size();
+		for(uint32 i = 0; i < skinCount; ++i)
+		{
+			m_skins[i]->_SetPaletteBuffer(this, offset);
+			offset += m_skins[i]->GetBonePaletteLength();
+		}
+
+		m_paletteSize = offset;
+		m_bonesDirty = true;
+	}
+
+	void CMashSkinPaletteBuffer::RebuildBones()
+	{
+		m_bones.Clear();
+
+		const uint32 skinCount = m_skins.Size();
+		for(uint32 i = 0; i < skinCount; ++i)
+		{
+			const uint32 offset = m_skins[i]->GetPaletteOffset();
+			const MashArray<MashSkin::sBone> &skinBones = m_skins[i]->GetBones();
+			const uint32 boneCount = skinBones.Size();
+			for(uint32 b = 0; b < boneCount; ++b)
+			{
+				sPaletteBone paletteBone;
+				paletteBone.inverseBindPose = &skinBones[b].node->GetInverseWorldBindPose();
+				paletteBone.world = &skinBones[b].node->GetRenderTransformation();
+				paletteBone.paletteIndex = offset + skinBones[b].id;
+				m_bones.PushBack(paletteBone);
+			}
+		}
+
+		m_bones.Sort();
+
+		//unused bone ids are left in their bind pose
+		m_palette.Resize(m_paletteSize);
+		for(uint32 i = 0; i < m_paletteSize; ++i)
+			m_palette[i].Identity();
+
+		m_bonesDirty = false;
+	}
+
+	eMASH_STATUS CMashSkinPaletteBuffer::ReserveTexture(uint32 matrixCount)
+	{
+		const uint32 rowCount = (matrixCount + g_skinPaletteMatricesPerRow - 1) / g_skinPaletteMatricesPerRow;
+		if (m_texture && (rowCount <= m_textureRowCount))
+			return aMASH_OK;
+
+		if (!m_textureState)
+		{
+			//matrices must not be filtered
+			sSamplerState state;
+			state.type = aSAMPLER2D;
+			state.filter = aFILTER_MIN_MAG_MIP_POINT;
+			state.uMode = aTEXTURE_ADDRESS_CLAMP;
+			state.vMode = aTEXTURE_ADDRESS_CLAMP;
+			m_textureState = m_renderer->AddSamplerState(state);
+			if (!m_textureState)
+			{
+				MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR,
+					"Failed to create palette sampler state.",
+					"CMashSkinPaletteBuffer::ReserveTexture");
+
+				return aMASH_FAILED;
+			}
+
+			m_textureState->Grab();
+		}
+
+		if (m_texture)
+		{
+			m_renderer->RemoveTextureFromCache(m_texture);
+			m_texture = 0;
+		}
+
+		//grow in powers of two so adding skins one at a time doesn't recreate the texture each time
+		uint32 newRowCount = (m_textureRowCount > 0) ? m_textureRowCount : 1;
+		while(newRowCount < rowCount)
+			newRowCount *= 2;
+
+		m_texture = m_renderer->AddTexture("", g_skinPaletteMatricesPerRow * 4, newRowCount, false, aUSAGE_DYNAMIC, aFORMAT_RGBA32_FLOAT);
+		if (!m_texture)
+		{
+			m_textureRowCount = 0;
+
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR,
+				"Failed to create palette texture.",
+				"CMashSkinPaletteBuffer::ReserveTexture");
+
+			return aMASH_FAILED;
+		}
+
+		m_textureRowCount = newRowCount;
+
+		return aMASH_OK;
+	}
+
+	eMASH_STATUS CMashSkinPaletteBuffer::Update()
+	{
+		const uint32 currentFrame = MashDevice::StaticDevice->GetTimer()->GetFrameCount();
+		if ((m_lastUpdateFrame == currentFrame) && !m_bonesDirty)
+			return aMASH_OK;
+
+		m_lastUpdateFrame = currentFrame;
+
+		if (m_bonesDirty)
+			RebuildBones();
+
+		if (m_paletteSize == 0)
+			return aMASH_OK;
+
+		/*
+			Same as MashBone::GetWorldSkinningOffset() for every bone, without
+			the virtual calls and with the palette written in order.
+		*/
+		const sPaletteBone *bones = m_bones.Pointer();
+		MashMatrix4 *palette = m_palette.Pointer();
+		const uint32 boneCount = m_bones.Size();
+		for(uint32 i = 0; i < boneCount; ++i)
+			palette[bones[i].paletteIndex] = *bones[i].inverseBindPose * *bones[i].world;
+
+		if (ReserveTexture(m_paletteSize) == aMASH_FAILED)
+			return aMASH_FAILED;
+
+		void *textureData = 0;
+		uint32 rowPitch = 0;
+		if (m_texture->Lock(aLOCK_WRITE_DISCARD, &textureData, 0, 0, &rowPitch) == aMASH_FAILED)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR,
+				"Failed to lock palette texture.",
+				"CMashSkinPaletteBuffer::Update");
+
+			return aMASH_FAILED;
+		}
+
+		//rows may be padded so the palette is copied one row at a time unless it's tightly packed
+		const uint32 rowSize = sizeof(MashMatrix4) * g_skinPaletteMatricesPerRow;
+		if (rowPitch == rowSize)
+		{
+			memcpy(textureData, palette, sizeof(MashMatrix4) * m_paletteSize);
+		}
+		else
+		{
+			uint8 *row = (uint8*)textureData;
+			for(uint32 i = 0; i < m_paletteSize; i += g_skinPaletteMatricesPerRow)
+			{
+				const uint32 rowMatrixCount = math::Min<uint32>(m_paletteSize - i, g_skinPaletteMatricesPerRow);
+				memcpy(row, palette + i, sizeof(MashMatrix4) * rowMatrixCount);
+				row += rowPitch;
+			}
+		}
+
+		return m_texture->Unlock();
+	}
+
+	int32 CMashSkinPaletteBuffer::GetSkinOffset(const MashSkin *skin)const
+	{
+		if (!skin || (skin->GetPaletteBuffer() != this))
+			return -1;
+
+		return (int32)skin->GetPaletteOffset();
+	}
+
+	uint32 CMashSkinPaletteBuffer::GetMatricesPerRow()const
+	{
+		return g_skinPaletteMatricesPerRow;
+	}
+}
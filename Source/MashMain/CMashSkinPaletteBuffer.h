@@ -0,0 +1,100 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+
+#ifndef _C_MASH_SKIN_PALETTE_BUFFER_H_
+#define _C_MASH_SKIN_PALETTE_BUFFER_H_
+
+#include "MashSkinPaletteBuffer.h"
+#include "MashArray.h"
+#include "MashMatrix4.h"
+
+namespace mash
+{
+	class MashVideo;
+
+	class CMashSkinPaletteBuffer : public MashSkinPaletteBuffer
+	{
+	private:
+		/*
+			Flattened list of all bones in all skins. Sorted by palette index so the
+			palette is written front to back. The matrices are owned by the bones, which
+			are kept alive by the skins grabbed in m_skins.
+		*/
+		struct sPaletteBone
+		{
+			const MashMatrix4 *inverseBindPose;
+			const MashMatrix4 *world;
+			uint32 paletteIndex;
+
+			bool operator<(const sPaletteBone &other)const
+			{
+				return paletteIndex < other.paletteIndex;
+			}
+		};
+
+		MashVideo *m_renderer;
+		MashArray<MashSkin*> m_skins;
+		MashArray<sPaletteBone> m_bones;
+		MashArray<MashMatrix4> m_palette;
+		uint32 m_paletteSize;
+
+		MashTexture *m_texture;
+		MashTextureState *m_textureState;
+		uint32 m_textureRowCount;
+
+		uint32 m_lastUpdateFrame;
+		bool m_bonesDirty;
+
+		void UpdateSkinOffsets();
+		void RebuildBones();
+		eMASH_STATUS ReserveTexture(uint32 matrixCount);
+	public:
+		CMashSkinPaletteBuffer(MashVideo *renderer);
+		~CMashSkinPaletteBuffer();
+
+		eMASH_STATUS AddSkin(MashSkin *skin);
+		void RemoveSkin(MashSkin *skin);
+		void RemoveAllSkins();
+		eMASH_STATUS Update();
+
+		int32 GetSkinOffset(const MashSkin *skin)const;
+		const MashMatrix4* GetPalette()const;
+		uint32 GetPaletteSize()const;
+		uint32 GetSkinCount()const;
+		MashTexture* GetTexture(const MashTextureState **textureStateOut = 0)const;
+		uint32 GetMatricesPerRow()const;
+
+		void _OnSkinChange();
+	};
+
+	inline const MashMatrix4* CMashSkinPaletteBuffer::GetPalette()const
+	{
+		if (m_paletteSize == 0)
+			return 0;
+
+		return m_palette.Pointer();
+	}
+
+	inline uint32 CMashSkinPaletteBuffer::GetPaletteSize()const
+	{
+		return m_paletteSize;
+	}
+
+	inline uint32 CMashSkinPaletteBuffer::GetSkinCount()const
+	{
+		return m_skins.Size();
+	}
+
+	inline MashTexture* CMashSkinPaletteBuffer::GetTexture(const MashTextureState **textureStateOut)const
+	{
+		if (textureStateOut)
+			*textureStateOut = m_textureState;
+
+		return m_texture;
+	}
+}
+
+#endif
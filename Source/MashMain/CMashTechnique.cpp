@@ -312,7 +312,7 @@ namespace mash
 		*/
 		if (((compileFlags & aMATERIAL_COMPILER_EVERYTHING) || 
 			((compileFlags & aMATERIAL_COMPILER_NON_COMPILED) && !m_bIsCompiled) ||
-			((compileFlags & aMATERIAL_COMPILER_FORWARD_RENDERED) && ((lightingType == aLIGHT_TYPE_VERTEX) || (lightingType == aLIGHT_TYPE_PIXEL))) ||
+			((compileFlags & aMATERIAL_COMPILER_FORWARD_RENDERED) && ((lightingType == aLIGHT_TYPE_VERTEX) || (lightingType == aLIGHT_TYPE_PIXEL) || (lightingType == aLIGHT_TYPE_CLUSTERED))) ||
 			((compileFlags & aMATERIAL_COMPILER_AUTOS) && (m_lightingType == aLIGHT_TYPE_AUTO))))
 		{
 			if (lightingType != m_lightingType)
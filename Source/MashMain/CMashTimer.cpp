@@ -16,8 +16,6 @@ namespace mash
         QueryPerformanceFrequency(&m_cntsPerSec);
         
         QueryPerformanceCounter(&m_iStartTime);
-        
-		m_iCurrentTime = m_iStartTime;
 #elif defined (MASH_APPLE) || defined (MASH_LINUX)
 		gettimeofday(&m_startTime, NULL);
 #endif
@@ -31,8 +29,10 @@ namespace mash
 	uint64 CMashTimer::GetTimeSinceProgramStart()
 	{
 #ifdef MASH_WINDOWS
-        QueryPerformanceCounter(&m_iCurrentTime);
-		return (m_iCurrentTime.QuadPart - m_iStartTime.QuadPart) * 1000 / m_cntsPerSec.QuadPart;
+		//local so the time can be read from worker threads
+		LARGE_INTEGER currentTime;
+        QueryPerformanceCounter(&currentTime);
+		return (currentTime.QuadPart - m_iStartTime.QuadPart) * 1000 / m_cntsPerSec.QuadPart;
 #elif defined (MASH_APPLE) || defined (MASH_LINUX)
 		struct timeval currentTime;
         gettimeofday(&currentTime, NULL);
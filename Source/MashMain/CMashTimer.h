@@ -29,7 +29,6 @@ namespace mash
     {
 	private:
 #ifdef MASH_WINDOWS
-        LARGE_INTEGER m_iCurrentTime;
         LARGE_INTEGER m_iStartTime;
         LARGE_INTEGER m_cntsPerSec;
 #elif defined (MASH_APPLE) || defined (MASH_LINUX)
@@ -0,0 +1,165 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#include "CMashTransientVertexBuffer.h"
+#include "MashVideo.h"
+#include "MashMeshBuffer.h"
+#include "MashVertexBuffer.h"
+#include "MashVertex.h"
+#include "MashLog.h"
+#include <cstring>
+
+namespace mash
+{
+	//initial ring size. Grows as needed.
+	static const uint32 g_transientVertexBufferSizeInBytes = 256 * 1024;
+
+	CMashTransientVertexBuffer::CMashTransientVertexBuffer(MashVideo *renderer, MashVertex *vertexDeclaration):MashTransientVertexBuffer(),
+		m_renderer(renderer), m_vertexDeclaration(vertexDeclaration), m_meshBuffer(0), m_vertexStride(0),
+		m_vertexCapacity(0), m_nextVertex(0), m_lockedVertex(0), m_lockedVertexCount(0), m_isLocked(false)
+	{
+		m_vertexDeclaration->Grab();
+		m_vertexStride = m_vertexDeclaration->GetStreamSizeInBytes(0);
+	}
+
+	CMashTransientVertexBuffer::~CMashTransientVertexBuffer()
+	{
+		if (m_isLocked)
+			m_meshBuffer->GetVertexBuffer()->Unlock();
+
+		if (m_meshBuffer)
+		{
+			m_meshBuffer->Drop();
+			m_meshBuffer = 0;
+		}
+
+		if (m_vertexDeclaration)
+		{
+			m_vertexDeclaration->Drop();
+			m_vertexDeclaration = 0;
+		}
+	}
+
+	eMASH_STATUS CMashTransientVertexBuffer::Reserve(uint32 vertexCount, eBUFFER_LOCK &lockTypeOut)
+	{
+		if (!m_meshBuffer || (vertexCount > m_vertexCapacity))
+		{
+			uint32 newCapacity = m_vertexCapacity * 2;
+			if (newCapacity == 0)
+				newCapacity = g_transientVertexBufferSizeInBytes / m_vertexStride;
+
+			if (newCapacity < vertexCount)
+				newCapacity = vertexCount;
+
+			if (!m_meshBuffer)
+			{
+				sVertexStreamInit streamData;
+				streamData.data = 0;
+				streamData.dataSizeInBytes = newCapacity * m_vertexStride;
+				streamData.usage = aUSAGE_DYNAMIC;
+
+				m_meshBuffer = m_renderer->CreateMeshBuffer(&streamData, 1, m_vertexDeclaration);
+				if (!m_meshBuffer)
+				{
+					MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR,
+						"Failed to create transient mesh buffer.",
+						"CMashTransientVertexBuffer::Reserve");
+
+					return aMASH_FAILED;
+				}
+			}
+			else if (m_meshBuffer->ResizeVertexBuffers(0, newCapacity * m_vertexStride, aUSAGE_DYNAMIC, false) == aMASH_FAILED)
+			{
+				MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR,
+					"Failed to resize transient vertex buffer.",
+					"CMashTransientVertexBuffer::Reserve");
+
+				return aMASH_FAILED;
+			}
+
+			m_vertexCapacity = newCapacity;
+			m_nextVertex = 0;
+		}
+		else if ((m_nextVertex + vertexCount) > m_vertexCapacity)
+		{
+			//wrap around
+			m_nextVertex = 0;
+		}
+
+		/*
+			Data before m_nextVertex may still be in use by the GPU. Space after it
+			hasn't been written since the last discard so it can be written without waiting.
+		*/
+		lockTypeOut = (m_nextVertex == 0) ? aLOCK_WRITE_DISCARD : aLOCK_WRITE_NOOVERWRITE;
+
+		return aMASH_OK;
+	}
+
+	eMASH_STATUS CMashTransientVertexBuffer::Lock(uint32 maxVertexCount, void **dataOut)
+	{
+		if (m_isLocked)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR,
+				"Buffer is already locked.",
+				"CMashTransientVertexBuffer::Lock");
+
+			return aMASH_FAILED;
+		}
+
+		if (maxVertexCount == 0)
+			return aMASH_FAILED;
+
+		eBUFFER_LOCK lockType = aLOCK_WRITE_DISCARD;
+		if (Reserve(maxVertexCount, lockType) == aMASH_FAILED)
+			return aMASH_FAILED;
+
+		uint8 *bufferData = 0;
+		if (m_meshBuffer->GetVertexBuffer()->Lock(lockType, (void**)&bufferData) == aMASH_FAILED)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR,
+				"Failed to lock transient vertex buffer.",
+				"CMashTransientVertexBuffer::Lock");
+
+			return aMASH_FAILED;
+		}
+
+		*dataOut = bufferData + (m_nextVertex * m_vertexStride);
+		m_lockedVertex = m_nextVertex;
+		m_lockedVertexCount = maxVertexCount;
+		m_isLocked = true;
+
+		return aMASH_OK;
+	}
+
+	eMASH_STATUS CMashTransientVertexBuffer::Unlock(uint32 vertexCount, uint32 &firstVertexOut)
+	{
+		if (!m_isLocked)
+			return aMASH_FAILED;
+
+		m_isLocked = false;
+
+		if (m_meshBuffer->GetVertexBuffer()->Unlock() == aMASH_FAILED)
+			return aMASH_FAILED;
+
+		if (vertexCount > m_lockedVertexCount)
+			vertexCount = m_lockedVertexCount;
+
+		firstVertexOut = m_lockedVertex;
+		m_nextVertex = m_lockedVertex + vertexCount;
+
+		return aMASH_OK;
+	}
+
+	eMASH_STATUS CMashTransientVertexBuffer::Write(const void *vertices, uint32 vertexCount, uint32 &firstVertexOut)
+	{
+		void *data = 0;
+		if (Lock(vertexCount, &data) == aMASH_FAILED)
+			return aMASH_FAILED;
+
+		memcpy(data, vertices, vertexCount * m_vertexStride);
+
+		return Unlock(vertexCount, firstVertexOut);
+	}
+}
@@ -0,0 +1,59 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+
+#ifndef _C_MASH_TRANSIENT_VERTEX_BUFFER_H_
+#define _C_MASH_TRANSIENT_VERTEX_BUFFER_H_
+
+#include "MashTransientVertexBuffer.h"
+
+namespace mash
+{
+	class MashVideo;
+
+	class CMashTransientVertexBuffer : public MashTransientVertexBuffer
+	{
+	private:
+		MashVideo *m_renderer;
+		MashVertex *m_vertexDeclaration;
+		MashMeshBuffer *m_meshBuffer;
+		uint32 m_vertexStride;
+		uint32 m_vertexCapacity;
+		uint32 m_nextVertex;
+		uint32 m_lockedVertex;
+		uint32 m_lockedVertexCount;
+		bool m_isLocked;
+
+		eMASH_STATUS Reserve(uint32 vertexCount, eBUFFER_LOCK &lockTypeOut);
+	public:
+		CMashTransientVertexBuffer(MashVideo *renderer, MashVertex *vertexDeclaration);
+		~CMashTransientVertexBuffer();
+
+		eMASH_STATUS Lock(uint32 maxVertexCount, void **dataOut);
+		eMASH_STATUS Unlock(uint32 vertexCount, uint32 &firstVertexOut);
+		eMASH_STATUS Write(const void *vertices, uint32 vertexCount, uint32 &firstVertexOut);
+
+		MashMeshBuffer* GetMeshBuffer()const;
+		MashVertex* GetVertexDeclaration()const;
+		bool IsLocked()const;
+	};
+
+	inline MashMeshBuffer* CMashTransientVertexBuffer::GetMeshBuffer()const
+	{
+		return m_meshBuffer;
+	}
+
+	inline MashVertex* CMashTransientVertexBuffer::GetVertexDeclaration()const
+	{
+		return m_vertexDeclaration;
+	}
+
+	inline bool CMashTransientVertexBuffer::IsLocked()const
+	{
+		return m_isLocked;
+	}
+}
+
+#endif
@@ -237,4 +237,56 @@ namespace mash
 
 		return trisFound;
 	}
+	uint32 CMashTriCollectionCached::CheckCollisions(const mash::MashRay *rays,
+			uint32 rayCount,
+			const MashTransformState &transform,
+			bool *out)const
+	{
+		uint32 hitCount = 0;
+		for(uint32 i = 0; i < rayCount; ++i)
+		{
+			out[i] = CheckCollision(rays[i], transform);
+			if (out[i])
+				++hitCount;
+		}
+
+		return hitCount;
+	}
+
+	uint32 CMashTriCollectionCached::GetClosestTriangles(const mash::MashRay *rays,
+			uint32 rayCount,
+			const MashTransformState &transform,
+			sTriPickResult *out)const
+	{
+		uint32 resultCount = 0;
+		sTriPickResult result;
+		for(uint32 i = 0; i < rayCount; ++i)
+		{
+			if (GetClosestTriangle(rays[i], transform, result) && (result.distance < out[i].distance))
+			{
+				out[i] = result;
+				++resultCount;
+			}
+		}
+
+		return resultCount;
+	}
+
+	uint32 CMashTriCollectionCached::GetIntersectingTriangles(const MashAABB *bounds,
+			uint32 boundsCount,
+			const MashTransformState &transform, 
+			MashArray<sIntersectingTriangleResult> &out,
+			uint32 *resultStartOut)const
+	{
+		const uint32 firstResult = out.Size();
+		for(uint32 i = 0; i < boundsCount; ++i)
+		{
+			resultStartOut[i] = out.Size();
+			GetIntersectingTriangles(bounds[i], transform, out);
+		}
+
+		resultStartOut[boundsCount] = out.Size();
+
+		return out.Size() - firstResult;
+	}
 }
\ No newline at end of file
@@ -43,6 +43,22 @@ namespace mash
 			const MashTransformState &transform,
 			MashArray<sTriPickResult> &out)const;
 
+		uint32 CheckCollisions(const mash::MashRay *rays,
+			uint32 rayCount,
+			const MashTransformState &transform,
+			bool *out)const;
+
+		uint32 GetClosestTriangles(const mash::MashRay *rays,
+			uint32 rayCount,
+			const MashTransformState &transform,
+			sTriPickResult *out)const;
+
+		uint32 GetIntersectingTriangles(const MashAABB *bounds,
+			uint32 boundsCount,
+			const MashTransformState &transform, 
+			MashArray<sIntersectingTriangleResult> &out,
+			uint32 *resultStartOut)const;
+
 		const MashArray<MashTriangleBuffer*>& GetTriangleBufferCollection()const;
 		const MashTriangleBuffer* GetTriangleBuffer(uint32 index)const;
 		uint32 GetTriangleBufferCount()const;
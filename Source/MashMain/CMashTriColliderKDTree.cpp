@@ -11,63 +11,144 @@
 #include "MashGenericArray.h"
 #include "MashGeometryHelper.h"
 #include "MashTransformState.h"
+#include "MashLog.h"
+#include "MashJob.h"
+#include "MashMathSIMD.h"
+#include <algorithm>
+#include <cmath>
 
 namespace mash
 {
-	CMashTriColliderKDTree::CMashTriColliderKDTree():m_root(0)
+	/*
+		Traversal uses a fixed size stack so the tree depth is capped.
+	*/
+	static const uint32 g_kdTreeMaxDepth = 48;
+	static const uint32 g_kdTreeMinLeafTriangles = 4;
+	static const uint32 g_kdTreeSAHBinCount = 32;
+
+	/*
+		Relative costs used by the surface area heuristic. Splits with an empty
+		child are favoured as they allow rays to skip empty space quickly.
+	*/
+	static const f32 g_kdTreeTraversalCost = 1.0f;
+	static const f32 g_kdTreeIntersectionCost = 2.0f;
+	static const f32 g_kdTreeEmptyBonus = 0.2f;
+
+	/*
+		Serialized trees older than the flat layout start with 0 or 1 to
+		flag the root node.
+	*/
+	static const uint32 g_kdTreeFlatLayoutTag = 2;
+
+	/*
+		Large ray and bounds batches are split into contiguous ranges of the
+		sorted batch and run as jobs.
+	*/
+	static const uint32 g_kdTreeMinQueriesPerJob = 256;
+	static const uint32 g_kdTreeMaxBatchJobs = 16;
+
+	//floats in one block of 4 triangles
+	static const uint32 g_kdTreeTriangleBlockSize = 36;
+
+	static uint32 GetBatchJobCount(uint32 queryCount)
 	{
+		uint32 jobCount = math::Min<uint32>(math::Min<uint32>(jobs::GetHardwareThreadCount(), g_kdTreeMaxBatchJobs), 
+			queryCount / g_kdTreeMinQueriesPerJob);
 
+		if (jobCount == 0)
+			jobCount = 1;
+
+		return jobCount;
 	}
 
-	CMashTriColliderKDTree::~CMashTriColliderKDTree()
+	class CMashTriColliderKDTree::CRayBatchJob : public MashJob
 	{
-		if (m_root)
+	public:
+		const CMashTriColliderKDTree *collider;
+		const mash::MashRay *rays;
+		const mash::MashRay *localRays;
+		const uint32 *order;
+		uint32 first;
+		uint32 last;
+		const MashTransformState *transform;
+		//hitsOut is set for CheckCollisions(), resultsOut for GetClosestTriangles()
+		bool *hitsOut;
+		sTriPickResult *resultsOut;
+		uint32 count;
+
+		CRayBatchJob():MashJob(), collider(0), rays(0), localRays(0), order(0), first(0), last(0), 
+			transform(0), hitsOut(0), resultsOut(0), count(0){}
+
+		void Run()
 		{
-			MASH_DELETE_T(KDNode, m_root);
+			if (hitsOut)
+				collider->_CheckCollisions(localRays, order, first, last, hitsOut, count);
+			else
+				collider->_GetClosestTriangles(rays, localRays, order, first, last, *transform, resultsOut, count);
 		}
+	};
 
-		for(uint32 i = 0; i < m_triangleBuffers.Size(); ++i)
+	class CMashTriColliderKDTree::CBoundsBatchJob : public MashJob
+	{
+	public:
+		const CMashTriColliderKDTree *collider;
+		const MashAABB *bounds;
+		uint32 first;
+		uint32 last;
+		const MashTransformState *transform;
+		MashArray<sIntersectingTriangleResult> *resultsOut;
+		uint32 *resultStartOut;
+
+		CBoundsBatchJob():MashJob(), collider(0), bounds(0), first(0), last(0), transform(0), resultsOut(0), resultStartOut(0){}
+
+		void Run()
 		{
-			if (m_triangleBuffers[i])
-				m_triangleBuffers[i]->Drop();
+			MashArray<uint32> candidates;
+			for(uint32 i = first; i < last; ++i)
+			{
+				resultStartOut[i] = resultsOut->Size();
+
+				MashAABB localBounds(bounds[i]);
+				localBounds.TransformInverse(*transform);
+				collider->CollectIntersectingTriangles(localBounds, candidates, *resultsOut);
+			}
 		}
-	}
+	};
 
-	void CMashTriColliderKDTree::_Serialize(KDNode *node, MashGenericArray &out)const
+	static f32 GetSurfaceArea(const MashAABB &aabb)
 	{
-		out.AppendUnsignedInt(node->axis);
-		out.AppendFloat(node->splitPosition);
-		out.AppendUnsignedInt(node->triangleCount);
-
-		if (node->triangleCount > 0)
-			out.Append(node->triangleIndexList, node->triangleCount * sizeof(uint32));
-
-		if (node->child[0])
-			out.AppendUnsignedInt(1);
-		else
-			out.AppendUnsignedInt(0);
+		const MashVector3 extents = aabb.max - aabb.min;
+		return 2.0f * ((extents.x * extents.y) + (extents.y * extents.z) + (extents.x * extents.z));
+	}
 
-		if (node->child[1])
-			out.AppendUnsignedInt(1);
-		else
-			out.AppendUnsignedInt(0);
+	CMashTriColliderKDTree::CMashTriColliderKDTree()
+	{
 
-		if (node->child[0])
-			_Serialize(node->child[0], out);
+	}
 
-		if (node->child[1])
-			_Serialize(node->child[1], out);
+	CMashTriColliderKDTree::~CMashTriColliderKDTree()
+	{
+		for(uint32 i = 0; i < m_triangleBuffers.Size(); ++i)
+		{
+			if (m_triangleBuffers[i])
+				m_triangleBuffers[i]->Drop();
+		}
 	}
 
 	void CMashTriColliderKDTree::Serialize(MashGenericArray &out)const
 	{
-		if (m_root)
-			out.AppendUnsignedInt(1);
-		else
-			out.AppendUnsignedInt(0);
+		out.AppendUnsignedInt(g_kdTreeFlatLayoutTag);
+
+		out.Append(&m_bounds.min, sizeof(MashVector3));
+		out.Append(&m_bounds.max, sizeof(MashVector3));
+
+		out.AppendUnsignedInt(m_nodes.Size());
+		if (!m_nodes.Empty())
+			out.Append(m_nodes.Pointer(), m_nodes.Size() * sizeof(sNode));
 
-		if (m_root)
-			_Serialize(m_root, out);
+		out.AppendUnsignedInt(m_leafTriangles.Size());
+		if (!m_leafTriangles.Empty())
+			out.Append(m_leafTriangles.Pointer(), m_leafTriangles.Size() * sizeof(uint32));
 
 		out.AppendUnsignedInt(m_triangleDataPool.Size());
 		
@@ -75,57 +156,147 @@ namespace mash
 			out.Append(&m_triangleDataPool[0], m_triangleDataPool.Size() * sizeof(sTriangleData));
 	}
 
-	void CMashTriColliderKDTree::_Deserialize(KDNode *node, const uint8 *dataArray, uint32 &nextByte)
+	void CMashTriColliderKDTree::_DeserializeLegacyNode(const uint8 *dataArray, uint32 &nextByte)
 	{
-		memcpy(&node->axis, &dataArray[nextByte], sizeof(uint32));
+		uint32 axis = 0;
+		memcpy(&axis, &dataArray[nextByte], sizeof(uint32));
 		nextByte += sizeof(uint32);
 
-		memcpy(&node->splitPosition, &dataArray[nextByte], sizeof(f32));
+		f32 splitPosition = 0.0f;
+		memcpy(&splitPosition, &dataArray[nextByte], sizeof(f32));
 		nextByte += sizeof(f32);
 
-		memcpy(&node->triangleCount, &dataArray[nextByte], sizeof(uint32));
+		uint32 triangleCount = 0;
+		memcpy(&triangleCount, &dataArray[nextByte], sizeof(uint32));
 		nextByte += sizeof(uint32);
 
-		if (node->triangleCount > 0)
+		const uint32 nodeIndex = m_nodes.Size();
+		m_nodes.PushBack(sNode());
+		m_nodes[nodeIndex].firstTriangle = m_leafTriangles.Size();
+		m_nodes[nodeIndex].flags = sNode::aLEAF_NODE | (triangleCount << 2);
+
+		if (triangleCount > 0)
 		{
-			node->triangleIndexList = MASH_NEW_ARRAY_T_COMMON(uint32, node->triangleCount);
-			memcpy(node->triangleIndexList, &dataArray[nextByte], sizeof(uint32) * node->triangleCount);
-			nextByte += sizeof(uint32) * node->triangleCount;
+			m_leafTriangles.Resize(m_leafTriangles.Size() + triangleCount);
+			memcpy(&m_leafTriangles[m_nodes[nodeIndex].firstTriangle], &dataArray[nextByte], sizeof(uint32) * triangleCount);
+			nextByte += sizeof(uint32) * triangleCount;
 		}
-		else
-			node->triangleIndexList = 0;
 
-		uint32 childIndex = 0;
-		memcpy(&childIndex, &dataArray[nextByte], sizeof(uint32));
+		uint32 containsChild[2] = {0, 0};
+		memcpy(&containsChild[0], &dataArray[nextByte], sizeof(uint32));
 		nextByte += sizeof(uint32);
+		memcpy(&containsChild[1], &dataArray[nextByte], sizeof(uint32));
+		nextByte += sizeof(uint32);
+
+		//old leaf nodes never contain children
+		if (!containsChild[0] && !containsChild[1])
+			return;
 
-		if (childIndex == 1)
-			node->child[0] = MASH_NEW_T_COMMON(KDNode);
+		m_nodes[nodeIndex].splitPosition = splitPosition;
 
-		memcpy(&childIndex, &dataArray[nextByte], sizeof(uint32));
-		nextByte += sizeof(uint32);
+		//missing children become empty leaves
+		if (containsChild[0])
+			_DeserializeLegacyNode(dataArray, nextByte);
+		else
+			CreateLeaf(m_leafTriangles, 0, 0);
 
-		if (childIndex == 1)
-			node->child[1] = MASH_NEW_T_COMMON(KDNode);
+		const uint32 rightChild = m_nodes.Size();
+		if (containsChild[1])
+			_DeserializeLegacyNode(dataArray, nextByte);
+		else
+			CreateLeaf(m_leafTriangles, 0, 0);
 
-		if (node->child[0])
-			_Deserialize(node->child[0], dataArray, nextByte);
-		if (node->child[1])
-			_Deserialize(node->child[1], dataArray, nextByte);
+		m_nodes[nodeIndex].flags = axis | (rightChild << 2);
+	}
+
+	uint32 CMashTriColliderKDTree::_GetTreeDepth()const
+	{
+		if (m_nodes.Empty())
+			return 0;
+
+		//heap stack as the tree being checked may be deeper than the traversal stacks allow
+		MashArray<uint32> nodeStack;
+		MashArray<uint32> depthStack;
+		nodeStack.PushBack(0);
+		depthStack.PushBack(0);
+
+		const uint32 nodeCount = m_nodes.Size();
+		uint32 maxDepth = 0;
+		while(!nodeStack.Empty())
+		{
+			const uint32 nodeIndex = nodeStack.Back();
+			const uint32 depth = depthStack.Back();
+			nodeStack.PopBack();
+			depthStack.PopBack();
+
+			if (depth > maxDepth)
+				maxDepth = depth;
+
+			const sNode &node = m_nodes[nodeIndex];
+			if (node.IsLeaf())
+				continue;
+
+			//children always follow their parent so this also stops cycles
+			const uint32 rightChild = node.GetRightChild();
+			if ((nodeIndex + 1 >= nodeCount) || (rightChild <= nodeIndex + 1) || (rightChild >= nodeCount))
+				return 0xFFFFFFFF;
+
+			nodeStack.PushBack(nodeIndex + 1);
+			depthStack.PushBack(depth + 1);
+			nodeStack.PushBack(rightChild);
+			depthStack.PushBack(depth + 1);
+		}
+
+		return maxDepth;
 	}
 
 	void CMashTriColliderKDTree::Deserialize(const uint8 *dataArray, uint32 &bytesRead)
 	{
 		uint32 nextByte = 0;
 
-		uint32 containsRoot = 0;
-		memcpy(&containsRoot, dataArray, sizeof(uint32));
+		m_nodes.Clear();
+		m_leafTriangles.Clear();
+
+		uint32 layoutTag = 0;
+		memcpy(&layoutTag, dataArray, sizeof(uint32));
 		nextByte += sizeof(uint32);
 
-		if (containsRoot == 1)
+		if (layoutTag == g_kdTreeFlatLayoutTag)
 		{
-			m_root = MASH_NEW_T_COMMON(KDNode);
-			_Deserialize(m_root, dataArray, nextByte);
+			memcpy(&m_bounds.min, &dataArray[nextByte], sizeof(MashVector3));
+			nextByte += sizeof(MashVector3);
+			memcpy(&m_bounds.max, &dataArray[nextByte], sizeof(MashVector3));
+			nextByte += sizeof(MashVector3);
+
+			uint32 nodeCount = 0;
+			memcpy(&nodeCount, &dataArray[nextByte], sizeof(uint32));
+			nextByte += sizeof(uint32);
+
+			if (nodeCount > 0)
+			{
+				m_nodes.Resize(nodeCount);
+				memcpy(m_nodes.Pointer(), &dataArray[nextByte], sizeof(sNode) * nodeCount);
+				nextByte += sizeof(sNode) * nodeCount;
+			}
+
+			uint32 leafTriangleCount = 0;
+			memcpy(&leafTriangleCount, &dataArray[nextByte], sizeof(uint32));
+			nextByte += sizeof(uint32);
+
+			if (leafTriangleCount > 0)
+			{
+				m_leafTriangles.Resize(leafTriangleCount);
+				memcpy(m_leafTriangles.Pointer(), &dataArray[nextByte], sizeof(uint32) * leafTriangleCount);
+				nextByte += sizeof(uint32) * leafTriangleCount;
+			}
+		}
+		else
+		{
+			if (layoutTag == 1)
+				_DeserializeLegacyNode(dataArray, nextByte);
+
+			//older files did not store the bounds
+			CalculateBounds();
 		}
 
 		uint32 triPoolSize = 0;
@@ -139,391 +310,637 @@ namespace mash
 			nextByte += sizeof(sTriangleData) * triPoolSize;
 		}
 
+		/*
+			Trees from the old builder had no depth limit. Deeper trees would overflow
+			the fixed traversal stacks so they are rebuilt from the triangle buffers.
+		*/
+		if (_GetTreeDepth() > g_kdTreeMaxDepth)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_WARNING,
+				"Loaded kd tree is too deep or invalid. It will be rebuilt.",
+				"CMashTriColliderKDTree::Deserialize");
+
+			GenerateSpacialData();
+		}
+		else
+		{
+			_BuildLeafTrianglePoints();
+		}
+
 		bytesRead += nextByte;
 	}
 
-	void CMashTriColliderKDTree::SplitNode(KDNode *parent, 
-		const MashArray<uint32> &triangleList, 
-		MashAABB &parentBounds, 
-		//uint32 maxDepth, 
-		uint32 desiredTriangledPerNode, 
-		uint32 &currentDepth,
-		uint32 axisTriCount[3])
+	void CMashTriColliderKDTree::CreateLeaf(const MashArray<uint32> &workingTriangles, uint32 first, uint32 count)
 	{
-		parent->axis = currentDepth % 3;
-		//just halve the aabb on the current axis to determine the splitting plane
-		parent->splitPosition = (parentBounds.max[parent->axis] + parentBounds.min[parent->axis]) * 0.5f;
-		parent->child[0] = 0;
-		parent->child[1] = 0;
+		sNode leaf;
+		leaf.firstTriangle = m_leafTriangles.Size();
+		leaf.flags = sNode::aLEAF_NODE | (count << 2);
+		m_nodes.PushBack(leaf);
 
-		//quit condition
-		const uint32 triangleCount = triangleList.Size();
+		if (count > 0)
+			m_leafTriangles.Append(&workingTriangles[first], count);
+	}
+
+	void CMashTriColliderKDTree::BuildNode(const MashArray<MashAABB> &triangleBounds, 
+			MashArray<uint32> &workingTriangles, 
+			uint32 first, 
+			uint32 count, 
+			const MashAABB &nodeBounds, 
+			uint32 depth, 
+			uint32 maxDepth,
+			uint32 minTrianglesPerLeaf)
+	{
+		const f32 nodeArea = GetSurfaceArea(nodeBounds);
+		if ((count <= minTrianglesPerLeaf) || (depth >= maxDepth) || (nodeArea <= 0.0f))
+		{
+			CreateLeaf(workingTriangles, first, count);
+			return;
+		}
 
 		/*
-			If all axis have the same tri count then weve reached a point where
-			tris wont subdivide any further.
+			Binned surface area heuristic. Triangle extents are binned along each axis.
+			A triangle is counted in the left child if it starts before a bin boundary and in
+			the right child if it ends after it, so straddling triangles are counted in both.
 		*/
-		bool forceLeafNode = axisTriCount[0] == axisTriCount[1] && axisTriCount[1] == axisTriCount[2];
-		if (forceLeafNode || (triangleCount < desiredTriangledPerNode))
+		const f32 invNodeArea = 1.0f / nodeArea;
+		const f32 leafCost = g_kdTreeIntersectionCost * count;
+		f32 bestCost = leafCost;
+		uint32 bestAxis = 0;
+		f32 bestSplit = 0.0f;
+		bool splitFound = false;
+
+		uint32 minBins[g_kdTreeSAHBinCount];
+		uint32 maxBins[g_kdTreeSAHBinCount];
+
+		for(uint32 axis = 0; axis < 3; ++axis)
 		{
-			//this is a leaf node
-			parent->triangleCount = triangleCount;
-			//use alloc for speedier allocations
-			parent->triangleIndexList = MASH_ALLOC_T_COMMON(uint32, parent->triangleCount);
+			const f32 axisMin = nodeBounds.min.v[axis];
+			const f32 axisExtent = nodeBounds.max.v[axis] - axisMin;
+			if (axisExtent <= 0.0f)
+				continue;
 
-			for(uint32 i = 0; i < triangleCount; ++i)
-				parent->triangleIndexList[i] = triangleList[i];
+			memset(minBins, 0, sizeof(minBins));
+			memset(maxBins, 0, sizeof(maxBins));
 
-			return;
-		}
+			const f32 binScale = g_kdTreeSAHBinCount / axisExtent;
+			for(uint32 i = 0; i < count; ++i)
+			{
+				const MashAABB &bounds = triangleBounds[workingTriangles[first + i]];
+				const int32 minBin = (int32)((bounds.min.v[axis] - axisMin) * binScale);
+				const int32 maxBin = (int32)((bounds.max.v[axis] - axisMin) * binScale);
+				++minBins[math::Clamp<int32>(0, g_kdTreeSAHBinCount - 1, minBin)];
+				++maxBins[math::Clamp<int32>(0, g_kdTreeSAHBinCount - 1, maxBin)];
+			}
 
-		MashArray<uint32> leftTris;
-		MashArray<uint32> rightTris;
+			uint32 leftCount = 0;
+			uint32 rightCount = count;
+			for(uint32 bin = 1; bin < g_kdTreeSAHBinCount; ++bin)
+			{
+				leftCount += minBins[bin - 1];
+				rightCount -= maxBins[bin - 1];
 
-		f32 p0, p1, p2;
-		sTriangleData *curTri = 0;
-		int boundarySide = 0;
-		for(uint32 i = 0; i < triangleCount; ++i)
-		{
-			boundarySide = 0;
-			curTri = &m_triangleDataPool[triangleList[i]];
-			p0 = m_triangleBuffers[curTri->triangleBuffer]->GetPoint(curTri->triangleIndex, 0)[parent->axis];
-			p1 = m_triangleBuffers[curTri->triangleBuffer]->GetPoint(curTri->triangleIndex, 1)[parent->axis];
-			p2 = m_triangleBuffers[curTri->triangleBuffer]->GetPoint(curTri->triangleIndex, 2)[parent->axis];
+				const f32 split = axisMin + ((axisExtent * bin) / g_kdTreeSAHBinCount);
+
+				MashAABB leftBounds(nodeBounds);
+				leftBounds.max.v[axis] = split;
+				MashAABB rightBounds(nodeBounds);
+				rightBounds.min.v[axis] = split;
+
+				const f32 leftProbability = GetSurfaceArea(leftBounds) * invNodeArea;
+				const f32 rightProbability = GetSurfaceArea(rightBounds) * invNodeArea;
+				const f32 bonus = ((leftCount == 0) || (rightCount == 0)) ? g_kdTreeEmptyBonus : 0.0f;
 
-			/*
-				TODO : Should this be checking edge intersections too?
-			*/
+				const f32 cost = g_kdTreeTraversalCost + 
+					(g_kdTreeIntersectionCost * (1.0f - bonus) * ((leftProbability * leftCount) + (rightProbability * rightCount)));
 
-			//a triangle can live in both sides if it overlaps the boundary.
-			if ((p0 < parent->splitPosition) || (p1 < parent->splitPosition) || (p2 < parent->splitPosition))
-				leftTris.PushBack(triangleList[i]);
-			
-			if ((p0 >= parent->splitPosition) || (p1 >= parent->splitPosition) || (p2 >= parent->splitPosition))
-				rightTris.PushBack(triangleList[i]);
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = split;
+					splitFound = true;
+				}
+			}
 		}
 
-		if (!leftTris.Empty())
+		if (!splitFound)
 		{
-			f32 oldMax = parentBounds.max[parent->axis];
-			parentBounds.max.v[parent->axis] = parent->splitPosition;
-			uint32 oldAxisCount = axisTriCount[parent->axis];
-			axisTriCount[parent->axis] = leftTris.Size();
-
-			++currentDepth;
-			parent->child[0] = MASH_NEW_T_COMMON(KDNode);
-			SplitNode(parent->child[0], leftTris, parentBounds/*, maxDepth*/, desiredTriangledPerNode, currentDepth, axisTriCount);
-			--currentDepth;
+			CreateLeaf(workingTriangles, first, count);
+			return;
+		}
 
-			parentBounds.max.v[parent->axis] = oldMax;
-			axisTriCount[parent->axis] = oldAxisCount;
+		//child lists are appended to the end of the working list
+		const uint32 leftFirst = workingTriangles.Size();
+		for(uint32 i = 0; i < count; ++i)
+		{
+			const uint32 triangle = workingTriangles[first + i];
+			if (triangleBounds[triangle].min.v[bestAxis] < bestSplit)
+				workingTriangles.PushBack(triangle);
 		}
 
-		if (!rightTris.Empty())
+		const uint32 rightFirst = workingTriangles.Size();
+		for(uint32 i = 0; i < count; ++i)
 		{
-			f32 oldMin = parentBounds.min[parent->axis];
-			parentBounds.min.v[parent->axis] = parent->splitPosition;
-			uint32 oldAxisCount = axisTriCount[parent->axis];
-			axisTriCount[parent->axis] = rightTris.Size();
+			const uint32 triangle = workingTriangles[first + i];
+			if (triangleBounds[triangle].max.v[bestAxis] >= bestSplit)
+				workingTriangles.PushBack(triangle);
+		}
 
-			++currentDepth;
-			parent->child[1] = MASH_NEW_T_COMMON(KDNode);
-			SplitNode(parent->child[1], rightTris, parentBounds/*, maxDepth*/, desiredTriangledPerNode, currentDepth, axisTriCount);
-			--currentDepth;
+		const uint32 leftCount = rightFirst - leftFirst;
+		const uint32 rightCount = workingTriangles.Size() - rightFirst;
 
-			parentBounds.min.v[parent->axis] = oldMin;
-			axisTriCount[parent->axis] = oldAxisCount;
+		//binning may be slightly off from the actual partition. Stop if nothing was seperated.
+		if ((leftCount == count) && (rightCount == count))
+		{
+			workingTriangles.Resize(leftFirst);
+			CreateLeaf(workingTriangles, first, count);
+			return;
 		}
+
+		const uint32 nodeIndex = m_nodes.Size();
+		m_nodes.PushBack(sNode());
+		m_nodes[nodeIndex].splitPosition = bestSplit;
+
+		MashAABB childBounds(nodeBounds);
+		childBounds.max.v[bestAxis] = bestSplit;
+		BuildNode(triangleBounds, workingTriangles, leftFirst, leftCount, childBounds, depth + 1, maxDepth, minTrianglesPerLeaf);
+
+		const uint32 rightChild = m_nodes.Size();
+		childBounds = nodeBounds;
+		childBounds.min.v[bestAxis] = bestSplit;
+		BuildNode(triangleBounds, workingTriangles, rightFirst, rightCount, childBounds, depth + 1, maxDepth, minTrianglesPerLeaf);
+
+		m_nodes[nodeIndex].flags = bestAxis | (rightChild << 2);
+
+		workingTriangles.Resize(leftFirst);
 	}
 
-	void CMashTriColliderKDTree::CreateTree(uint32 maxDepth, uint32 desiredTriangledPerNode)
+	void CMashTriColliderKDTree::CalculateBounds()
 	{
-		MashAABB totalAABB(MashVector3(mash::math::MaxFloat(), mash::math::MaxFloat(), mash::math::MaxFloat()),
+		m_bounds = MashAABB(MashVector3(mash::math::MaxFloat(), mash::math::MaxFloat(), mash::math::MaxFloat()),
 			MashVector3(mash::math::MinFloat(), mash::math::MinFloat(), mash::math::MinFloat()));
 
-		uint32 triangleCount = 0;
 		for(uint32 i = 0; i < m_triangleBuffers.Size(); ++i)
 		{
-			const MashTriangleBuffer *triangleBuffer = m_triangleBuffers[i];
-
-			/*
-				Create an aabb that contains all the triangles. This will be used to determine the
-				splitting plane later.
-			*/
-			MashArray<mash::MashVector3>::ConstIterator pointIter = triangleBuffer->GetVertexList().Begin();
-			MashArray<mash::MashVector3>::ConstIterator pointIterEnd = triangleBuffer->GetVertexList().End();
+			MashArray<mash::MashVector3>::ConstIterator pointIter = m_triangleBuffers[i]->GetVertexList().Begin();
+			MashArray<mash::MashVector3>::ConstIterator pointIterEnd = m_triangleBuffers[i]->GetVertexList().End();
 			for(; pointIter != pointIterEnd; ++pointIter)
 			{
-				totalAABB.Add(*pointIter);
+				m_bounds.Add(*pointIter);
 			}
-
-			triangleCount += triangleBuffer->GetTriangleCount();
 		}
+	}
+
+	void CMashTriColliderKDTree::CreateTree(uint32 maxDepth, uint32 minTrianglesPerLeaf)
+	{
+		m_nodes.Clear();
+		m_leafTriangles.Clear();
+
+		CalculateBounds();
+
+		uint32 triangleCount = 0;
+		for(uint32 i = 0; i < m_triangleBuffers.Size(); ++i)
+			triangleCount += m_triangleBuffers[i]->GetTriangleCount();
 
 		//nothing to store
 		if (triangleCount == 0)
 			return;
 
-		MashArray<uint32> triangleIndexList(triangleCount);
-
 		/*
 			Now we build the pool of triangles for this tree. A node will reference this data so we
 			don't waste memory when triangle data needs to be duplicated due to boundary cases.
 		*/
+		MashArray<uint32> workingTriangles(triangleCount);
+		MashArray<MashAABB> triangleBounds(triangleCount);
 		m_triangleDataPool.Resize(triangleCount);
 		uint32 currentTriangle = 0;
 		for(uint32 i = 0; i < m_triangleBuffers.Size(); ++i)
 		{
-			uint32 curBufferTriCount = m_triangleBuffers[i]->GetTriangleCount();
+			const MashTriangleBuffer *triangleBuffer = m_triangleBuffers[i];
+			uint32 curBufferTriCount = triangleBuffer->GetTriangleCount();
 			for(uint32 tri = 0; tri < curBufferTriCount; ++tri)
 			{
 				m_triangleDataPool[currentTriangle].triangleBuffer = i;
 				m_triangleDataPool[currentTriangle].triangleIndex = tri;
 
-				//generate a list of triangle indices. This is what the leaf nodes will hold
-				triangleIndexList[currentTriangle] = currentTriangle;
+				MashAABB &bounds = triangleBounds[currentTriangle];
+				bounds.min = triangleBuffer->GetPoint(tri, 0);
+				bounds.max = bounds.min;
+				bounds.Add(triangleBuffer->GetPoint(tri, 1));
+				bounds.Add(triangleBuffer->GetPoint(tri, 2));
+
+				workingTriangles[currentTriangle] = currentTriangle;
 
 				++currentTriangle;
 			}
 		}
 
-		m_root = MASH_NEW_T_COMMON(KDNode);
+		m_nodes.Reserve(((triangleCount / minTrianglesPerLeaf) + 1) * 2);
+		m_leafTriangles.Reserve(triangleCount * 2);
+
+		BuildNode(triangleBounds, workingTriangles, 0, triangleCount, m_bounds, 0, maxDepth, minTrianglesPerLeaf);
 
-		uint32 currentDepth = 0;
-		uint32 axisTriCount[] = {0, mash::math::MaxUInt32() / 2, mash::math::MaxUInt32()};
-		SplitNode(m_root, triangleIndexList, totalAABB/*, maxDepth*/, desiredTriangledPerNode, currentDepth, axisTriCount);
+		_BuildLeafTrianglePoints();
 	}
 
-	bool CMashTriColliderKDTree::GetIntersectingTriangles(KDNode *node, const mash::MashRay &ray, MashArray<sTriPickResult> &out)const
+	void CMashTriColliderKDTree::_BuildLeafTrianglePoints()
 	{
-		if (!node)
-			return (!out.Empty());
+		m_leafTrianglePoints.Clear();
+		m_leafPointOffsets.Clear();
+
+		const uint32 nodeCount = m_nodes.Size();
+		if (nodeCount == 0)
+			return;
 
-		if (node->triangleCount > 0)
+		uint32 blockCount = 0;
+		for(uint32 n = 0; n < nodeCount; ++n)
 		{
-			//check triangles
-			for(uint32 i = 0; i < node->triangleCount; ++i)
+			if (m_nodes[n].IsLeaf())
+				blockCount += (m_nodes[n].GetTriangleCount() + 3) / 4;
+		}
+
+		m_leafPointOffsets.Resize(nodeCount);
+		m_leafTrianglePoints.Resize(blockCount * g_kdTreeTriangleBlockSize);
+		if (blockCount > 0)
+			memset(m_leafTrianglePoints.Pointer(), 0, m_leafTrianglePoints.Size() * sizeof(f32));
+
+		uint32 nextFloat = 0;
+		for(uint32 n = 0; n < nodeCount; ++n)
+		{
+			const sNode &node = m_nodes[n];
+			if (!node.IsLeaf())
 			{
-				const sTriangleData *currentTriangleData = &m_triangleDataPool[node->triangleIndexList[i]];
-				m_triangleBuffers[currentTriangleData->triangleBuffer]->GetPoint(currentTriangleData->triangleIndex, 0);
-				sTriPickResult result;
-				if (mash::collision::Ray_Triangle(m_triangleBuffers[currentTriangleData->triangleBuffer]->GetPoint(currentTriangleData->triangleIndex, 0), 
-					m_triangleBuffers[currentTriangleData->triangleBuffer]->GetPoint(currentTriangleData->triangleIndex, 1), 
-					m_triangleBuffers[currentTriangleData->triangleBuffer]->GetPoint(currentTriangleData->triangleIndex, 2),//tri,
-					ray,
-					result.u,
-					result.v,
-					result.w,
-					result.distance))
-				{
-					result.bufferIndex = currentTriangleData->triangleBuffer;
-					result.triangleIndex = currentTriangleData->triangleIndex;
-					result.collision = true;
+				m_leafPointOffsets[n] = 0;
+				continue;
+			}
+
+			m_leafPointOffsets[n] = nextFloat;
 
-					out.PushBack(result);
+			const uint32 triangleCount = node.GetTriangleCount();
+			for(uint32 i = 0; i < triangleCount; ++i)
+			{
+				const sTriangleData &triangleData = m_triangleDataPool[m_leafTriangles[node.firstTriangle + i]];
+				const MashTriangleBuffer *triangleBuffer = m_triangleBuffers[triangleData.triangleBuffer];
+				f32 *block = &m_leafTrianglePoints[nextFloat + ((i / 4) * g_kdTreeTriangleBlockSize)];
+				const uint32 lane = i % 4;
+				for(uint32 p = 0; p < 3; ++p)
+				{
+					const MashVector3 &point = triangleBuffer->GetPoint(triangleData.triangleIndex, p);
+					block[(p * 12) + lane] = point.x;
+					block[(p * 12) + 4 + lane] = point.y;
+					block[(p * 12) + 8 + lane] = point.z;
 				}
 			}
+
+			nextFloat += ((triangleCount + 3) / 4) * g_kdTreeTriangleBlockSize;
 		}
+	}
 
-		uint32 axis = node->axis;
-		uint32 firstNodeToCheck = ray.origin[axis] > node->splitPosition;
+	bool CMashTriColliderKDTree::ClipRayToBounds(const mash::MashRay &ray, f32 &tMinOut, f32 &tMaxOut)const
+	{
+		tMinOut = 0.0f;
+		tMaxOut = mash::math::MaxFloat();
 
-		if (ray.dir[axis] == 0.0f)
-		{
-			GetIntersectingTriangles(node->child[firstNodeToCheck], ray, out);
-		}
-		else
+		for(uint32 axis = 0; axis < 3; ++axis)
 		{
-			float t = (node->splitPosition - ray.origin[axis]) / ray.dir[axis];
-
-			if (0.0f <= t)
+			if (ray.dir.v[axis] == 0.0f)
 			{
-				GetIntersectingTriangles(node->child[firstNodeToCheck], ray, out);
-				GetIntersectingTriangles(node->child[firstNodeToCheck ^ 1], ray, out);
+				if ((ray.origin.v[axis] < m_bounds.min.v[axis]) || (ray.origin.v[axis] > m_bounds.max.v[axis]))
+					return false;
 			}
 			else
 			{
-				GetIntersectingTriangles(node->child[firstNodeToCheck], ray, out);
+				const f32 invDir = 1.0f / ray.dir.v[axis];
+				f32 tNear = (m_bounds.min.v[axis] - ray.origin.v[axis]) * invDir;
+				f32 tFar = (m_bounds.max.v[axis] - ray.origin.v[axis]) * invDir;
+				if (tNear > tFar)
+					std::swap(tNear, tFar);
+
+				tMinOut = math::Max<f32>(tMinOut, tNear);
+				tMaxOut = math::Min<f32>(tMaxOut, tFar);
+				if (tMinOut > tMaxOut)
+					return false;
 			}
 		}
 
-		return (!out.Empty());
+		return true;
 	}
 
-	void CMashTriColliderKDTree::_GetIntersectingTriangles(KDNode *node, 
-			const sCollectIntersectionData &bodyData,
-			MashVector3 &volNearPt,
-			bool &collisionFound,
-			MashArray<sIntersectingTriangleResult> &out)const
+	bool CMashTriColliderKDTree::GetIntersectingTriangles(const mash::MashRay &ray, MashArray<sTriPickResult> &out)const
 	{
-		if (!node)
-			return;
+		f32 tMin, tMax;
+		if (m_nodes.Empty() || !ClipRayToBounds(ray, tMin, tMax))
+			return (!out.Empty());
 
-		if (node->triangleCount > 0)
+		const uint32 firstResult = out.Size();
+
+		sTraversalData stack[g_kdTreeMaxDepth + 1];
+		uint32 stackSize = 0;
+		uint32 nodeIndex = 0;
+
+		while(true)
 		{
-			//check triangles
-			sIntersectingTriangleResult result;
-			for(uint32 i = 0; i < node->triangleCount; ++i)
+			const sNode &node = m_nodes[nodeIndex];
+			if (node.IsLeaf())
 			{
-				
-				if (m_intersectionCheckCache[node->triangleIndexList[i]] == 0)
-				{//++tricolcounter;
-					const sTriangleData *currentTriangleData = &m_triangleDataPool[node->triangleIndexList[i]];
-					
-					if (mash::collision::AABB_Triangle(bodyData.aabb, 
-						m_triangleBuffers[currentTriangleData->triangleBuffer]->GetPoint(currentTriangleData->triangleIndex, 0), 
-						m_triangleBuffers[currentTriangleData->triangleBuffer]->GetPoint(currentTriangleData->triangleIndex, 1), 
-						m_triangleBuffers[currentTriangleData->triangleBuffer]->GetPoint(currentTriangleData->triangleIndex, 2)))
-					{
-						collisionFound = true;
+				const uint32 *leafTriangles = m_leafTriangles.Pointer() + node.firstTriangle;
+				const uint32 triangleCount = node.GetTriangleCount();
+				const f32 *points = m_leafTrianglePoints.Pointer() + m_leafPointOffsets[nodeIndex];
+				for(uint32 i = 0; i < triangleCount; i += 4, points += g_kdTreeTriangleBlockSize)
+				{
+					f32 t[4], v[4], w[4];
+					const uint32 hits = simd::RayTriangle4(points, ray.origin.v, ray.dir.v, t, v, w);
+					if (hits == 0)
+						continue;
 
+					for(uint32 lane = 0; lane < 4; ++lane)
+					{
+						if (!(hits & (1 << lane)))
+							continue;
+
+						const sTriangleData *currentTriangleData = &m_triangleDataPool[leafTriangles[i + lane]];
+						sTriPickResult result;
+						result.distance = t[lane];
+						result.v = v[lane];
+						result.w = w[lane];
+						result.u = 1.0f - v[lane] - w[lane];
 						result.bufferIndex = currentTriangleData->triangleBuffer;
 						result.triangleIndex = currentTriangleData->triangleIndex;
+						result.collision = true;
+
 						out.PushBack(result);
 					}
+				}
+
+				if (stackSize == 0)
+					break;
 
-					m_intersectionCheckCache[node->triangleIndexList[i]] = 1;
+				--stackSize;
+				nodeIndex = stack[stackSize].node;
+				tMin = stack[stackSize].tMin;
+				tMax = stack[stackSize].tMax;
+			}
+			else
+			{
+				const uint32 axis = node.GetAxis();
+				const bool originBelow = (ray.origin.v[axis] < node.splitPosition) || 
+					((ray.origin.v[axis] == node.splitPosition) && (ray.dir.v[axis] <= 0.0f));
+
+				const uint32 nearChild = originBelow ? (nodeIndex + 1) : node.GetRightChild();
+				const uint32 farChild = originBelow ? node.GetRightChild() : (nodeIndex + 1);
+
+				if (ray.dir.v[axis] == 0.0f)
+				{
+					nodeIndex = nearChild;
+					continue;
+				}
+
+				const f32 tSplit = (node.splitPosition - ray.origin.v[axis]) / ray.dir.v[axis];
+				if ((tSplit > tMax) || (tSplit <= 0.0f))
+				{
+					nodeIndex = nearChild;
+				}
+				else if (tSplit < tMin)
+				{
+					nodeIndex = farChild;
+				}
+				else
+				{
+					stack[stackSize].node = farChild;
+					stack[stackSize].tMin = tSplit;
+					stack[stackSize].tMax = tMax;
+					++stackSize;
+
+					nodeIndex = nearChild;
+					tMax = tSplit;
 				}
 			}
 		}
 
-		// Figure out which child to recurse into first (0 = near, 1 = far)
-		uint32 firstNodeToCheck = bodyData.aabbCenter.v[node->axis] > node->splitPosition;
+		/*
+			Triangles that straddle a split live in more than one leaf. Remove
+			any duplicates from this query.
+		*/
+		struct sResultSort
+		{
+			bool operator()(const sTriPickResult &a, const sTriPickResult &b)const
+			{
+				if (a.bufferIndex != b.bufferIndex)
+					return a.bufferIndex < b.bufferIndex;
 
-		// Always recurse into the subtree the sphere center is in
-		_GetIntersectingTriangles(node->child[firstNodeToCheck], bodyData, volNearPt, collisionFound, out);
+				return a.triangleIndex < b.triangleIndex;
+			}
+		};
 
-		// Update (by clamping) nearest point on volume when traversing far side.
-		// Keep old value on the local stack so it can be restored later
-		f32 oldValue = volNearPt[node->axis];
-		volNearPt.v[node->axis] = node->splitPosition;
+		const uint32 resultCount = out.Size() - firstResult;
+		if (resultCount > 1)
+		{
+			sTriPickResult *results = out.Pointer() + firstResult;
+			std::sort(results, results + resultCount, sResultSort());
 
-		// If sphere overlaps the volume of the far node, recurse that subtree too
-		//if (volNearPt.GetDistanceToSQ(bodyData.sphereCenter) < (bodyData.sphereRadius * bodyData.sphereRadius))
-		//	_GetIntersectingTriangles(node->child[firstNodeToCheck ^ 1], bodyData, volNearPt, collisionFound, out);
-		if (bodyData.aabb.Intersects(volNearPt))
-			_GetIntersectingTriangles(node->child[firstNodeToCheck ^ 1], bodyData, volNearPt, collisionFound, out);
-		
+			uint32 uniqueCount = 1;
+			for(uint32 i = 1; i < resultCount; ++i)
+			{
+				if ((results[i].bufferIndex != results[uniqueCount - 1].bufferIndex) || 
+					(results[i].triangleIndex != results[uniqueCount - 1].triangleIndex))
+				{
+					results[uniqueCount++] = results[i];
+				}
+			}
+
+			out.Resize(firstResult + uniqueCount);
+		}
 
-		// Restore component of nearest pt on volume when returning
-		volNearPt.v[node->axis] = oldValue;
+		return (!out.Empty());
 	}
 
-	bool CMashTriColliderKDTree::GetIntersectingTriangles(const MashAABB &bounds, 
-			const MashTransformState &transform, 
-			MashArray<sIntersectingTriangleResult> &out)const
+	bool CMashTriColliderKDTree::CollectIntersectingTriangles(const MashAABB &localBounds, 
+		MashArray<uint32> &candidatesScratch, 
+		MashArray<sIntersectingTriangleResult> &out)const
 	{
-		//tricolcounter = 0;
-		sCollectIntersectionData bodyData;
+		if (m_nodes.Empty())
+			return false;
 
-		/*
-			m_intersectionCheckCache is only used here. So we resize it here only so
-			it doesn't reserve memory when its not needed.
+		candidatesScratch.Clear();
 
-			fill is specialized for char types using memset.
-		*/
-		if (m_intersectionCheckCache.size() < m_triangleDataPool.Size())
-			m_intersectionCheckCache.resize(m_triangleDataPool.Size(), false);
-		else
-			std::fill(m_intersectionCheckCache.begin(), m_intersectionCheckCache.end(), 0);
+		uint32 stack[g_kdTreeMaxDepth + 1];
+		uint32 stackSize = 0;
+		uint32 nodeIndex = 0;
 
-		bodyData.aabb = bounds;
-		bodyData.aabb.TransformInverse(transform);
+		while(true)
+		{
+			const sNode &node = m_nodes[nodeIndex];
+			if (node.IsLeaf())
+			{
+				candidatesScratch.Append(m_leafTriangles.Pointer() + node.firstTriangle, node.GetTriangleCount());
+
+				if (stackSize == 0)
+					break;
+
+				nodeIndex = stack[--stackSize];
+			}
+			else
+			{
+				const uint32 axis = node.GetAxis();
+				const bool visitLeft = localBounds.min.v[axis] < node.splitPosition;
+				const bool visitRight = localBounds.max.v[axis] >= node.splitPosition;
 
-		//convert aabb to sphere
-		bodyData.aabbCenter = bodyData.aabb.GetCenter();
+				if (visitLeft && visitRight)
+				{
+					stack[stackSize++] = node.GetRightChild();
+					nodeIndex = nodeIndex + 1;
+				}
+				else if (visitLeft)
+				{
+					nodeIndex = nodeIndex + 1;
+				}
+				else
+				{
+					nodeIndex = node.GetRightChild();
+				}
+			}
+		}
+
+		/*
+			Triangles that straddle a split live in more than one leaf. Duplicates
+			are removed before testing so each triangle is only tested once.
+		*/
+		uint32 *candidates = candidatesScratch.Pointer();
+		const uint32 candidateCount = candidatesScratch.Size();
+		std::sort(candidates, candidates + candidateCount);
 
-		MashVector3 volNearPt = bodyData.aabbCenter;
 		bool collisionFound = false;
-		_GetIntersectingTriangles(m_root, bodyData, volNearPt, collisionFound, out);
+		sIntersectingTriangleResult result;
+		for(uint32 i = 0; i < candidateCount; ++i)
+		{
+			if ((i > 0) && (candidates[i] == candidates[i - 1]))
+				continue;
+
+			const sTriangleData *currentTriangleData = &m_triangleDataPool[candidates[i]];
+			const MashTriangleBuffer *triangleBuffer = m_triangleBuffers[currentTriangleData->triangleBuffer];
+		
+			if (mash::collision::AABB_Triangle(localBounds, 
+				triangleBuffer->GetPoint(currentTriangleData->triangleIndex, 0), 
+				triangleBuffer->GetPoint(currentTriangleData->triangleIndex, 1), 
+				triangleBuffer->GetPoint(currentTriangleData->triangleIndex, 2)))
+			{
+				collisionFound = true;
+
+				result.bufferIndex = currentTriangleData->triangleBuffer;
+				result.triangleIndex = currentTriangleData->triangleIndex;
+				out.PushBack(result);
+			}
+		}
+
 		return collisionFound;
 	}
 
-	bool CMashTriColliderKDTree::GetClosestTriangle(KDNode *node, const mash::MashRay &ray, bool quitOnFirstCollision, sTriPickResult &out)const
+	bool CMashTriColliderKDTree::GetClosestTriangle(const mash::MashRay &ray, bool quitOnFirstCollision, sTriPickResult &out)const
 	{
-		if (!node)
+		f32 tMin, tMax;
+		if (m_nodes.Empty() || !ClipRayToBounds(ray, tMin, tMax))
 			return out.collision;
 
-		if (node->triangleCount > 0)
+		sTraversalData stack[g_kdTreeMaxDepth + 1];
+		uint32 stackSize = 0;
+		uint32 nodeIndex = 0;
+
+		while(true)
 		{
-			//check triangles
-			for(uint32 i = 0; i < node->triangleCount; ++i)
+			const sNode &node = m_nodes[nodeIndex];
+			if (node.IsLeaf())
 			{
-				const sTriangleData *currentTriangleData = &m_triangleDataPool[node->triangleIndexList[i]];
-				sTriPickResult result;
-				if (mash::collision::Ray_Triangle(m_triangleBuffers[currentTriangleData->triangleBuffer]->GetPoint(currentTriangleData->triangleIndex, 0), 
-					m_triangleBuffers[currentTriangleData->triangleBuffer]->GetPoint(currentTriangleData->triangleIndex, 1), 
-					m_triangleBuffers[currentTriangleData->triangleBuffer]->GetPoint(currentTriangleData->triangleIndex, 2),//tri,
-					ray,
-					result.u,
-					result.v,
-					result.w,
-					result.distance))
+				const uint32 *leafTriangles = m_leafTriangles.Pointer() + node.firstTriangle;
+				const uint32 triangleCount = node.GetTriangleCount();
+				const f32 *points = m_leafTrianglePoints.Pointer() + m_leafPointOffsets[nodeIndex];
+				for(uint32 i = 0; i < triangleCount; i += 4, points += g_kdTreeTriangleBlockSize)
 				{
-					if (result.distance < out.distance)
-					{
-						out.bufferIndex = currentTriangleData->triangleBuffer;
-						out.triangleIndex = currentTriangleData->triangleIndex;
-						out.distance = result.distance;
+					f32 t[4], v[4], w[4];
+					const uint32 hits = simd::RayTriangle4(points, ray.origin.v, ray.dir.v, t, v, w);
+					if (hits == 0)
+						continue;
 
-						out.u = result.u;
-						out.v = result.v;
-						out.w = result.w;
-						out.collision = true;
-
-						if (quitOnFirstCollision)
-							return true;
+					//lanes are checked in triangle order so ties resolve as they did one at a time
+					for(uint32 lane = 0; lane < 4; ++lane)
+					{
+						if ((hits & (1 << lane)) && (t[lane] < out.distance))
+						{
+							const sTriangleData *currentTriangleData = &m_triangleDataPool[leafTriangles[i + lane]];
+							out.bufferIndex = currentTriangleData->triangleBuffer;
+							out.triangleIndex = currentTriangleData->triangleIndex;
+							out.distance = t[lane];
+
+							out.u = 1.0f - v[lane] - w[lane];
+							out.v = v[lane];
+							out.w = w[lane];
+							out.collision = true;
+
+							if (quitOnFirstCollision)
+								return true;
+						}
 					}
 				}
-			}
-		}
-
-		/*
-			Nodes are traversed in near to far order, so once a node has a triangle that
-			intersects with the ray we can exit. Note we don't exit right away because the node
-			may contain many triangles at different distances (the triangles at this node will be
-			the closest out of all other nodes).
-		*/
-		if (out.collision)
-			return true;
 
-		uint32 axis = node->axis;
-		uint32 firstNodeToCheck = ray.origin[axis] > node->splitPosition;
+				/*
+					Leaves are visited in near to far order. A hit within this leaf
+					can not be beaten by any leaf further along the ray.
+				*/
+				if (out.collision && (out.distance <= tMax))
+					break;
 
-		/*
-			If the ray is parallel to the plane then we only need to check the closest node because
-			the ray doesn't pass into the neighbour.
-		*/
-		if (ray.dir[axis] == 0.0f)
-		{
-			if (GetClosestTriangle(node->child[firstNodeToCheck], ray, quitOnFirstCollision, out))
-				return true;
-		}
-		else
-		{
-			//Gets the length along the ray (on the current axis) that an intersection with the plane occurs.
-			float t = (node->splitPosition - ray.origin[axis]) / ray.dir[axis];
+				if (stackSize == 0)
+					break;
 
-			/*
-				A positive length means the ray intersects with the plane, therefore we need to check
-				both children.
-				First we check the closest child as this will contain the closest triangles.
-			*/
-			if (0.0f <= t)
-			{
-				if (GetClosestTriangle(node->child[firstNodeToCheck], ray, quitOnFirstCollision, out))
-					return true;
+				--stackSize;
+				nodeIndex = stack[stackSize].node;
+				tMin = stack[stackSize].tMin;
+				tMax = stack[stackSize].tMax;
 
-				if (GetClosestTriangle(node->child[firstNodeToCheck ^ 1], ray, quitOnFirstCollision, out))
-					return true;
+				if (out.collision && (out.distance < tMin))
+					break;
 			}
 			else
 			{
+				const uint32 axis = node.GetAxis();
+				const bool originBelow = (ray.origin.v[axis] < node.splitPosition) || 
+					((ray.origin.v[axis] == node.splitPosition) && (ray.dir.v[axis] <= 0.0f));
+
+				const uint32 nearChild = originBelow ? (nodeIndex + 1) : node.GetRightChild();
+				const uint32 farChild = originBelow ? node.GetRightChild() : (nodeIndex + 1);
+
 				/*
-					The ray doesn't intersect the far child so we only need to check the closest child.
+					If the ray is parallel to the plane then we only need to check the closest node because
+					the ray doesn't pass into the neighbour.
 				*/
-				if (GetClosestTriangle(node->child[firstNodeToCheck], ray, quitOnFirstCollision, out))
-					return true;
+				if (ray.dir.v[axis] == 0.0f)
+				{
+					nodeIndex = nearChild;
+					continue;
+				}
+
+				//Gets the length along the ray (on the current axis) that an intersection with the plane occurs.
+				const f32 tSplit = (node.splitPosition - ray.origin.v[axis]) / ray.dir.v[axis];
+				if ((tSplit > tMax) || (tSplit <= 0.0f))
+				{
+					//the ray doesn't reach the far child
+					nodeIndex = nearChild;
+				}
+				else if (tSplit < tMin)
+				{
+					//the ray has already passed the near child
+					nodeIndex = farChild;
+				}
+				else
+				{
+					//check the near child first, it will contain the closest triangles
+					stack[stackSize].node = farChild;
+					stack[stackSize].tMin = tSplit;
+					stack[stackSize].tMax = tMax;
+					++stackSize;
+
+					nodeIndex = nearChild;
+					tMax = tSplit;
+				}
 			}
 		}
 
@@ -551,36 +968,45 @@ namespace mash
 			if (buffer[i])
 				m_triangleBuffers.PushBack(buffer[i]);
 		}
-
-		//m_intersectionCheckCache.resize(m_triangleDataPool.Size(), 0);
 	}
 
 	void CMashTriColliderKDTree::GenerateSpacialData()
 	{
-		/*
-			Use a value thats not too small to stop the tree from growing too large.
-			Meshes with very large triangles will still fill the tree unnecessarily due
-			to them not fitting into a node neatly.
+		uint32 triCount = 0;
+		for(uint32 i = 0; i < m_triangleBuffers.Size(); ++i)
+			triCount += m_triangleBuffers[i]->GetTriangleCount();
 
-			The following calculations use a rough approximation of the best case
-			scenario of triangle dispersion
+		/*
+			The surface area heuristic decides when to stop splitting. Max depth only
+			stops very large or badly formed meshes from growing without limit.
 		*/
-		uint32 desiredTrisPerNode = 20; 
-		uint32 maxDepth = 5;//NOTE : Max depth is currently not being used
+		uint32 maxDepth = 1 + (uint32)(1.3f * (log((f32)math::Max<uint32>(triCount, 1)) / log(2.0f)));
+		if (maxDepth > g_kdTreeMaxDepth)
+			maxDepth = g_kdTreeMaxDepth;
 
-		const uint32 triCount = m_triangleDataPool.Size();
-		if (triCount > 500)
-		{
-			desiredTrisPerNode = 20;
-			maxDepth = 10;
-		}
-		if (triCount > 2000)
-		{
-			desiredTrisPerNode = (triCount / 100) + 1;
-			maxDepth = 10;
-		}
+		CreateTree(maxDepth, g_kdTreeMinLeafTriangles);
+	}
 
-		CreateTree(maxDepth, desiredTrisPerNode);
+	void CMashTriColliderKDTree::ToWorldDistance(const mash::MashRay &worldRay, const MashTransformState &transform, sTriPickResult &result)const
+	{
+		/*
+			This is needed to scale the distance back into world space.
+			At the moment it may be scaled by the local scale, which would
+			be wrong.
+		*/
+		const MashTriangleBuffer *triangleBuffer = m_triangleBuffers[result.bufferIndex];
+
+		mash::MashVector3 intersectionPoint((triangleBuffer->GetPoint(result.triangleIndex, 0) * 
+				result.u) +
+				(triangleBuffer->GetPoint(result.triangleIndex, 1) * 
+				result.v) +
+				(triangleBuffer->GetPoint(result.triangleIndex, 2) * 
+				result.w));
+
+		//transform into world space
+		intersectionPoint = transform.Transform(intersectionPoint);
+		//get actual distance
+		result.distance = (worldRay.origin - intersectionPoint).Length();
 	}
 
 	bool CMashTriColliderKDTree::CheckCollision(const mash::MashRay &ray, const MashTransformState &transform)const
@@ -592,7 +1018,7 @@ namespace mash
 		out.distance = mash::math::MaxFloat();
 		out.collision = false;
 
-		return GetClosestTriangle(m_root, transformedRay, true, out);
+		return GetClosestTriangle(transformedRay, true, out);
 	}
 
 	bool CMashTriColliderKDTree::GetClosestTriangle(const mash::MashRay &ray,
@@ -605,29 +1031,10 @@ namespace mash
 		out.distance = mash::math::MaxFloat();
 		out.collision = false;
 
-		GetClosestTriangle(m_root, transformedRay, false, out);
+		GetClosestTriangle(transformedRay, false, out);
 
-		/*
-			This is needed to scale the distance back into world space.
-			At the moment it may be scaled by the local scale, which would
-			be wrong.
-		*/
 		if (out.collision)
-		{
-			const MashTriangleBuffer *triangleBuffer = m_triangleBuffers[out.bufferIndex];
-
-			mash::MashVector3 intersectionPoint((triangleBuffer->GetPoint(out.triangleIndex, 0) * 
-					out.u) +
-					(triangleBuffer->GetPoint(out.triangleIndex, 1) * 
-					out.v) +
-					(triangleBuffer->GetPoint(out.triangleIndex, 2) * 
-					out.w));
-
-			//transform into world space
-			intersectionPoint = transform.Transform(intersectionPoint);
-			//get actual distance
-			out.distance = (ray.origin - intersectionPoint).Length();
-		}
+			ToWorldDistance(ray, transform, out);
 
 		return out.collision;
 	}
@@ -639,31 +1046,257 @@ namespace mash
 		mash::MashRay transformedRay(ray);
 		transformedRay.TransformInverse(transform);
 
-		GetIntersectingTriangles(m_root, transformedRay, out);
+		const uint32 firstResult = out.Size();
+		GetIntersectingTriangles(transformedRay, out);
+
+		const uint32 trisFound = out.Size();
+		for(uint32 i = firstResult; i < trisFound; ++i)
+			ToWorldDistance(ray, transform, out[i]);
+
+		return (trisFound > firstResult);
+	}
+
+	bool CMashTriColliderKDTree::GetIntersectingTriangles(const MashAABB &bounds, 
+			const MashTransformState &transform, 
+			MashArray<sIntersectingTriangleResult> &out)const
+	{
+		MashAABB localBounds(bounds);
+		localBounds.TransformInverse(transform);
+
+		MashInlineArray<uint32, 256> candidates;
+		return CollectIntersectingTriangles(localBounds, candidates, out);
+	}
+
+	void CMashTriColliderKDTree::PrepareRayBatch(const mash::MashRay *rays, 
+			uint32 rayCount, 
+			const MashTransformState &transform, 
+			MashArray<mash::MashRay> &localRaysOut, 
+			MashArray<uint32> &orderOut)const
+	{
+		localRaysOut.Resize(rayCount);
+		orderOut.Resize(rayCount);
+
+		const MashVector3 boundsExtents = m_bounds.max - m_bounds.min;
+		MashVector3 quantizeScale;
+		for(uint32 axis = 0; axis < 3; ++axis)
+			quantizeScale.v[axis] = (boundsExtents.v[axis] > 0.0f) ? (511.0f / boundsExtents.v[axis]) : 0.0f;
 
 		/*
-			This is needed to scale the distance back into world space.
-			At the moment it may be scaled by the local scale, which would
-			be wrong.
+			Rays are sorted by direction octant then by the morton code of
+			their origin within the tree bounds.
 		*/
-		const uint32 trisFound = out.Size();
-		for(uint32 i = 0; i < trisFound; ++i)
+		MashArray<uint64> sortKeys(rayCount);
+		for(uint32 i = 0; i < rayCount; ++i)
+		{
+			localRaysOut[i] = rays[i];
+			localRaysOut[i].TransformInverse(transform);
+
+			const MashRay &localRay = localRaysOut[i];
+			uint32 key = 0;
+			for(uint32 axis = 0; axis < 3; ++axis)
+			{
+				if (localRay.dir.v[axis] < 0.0f)
+					key |= 1 << (27 + axis);
+
+				const f32 scaled = (localRay.origin.v[axis] - m_bounds.min.v[axis]) * quantizeScale.v[axis];
+				const uint32 cell = (uint32)math::Clamp<f32>(0.0f, 511.0f, scaled);
+				for(uint32 bit = 0; bit < 9; ++bit)
+					key |= ((cell >> bit) & 1) << ((bit * 3) + axis);
+			}
+
+			sortKeys[i] = ((uint64)key << 32) | i;
+		}
+
+		std::sort(sortKeys.Pointer(), sortKeys.Pointer() + rayCount);
+
+		for(uint32 i = 0; i < rayCount; ++i)
+			orderOut[i] = (uint32)(sortKeys[i] & 0xffffffff);
+	}
+
+	uint32 CMashTriColliderKDTree::CheckCollisions(const mash::MashRay *rays,
+			uint32 rayCount,
+			const MashTransformState &transform,
+			bool *out)const
+	{
+		MashArray<mash::MashRay> localRays;
+		MashArray<uint32> order;
+		PrepareRayBatch(rays, rayCount, transform, localRays, order);
+
+		const uint32 jobCount = GetBatchJobCount(rayCount);
+		if (jobCount == 1)
+		{
+			uint32 hitCount = 0;
+			_CheckCollisions(localRays.Pointer(), order.Pointer(), 0, rayCount, out, hitCount);
+			return hitCount;
+		}
+
+		CRayBatchJob rayJobs[g_kdTreeMaxBatchJobs];
+		MashJob *jobList[g_kdTreeMaxBatchJobs];
+		const uint32 raysPerJob = (rayCount + jobCount - 1) / jobCount;
+		for(uint32 i = 0; i < jobCount; ++i)
+		{
+			rayJobs[i].collider = this;
+			rayJobs[i].localRays = localRays.Pointer();
+			rayJobs[i].order = order.Pointer();
+			rayJobs[i].first = math::Min<uint32>(i * raysPerJob, rayCount);
+			rayJobs[i].last = math::Min<uint32>(rayJobs[i].first + raysPerJob, rayCount);
+			rayJobs[i].hitsOut = out;
+			jobList[i] = &rayJobs[i];
+		}
+
+		jobs::RunJobs(jobList, jobCount);
+
+		uint32 hitCount = 0;
+		for(uint32 i = 0; i < jobCount; ++i)
+			hitCount += rayJobs[i].count;
+
+		return hitCount;
+	}
+
+	void CMashTriColliderKDTree::_CheckCollisions(const mash::MashRay *localRays, 
+			const uint32 *order, 
+			uint32 first, 
+			uint32 last, 
+			bool *out, 
+			uint32 &hitCountOut)const
+	{
+		hitCountOut = 0;
+		for(uint32 i = first; i < last; ++i)
+		{
+			const uint32 rayIndex = order[i];
+
+			sTriPickResult result;
+			result.distance = mash::math::MaxFloat();
+			result.collision = false;
+
+			out[rayIndex] = GetClosestTriangle(localRays[rayIndex], true, result);
+			if (out[rayIndex])
+				++hitCountOut;
+		}
+	}
+
+	uint32 CMashTriColliderKDTree::GetClosestTriangles(const mash::MashRay *rays,
+			uint32 rayCount,
+			const MashTransformState &transform,
+			sTriPickResult *out)const
+	{
+		MashArray<mash::MashRay> localRays;
+		MashArray<uint32> order;
+		PrepareRayBatch(rays, rayCount, transform, localRays, order);
+
+		const uint32 jobCount = GetBatchJobCount(rayCount);
+		if (jobCount == 1)
+		{
+			uint32 resultCount = 0;
+			_GetClosestTriangles(rays, localRays.Pointer(), order.Pointer(), 0, rayCount, transform, out, resultCount);
+			return resultCount;
+		}
+
+		CRayBatchJob rayJobs[g_kdTreeMaxBatchJobs];
+		MashJob *jobList[g_kdTreeMaxBatchJobs];
+		const uint32 raysPerJob = (rayCount + jobCount - 1) / jobCount;
+		for(uint32 i = 0; i < jobCount; ++i)
+		{
+			rayJobs[i].collider = this;
+			rayJobs[i].rays = rays;
+			rayJobs[i].localRays = localRays.Pointer();
+			rayJobs[i].order = order.Pointer();
+			rayJobs[i].first = math::Min<uint32>(i * raysPerJob, rayCount);
+			rayJobs[i].last = math::Min<uint32>(rayJobs[i].first + raysPerJob, rayCount);
+			rayJobs[i].transform = &transform;
+			rayJobs[i].resultsOut = out;
+			jobList[i] = &rayJobs[i];
+		}
+
+		jobs::RunJobs(jobList, jobCount);
+
+		uint32 resultCount = 0;
+		for(uint32 i = 0; i < jobCount; ++i)
+			resultCount += rayJobs[i].count;
+
+		return resultCount;
+	}
+
+	void CMashTriColliderKDTree::_GetClosestTriangles(const mash::MashRay *rays, 
+			const mash::MashRay *localRays, 
+			const uint32 *order, 
+			uint32 first, 
+			uint32 last, 
+			const MashTransformState &transform, 
+			sTriPickResult *out, 
+			uint32 &resultCountOut)const
+	{
+		resultCountOut = 0;
+		for(uint32 i = first; i < last; ++i)
 		{
-			const MashTriangleBuffer *triangleBuffer = m_triangleBuffers[out[i].bufferIndex];
+			const uint32 rayIndex = order[i];
 
-			mash::MashVector3 intersectionPoint((triangleBuffer->GetPoint(out[i].triangleIndex, 0) * 
-					out[i].u) +
-					(triangleBuffer->GetPoint(out[i].triangleIndex, 1) * 
-					out[i].v) +
-					(triangleBuffer->GetPoint(out[i].triangleIndex, 2) * 
-					out[i].w));
+			sTriPickResult result;
+			result.distance = mash::math::MaxFloat();
+			result.collision = false;
 
-			//transform into world space
-			intersectionPoint = transform.Transform(intersectionPoint);
-			//get actual distance
-			out[i].distance = (ray.origin - intersectionPoint).Length();
+			if (GetClosestTriangle(localRays[rayIndex], false, result))
+			{
+				ToWorldDistance(rays[rayIndex], transform, result);
+				if (result.distance < out[rayIndex].distance)
+				{
+					out[rayIndex] = result;
+					++resultCountOut;
+				}
+			}
 		}
+	}
+
+	uint32 CMashTriColliderKDTree::GetIntersectingTriangles(const MashAABB *bounds,
+			uint32 boundsCount,
+			const MashTransformState &transform, 
+			MashArray<sIntersectingTriangleResult> &out,
+			uint32 *resultStartOut)const
+	{
+		const uint32 firstResult = out.Size();
+		const uint32 jobCount = GetBatchJobCount(boundsCount);
+
+		/*
+			The first job writes straight into out. The other jobs fill their own
+			lists which are appended in order once all jobs are done.
+		*/
+		CBoundsBatchJob boundsJobs[g_kdTreeMaxBatchJobs];
+		MashJob *jobList[g_kdTreeMaxBatchJobs];
+		MashArray<sIntersectingTriangleResult> jobResults[g_kdTreeMaxBatchJobs - 1];
+		const uint32 boundsPerJob = (boundsCount + jobCount - 1) / jobCount;
+		for(uint32 i = 0; i < jobCount; ++i)
+		{
+			boundsJobs[i].collider = this;
+			boundsJobs[i].bounds = bounds;
+			boundsJobs[i].first = math::Min<uint32>(i * boundsPerJob, boundsCount);
+			boundsJobs[i].last = math::Min<uint32>(boundsJobs[i].first + boundsPerJob, boundsCount);
+			boundsJobs[i].transform = &transform;
+			boundsJobs[i].resultsOut = (i == 0) ? &out : &jobResults[i - 1];
+			boundsJobs[i].resultStartOut = resultStartOut;
+			jobList[i] = &boundsJobs[i];
+		}
+
+		if (jobCount == 1)
+		{
+			boundsJobs[0].Run();
+		}
+		else
+		{
+			jobs::RunJobs(jobList, jobCount);
+
+			for(uint32 i = 1; i < jobCount; ++i)
+			{
+				const uint32 resultOffset = out.Size();
+				for(uint32 b = boundsJobs[i].first; b < boundsJobs[i].last; ++b)
+					resultStartOut[b] += resultOffset;
+
+				if (!jobResults[i - 1].Empty())
+					out.Append(jobResults[i - 1].Pointer(), jobResults[i - 1].Size());
+			}
+		}
+
+		resultStartOut[boundsCount] = out.Size();
 
-		return trisFound;
+		return out.Size() - firstResult;
 	}
-}
\ No newline at end of file
+}
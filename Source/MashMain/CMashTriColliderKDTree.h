@@ -8,7 +8,6 @@
 
 #include "MashTriangleCollider.h"
 #include "MashAABB.h"
-#include <vector>
 
 namespace mash
 {
@@ -27,82 +26,134 @@ namespace mash
 			}
 		};
 
-		struct sCollectIntersectionData
+		/*
+			Nodes are stored depth first in a single array. The left child of an interior
+			node always directly follows its parent so only the right child index is stored.
+			This keeps each node at 8 bytes so a cache line holds 8 nodes.
+		*/
+		struct sNode
 		{
-			MashAABB aabb;
-			MashVector3 aabbCenter;
-		};
-
-		class KDNode
-		{
-		public:
-			uint32 axis;
-			f32 splitPosition;
-			KDNode *child[2];
+			/*
+				Interior nodes store the split position. Leaf nodes store the
+				first triangle within m_leafTriangles.
+			*/
+			union
+			{
+				f32 splitPosition;
+				uint32 firstTriangle;
+			};
 
-			uint32 *triangleIndexList;
-			uint32 triangleCount;
+			/*
+				Lower 2 bits store the split axis or aLEAF_NODE. The upper 30 bits store
+				the right child index for interior nodes or the triangle count for leaf nodes.
+			*/
+			uint32 flags;
 
-			KDNode():axis(0), triangleIndexList(0), splitPosition(0.0f), triangleCount(0)
-			{
-				child[0] = 0;
-				child[1] = 0;
-			}
-			~KDNode()
+			enum
 			{
-				if (child[0])
-				{
-					MASH_DELETE_T(KDNode, child[0]);
-					child[0] = 0;
-				}
-
-				if (child[1])
-				{
-					MASH_DELETE_T(KDNode, child[1]);
-					child[1] = 0;
-				}
-
-				if (triangleIndexList)
-				{
-					MASH_FREE(triangleIndexList);
-					triangleIndexList = 0;
-				}
-			}
+				aLEAF_NODE = 3
+			};
+
+			bool IsLeaf()const{return (flags & 3) == aLEAF_NODE;}
+			uint32 GetAxis()const{return flags & 3;}
+			uint32 GetRightChild()const{return flags >> 2;}
+			uint32 GetTriangleCount()const{return flags >> 2;}
 		};
 
-		MashArray<MashTriangleBuffer*> m_triangleBuffers;
-		KDNode *m_root;
+		//used during traversal
+		struct sTraversalData
+		{
+			uint32 node;
+			f32 tMin;
+			f32 tMax;
+		};
 
-		//TODO : Dynamic bitset
-		mutable std::vector<int8> m_intersectionCheckCache;
+		MashArray<MashTriangleBuffer*> m_triangleBuffers;
+		MashArray<sNode> m_nodes;
+		//indices into m_triangleDataPool referenced by the leaf nodes
+		MashArray<uint32> m_leafTriangles;
+		MashAABB m_bounds;
 
 		//this list must never change memory position after init.
 		MashArray<sTriangleData> m_triangleDataPool;
 
-		//parentBounds used to determine splitting plane
-		void SplitNode(KDNode *parent, const MashArray<uint32> &triangleList, MashAABB &parentBounds, /*uint32 maxDepth, */uint32 desiredTriangledPerNode, uint32 &currentDepth, uint32 axisTriCount[3]);
-		void CreateTree(uint32 maxDepth, uint32 desiredTriangledPerNode);
-		bool GetClosestTriangle(KDNode *node, const mash::MashRay &ray, bool quitOnFirstCollision, sTriPickResult &out)const;
-		bool GetIntersectingTriangles(KDNode *node, const mash::MashRay &ray, MashArray<sTriPickResult> &out)const;
-
-		void _GetIntersectingTriangles(KDNode *node, 
-			const sCollectIntersectionData &bodyData,
-			MashVector3 &volNearPt,
-			bool &collisionFound,
-			MashArray<sIntersectingTriangleResult> &out)const;
-
-		bool GetIntersectingTriangles(const MashAABB &bounds, 
+		/*
+			Copy of the leaf triangle points so rays can be tested against 4 triangles
+			at once. Each leaf stores blocks of 36 floats in the layout used by
+			simd::RayTriangle4(). Unused lanes are zero. m_leafPointOffsets holds the
+			first float for each leaf node and is indexed by node.
+		*/
+		MashArray<f32> m_leafTrianglePoints;
+		MashArray<uint32> m_leafPointOffsets;
+
+		class CRayBatchJob;
+		class CBoundsBatchJob;
+
+		/*
+			Node triangles are stored in workingTriangles between first and
+			first + count. Child lists are appended to the end of the array
+			and removed once the child has been built.
+		*/
+		void BuildNode(const MashArray<MashAABB> &triangleBounds, 
+			MashArray<uint32> &workingTriangles, 
+			uint32 first, 
+			uint32 count, 
+			const MashAABB &nodeBounds, 
+			uint32 depth, 
+			uint32 maxDepth,
+			uint32 minTrianglesPerLeaf);
+
+		void CreateLeaf(const MashArray<uint32> &workingTriangles, uint32 first, uint32 count);
+		void CalculateBounds();
+		void CreateTree(uint32 maxDepth, uint32 minTrianglesPerLeaf);
+		//must be called after the nodes are built or loaded
+		void _BuildLeafTrianglePoints();
+		void _CheckCollisions(const mash::MashRay *localRays, const uint32 *order, uint32 first, uint32 last, bool *out, uint32 &hitCountOut)const;
+		void _GetClosestTriangles(const mash::MashRay *rays, 
+			const mash::MashRay *localRays, 
+			const uint32 *order, 
+			uint32 first, 
+			uint32 last, 
+			const MashTransformState &transform, 
+			sTriPickResult *out, 
+			uint32 &resultCountOut)const;
+		/*
+			Transforms rays into local space and orders them so rays that start close
+			together and travel in the same direction are traversed one after another.
+		*/
+		void PrepareRayBatch(const mash::MashRay *rays, 
+			uint32 rayCount, 
 			const MashTransformState &transform, 
+			MashArray<mash::MashRay> &localRaysOut, 
+			MashArray<uint32> &orderOut)const;
+
+		void ToWorldDistance(const mash::MashRay &worldRay, const MashTransformState &transform, sTriPickResult &result)const;
+		bool ClipRayToBounds(const mash::MashRay &ray, f32 &tMinOut, f32 &tMaxOut)const;
+		bool GetClosestTriangle(const mash::MashRay &ray, bool quitOnFirstCollision, sTriPickResult &out)const;
+		bool GetIntersectingTriangles(const mash::MashRay &ray, MashArray<sTriPickResult> &out)const;
+
+		/*
+			candidatesScratch is owned by the caller so queries don't write any
+			shared state and a collider can be queried from many threads at once.
+		*/
+		bool CollectIntersectingTriangles(const MashAABB &localBounds, 
+			MashArray<uint32> &candidatesScratch, 
 			MashArray<sIntersectingTriangleResult> &out)const;
 
-		void _Serialize(KDNode *node, MashGenericArray &out)const;
-		void _Deserialize(KDNode *node, const uint8 *dataArray, uint32 &nextBytes);
+		//converts the recursive node layout used by older files
+		void _DeserializeLegacyNode(const uint8 *dataArray, uint32 &nextByte);
+		//returns 0xFFFFFFFF if the node layout is invalid
+		uint32 _GetTreeDepth()const;
 	public:
 		CMashTriColliderKDTree();
 		~CMashTriColliderKDTree();
 
 		void SetTriangleBuffers(MashTriangleBuffer **buffer, uint32 bufferCount);
 
+		bool GetIntersectingTriangles(const MashAABB &bounds, 
+			const MashTransformState &transform, 
+			MashArray<sIntersectingTriangleResult> &out)const;
+
 		bool CheckCollision(const mash::MashRay &ray, 
 			const MashTransformState &transform)const;
 
@@ -114,6 +165,22 @@ namespace mash
 			const MashTransformState &transform,
 			MashArray<sTriPickResult> &out)const;
 
+		uint32 CheckCollisions(const mash::MashRay *rays,
+			uint32 rayCount,
+			const MashTransformState &transform,
+			bool *out)const;
+
+		uint32 GetClosestTriangles(const mash::MashRay *rays,
+			uint32 rayCount,
+			const MashTransformState &transform,
+			sTriPickResult *out)const;
+
+		uint32 GetIntersectingTriangles(const MashAABB *bounds,
+			uint32 boundsCount,
+			const MashTransformState &transform, 
+			MashArray<sIntersectingTriangleResult> &out,
+			uint32 *resultStartOut)const;
+
 		const MashArray<MashTriangleBuffer*>& GetTriangleBufferCollection()const;
 		const MashTriangleBuffer* GetTriangleBuffer(uint32 index)const;
 		uint32 GetTriangleBufferCount()const;
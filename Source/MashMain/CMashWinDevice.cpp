@@ -4,6 +4,7 @@
 // For license and distribution see Mash.h
 //-------------------------------------------------------------------------
 #include "CMashWinDevice.h"
+#include "CMashNullDevice.h"
 #include "MashDataTypes.h"
 
 #ifdef MASH_WINDOWS
@@ -1176,6 +1177,9 @@ namespace mash
 		if (settings.enableDeferredRender)
 			settings.antiAliasType = aANTIALIAS_TYPE_NONE;
 
+		if (settings.headless)
+			return _CreateNullDevice(settings);
+
 		CMashWinDevice *device = MASH_NEW_COMMON CMashWinDevice(settings.debugFilePath);
 		if (device->Initialise(settings) == aMASH_FAILED)
 		{
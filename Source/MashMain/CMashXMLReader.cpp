@@ -7,19 +7,50 @@
 #include "MashFileManager.h"
 #include "MashFileStream.h"
 #include "MashLog.h"
+#include "MashTextParser.h"
+#include "MashMemory.h"
 
 namespace mash
 {
-	CMashXMLReader::CMashXMLReader(MashFileManager *fileManager):MashXMLReader(), m_fileManager(fileManager)
+	/*
+		Attaches extracted text to elements in document order. Returns the number
+		of matching elements found so the caller can check the tree lines up with
+		the text.
+	*/
+	static uint32 AssignElementText(TiXmlElement *element, const int8 *const *textElements, uint32 textElementCount,
+		const MashArray<const int8*> &elementText, uint32 index)
 	{
+		for(; element; element = element->NextSiblingElement())
+		{
+			for(uint32 i = 0; i < textElementCount; ++i)
+			{
+				if (strcmp(element->Value(), textElements[i]) == 0)
+				{
+					if ((index < elementText.Size()) && elementText[index])
+						element->SetUserData((void*)elementText[index]);
+
+					++index;
+					break;
+				}
+			}
+
+			index = AssignElementText(element->FirstChildElement(), textElements, textElementCount, elementText, index);
+		}
 
+		return index;
 	}
 
-	CMashXMLReader::~CMashXMLReader()
+	CMashXMLReader::CMashXMLReader(MashFileManager *fileManager):MashXMLReader(), m_fileManager(fileManager), m_elementText(0)
 	{
 
 	}
 
+	CMashXMLReader::~CMashXMLReader()
+	{
+		if (m_elementText)
+			MASH_FREE(m_elementText);
+	}
+
 	bool CMashXMLReader::LoadFile(const int8 *sFileName)
 	{
 		MashFileStream *fileStream = m_fileManager->CreateFileStream();
@@ -33,10 +64,46 @@ namespace mash
 			return aMASH_FAILED;
 		}
 
-		m_document.Parse((const int8*)fileStream->GetData());
+		const bool result = LoadText((const int8*)fileStream->GetData());
 
 		fileStream->Destroy();
 
+		return result;
+	}
+
+	bool CMashXMLReader::LoadText(const int8 *xmlText, const int8 *const *textElements, uint32 textElementCount)
+	{
+		if (textElements && (textElementCount > 0))
+		{
+			const uint32 textLength = strlen(xmlText);
+			if (m_elementText)
+				MASH_FREE(m_elementText);
+
+			m_elementText = (int8*)MASH_ALLOC_COMMON(textLength + 1);
+			memcpy(m_elementText, xmlText, textLength + 1);
+
+			int8 *document = (int8*)MASH_ALLOC_COMMON(textLength + 1);
+			MashArray<const int8*> elementText;
+			text::ExtractElementText(m_elementText, textElements, textElementCount, document, elementText);
+
+			m_document.Parse(document);
+			MASH_FREE(document);
+
+			//if the tree doesn't match the scan, for example due to a parse error, then load normally
+			if (AssignElementText(m_document.FirstChildElement(), textElements, textElementCount, elementText, 0) != elementText.Size())
+			{
+				m_document.Clear();
+				MASH_FREE(m_elementText);
+				m_elementText = 0;
+
+				m_document.Parse(xmlText);
+			}
+		}
+		else
+		{
+			m_document.Parse(xmlText);
+		}
+
 		TiXmlHandle documentHandle(&m_document);
 
 		TiXmlElement *pElement = documentHandle.FirstChildElement().ToElement();
@@ -148,6 +215,11 @@ namespace mash
 
 	const int8* CMashXMLReader::GetTextRaw()const
 	{
+		//text kept out of the tree by LoadText()
+		const void *elementText = m_elementStack.top()->GetUserData();
+		if (elementText)
+			return (const int8*)elementText;
+
 		return m_elementStack.top()->GetText();
 	}
 
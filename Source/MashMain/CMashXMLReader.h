@@ -20,11 +20,23 @@ namespace mash
 		TiXmlDocument m_document;
 		MashFileManager *m_fileManager;
 		std::stack<TiXmlElement*> m_elementStack;
+		//text moved out of the document by LoadText()
+		int8 *m_elementText;
 	public:
 		CMashXMLReader(MashFileManager *fileManager);
 		~CMashXMLReader();
 
 		bool LoadFile(const int8 *sFileName);
+		/*
+			Parses text already in memory. Doesn't use the file manager so
+			this can be called from a worker thread.
+
+			The text of elements named in textElements is kept out of the
+			document tree, see text::ExtractElementText(). GetTextRaw() still
+			returns it but it isn't whitespace condensed and won't be written
+			by GetFileAsString(). Use this for large number arrays.
+		*/
+		bool LoadText(const int8 *xmlText, const int8 *const *textElements = 0, uint32 textElementCount = 0);
 		void Destroy();
 		void GetFileAsString(MashStringc &out);
 
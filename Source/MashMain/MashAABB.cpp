@@ -240,56 +240,65 @@ namespace mash
 		Repair();
 	}
 
-	MashAABB& MashAABB::Transform(const MashTransformState &state)
+	/*
+		Upper 3x3 of MashMatrix4(orientation), without building the rest of the matrix.
+	*/
+	static void QuaternionToRotation(const MashQuaternion &q, f32 *r)
 	{
-		return Transform(state.ToMatrix());
-	}
+		r[0] = 1.0f - 2.0f*q.y*q.y - 2.0f*q.z*q.z;
+		r[1] = 2.0f*q.x*q.y + 2.0f*q.z*q.w;
+		r[2] = 2.0f*q.x*q.z - 2.0f*q.y*q.w;
 
-	MashAABB& MashAABB::TransformInverse(const MashTransformState &state)
-	{
-		return Transform(state.ToMatrix().Invert());
+		r[3] = 2.0f*q.x*q.y - 2.0f*q.z*q.w;
+		r[4] = 1.0f - 2.0f*q.x*q.x - 2.0f*q.z*q.z;
+		r[5] = 2.0f*q.z*q.y + 2.0f*q.x*q.w;
+
+		r[6] = 2.0f*q.x*q.z + 2.0f*q.y*q.w;
+		r[7] = 2.0f*q.z*q.y - 2.0f*q.x*q.w;
+		r[8] = 1.0f - 2.0f*q.x*q.x - 2.0f*q.y*q.y;
 	}
 
-	MashAABB& MashAABB::Transform(const MashMatrix4 &matrix)
+	MashAABB& MashAABB::Transform(const MashTransformState &state)
 	{
-		const f32 Amin[3] = {min.x, min.y, min.z};
-		const f32 Amax[3] = {max.x, max.y, max.z};
+		f32 r[9];
+		QuaternionToRotation(state.orientation, r);
 
-		f32 Bmin[3];
-		f32 Bmax[3];
+		//same layout as MashTransformState::ToMatrix()
+		const f32 m[16] = {
+			r[0] * state.scale.x, r[1] * state.scale.y, r[2] * state.scale.z, 0.0f,
+			r[3] * state.scale.x, r[4] * state.scale.y, r[5] * state.scale.z, 0.0f,
+			r[6] * state.scale.x, r[7] * state.scale.y, r[8] * state.scale.z, 0.0f,
+			state.translation.x, state.translation.y, state.translation.z, 1.0f};
 
-		Bmin[0] = Bmax[0] = matrix.m41;
-		Bmin[1] = Bmax[1] = matrix.m42;
-		Bmin[2] = Bmax[2] = matrix.m43;
+		simd::AABBTransform(m, min.v, max.v, min.v, max.v);
+		return *this;
+	}
+
+	MashAABB& MashAABB::TransformInverse(const MashTransformState &state)
+	{
+		f32 r[9];
+		QuaternionToRotation(state.orientation, r);
 
-		for (int32 i = 0; i < 3; ++i)
+		/*
+			The inverse of rotate, scale, translate is the inverse scale followed by the
+			transposed rotation, so no general matrix inverse is needed.
+		*/
+		const f32 invScale[3] = {1.0f / state.scale.x, 1.0f / state.scale.y, 1.0f / state.scale.z};
+		f32 m[16];
+		for(uint32 i = 0; i < 3; ++i)
 		{
-			for (int32 j = 0; j < 3; ++j)
-			{
-				const f32 a = matrix.m[j][i] * Amin[j];
-				const f32 b = matrix.m[j][i] * Amax[j];
-
-				if (a < b)
-				{
-					Bmin[i] += a;
-					Bmax[i] += b;
-				}
-				else
-				{
-					Bmin[i] += b;
-					Bmax[i] += a;
-				}
-			}
+			m[i * 4] = r[i] * invScale[i];
+			m[i * 4 + 1] = r[3 + i] * invScale[i];
+			m[i * 4 + 2] = r[6 + i] * invScale[i];
+			m[i * 4 + 3] = 0.0f;
 		}
 
-		min.x = Bmin[0];
-		min.y = Bmin[1];
-		min.z = Bmin[2];
+		for(uint32 j = 0; j < 3; ++j)
+			m[12 + j] = -(state.translation.x * m[j] + state.translation.y * m[4 + j] + state.translation.z * m[8 + j]);
 
-		max.x = Bmax[0];
-		max.y = Bmax[1];
-		max.z = Bmax[2];
+		m[15] = 1.0f;
 
+		simd::AABBTransform(m, min.v, max.v, min.v, max.v);
 		return *this;
 	}
 
@@ -13,6 +13,9 @@
 #include "MashTexture.h"
 #include "MashTechniqueInstance.h"
 #include "MashEffect.h"
+#include "MashSkinPaletteBuffer.h"
+#include "MashLightClusterGrid.h"
+#include <math.h>
 
 namespace mash
 {
@@ -402,10 +405,105 @@ namespace mash
 			MashEffectParamHandle *pParameter,
 			uint32 iIndex)
 	{
+		/*
+			Skins in a palette buffer are read from autoBonePaletteTexture. Their palettes
+			have already been uploaded once for the frame so nothing is sent per draw.
+		*/
+		if (pRenderInfo->GetSkinPaletteBuffer())
+			return;
+
 		if (pRenderInfo->GetBonePalette())
 			pEffect->SetMatrix(pParameter, pRenderInfo->GetBonePalette(), pRenderInfo->GetCurrentBoneCount());
 	}
 
+	void MashParamBonePaletteTexture::OnSet(const MashRenderInfo *pRenderInfo, 
+			MashEffect *pEffect, 
+			MashEffectParamHandle *pParameter,
+			uint32 iIndex)
+	{
+		const MashSkinPaletteBuffer *paletteBuffer = pRenderInfo->GetSkinPaletteBuffer();
+		if (!paletteBuffer)
+			return;
+
+		const MashTextureState *textureState = 0;
+		MashTexture *texture = paletteBuffer->GetTexture(&textureState);
+		if (!texture)
+			return;
+
+		pEffect->SetTexture(pParameter, texture, textureState);
+	}
+
+	void MashParamBonePaletteInfo::OnSet(const MashRenderInfo *pRenderInfo, 
+			MashEffect *pEffect, 
+			MashEffectParamHandle *pParameter,
+			uint32 iIndex)
+	{
+		const MashSkinPaletteBuffer *paletteBuffer = pRenderInfo->GetSkinPaletteBuffer();
+		if (!paletteBuffer)
+			return;
+
+		MashTexture *texture = paletteBuffer->GetTexture();
+		if (!texture)
+			return;
+
+		uint32 width, height;
+		texture->GetSize(width, height);
+
+		MashVector4 info;
+		info.v[0] = (f32)pRenderInfo->GetBonePaletteOffset();
+		info.v[1] = (f32)paletteBuffer->GetMatricesPerRow();
+		info.v[2] = 1.0f / (f32)width;
+		info.v[3] = 1.0f / (f32)height;
+
+		pEffect->SetVector4(pParameter, &info);
+	}
+
+	void MashParamLightClusterTexture::OnSet(const MashRenderInfo *pRenderInfo, 
+			MashEffect *pEffect, 
+			MashEffectParamHandle *pParameter,
+			uint32 iIndex)
+	{
+		const MashTextureState *textureState = 0;
+		MashTexture *texture = pRenderInfo->GetLightClusterTexture(&textureState);
+		if (!texture)
+			return;
+
+		pEffect->SetTexture(pParameter, texture, textureState);
+	}
+
+	void MashParamLightClusterInfo::OnSet(const MashRenderInfo *pRenderInfo, 
+			MashEffect *pEffect, 
+			MashEffectParamHandle *pParameter,
+			uint32 iIndex)
+	{
+		if (!pRenderInfo->GetLightClusterGrid())
+			return;
+
+		pEffect->SetVector4(pParameter, &pRenderInfo->GetLightClusterLayout());
+	}
+
+	void MashParamLightClusterGrid::OnSet(const MashRenderInfo *pRenderInfo, 
+			MashEffect *pEffect, 
+			MashEffectParamHandle *pParameter,
+			uint32 iIndex)
+	{
+		const MashLightClusterGrid *grid = pRenderInfo->GetLightClusterGrid();
+		if (!grid)
+			return;
+
+		/*
+			The slice of a view depth z is floor(log(z / near) * w).
+			Near and far can be taken from autoCameraNearFar.
+		*/
+		MashVector4 gridInfo;
+		gridInfo.v[0] = (f32)grid->GetTilesX();
+		gridInfo.v[1] = (f32)grid->GetTilesY();
+		gridInfo.v[2] = (f32)grid->GetSlices();
+		gridInfo.v[3] = (f32)grid->GetSlices() / logf(grid->GetFar() / grid->GetNear());
+
+		pEffect->SetVector4(pParameter, &gridInfo);
+	}
+
 	void MashParamLightWorldPosition::OnSet(const MashRenderInfo *pRenderInfo, 
 			MashEffect *pEffect, 
 			MashEffectParamHandle *pParameter,
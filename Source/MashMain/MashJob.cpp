@@ -0,0 +1,325 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#include "MashJob.h"
+#include "MashMemory.h"
+#include <cstring>
+
+#ifdef MASH_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+namespace mash
+{
+	/*
+		Worker threads are created the first time they are needed and then
+		wait for more work, so RunJobs() can be called every frame without
+		the cost of starting threads.
+
+		Only one call to RunJobs() uses the workers at a time. Any other call
+		made while they are busy, such as from within a job, runs its jobs on
+		the calling thread.
+	*/
+	class CMashJobPool
+	{
+	private:
+#ifdef MASH_WINDOWS
+		CRITICAL_SECTION m_lock;
+		CONDITION_VARIABLE m_workReady;
+		CONDITION_VARIABLE m_workDone;
+		HANDLE *m_threads;
+#else
+		pthread_mutex_t m_lock;
+		pthread_cond_t m_workReady;
+		pthread_cond_t m_workDone;
+		pthread_t *m_threads;
+#endif
+		uint32 m_threadCount;
+		uint32 m_threadCapacity;
+
+		//current batch, guarded by m_lock
+		MashJob **m_jobs;
+		uint32 m_jobCount;
+		uint32 m_nextJob;
+		uint32 m_completedJobs;
+		uint32 m_batchId;
+		uint32 m_workerLimit;
+		uint32 m_joinedWorkers;
+		bool m_busy;
+		bool m_shutdown;
+
+		void _Lock()
+		{
+#ifdef MASH_WINDOWS
+			EnterCriticalSection(&m_lock);
+#else
+			pthread_mutex_lock(&m_lock);
+#endif
+		}
+
+		void _Unlock()
+		{
+#ifdef MASH_WINDOWS
+			LeaveCriticalSection(&m_lock);
+#else
+			pthread_mutex_unlock(&m_lock);
+#endif
+		}
+
+		//must be called with the lock held
+		void _RunBatchJobs()
+		{
+			while(m_nextJob < m_jobCount)
+			{
+				MashJob *job = m_jobs[m_nextJob++];
+				_Unlock();
+				job->Run();
+				_Lock();
+
+				if (++m_completedJobs == m_jobCount)
+				{
+#ifdef MASH_WINDOWS
+					WakeAllConditionVariable(&m_workDone);
+#else
+					pthread_cond_broadcast(&m_workDone);
+#endif
+				}
+			}
+		}
+
+		//must be called with the lock held
+		void _StartThreads(uint32 count)
+		{
+			if (count > m_threadCapacity)
+			{
+#ifdef MASH_WINDOWS
+				HANDLE *threads = (HANDLE*)MASH_ALLOC_COMMON(sizeof(HANDLE) * count);
+				if (m_threads)
+				{
+					memcpy(threads, m_threads, sizeof(HANDLE) * m_threadCount);
+					MASH_FREE(m_threads);
+				}
+#else
+				pthread_t *threads = (pthread_t*)MASH_ALLOC_COMMON(sizeof(pthread_t) * count);
+				if (m_threads)
+				{
+					memcpy(threads, m_threads, sizeof(pthread_t) * m_threadCount);
+					MASH_FREE(m_threads);
+				}
+#endif
+				m_threads = threads;
+				m_threadCapacity = count;
+			}
+
+			//if a thread fails to start then its share of the work is picked up by the others
+			for(uint32 i = m_threadCount; i < count; ++i)
+			{
+#ifdef MASH_WINDOWS
+				m_threads[m_threadCount] = CreateThread(0, 0, ThreadMain, this, 0, 0);
+				if (!m_threads[m_threadCount])
+					break;
+#else
+				if (pthread_create(&m_threads[m_threadCount], 0, ThreadMain, this) != 0)
+					break;
+#endif
+				++m_threadCount;
+			}
+		}
+
+		void _WorkerMain()
+		{
+			uint32 lastBatchId = 0;
+			_Lock();
+			while(true)
+			{
+				while(!m_shutdown && ((m_batchId == lastBatchId) || (m_nextJob >= m_jobCount) || (m_joinedWorkers >= m_workerLimit)))
+				{
+#ifdef MASH_WINDOWS
+					SleepConditionVariableCS(&m_workReady, &m_lock, INFINITE);
+#else
+					pthread_cond_wait(&m_workReady, &m_lock);
+#endif
+				}
+
+				if (m_shutdown)
+					break;
+
+				lastBatchId = m_batchId;
+				++m_joinedWorkers;
+				_RunBatchJobs();
+			}
+			_Unlock();
+		}
+
+#ifdef MASH_WINDOWS
+		static DWORD WINAPI ThreadMain(LPVOID data)
+		{
+			((CMashJobPool*)data)->_WorkerMain();
+			return 0;
+		}
+#else
+		static void* ThreadMain(void *data)
+		{
+			((CMashJobPool*)data)->_WorkerMain();
+			return 0;
+		}
+#endif
+	public:
+		CMashJobPool():m_threads(0), m_threadCount(0), m_threadCapacity(0), m_jobs(0), m_jobCount(0), m_nextJob(0),
+			m_completedJobs(0), m_batchId(0), m_workerLimit(0), m_joinedWorkers(0), m_busy(false), m_shutdown(false)
+		{
+#ifdef MASH_WINDOWS
+			InitializeCriticalSection(&m_lock);
+			InitializeConditionVariable(&m_workReady);
+			InitializeConditionVariable(&m_workDone);
+#else
+			pthread_mutex_init(&m_lock, 0);
+			pthread_cond_init(&m_workReady, 0);
+			pthread_cond_init(&m_workDone, 0);
+#endif
+		}
+
+		/*
+			Threads are not joined here as this runs during static destruction,
+			where waiting on threads isn't safe on all platforms. Call
+			ReleaseThreads() beforehand.
+		*/
+		~CMashJobPool()
+		{
+			if (m_threadCount > 0)
+				return;
+
+#ifdef MASH_WINDOWS
+			DeleteCriticalSection(&m_lock);
+#else
+			pthread_cond_destroy(&m_workDone);
+			pthread_cond_destroy(&m_workReady);
+			pthread_mutex_destroy(&m_lock);
+#endif
+		}
+
+		void Run(MashJob **jobs, uint32 jobCount, uint32 workerCount)
+		{
+			_Lock();
+			if (m_busy || (workerCount == 0))
+			{
+				_Unlock();
+
+				for(uint32 i = 0; i < jobCount; ++i)
+					jobs[i]->Run();
+
+				return;
+			}
+
+			m_busy = true;
+			if (m_threadCount < workerCount)
+				_StartThreads(workerCount);
+
+			m_jobs = jobs;
+			m_jobCount = jobCount;
+			m_nextJob = 0;
+			m_completedJobs = 0;
+			m_workerLimit = workerCount;
+			m_joinedWorkers = 0;
+			//0 is never used so new workers don't mistake the first batch for one they have run
+			if (++m_batchId == 0)
+				m_batchId = 1;
+
+#ifdef MASH_WINDOWS
+			WakeAllConditionVariable(&m_workReady);
+#else
+			pthread_cond_broadcast(&m_workReady);
+#endif
+
+			//the calling thread also runs jobs
+			_RunBatchJobs();
+
+			while(m_completedJobs < m_jobCount)
+			{
+#ifdef MASH_WINDOWS
+				SleepConditionVariableCS(&m_workDone, &m_lock, INFINITE);
+#else
+				pthread_cond_wait(&m_workDone, &m_lock);
+#endif
+			}
+
+			m_jobs = 0;
+			m_jobCount = 0;
+			m_nextJob = 0;
+			m_busy = false;
+			_Unlock();
+		}
+
+		void ReleaseThreads()
+		{
+			_Lock();
+			m_shutdown = true;
+#ifdef MASH_WINDOWS
+			WakeAllConditionVariable(&m_workReady);
+#else
+			pthread_cond_broadcast(&m_workReady);
+#endif
+			_Unlock();
+
+			for(uint32 i = 0; i < m_threadCount; ++i)
+			{
+#ifdef MASH_WINDOWS
+				WaitForSingleObject(m_threads[i], INFINITE);
+				CloseHandle(m_threads[i]);
+#else
+				pthread_join(m_threads[i], 0);
+#endif
+			}
+
+			if (m_threads)
+				MASH_FREE(m_threads);
+
+			_Lock();
+			m_threads = 0;
+			m_threadCount = 0;
+			m_threadCapacity = 0;
+			m_shutdown = false;
+			_Unlock();
+		}
+	};
+
+	static CMashJobPool g_jobPool;
+
+	namespace jobs
+	{
+		uint32 GetHardwareThreadCount()
+		{
+#ifdef MASH_WINDOWS
+			SYSTEM_INFO info;
+			GetSystemInfo(&info);
+			const int32 count = info.dwNumberOfProcessors;
+#else
+			const int32 count = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+			return (count > 0) ? count : 1;
+		}
+
+		void RunJobs(MashJob **jobs, uint32 jobCount, uint32 maxThreads)
+		{
+			if (!jobs || (jobCount == 0))
+				return;
+
+			if (maxThreads == 0)
+				maxThreads = GetHardwareThreadCount();
+
+			//the calling thread counts as one
+			const uint32 workerCount = ((jobCount < maxThreads) ? jobCount : maxThreads) - 1;
+			g_jobPool.Run(jobs, jobCount, workerCount);
+		}
+
+		void ReleaseWorkerThreads()
+		{
+			g_jobPool.ReleaseThreads();
+		}
+	}
+}
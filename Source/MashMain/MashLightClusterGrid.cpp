@@ -0,0 +1,474 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#include "MashLightClusterGrid.h"
+#include "MashLight.h"
+#include "MashAABB.h"
+#include "MashJob.h"
+#include "MashTypes.h"
+#include "MashMathHelper.h"
+#include <math.h>
+
+#ifdef MASH_SIMD_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace mash
+{
+	/*
+		Below this many lights it's quicker to bin on one thread than to
+		wake the workers.
+	*/
+	static const uint32 g_clusterMinLightsPerJob = 64;
+	static const uint32 g_clusterMaxJobs = 16;
+
+	class MashLightClusterGrid::CBinJob : public MashJob
+	{
+	public:
+		const MashLightClusterGrid *grid;
+		const sLightVolume *lights;
+		uint32 first;
+		uint32 last;
+		MashArray<sLightClusterPair> *pairs;
+
+		CBinJob():MashJob(), grid(0), lights(0), first(0), last(0), pairs(0){}
+
+		void Run()
+		{
+			grid->_BinLights(lights, first, last, *pairs);
+		}
+	};
+
+	MashLightClusterGrid::MashLightClusterGrid():m_tilesX(aDEFAULT_TILES_X), m_tilesY(aDEFAULT_TILES_Y), m_slices(aDEFAULT_SLICES),
+		m_fovY(0.7853981625f), m_aspect(1.0f), m_near(1.0f), m_far(1000.0f), m_tanHalfFovX(0.0f), m_tanHalfFovY(0.0f),
+		m_logFarOverNear(0.0f), m_boundsDirty(true), m_maxThreads(0)
+	{
+	}
+
+	MashLightClusterGrid::~MashLightClusterGrid()
+	{
+	}
+
+	void MashLightClusterGrid::SetGridSize(uint32 tilesX, uint32 tilesY, uint32 slices)
+	{
+		if (tilesX == 0) tilesX = 1;
+		if (tilesY == 0) tilesY = 1;
+		if (slices == 0) slices = 1;
+
+		if ((tilesX != m_tilesX) || (tilesY != m_tilesY) || (slices != m_slices))
+		{
+			m_tilesX = tilesX;
+			m_tilesY = tilesY;
+			m_slices = slices;
+			m_boundsDirty = true;
+		}
+	}
+
+	void MashLightClusterGrid::SetProjection(f32 fovY, f32 aspect, f32 zNear, f32 zFar)
+	{
+		if ((fovY != m_fovY) || (aspect != m_aspect) || (zNear != m_near) || (zFar != m_far))
+		{
+			m_fovY = fovY;
+			m_aspect = aspect;
+			m_near = zNear;
+			m_far = zFar;
+			m_boundsDirty = true;
+		}
+	}
+
+	void MashLightClusterGrid::SetMaxThreads(uint32 maxThreads)
+	{
+		m_maxThreads = maxThreads;
+	}
+
+	void MashLightClusterGrid::_RebuildBounds()
+	{
+		m_tanHalfFovY = tanf(m_fovY * 0.5f);
+		m_tanHalfFovX = m_tanHalfFovY * m_aspect;
+		m_logFarOverNear = logf(m_far / m_near);
+
+		m_sliceDepths.Resize(m_slices + 1);
+		for(uint32 z = 0; z <= m_slices; ++z)
+			m_sliceDepths[z] = m_near * expf(m_logFarOverNear * ((f32)z / (f32)m_slices));
+
+		//make sure the last slice ends exactly on the far plane
+		m_sliceDepths[m_slices] = m_far;
+
+		const uint32 clusterCount = GetClusterCount();
+		m_boundsMinX.Resize(clusterCount);
+		m_boundsMinY.Resize(clusterCount);
+		m_boundsMinZ.Resize(clusterCount);
+		m_boundsMaxX.Resize(clusterCount);
+		m_boundsMaxY.Resize(clusterCount);
+		m_boundsMaxZ.Resize(clusterCount);
+		m_clusters.Resize(clusterCount);
+
+		const f32 tileWidth = 2.0f / (f32)m_tilesX;
+		const f32 tileHeight = 2.0f / (f32)m_tilesY;
+		for(uint32 z = 0; z < m_slices; ++z)
+		{
+			const f32 nearDepth = m_sliceDepths[z];
+			const f32 farDepth = m_sliceDepths[z + 1];
+
+			for(uint32 y = 0; y < m_tilesY; ++y)
+			{
+				const f32 ndcY0 = -1.0f + (tileHeight * y);
+				const f32 ndcY1 = ndcY0 + tileHeight;
+
+				for(uint32 x = 0; x < m_tilesX; ++x)
+				{
+					const f32 ndcX0 = -1.0f + (tileWidth * x);
+					const f32 ndcX1 = ndcX0 + tileWidth;
+
+					//tile edges widen with depth so check both ends of the slice
+					const uint32 i = GetClusterIndex(x, y, z);
+					m_boundsMinX[i] = math::Min<f32>(ndcX0 * nearDepth, ndcX0 * farDepth) * m_tanHalfFovX;
+					m_boundsMaxX[i] = math::Max<f32>(ndcX1 * nearDepth, ndcX1 * farDepth) * m_tanHalfFovX;
+					m_boundsMinY[i] = math::Min<f32>(ndcY0 * nearDepth, ndcY0 * farDepth) * m_tanHalfFovY;
+					m_boundsMaxY[i] = math::Max<f32>(ndcY1 * nearDepth, ndcY1 * farDepth) * m_tanHalfFovY;
+					m_boundsMinZ[i] = nearDepth;
+					m_boundsMaxZ[i] = farDepth;
+				}
+			}
+		}
+
+		m_boundsDirty = false;
+	}
+
+	uint32 MashLightClusterGrid::_GetSlice(f32 viewDepth)const
+	{
+		if (viewDepth <= m_near)
+			return 0;
+
+		const int32 slice = (int32)(logf(viewDepth / m_near) / m_logFarOverNear * (f32)m_slices);
+		return (uint32)math::Clamp<int32>(0, (int32)m_slices - 1, slice);
+	}
+
+	void MashLightClusterGrid::_BinLight(const sLightVolume &light, uint32 lightIndex, MashArray<sLightClusterPair> &pairsOut)const
+	{
+		if (light.range <= 0.0f)
+			return;
+
+		//find a sphere that bounds the light
+		MashVector3 centre = light.position;
+		f32 radius = light.range;
+		const bool isSpot = (light.type == aLIGHT_SPOT);
+		f32 sinOuterCone = 0.0f;
+		if (isSpot)
+		{
+			sinOuterCone = sqrtf(math::Max<f32>(0.0f, 1.0f - (light.cosOuterCone * light.cosOuterCone)));
+
+			//narrow cones fit in a smaller sphere pushed along the direction
+			if (light.cosOuterCone >= 0.5f)
+			{
+				radius = light.range / (2.0f * light.cosOuterCone);
+				centre = light.position + (light.direction * radius);
+			}
+		}
+
+		const f32 minDepth = centre.z - radius;
+		const f32 maxDepth = centre.z + radius;
+		if ((maxDepth < m_near) || (minDepth > m_far))
+			return;
+
+		const f32 clampedMinDepth = math::Max<f32>(minDepth, m_near);
+		const f32 clampedMaxDepth = math::Min<f32>(maxDepth, m_far);
+
+		/*
+			Conservative screen extents. The smallest x/depth comes from the nearest
+			depth when x is negative and the farthest depth when x is positive.
+		*/
+		const f32 left = centre.x - radius;
+		const f32 right = centre.x + radius;
+		const f32 bottom = centre.y - radius;
+		const f32 top = centre.y + radius;
+		const f32 ndcLeft = left / (((left < 0.0f) ? clampedMinDepth : clampedMaxDepth) * m_tanHalfFovX);
+		const f32 ndcRight = right / (((right > 0.0f) ? clampedMinDepth : clampedMaxDepth) * m_tanHalfFovX);
+		const f32 ndcBottom = bottom / (((bottom < 0.0f) ? clampedMinDepth : clampedMaxDepth) * m_tanHalfFovY);
+		const f32 ndcTop = top / (((top > 0.0f) ? clampedMinDepth : clampedMaxDepth) * m_tanHalfFovY);
+
+		if ((ndcLeft > 1.0f) || (ndcRight < -1.0f) || (ndcBottom > 1.0f) || (ndcTop < -1.0f))
+			return;
+
+		const int32 tileX0 = math::Clamp<int32>(0, (int32)m_tilesX - 1, (int32)floorf((ndcLeft + 1.0f) * 0.5f * (f32)m_tilesX));
+		const int32 tileX1 = math::Clamp<int32>(0, (int32)m_tilesX - 1, (int32)floorf((ndcRight + 1.0f) * 0.5f * (f32)m_tilesX));
+		const int32 tileY0 = math::Clamp<int32>(0, (int32)m_tilesY - 1, (int32)floorf((ndcBottom + 1.0f) * 0.5f * (f32)m_tilesY));
+		const int32 tileY1 = math::Clamp<int32>(0, (int32)m_tilesY - 1, (int32)floorf((ndcTop + 1.0f) * 0.5f * (f32)m_tilesY));
+		const uint32 slice0 = _GetSlice(clampedMinDepth);
+		const uint32 slice1 = _GetSlice(clampedMaxDepth);
+
+		const f32 radiusSq = radius * radius;
+		const f32 *minX = m_boundsMinX.Pointer();
+		const f32 *minY = m_boundsMinY.Pointer();
+		const f32 *minZ = m_boundsMinZ.Pointer();
+		const f32 *maxX = m_boundsMaxX.Pointer();
+		const f32 *maxY = m_boundsMaxY.Pointer();
+		const f32 *maxZ = m_boundsMaxZ.Pointer();
+
+#ifdef MASH_SIMD_SSE
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 cx = _mm_set1_ps(centre.x);
+		const __m128 cy = _mm_set1_ps(centre.y);
+		const __m128 cz = _mm_set1_ps(centre.z);
+		const __m128 rSq = _mm_set1_ps(radiusSq);
+#endif
+
+		sLightClusterPair pair;
+		pair.light = lightIndex;
+
+		for(uint32 z = slice0; z <= slice1; ++z)
+		{
+			for(int32 y = tileY0; y <= tileY1; ++y)
+			{
+				const uint32 rowStart = GetClusterIndex(0, y, z);
+				int32 x = tileX0;
+
+				//passing clusters are flagged in a bit mask, 4 at a time
+				while(x <= tileX1)
+				{
+					uint32 mask = 0;
+					uint32 testCount = 0;
+					const uint32 i = rowStart + x;
+#ifdef MASH_SIMD_SSE
+					if (x + 3 <= tileX1)
+					{
+						__m128 dx = _mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&minX[i]), cx), _mm_sub_ps(cx, _mm_loadu_ps(&maxX[i])));
+						__m128 dy = _mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&minY[i]), cy), _mm_sub_ps(cy, _mm_loadu_ps(&maxY[i])));
+						__m128 dz = _mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&minZ[i]), cz), _mm_sub_ps(cz, _mm_loadu_ps(&maxZ[i])));
+						dx = _mm_max_ps(dx, zero);
+						dy = _mm_max_ps(dy, zero);
+						dz = _mm_max_ps(dz, zero);
+						const __m128 distSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+						mask = (uint32)_mm_movemask_ps(_mm_cmple_ps(distSq, rSq));
+						testCount = 4;
+					}
+					else
+#endif
+					{
+						const f32 dx = math::Max<f32>(0.0f, math::Max<f32>(minX[i] - centre.x, centre.x - maxX[i]));
+						const f32 dy = math::Max<f32>(0.0f, math::Max<f32>(minY[i] - centre.y, centre.y - maxY[i]));
+						const f32 dz = math::Max<f32>(0.0f, math::Max<f32>(minZ[i] - centre.z, centre.z - maxZ[i]));
+						mask = (((dx * dx) + (dy * dy) + (dz * dz)) <= radiusSq) ? 1 : 0;
+						testCount = 1;
+					}
+
+					for(uint32 j = 0; j < testCount; ++j)
+					{
+						if (!(mask & (1 << j)))
+							continue;
+
+						const uint32 cluster = i + j;
+						if (isSpot)
+						{
+							//test the sphere around the cluster against the cone
+							const MashVector3 boxMin(minX[cluster], minY[cluster], minZ[cluster]);
+							const MashVector3 boxMax(maxX[cluster], maxY[cluster], maxZ[cluster]);
+							const MashVector3 boxCentre = (boxMin + boxMax) * 0.5f;
+							const f32 boxRadius = (boxMax - boxCentre).Length();
+
+							const MashVector3 v = boxCentre - light.position;
+							const f32 lengthSq = v.Dot(v);
+							const f32 alongDirection = v.Dot(light.direction);
+							const f32 closest = (light.cosOuterCone * sqrtf(math::Max<f32>(0.0f, lengthSq - (alongDirection * alongDirection)))) - (alongDirection * sinOuterCone);
+							if ((closest > boxRadius) || (alongDirection > (boxRadius + light.range)) || (alongDirection < -boxRadius))
+								continue;
+						}
+
+						pair.cluster = cluster;
+						pairsOut.PushBack(pair);
+					}
+
+					x += testCount;
+				}
+			}
+		}
+	}
+
+	void MashLightClusterGrid::_BinLights(const sLightVolume *lights, uint32 first, uint32 last, MashArray<sLightClusterPair> &pairsOut)const
+	{
+		pairsOut.Clear();
+		for(uint32 i = first; i < last; ++i)
+		{
+			if (lights[i].type != aLIGHT_DIRECTIONAL)
+				_BinLight(lights[i], i, pairsOut);
+		}
+	}
+
+	void MashLightClusterGrid::Build(const sLightVolume *lights, uint32 count)
+	{
+		if (m_boundsDirty)
+			_RebuildBounds();
+
+		const uint32 clusterCount = GetClusterCount();
+		m_directionalLights.Clear();
+		for(uint32 i = 0; i < count; ++i)
+		{
+			if ((lights[i].type == aLIGHT_DIRECTIONAL) && (lights[i].range >= 0.0f))
+				m_directionalLights.PushBack(i);
+		}
+
+		//split the lights into contiguous ranges so indices stay in order
+		uint32 jobCount = 1;
+		if (m_maxThreads != 1)
+		{
+			const uint32 threadCount = (m_maxThreads == 0) ? jobs::GetHardwareThreadCount() : m_maxThreads;
+			jobCount = math::Min<uint32>(math::Min<uint32>(threadCount, g_clusterMaxJobs), count / g_clusterMinLightsPerJob);
+			if (jobCount == 0)
+				jobCount = 1;
+		}
+
+		if (m_pairs.Size() < jobCount)
+			m_pairs.Resize(jobCount);
+
+		if (jobCount == 1)
+		{
+			_BinLights(lights, 0, count, m_pairs[0]);
+		}
+		else
+		{
+			CBinJob binJobs[g_clusterMaxJobs];
+			MashJob *jobList[g_clusterMaxJobs];
+			const uint32 lightsPerJob = (count + jobCount - 1) / jobCount;
+			for(uint32 i = 0; i < jobCount; ++i)
+			{
+				binJobs[i].grid = this;
+				binJobs[i].lights = lights;
+				binJobs[i].first = math::Min<uint32>(i * lightsPerJob, count);
+				binJobs[i].last = math::Min<uint32>(binJobs[i].first + lightsPerJob, count);
+				binJobs[i].pairs = &m_pairs[i];
+				jobList[i] = &binJobs[i];
+			}
+
+			jobs::RunJobs(jobList, jobCount, m_maxThreads);
+		}
+
+		//count the lights in each cluster then scatter them into one array
+		const uint32 directionalCount = m_directionalLights.Size();
+		sCluster *clusters = m_clusters.Pointer();
+		for(uint32 i = 0; i < clusterCount; ++i)
+			clusters[i].count = directionalCount;
+
+		uint32 pairCount = 0;
+		for(uint32 j = 0; j < jobCount; ++j)
+		{
+			const uint32 jobPairCount = m_pairs[j].Size();
+			const sLightClusterPair *pairs = m_pairs[j].Pointer();
+			for(uint32 i = 0; i < jobPairCount; ++i)
+				++clusters[pairs[i].cluster].count;
+
+			pairCount += jobPairCount;
+		}
+
+		uint32 offset = 0;
+		for(uint32 i = 0; i < clusterCount; ++i)
+		{
+			clusters[i].offset = offset;
+			offset += clusters[i].count;
+			clusters[i].count = 0;
+		}
+
+		m_lightIndices.Resize(pairCount + (directionalCount * clusterCount));
+		uint32 *indices = m_lightIndices.Pointer();
+
+		if (directionalCount > 0)
+		{
+			for(uint32 i = 0; i < clusterCount; ++i)
+			{
+				for(uint32 d = 0; d < directionalCount; ++d)
+					indices[clusters[i].offset + d] = m_directionalLights[d];
+
+				clusters[i].count = directionalCount;
+			}
+		}
+
+		for(uint32 j = 0; j < jobCount; ++j)
+		{
+			const uint32 jobPairCount = m_pairs[j].Size();
+			const sLightClusterPair *pairs = m_pairs[j].Pointer();
+			for(uint32 i = 0; i < jobPairCount; ++i)
+			{
+				sCluster &cluster = clusters[pairs[i].cluster];
+				indices[cluster.offset + cluster.count++] = pairs[i].light;
+			}
+		}
+	}
+
+	void MashLightClusterGrid::Build(MashLight *const *lights, uint32 count)
+	{
+		m_lightVolumes.Resize(count);
+		for(uint32 i = 0; i < count; ++i)
+		{
+			const sMashLight *data = lights[i]->GetLightData();
+			sLightVolume &volume = m_lightVolumes[i];
+			volume.type = lights[i]->GetLightType();
+			volume.position = data->viewSpacePosition;
+			volume.direction = data->viewSpaceDirection;
+			volume.cosOuterCone = data->outerCone;
+
+			//negative range marks the light as disabled
+			volume.range = lights[i]->IsLightEnabled() ? data->range : -1.0f;
+		}
+
+		Build(m_lightVolumes.Pointer(), count);
+	}
+
+	int32 MashLightClusterGrid::GetClusterIndex(const MashVector3 &viewPosition)const
+	{
+		if ((viewPosition.z < m_near) || (viewPosition.z > m_far) || m_boundsDirty)
+			return -1;
+
+		const f32 ndcX = viewPosition.x / (viewPosition.z * m_tanHalfFovX);
+		const f32 ndcY = viewPosition.y / (viewPosition.z * m_tanHalfFovY);
+		if ((ndcX < -1.0f) || (ndcX > 1.0f) || (ndcY < -1.0f) || (ndcY > 1.0f))
+			return -1;
+
+		const uint32 x = (uint32)math::Clamp<int32>(0, (int32)m_tilesX - 1, (int32)((ndcX + 1.0f) * 0.5f * (f32)m_tilesX));
+		const uint32 y = (uint32)math::Clamp<int32>(0, (int32)m_tilesY - 1, (int32)((ndcY + 1.0f) * 0.5f * (f32)m_tilesY));
+		return (int32)GetClusterIndex(x, y, _GetSlice(viewPosition.z));
+	}
+
+	void MashLightClusterGrid::GetClusterBounds(uint32 cluster, MashAABB &boundsOut)const
+	{
+		boundsOut.min = MashVector3(m_boundsMinX[cluster], m_boundsMinY[cluster], m_boundsMinZ[cluster]);
+		boundsOut.max = MashVector3(m_boundsMaxX[cluster], m_boundsMaxY[cluster], m_boundsMaxZ[cluster]);
+	}
+
+	uint32 MashLightClusterGrid::GetTileLights(uint32 tileX, uint32 tileY, f32 minDepth, f32 maxDepth, MashArray<uint32> &lightsOut)const
+	{
+		lightsOut.Clear();
+
+		if ((tileX >= m_tilesX) || (tileY >= m_tilesY) || m_boundsDirty)
+			return 0;
+
+		if ((maxDepth < m_near) || (minDepth > m_far) || (minDepth > maxDepth))
+			return 0;
+
+		const uint32 firstSlice = _GetSlice(minDepth);
+		const uint32 lastSlice = _GetSlice(maxDepth);
+		for(uint32 z = firstSlice; z <= lastSlice; ++z)
+		{
+			const sCluster &cluster = m_clusters[GetClusterIndex(tileX, tileY, z)];
+			lightsOut.Append(m_lightIndices.Pointer() + cluster.offset, cluster.count);
+		}
+
+		//lights spanning several slices are listed more than once
+		if (lightsOut.Size() > 1)
+		{
+			lightsOut.Sort();
+
+			uint32 *indices = lightsOut.Pointer();
+			uint32 uniqueCount = 1;
+			for(uint32 i = 1; i < lightsOut.Size(); ++i)
+			{
+				if (indices[i] != indices[uniqueCount - 1])
+					indices[uniqueCount++] = indices[i];
+			}
+
+			lightsOut.Resize(uniqueCount);
+		}
+
+		return lightsOut.Size();
+	}
+}
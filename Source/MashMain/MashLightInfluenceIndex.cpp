@@ -0,0 +1,309 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#include "MashLightInfluenceIndex.h"
+#include "MashAABB.h"
+#include "MashMathHelper.h"
+#include <math.h>
+
+namespace mash
+{
+	//queries touching more cells than this test every light instead
+	static const uint32 g_influenceMaxQueryCells = 64;
+	//keeps very large bounds from overflowing the cell coordinates
+	static const f32 g_influenceMaxCell = 1000000.0f;
+
+	MashLightInfluenceIndex::MashLightInfluenceIndex(f32 cellSize):m_cellSize(1.0f), m_invCellSize(1.0f),
+		m_activeLightCount(0), m_rehashCount(0), m_queryStamp(0)
+	{
+		m_buckets.Resize(aBUCKET_COUNT);
+		SetCellSize(cellSize);
+	}
+
+	MashLightInfluenceIndex::~MashLightInfluenceIndex()
+	{
+	}
+
+	void MashLightInfluenceIndex::SetCellSize(f32 cellSize)
+	{
+		if (cellSize <= 0.0f)
+			cellSize = 1.0f;
+
+		if (cellSize == m_cellSize)
+			return;
+
+		const uint32 lightCount = m_lights.Size();
+		for(uint32 i = 0; i < lightCount; ++i)
+		{
+			if (m_lights[i].active)
+				_Remove(i);
+		}
+
+		m_cellSize = cellSize;
+		m_invCellSize = 1.0f / cellSize;
+
+		for(uint32 i = 0; i < lightCount; ++i)
+		{
+			if (m_lights[i].active)
+				_Insert(i);
+		}
+	}
+
+	uint32 MashLightInfluenceIndex::_GetBucket(int32 x, int32 y, int32 z)const
+	{
+		const uint32 hash = ((uint32)x * 73856093U) ^ ((uint32)y * 19349663U) ^ ((uint32)z * 83492791U);
+		return hash & (aBUCKET_COUNT - 1);
+	}
+
+	void MashLightInfluenceIndex::_GetCells(const MashVector3 &boundsMin, const MashVector3 &boundsMax, int32 *cellMinOut, int32 *cellMaxOut)const
+	{
+		for(uint32 i = 0; i < 3; ++i)
+		{
+			cellMinOut[i] = (int32)floorf(math::Clamp<f32>(-g_influenceMaxCell, g_influenceMaxCell, boundsMin.v[i] * m_invCellSize));
+			cellMaxOut[i] = (int32)floorf(math::Clamp<f32>(-g_influenceMaxCell, g_influenceMaxCell, boundsMax.v[i] * m_invCellSize));
+		}
+	}
+
+	void MashLightInfluenceIndex::_Insert(uint32 id)
+	{
+		sLightRecord &light = m_lights[id];
+		const MashVector3 extents(light.range, light.range, light.range);
+		_GetCells(light.position - extents, light.position + extents, light.cellMin, light.cellMax);
+
+		const f32 cellCount = (f32)(light.cellMax[0] - light.cellMin[0] + 1) *
+			(f32)(light.cellMax[1] - light.cellMin[1] + 1) *
+			(f32)(light.cellMax[2] - light.cellMin[2] + 1);
+
+		light.oversized = (cellCount > (f32)aMAX_LIGHT_CELLS);
+		if (light.oversized)
+		{
+			m_oversizedLights.PushBack(id);
+			return;
+		}
+
+		for(int32 z = light.cellMin[2]; z <= light.cellMax[2]; ++z)
+		{
+			for(int32 y = light.cellMin[1]; y <= light.cellMax[1]; ++y)
+			{
+				for(int32 x = light.cellMin[0]; x <= light.cellMax[0]; ++x)
+					m_buckets[_GetBucket(x, y, z)].PushBack(id);
+			}
+		}
+	}
+
+	void MashLightInfluenceIndex::_Remove(uint32 id)
+	{
+		const sLightRecord &light = m_lights[id];
+		if (light.oversized)
+		{
+			const uint32 count = m_oversizedLights.Size();
+			for(uint32 i = 0; i < count; ++i)
+			{
+				if (m_oversizedLights[i] == id)
+				{
+					m_oversizedLights[i] = m_oversizedLights[count - 1];
+					m_oversizedLights.PopBack();
+					break;
+				}
+			}
+
+			return;
+		}
+
+		/*
+			Several cells may share a bucket so only one entry is removed
+			per cell to match _Insert().
+		*/
+		for(int32 z = light.cellMin[2]; z <= light.cellMax[2]; ++z)
+		{
+			for(int32 y = light.cellMin[1]; y <= light.cellMax[1]; ++y)
+			{
+				for(int32 x = light.cellMin[0]; x <= light.cellMax[0]; ++x)
+				{
+					MashArray<uint32> &bucket = m_buckets[_GetBucket(x, y, z)];
+					const uint32 count = bucket.Size();
+					for(uint32 i = 0; i < count; ++i)
+					{
+						if (bucket[i] == id)
+						{
+							bucket[i] = bucket[count - 1];
+							bucket.PopBack();
+							break;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	void MashLightInfluenceIndex::SetLight(uint32 id, const MashVector3 &position, f32 range, const MashVector3 &attenuation, f32 intensity)
+	{
+		if (id >= m_lights.Size())
+		{
+			sLightRecord emptyRecord = sLightRecord();
+			m_lights.Resize(id + 1, emptyRecord);
+		}
+
+		if (range < 0.0f)
+			range = 0.0f;
+
+		sLightRecord &light = m_lights[id];
+		light.attenuation = attenuation;
+		light.intensity = intensity;
+
+		if (light.active)
+		{
+			const MashVector3 extents(range, range, range);
+			int32 cellMin[3];
+			int32 cellMax[3];
+			_GetCells(position - extents, position + extents, cellMin, cellMax);
+
+			//still in the same cells so only the light data needs updating
+			if ((cellMin[0] == light.cellMin[0]) && (cellMin[1] == light.cellMin[1]) && (cellMin[2] == light.cellMin[2]) &&
+				(cellMax[0] == light.cellMax[0]) && (cellMax[1] == light.cellMax[1]) && (cellMax[2] == light.cellMax[2]))
+			{
+				light.position = position;
+				light.range = range;
+				return;
+			}
+
+			_Remove(id);
+			++m_rehashCount;
+		}
+		else
+		{
+			light.active = true;
+			++m_activeLightCount;
+		}
+
+		light.position = position;
+		light.range = range;
+		_Insert(id);
+	}
+
+	void MashLightInfluenceIndex::RemoveLight(uint32 id)
+	{
+		if ((id >= m_lights.Size()) || !m_lights[id].active)
+			return;
+
+		_Remove(id);
+		m_lights[id].active = false;
+		--m_activeLightCount;
+	}
+
+	void MashLightInfluenceIndex::Clear()
+	{
+		for(uint32 i = 0; i < aBUCKET_COUNT; ++i)
+			m_buckets[i].Clear();
+
+		m_oversizedLights.Clear();
+		m_lights.Clear();
+		m_activeLightCount = 0;
+	}
+
+	void MashLightInfluenceIndex::_AddCandidate(uint32 id, const MashAABB &bounds, uint32 maxLights, uint32 *lightsOut, f32 *scores, uint32 &countOut)
+	{
+		sLightRecord &light = m_lights[id];
+		if (light.queryStamp == m_queryStamp)
+			return;
+
+		light.queryStamp = m_queryStamp;
+
+		MashVector3 closestPoint;
+		bounds.ClosestPoint(light.position, closestPoint);
+		const f32 distanceSq = light.position.GetDistanceToSQ(closestPoint);
+		if (distanceSq >= (light.range * light.range))
+			return;
+
+		//same falloff as the lighting shaders
+		const f32 distance = sqrtf(distanceSq);
+		f32 denominator = (light.attenuation.x * distanceSq) + (light.attenuation.y * distance) + light.attenuation.z;
+		if (denominator < 0.0001f)
+			denominator = 0.0001f;
+
+		const f32 score = light.intensity / denominator;
+		if ((countOut == maxLights) && (score <= scores[countOut - 1]))
+			return;
+
+		//insert into the list sorted by score
+		uint32 i = (countOut < maxLights) ? countOut++ : countOut - 1;
+		for(; (i > 0) && (scores[i - 1] < score); --i)
+		{
+			scores[i] = scores[i - 1];
+			lightsOut[i] = lightsOut[i - 1];
+		}
+
+		scores[i] = score;
+		lightsOut[i] = id;
+	}
+
+	uint32 MashLightInfluenceIndex::GetInfluences(const MashAABB &bounds, uint32 maxLights, uint32 *lightsOut)
+	{
+		if ((maxLights == 0) || (m_activeLightCount == 0))
+			return 0;
+
+		//a new stamp makes sure lights in several cells are only tested once
+		++m_queryStamp;
+		if (m_queryStamp == 0)
+		{
+			const uint32 lightCount = m_lights.Size();
+			for(uint32 i = 0; i < lightCount; ++i)
+				m_lights[i].queryStamp = 0;
+
+			m_queryStamp = 1;
+		}
+
+		f32 scoreBuffer[16];
+		MashArray<f32> scoreArray;
+		f32 *scores = scoreBuffer;
+		if (maxLights > 16)
+		{
+			scoreArray.Resize(maxLights);
+			scores = scoreArray.Pointer();
+		}
+
+		uint32 count = 0;
+
+		int32 cellMin[3];
+		int32 cellMax[3];
+		_GetCells(bounds.min, bounds.max, cellMin, cellMax);
+
+		const f32 cellCount = (f32)(cellMax[0] - cellMin[0] + 1) *
+			(f32)(cellMax[1] - cellMin[1] + 1) *
+			(f32)(cellMax[2] - cellMin[2] + 1);
+
+		if (cellCount > (f32)g_influenceMaxQueryCells)
+		{
+			const uint32 lightCount = m_lights.Size();
+			for(uint32 i = 0; i < lightCount; ++i)
+			{
+				if (m_lights[i].active)
+					_AddCandidate(i, bounds, maxLights, lightsOut, scores, count);
+			}
+		}
+		else
+		{
+			for(int32 z = cellMin[2]; z <= cellMax[2]; ++z)
+			{
+				for(int32 y = cellMin[1]; y <= cellMax[1]; ++y)
+				{
+					for(int32 x = cellMin[0]; x <= cellMax[0]; ++x)
+					{
+						const MashArray<uint32> &bucket = m_buckets[_GetBucket(x, y, z)];
+						const uint32 bucketSize = bucket.Size();
+						for(uint32 i = 0; i < bucketSize; ++i)
+							_AddCandidate(bucket[i], bounds, maxLights, lightsOut, scores, count);
+					}
+				}
+			}
+
+			const uint32 oversizedCount = m_oversizedLights.Size();
+			for(uint32 i = 0; i < oversizedCount; ++i)
+				_AddCandidate(m_oversizedLights[i], bounds, maxLights, lightsOut, scores, count);
+		}
+
+		return count;
+	}
+}
@@ -10,13 +10,39 @@
 #include "MashEventTypes.h"
 #include "MashMathHelper.h"
 
+#ifdef MASH_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
 namespace mash
 {
 	MashLog *MashLog::m_instance = 0;
 
+	/*
+		Messages may be written from worker threads, for example while scene
+		files are parsed in parallel. Initialised with the log instance.
+	*/
+#ifdef MASH_WINDOWS
+	static CRITICAL_SECTION g_logLock;
+#else
+	static pthread_mutex_t g_logLock;
+#endif
+
     MashLog::MashLog():m_log(0), m_errorLevelFlags(mash::math::MaxUInt32()), m_receiverID(0),
         m_suppressMessages(false)
 	{
+#ifdef MASH_WINDOWS
+		InitializeCriticalSection(&g_logLock);
+#else
+		//recursive like a critical section so receivers can write to the log
+		pthread_mutexattr_t lockAttributes;
+		pthread_mutexattr_init(&lockAttributes);
+		pthread_mutexattr_settype(&lockAttributes, PTHREAD_MUTEX_RECURSIVE);
+		pthread_mutex_init(&g_logLock, &lockAttributes);
+		pthread_mutexattr_destroy(&lockAttributes);
+#endif
 	}
 
 	MashLog* MashLog::Instance()
@@ -39,6 +65,12 @@ namespace mash
 	MashLog::~MashLog()
 	{
 		CloseLog();
+
+#ifdef MASH_WINDOWS
+		DeleteCriticalSection(&g_logLock);
+#else
+		pthread_mutex_destroy(&g_logLock);
+#endif
 	}
 
 	// Closes the current log if it is open.
@@ -114,16 +146,25 @@ namespace mash
         
 		if (m_errorLevelFlags & (uint32)level)
 		{
+#ifdef MASH_WINDOWS
+			EnterCriticalSection(&g_logLock);
+#else
+			pthread_mutex_lock(&g_logLock);
+#endif
 			if (m_log == 0)
 			{
 				CreateLog();
 
 				if (m_log == 0)
+				{
+#ifdef MASH_WINDOWS
+					LeaveCriticalSection(&g_logLock);
+#else
+					pthread_mutex_unlock(&g_logLock);
+#endif
 					return;
+				}
 			}
-            else
-            {
-            }
 
 			MashStringc message;
 			switch(level)
@@ -170,6 +211,12 @@ namespace mash
 				for(uint32 i = 0; i < receiverCount; ++i)
 					m_receivers[i].callback.Call(e);
 			}
+
+#ifdef MASH_WINDOWS
+			LeaveCriticalSection(&g_logLock);
+#else
+			pthread_mutex_unlock(&g_logLock);
+#endif
 		}
 	}
 }
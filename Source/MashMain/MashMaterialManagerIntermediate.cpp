@@ -52,6 +52,7 @@ namespace mash
 		}
 
 		m_materials.Clear();
+		m_materialsByName.Clear();
 	}
 
 	eMASH_STATUS MashMaterialManagerIntermediate::_Initialise(const sMashDeviceSettings &creationParameters)
@@ -81,6 +82,11 @@ namespace mash
 		m_autoShaderParameters.PushBack(MASH_NEW_COMMON MashParameterGBufferLightSpecualrSampler(m_renderer));
 
 		m_autoShaderParameters.PushBack(MASH_NEW_COMMON MashParamBonePaletteArray());
+		m_autoShaderParameters.PushBack(MASH_NEW_COMMON MashParamBonePaletteTexture());
+		m_autoShaderParameters.PushBack(MASH_NEW_COMMON MashParamBonePaletteInfo());
+		m_autoShaderParameters.PushBack(MASH_NEW_COMMON MashParamLightClusterTexture());
+		m_autoShaderParameters.PushBack(MASH_NEW_COMMON MashParamLightClusterInfo());
+		m_autoShaderParameters.PushBack(MASH_NEW_COMMON MashParamLightClusterGrid());
 
 		m_autoShaderParameters.PushBack(MASH_NEW_COMMON MashParamLightWorldPosition());
 
@@ -144,6 +150,9 @@ namespace mash
 
 				break;
 			}
+		default:
+			//no special autos needed
+			break;
 		}
 
 		switch(materialType)
@@ -218,6 +227,21 @@ namespace mash
 				loadedMaterial = GetMaterial("MashGBufferClear", "MashGBufferMaterial.mtl", 0, 0, wasLoaded);
 				break;
 			}
+		case aSTANDARD_MATERIAL_GBUFFER_TILED_DIR_LIGHT:
+			{
+				loadedMaterial = GetMaterial("MashGBufferTiledDirectionalLight", "MashGBufferMaterial.mtl", 0, 0, wasLoaded);
+				break;
+			}
+		case aSTANDARD_MATERIAL_GBUFFER_TILED_SPOT_LIGHT:
+			{
+				loadedMaterial = GetMaterial("MashGBufferTiledSpotLight", "MashGBufferMaterial.mtl", 0, 0, wasLoaded);
+				break;
+			}
+		case aSTANDARD_MATERIAL_GBUFFER_TILED_POINT_LIGHT:
+			{
+				loadedMaterial = GetMaterial("MashGBufferTiledPointLight", "MashGBufferMaterial.mtl", 0, 0, wasLoaded);
+				break;
+			}
 		case aSTANDARD_MATERIAL_PARTICLE_CPU:
 			{
 				loadedMaterial = GetMaterial("MashCPUParticleMaterial", "MashCPUParticleMaterial.mtl", 0, 0, wasLoaded);
@@ -352,6 +376,7 @@ namespace mash
 		{
 			if (*iter == pMaterial)
 			{
+				m_materialsByName.Erase(MashStringID(pMaterial->GetMaterialName()));
 				m_materials.Erase(iter);
                 pMaterial->Drop();
 				break;
@@ -370,6 +395,7 @@ namespace mash
 		}
 
 		m_materials.Clear();
+		m_materialsByName.Clear();
 	}
 
 	eMASH_STATUS MashMaterialManagerIntermediate::SaveAllSkinsToFile(const int8 *sFileName)
@@ -385,15 +411,14 @@ namespace mash
         if (!sName)
             return 0;
         
-		MashList<MashMaterial*>::ConstIterator iter = m_materials.Begin();
-		MashList<MashMaterial*>::ConstIterator end = m_materials.End();
-		for(; iter != end; ++iter)
-		{
-			if (strcmp((*iter)->GetMaterialName().GetCString(), sName) == 0)
-				return (*iter);
-		}
-        
-		return 0;
+		MashMaterial *const *material = m_materialsByName.Find(sName);
+		return material ? *material : 0;
+	}
+
+	MashMaterial* MashMaterialManagerIntermediate::FindMaterial(const MashStringID &name)const
+	{
+		MashMaterial *const *material = m_materialsByName.Find(name);
+		return material ? *material : 0;
 	}
 
 	MashTechniqueInstance* MashMaterialManagerIntermediate::_CreateTechniqueInstance(MashTechnique *refTechnique)
@@ -508,6 +533,7 @@ namespace mash
 		
 		pMaterial = MASH_NEW_COMMON CMashMaterial(m_renderer, sUniqueName.GetCString(), reference);
 		m_materials.PushBack(pMaterial);
+		m_materialsByName.Insert(MashStringID(sUniqueName), pMaterial);
 
 		return pMaterial;
 	}
@@ -520,6 +546,7 @@ namespace mash
 
 		MashMaterial *newMaterial = MASH_NEW_COMMON CMashMaterial(m_renderer, sUniqueName.GetCString(), 0);
 		m_materials.PushBack(newMaterial);
+		m_materialsByName.Insert(MashStringID(sUniqueName), newMaterial);
 
 		MashVertex *vertexDeclaration = m_renderer->_CreateVertexType(newMaterial, vertexElements, elementCount);
 		if (!vertexDeclaration)
@@ -573,6 +600,14 @@ namespace mash
 		return aMASH_OK;
 	}
 
+	eAUTO_PARAM_UPDATE_RATE MashMaterialManagerIntermediate::GetAutoParameterUpdateRate(uint32 autoParamHandlerIndex)const
+	{
+		if (autoParamHandlerIndex >= m_autoShaderParameters.Size())
+			return aAUTO_PARAM_UPDATE_PER_OBJECT;
+
+		return m_autoShaderParameters[autoParamHandlerIndex]->GetUpdateRate();
+	}
+
 	void MashMaterialManagerIntermediate::_SetProgramAutoParameter(MashEffect *pEffect, 
 		MashEffectParamHandle *pParameter, 
 		uint32 parameterType,
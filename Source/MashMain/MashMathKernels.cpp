@@ -0,0 +1,327 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#include "MashMathKernels.h"
+#include "MashMatrix4.h"
+#include "MashQuaternion.h"
+#include "MashTransformState.h"
+#include "MashAABB.h"
+#include "MashMathHelper.h"
+
+/*
+	AVX kernels are compiled in when the whole engine targets AVX. Otherwise they
+	are compiled for AVX on their own and only used if the CPU supports it.
+*/
+#if defined(MASH_SIMD_AVX)
+	#define MASH_KERNELS_AVX
+	#define MASH_KERNELS_AVX_TARGET
+#elif defined(MASH_SIMD_SSE)
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+		#include <immintrin.h>
+		#define MASH_KERNELS_AVX
+		#define MASH_KERNELS_RUNTIME_AVX
+		#define MASH_KERNELS_AVX_TARGET
+	#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+		#include <immintrin.h>
+		#define MASH_KERNELS_AVX
+		#define MASH_KERNELS_RUNTIME_AVX
+		#define MASH_KERNELS_AVX_TARGET __attribute__((target("avx")))
+	#endif
+#endif
+
+namespace mash
+{
+	typedef void (*TransformPointsKernel)(const f32 *matrix, const uint8 *points, uint32 pointStride, uint8 *pointsOut, uint32 pointOutStride, uint32 count);
+	typedef void (*MultiplyMatricesKernel)(const f32 *a, const f32 *b, f32 *out, uint32 count);
+
+	struct sMathKernelTable
+	{
+		TransformPointsKernel transformPoints;
+		MultiplyMatricesKernel multiplyMatrices;
+		const int8 *name;
+	};
+
+#ifdef MASH_SIMD_SSE
+	//loads 3 floats without reading past the end. The w component is 0.
+	inline __m128 KernelLoad3(const f32 *p)
+	{
+		return _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)p), _mm_load_ss(&p[2]));
+	}
+
+	inline void KernelStore3(f32 *p, __m128 v)
+	{
+		_mm_storel_pi((__m64*)p, v);
+		_mm_store_ss(&p[2], _mm_movehl_ps(v, v));
+	}
+
+	//x + y + z + w in all components
+	inline __m128 KernelHorizontalSum(__m128 v)
+	{
+		v = _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+		return _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+	}
+#endif
+
+	static void TransformPointsDefault(const f32 *matrix, const uint8 *points, uint32 pointStride, uint8 *pointsOut, uint32 pointOutStride, uint32 count)
+	{
+#ifdef MASH_SIMD_SSE
+		const __m128 r0 = _mm_loadu_ps(&matrix[0]);
+		const __m128 r1 = _mm_loadu_ps(&matrix[4]);
+		const __m128 r2 = _mm_loadu_ps(&matrix[8]);
+		const __m128 r3 = _mm_loadu_ps(&matrix[12]);
+
+		for(uint32 i = 0; i < count; ++i)
+		{
+			const f32 *p = (const f32*)&points[i * pointStride];
+			__m128 result = _mm_add_ps(r3, _mm_mul_ps(_mm_set1_ps(p[0]), r0));
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(p[1]), r1));
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(p[2]), r2));
+			KernelStore3((f32*)&pointsOut[i * pointOutStride], result);
+		}
+#else
+		for(uint32 i = 0; i < count; ++i)
+			simd::TransformPointScalar(matrix, (const f32*)&points[i * pointStride], (f32*)&pointsOut[i * pointOutStride]);
+#endif
+	}
+
+	static void MultiplyMatricesDefault(const f32 *a, const f32 *b, f32 *out, uint32 count)
+	{
+		for(uint32 i = 0; i < count; ++i)
+			simd::MatrixMultiply(&a[i * 16], &b[i * 16], &out[i * 16]);
+	}
+
+#ifdef MASH_KERNELS_AVX
+	MASH_KERNELS_AVX_TARGET static void TransformPointsAVX(const f32 *matrix, const uint8 *points, uint32 pointStride, uint8 *pointsOut, uint32 pointOutStride, uint32 count)
+	{
+		//two points at a time, one in each 128 bit lane
+		const __m256 r0 = _mm256_broadcast_ps((const __m128*)&matrix[0]);
+		const __m256 r1 = _mm256_broadcast_ps((const __m128*)&matrix[4]);
+		const __m256 r2 = _mm256_broadcast_ps((const __m128*)&matrix[8]);
+		const __m256 r3 = _mm256_broadcast_ps((const __m128*)&matrix[12]);
+
+		uint32 i = 0;
+		for(; (i + 1) < count; i += 2)
+		{
+			const f32 *p0 = (const f32*)&points[i * pointStride];
+			const f32 *p1 = (const f32*)&points[(i + 1) * pointStride];
+
+			const __m256 x = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(p0[0])), _mm_set1_ps(p1[0]), 1);
+			const __m256 y = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(p0[1])), _mm_set1_ps(p1[1]), 1);
+			const __m256 z = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(p0[2])), _mm_set1_ps(p1[2]), 1);
+
+			__m256 result = _mm256_add_ps(r3, _mm256_mul_ps(x, r0));
+			result = _mm256_add_ps(result, _mm256_mul_ps(y, r1));
+			result = _mm256_add_ps(result, _mm256_mul_ps(z, r2));
+
+			KernelStore3((f32*)&pointsOut[i * pointOutStride], _mm256_castps256_ps128(result));
+			KernelStore3((f32*)&pointsOut[(i + 1) * pointOutStride], _mm256_extractf128_ps(result, 1));
+		}
+
+		_mm256_zeroupper();
+
+		if (i < count)
+			TransformPointsDefault(matrix, &points[i * pointStride], pointStride, &pointsOut[i * pointOutStride], pointOutStride, 1);
+	}
+
+	MASH_KERNELS_AVX_TARGET static void MultiplyMatricesAVX(const f32 *a, const f32 *b, f32 *out, uint32 count)
+	{
+		for(uint32 i = 0; i < count; ++i)
+		{
+			const f32 *ma = &a[i * 16];
+			const f32 *mb = &b[i * 16];
+
+			//two rows of a at a time, one in each 128 bit lane
+			const __m256 b0 = _mm256_broadcast_ps((const __m128*)&mb[0]);
+			const __m256 b1 = _mm256_broadcast_ps((const __m128*)&mb[4]);
+			const __m256 b2 = _mm256_broadcast_ps((const __m128*)&mb[8]);
+			const __m256 b3 = _mm256_broadcast_ps((const __m128*)&mb[12]);
+			const __m256 a01 = _mm256_loadu_ps(&ma[0]);
+			const __m256 a23 = _mm256_loadu_ps(&ma[8]);
+
+			__m256 r01 = _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0x00), b0);
+			r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0x55), b1));
+			r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0xAA), b2));
+			r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, 0xFF), b3));
+
+			__m256 r23 = _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0x00), b0);
+			r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0x55), b1));
+			r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0xAA), b2));
+			r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, 0xFF), b3));
+
+			_mm256_storeu_ps(&out[i * 16], r01);
+			_mm256_storeu_ps(&out[(i * 16) + 8], r23);
+		}
+
+		_mm256_zeroupper();
+	}
+#endif
+
+	static bool CPUSupportsAVX()
+	{
+#if defined(MASH_SIMD_AVX)
+		return true;
+#elif defined(MASH_KERNELS_RUNTIME_AVX) && defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 1);
+
+		//the cpu must support AVX and the OS must save the AVX registers
+		const bool cpuSupport = (info[2] & (1 << 28)) != 0;
+		const bool osxsave = (info[2] & (1 << 27)) != 0;
+		if (!cpuSupport || !osxsave)
+			return false;
+
+		return (_xgetbv(0) & 6) == 6;
+#elif defined(MASH_KERNELS_RUNTIME_AVX)
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx") != 0;
+#else
+		return false;
+#endif
+	}
+
+	static sMathKernelTable SelectKernels()
+	{
+		sMathKernelTable table;
+		table.transformPoints = TransformPointsDefault;
+		table.multiplyMatrices = MultiplyMatricesDefault;
+
+#if defined(MASH_SIMD_SSE)
+		table.name = "SSE";
+#else
+		table.name = "Scalar";
+#endif
+
+#ifdef MASH_KERNELS_AVX
+		if (CPUSupportsAVX())
+		{
+			table.transformPoints = TransformPointsAVX;
+			table.multiplyMatrices = MultiplyMatricesAVX;
+			table.name = "AVX";
+		}
+#endif
+
+		return table;
+	}
+
+	static const sMathKernelTable& GetKernelTable()
+	{
+		static const sMathKernelTable table = SelectKernels();
+		return table;
+	}
+
+	namespace kernels
+	{
+		void TransformPoints(const MashMatrix4 &matrix, const void *points, uint32 pointStride, void *pointsOut, uint32 pointOutStride, uint32 count)
+		{
+			GetKernelTable().transformPoints(matrix.v, (const uint8*)points, pointStride, (uint8*)pointsOut, pointOutStride, count);
+		}
+
+		void TransformPoints(const MashTransformState &state, const void *points, uint32 pointStride, void *pointsOut, uint32 pointOutStride, uint32 count)
+		{
+			const MashMatrix4 matrix(state.orientation, state.translation, state.scale);
+			GetKernelTable().transformPoints(matrix.v, (const uint8*)points, pointStride, (uint8*)pointsOut, pointOutStride, count);
+		}
+
+		void TransformVectors(const MashMatrix4 &matrix, const void *vectors, uint32 vectorStride, void *vectorsOut, uint32 vectorOutStride, uint32 count)
+		{
+			MashMatrix4 rotation(matrix);
+			rotation.m41 = 0.0f;
+			rotation.m42 = 0.0f;
+			rotation.m43 = 0.0f;
+			GetKernelTable().transformPoints(rotation.v, (const uint8*)vectors, vectorStride, (uint8*)vectorsOut, vectorOutStride, count);
+		}
+
+		void NormalizeVectors(void *vectors, uint32 vectorStride, uint32 count)
+		{
+			uint8 *data = (uint8*)vectors;
+#ifdef MASH_SIMD_SSE
+			for(uint32 i = 0; i < count; ++i)
+			{
+				f32 *p = (f32*)&data[i * vectorStride];
+				const __m128 v = KernelLoad3(p);
+				const __m128 magSqr = KernelHorizontalSum(_mm_mul_ps(v, v));
+				if (_mm_cvtss_f32(magSqr) > 0.0f)
+					KernelStore3(p, _mm_div_ps(v, _mm_sqrt_ps(magSqr)));
+			}
+#else
+			for(uint32 i = 0; i < count; ++i)
+				((MashVector3*)&data[i * vectorStride])->Normalize();
+#endif
+		}
+
+		void ComputeBounds(const void *points, uint32 pointStride, uint32 count, MashAABB &boundsOut)
+		{
+			boundsOut = MashAABB();
+			const uint8 *data = (const uint8*)points;
+#ifdef MASH_SIMD_SSE
+			if (count == 0)
+				return;
+
+			__m128 minV = KernelLoad3((const f32*)data);
+			__m128 maxV = minV;
+			for(uint32 i = 1; i < count; ++i)
+			{
+				const __m128 p = KernelLoad3((const f32*)&data[i * pointStride]);
+				minV = _mm_min_ps(minV, p);
+				maxV = _mm_max_ps(maxV, p);
+			}
+
+			KernelStore3(boundsOut.min.v, minV);
+			KernelStore3(boundsOut.max.v, maxV);
+#else
+			for(uint32 i = 0; i < count; ++i)
+				boundsOut.Add(*(const MashVector3*)&data[i * pointStride]);
+#endif
+		}
+
+		void MergeAABBs(const MashAABB *boxes, uint32 count, MashAABB &boundsInOut)
+		{
+#ifdef MASH_SIMD_SSE
+			__m128 minV = KernelLoad3(boundsInOut.min.v);
+			__m128 maxV = KernelLoad3(boundsInOut.max.v);
+			for(uint32 i = 0; i < count; ++i)
+			{
+				minV = _mm_min_ps(minV, KernelLoad3(boxes[i].min.v));
+				maxV = _mm_max_ps(maxV, KernelLoad3(boxes[i].max.v));
+			}
+
+			KernelStore3(boundsInOut.min.v, minV);
+			KernelStore3(boundsInOut.max.v, maxV);
+#else
+			for(uint32 i = 0; i < count; ++i)
+				boundsInOut.Merge(boxes[i]);
+#endif
+		}
+
+		void MultiplyMatrices(const MashMatrix4 *a, const MashMatrix4 *b, MashMatrix4 *out, uint32 count)
+		{
+			GetKernelTable().multiplyMatrices(a->v, b->v, out->v, count);
+		}
+
+		void NormalizeQuaternions(MashQuaternion *quaternions, uint32 count)
+		{
+#ifdef MASH_SIMD_SSE
+			for(uint32 i = 0; i < count; ++i)
+			{
+				const __m128 q = _mm_loadu_ps(quaternions[i].v);
+				const __m128 magSqr = KernelHorizontalSum(_mm_mul_ps(q, q));
+				if (_mm_cvtss_f32(magSqr) > 0.0f)
+					_mm_storeu_ps(quaternions[i].v, _mm_div_ps(q, _mm_sqrt_ps(magSqr)));
+				else
+					quaternions[i].Identity();
+			}
+#else
+			for(uint32 i = 0; i < count; ++i)
+				quaternions[i].Normalize();
+#endif
+		}
+
+		const int8* GetKernelBackendName()
+		{
+			return GetKernelTable().name;
+		}
+	}
+}
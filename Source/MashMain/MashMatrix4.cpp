@@ -11,66 +11,6 @@
 #include "MashMathHelper.h"
 namespace mash
 {
-	MashMatrix4 MashMatrix4::operator*(const MashMatrix4 &other)const
-	{
-		MashMatrix4 newMatrix(false);
-
-		//calculate the 3x3 rotation portion
-		newMatrix.m11 = m11*other.m11 + m12*other.m21 + m13*other.m31 + m14*other.m41;
-		newMatrix.m12 = m11*other.m12 + m12*other.m22 + m13*other.m32 + m14*other.m42;
-		newMatrix.m13 = m11*other.m13 + m12*other.m23 + m13*other.m33 + m14*other.m43;
-		newMatrix.m14 = m11*other.m14 + m12*other.m24 + m13*other.m34 + m14*other.m44;
-
-		newMatrix.m21 = m21*other.m11 + m22*other.m21 + m23*other.m31 + m24*other.m41;
-		newMatrix.m22 = m21*other.m12 + m22*other.m22 + m23*other.m32 + m24*other.m42;
-		newMatrix.m23 = m21*other.m13 + m22*other.m23 + m23*other.m33 + m24*other.m43;
-		newMatrix.m24 = m21*other.m14 + m22*other.m24 + m23*other.m34 + m24*other.m44;
-
-		newMatrix.m31 = m31*other.m11 + m32*other.m21 + m33*other.m31 + m34*other.m41;
-		newMatrix.m32 = m31*other.m12 + m32*other.m22 + m33*other.m32 + m34*other.m42;
-		newMatrix.m33 = m31*other.m13 + m32*other.m23 + m33*other.m33 + m34*other.m43;
-		newMatrix.m34 = m31*other.m14 + m32*other.m24 + m33*other.m34 + m34*other.m44;
-
-		//calculate the translation portion
-		newMatrix.m41 = m41*other.m11 + m42*other.m21 + m43*other.m31 + m44*other.m41;
-		newMatrix.m42 = m41*other.m12 + m42*other.m22 + m43*other.m32 + m44*other.m42;
-		newMatrix.m43 = m41*other.m13 + m42*other.m23 + m43*other.m33 + m44*other.m43;
-		newMatrix.m44 = m41*other.m14 + m42*other.m24 + m43*other.m34 + m44*other.m44;
-
-		return newMatrix;
-	}
-
-	MashVector4 MashMatrix4::TransformVector(const MashVector4 &vector)const
-	{
-		MashVector4 out;
-		out.x = (m[0][0]*vector.v[0])+(m[1][0]*vector.v[1])+(m[2][0]*vector.v[2])+(m[3][0]*vector.v[3]);
-		out.y = (m[0][1]*vector.v[0])+(m[1][1]*vector.v[1])+(m[2][1]*vector.v[2])+(m[3][1]*vector.v[3]);
-		out.z = (m[0][2]*vector.v[0])+(m[1][2]*vector.v[1])+(m[2][2]*vector.v[2])+(m[3][2]*vector.v[3]);
-		out.w = (m[0][3]*vector.v[0])+(m[1][3]*vector.v[1])+(m[2][3]*vector.v[2])+(m[3][3]*vector.v[3]);
-		return out;
-	}
-
-	void MashMatrix4::TransformVector(const MashVector3 &vector, MashVector3 &out)const
-	{
-		MashVector3 vec(vector);
-		out.x = vec.x*m11 + vec.y*m21 + vec.z*m31 + m41;
-		out.y = vec.x*m12 + vec.y*m22 + vec.z*m32 + m42;
-		out.z = vec.x*m13 + vec.y*m23 + vec.z*m33 + m43;
-	}
-
-	MashVector2 MashMatrix4::TransformVector(const MashVector2 &vector)const
-	{
-		return MashVector2(vector.x*m11 + vector.y*m21 + m41,
-							vector.x*m12 + vector.y*m22 + m42);
-	}
-
-	MashVector3 MashMatrix4::TransformVector(const MashVector3 &vector)const
-	{
-		return MashVector3(vector.x*m11 + vector.y*m21 + vector.z*m31 + m41,
-							vector.x*m12 + vector.y*m22 + vector.z*m32 + m42,
-							vector.x*m13 + vector.y*m23 + vector.z*m33 + m43);
-	}
-
 	MashVector3 MashMatrix4::TransformVectorTranspose(const MashVector3 &vector)const
 	{
 		return MashVector3(vector.x*m11 + vector.y*m12 + vector.z*m13 - m41,
@@ -110,12 +50,6 @@ namespace mash
         m34 = 0.0f;
     }
 
-	MashMatrix4& MashMatrix4::operator*=(MashMatrix4 &matrix)
-	{
-		(*this) = (*this)*matrix;
-		return (*this);
-	}
-
 	MashMatrix4& MashMatrix4::Identity()
 	{
 		m11 = 1.f; m12 = 0.f; m13 = 0.f; m14 = 0.f;
@@ -217,78 +151,6 @@ namespace mash
 		return false;
 	}
 
-	MashMatrix4& MashMatrix4::Invert()
-	{
-	    f32 fDeterminant = (m11 * m22 - m12 * m21) * (m33 * m44 - m34 * m43) -
-							(m11 * m23 - m13 * m21) * (m32 * m44 - m34 * m42) +
-							(m11 * m24 - m14 * m21) * (m32 * m43 - m33 * m42) +
-							(m12 * m23 - m13 * m22) * (m31 * m44 - m34 * m41) -
-							(m12 * m24 - m14 * m22) * (m31 * m43 - m33 * m41) +
-							(m13 * m24 - m14 * m23) * (m31 * m42 - m32 * m41);
-
-		//make sure the determinant is not zero
-		if (fabs(fDeterminant) <= 0.00000001f)
-			return *this;
-
-		fDeterminant = 1.0f / fDeterminant;
-
-		MashMatrix4 newMatrix(false);
-
-		newMatrix.m11 = fDeterminant * (m22 * (m33 * m44 - m34 * m43) +
-				m23 * (m34 * m42 - m32 * m44) +
-				m24 * (m32 * m43 - m33 * m42));
-		newMatrix.m12 = fDeterminant * (m32 * (m13 * m44 - m14 * m43) +
-				m33 * (m14 * m42 - m12 * m44) +
-				m34 * (m12 * m43 - m13 * m42));
-		newMatrix.m13 = fDeterminant * (m42 * (m13 * m24 - m14 * m23) +
-				m43 * (m14 * m22 - m12 * m24) +
-				m44 * (m12 * m23 - m13 * m22));
-		newMatrix.m14 = fDeterminant * (m12 * (m24 * m33 - m23 * m34) +
-				m13 * (m22 * m34 - m24 * m32) +
-				m14 * (m23 * m32 - m22 * m33));
-		newMatrix.m21 = fDeterminant * (m23 * (m31 * m44 - m34 * m41) +
-				m24 * (m33 * m41 - m31 * m43) +
-				m21 * (m34 * m43 - m33 * m44));
-
-		//////////////////////
-		newMatrix.m22 = fDeterminant * (m33 * (m11 * m44 - m14 * m41) +
-				m34 * (m13 * m41 - m11 * m43) +
-				m31 * (m14 * m43 - m13 * m44));
-		newMatrix.m23 = fDeterminant * (m43 * (m11 * m24 - m14 * m21) +
-				m44 * (m13 * m21 - m11 * m23) +
-				m41 * (m14 * m23 - m13 * m24));
-		newMatrix.m24 = fDeterminant * (m13 * (m24 * m31 - m21 * m34) +
-				m14 * (m21 * m33 - m23 * m31) +
-				m11 * (m23 * m34 - m24 * m33));
-		newMatrix.m31 = fDeterminant * (m24 * (m31 * m42 - m32 * m41) +
-				m21 * (m32 * m44 - m34 * m42) +
-				m22 * (m34 * m41 - m31 * m44));
-		newMatrix.m32 = fDeterminant * (m34 * (m11 * m42 - m12 * m41) +
-				m31 * (m12 * m44 - m14 * m42) +
-				m32 * (m14 * m41 - m11 * m44));
-		newMatrix.m33 = fDeterminant * (m44 * (m11 * m22 - m12 * m21) +
-				m41 * (m12 * m24 - m14 * m22) +
-				m42 * (m14 * m21 - m11 * m24));
-		newMatrix.m34 = fDeterminant * (m14 * (m22 * m31 - m21 * m32) +
-				m11 * (m24 * m32 - m22 * m34) +
-				m12 * (m21 * m34 - m24 * m31));
-		newMatrix.m41 = fDeterminant * (m21 * (m33 * m42 - m32 * m43) +
-				m22 * (m31 * m43 - m33 * m41) +
-				m23 * (m32 * m41 - m31 * m42));
-		newMatrix.m42 = fDeterminant * (m31 * (m13 * m42 - m12 * m43) +
-				m32 * (m11 * m43 - m13 * m41) +
-				m33 * (m12 * m41 - m11 * m42));
-		newMatrix.m43 = fDeterminant * (m41 * (m13 * m22 - m12 * m23) +
-				m42 * (m11 * m23 - m13 * m21) +
-				m43 * (m12 * m21 - m11 * m22));
-		newMatrix.m44 = fDeterminant * (m11 * (m22 * m33 - m23 * m32) +
-				m12 * (m23 * m31 - m21 * m33) +
-				m13 * (m21 * m32 - m22 * m31));
-
-		*this = newMatrix;
-		return *this;
-	}
-
 	MashQuaternion MashMatrix4::ToQuaternion()const
 	{
 		MashQuaternion q;
@@ -236,53 +236,6 @@ namespace mash
 		return MashQuaternion(b.w * a, b.x * a, b.y * a, b.z * a);
 	}
 
-	//interploates from a to b as t varies from 0 to 1. Set this to the result
-	MashQuaternion& MashQuaternion::Slerp(const MashQuaternion &a, const MashQuaternion &b, f32 t)
-	{
-		f32 fAngle = a.DotProduct(b);
-
-		MashQuaternion at(a.w, a.x, a.y, a.z);
-		MashQuaternion bt(b.w, b.x, b.y, b.z);
-
-		if (fAngle < 0.0f)
-		{
-			at *= -1.0f;
-			fAngle *= -1.0f;
-		}
-
-		f32 fScale;
-		f32 fInvScale;
-
-		if ((fAngle + 1.0f) > 0.05f)
-		{
-			if ((1.0f - fAngle) >= 0.05f)
-			{
-				f32 fTheta = (f32)acos(fAngle);
-				f32 fInvTheta = 1.0f / (f32)sin(fTheta);
-				fScale = (f32)sin(fTheta * (1.0f - t)) * fInvTheta;
-				fInvScale = (f32)sin(fTheta * t) * fInvTheta;
-			}
-			else
-			{
-				fScale = 1.0f - t;
-				fInvScale = t;
-			}
-		}
-		else
-		{
-			bt.x = -at.y;
-			bt.y = at.x;
-			bt.z = -at.w;
-			bt.w = at.z;
-
-			fScale = (f32)sin(mash::math::Pi() * (0.5f - t));
-			fInvScale = (f32)sin(mash::math::Pi() * t);
-		}
-
-		*this = (at * fScale) + (bt * fInvScale);
-        return *this;
-	}
-
 	MashQuaternion& MashQuaternion::Lerp(const MashQuaternion &a, const MashQuaternion &b, f32 t)
 	{
         const f32 scale = 1.0f - t;
@@ -8,9 +8,142 @@
 #include "MashTriangleCollider.h"
 #include "MashRay.h"
 #include "MashSceneNode.h"
+#include "MashMathSIMD.h"
 
 namespace mash
 {
+	/*
+		Scratch data shared by the whole batch. Ray lists for each level
+		of the scene graph are appended to activeRays and removed once
+		that level has been processed.
+	*/
+	struct sBatchPickData
+	{
+		const MashRay *rays;
+		uint32 typesToTest;
+		sTriPickResult *out;
+
+		MashArray<uint32> activeRays;
+		MashArray<uint32> colliderRayIndices;
+		MashArray<MashRay> colliderRays;
+		MashArray<sTriPickResult> colliderResults;
+	};
+
+	/*
+		Tests up to 4 rays against a box. Bit i of the result is set if
+		rays[rayIndices[i]] hit the box.
+	*/
+	static uint32 RayAABB4(const mash::MashAABB &box, const mash::MashRay *rays, const uint32 *rayIndices, uint32 count, f32 *distanceOut)
+	{
+		f32 origins[12];
+		f32 dirs[12];
+		for(uint32 lane = 0; lane < 4; ++lane)
+		{
+			//unused lanes repeat the last ray
+			const mash::MashRay &ray = rays[rayIndices[(lane < count) ? lane : (count - 1)]];
+			for(uint32 axis = 0; axis < 3; ++axis)
+			{
+				origins[(axis * 4) + lane] = ray.origin.v[axis];
+				dirs[(axis * 4) + lane] = ray.dir.v[axis];
+			}
+		}
+
+		return simd::RayAABB4(box.min.v, box.max.v, origins, dirs, distanceOut) & ((1 << count) - 1);
+	}
+
+	static void GetClosestTrisFromSceneBatch(mash::MashSceneNode *pScene,
+		uint32 firstActiveRay,
+		uint32 activeRayCount,
+		sBatchPickData &data)
+	{
+		const MashTriangleCollider *collider = pScene->GetTriangleCollider();
+		if (collider && (data.typesToTest & pScene->GetNodeType()))
+		{
+			const mash::MashAABB &worldBounds = pScene->GetWorldBoundingBox();
+
+			data.colliderRayIndices.Clear();
+			data.colliderRays.Clear();
+			data.colliderResults.Clear();
+
+			for(uint32 i = 0; i < activeRayCount; i += 4)
+			{
+				const uint32 *rayIndices = &data.activeRays[firstActiveRay + i];
+				const uint32 groupSize = (activeRayCount - i < 4) ? (activeRayCount - i) : 4;
+
+				f32 BBDist[4];
+				const uint32 hits = RayAABB4(worldBounds, data.rays, rayIndices, groupSize, BBDist);
+				for(uint32 lane = 0; lane < groupSize; ++lane)
+				{
+					const uint32 rayIndex = rayIndices[lane];
+
+					//only test rays that may find a closer triangle
+					if ((hits & (1 << lane)) && (BBDist[lane] < data.out[rayIndex].distance))
+					{
+						data.colliderRayIndices.PushBack(rayIndex);
+						data.colliderRays.PushBack(data.rays[rayIndex]);
+						data.colliderResults.PushBack(data.out[rayIndex]);
+					}
+				}
+			}
+
+			if (!data.colliderRays.Empty())
+			{
+				collider->GetClosestTriangles(data.colliderRays.Pointer(), 
+					data.colliderRays.Size(), 
+					pScene->GetWorldTransformState(), 
+					data.colliderResults.Pointer());
+
+				const uint32 testedRayCount = data.colliderRayIndices.Size();
+				for(uint32 i = 0; i < testedRayCount; ++i)
+				{
+					sTriPickResult &result = data.out[data.colliderRayIndices[i]];
+					if (data.colliderResults[i].distance < result.distance)
+					{
+						result = data.colliderResults[i];
+						result.node = pScene;
+					}
+				}
+			}
+		}
+
+		if (pScene->GetChildren().Empty())
+			return;
+
+		//If there is no intersection here than no need to check children
+		const uint32 firstChildRay = data.activeRays.Size();
+		const mash::MashAABB &totalBounds = pScene->GetTotalBoundingBox();
+		for(uint32 i = 0; i < activeRayCount; i += 4)
+		{
+			const uint32 groupSize = (activeRayCount - i < 4) ? (activeRayCount - i) : 4;
+
+			f32 BBDist[4];
+			const uint32 hits = RayAABB4(totalBounds, data.rays, &data.activeRays[firstActiveRay + i], groupSize, BBDist);
+
+			//activeRays may move as rays are added so the index is copied first
+			for(uint32 lane = 0; lane < groupSize; ++lane)
+			{
+				if (hits & (1 << lane))
+				{
+					const uint32 rayIndex = data.activeRays[firstActiveRay + i + lane];
+					data.activeRays.PushBack(rayIndex);
+				}
+			}
+		}
+
+		const uint32 childRayCount = data.activeRays.Size() - firstChildRay;
+		if (childRayCount > 0)
+		{
+			MashList<mash::MashSceneNode*>::ConstIterator iter = pScene->GetChildren().Begin();
+			MashList<mash::MashSceneNode*>::ConstIterator end = pScene->GetChildren().End();
+			for(; iter != end; ++iter)
+			{
+				GetClosestTrisFromSceneBatch((*iter), firstChildRay, childRayCount, data);
+			}
+		}
+
+		data.activeRays.Resize(firstChildRay);
+	}
+
 	bool MashScenePick::GetNodesByBounds(mash::MashSceneNode *pScene,
 			const mash::MashRay &ray,
 			uint32 iTypesToTest,
@@ -190,4 +323,37 @@ namespace mash
 
 		return out.collision;
 	}
+	uint32 MashScenePick::GetClosestTrisFromScene(mash::MashSceneNode *pScene,
+		const mash::MashRay *rays,
+		uint32 rayCount,
+		uint32 iTypesToTest,
+		bool bBackFaceCull,
+		sTriPickResult *out)
+	{
+		for(uint32 i = 0; i < rayCount; ++i)
+			out[i] = sTriPickResult();
+
+		if (!pScene || (rayCount == 0))
+			return 0;
+
+		sBatchPickData data;
+		data.rays = rays;
+		data.typesToTest = iTypesToTest;
+		data.out = out;
+
+		data.activeRays.Resize(rayCount);
+		for(uint32 i = 0; i < rayCount; ++i)
+			data.activeRays[i] = i;
+
+		GetClosestTrisFromSceneBatch(pScene, 0, rayCount, data);
+
+		uint32 hitCount = 0;
+		for(uint32 i = 0; i < rayCount; ++i)
+		{
+			if (out[i].collision)
+				++hitCount;
+		}
+
+		return hitCount;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,266 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#include "MashStringID.h"
+#include "MashMemory.h"
+#include <cstring>
+
+#ifdef MASH_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+namespace mash
+{
+	/*
+		Global interning table. Strings are copied into large blocks that are
+		never freed so the pointers returned from GetString() stay valid. The
+		table is created on first use and lives for the process, so ids may be
+		created from static initialisers.
+
+		Buckets hold id + 1 so 0 can mark an empty bucket.
+	*/
+	class CMashStringIDTable
+	{
+	private:
+		enum
+		{
+			aSTRING_BLOCK_SIZE = 16384,
+			aMIN_BUCKET_COUNT = 1024
+		};
+
+		struct sString
+		{
+			const int8 *string;
+			uint32 length;
+			uint32 hash;
+		};
+
+		sString *m_strings;
+		uint32 m_stringCount;
+		uint32 m_stringCapacity;
+
+		uint32 *m_buckets;
+		uint32 m_bucketCount;
+
+		int8 *m_block;
+		uint32 m_blockUsed;
+		uint32 m_blockSize;
+
+		static uint32 Hash(const int8 *string, uint32 &lengthOut)
+		{
+			//FNV-1a
+			uint32 hash = 2166136261U;
+			const uint8 *c = (const uint8*)string;
+			for(; *c; ++c)
+			{
+				hash ^= *c;
+				hash *= 16777619U;
+			}
+
+			lengthOut = (uint32)(c - (const uint8*)string);
+			return hash;
+		}
+
+		int8* CopyString(const int8 *string, uint32 length)
+		{
+			const uint32 bytes = length + 1;
+			if (!m_block || (m_blockUsed + bytes > m_blockSize))
+			{
+				//old blocks are intentionally leaked, they are still referenced by m_strings
+				m_blockSize = (bytes > aSTRING_BLOCK_SIZE) ? bytes : (uint32)aSTRING_BLOCK_SIZE;
+				m_block = (int8*)MASH_ALLOC_COMMON(m_blockSize);
+				m_blockUsed = 0;
+			}
+
+			int8 *out = m_block + m_blockUsed;
+			memcpy(out, string, bytes);
+			m_blockUsed += bytes;
+
+			return out;
+		}
+
+		void GrowBuckets()
+		{
+			const uint32 newCount = (m_bucketCount > 0) ? m_bucketCount * 2 : (uint32)aMIN_BUCKET_COUNT;
+			uint32 *newBuckets = (uint32*)MASH_ALLOC_COMMON(sizeof(uint32) * newCount);
+			memset(newBuckets, 0, sizeof(uint32) * newCount);
+
+			//id 0 is the empty string and is never stored in a bucket
+			for(uint32 id = 1; id < m_stringCount; ++id)
+			{
+				uint32 slot = m_strings[id].hash & (newCount - 1);
+				while(newBuckets[slot] != 0)
+					slot = (slot + 1) & (newCount - 1);
+
+				newBuckets[slot] = id + 1;
+			}
+
+			if (m_buckets)
+				MASH_FREE(m_buckets);
+
+			m_buckets = newBuckets;
+			m_bucketCount = newCount;
+		}
+
+		bool FindInternal(const int8 *string, uint32 length, uint32 hash, uint32 &idOut)const
+		{
+			uint32 slot = hash & (m_bucketCount - 1);
+			while(m_buckets[slot] != 0)
+			{
+				const sString &s = m_strings[m_buckets[slot] - 1];
+				if ((s.hash == hash) && (s.length == length) && (memcmp(s.string, string, length) == 0))
+				{
+					idOut = m_buckets[slot] - 1;
+					return true;
+				}
+
+				slot = (slot + 1) & (m_bucketCount - 1);
+			}
+
+			return false;
+		}
+
+#ifdef MASH_WINDOWS
+		CRITICAL_SECTION m_lock;
+		void Lock(){EnterCriticalSection(&m_lock);}
+		void Unlock(){LeaveCriticalSection(&m_lock);}
+#else
+		pthread_mutex_t m_lock;
+		void Lock(){pthread_mutex_lock(&m_lock);}
+		void Unlock(){pthread_mutex_unlock(&m_lock);}
+#endif
+	public:
+		CMashStringIDTable():m_strings(0), m_stringCount(0), m_stringCapacity(0),
+			m_buckets(0), m_bucketCount(0), m_block(0), m_blockUsed(0), m_blockSize(0)
+		{
+#ifdef MASH_WINDOWS
+			InitializeCriticalSection(&m_lock);
+#else
+			pthread_mutex_init(&m_lock, 0);
+#endif
+			GrowBuckets();
+
+			//id 0 is always the empty string
+			m_stringCapacity = aMIN_BUCKET_COUNT;
+			m_strings = (sString*)MASH_ALLOC_COMMON(sizeof(sString) * m_stringCapacity);
+			m_strings[0].string = "";
+			m_strings[0].length = 0;
+			m_strings[0].hash = 0;
+			m_stringCount = 1;
+		}
+
+		uint32 Intern(const int8 *string)
+		{
+			if (!string || (string[0] == 0))
+				return 0;
+
+			uint32 length = 0;
+			const uint32 hash = Hash(string, length);
+
+			Lock();
+
+			uint32 id = 0;
+			if (!FindInternal(string, length, hash, id))
+			{
+				if (m_stringCount == m_stringCapacity)
+				{
+					sString *newStrings = (sString*)MASH_ALLOC_COMMON(sizeof(sString) * m_stringCapacity * 2);
+					memcpy(newStrings, m_strings, sizeof(sString) * m_stringCount);
+					MASH_FREE(m_strings);
+					m_strings = newStrings;
+					m_stringCapacity *= 2;
+				}
+
+				id = m_stringCount++;
+				m_strings[id].string = CopyString(string, length);
+				m_strings[id].length = length;
+				m_strings[id].hash = hash;
+
+				//keep the load factor under 0.5
+				if (m_stringCount * 2 > m_bucketCount)
+				{
+					GrowBuckets();
+				}
+				else
+				{
+					uint32 slot = hash & (m_bucketCount - 1);
+					while(m_buckets[slot] != 0)
+						slot = (slot + 1) & (m_bucketCount - 1);
+
+					m_buckets[slot] = id + 1;
+				}
+			}
+
+			Unlock();
+
+			return id;
+		}
+
+		bool Find(const int8 *string, uint32 &idOut)
+		{
+			if (!string || (string[0] == 0))
+			{
+				idOut = 0;
+				return true;
+			}
+
+			uint32 length = 0;
+			const uint32 hash = Hash(string, length);
+
+			Lock();
+			const bool found = FindInternal(string, length, hash, idOut);
+			Unlock();
+
+			return found;
+		}
+
+		const int8* GetString(uint32 id)
+		{
+			Lock();
+			const int8 *string = (id < m_stringCount) ? m_strings[id].string : "";
+			Unlock();
+
+			return string;
+		}
+	};
+
+	static CMashStringIDTable* GetStringIDTable()
+	{
+		/*
+			Created on first use so ids can be built during static initialisation.
+			Never destroyed as ids may be used until the process exits.
+		*/
+		static CMashStringIDTable *table = MASH_NEW_T_COMMON(CMashStringIDTable)();
+		return table;
+	}
+
+	MashStringID::MashStringID(const int8 *string):m_id(GetStringIDTable()->Intern(string))
+	{
+	}
+
+	MashStringID::MashStringID(const MashStringc &string):m_id(GetStringIDTable()->Intern(string.GetCString()))
+	{
+	}
+
+	const int8* MashStringID::GetString()const
+	{
+		if (m_id == 0)
+			return "";
+
+		return GetStringIDTable()->GetString(m_id);
+	}
+
+	bool MashStringID::Find(const int8 *string, MashStringID &out)
+	{
+		uint32 id = 0;
+		if (!GetStringIDTable()->Find(string, id))
+			return false;
+
+		out.m_id = id;
+		return true;
+	}
+}
@@ -0,0 +1,452 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#include "MashTextParser.h"
+#include <cstring>
+#include <cstdlib>
+#include <float.h>
+
+#if defined(MASH_SIMD_SSE) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define MASH_TEXT_PARSER_SSE2
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+namespace mash
+{
+	namespace text
+	{
+		//digits are only added to the mantissa while it is below this so it can't overflow
+		static const uint64 g_maxMantissa = 100000000000000000ULL;
+
+		//powers of 10 that are exact in each type
+		static const f32 g_floatPow10[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+		static const f64 g_doublePow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+			1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+		static inline bool IsDigit(int8 c)
+		{
+			return (uint32)(c - '0') < 10;
+		}
+
+		static inline const int8* SkipToken(const int8 *str)
+		{
+			while((*str != 0) && !IsWhitespace(*str))
+				++str;
+
+			return str;
+		}
+
+#ifdef MASH_TEXT_PARSER_SSE2
+		static inline uint32 FirstBitSet(uint32 value)
+		{
+#ifdef _MSC_VER
+			unsigned long index;
+			_BitScanForward(&index, value);
+			return index;
+#else
+			return __builtin_ctz(value);
+#endif
+		}
+#endif
+
+		const int8* SkipWhitespace(const int8 *str)
+		{
+#ifdef MASH_TEXT_PARSER_SSE2
+			//most separators are a single character so this usually returns before the vector loop
+			while(((size_t)str & 15) != 0)
+			{
+				if (!IsWhitespace(*str))
+					return str;
+
+				++str;
+			}
+
+			/*
+				Aligned loads never cross a page boundary so reading past the
+				null terminator within a block is safe.
+			*/
+			const __m128i space = _mm_set1_epi8(' ');
+			const __m128i newLine = _mm_set1_epi8('\n');
+			const __m128i tab = _mm_set1_epi8('\t');
+			const __m128i carriageReturn = _mm_set1_epi8('\r');
+			while(true)
+			{
+				const __m128i block = _mm_load_si128((const __m128i*)str);
+				const __m128i whitespace = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, space), _mm_cmpeq_epi8(block, newLine)),
+					_mm_or_si128(_mm_cmpeq_epi8(block, tab), _mm_cmpeq_epi8(block, carriageReturn)));
+
+				const uint32 mask = (uint32)_mm_movemask_epi8(whitespace);
+				if (mask != 0xFFFF)
+					return str + FirstBitSet(~mask & 0xFFFF);
+
+				str += 16;
+			}
+#else
+			while(IsWhitespace(*str))
+				++str;
+
+			return str;
+#endif
+		}
+
+		//handles everything the fast path can't round exactly, as well as inf and nan
+		static const int8* ParseFloatSlow(const int8 *str, f32 &out)
+		{
+			int8 *end = 0;
+			out = strtof(str, &end);
+			return end;
+		}
+
+		const int8* ParseFloat(const int8 *str, f32 &out)
+		{
+			const int8 *p = str;
+			const bool negative = (*p == '-');
+			if ((*p == '-') || (*p == '+'))
+				++p;
+
+			uint64 mantissa = 0;
+			int32 exponent = 0;
+			bool truncated = false;
+
+			const int8 *digitStart = p;
+			for(; IsDigit(*p); ++p)
+			{
+				if (mantissa < g_maxMantissa)
+				{
+					mantissa = (mantissa * 10) + (uint32)(*p - '0');
+				}
+				else
+				{
+					++exponent;
+					truncated |= (*p != '0');
+				}
+			}
+
+			uint32 digitCount = (uint32)(p - digitStart);
+			if (*p == '.')
+			{
+				++p;
+				digitStart = p;
+				for(; IsDigit(*p); ++p)
+				{
+					if (mantissa < g_maxMantissa)
+					{
+						mantissa = (mantissa * 10) + (uint32)(*p - '0');
+						--exponent;
+					}
+					else
+					{
+						truncated |= (*p != '0');
+					}
+				}
+
+				digitCount += (uint32)(p - digitStart);
+			}
+
+			if (digitCount == 0)
+				return ParseFloatSlow(str, out);
+
+			//an 'e' without digits isn't part of the number
+			if ((*p == 'e') || (*p == 'E'))
+			{
+				const int8 *e = p + 1;
+				const bool negativeExponent = (*e == '-');
+				if ((*e == '-') || (*e == '+'))
+					++e;
+
+				if (IsDigit(*e))
+				{
+					int32 value = 0;
+					for(; IsDigit(*e); ++e)
+					{
+						if (value < 100000)
+							value = (value * 10) + (*e - '0');
+					}
+
+					exponent += negativeExponent ? -value : value;
+					p = e;
+				}
+			}
+
+			if (!truncated)
+			{
+				if (mantissa == 0)
+				{
+					out = negative ? -0.0f : 0.0f;
+					return p;
+				}
+
+				//both values are exact floats so the result is rounded once
+				if ((mantissa <= (1ULL << 24)) && (exponent >= -10) && (exponent <= 10))
+				{
+					f32 value = (f32)mantissa;
+					if (exponent < 0)
+						value /= g_floatPow10[-exponent];
+					else
+						value *= g_floatPow10[exponent];
+
+					out = negative ? -value : value;
+					return p;
+				}
+
+				if ((mantissa <= (1ULL << 53)) && (exponent >= -22) && (exponent <= 22))
+				{
+					f64 value = (f64)mantissa;
+					if (exponent < 0)
+						value /= g_doublePow10[-exponent];
+					else
+						value *= g_doublePow10[exponent];
+
+					/*
+						value is the correctly rounded double. Rounding it again to a float gives
+						the correctly rounded float unless it landed exactly half way between two
+						floats. Float denormals have fewer bits so are also left to strtof().
+					*/
+					if (value >= (f64)FLT_MIN)
+					{
+						uint64 bits;
+						memcpy(&bits, &value, sizeof(f64));
+						if ((bits & 0x1FFFFFFFULL) != 0x10000000ULL)
+						{
+							out = negative ? -(f32)value : (f32)value;
+							return p;
+						}
+					}
+				}
+			}
+
+			return ParseFloatSlow(str, out);
+		}
+
+		const int8* ParseInt(const int8 *str, int32 &out)
+		{
+			const int8 *p = str;
+			const bool negative = (*p == '-');
+			if ((*p == '-') || (*p == '+'))
+				++p;
+
+			if (!IsDigit(*p))
+				return str;
+
+			uint32 value = 0;
+			for(; IsDigit(*p); ++p)
+				value = (value * 10) + (uint32)(*p - '0');
+
+			out = negative ? (int32)(0U - value) : (int32)value;
+			return p;
+		}
+
+		uint32 ParseFloatArray(const int8 *str, f32 *out, uint32 maxCount)
+		{
+			if (!str || !out)
+				return 0;
+
+			uint32 count = 0;
+			str = SkipWhitespace(str);
+			while((*str != 0) && (count < maxCount))
+			{
+				const int8 *end = ParseFloat(str, out[count]);
+				if (end == str)
+					out[count] = 0.0f;
+
+				++count;
+				//anything left in the token is ignored, like atof()
+				str = SkipWhitespace(SkipToken(end));
+			}
+
+			return count;
+		}
+
+		uint32 ParseIntArray(const int8 *str, int32 *out, uint32 maxCount)
+		{
+			if (!str || !out)
+				return 0;
+
+			uint32 count = 0;
+			str = SkipWhitespace(str);
+			while((*str != 0) && (count < maxCount))
+			{
+				const int8 *end = ParseInt(str, out[count]);
+				if (end == str)
+					out[count] = 0;
+
+				++count;
+				str = SkipWhitespace(SkipToken(end));
+			}
+
+			return count;
+		}
+
+		uint32 ParseBoolArray(const int8 *str, bool *out, uint32 maxCount)
+		{
+			if (!str || !out)
+				return 0;
+
+			uint32 count = 0;
+			str = SkipWhitespace(str);
+			while((*str != 0) && (count < maxCount))
+			{
+				out[count++] = (*str == 't') || (*str == '1');
+				str = SkipWhitespace(SkipToken(str));
+			}
+
+			return count;
+		}
+
+		static bool IsElementName(const int8 *name, uint32 nameLength, const int8 *const *elementNames, uint32 elementNameCount)
+		{
+			for(uint32 i = 0; i < elementNameCount; ++i)
+			{
+				if ((strncmp(elementNames[i], name, nameLength) == 0) && (elementNames[i][nameLength] == 0))
+					return true;
+			}
+
+			return false;
+		}
+
+		//returns one past the end of sequence, or the null terminator if it isn't found
+		static int8* FindEnd(int8 *str, const int8 *sequence)
+		{
+			int8 *found = strstr(str, sequence);
+			if (!found)
+				return str + strlen(str);
+
+			return found + strlen(sequence);
+		}
+
+		uint32 ExtractElementText(int8 *text, const int8 *const *elementNames, uint32 elementNameCount,
+			int8 *documentOut, MashArray<const int8*> &textOut)
+		{
+			textOut.Clear();
+
+			uint32 extractedCount = 0;
+			int8 *in = text;
+			int8 *out = documentOut;
+			while(*in != 0)
+			{
+				//copy everything up to the next tag
+				int8 *tagStart = strchr(in, '<');
+				if (!tagStart)
+					tagStart = in + strlen(in);
+
+				memcpy(out, in, tagStart - in);
+				out += tagStart - in;
+				in = tagStart;
+
+				if (*in == 0)
+					break;
+
+				//comments, cdata, processing instructions and declarations are copied as is
+				int8 *tagEnd = 0;
+				if (strncmp(in, "<!--", 4) == 0)
+				{
+					tagEnd = FindEnd(in + 4, "-->");
+				}
+				else if (strncmp(in, "<![CDATA[", 9) == 0)
+				{
+					tagEnd = FindEnd(in + 9, "]]>");
+				}
+				else if (in[1] == '?')
+				{
+					tagEnd = FindEnd(in + 2, "?>");
+				}
+				else if (in[1] == '!')
+				{
+					//doctype may hold an internal subset in brackets
+					int32 depth = 0;
+					tagEnd = in + 2;
+					for(; *tagEnd != 0; ++tagEnd)
+					{
+						if (*tagEnd == '[')
+							++depth;
+						else if (*tagEnd == ']')
+							--depth;
+						else if ((*tagEnd == '>') && (depth <= 0))
+						{
+							++tagEnd;
+							break;
+						}
+					}
+				}
+
+				if (tagEnd)
+				{
+					memcpy(out, in, tagEnd - in);
+					out += tagEnd - in;
+					in = tagEnd;
+					continue;
+				}
+
+				//start or end tag
+				int8 *p = in + 1;
+				const bool endTag = (*p == '/');
+				if (endTag)
+					++p;
+
+				const int8 *name = p;
+				while((*p != 0) && !IsWhitespace(*p) && (*p != '>') && (*p != '/'))
+					++p;
+
+				const uint32 nameLength = (uint32)(p - name);
+
+				//find the end of the tag, skipping quoted attribute values
+				int8 quote = 0;
+				for(; *p != 0; ++p)
+				{
+					if (quote)
+					{
+						if (*p == quote)
+							quote = 0;
+					}
+					else if ((*p == '"') || (*p == '\''))
+						quote = *p;
+					else if (*p == '>')
+						break;
+				}
+
+				if (*p == 0)
+				{
+					memcpy(out, in, p - in);
+					out += p - in;
+					in = p;
+					break;
+				}
+
+				const bool selfClosing = (p[-1] == '/');
+				++p;
+				memcpy(out, in, p - in);
+				out += p - in;
+				in = p;
+
+				if (!endTag && IsElementName(name, nameLength, elementNames, elementNameCount))
+				{
+					const int8 *elementText = 0;
+					if (!selfClosing)
+					{
+						//only plain text directly followed by the end tag is moved
+						int8 *textEnd = strchr(in, '<');
+						if (textEnd && (textEnd != in) && (textEnd[1] == '/') && !memchr(in, '&', textEnd - in))
+						{
+							elementText = in;
+
+							*out++ = '<';
+							*textEnd = 0;
+							in = textEnd + 1;
+							++extractedCount;
+						}
+					}
+
+					textOut.PushBack(elementText);
+				}
+			}
+
+			*out = 0;
+			return extractedCount;
+		}
+	}
+}
@@ -8,6 +8,7 @@
 #include "MashSceneManager.h"
 #include "MashMeshBuffer.h"
 #include "CMashPrimitiveBatch.h"
+#include "CMashTransientVertexBuffer.h"
 #include "MashHelper.h"
 #include "MashTechniqueInstance.h"
 #include "MashVertexBuffer.h"
@@ -18,19 +19,20 @@
 #include "MashMesh.h"
 #include "MashRectangle2.h"
 #include "MashFileManager.h"
+#include <set>
 
 namespace mash
 {
 	MashVideoIntermediate::MashVideoIntermediate():MashVideo(),
-        m_currentRenderSurface(0),
-		m_FillColour(0.0f, 0.0f, 0.0f, 0.0f), 
-		m_fsMeshBuffer(0), m_FSVertexCount(0), m_renderInfo(0), 
-		m_textureIDCounter(0),  
-		m_viewPort(), m_defaultBlendState(0),
-		m_defaultRasterizerState(0),m_currentRasterizerState(-1),
-		m_currentBlendState(-1), m_pFileManager(0), m_sceneManager(0),
-		m_drawTextureMaterial(0), m_currentDrawCount(0),
-		m_currentFrameTechniqueChangeCount(0), m_dynamicFsMeshBuffer(0), m_lockRasterizerState(false), m_lockBlendState(false),m_drawTextureTransMaterial(0)
+		m_pFileManager(0), m_fsMeshBuffer(0), m_dynamicFsMeshBuffer(0),
+		m_drawTextureMaterial(0), m_drawTextureTransMaterial(0),
+		m_currentRenderSurface(0), m_FillColour(0.0f, 0.0f, 0.0f, 0.0f),
+		m_currentDrawCount(0), m_currentFrameTechniqueChangeCount(0),
+		m_currentFrameConstantBytesUploaded(0), m_currentFrameConstantUploadsSkipped(0),
+		m_FSVertexCount(0), m_renderInfo(0), m_viewPort(),
+		m_textureIDCounter(0), m_defaultBlendState(0), m_defaultRasterizerState(0),
+		m_currentRasterizerState(-1), m_currentBlendState(-1),
+		m_lockRasterizerState(false), m_lockBlendState(false), m_sceneManager(0)
 	{
 	}
 
@@ -61,6 +63,13 @@ namespace mash
 			m_dynamicFsMeshBuffer = 0;
 		}
 
+		std::map<const MashVertex*, MashTransientVertexBuffer*>::iterator transientIter = m_transientVertexBuffers.begin();
+		std::map<const MashVertex*, MashTransientVertexBuffer*>::iterator transientIterEnd = m_transientVertexBuffers.end();
+		for(; transientIter != transientIterEnd; ++transientIter)
+			transientIter->second->Drop();
+
+		m_transientVertexBuffers.clear();
+
 		if (m_skinManager)
 		{
 			m_skinManager->Drop();
@@ -278,8 +287,11 @@ namespace mash
 		*/
 
 		m_renderInfo->SetSkin(0);
+		m_renderInfo->SetSkinPaletteBuffer(0, 0);
 		m_currentDrawCount = 0;
 		m_currentFrameTechniqueChangeCount = 0;
+		m_currentFrameConstantBytesUploaded = 0;
+		m_currentFrameConstantUploadsSkipped = 0;
 
 		return aMASH_OK;
 	}
@@ -343,6 +355,58 @@ namespace mash
 		return LoadTextureFromFile(fileName);
 	}
 
+	MashTransientVertexBuffer* MashVideoIntermediate::GetTransientVertexBuffer(MashVertex *vertexDecl)
+	{
+		if (!vertexDecl)
+			return 0;
+
+		std::map<const MashVertex*, MashTransientVertexBuffer*>::iterator iter = m_transientVertexBuffers.find(vertexDecl);
+		if (iter != m_transientVertexBuffers.end())
+			return iter->second;
+
+		MashTransientVertexBuffer *transientBuffer = MASH_NEW_COMMON CMashTransientVertexBuffer(this, vertexDecl);
+		m_transientVertexBuffers.insert(std::make_pair(vertexDecl, transientBuffer));
+
+		return transientBuffer;
+	}
+
+	void MashVideoIntermediate::LoadTexturesFromFiles(const MashStringc *fileNames, uint32 count)
+	{
+		for(uint32 i = 0; i < count; ++i)
+			LoadTextureFromFile(fileNames[i]);
+	}
+
+	eMASH_STATUS MashVideoIntermediate::GetTextures(const MashStringc *fileNames, uint32 count, MashTexture **out)
+	{
+		if (!fileNames || (count == 0))
+			return aMASH_OK;
+
+		//gather unique file names that aren't already loaded
+		MashArray<MashStringc> filesToLoad;
+		std::set<MashStringc> uniqueNames;
+		for(uint32 i = 0; i < count; ++i)
+		{
+			if (!FindTexture(fileNames[i]) && uniqueNames.insert(fileNames[i]).second)
+				filesToLoad.PushBack(fileNames[i]);
+		}
+
+		if (!filesToLoad.Empty())
+			LoadTexturesFromFiles(filesToLoad.Pointer(), filesToLoad.Size());
+
+		eMASH_STATUS status = aMASH_OK;
+		for(uint32 i = 0; i < count; ++i)
+		{
+			MashTexture *texture = FindTexture(fileNames[i]);
+			if (!texture)
+				status = aMASH_FAILED;
+
+			if (out)
+				out[i] = texture;
+		}
+
+		return status;
+	}
+
 	void MashVideoIntermediate::RemoveAllTexturesFromCache()
 	{
 		std::map<MashStringc, MashTexture*>::const_iterator iter = m_textures.begin();
@@ -406,6 +470,34 @@ namespace mash
 		return DrawVertexList(m_dynamicFsMeshBuffer, m_FSVertexCount, 2, aPRIMITIVE_TRIANGLE_LIST);
 	}
 
+	eMASH_STATUS MashVideoIntermediate::DrawQuadRegion(const mash::MashRectangle2 &region, const mash::MashRectangle2 &texCoords)
+	{
+		//viewport space to clip space
+		const f32 left = (region.left * 2.0f) - 1.0f;
+		const f32 right = (region.right * 2.0f) - 1.0f;
+		const f32 top = 1.0f - (region.top * 2.0f);
+		const f32 bottom = 1.0f - (region.bottom * 2.0f);
+
+		MashVertexPosTex::sMashVertexPosTex quadVerts[6] = {
+			MashVertexPosTex::sMashVertexPosTex(mash::MashVector3(right, top, 1.0f), mash::MashVector2(texCoords.right, texCoords.top)),//tr
+			MashVertexPosTex::sMashVertexPosTex(mash::MashVector3(left, bottom, 1.0f), mash::MashVector2(texCoords.left, texCoords.bottom)),//bl
+			MashVertexPosTex::sMashVertexPosTex(mash::MashVector3(left, top, 1.0f), mash::MashVector2(texCoords.left, texCoords.top)),//tl
+			MashVertexPosTex::sMashVertexPosTex(mash::MashVector3(right, top, 1.0f), mash::MashVector2(texCoords.right, texCoords.top)),//tr
+			MashVertexPosTex::sMashVertexPosTex(mash::MashVector3(right, bottom, 1.0f), mash::MashVector2(texCoords.right, texCoords.bottom)),//br
+			MashVertexPosTex::sMashVertexPosTex(mash::MashVector3(left, bottom, 1.0f), mash::MashVector2(texCoords.left, texCoords.bottom))};//bl
+
+		int8 *data = 0;
+		if (m_dynamicFsMeshBuffer->GetVertexBuffer()->Lock(aLOCK_WRITE_DISCARD, (void**)(&data)) == aMASH_FAILED)
+			return aMASH_FAILED;
+
+		memcpy(data, quadVerts, sizeof(quadVerts));
+
+		if (m_dynamicFsMeshBuffer->GetVertexBuffer()->Unlock() == aMASH_FAILED)
+			return aMASH_FAILED;
+
+		return DrawVertexList(m_dynamicFsMeshBuffer, m_FSVertexCount, 2, aPRIMITIVE_TRIANGLE_LIST);
+	}
+
 	eMASH_STATUS MashVideoIntermediate::DrawTextureClip(mash::MashTexture *pTexture,
 				const mash::MashRectangle2 &screenPos,
 				const mash::MashRectangle2 &clippingArea,
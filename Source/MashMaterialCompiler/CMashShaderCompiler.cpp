@@ -1548,7 +1548,7 @@ namespace mash
 				vertexFunction += " = lightingOutput.specular;\n";
 
 			}
-			else if (lightingType == aLIGHT_TYPE_PIXEL || lightingType == aLIGHT_TYPE_DEFERRED)
+			else if (lightingType == aLIGHT_TYPE_PIXEL || lightingType == aLIGHT_TYPE_CLUSTERED || lightingType == aLIGHT_TYPE_DEFERRED)
 			{
 				//view space position must be passed to pixel shadow for pixel or deferred lighting
 				vertexScriptData.userOutput[vertexOutputSemanticMap[aVERTEX_OUTPUT_VPOS]].passToPixel = true;
@@ -1726,7 +1726,7 @@ namespace mash
 			diffuseName = "userOutput." + pixelScriptData.userOutput[pixelOutputSemanticMap[aPIXEL_OUTPUT_DIFFUSE]].name;
 		}
 
-		if (lightingType == aLIGHT_TYPE_VERTEX || lightingType == aLIGHT_TYPE_PIXEL || lightingType == aLIGHT_TYPE_DEFERRED)
+		if (lightingType == aLIGHT_TYPE_VERTEX || lightingType == aLIGHT_TYPE_PIXEL || lightingType == aLIGHT_TYPE_CLUSTERED || lightingType == aLIGHT_TYPE_DEFERRED)
 		{
 			if (lightingType == aLIGHT_TYPE_VERTEX)
 			{
@@ -1807,7 +1807,8 @@ namespace mash
 					viewNormName = "userOutput." + pixelScriptData.userOutput[pixelOutputSemanticMap[aPIXEL_OUTPUT_VNORM]].name;
 				}
 
-				if (lightingType == aLIGHT_TYPE_PIXEL)
+				//clustered lighting uses the forward rendered light list, the cluster data is available through autos
+				if (lightingType == aLIGHT_TYPE_PIXEL || lightingType == aLIGHT_TYPE_CLUSTERED)
 				{
 					//add forward rendered lighting code
 					pixelScriptData.includes.PushBack(MashShaderString(m_effectIncludes[aEFF_INC_FORWARD_RENDERED_LIGHTING_G].GetCString(), m_stringMemoryPool));
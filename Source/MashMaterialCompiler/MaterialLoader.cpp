@@ -129,6 +129,8 @@ namespace mash
 				mainMaterials.PushBack(&g_shaderCompilerData->g_materials[i]);
 		}
 
+		PreloadTextures(m_pRenderer, g_shaderCompilerData->g_materials, reloadFile);
+
 		//load base materials
 		const unsigned int iMainMaterialCount = mainMaterials.Size();
 		for(unsigned int i = 0; i < iMainMaterialCount; ++i)
@@ -163,6 +165,43 @@ namespace mash
 		return aMASH_OK;
 	}
 
+	void MaterialLoader::PreloadTextures(mash::MashVideo *pRenderer, const MashArray<sMaterial> &materials, bool reloadFile)
+	{
+		/*
+			Loads all textures used by the new materials in one batch so they can be
+			decoded in parallel. Material creation will then find them in the cache.
+		*/
+		MashMaterialManager *pSkinManager = pRenderer->GetMaterialManager();
+		MashArray<MashStringc> textureFiles;
+		const unsigned int iMaterialCount = materials.Size();
+		for(unsigned int i = 0; i < iMaterialCount; ++i)
+		{
+			const sMaterial *pMaterial = &materials[i];
+			if (!reloadFile && pSkinManager->FindMaterial(pMaterial->sMaterialName))
+				continue;
+
+			for(unsigned int iTex = 0; iTex < pMaterial->samplers.Size(); ++iTex)
+			{
+				if (pMaterial->samplers[iTex].sTextureFile)
+					textureFiles.PushBack(pMaterial->samplers[iTex].sTextureFile);
+			}
+
+			for(unsigned int iTechnique = 0; iTechnique < pMaterial->techniques.Size(); ++iTechnique)
+			{
+				const MashArray<sSampler> &techniqueSamplers = pMaterial->techniques[iTechnique].samplers;
+				for(unsigned int iTex = 0; iTex < techniqueSamplers.Size(); ++iTex)
+				{
+					if (techniqueSamplers[iTex].sTextureFile)
+						textureFiles.PushBack(techniqueSamplers[iTex].sTextureFile);
+				}
+			}
+		}
+
+		//any failures are logged again when the material tries to use the texture
+		if (!textureFiles.Empty())
+			pRenderer->GetTextures(textureFiles.Pointer(), textureFiles.Size());
+	}
+
 	eMASH_STATUS MaterialLoader::GetVertex(mash::MashVideo *pRenderer,
 		const MashArray<sVertexElement> &vertexDeclaration, 
 		MashArray<sMashVertexElement> &elmsOut)						
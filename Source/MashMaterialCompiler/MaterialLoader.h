@@ -32,6 +32,8 @@ namespace mash
 
 		MashMaterial* CreateReferenceMaterial(mash::MashVideo *pRenderer, sMaterial *pMaterial, bool reloadFile);
 
+		void PreloadTextures(mash::MashVideo *pRenderer, const MashArray<sMaterial> &materials, bool reloadFile);
+
 		eMASH_STATUS GetVertex(mash::MashVideo *pRenderer,
 			const MashArray<sVertexElement> &vertexDeclaration, 
 			MashArray<sMashVertexElement> &elmsOut);
@@ -0,0 +1,348 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#include "CMashNullEffect.h"
+#include "CMashNullRenderer.h"
+#include "MashMaterialManager.h"
+#include "MashMatrix4.h"
+#include "MashTexture.h"
+#include "MashHelper.h"
+#include "MashLog.h"
+
+namespace mash
+{
+	CMashNullEffect::CMashNullEffect(CMashNullRenderer *renderer):MashEffect(),m_pRenderer(renderer),
+		m_bIsValid(false), m_bIsCompiled(false), m_isAPIEffect(false)
+	{
+		for(uint32 i = 0; i < aPROGRAM_UNKNOWN; ++i)
+			m_programs[i] = 0;
+	}
+
+	CMashNullEffect::~CMashNullEffect()
+	{
+		for(uint32 i = 0; i < aPROGRAM_UNKNOWN; ++i)
+		{
+			if (m_programs[i])
+				m_programs[i]->Drop();
+
+			m_programs[i] = 0;
+		}
+
+		ClearParameters();
+	}
+
+	void CMashNullEffect::ClearParameters()
+	{
+		m_autoParameters.Clear();
+
+		std::map<MashStringc, CMashNullEffectParamHandle*>::iterator iter = m_parameters.begin();
+		std::map<MashStringc, CMashNullEffectParamHandle*>::iterator iterEnd = m_parameters.end();
+		for(; iter != iterEnd; ++iter)
+		{
+			iter->second->Drop();
+		}
+
+		m_parameters.clear();
+	}
+
+	MashEffect* CMashNullEffect::CreateIndependentCopy()
+	{
+		CMashNullEffect *newEffect = (CMashNullEffect*)m_pRenderer->GetMaterialManager()->CreateEffect();
+		newEffect->m_isAPIEffect = m_isAPIEffect;
+
+		for(uint32 i = 0; i < aPROGRAM_UNKNOWN; ++i)
+		{
+			if (m_programs[i])
+			{
+				MashEffectProgram *program = 0;
+				if (m_isAPIEffect)
+					program = newEffect->AddProgramCompiled(m_programs[i]->GetHighLevelSource().GetCString(), m_programs[i]->GetEntry().GetCString(), m_programs[i]->GetProfile(), m_programs[i]->GetFileName().GetCString());
+				else
+					program = newEffect->AddProgram(m_programs[i]->GetFileName().GetCString(), m_programs[i]->GetEntry().GetCString(), m_programs[i]->GetProfile());
+
+				if (program)
+					program->SetCompileArguments(m_programs[i]->GetCompileArguments());
+			}
+		}
+
+		return newEffect;
+	}
+
+	MashEffectProgram* CMashNullEffect::AddProgramCompiled(const int8 *highLevelCode, const int8 *entry, eSHADER_PROFILE profile, const int8 *fileName)
+	{
+		if (!highLevelCode)
+			return 0;
+
+		ePROGRAM_TYPE programType = mash::helpers::GetEffectProgramTypeFromProfile(profile);
+
+		if (programType == aPROGRAM_UNKNOWN)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+				"Unknown profile type used. The program was not added.", 
+				"CMashNullEffect::AddProgramCompiled");
+
+			return 0;
+		}
+
+		m_isAPIEffect = true;
+
+		CMashNullEffectProgram *program = MASH_NEW_COMMON CMashNullEffectProgram(programType,
+			highLevelCode,
+			fileName,
+			entry,
+			profile);
+
+		if (m_programs[programType])
+			m_programs[programType]->Drop();
+
+		m_programs[programType] = program;
+
+		return program;
+	}
+
+	MashEffectProgram* CMashNullEffect::AddProgram(const int8 *fileName, const int8 *entry, eSHADER_PROFILE profile)
+	{
+		if (!fileName)
+			return 0;
+
+		ePROGRAM_TYPE programType = mash::helpers::GetEffectProgramTypeFromProfile(profile);
+
+		if (programType == aPROGRAM_UNKNOWN)
+		{
+			MASH_WRITE_TO_LOG_EX(MashLog::aERROR_LEVEL_ERROR, 
+				"CMashNullEffect::AddProgram",
+				"Unknown profile type used for effect '%s'. The program was not added.",
+				fileName);
+
+			return 0;
+		}
+
+		m_isAPIEffect = mash::helpers::IsFileANativeEffectProgram(fileName);
+
+		CMashNullEffectProgram *program = MASH_NEW_COMMON CMashNullEffectProgram(programType,
+			0,
+			fileName,
+			entry,
+			profile);
+
+		if (m_programs[programType])
+			m_programs[programType]->Drop();
+
+		m_programs[programType] = program;
+
+		return program;
+	}
+
+	eMASH_STATUS CMashNullEffect::_Compile(MashFileManager *fileManager, 
+		const MashMaterialManager *skinManager, 
+		const sEffectCompileArgs &compileArgs)
+	{
+		m_bIsCompiled = true;
+		m_bIsValid = true;
+
+		if (!m_isAPIEffect)
+		{
+			if (((MashMaterialManager*)skinManager)->BuildRunTimeEffect(this, compileArgs) == aMASH_FAILED)
+			{
+				MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+					"Failed to compile effect into native format.", 
+					"CMashNullEffect::_Compile");
+
+				return aMASH_FAILED;
+			}
+		}
+
+		ClearParameters();
+
+		for(uint32 i = 0; i < aPROGRAM_UNKNOWN; ++i)
+		{
+			if (m_programs[i])
+			{
+				bool isValid = false;
+				if (m_programs[i]->_Compile(fileManager, skinManager, compileArgs.macros, compileArgs.macroCount, isValid) == aMASH_FAILED)
+				{
+					m_bIsCompiled = false;
+					m_bIsValid = false;
+				}
+
+				if (!isValid)
+					m_bIsValid = false;
+			}
+		}
+
+		if (!m_bIsCompiled)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+				"Failed to compile effect.", 
+				"CMashNullEffect::_Compile");
+
+			return aMASH_FAILED;
+		}
+
+		if (!m_bIsValid)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_INFORMATION, 
+				"Effect is not valid on the current system.", 
+				"CMashNullEffect::_Compile");
+
+			return aMASH_OK;
+		}
+
+		/*
+			Parameters are shared between programs, the same as a linked GLSL program.
+		*/
+		int8 newParamName[256];
+		uint32 semanticType = 0;
+		uint32 semanticIndex = 0;
+		uint32 textureCounter = 0;
+		bool isStructParam = false;
+		for(uint32 i = 0; i < aPROGRAM_UNKNOWN; ++i)
+		{
+			if (!m_programs[i])
+				continue;
+
+			const MashArray<CMashNullEffectProgram::sUniform> &uniforms = m_programs[i]->GetUniforms();
+			const uint32 uniformCount = uniforms.Size();
+			for(uint32 u = 0; u < uniformCount; ++u)
+			{
+				const MashStringc &paramName = uniforms[u].name;
+				if (m_parameters.find(paramName) != m_parameters.end())
+					continue;
+
+				uint32 effectTextureIndex = 0;
+				if (uniforms[u].isTexture)
+					effectTextureIndex = textureCounter++;
+
+				CMashNullEffectParamHandle *newParam = MASH_NEW_COMMON CMashNullEffectParamHandle(uniforms[u].isTexture, effectTextureIndex);
+				m_parameters[paramName] = newParam;
+
+				isStructParam = false;
+				newParamName[0] = 0;
+				mash::helpers::GetAutoEffectParameterName(paramName.GetCString(), newParamName, semanticIndex, isStructParam);
+				if (m_pRenderer->GetMaterialManager()->IsAutoParameter(newParamName, semanticType))
+				{
+					//per object data changes nearly every draw so tracking it would only add a compare
+					newParam->_SetChangeTracking(m_pRenderer->GetMaterialManager()->GetAutoParameterUpdateRate(semanticType) != aAUTO_PARAM_UPDATE_PER_OBJECT);
+					m_autoParameters.PushBack(sAutoParameter(newParam, semanticType, semanticIndex));
+				}
+			}
+		}
+
+		return aMASH_OK;
+	}
+
+	void CMashNullEffect::RecordParameter(MashEffectParamHandle *pHandle, const void *data, uint32 sizeInBytes, uint32 count)
+	{
+		if (!pHandle)
+			return;
+
+		//redundant uploads are filtered the same as the hardware renderers
+		if (!m_pRenderer->_OnConstantDataChange(pHandle, data, sizeInBytes))
+			return;
+
+		m_pRenderer->_RecordCommand(aNULL_CMD_SET_PARAMETER, pHandle, sizeInBytes, count);
+	}
+
+	void CMashNullEffect::SetMatrix(MashEffectParamHandle *pHandle, const mash::MashMatrix4 *data, uint32 count)
+	{
+		RecordParameter(pHandle, data, sizeof(mash::MashMatrix4) * count, count);
+	}
+
+	void CMashNullEffect::SetInt(MashEffectParamHandle *pHandle, const int32 *data, uint32 count)
+	{
+		RecordParameter(pHandle, data, sizeof(int32) * count, count);
+	}
+
+	void CMashNullEffect::SetBool(MashEffectParamHandle *pHandle, const bool *data, uint32 count)
+	{
+		RecordParameter(pHandle, data, sizeof(bool) * count, count);
+	}
+
+	void CMashNullEffect::SetFloat(MashEffectParamHandle *pHandle, const f32 *data, uint32 count)
+	{
+		RecordParameter(pHandle, data, sizeof(f32) * count, count);
+	}
+
+	void CMashNullEffect::SetVector2(MashEffectParamHandle *pHandle, const mash::MashVector2 *data, uint32 count)
+	{
+		RecordParameter(pHandle, data, sizeof(mash::MashVector2) * count, count);
+	}
+
+	void CMashNullEffect::SetVector3(MashEffectParamHandle *pHandle, const mash::MashVector3 *data, uint32 count)
+	{
+		RecordParameter(pHandle, data, sizeof(mash::MashVector3) * count, count);
+	}
+
+	void CMashNullEffect::SetVector4(MashEffectParamHandle *pHandle, const mash::MashVector4 *data, uint32 count)
+	{
+		RecordParameter(pHandle, data, sizeof(mash::MashVector4) * count, count);
+	}
+
+	void CMashNullEffect::SetValue(MashEffectParamHandle *pHandle, const void *pData, uint32 iSizeInBytes)
+	{
+		RecordParameter(pHandle, pData, iSizeInBytes, 1);
+	}
+
+	eMASH_STATUS CMashNullEffect::SetTexture(MashEffectParamHandle *pHandle, MashTexture *pTexture, const MashTextureState *pTextureState)
+	{
+		if (!pTexture)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_WARNING, 
+				"No texture pointer given.", 
+				"CMashNullEffect::SetTexture");
+
+			return aMASH_OK;
+		}
+
+		const eRESOURCE_TYPE resType = pTexture->GetType();
+		if ((resType != aRESOURCE_TEXTURE) && (resType != aRESOURCE_CUBE_TEXTURE))
+		{
+			//should never happen
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+				"Invalid texture resource.", 
+				"CMashNullEffect::SetTexture");
+
+			return aMASH_FAILED;
+		}
+
+		uint32 textureIndex = 0;
+		if (pHandle)
+			textureIndex = ((CMashNullEffectParamHandle*)pHandle)->GetEffectTextureIndex();
+
+		m_pRenderer->_RecordCommand(aNULL_CMD_SET_TEXTURE, pTexture, pTexture->GetTextureID(), textureIndex);
+
+		return aMASH_OK;
+	}
+
+	MashEffectParamHandle* CMashNullEffect::GetParameterByName(const int8 *sName, ePROGRAM_TYPE type)
+	{
+		std::map<MashStringc, CMashNullEffectParamHandle*>::iterator iter = m_parameters.find(sName);
+		if (iter != m_parameters.end())
+			return iter->second;
+
+		return 0;
+	}
+
+	void CMashNullEffect::_OnUnload(MashMaterialManager *skinManager, const MashRenderInfo *renderInfo)
+	{
+	}
+
+	void CMashNullEffect::_OnLoad(MashMaterialManager *pSkinManager, const MashRenderInfo *pRenderInfo)
+	{
+		if (!m_bIsValid)
+			return;
+
+		m_pRenderer->_RecordCommand(aNULL_CMD_SET_EFFECT, this);
+	}
+
+	void CMashNullEffect::_OnUpdate(MashMaterialManager *pSkinManager, const MashRenderInfo *pRenderInfo)
+	{
+		const uint32 iAutoParameterCount = m_autoParameters.Size();
+		for(uint32 i = 0; i < iAutoParameterCount; ++i)
+		{
+			pSkinManager->_SetProgramAutoParameter(this, m_autoParameters[i].pParameter, m_autoParameters[i].type, m_autoParameters[i].iIndex);
+		}
+	}
+}
@@ -0,0 +1,103 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#ifndef _C_MASH_NULL_EFFECT_H_
+#define _C_MASH_NULL_EFFECT_H_
+
+#include "MashEffect.h"
+#include "CMashNullEffectProgram.h"
+#include <map>
+#include "MashArray.h"
+namespace mash
+{
+	class CMashNullRenderer;
+
+	class CMashNullEffectParamHandle : public MashEffectParamHandle
+	{
+	private:
+		bool m_isTexture;
+		uint32 m_effectTextureIndex;
+	public:
+		CMashNullEffectParamHandle(bool isTexture, uint32 effectTextureIndex):MashEffectParamHandle(),
+			m_isTexture(isTexture), m_effectTextureIndex(effectTextureIndex){}
+		~CMashNullEffectParamHandle(){}
+
+		bool IsTexture()const{return m_isTexture;}
+		uint32 GetEffectTextureIndex()const{return m_effectTextureIndex;}
+	};
+
+	class CMashNullEffect : public MashEffect
+	{
+	private:
+		struct sAutoParameter
+		{
+			MashEffectParamHandle *pParameter;
+			uint32 type;
+			uint32 iIndex;
+
+			sAutoParameter():pParameter(0), type(0), iIndex(0){}
+			sAutoParameter(MashEffectParamHandle *_pParameter, uint32 _type, uint32 _iIndex):pParameter(_pParameter), type(_type), iIndex(_iIndex){}
+		};
+
+		CMashNullRenderer *m_pRenderer;
+		MashArray<sAutoParameter> m_autoParameters;
+		std::map<MashStringc, CMashNullEffectParamHandle*> m_parameters;
+		CMashNullEffectProgram *m_programs[aPROGRAM_UNKNOWN];
+		bool m_bIsValid;
+		bool m_bIsCompiled;
+		bool m_isAPIEffect;
+
+		void ClearParameters();
+		void RecordParameter(MashEffectParamHandle *pHandle, const void *data, uint32 sizeInBytes, uint32 count);
+	public:
+		CMashNullEffect(CMashNullRenderer *renderer);
+
+		~CMashNullEffect();
+
+		MashEffect* CreateIndependentCopy();
+
+		void SetMatrix(MashEffectParamHandle *pHandle, const mash::MashMatrix4 *data, uint32 count = 1);
+		void SetInt(MashEffectParamHandle *pHandle, const int32 *data, uint32 count = 1);
+		void SetBool(MashEffectParamHandle *pHandle, const bool *data, uint32 count = 1);
+		void SetFloat(MashEffectParamHandle *pHandle, const f32 *data, uint32 count = 1);
+		void SetVector2(MashEffectParamHandle *pHandle, const mash::MashVector2 *data, uint32 count = 1);
+		void SetVector3(MashEffectParamHandle *pHandle, const mash::MashVector3 *data, uint32 count = 1);
+		void SetVector4(MashEffectParamHandle *pHandle, const mash::MashVector4 *data, uint32 count = 1);
+		void SetValue(MashEffectParamHandle *pHandle, const void *pData, uint32 iSizeInBytes);
+
+		//doesnt pay any attention to program type
+		MashEffectParamHandle* GetParameterByName(const int8 *sName, ePROGRAM_TYPE type);
+
+		bool IsValid()const;
+		bool IsCompiled()const;
+		eMASH_STATUS _Compile(MashFileManager *fileManager, const MashMaterialManager *skinManager, const sEffectCompileArgs &compileArgs);
+		void _OnLoad(MashMaterialManager *pSkinManager, const MashRenderInfo *pRenderInfo);
+		void _OnUpdate(MashMaterialManager *pSkinManager, const MashRenderInfo *pRenderInfo);
+		void _OnUnload(MashMaterialManager *skinManager, const MashRenderInfo *renderInfo);
+
+		MashEffectProgram* AddProgramCompiled(const int8 *highLevelCode, const int8 *entry, eSHADER_PROFILE profile, const int8 *fileName = 0);
+		MashEffectProgram* AddProgram(const int8 *sFileName, const int8 *sntry, eSHADER_PROFILE profile);
+		MashEffectProgram* GetProgramByType(ePROGRAM_TYPE type)const;
+
+		eMASH_STATUS SetTexture(MashEffectParamHandle *pHandle, MashTexture *pTexture, const MashTextureState *pTextureState);
+	};
+
+	inline MashEffectProgram* CMashNullEffect::GetProgramByType(ePROGRAM_TYPE type)const
+	{
+		return m_programs[type];
+	}
+
+	inline bool CMashNullEffect::IsValid()const
+	{
+		return m_bIsValid;
+	}
+
+	inline bool CMashNullEffect::IsCompiled()const
+	{
+		return m_bIsCompiled;
+	}
+}
+
+#endif
@@ -0,0 +1,161 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#include "CMashNullEffectProgram.h"
+#include "MashMaterialManager.h"
+#include "MashFileStream.h"
+#include "MashLog.h"
+#include <cstring>
+
+namespace mash
+{
+	static bool IsIdentifierChar(int8 c)
+	{
+		return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) || ((c >= '0') && (c <= '9')) || (c == '_');
+	}
+
+	static bool IsWhiteSpace(int8 c)
+	{
+		return (c == ' ') || (c == '\t') || (c == '\n') || (c == '\r');
+	}
+
+	static const int8* ReadIdentifier(const int8 *c, MashStringc &out)
+	{
+		while(*c && IsWhiteSpace(*c))
+			++c;
+
+		const int8 *start = c;
+		while(*c && IsIdentifierChar(*c))
+			++c;
+
+		out.Clear();
+		if (c != start)
+			out.Append(start, c - start);
+
+		return c;
+	}
+
+	CMashNullEffectProgram::CMashNullEffectProgram(ePROGRAM_TYPE programType,
+			const int8 *compiledCode,
+			const int8 *fileName, 
+			const int8 *entry, 
+			eSHADER_PROFILE profile):MashEffectProgramIntermediate(programType, compiledCode, fileName, entry, profile)
+	{
+	}
+
+	CMashNullEffectProgram::~CMashNullEffectProgram()
+	{
+	}
+
+	void CMashNullEffectProgram::ReadUniforms(const int8 *source)
+	{
+		/*
+			There is no API to reflect parameters from so the GLSL source is
+			searched for declarations of the form :
+				uniform <type> <name>;
+				uniform <type> <name>[count];
+				layout(...) uniform <blockName> { ... };
+		*/
+		static const int8 *uniformKeyword = "uniform";
+		static const uint32 uniformKeywordLength = 7;
+
+		m_uniforms.Clear();
+
+		MashStringc typeName;
+		MashStringc paramName;
+		const int8 *c = source;
+		while((c = strstr(c, uniformKeyword)) != 0)
+		{
+			const bool isWordStart = (c == source) || !IsIdentifierChar(*(c - 1));
+			c += uniformKeywordLength;
+			if (!isWordStart || !IsWhiteSpace(*c))
+				continue;
+
+			c = ReadIdentifier(c, typeName);
+			if (typeName.Empty())
+				continue;
+
+			while(*c && IsWhiteSpace(*c))
+				++c;
+
+			sUniform newUniform;
+			newUniform.isTexture = false;
+			if (*c == '{')
+			{
+				//uniform block
+				newUniform.name = typeName;
+			}
+			else
+			{
+				c = ReadIdentifier(c, paramName);
+				if (paramName.Empty())
+					continue;
+
+				newUniform.name = paramName;
+				newUniform.isTexture = (strncmp(typeName.GetCString(), "sampler", 7) == 0);
+			}
+
+			m_uniforms.PushBack(newUniform);
+		}
+	}
+
+	eMASH_STATUS CMashNullEffectProgram::_Compile(MashFileManager *pFileManager, 
+		const MashMaterialManager *pSkinManager, 
+		const sEffectMacro *customMacros, 
+		uint32 customMacroCount,
+		bool &isValid)
+	{
+		isValid = false;
+
+		if (!pSkinManager->IsProfileSupported(m_profile))
+		{            
+            MASH_WRITE_TO_LOG_EX(MashLog::aERROR_LEVEL_WARNING, 
+                                "CMashNullEffectProgram::_Compile",
+                                "Shader profile not supported on the current system for effect '%s'.",
+                                m_fileName.GetCString());
+            
+			return aMASH_OK; //no error
+		}
+
+		if (m_compiledShader.Empty() && !m_fileName.Empty())
+		{
+			MashFileStream *pFileStream = pFileManager->CreateFileStream();
+			if (pFileStream->LoadFile(m_fileName.GetCString(), aFILE_IO_TEXT) == aMASH_FAILED)
+			{
+				MASH_WRITE_TO_LOG_EX(MashLog::aERROR_LEVEL_ERROR, 
+                                    "CMashNullEffectProgram::_Compile",
+                                    "Failed to read program source '%s'.",
+                                    m_fileName.GetCString());
+				pFileStream->Destroy();
+				return aMASH_FAILED;
+			}
+
+			if (pFileStream->GetDataSizeInBytes() > 0)
+				m_compiledShader = (const int8*)pFileStream->GetData();
+
+			pFileStream->Destroy();
+            
+            m_compiledFileName = m_fileName;
+		}
+
+		if (m_compiledShader.Empty())
+		{
+            MASH_WRITE_TO_LOG_EX(MashLog::aERROR_LEVEL_ERROR, 
+                                "CMashNullEffectProgram::_Compile",
+                                "No program source set for effect '%s'.",
+                                m_fileName.GetCString());
+            
+			return aMASH_FAILED;
+		}
+
+		ReadUniforms(m_compiledShader.GetCString());
+
+        m_compiledFileName.FreeMemory();
+        m_compiledShader.FreeMemory();
+
+		isValid = true;
+		return aMASH_OK;
+	}
+}
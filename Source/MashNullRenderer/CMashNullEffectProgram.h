@@ -0,0 +1,56 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#ifndef _C_MASH_NULL_EFFECT_PROGRAM_H_
+#define _C_MASH_NULL_EFFECT_PROGRAM_H_
+
+#include "MashEffectProgramIntermediate.h"
+#include "MashFileManager.h"
+
+namespace mash
+{
+	class MashMaterialManager;
+
+	class CMashNullEffectProgram : public MashEffectProgramIntermediate
+	{
+	public:
+		struct sUniform
+		{
+			MashStringc name;
+			bool isTexture;
+		};
+	private:
+		MashArray<sUniform> m_uniforms;
+
+		void ReadUniforms(const int8 *source);
+	public:
+		CMashNullEffectProgram(ePROGRAM_TYPE programType,
+			const int8 *compiledCode,
+			const int8 *fileName, 
+			const int8 *entry, 
+			eSHADER_PROFILE profile);
+
+		~CMashNullEffectProgram();
+
+		eMASH_STATUS _Compile(MashFileManager *pFileManager, 
+			const MashMaterialManager *pSkinManager, 
+			const sEffectMacro *customMacros, 
+			uint32 customMacroCount,
+			bool &isValid);
+
+		/*
+			Uniforms and uniform blocks declared in the source
+			of the last successful compile.
+		*/
+		const MashArray<sUniform>& GetUniforms()const;
+	};
+
+	inline const MashArray<CMashNullEffectProgram::sUniform>& CMashNullEffectProgram::GetUniforms()const
+	{
+		return m_uniforms;
+	}
+}
+
+#endif
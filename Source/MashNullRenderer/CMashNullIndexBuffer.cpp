@@ -0,0 +1,116 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#include "CMashNullIndexBuffer.h"
+#include "CMashNullRenderer.h"
+#include "MashLog.h"
+#include <cstring>
+
+namespace mash
+{
+	CMashNullIndexBuffer::CMashNullIndexBuffer(CMashNullRenderer *pRenderer,
+			const void *data,
+			eUSAGE usage,
+			eFORMAT format,
+			uint32 size):MashIndexBuffer(),m_pRenderer(pRenderer),
+			m_data(0), m_usage(usage), m_format(format), m_size(size), m_lockType(aLOCK_WRITE), m_isLocked(false)
+	{
+		if (m_size > 0)
+		{
+			m_data = MASH_ALLOC_T_COMMON(uint8, m_size);
+
+			if (data)
+				memcpy(m_data, data, m_size);
+			else
+				memset(m_data, 0, m_size);
+		}
+	}
+
+	CMashNullIndexBuffer::~CMashNullIndexBuffer()
+	{
+		if (m_data)
+		{
+			MASH_FREE(m_data);
+			m_data = 0;
+		}
+	}
+
+	eMASH_STATUS CMashNullIndexBuffer::Resize(uint32 newSize, bool saveData)
+	{
+		uint8 *newData = 0;
+		if (newSize > 0)
+		{
+			newData = MASH_ALLOC_T_COMMON(uint8, newSize);
+			memset(newData, 0, newSize);
+
+			if (saveData && m_data)
+				memcpy(newData, m_data, (m_size > newSize)?newSize:m_size);
+		}
+
+		if (m_data)
+			MASH_FREE(m_data);
+
+		m_data = newData;
+		m_size = newSize;
+
+		m_pRenderer->_RecordCommand(aNULL_CMD_UPDATE_BUFFER, this, m_size, aLOCK_WRITE_DISCARD);
+
+		return aMASH_OK;
+	}
+
+	eMASH_STATUS CMashNullIndexBuffer::Copy(const MashIndexBuffer *from)
+	{
+		const CMashNullIndexBuffer *nullFromBuffer = (const CMashNullIndexBuffer*)from;
+		const uint32 amountToWrite = (m_size > nullFromBuffer->GetBufferSize())?nullFromBuffer->GetBufferSize():m_size;
+
+		if (amountToWrite > 0)
+			memcpy(m_data, nullFromBuffer->GetData(), amountToWrite);
+
+		m_pRenderer->_RecordCommand(aNULL_CMD_UPDATE_BUFFER, this, amountToWrite, aLOCK_WRITE);
+
+		return aMASH_OK;
+	}
+
+	MashIndexBuffer* CMashNullIndexBuffer::Clone()const
+	{
+		const uint32 indexSize = (m_format == aFORMAT_R16_UINT)?sizeof(int16):sizeof(int32);
+		return m_pRenderer->CreateIndexBuffer(m_data, m_size / indexSize, m_usage, m_format);
+	}
+
+	eMASH_STATUS CMashNullIndexBuffer::Lock(eBUFFER_LOCK eType, void **pData)const
+	{
+		if (m_isLocked)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+				"Index buffer is already locked.", 
+				"CMashNullIndexBuffer::Lock");
+
+			return aMASH_FAILED;
+		}
+
+		m_isLocked = true;
+		m_lockType = eType;
+		*pData = m_data;
+
+		return aMASH_OK;
+	}
+
+	eMASH_STATUS CMashNullIndexBuffer::Unlock()const
+	{
+		if (!m_isLocked)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+				"Failed to unmap index buffer. The buffer was not locked.", 
+				"CMashNullIndexBuffer::Unlock");
+
+			return aMASH_FAILED;
+		}
+
+		m_isLocked = false;
+		m_pRenderer->_RecordCommand(aNULL_CMD_UPDATE_BUFFER, this, m_size, m_lockType);
+
+		return aMASH_OK;
+	}
+}
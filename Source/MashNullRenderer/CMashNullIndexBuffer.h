@@ -0,0 +1,76 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#ifndef _C_MASH_NULL_INDEX_BUFFER_H_
+#define _C_MASH_NULL_INDEX_BUFFER_H_
+
+#include "MashIndexBuffer.h"
+namespace mash
+{
+	class CMashNullRenderer;
+
+	/*
+		Index data is held in system memory. Locks return a pointer
+		directly into this memory and unlocks are recorded as buffer updates.
+	*/
+	class CMashNullIndexBuffer : public MashIndexBuffer
+	{
+	private:
+		CMashNullRenderer *m_pRenderer;
+		uint8 *m_data;
+		eUSAGE m_usage;
+		eFORMAT m_format;
+		uint32 m_size;
+		mutable eBUFFER_LOCK m_lockType;
+		mutable bool m_isLocked;
+	public:
+		CMashNullIndexBuffer(CMashNullRenderer *pRenderer,
+			const void *data,
+			eUSAGE usage,
+			eFORMAT format,
+			uint32 size);
+
+		~CMashNullIndexBuffer();
+
+		eMASH_STATUS Copy(const MashIndexBuffer *from);
+		MashIndexBuffer* Clone()const;
+
+		eMASH_STATUS Resize(uint32 newSize, bool saveData = false);
+		uint32 GetBufferSize()const;
+		eMASH_STATUS Lock(eBUFFER_LOCK eType, void **pData)const;
+		eMASH_STATUS Unlock()const;
+		eRESOURCE_TYPE GetType()const;
+		eFORMAT GetFormat()const;
+		eUSAGE GetUsageType()const;
+		const uint8* GetData()const;
+	};
+
+	inline uint32 CMashNullIndexBuffer::GetBufferSize()const
+	{
+		return m_size;
+	}
+
+	inline const uint8* CMashNullIndexBuffer::GetData()const
+	{
+		return m_data;
+	}
+
+	inline eUSAGE CMashNullIndexBuffer::GetUsageType()const
+	{
+		return m_usage;
+	}
+
+	inline eFORMAT CMashNullIndexBuffer::GetFormat()const
+	{
+		return m_format;
+	}
+
+	inline eRESOURCE_TYPE CMashNullIndexBuffer::GetType()const
+	{
+		return aRESOURCE_INDEX;
+	}
+}
+
+#endif
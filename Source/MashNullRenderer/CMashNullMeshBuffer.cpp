@@ -0,0 +1,14 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#include "CMashNullMeshBuffer.h"
+
+namespace mash
+{
+	MashMeshBuffer* CMashNullMeshBuffer::Clone()
+	{
+		return MashMeshBufferIntermediate::CloneMembers(this);
+	}
+}
@@ -0,0 +1,30 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#ifndef _C_MASH_NULL_MESH_BUFFER_H_
+#define _C_MASH_NULL_MESH_BUFFER_H_
+
+#include "MashMeshBufferIntermediate.h"
+
+namespace mash
+{
+	class CMashNullMeshBuffer : public MashMeshBufferIntermediate
+	{
+	public:
+		CMashNullMeshBuffer(MashVideo *renderer,
+			MashArray<MashVertexBuffer*> &vertexBuffers, 
+			MashIndexBuffer *indexBuffer,
+			MashVertex *vertexDeclaration):MashMeshBufferIntermediate(renderer,
+			vertexBuffers, indexBuffer, vertexDeclaration){}
+
+		CMashNullMeshBuffer(MashVideo *renderer):MashMeshBufferIntermediate(renderer){}
+
+		MashMeshBuffer* Clone();
+
+		~CMashNullMeshBuffer(){}
+	};
+}
+
+#endif
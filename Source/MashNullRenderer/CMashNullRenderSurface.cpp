@@ -0,0 +1,163 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#include "CMashNullRenderSurface.h"
+#include "CMashNullRenderer.h"
+#include "MashLog.h"
+namespace mash
+{
+	CMashNullRenderSurface::CMashNullRenderSurface(CMashNullRenderer *renderer,
+			MashArray<eFORMAT> &targetFormats,
+			bool useMipmaps,
+			uint32 width,
+			uint32 height,
+			eDEPTH_BUFFER_OPTIONS depthOptions,
+			bool fitToScreen,
+			bool isCube):MashRenderSurface(), m_renderer(renderer), m_depthOptions(depthOptions),
+			m_targetFormats(targetFormats), m_useMipmaps(useMipmaps), m_isCube(isCube),
+			m_fitToScreen(fitToScreen), m_width(width), m_height(height), m_autoViewport(true)
+	{
+
+	}
+
+	CMashNullRenderSurface::~CMashNullRenderSurface()
+	{
+		m_renderer->_RemoveRenderSurface(this);
+
+		MashArray<MashTexture*>::Iterator texIter = m_textures.Begin();
+		MashArray<MashTexture*>::Iterator texIterEnd = m_textures.End();
+		for(; texIter != texIterEnd; ++texIter)
+		{
+			m_renderer->RemoveTextureFromCache(*texIter);
+			(*texIter)->Drop();
+		}
+
+		m_textures.Clear();
+	}
+
+	MashRenderSurface* CMashNullRenderSurface::Clone()const
+	{
+		if (m_targetFormats.Size() == 0)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+				"Failed to clone render surface.", 
+				"CMashNullRenderSurface::Clone");
+
+			return 0;
+		}
+
+		MashRenderSurface *newSurface = 0;
+		if (m_isCube)
+		{
+			newSurface = m_renderer->CreateCubicRenderSurface(m_width, m_useMipmaps, m_targetFormats[0], 
+				m_depthOptions != aDEPTH_OPTION_NO_DEPTH, aFORMAT_DEPTH32_FLOAT);
+		}
+		else
+		{
+			const int32 width = (m_fitToScreen)?-1:(int32)m_width;
+			const int32 height = (m_fitToScreen)?-1:(int32)m_height;
+			newSurface = m_renderer->CreateRenderSurface(width, height, &m_targetFormats[0], 
+				m_targetFormats.Size(), m_useMipmaps, m_depthOptions);
+		}
+
+		if (!newSurface)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+				"Failed to clone render surface.", 
+				"CMashNullRenderSurface::Clone");
+		}
+
+		return newSurface;
+	}
+
+	eMASH_STATUS CMashNullRenderSurface::Initialise()
+	{
+		for(uint32 i = 0; i < m_targetFormats.Size(); ++i)
+		{
+			MashTexture *tex = 0;
+			if (m_isCube)
+				tex = m_renderer->AddCubeTexture("", m_width, m_useMipmaps, aUSAGE_RENDER_TARGET, m_targetFormats[i]);
+			else
+				tex = m_renderer->AddTexture("", m_width, m_height, m_useMipmaps, aUSAGE_RENDER_TARGET, m_targetFormats[i]);
+
+			if (!tex)
+			{
+				MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+					"Failed to create render surface texture.", 
+					"CMashNullRenderSurface::Initialise");
+
+				return aMASH_FAILED;
+			}
+
+			tex->Grab();
+			m_textures.PushBack(tex);
+		}
+
+		return aMASH_OK;
+	}
+
+	void CMashNullRenderSurface::GenerateMips(int32 iSurface)
+	{
+		//nothing to generate
+	}
+
+	eMASH_STATUS CMashNullRenderSurface::OnSet(int32 iSurface)
+	{
+		m_renderer->_RecordCommand(aNULL_CMD_SET_RENDER_TARGET, this, (uint32)iSurface);
+
+		if (m_autoViewport)
+		{
+			sMashViewPort viewPort;
+			viewPort.x = 0;
+			viewPort.y = 0;
+			viewPort.width = m_width;
+			viewPort.height = m_height;
+			viewPort.minZ = 0.0f;
+			viewPort.maxZ = 1.0f;
+			m_renderer->SetViewport(viewPort);
+		}
+
+		return aMASH_OK;
+	}
+
+	void CMashNullRenderSurface::OnDismount()
+	{
+	}
+
+	void CMashNullRenderSurface::_ClearTargets(uint32 iClearFlags, const sMashColour4 &colour, f32 fZDepth)
+	{
+		//done by the renderer
+	}
+
+	eMASH_STATUS CMashNullRenderSurface::OnPreResize()
+	{
+		if (m_fitToScreen)
+		{
+			for(uint32 i = 0; i < m_textures.Size(); ++i)
+			{
+				m_renderer->RemoveTextureFromCache(m_textures[i]);
+				m_textures[i]->Drop();
+			}
+
+			m_textures.Clear();
+		}
+
+		return aMASH_OK;
+	}
+
+	eMASH_STATUS CMashNullRenderSurface::OnPostResize(uint32 width, uint32 height)
+	{
+		//only resize if needed
+		if (m_fitToScreen)
+		{
+			m_width = width;
+			m_height = height;
+
+			return Initialise();
+		}
+
+		return aMASH_OK;
+	}
+}
@@ -0,0 +1,101 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#ifndef _C_MASH_NULL_RENDER_SURFACE_H_
+#define _C_MASH_NULL_RENDER_SURFACE_H_
+
+#include "MashRenderSurface.h"
+#include "MashTexture.h"
+#include "MashArray.h"
+namespace mash
+{
+	class CMashNullRenderer;
+
+	/*
+		Used for both standard and cubic render surfaces. Cubic surfaces
+		hold a single cube texture and the surface index given to OnSet()
+		is the face being rendered.
+	*/
+	class CMashNullRenderSurface : public MashRenderSurface
+	{
+	private:
+		CMashNullRenderer *m_renderer;
+		eDEPTH_BUFFER_OPTIONS m_depthOptions;
+		MashArray<MashTexture*> m_textures;
+		MashArray<eFORMAT> m_targetFormats;
+		bool m_useMipmaps;
+		bool m_isCube;
+		bool m_fitToScreen;
+		uint32 m_width;
+		uint32 m_height;
+		bool m_autoViewport;
+	public:
+		CMashNullRenderSurface(CMashNullRenderer *renderer,
+			MashArray<eFORMAT> &targetFormats,
+			bool useMipmaps,
+			uint32 width,
+			uint32 height,
+			eDEPTH_BUFFER_OPTIONS depthOptions,
+			bool fitToScreen,
+			bool isCube);
+
+		~CMashNullRenderSurface();
+
+		eMASH_STATUS Initialise();
+
+		void GenerateMips(int32 iSurface);
+
+		MashRenderSurface* Clone()const;
+		eMASH_STATUS OnSet(int32 iSurface = -1);
+		void OnDismount();
+		MashTexture* GetTexture(uint32 iTexture)const;
+		uint32 GetTextureCount()const;
+		eUSAGE GetUsageType()const;
+
+		mash::MashVector2 GetDimentions()const;
+
+		eMASH_STATUS OnPreResize();
+		eMASH_STATUS OnPostResize(uint32 width, uint32 height);
+		void _ClearTargets(uint32 iClearFlags, const sMashColour4 &colour, f32 fZDepth);
+
+		void SetAutoViewport(bool state);
+		bool GetAutoViewport()const;
+	};
+
+	inline void CMashNullRenderSurface::SetAutoViewport(bool state)
+	{
+		m_autoViewport = state;
+	}
+
+	inline bool CMashNullRenderSurface::GetAutoViewport()const
+	{
+		return m_autoViewport;
+	}
+
+	inline eUSAGE CMashNullRenderSurface::GetUsageType()const
+	{
+		return aUSAGE_RENDER_TARGET;
+	}
+
+	inline MashTexture* CMashNullRenderSurface::GetTexture(uint32 iTexture)const
+	{
+		if (iTexture >= m_textures.Size())
+			return 0;
+
+		return m_textures[iTexture];
+	}
+
+	inline uint32 CMashNullRenderSurface::GetTextureCount()const
+	{
+		return m_textures.Size();
+	}
+
+	inline mash::MashVector2 CMashNullRenderSurface::GetDimentions()const
+	{
+		return mash::MashVector2(m_width, m_height);
+	}
+}
+
+#endif
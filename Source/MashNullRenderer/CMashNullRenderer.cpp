@@ -0,0 +1,635 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#include "CMashNullRenderer.h"
+#include "CMashNullSkinManager.h"
+#include "CMashNullTexture.h"
+#include "CMashNullVertexBuffer.h"
+#include "CMashNullIndexBuffer.h"
+#include "CMashNullVertex.h"
+#include "CMashNullMeshBuffer.h"
+#include "CMashNullRenderSurface.h"
+#include "MashTexture.h"
+#include "MashHelper.h"
+#include "MashFileManager.h"
+#include "MashFileStream.h"
+#include "MashMaterial.h"
+#include "MashDevice.h"
+#include "MashLog.h"
+
+namespace mash
+{
+	MashVideo* CreateMashNullDevice()
+	{
+		CMashNullRenderer *pNewRenderer = MASH_NEW_COMMON CMashNullRenderer();
+		return pNewRenderer;
+	}
+
+	CMashNullRenderer::CMashNullRenderer():MashNullVideo(), m_backbufferSize(0.0f, 0.0f),
+		m_commandLogEnabled(true)
+	{
+	}
+
+	CMashNullRenderer::~CMashNullRenderer()
+	{
+		MashArray<MashTextureState*>::Iterator samplerIter = m_samplerStates.Begin();
+		MashArray<MashTextureState*>::Iterator samplerIterEnd = m_samplerStates.End();
+		for(; samplerIter != samplerIterEnd; ++samplerIter)
+			(*samplerIter)->Drop();
+
+		m_samplerStates.Clear();
+	}
+
+	eMASH_STATUS CMashNullRenderer::_Initialise(MashDevice *device, const sMashDeviceSettings &creationParameters, void *extraData)
+	{
+		MashFileManager *pFileManager = device->GetFileManager();
+
+		sMashViewPort viewport;
+		viewport.x = 0;
+		viewport.y = 0;
+		viewport.width = creationParameters.screenWidth;
+		viewport.height = creationParameters.screenHeight;
+		viewport.minZ = 0.0f;
+		viewport.maxZ = 1.0f;
+
+		m_defaultRenderTargetViewport = viewport;
+
+		m_backbufferSize.x = creationParameters.screenWidth;
+		m_backbufferSize.y = creationParameters.screenHeight;
+
+		SetViewport(viewport);
+
+		m_skinManager = MASH_NEW_COMMON CMashNullSkinManager(this);
+		if (m_skinManager->_Initialise(creationParameters) == aMASH_FAILED)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, "Skin manager failed to initialise.", "CMashNullRenderer::_Initialise");
+			return aMASH_FAILED;
+		}
+
+		return MashVideoIntermediate::_InitialiseCommon(pFileManager);
+	}
+
+	void CMashNullRenderer::_RecordCommand(eNULL_COMMAND_TYPE type, const void *object, uint32 argA, uint32 argB, uint32 argC, uint32 argD)
+	{
+		switch(type)
+		{
+		case aNULL_CMD_SET_RENDER_TARGET:
+		case aNULL_CMD_SET_VIEWPORT:
+		case aNULL_CMD_SET_RASTERIZER_STATE:
+		case aNULL_CMD_SET_BLEND_STATE:
+		case aNULL_CMD_SET_VERTEX_FORMAT:
+			++m_currentFrameStats.stateChangeCount;
+			break;
+		case aNULL_CMD_SET_EFFECT:
+			++m_currentFrameStats.effectChangeCount;
+			break;
+		case aNULL_CMD_SET_PARAMETER:
+			++m_currentFrameStats.parameterUpdateCount;
+			break;
+		case aNULL_CMD_SET_TEXTURE:
+			++m_currentFrameStats.textureBindCount;
+			break;
+		case aNULL_CMD_UPDATE_BUFFER:
+		case aNULL_CMD_UPDATE_TEXTURE:
+			++m_currentFrameStats.bufferUpdateCount;
+			m_currentFrameStats.bufferUpdateBytes += argA;
+			break;
+		case aNULL_CMD_DRAW_INDEXED:
+		case aNULL_CMD_DRAW_VERTEX:
+		case aNULL_CMD_DRAW_VERTEX_INSTANCED:
+		case aNULL_CMD_DRAW_INDEXED_INSTANCED:
+			++m_currentFrameStats.drawCount;
+			m_currentFrameStats.primitiveCount += argC;
+			m_currentFrameStats.instanceCount += argD;
+			break;
+		default:
+			break;
+		};
+
+		if (m_commandLogEnabled)
+		{
+			sNullCommand command;
+			command.type = type;
+			command.object = object;
+			command.args[0] = argA;
+			command.args[1] = argB;
+			command.args[2] = argC;
+			command.args[3] = argD;
+			m_commandLog.PushBack(command);
+		}
+	}
+
+	void CMashNullRenderer::RecordDraw(eNULL_COMMAND_TYPE type, const MashMeshBuffer *buffer, uint32 vertexCount,
+			uint32 indexCount, uint32 primitiveCount, uint32 instanceCount)
+	{
+		++m_currentDrawCount;
+		_RecordCommand(type, buffer, vertexCount, indexCount, primitiveCount, instanceCount);
+	}
+
+	eMASH_STATUS CMashNullRenderer::SetRasteriserState(int32 state)
+	{
+		if (!m_lockRasterizerState)
+		{
+			if (state < 0 || (uint32)state >= m_rasterizerStates.Size())
+				state = m_defaultRasterizerState;
+
+			if (m_currentRasterizerState != state)
+			{
+				m_currentRasterizerState = state;
+				_RecordCommand(aNULL_CMD_SET_RASTERIZER_STATE, 0, state);
+			}
+		}
+
+		return aMASH_OK;
+	}
+
+	eMASH_STATUS CMashNullRenderer::SetBlendState(int32 state)
+	{
+		if (!m_lockBlendState)
+		{
+			if (state < 0 || (uint32)state >= m_blendStates.Size())
+				state = m_defaultBlendState;
+
+			if (m_currentBlendState != state)
+			{
+				m_currentBlendState = state;
+				_RecordCommand(aNULL_CMD_SET_BLEND_STATE, 0, state);
+			}
+		}
+
+		return aMASH_OK;
+	}
+
+	int32 CMashNullRenderer::AddRasteriserState(const sRasteriserStates &state)
+	{
+		//make sure the same state has not been created
+		const uint32 iStateCount = m_rasterizerStates.Size();
+		for(uint32 i = 0; i < iStateCount; ++i)
+		{
+			if (m_rasterizerStates[i] == state)
+				return i;
+		}
+
+		m_rasterizerStates.PushBack(state);
+
+		return (m_rasterizerStates.Size() - 1);
+	}
+
+	int32 CMashNullRenderer::AddBlendState(const sBlendStates &state)
+	{
+		//make sure the same state has not been created
+		const uint32 iStateCount = m_blendStates.Size();
+		for(uint32 i = 0; i < iStateCount; ++i)
+		{
+			if (m_blendStates[i] == state)
+				return i;
+		}
+
+		m_blendStates.PushBack(state);
+
+		return (m_blendStates.Size() - 1);
+	}
+
+	MashTextureState* CMashNullRenderer::AddSamplerState(const sSamplerState &state)
+	{
+		//make sure the same state has not been created
+		const uint32 iStateCount = m_samplerStates.Size();
+		for(uint32 i = 0; i < iStateCount; ++i)
+		{
+			if (*(m_samplerStates[i]->GetSamplerState()) == state)
+				return m_samplerStates[i];
+		}
+
+		MashTextureState *newState = MASH_NEW_COMMON MashTextureState(state);
+		m_samplerStates.PushBack(newState);
+
+		return newState;
+	}
+
+	const sBlendStates* CMashNullRenderer::GetBlendState(int32 iIndex)const
+	{
+		if (iIndex < 0 || (uint32)iIndex >= m_blendStates.Size())
+			iIndex = m_defaultBlendState;
+
+		return &m_blendStates[iIndex];
+	}
+
+	const sRasteriserStates* CMashNullRenderer::GetRasterizerState(int32 iIndex)const
+	{
+		if (iIndex < 0 || (uint32)iIndex >= m_rasterizerStates.Size())
+			iIndex = m_defaultRasterizerState;
+
+		return &m_rasterizerStates[iIndex];
+	}
+
+	eMASH_STATUS CMashNullRenderer::SetVertexFormat(MashVertex *pVertex)
+	{
+		if (!pVertex)
+		{
+			m_renderInfo->SetVertex(0);
+		}
+		else if (m_renderInfo->GetVertex() != pVertex)
+		{
+			_RecordCommand(aNULL_CMD_SET_VERTEX_FORMAT, pVertex);
+		}
+
+		return aMASH_OK;
+	}
+
+	const mash::MashVector2 CMashNullRenderer::GetBackBufferSize(bool returnActiveRenderSurfaceSize)const
+	{
+		if (!returnActiveRenderSurfaceSize || !m_currentRenderSurface)
+			return m_backbufferSize;
+		else
+		{
+			return m_currentRenderSurface->GetDimentions();
+		}
+	}
+
+	eMASH_STATUS CMashNullRenderer::BeginRender()
+	{
+		MashVideoIntermediate::BeginRender();
+
+		m_commandLog.Clear();
+		m_currentFrameStats = sNullFrameStats();
+		_RecordCommand(aNULL_CMD_BEGIN_RENDER, 0);
+
+		ClearTarget(aCLEAR_TARGET | aCLEAR_DEPTH | aCLEAR_STENCIL, m_FillColour, 1.0f);
+		return aMASH_OK;
+	}
+
+	eMASH_STATUS CMashNullRenderer::EndRender()
+	{
+		MashVideoIntermediate::EndRender();
+
+		_RecordCommand(aNULL_CMD_END_RENDER, 0);
+		m_lastFrameStats = m_currentFrameStats;
+
+		return aMASH_OK;
+	}
+
+	eMASH_STATUS CMashNullRenderer::OnResolutionChange(uint32 width, uint32 height)
+	{
+		MASH_WRITE_TO_LOG_EX(MashLog::aERROR_LEVEL_INFORMATION, 
+					"CMashNullRenderer::OnResolutionChange",
+                    "Resolution changing to width '%u height '%u'.", width, height);
+
+		m_backbufferSize.x = width;
+		m_backbufferSize.y = height;
+
+		//clean up any other references
+		if (OnPreResolutionChangeIntermediate() == aMASH_FAILED)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+					"Failed to change resolution.", 
+					"CMashNullRenderer::OnResolutionChange");
+
+			return aMASH_FAILED;
+		}
+
+		sMashViewPort viewport;
+		viewport.x = 0;
+		viewport.y = 0;
+		viewport.width = m_backbufferSize.x;
+		viewport.height = m_backbufferSize.y;
+		viewport.minZ = 0.0f;
+		viewport.maxZ = 1.0f;
+
+		m_defaultRenderTargetViewport = viewport;
+
+		SetViewport(viewport);
+
+		if (OnPostResolutionChangeIntermediate(m_backbufferSize.x, m_backbufferSize.y) == aMASH_FAILED)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+					"Failed to change resolution.", 
+					"CMashNullRenderer::OnResolutionChange");
+
+			return aMASH_FAILED;
+		}
+
+		MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_INFORMATION, 
+					"Resolution change succeeded.", 
+					"CMashNullRenderer::OnResolutionChange");
+
+		return aMASH_OK;
+	}
+
+	eMASH_STATUS CMashNullRenderer::SetScreenResolution(bool fullscreen, uint32 width, uint32 height)
+	{
+		//there is no window so the change can be applied immediately
+		return OnResolutionChange(width, height);
+	}
+
+	eMASH_STATUS CMashNullRenderer::SetViewport(const sMashViewPort &viewport)
+	{
+		if ((viewport.height == m_viewPort.height) &&
+			(viewport.width == m_viewPort.width) &&
+			(viewport.maxZ == m_viewPort.maxZ) &&
+			(viewport.minZ == m_viewPort.minZ) &&
+			(viewport.x == m_viewPort.x) &&
+			(viewport.y == m_viewPort.y))
+		{
+			return aMASH_OK;
+		}
+
+		m_viewPort = viewport;
+		_RecordCommand(aNULL_CMD_SET_VIEWPORT, 0);
+
+		_OnViewportChange();
+
+		return aMASH_OK;
+	}
+
+	eMASH_STATUS CMashNullRenderer::SaveScreenShotToFile(eSAVE_TEXTURE_FORMAT outputFormat, const MashStringc &file)const
+	{
+		MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_WARNING, 
+			"Screen shots are not supported by the null renderer.", 
+			"CMashNullRenderer::SaveScreenShotToFile");
+
+		return aMASH_FAILED;
+	}
+
+	eMASH_STATUS CMashNullRenderer::SaveTextureToFile(const MashTexture *texture, eSAVE_TEXTURE_FORMAT outputFormat, const MashStringc &file)const
+	{
+		MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_WARNING, 
+			"Saving textures is not supported by the null renderer.", 
+			"CMashNullRenderer::SaveTextureToFile");
+
+		return aMASH_FAILED;
+	}
+
+	MashVertex* CMashNullRenderer::_CreateVertexType(MashMaterial *material,
+			const sMashVertexElement *vertexDecl,
+			uint32 declCount)
+	{
+		MashVertex *vertex = 0;
+		//look for prev loaded vertex decl
+		const int32 iVertexCount = m_vertexTypes.Size();
+		for(int32 i = 0; i < iVertexCount; ++i)
+		{
+			if (m_vertexTypes[i]->IsEqual(vertexDecl, declCount))
+			{
+				vertex = m_vertexTypes[i];
+				break;
+			}
+		}
+
+		if (!vertex)
+		{
+			uint32 vertexSizeInBytes = 0;
+			for(uint32 i = 0; i < declCount; ++i)
+				vertexSizeInBytes += mash::helpers::GetVertexDeclTypeSize(vertexDecl[i].type);
+
+			vertex = MASH_NEW_COMMON CMashNullVertex(vertexDecl, declCount, vertexSizeInBytes);
+			m_vertexTypes.PushBack(vertex);
+			_AddCompileDependency(material, (CMashNullVertex*)vertex);
+		}
+		return vertex;
+	}
+
+	eMASH_STATUS CMashNullRenderer::SetRenderTargetDefault()
+	{
+		if (m_currentRenderSurface)
+		{
+			SetRenderTarget(0, 0);
+			SetViewport(m_defaultRenderTargetViewport);
+			_RecordCommand(aNULL_CMD_SET_RENDER_TARGET, 0);
+		}
+
+		return aMASH_OK;
+	}
+
+	MashTexture* CMashNullRenderer::LoadTextureFromFile(const MashStringc &fileName)
+	{
+		MashFileStream *pFileStream = m_pFileManager->CreateFileStream();
+		if (pFileStream->LoadFile(fileName.GetCString(), aFILE_IO_BINARY) == aMASH_FAILED)
+		{
+			MASH_WRITE_TO_LOG_EX(MashLog::aERROR_LEVEL_ERROR,
+				"CMashNullRenderer::LoadTextureFromFile",
+				"Failed to load texture '%s'.", fileName.GetCString());
+
+			pFileStream->Destroy();
+			return 0;
+		}
+
+		pFileStream->Destroy();
+
+		/*
+			Images are not decoded. A small placeholder is created
+			in its place so that materials can still reference it.
+		*/
+		MashTexture *texture = MASH_NEW_COMMON CMashNullTexture(this, m_textureIDCounter++,
+			fileName, false, aUSAGE_STATIC, 1, 1, aFORMAT_RGBA8_UINT, false);
+
+		m_textures.insert(std::make_pair(fileName, texture));
+
+		return texture;
+	}
+
+	MashTexture* CMashNullRenderer::CreateTexture(const MashStringc &sOldName, uint32 iWidth, uint32 iHeight, bool useMipmaps,
+				eUSAGE usage, eFORMAT format, bool isCube)
+	{
+		MashStringc sName;
+		if (ValidateTextureName(sOldName, sName) == aMASH_FAILED)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+				"Texture creataion failed. The name given was not unique.",
+				"CMashNullRenderer::CreateTexture");
+
+			return 0;
+		}
+
+		MashTexture *texture = MASH_NEW_COMMON CMashNullTexture(this, m_textureIDCounter++,
+			sName, useMipmaps, usage, iWidth, iHeight, format, isCube);
+
+		m_textures.insert(std::make_pair(sName, texture));
+
+		return texture;
+	}
+
+	MashTexture* CMashNullRenderer::AddTexture(const MashStringc &sName,
+										uint32 iWidth, 
+										uint32 iHeight, 
+										bool useMipmaps, 
+										eUSAGE usage, 
+										eFORMAT format)
+	{
+		return CreateTexture(sName, iWidth, iHeight, useMipmaps, usage, format, false);
+	}
+
+	MashTexture* CMashNullRenderer::AddCubeTexture(const MashStringc &sName,
+										uint32 iSize,
+										bool useMipmaps, 
+										eUSAGE usage, 
+										eFORMAT format)
+	{
+		return CreateTexture(sName, iSize, iSize, useMipmaps, usage, format, true);
+	}
+
+	MashMeshBuffer* CMashNullRenderer::_CreateMeshBuffer()
+	{
+		return MASH_NEW_COMMON CMashNullMeshBuffer(this);
+	}
+
+	MashMeshBuffer* CMashNullRenderer::CreateMeshBuffer(const sVertexStreamInit *initVertexStreamData,
+			uint32 initVertexStreamCount,
+			const MashVertex *vertexDecl, 
+			const void *indexData, 
+			uint32 indexCount, 
+			eFORMAT indexFormat,
+			eUSAGE indexUsage)
+	{
+		if (!initVertexStreamCount || !initVertexStreamData)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+				"Vertex initialiser data was not given.", 
+				"CMashNullRenderer::CreateMeshBuffer");
+
+			return 0;
+		}
+
+		if (initVertexStreamCount > vertexDecl->GetStreamCount())
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+				"There are more vertex streams given then there are elements in the vertex declaration.", 
+				"CMashNullRenderer::CreateMeshBuffer");
+
+			return 0;
+		}
+
+		MashArray<MashVertexBuffer*> vertexStreams;
+		for(uint32 i = 0; i < vertexDecl->GetStreamCount(); ++i)
+		{
+			if ((initVertexStreamCount > i) && (initVertexStreamData[i].dataSizeInBytes > 0))
+			{
+				vertexStreams.PushBack(CreateVertexBuffer(initVertexStreamData[i].data, 
+					initVertexStreamData[i].dataSizeInBytes, 
+					initVertexStreamData[i].usage));
+			}
+		}
+
+		MashIndexBuffer *indexBuffer = 0;
+		if (indexData && (indexCount > 0))
+			indexBuffer = CreateIndexBuffer(indexData, indexCount, indexUsage, indexFormat);
+
+		return MASH_NEW_COMMON CMashNullMeshBuffer(this, vertexStreams, indexBuffer, (MashVertex*)vertexDecl);
+	}
+
+	MashVertexBuffer* CMashNullRenderer::CreateVertexBuffer(const void *pData, uint32 iSizeInBytes, eUSAGE usage)
+	{
+		return MASH_NEW_COMMON CMashNullVertexBuffer(this, pData, usage, iSizeInBytes);
+	}
+
+	MashIndexBuffer* CMashNullRenderer::CreateIndexBuffer(const void *pData, uint32 iIndexCount, eUSAGE usage, eFORMAT format)
+	{
+		if (!iIndexCount)
+			return 0;
+
+		int32 iElementSizeInBytes = 0;
+		if (format == aFORMAT_R16_UINT)
+			iElementSizeInBytes = sizeof(int16);
+		else
+		{
+			iElementSizeInBytes = sizeof(int32);
+			//make sure the format is valid
+			format = aFORMAT_R32_UINT;
+		}
+
+		return MASH_NEW_COMMON CMashNullIndexBuffer(this, pData, usage, format, iElementSizeInBytes * iIndexCount);
+	}
+
+	MashRenderSurface* CMashNullRenderer::CreateRenderSurface(int32 iWidth, int32 iHeight, const eFORMAT *pFormats,
+		uint32 iTargetCount, bool useMipmaps, eDEPTH_BUFFER_OPTIONS depthOptions, eFORMAT eDepthFormat)
+	{
+		bool fitToScreen = false;
+		uint32 newWidth = 0;
+		uint32 newHeight = 0;
+		if (iWidth <= 0 || iHeight <= 0)
+		{
+			newWidth = (uint32)m_defaultRenderTargetViewport.width;
+			newHeight = (uint32)m_defaultRenderTargetViewport.height;
+
+			fitToScreen = true;
+		}
+		else
+		{
+			newWidth = (uint32)iWidth;
+			newHeight = (uint32)iHeight;
+		}
+
+		MashArray<eFORMAT> formats(pFormats, iTargetCount);
+		CMashNullRenderSurface *newRenderSurface = MASH_NEW_COMMON CMashNullRenderSurface(this, formats, useMipmaps, 
+			newWidth, newHeight, depthOptions, fitToScreen, false);
+
+		if (newRenderSurface->Initialise() == aMASH_FAILED)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR,
+					"Failed to create render surface.",
+					"CMashNullRenderer::CreateRenderSurface");
+
+			MASH_DELETE newRenderSurface;
+			return 0;
+		}
+
+		m_renderSurfaces.PushBack(newRenderSurface);
+
+		return newRenderSurface;
+	}
+
+	MashRenderSurface* CMashNullRenderer::CreateCubicRenderSurface(uint32 iSize, bool useMipmaps,
+		eFORMAT eTextureFormat, bool bUseDepth, eFORMAT eDepthFormat)
+	{
+		MashArray<eFORMAT> formats(&eTextureFormat, 1);
+		CMashNullRenderSurface *newRenderSurface = MASH_NEW_COMMON CMashNullRenderSurface(this, formats, useMipmaps, 
+			iSize, iSize, (bUseDepth)?aDEPTH_OPTION_OWN_DEPTH:aDEPTH_OPTION_NO_DEPTH, false, true);
+
+		if (newRenderSurface->Initialise() == aMASH_FAILED)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR,
+					"Failed to create render surface.",
+					"CMashNullRenderer::CreateCubicRenderSurface");
+
+			MASH_DELETE newRenderSurface;
+			return 0;
+		}
+
+		return newRenderSurface;
+	}
+
+	eMASH_STATUS CMashNullRenderer::ClearTarget(uint32 iClearFlags, const sMashColour4 &colour, f32 fZDepth)
+	{
+		_RecordCommand(aNULL_CMD_CLEAR_TARGET, m_currentRenderSurface, iClearFlags);
+		return aMASH_OK;
+	}
+
+	eMASH_STATUS CMashNullRenderer::DrawIndexedList(const MashMeshBuffer *buffer, uint32 iVertexCount, uint32 iIndexCount,
+				uint32 iPrimitiveCount, ePRIMITIVE_TYPE ePrimType)
+	{
+		RecordDraw(aNULL_CMD_DRAW_INDEXED, buffer, iVertexCount, iIndexCount, iPrimitiveCount, 1);
+		return aMASH_OK;
+	}
+
+	eMASH_STATUS CMashNullRenderer::DrawVertexList(const MashMeshBuffer *buffer, uint32 iVertexCount,
+		uint32 iPrimitiveCount, ePRIMITIVE_TYPE ePrimType, uint32 firstVertex)
+	{
+		RecordDraw(aNULL_CMD_DRAW_VERTEX, buffer, iVertexCount, 0, iPrimitiveCount, 1);
+		return aMASH_OK;
+	}
+
+	eMASH_STATUS CMashNullRenderer::DrawVertexInstancedList(const MashMeshBuffer *buffer, uint32 iVertexCount,
+			uint32 iPrimitiveCount, ePRIMITIVE_TYPE ePrimType, uint32 instanceCount)
+	{
+		RecordDraw(aNULL_CMD_DRAW_VERTEX_INSTANCED, buffer, iVertexCount, 0, iPrimitiveCount, instanceCount);
+		return aMASH_OK;
+	}
+
+	eMASH_STATUS CMashNullRenderer::DrawIndexedInstancedList(const MashMeshBuffer *buffer, uint32 iVertexCount, uint32 indexCount,
+			uint32 iPrimitiveCount, ePRIMITIVE_TYPE ePrimType, uint32 instanceCount)
+	{
+		RecordDraw(aNULL_CMD_DRAW_INDEXED_INSTANCED, buffer, iVertexCount, indexCount, iPrimitiveCount, instanceCount);
+		return aMASH_OK;
+	}
+}
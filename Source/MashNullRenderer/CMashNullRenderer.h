@@ -0,0 +1,171 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#ifndef _C_MASH_NULL_RENDERER_H_
+#define _C_MASH_NULL_RENDERER_H_
+
+#include "MashDataTypes.h"
+#include "Null/MashNullVideo.h"
+#include "MashTypes.h"
+
+namespace mash
+{
+	class MashDevice;
+
+	class CMashNullRenderer : public MashNullVideo
+	{
+	private:
+		mash::MashVector2 m_backbufferSize;
+		MashArray<sRasteriserStates> m_rasterizerStates;
+		MashArray<sBlendStates> m_blendStates;
+		MashArray<MashTextureState*> m_samplerStates;
+
+		MashArray<sNullCommand> m_commandLog;
+		bool m_commandLogEnabled;
+		sNullFrameStats m_currentFrameStats;
+		sNullFrameStats m_lastFrameStats;
+
+		MashTexture* LoadTextureFromFile(const MashStringc &fileName);
+		MashTexture* CreateTexture(const MashStringc &name, uint32 width, uint32 height, bool useMipmaps,
+			eUSAGE usage, eFORMAT format, bool isCube);
+		void RecordDraw(eNULL_COMMAND_TYPE type, const MashMeshBuffer *buffer, uint32 vertexCount,
+			uint32 indexCount, uint32 primitiveCount, uint32 instanceCount);
+	public:
+		CMashNullRenderer();
+		~CMashNullRenderer();
+
+		eMASH_STATUS SaveScreenShotToFile(eSAVE_TEXTURE_FORMAT outputFormat, const MashStringc &file)const;
+		eMASH_STATUS SaveTextureToFile(const MashTexture *texture, eSAVE_TEXTURE_FORMAT outputFormat, const MashStringc &file)const;
+
+		eMASH_STATUS OnResolutionChange(uint32 width, uint32 height);
+		eMASH_STATUS _Initialise(MashDevice *device, const sMashDeviceSettings &creationParameters, void *extraData);
+
+		eMASH_STATUS SetRasteriserState(int32 rasterizerState);
+		eMASH_STATUS SetBlendState(int32 blendState);
+		int32 AddRasteriserState(const sRasteriserStates &state);
+		int32 AddBlendState(const sBlendStates &state);
+		MashTextureState* AddSamplerState(const sSamplerState &state);
+
+		const sBlendStates* GetBlendState(int32 iIndex)const;
+		const sRasteriserStates* GetRasterizerState(int32 iIndex)const;
+
+		eMASH_STATUS BeginRender();
+		eMASH_STATUS EndRender();
+
+		eMASH_STATUS SetScreenResolution(bool fullscreen, uint32 width, uint32 height);
+		eMASH_STATUS SetViewport(const sMashViewPort &viewport);
+		eMASH_STATUS SetVertexFormat(MashVertex *pVertex);
+
+		MashVertex* _CreateVertexType(MashMaterial *material,
+			const sMashVertexElement *vertexDecl,
+			uint32 iDeclCount);
+
+		eMASH_STATUS SetRenderTargetDefault();
+
+		MashTexture* AddTexture(const MashStringc &sName,
+											uint32 iWidth,
+											uint32 iHeight,
+											bool useMipmaps,
+											eUSAGE usage,
+											eFORMAT format);
+
+		MashTexture* AddCubeTexture(const MashStringc &sName,
+											uint32 iSize,
+											bool useMipmaps,
+											eUSAGE usage,
+											eFORMAT format);
+
+		MashMeshBuffer* _CreateMeshBuffer();
+
+		MashMeshBuffer* CreateMeshBuffer(const sVertexStreamInit *initVertexStreamData,
+			uint32 initVertexStreamCount,
+			const MashVertex *vertexDecl,
+			const void *indexData = 0,
+			uint32 indexCount = 0,
+			eFORMAT indexFormat = aFORMAT_R16_UINT,
+			eUSAGE indexUsage = aUSAGE_STATIC);
+
+		MashVertexBuffer* CreateVertexBuffer(const void *pData, uint32 iSizeInBytes, eUSAGE usage);
+		MashIndexBuffer* CreateIndexBuffer(const void *pData, uint32 iIndexCount, eUSAGE usage, eFORMAT format);
+
+		MashRenderSurface* CreateRenderSurface(int32 iWidth, int32 iHeight, const eFORMAT *pFormats,
+			uint32 iTargetCount, bool useMipmaps, eDEPTH_BUFFER_OPTIONS depthOptions, eFORMAT eDepthFormat = aFORMAT_DEPTH32_FLOAT);
+
+		MashRenderSurface* CreateCubicRenderSurface(uint32 iSize, bool useMipmaps,
+			eFORMAT eTextureFormat, bool bUseDepth, eFORMAT eDepthFormat);
+
+		eMASH_STATUS ClearTarget(uint32 iClearFlags, const sMashColour4 &colour, f32 fZDepth = 1.0f);
+
+		eMASH_STATUS DrawIndexedList(const MashMeshBuffer *buffer, uint32 iVertexCount, uint32 iIndexCount,
+					uint32 iPrimitiveCount, ePRIMITIVE_TYPE ePrimType);
+
+		eMASH_STATUS DrawVertexList(const MashMeshBuffer *buffers, uint32 iVertexCount,
+			uint32 iPrimitiveCount, ePRIMITIVE_TYPE ePrimType, uint32 firstVertex = 0);
+
+		eMASH_STATUS DrawVertexInstancedList(const MashMeshBuffer *buffer, uint32 iVertexCount,
+				uint32 iPrimitiveCount, ePRIMITIVE_TYPE ePrimType, uint32 instanceCount);
+
+		eMASH_STATUS DrawIndexedInstancedList(const MashMeshBuffer *buffer, uint32 iVertexCount, uint32 indexCount,
+				uint32 iPrimitiveCount, ePRIMITIVE_TYPE ePrimType, uint32 instanceCount);
+
+		eSHADER_API_TYPE GetCurrentAPI()const;
+		const mash::MashVector2 GetBackBufferSize(bool returnActiveRenderSurfaceSize = false)const;
+
+		void SetCommandLogEnabled(bool enable);
+		bool GetCommandLogEnabled()const;
+		const MashArray<sNullCommand>& GetCommandLog()const;
+		void ClearCommandLog();
+		const sNullFrameStats& GetCurrentFrameStats()const;
+		const sNullFrameStats& GetLastFrameStats()const;
+
+		/*
+			Called by the renderer and null resources to record API calls.
+			Frame statistics are updated here so callers should filter out
+			redundant calls before recording.
+		*/
+		void _RecordCommand(eNULL_COMMAND_TYPE type, const void *object, uint32 argA = 0, uint32 argB = 0, uint32 argC = 0, uint32 argD = 0);
+	};
+
+	/*
+		The material compiler generates GLSL for this renderer. This means the
+		runtime effect generation path is the same as the OpenGL renderer.
+	*/
+	inline eSHADER_API_TYPE CMashNullRenderer::GetCurrentAPI()const
+	{
+		return aSHADERAPITYPE_OPENGL;
+	}
+
+	inline void CMashNullRenderer::SetCommandLogEnabled(bool enable)
+	{
+		m_commandLogEnabled = enable;
+	}
+
+	inline bool CMashNullRenderer::GetCommandLogEnabled()const
+	{
+		return m_commandLogEnabled;
+	}
+
+	inline const MashArray<sNullCommand>& CMashNullRenderer::GetCommandLog()const
+	{
+		return m_commandLog;
+	}
+
+	inline void CMashNullRenderer::ClearCommandLog()
+	{
+		m_commandLog.Clear();
+	}
+
+	inline const sNullFrameStats& CMashNullRenderer::GetCurrentFrameStats()const
+	{
+		return m_currentFrameStats;
+	}
+
+	inline const sNullFrameStats& CMashNullRenderer::GetLastFrameStats()const
+	{
+		return m_lastFrameStats;
+	}
+}
+
+#endif
@@ -0,0 +1,62 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#include "CMashNullSkinManager.h"
+#include "CMashNullRenderer.h"
+#include "CMashNullEffect.h"
+#include "MashHelper.h"
+
+namespace mash
+{
+	CMashNullSkinManager::CMashNullSkinManager(mash::CMashNullRenderer *pRenderer):MashMaterialManagerIntermediate(pRenderer)
+	{
+	}
+
+	CMashNullSkinManager::~CMashNullSkinManager()
+	{
+	}
+
+	MashEffect* CMashNullSkinManager::CreateEffect()
+	{
+		return MASH_NEW_COMMON CMashNullEffect((CMashNullRenderer*)m_renderer);
+	}
+
+	bool CMashNullSkinManager::IsProfileSupported(eSHADER_PROFILE profile)const
+	{
+		switch(profile)
+		{
+		case aSHADER_PROFILE_VS_GLSL:
+			return true;
+		case aSHADER_PROFILE_PS_GLSL:
+			return true;
+		case aSHADER_PROFILE_GS_GLSL:
+			return true;
+		default:
+			break;
+		};
+
+		return false;
+	}
+
+	eSHADER_PROFILE CMashNullSkinManager::GetLatestVertexProfile()const
+	{
+		return aSHADER_PROFILE_VS_GLSL;
+	}
+
+	eSHADER_PROFILE CMashNullSkinManager::GetLatestFragmentProfile()const
+	{
+		return aSHADER_PROFILE_PS_GLSL;
+	}
+
+	eSHADER_PROFILE CMashNullSkinManager::GetLatestGeometryProfile()const
+	{
+		return aSHADER_PROFILE_GS_GLSL;
+	}
+
+	const int8* CMashNullSkinManager::_GetAPIShaderHeader()
+	{
+		return mash::helpers::GetGLSLVersionAsString(aOGLVERSION_3_3);
+	}
+}
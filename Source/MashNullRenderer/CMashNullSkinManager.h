@@ -0,0 +1,33 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#ifndef _C_MASH_NULL_SKIN_MANAGER_H_
+#define _C_MASH_NULL_SKIN_MANAGER_H_
+
+#include "MashMaterialManagerIntermediate.h"
+
+namespace mash
+{
+	class CMashNullRenderer;
+
+	class CMashNullSkinManager : public MashMaterialManagerIntermediate
+	{
+	public:
+		CMashNullSkinManager(mash::CMashNullRenderer *pRenderer);
+		~CMashNullSkinManager();
+
+		MashEffect* CreateEffect();
+
+		bool IsProfileSupported(eSHADER_PROFILE profile)const;
+
+		eSHADER_PROFILE GetLatestVertexProfile()const;
+		eSHADER_PROFILE GetLatestFragmentProfile()const;
+		eSHADER_PROFILE GetLatestGeometryProfile()const;
+
+		const int8* _GetAPIShaderHeader();
+	};
+}
+
+#endif
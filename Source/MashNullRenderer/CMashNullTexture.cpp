@@ -0,0 +1,135 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#include "CMashNullTexture.h"
+#include "CMashNullRenderer.h"
+#include "MashHelper.h"
+#include "MashLog.h"
+#include <cstring>
+
+namespace mash
+{
+	CMashNullTexture::CMashNullTexture(CMashNullRenderer *renderer,
+			uint32 engineID, 
+			const MashStringc &name,
+			bool useMipmaps,
+			eUSAGE usage,
+			uint32 width,
+			uint32 height,
+			eFORMAT format,
+			bool isCube):MashTexture(), m_renderer(renderer), m_name(name), m_engineID(engineID),
+			m_usage(usage), m_format(format), m_useMipmaps(useMipmaps), m_isCube(isCube),
+			m_width(width), m_height(height), m_mipmapCount(1), m_data(0), m_lockType(aLOCK_WRITE),
+			m_isLocked(false)
+	{
+		if (m_useMipmaps)
+		{
+			uint32 size = (m_width > m_height)?m_width:m_height;
+			while(size > 1)
+			{
+				size >>= 1;
+				++m_mipmapCount;
+			}
+		}
+	}
+
+	CMashNullTexture::~CMashNullTexture()
+	{
+		if (m_data)
+		{
+			MASH_FREE(m_data);
+			m_data = 0;
+		}
+	}
+
+	uint32 CMashNullTexture::GetFaceSizeInBytes()const
+	{
+		return m_width * m_height * mash::helpers::GetFormatSize(m_format);
+	}
+
+	MashTexture* CMashNullTexture::Clone(const MashStringc &sName)const
+	{
+		MashTexture *newTexture = 0;
+		if (m_isCube)
+			newTexture = m_renderer->AddCubeTexture(sName, m_width, m_useMipmaps, m_usage, m_format);
+		else
+			newTexture = m_renderer->AddTexture(sName, m_width, m_height, m_useMipmaps, m_usage, m_format);
+
+		if (!newTexture)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+				"Failed to clone texture.", 
+				"CMashNullTexture::Clone");
+
+			return 0;
+		}
+
+		if (m_data)
+		{
+			void *newData = 0;
+			const uint32 faceCount = (m_isCube)?6:1;
+			for(uint32 face = 0; face < faceCount; ++face)
+			{
+				if (newTexture->Lock(aLOCK_WRITE, &newData, 0, face) == aMASH_OK)
+				{
+					memcpy(newData, m_data + (GetFaceSizeInBytes() * face), GetFaceSizeInBytes());
+					newTexture->Unlock(0, face);
+				}
+			}
+		}
+
+		return newTexture;
+	}
+
+	eMASH_STATUS CMashNullTexture::Lock(eBUFFER_LOCK eType, void **pData, uint32 iLevel, uint32 iFace, uint32 *pRowPitch)
+	{
+		/*
+			Only the top level is stored. Lower mip levels are never
+			sampled so there is nothing to write them to.
+		*/
+		if (m_isLocked || (iLevel > 0) || (iFace >= ((m_isCube)?6U:1U)))
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+				"Failed to lock texture. Invalid level, face, or the texture is already locked.", 
+				"CMashNullTexture::Lock");
+
+			return aMASH_FAILED;
+		}
+
+		const uint32 faceSize = GetFaceSizeInBytes();
+		if (!m_data)
+		{
+			const uint32 totalSize = faceSize * ((m_isCube)?6:1);
+			m_data = MASH_ALLOC_T_COMMON(uint8, totalSize);
+			memset(m_data, 0, totalSize);
+		}
+
+		m_isLocked = true;
+		m_lockType = eType;
+		*pData = m_data + (faceSize * iFace);
+
+		if (pRowPitch)
+			*pRowPitch = m_width * mash::helpers::GetFormatSize(m_format);
+
+		return aMASH_OK;
+	}
+
+	eMASH_STATUS CMashNullTexture::Unlock(uint32 iLevel, uint32 iFace)
+	{
+		if (!m_isLocked)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+				"Failed to unlock texture. The texture was not locked.", 
+				"CMashNullTexture::Unlock");
+
+			return aMASH_FAILED;
+		}
+
+		m_isLocked = false;
+		m_renderer->_RecordCommand(aNULL_CMD_UPDATE_TEXTURE, this, GetFaceSizeInBytes(), m_lockType, iLevel, iFace);
+
+		return aMASH_OK;
+	}
+}
@@ -0,0 +1,92 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#ifndef _C_MASH_NULL_TEXTURE_H_
+#define _C_MASH_NULL_TEXTURE_H_
+
+#include "MashTexture.h"
+namespace mash
+{
+	class CMashNullRenderer;
+
+	/*
+		Used for both 2D and cube textures. Texel memory is only
+		allocated the first time the texture is locked.
+	*/
+	class CMashNullTexture : public MashTexture
+	{
+	private:
+		CMashNullRenderer *m_renderer;
+		MashStringc m_name;
+		uint32 m_engineID;
+		eUSAGE m_usage;
+		eFORMAT m_format;
+		bool m_useMipmaps;
+		bool m_isCube;
+		uint32 m_width;
+		uint32 m_height;
+		uint32 m_mipmapCount;
+		uint8 *m_data;
+		eBUFFER_LOCK m_lockType;
+		bool m_isLocked;
+
+		uint32 GetFaceSizeInBytes()const;
+	public:
+		CMashNullTexture(CMashNullRenderer *renderer,
+			uint32 engineID, 
+			const MashStringc &name,
+			bool useMipmaps,
+			eUSAGE usage,
+			uint32 width,
+			uint32 height,
+			eFORMAT format,
+			bool isCube);
+
+		~CMashNullTexture();
+
+		MashTexture* Clone(const MashStringc &sName)const;
+		eMASH_STATUS Lock(eBUFFER_LOCK eType, void **pData, uint32 iLevel = 0, uint32 iFace = 0, uint32 *pRowPitch = 0);
+		eMASH_STATUS Unlock(uint32 iLevel = 0, uint32 iFace = 0);
+		eRESOURCE_TYPE GetType()const;
+		const MashStringc& GetName()const;
+		void GetSize(uint32 &iWidth, uint32 &iHeight)const;
+		uint32 GetTextureID()const;
+		uint32 GetMipmapCount()const;
+		eUSAGE GetUsageType()const;
+	};
+
+	inline uint32 CMashNullTexture::GetMipmapCount()const
+	{
+		return m_mipmapCount;
+	}
+
+	inline eUSAGE CMashNullTexture::GetUsageType()const
+	{
+		return m_usage;
+	}
+
+	inline uint32 CMashNullTexture::GetTextureID()const
+	{
+		return m_engineID;
+	}
+
+	inline const MashStringc& CMashNullTexture::GetName()const
+	{
+		return m_name;
+	}
+
+	inline void CMashNullTexture::GetSize(uint32 &iWidth, uint32 &iHeight)const
+	{
+		iWidth = m_width;
+		iHeight = m_height;
+	}
+
+	inline eRESOURCE_TYPE CMashNullTexture::GetType()const
+	{
+		return (m_isCube)?aRESOURCE_CUBE_TEXTURE:aRESOURCE_TEXTURE;
+	}
+}
+
+#endif
@@ -0,0 +1,54 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#include "CMashNullVertex.h"
+#include "MashLog.h"
+#include "MashTechnique.h"
+#include "MashTechniqueInstance.h"
+#include "MashMaterial.h"
+#include "MashEffect.h"
+#include "MashVideo.h"
+namespace mash
+{
+	CMashNullVertex::CMashNullVertex(const sMashVertexElement *pMashVertexDecl,
+		uint32 iElementCount,
+		uint32 iVertexSizeInBytes):MashVertexIntermediate(pMashVertexDecl, iElementCount, iVertexSizeInBytes),
+		m_isCompiled(false)
+	{
+	}
+
+	CMashNullVertex::~CMashNullVertex()
+	{
+	}
+
+	void CMashNullVertex::OnDependencyCompiled(MashVideo *renderer, MashMaterialDependentResourceBase *dependency)
+	{
+		if (IsValid())
+			return;
+
+		MashMaterial *material = (MashMaterial*)dependency;
+		MashEffect *effect = material->GetActiveTechnique()->GetTechnique()->GetEffect();
+
+		if (!effect || !effect->IsValid())
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+					"A valid effect program was not supplied.", 
+					"CMashNullVertex::OnDependencyCompiled");
+			return;
+		}
+
+		/*
+			There is no input layout to build. The declaration only needs to
+			wait on the material so that dependent mesh buffers are validated in
+			the same order as the other renderers.
+		*/
+		m_isCompiled = true;
+
+		/*
+			Build anything relying on this.
+		*/
+		renderer->_OnDependencyCompiled(this);
+	}
+}
@@ -0,0 +1,33 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#ifndef _C_MASH_NULL_VERTEX_H_
+#define _C_MASH_NULL_VERTEX_H_
+
+#include "MashVertexIntermediate.h"
+#include "MashMaterialDependentResource.h"
+namespace mash
+{
+	class CMashNullVertex : public MashVertexIntermediate, public MashMaterialDependentResource<CMashNullVertex>
+	{
+	private:
+		bool m_isCompiled;
+	public:
+		CMashNullVertex(const sMashVertexElement *pMashVertexDecl,
+			uint32 iElementCount,
+			uint32 iVertexSizeInBytes);
+		~CMashNullVertex();
+
+		bool IsValid()const;
+		void OnDependencyCompiled(MashVideo *renderer, MashMaterialDependentResourceBase *dependency);
+	};
+
+	inline bool CMashNullVertex::IsValid()const
+	{
+		return m_isCompiled;
+	}
+}
+
+#endif
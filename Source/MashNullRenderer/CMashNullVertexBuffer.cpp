@@ -0,0 +1,114 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#include "CMashNullVertexBuffer.h"
+#include "CMashNullRenderer.h"
+#include "MashLog.h"
+#include <cstring>
+
+namespace mash
+{
+	CMashNullVertexBuffer::CMashNullVertexBuffer(CMashNullRenderer *pRenderer,
+			const void *data,
+			eUSAGE usage,
+			uint32 size):MashVertexBuffer(),m_pRenderer(pRenderer),
+			m_data(0), m_usage(usage), m_size(size), m_lockType(aLOCK_WRITE), m_isLocked(false)
+	{
+		if (m_size > 0)
+		{
+			m_data = MASH_ALLOC_T_COMMON(uint8, m_size);
+
+			if (data)
+				memcpy(m_data, data, m_size);
+			else
+				memset(m_data, 0, m_size);
+		}
+	}
+
+	CMashNullVertexBuffer::~CMashNullVertexBuffer()
+	{
+		if (m_data)
+		{
+			MASH_FREE(m_data);
+			m_data = 0;
+		}
+	}
+
+	eMASH_STATUS CMashNullVertexBuffer::Resize(uint32 newSize, bool saveData)
+	{
+		uint8 *newData = 0;
+		if (newSize > 0)
+		{
+			newData = MASH_ALLOC_T_COMMON(uint8, newSize);
+			memset(newData, 0, newSize);
+
+			if (saveData && m_data)
+				memcpy(newData, m_data, (m_size > newSize)?newSize:m_size);
+		}
+
+		if (m_data)
+			MASH_FREE(m_data);
+
+		m_data = newData;
+		m_size = newSize;
+
+		m_pRenderer->_RecordCommand(aNULL_CMD_UPDATE_BUFFER, this, m_size, aLOCK_WRITE_DISCARD);
+
+		return aMASH_OK;
+	}
+
+	eMASH_STATUS CMashNullVertexBuffer::Copy(const MashVertexBuffer *from)
+	{
+		const CMashNullVertexBuffer *nullFromBuffer = (const CMashNullVertexBuffer*)from;
+		const uint32 amountToWrite = (m_size > nullFromBuffer->GetBufferSize())?nullFromBuffer->GetBufferSize():m_size;
+
+		if (amountToWrite > 0)
+			memcpy(m_data, nullFromBuffer->GetData(), amountToWrite);
+
+		m_pRenderer->_RecordCommand(aNULL_CMD_UPDATE_BUFFER, this, amountToWrite, aLOCK_WRITE);
+
+		return aMASH_OK;
+	}
+
+	MashVertexBuffer* CMashNullVertexBuffer::Clone()const
+	{
+		return m_pRenderer->CreateVertexBuffer(m_data, m_size, m_usage);
+	}
+
+	eMASH_STATUS CMashNullVertexBuffer::Lock(eBUFFER_LOCK eType, void **pData)const
+	{
+		if (m_isLocked)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+				"Vertex buffer is already locked.", 
+				"CMashNullVertexBuffer::Lock");
+
+			return aMASH_FAILED;
+		}
+
+		m_isLocked = true;
+		m_lockType = eType;
+		*pData = m_data;
+
+		return aMASH_OK;
+	}
+
+	eMASH_STATUS CMashNullVertexBuffer::Unlock()const
+	{
+		if (!m_isLocked)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
+				"Failed to unmap vertex buffer. The buffer was not locked.", 
+				"CMashNullVertexBuffer::Unlock");
+
+			return aMASH_FAILED;
+		}
+
+		m_isLocked = false;
+		m_pRenderer->_RecordCommand(aNULL_CMD_UPDATE_BUFFER, this, m_size, m_lockType);
+
+		return aMASH_OK;
+	}
+}
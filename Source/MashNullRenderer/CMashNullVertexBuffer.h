@@ -0,0 +1,68 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#ifndef _C_MASH_NULL_VERTEX_BUFFER_H_
+#define _C_MASH_NULL_VERTEX_BUFFER_H_
+
+#include "MashVertexBuffer.h"
+namespace mash
+{
+	class CMashNullRenderer;
+
+	/*
+		Vertex data is held in system memory. Locks return a pointer
+		directly into this memory and unlocks are recorded as buffer updates.
+	*/
+	class CMashNullVertexBuffer : public MashVertexBuffer
+	{
+	private:
+		CMashNullRenderer *m_pRenderer;
+		uint8 *m_data;
+		eUSAGE m_usage;
+		uint32 m_size;
+		mutable eBUFFER_LOCK m_lockType;
+		mutable bool m_isLocked;
+	public:
+		CMashNullVertexBuffer(CMashNullRenderer *pRenderer,
+			const void *data,
+			eUSAGE usage,
+			uint32 size);
+
+		~CMashNullVertexBuffer();
+
+		eMASH_STATUS Copy(const MashVertexBuffer *from);
+		MashVertexBuffer* Clone()const;
+
+		eMASH_STATUS Resize(uint32 newSize, bool saveData = false);
+		uint32 GetBufferSize()const;
+		eMASH_STATUS Lock(eBUFFER_LOCK eType, void **pData)const;
+		eMASH_STATUS Unlock()const;
+		eRESOURCE_TYPE GetType()const;
+		eUSAGE GetUsageType()const;
+		const uint8* GetData()const;
+	};
+
+	inline uint32 CMashNullVertexBuffer::GetBufferSize()const
+	{
+		return m_size;
+	}
+
+	inline const uint8* CMashNullVertexBuffer::GetData()const
+	{
+		return m_data;
+	}
+
+	inline eUSAGE CMashNullVertexBuffer::GetUsageType()const
+	{
+		return m_usage;
+	}
+
+	inline eRESOURCE_TYPE CMashNullVertexBuffer::GetType()const
+	{
+		return aRESOURCE_VERTEX;
+	}
+}
+
+#endif
@@ -119,7 +119,7 @@ namespace mash
 		return 0;
 	}
 
-	eMASH_STATUS CMashOpenGLCubeTexture::Lock(eBUFFER_LOCK eType, void **pData, uint32 iLevel, uint32 iFace)
+	eMASH_STATUS CMashOpenGLCubeTexture::Lock(eBUFFER_LOCK eType, void **pData, uint32 iLevel, uint32 iFace, uint32 *pRowPitch)
 	{
 		if (m_PBOOpenGLID[iFace] == -1)
 		{
@@ -156,6 +156,10 @@ namespace mash
 		
 		*pData = glMapBufferPtr(m_PBOOpenGLID[iFace], GL_WRITE_ONLY);
 
+		//the pixel buffer is tightly packed
+		if (pRowPitch)
+			*pRowPitch = m_width * m_pixelSizeInBytes;
+
 		return aMASH_OK;
 	}
 
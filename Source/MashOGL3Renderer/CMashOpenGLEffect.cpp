@@ -24,11 +24,39 @@
 
 namespace mash
 {
-	CMashOglSharedUniformBuffer::CMashOglSharedUniformBuffer(CMashOpenGLSkinManager *_manager, const MashStringc &_bufferName, GLuint _uboIndex, GLuint _bindingIndex, GLuint _bufferSize):uboIndex(_uboIndex), 
-		bindingIndex(_bindingIndex), bufferSize(_bufferSize), bufferName(_bufferName), manager(_manager)
+	CMashOglSharedUniformBuffer::CMashOglSharedUniformBuffer(CMashOpenGLSkinManager *_manager, const MashStringID &_bufferName, GLuint _uboIndex, GLuint _bindingIndex, GLuint _bufferSize):uboIndex(_uboIndex), 
+		bindingIndex(_bindingIndex), bufferSize(_bufferSize), bufferName(_bufferName), manager(_manager),
+		lastData(0), lastDataSize(0)
 	{
 	}
 
+	bool CMashOglSharedUniformBuffer::OnDataChange(const void *data, uint32 sizeInBytes)
+	{
+		if (lastData && (lastDataSize == sizeInBytes) && (memcmp(lastData, data, sizeInBytes) == 0))
+			return false;
+
+		if (lastDataSize != sizeInBytes)
+		{
+			if (lastData)
+				MASH_FREE(lastData);
+
+			lastData = (uint8*)MASH_ALLOC_COMMON(sizeInBytes);
+			lastDataSize = sizeInBytes;
+		}
+
+		memcpy(lastData, data, sizeInBytes);
+		return true;
+	}
+
+	void CMashOglSharedUniformBuffer::InvalidateData()
+	{
+		if (lastData)
+			MASH_FREE(lastData);
+
+		lastData = 0;
+		lastDataSize = 0;
+	}
+
     CMashOglSharedUniformBuffer::~CMashOglSharedUniformBuffer()
     {
 		/*
@@ -41,6 +69,8 @@ namespace mash
 			manager->_OnSharedUniformBufferDelete(this);
 
         glDeleteBuffersPtr(1, &uboIndex);
+
+		InvalidateData();
     }
     
 	CMashOpenGLEffect::CMashOpenGLEffect(CMashOpenGLRenderer *renderer):MashEffect(),m_pRenderer(renderer),
@@ -67,14 +97,14 @@ namespace mash
             m_programs[i] = 0;
         }
         
-        std::map<MashStringc, CMashOpenGLEffectParamHandle*>::iterator iterParam = m_parameters.begin();
-        std::map<MashStringc, CMashOpenGLEffectParamHandle*>::iterator iterParamEnd = m_parameters.end();
-        for(; iterParam != iterParamEnd; ++iterParam)
+        const uint32 paramSlotCount = m_parameters.GetSlotCount();
+        for(uint32 i = 0; i < paramSlotCount; ++i)
         {
-            MASH_DELETE iterParam->second;
+            if (m_parameters.IsSlotUsed(i))
+                MASH_DELETE m_parameters.GetSlotValue(i);
         }
         
-        m_parameters.clear();
+        m_parameters.Clear();
 
 	}
 
@@ -262,12 +292,13 @@ namespace mash
 
 		m_autoParameters.Clear();
 
-		std::map<MashStringc, CMashOpenGLEffectParamHandle*>::iterator iter = m_parameters.begin();
-		for(; iter != m_parameters.end(); ++iter)
+		const uint32 paramSlotCount = m_parameters.GetSlotCount();
+		for(uint32 i = 0; i < paramSlotCount; ++i)
 		{
-			iter->second->Drop();
+			if (m_parameters.IsSlotUsed(i))
+				m_parameters.GetSlotValue(i)->Drop();
 		}
-		m_parameters.clear();
+		m_parameters.Clear();
 
 		for(uint32 i = 0; i < aPROGRAM_UNKNOWN; ++i)
 		{
@@ -474,7 +505,7 @@ namespace mash
 					if (paramLocation != -1)
 					{
                         CMashOpenGLEffectParamHandle *newParam = MASH_NEW_COMMON CMashOpenGLEffectParamHandle(paramLocation, paramType, paramSize);
-						m_parameters[paramName] = newParam;
+						m_parameters.Insert(MashStringID(paramName), newParam);
                         
                         isStructParam = false;
 						mash::helpers::GetAutoEffectParameterName(paramName, newParamName, semanticIndex, isStructParam);
@@ -497,6 +528,9 @@ namespace mash
 												"CMashOpenGLEffect::_Compile",
 												"Adding auto parameter '%s' size '%d'.", paramName, paramSize);
 							}
+
+							//per object data changes nearly every draw so tracking it would only add a compare
+							newParam->_SetChangeTracking(m_pRenderer->GetMaterialManager()->GetAutoParameterUpdateRate(semanticType) != aAUTO_PARAM_UPDATE_PER_OBJECT);
                             
 							m_autoParameters.PushBack(sAutoParameter(newParam, semanticType, semanticIndex));
 						}
@@ -542,17 +576,21 @@ namespace mash
                     glGetActiveUniformBlockivPtr(m_openGLProgamID, i, GL_UNIFORM_BLOCK_DATA_SIZE, &uniformBlockSize);
 
 					CMashOpenGLSkinManager *skinManager = (CMashOpenGLSkinManager*)m_pRenderer->GetMaterialManager();
-					CMashOglSharedUniformBuffer *sharedUbo = skinManager->GetSharedUniformBuffer(uniformBufferName, uniformBlockSize);
+					const MashStringID uniformBufferID(uniformBufferName);
+					CMashOglSharedUniformBuffer *sharedUbo = skinManager->GetSharedUniformBuffer(uniformBufferID, uniformBlockSize);
 
 					if (sharedUbo)
 					{
 						CMashOpenGLEffectParamHandle *newParam = MASH_NEW_COMMON CMashOpenGLEffectParamHandle(i, GL_UNIFORM_BUFFER, uniformBlockSize, sharedUbo);
                         
                         sharedUbo->Drop();
+
+						//changes are tracked by the shared buffer so each effect doesn't hold its own copy
+						newParam->_SetChangeTracking(false);
 						
                         glUniformBlockBindingPtr (m_openGLProgamID, i, sharedUbo->bindingIndex);
 
-						m_parameters[uniformBufferName] = newParam;
+						m_parameters.Insert(uniformBufferID, newParam);
 
 						int8 newParamName[256];//make dynamic buffer
 						newParamName[0] = 0;
@@ -580,11 +618,17 @@ namespace mash
 
 	void CMashOpenGLEffect::SetMatrix(MashEffectParamHandle *pHandle, const mash::MashMatrix4 *data, uint32 count)
 	{  
+		if (!m_pRenderer->_OnConstantDataChange(pHandle, data, sizeof(mash::MashMatrix4) * count))
+			return;
+
         glUniformMatrix4fvPtr(((CMashOpenGLEffectParamHandle*)pHandle)->GetOpenGLLocation(), count, false, (GLfloat*)data->m);
 	}
 
 	void CMashOpenGLEffect::SetInt(MashEffectParamHandle *pHandle, const int32 *data, uint32 count)
 	{
+		if (!m_pRenderer->_OnConstantDataChange(pHandle, data, sizeof(int32) * count))
+			return;
+
 		CMashOpenGLEffectParamHandle *openGLHandle = (CMashOpenGLEffectParamHandle*)pHandle;
 		if (openGLHandle->GetOpenGLSize() > 1)
 		{
@@ -598,6 +642,9 @@ namespace mash
 
 	void CMashOpenGLEffect::SetVector2(MashEffectParamHandle *pHandle, const mash::MashVector2 *data, uint32 count)
 	{
+		if (!m_pRenderer->_OnConstantDataChange(pHandle, data, sizeof(mash::MashVector2) * count))
+			return;
+
 		CMashOpenGLEffectParamHandle *openGLHandle = (CMashOpenGLEffectParamHandle*)pHandle;
 		switch(openGLHandle->GetOpenGLType())
 		{
@@ -632,6 +679,9 @@ namespace mash
 
 	void CMashOpenGLEffect::SetVector3(MashEffectParamHandle *pHandle, const mash::MashVector3 *data, uint32 count)
 	{
+		if (!m_pRenderer->_OnConstantDataChange(pHandle, data, sizeof(mash::MashVector3) * count))
+			return;
+
 		CMashOpenGLEffectParamHandle *openGLHandle = (CMashOpenGLEffectParamHandle*)pHandle;
 		switch(openGLHandle->GetOpenGLType())
 		{
@@ -666,6 +716,9 @@ namespace mash
 
 	void CMashOpenGLEffect::SetBool(MashEffectParamHandle *pHandle, const bool *data, uint32 count)
 	{
+		if (!m_pRenderer->_OnConstantDataChange(pHandle, data, sizeof(bool) * count))
+			return;
+
 		CMashOpenGLEffectParamHandle *openGLHandle = (CMashOpenGLEffectParamHandle*)pHandle;
 		if (openGLHandle->GetOpenGLSize() > 1)
 		{
@@ -679,6 +732,9 @@ namespace mash
 
 	void CMashOpenGLEffect::SetFloat(MashEffectParamHandle *pHandle, const f32 *data, uint32 count)
 	{
+		if (!m_pRenderer->_OnConstantDataChange(pHandle, data, sizeof(f32) * count))
+			return;
+
 		CMashOpenGLEffectParamHandle *openGLHandle = (CMashOpenGLEffectParamHandle*)pHandle;
 		if (openGLHandle->GetOpenGLSize() > 1)
 		{
@@ -692,6 +748,9 @@ namespace mash
 
 	void CMashOpenGLEffect::SetVector4(MashEffectParamHandle *pHandle, const mash::MashVector4 *data, uint32 count)
 	{
+		if (!m_pRenderer->_OnConstantDataChange(pHandle, data, sizeof(mash::MashVector4) * count))
+			return;
+
 		CMashOpenGLEffectParamHandle *openGLHandle = (CMashOpenGLEffectParamHandle*)pHandle;
 		switch(openGLHandle->GetOpenGLType())
 		{
@@ -733,7 +792,7 @@ namespace mash
 		CMashOpenGLEffectParamHandle *openGLHandle = (CMashOpenGLEffectParamHandle*)pHandle;
 
         {
-            const CMashOglSharedUniformBuffer *uboSharedData = openGLHandle->GetOpenGLUBO();
+            CMashOglSharedUniformBuffer *uboSharedData = openGLHandle->GetOpenGLUBO();
             if (!uboSharedData)
             {
                 MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
@@ -751,6 +810,19 @@ namespace mash
                 
                 return;
             }
+
+            /*
+				The buffer is shared by name between effects so data such as
+				per frame lighting only needs to be uploaded once per change.
+			*/
+            if (!uboSharedData->OnDataChange(pData, iSizeInBytes))
+            {
+                m_pRenderer->_OnConstantUploadSkipped();
+                return;
+            }
+
+            m_pRenderer->_OnConstantDataUploaded(iSizeInBytes);
+
             //GLenum e1 = glGetError();
             glBindBufferPtr(GL_UNIFORM_BUFFER, uboSharedData->uboIndex);
             
@@ -817,9 +889,18 @@ namespace mash
 
 	MashEffectParamHandle* CMashOpenGLEffect::GetParameterByName(const int8 *sName, ePROGRAM_TYPE type)
 	{
-		std::map<MashStringc, CMashOpenGLEffectParamHandle*>::iterator iter = m_parameters.find(sName);
-		if (iter != m_parameters.end())
-			return iter->second;
+		CMashOpenGLEffectParamHandle **param = m_parameters.Find(sName);
+		if (param)
+			return *param;
+
+		return 0;
+	}
+
+	MashEffectParamHandle* CMashOpenGLEffect::GetParameterByName(const MashStringID &name, ePROGRAM_TYPE type)
+	{
+		CMashOpenGLEffectParamHandle **param = m_parameters.Find(name);
+		if (param)
+			return *param;
 
 		return 0;
 	}
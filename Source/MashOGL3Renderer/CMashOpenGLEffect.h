@@ -9,7 +9,7 @@
 #include "MashEffect.h"
 #include "CMashOpenGLEffectProgram.h"
 #include "CMashOpenGLHelper.h"
-#include <map>
+#include "MashStringIDMap.h"
 #include "MashArray.h"
 namespace mash
 {
@@ -19,14 +19,26 @@ namespace mash
 	class CMashOglSharedUniformBuffer : public MashReferenceCounter
 	{
 	public:
-		CMashOglSharedUniformBuffer(CMashOpenGLSkinManager *_manager, const MashStringc &_bufferName, GLuint _uboIndex, GLuint _bindingIndex, GLuint _bufferSize);
+		CMashOglSharedUniformBuffer(CMashOpenGLSkinManager *_manager, const MashStringID &_bufferName, GLuint _uboIndex, GLuint _bindingIndex, GLuint _bufferSize);
 		~CMashOglSharedUniformBuffer();
 
         CMashOpenGLSkinManager *manager;
-        MashStringc bufferName;
+        MashStringID bufferName;
 		GLuint uboIndex;
 		GLuint bindingIndex;
 		GLuint bufferSize;
+
+		/*
+			Copy of the data last sent to the buffer. Used to skip uploads
+			when multiple effects set the same data, eg, per frame light data.
+		*/
+		uint8 *lastData;
+		uint32 lastDataSize;
+
+		//returns true if the data differs from the last upload
+		bool OnDataChange(const void *data, uint32 sizeInBytes);
+		//called when the buffer contents are lost
+		void InvalidateData();
 	};
 
 	class CMashOpenGLEffectParamHandle : public MashEffectParamHandle
@@ -124,7 +136,7 @@ namespace mash
 		CMashOpenGLRenderer *m_pRenderer;
 		MashArray<sMashOpenGLVertexAttribute> m_vertexInputAttributes;
 		MashArray<sAutoParameter> m_autoParameters;
-		std::map<MashStringc, CMashOpenGLEffectParamHandle*> m_parameters;
+		MashStringIDMap<CMashOpenGLEffectParamHandle*> m_parameters;
 		CMashOpenGLEffectProgram *m_programs[aPROGRAM_UNKNOWN];
 		bool m_bIsValid;
 		bool m_bIsCompiled;
@@ -151,6 +163,7 @@ namespace mash
 
 		//doesnt pay any attention to program type
 		MashEffectParamHandle* GetParameterByName(const int8 *sName, ePROGRAM_TYPE type);
+		MashEffectParamHandle* GetParameterByName(const MashStringID &name, ePROGRAM_TYPE type);
 
 		bool IsValid()const;
 		bool IsCompiled()const;
@@ -127,7 +127,15 @@ namespace mash
             glBufferDataPtr(GL_ELEMENT_ARRAY_BUFFER, m_size, 0, flag);
 		}
 
-        *pData = glMapBufferPtr(GL_ELEMENT_ARRAY_BUFFER, GL_WRITE_ONLY);
+		if (eType == aLOCK_WRITE_NOOVERWRITE)
+		{
+			//see CMashOpenGLVertexBuffer::Lock()
+			*pData = glMapBufferRangePtr(GL_ELEMENT_ARRAY_BUFFER, 0, m_size, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+		}
+		else
+		{
+			*pData = glMapBufferPtr(GL_ELEMENT_ARRAY_BUFFER, GL_WRITE_ONLY);
+		}
 
 		return aMASH_OK;
 	}
@@ -23,6 +23,9 @@
 #include "MashMaterialDependentResource.h"
 #include "MashLog.h"
 #include "SOIL.h"
+#include "CMashOpenGLTextureDecoder.h"
+#include "OpenGL3/MashTextureCooker.h"
+#include <cstring>
 
 #ifdef MASH_WINDOWS
 #include "MashDevice.h"
@@ -1400,8 +1403,6 @@ namespace mash
 
 	MashTexture* CMashOpenGLRenderer::LoadTextureFromFile(const MashStringc &fileName)
 	{        
-
-		GLenum e1 = glGetError();
 		MashFileStream *pFileStream = m_pFileManager->CreateFileStream();
 		if (pFileStream->LoadFile(fileName.GetCString(), aFILE_IO_BINARY) == aMASH_FAILED)
 		{
@@ -1413,23 +1414,40 @@ namespace mash
 			return 0;
 		}
 
-		uint32 openGLTexID = SOIL_load_OGL_texture_from_memory((const uint8*)pFileStream->GetData(),
-			pFileStream->GetDataSizeInBytes(),
+		MashTexture *texture = LoadTextureFromMemory(fileName, (const uint8*)pFileStream->GetData(), pFileStream->GetDataSizeInBytes());
+		pFileStream->Destroy();
+
+		return texture;
+	}
+
+	MashTexture* CMashOpenGLRenderer::LoadTextureFromMemory(const MashStringc &fileName, const uint8 *data, uint32 sizeInBytes)
+	{
+		GLenum e1 = glGetError();
+
+		/*
+			Cooked files (see CookTexture()) are uploaded as is. They are already flipped
+			and include a full mip chain. Other formats, including DDS files from other
+			tools, are decoded and processed here.
+		*/
+		uint32 loadFlags = SOIL_FLAG_POWER_OF_TWO | SOIL_FLAG_MIPMAPS | SOIL_FLAG_INVERT_Y;
+		if (IsCookedTextureDirectUpload(data, sizeInBytes))
+			loadFlags = SOIL_FLAG_DDS_LOAD_DIRECT;
+
+		uint32 openGLTexID = SOIL_load_OGL_texture_from_memory(data,
+			sizeInBytes,
 			0,
 			SOIL_CREATE_NEW_ID,
-			SOIL_FLAG_POWER_OF_TWO | SOIL_FLAG_MIPMAPS | SOIL_FLAG_INVERT_Y);
-
-		pFileStream->Destroy();
+			loadFlags);
 
 		if (openGLTexID == 0)
 		{
 			MASH_WRITE_TO_LOG_EX(MashLog::aERROR_LEVEL_ERROR,
-				"CMashOpenGLRenderer::LoadTextureFromFile",
+				"CMashOpenGLRenderer::LoadTextureFromMemory",
 				"Failed to load texture '%s'.", fileName.GetCString());
 
 			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR, 
 				SOIL_last_result(), 
-				"CMashOpenGLRenderer::LoadTextureFromFile");
+				"CMashOpenGLRenderer::LoadTextureFromMemory");
 
 			return 0;
 		}
@@ -1464,6 +1482,127 @@ namespace mash
 		return texture;
 	}
 
+	MashTexture* CMashOpenGLRenderer::UploadDecodedTexture(const MashStringc &fileName, const CMashOpenGLTextureDecodeJob *decodedTexture)
+	{
+		GLint maxTextureSize = 0;
+		glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+
+		//levels too large for the device are skipped
+		const uint8 *levelData = decodedTexture->GetImageData();
+		uint32 width = decodedTexture->GetWidth();
+		uint32 height = decodedTexture->GetHeight();
+		uint32 firstLevel = 0;
+		while((firstLevel < (decodedTexture->GetMipmapCount() - 1)) && 
+			((width > (uint32)maxTextureSize) || (height > (uint32)maxTextureSize)))
+		{
+			levelData += width * height * 4;
+			width = (width > 1) ? (width / 2) : 1;
+			height = (height > 1) ? (height / 2) : 1;
+			++firstLevel;
+		}
+
+		const uint32 levelCount = decodedTexture->GetMipmapCount() - firstLevel;
+		const uint32 topWidth = width;
+		const uint32 topHeight = height;
+
+		GLuint openGLTexID = 0;
+		glGenTextures(1, &openGLTexID);
+		glBindTexture(GL_TEXTURE_2D, openGLTexID);
+
+		for(uint32 level = 0; level < levelCount; ++level)
+		{
+			glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, levelData);
+
+			levelData += width * height * 4;
+			width = (width > 1) ? (width / 2) : 1;
+			height = (height > 1) ? (height / 2) : 1;
+		}
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (levelCount > 1) ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		if (glGetError() != GL_NO_ERROR)
+		{
+			MASH_WRITE_TO_LOG_EX(MashLog::aERROR_LEVEL_ERROR,
+				"CMashOpenGLRenderer::UploadDecodedTexture",
+				"Failed to upload texture '%s'.", fileName.GetCString());
+
+			glDeleteTextures(1, &openGLTexID);
+			return 0;
+		}
+
+		MashTexture *texture = MASH_NEW_COMMON CMashOpenGLTexture(this, openGLTexID, m_textureIDCounter++,
+			fileName, true, aUSAGE_STATIC, topWidth, topHeight, GL_RGBA, GL_UNSIGNED_BYTE, 4);
+
+		m_textures.insert(std::make_pair(fileName, texture));
+
+		return texture;
+	}
+
+	void CMashOpenGLRenderer::LoadTexturesFromFiles(const MashStringc *fileNames, uint32 count)
+	{
+		/*
+			File access isn't thread safe so all files are read up front on this thread.
+			Decoding and mipmap generation is then done on worker threads, and the results
+			uploaded back on this thread.
+		*/
+		MashArray<MashFileStream*> fileStreams(count, 0);
+		MashArray<MashJob*> decodeJobs;
+		MashArray<uint32> decodeJobFiles;
+		for(uint32 i = 0; i < count; ++i)
+		{
+			MashFileStream *fileStream = m_pFileManager->CreateFileStream();
+			if (fileStream->LoadFile(fileNames[i].GetCString(), aFILE_IO_BINARY) == aMASH_FAILED)
+			{
+				MASH_WRITE_TO_LOG_EX(MashLog::aERROR_LEVEL_ERROR,
+					"CMashOpenGLRenderer::LoadTexturesFromFiles",
+					"Failed to load texture '%s'.", fileNames[i].GetCString());
+
+				fileStream->Destroy();
+				continue;
+			}
+
+			const uint8 *data = (const uint8*)fileStream->GetData();
+			const uint32 sizeInBytes = fileStream->GetDataSizeInBytes();
+
+			//cooked files are already processed and can be uploaded directly
+			if (IsCookedTextureDirectUpload(data, sizeInBytes))
+			{
+				LoadTextureFromMemory(fileNames[i], data, sizeInBytes);
+				fileStream->Destroy();
+				continue;
+			}
+
+			fileStreams[i] = fileStream;
+			decodeJobs.PushBack(MASH_NEW_COMMON CMashOpenGLTextureDecodeJob(data, sizeInBytes));
+			decodeJobFiles.PushBack(i);
+		}
+
+		if (!decodeJobs.Empty())
+			jobs::RunJobs(decodeJobs.Pointer(), decodeJobs.Size());
+
+		for(uint32 i = 0; i < decodeJobs.Size(); ++i)
+		{
+			const CMashOpenGLTextureDecodeJob *decodeJob = (CMashOpenGLTextureDecodeJob*)decodeJobs[i];
+			const uint32 fileIndex = decodeJobFiles[i];
+			if (decodeJob->GetImageData())
+			{
+				UploadDecodedTexture(fileNames[fileIndex], decodeJob);
+			}
+			else
+			{
+				//decoding failed, this will log the reason
+				LoadTextureFromMemory(fileNames[fileIndex], (const uint8*)fileStreams[fileIndex]->GetData(), 
+					fileStreams[fileIndex]->GetDataSizeInBytes());
+			}
+
+			MASH_DELETE decodeJob;
+			fileStreams[fileIndex]->Destroy();
+		}
+	}
+
 	MashTexture* CMashOpenGLRenderer::AddTexture(const MashStringc &sOldName,
 										uint32 iWidth, 
 										uint32 iHeight, 
@@ -1850,11 +1989,11 @@ namespace mash
 	}
 
 	eMASH_STATUS CMashOpenGLRenderer::DrawVertexList(const MashMeshBuffer *buffer, uint32 iVertexCount,
-			uint32 iPrimitiveCount, ePRIMITIVE_TYPE ePrimType/*, MashTechniqueInstance *pTechnique*/)
+			uint32 iPrimitiveCount, ePRIMITIVE_TYPE ePrimType, uint32 firstVertex/*, MashTechniqueInstance *pTechnique*/)
 	{
         glBindVertexArrayPtr(((CMashOpenGLMeshBuffer*)buffer)->GetOpenGLIndex());
 
-		glDrawArrays(MashToOpenGLPrimitiveType(ePrimType), 0, iVertexCount);
+		glDrawArrays(MashToOpenGLPrimitiveType(ePrimType), firstVertex, iVertexCount);
         glBindVertexArrayPtr(0);
 		++m_currentDrawCount;
 		return aMASH_OK;
@@ -17,6 +17,7 @@ namespace mash
     class MashDevice;
     
     class CGLContextObj;
+	class CMashOpenGLTextureDecodeJob;
     
 	class CMashOpenGLRenderer : public MashVideoIntermediate
 	{
@@ -106,6 +107,9 @@ namespace mash
         MashRenderSurface *m_defaultRenderTarget;
 
 		MashTexture* LoadTextureFromFile(const MashStringc &fileName);
+		void LoadTexturesFromFiles(const MashStringc *fileNames, uint32 count);
+		MashTexture* LoadTextureFromMemory(const MashStringc &fileName, const uint8 *data, uint32 sizeInBytes);
+		MashTexture* UploadDecodedTexture(const MashStringc &fileName, const CMashOpenGLTextureDecodeJob *decodedTexture);
         bool IsExtensionSupported(const char *extList, const char *extension);
 	public:
 		CMashOpenGLRenderer();
@@ -188,7 +192,7 @@ namespace mash
 					uint32 iPrimitiveCount, ePRIMITIVE_TYPE ePrimType);
 
 		eMASH_STATUS DrawVertexList(const MashMeshBuffer *buffers, uint32 iVertexCount,
-			uint32 iPrimitiveCount, ePRIMITIVE_TYPE ePrimType);
+			uint32 iPrimitiveCount, ePRIMITIVE_TYPE ePrimType, uint32 firstVertex = 0);
 
 		eMASH_STATUS DrawVertexInstancedList(const MashMeshBuffer *buffer, uint32 iVertexCount,
 				uint32 iPrimitiveCount, ePRIMITIVE_TYPE ePrimType, uint32 instanceCount);
@@ -19,37 +19,39 @@ namespace mash
 
 	CMashOpenGLSkinManager::~CMashOpenGLSkinManager()
 	{
-        m_sharedUniformBuffers.clear();
+        m_sharedUniformBuffers.Clear();
 	}
 
     void CMashOpenGLSkinManager::_OnSharedUniformBufferDelete(CMashOglSharedUniformBuffer *buffer)
     {
-        m_sharedUniformBuffers.erase(buffer->bufferName);
+        m_sharedUniformBuffers.Erase(buffer->bufferName);
         m_freedUniformBufferBindings.push(buffer->bindingIndex);
     }
 
-	CMashOglSharedUniformBuffer* CMashOpenGLSkinManager::GetSharedUniformBuffer(const int8 *name, uint32 bufferSize)
+	CMashOglSharedUniformBuffer* CMashOpenGLSkinManager::GetSharedUniformBuffer(const MashStringID &name, uint32 bufferSize)
 	{
-		std::map<MashStringc, CMashOglSharedUniformBuffer*>::iterator iter = m_sharedUniformBuffers.find(name);
-		if (iter != m_sharedUniformBuffers.end())
+		CMashOglSharedUniformBuffer **existingBuffer = m_sharedUniformBuffers.Find(name);
+		if (existingBuffer)
 		{
-			if (iter->second->bufferSize < bufferSize)
+			CMashOglSharedUniformBuffer *sharedBuffer = *existingBuffer;
+			if (sharedBuffer->bufferSize < bufferSize)
 			{
 				/*
 					Another effect may use a uniform buffer of the same name, and of a different
 					size. This check makes sure the shared buffer is big enough for anything that will
 					use it.
 				*/
-				glBindBufferPtr(GL_UNIFORM_BUFFER, iter->second->uboIndex);
+				glBindBufferPtr(GL_UNIFORM_BUFFER, sharedBuffer->uboIndex);
 				glBufferDataPtr (GL_UNIFORM_BUFFER, bufferSize, 0, GL_DYNAMIC_DRAW);
 				glBindBufferPtr(GL_UNIFORM_BUFFER, 0);
 
-				iter->second->bufferSize = bufferSize;
+				sharedBuffer->bufferSize = bufferSize;
+				sharedBuffer->InvalidateData();
 			}
             
-            iter->second->Grab();
+            sharedBuffer->Grab();
             
-			return iter->second;
+			return sharedBuffer;
 		}
 
 		//create a new buffer
@@ -87,7 +89,7 @@ namespace mash
 		glBindBufferPtr(GL_UNIFORM_BUFFER, 0);
         
 		CMashOglSharedUniformBuffer *newParam = MASH_NEW_COMMON CMashOglSharedUniformBuffer(this, name, uboIndex, bindingIndex, bufferSize);
-		m_sharedUniformBuffers.insert(std::make_pair(name, newParam));
+		m_sharedUniformBuffers.Insert(name, newParam);
 
 		return newParam;
 	}
@@ -8,7 +8,7 @@
 
 #include "MashMaterialManagerIntermediate.h"
 #include "MashFileManager.h"
-#include <map>
+#include "MashStringIDMap.h"
 #include <stack>
 namespace mash
 {
@@ -19,7 +19,7 @@ namespace mash
 	{
 	private:
 		CMashOpenGLRenderer *m_oglRenderer;
-		std::map<MashStringc, CMashOglSharedUniformBuffer*> m_sharedUniformBuffers;
+		MashStringIDMap<CMashOglSharedUniformBuffer*> m_sharedUniformBuffers;
 		std::stack<uint32> m_freedUniformBufferBindings;
 		int32 m_nextUboBindingIndex;
 	public:
@@ -37,7 +37,7 @@ namespace mash
 		/*
 			The returned buffer MUST be dropped when done
 		*/
-		CMashOglSharedUniformBuffer* GetSharedUniformBuffer(const int8 *name, uint32 bufferSize);
+		CMashOglSharedUniformBuffer* GetSharedUniformBuffer(const MashStringID &name, uint32 bufferSize);
         void _OnSharedUniformBufferDelete(CMashOglSharedUniformBuffer *buffer);
 
 		const int8* _GetAPIShaderHeader();
@@ -77,7 +77,7 @@ namespace mash
 		return 0;
 	}
 
-	eMASH_STATUS CMashOpenGLTexture::Lock(eBUFFER_LOCK eType, void **pData, uint32 iLevel, uint32 iFace)
+	eMASH_STATUS CMashOpenGLTexture::Lock(eBUFFER_LOCK eType, void **pData, uint32 iLevel, uint32 iFace, uint32 *pRowPitch)
 	{
 		if (m_PBOOpenGLID == mash::math::MaxUInt32())
 		{
@@ -114,6 +114,10 @@ namespace mash
 		
 		*pData = glMapBufferPtr(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
 
+		//the pixel buffer is tightly packed
+		if (pRowPitch)
+			*pRowPitch = m_width * m_pixelSizeInBytes;
+
 		return aMASH_OK;
 	}
 
@@ -0,0 +1,274 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#include "OpenGL3/MashTextureCooker.h"
+#include "CMashOpenGLTextureDecoder.h"
+#include "MashFileManager.h"
+#include "MashFileStream.h"
+#include "MashMemory.h"
+#include "MashLog.h"
+#include "SOIL.h"
+#include "image_helper.h"
+
+extern "C"
+{
+#include "image_DXT.h"
+}
+
+#include <cstring>
+#include <cstdlib>
+
+namespace mash
+{
+	/*
+		Written to DDS_header::dwReserved1 so cooked files can be told apart from
+		DDS files written by other tools. The flags follow the tag.
+	*/
+	static const uint32 g_cookedTextureTag = ('M' << 0) | ('A' << 8) | ('S' << 16) | ('H' << 24);
+	static const uint32 g_cookedTextureTagIndex = 0;
+	static const uint32 g_cookedTextureFlagsIndex = 1;
+	static const uint32 g_cookedTextureFlagInvertY = 1;
+
+	/*
+		Appends one mip level to the stream in the cooked format.
+		Returns the number of bytes written.
+	*/
+	static uint32 AppendMipLevel(const uint8 *image, uint32 width, uint32 height, eTEXTURE_COOK_FORMAT format, MashFileStream *out)
+	{
+		if (format == aTEXTURE_COOK_FORMAT_RGBA8)
+		{
+			//DDS stores uncompressed data as BGRA
+			const uint32 sizeInBytes = width * height * 4;
+			uint8 *bgra = (uint8*)MASH_ALLOC_COMMON(sizeInBytes);
+			for(uint32 i = 0; i < sizeInBytes; i += 4)
+			{
+				bgra[i] = image[i + 2];
+				bgra[i + 1] = image[i + 1];
+				bgra[i + 2] = image[i];
+				bgra[i + 3] = image[i + 3];
+			}
+
+			out->AppendToStream(bgra, sizeInBytes);
+			MASH_FREE(bgra);
+			return sizeInBytes;
+		}
+
+		int32 compressedSize = 0;
+		uint8 *compressed = 0;
+		if (format == aTEXTURE_COOK_FORMAT_DXT1)
+			compressed = convert_image_to_DXT1(image, width, height, 4, &compressedSize);
+		else
+			compressed = convert_image_to_DXT5(image, width, height, 4, &compressedSize);
+
+		if (!compressed)
+			return 0;
+
+		out->AppendToStream(compressed, compressedSize);
+		//allocated by SOIL
+		free(compressed);
+		return compressedSize;
+	}
+
+	eMASH_STATUS CookTexture(const void *sourceData, uint32 sourceSizeInBytes,
+		const sTextureCookSettings &settings, MashFileStream *out, sTextureCookInfo *info)
+	{
+		if (!sourceData || (sourceSizeInBytes == 0) || !out)
+		{
+			MASH_WRITE_TO_LOG(MashLog::aERROR_LEVEL_ERROR,
+				"Invalid source data or output stream.",
+				"CookTexture");
+
+			return aMASH_FAILED;
+		}
+
+		int32 width = 0;
+		int32 height = 0;
+		int32 sourceChannels = 0;
+		uint8 *image = SOIL_load_image_from_memory((const uint8*)sourceData, sourceSizeInBytes, &width, &height, &sourceChannels, SOIL_LOAD_RGBA);
+		if (!image)
+		{
+			MASH_WRITE_TO_LOG_EX(MashLog::aERROR_LEVEL_ERROR,
+				"CookTexture",
+				"Failed to decode source image. %s", SOIL_last_result());
+
+			return aMASH_FAILED;
+		}
+
+		eTEXTURE_COOK_FORMAT format = settings.format;
+		if (format == aTEXTURE_COOK_FORMAT_AUTO_DXT)
+			format = ((sourceChannels == 2) || (sourceChannels == 4)) ? aTEXTURE_COOK_FORMAT_DXT5 : aTEXTURE_COOK_FORMAT_DXT1;
+
+		if (settings.resizeToPowerOfTwo)
+		{
+			const int32 newWidth = NextPowerOfTwo(width);
+			const int32 newHeight = NextPowerOfTwo(height);
+			if ((newWidth != width) || (newHeight != height))
+			{
+				uint8 *resampled = (uint8*)malloc(newWidth * newHeight * 4);
+				up_scale_image(image, width, height, 4, resampled, newWidth, newHeight);
+				SOIL_free_image_data(image);
+				image = resampled;
+				width = newWidth;
+				height = newHeight;
+			}
+		}
+
+		if (settings.invertY)
+			FlipImageY(image, width, height, 4);
+
+		const uint32 mipmapCount = settings.generateMipmaps ? CalculateMipmapCount(width, height) : 1;
+
+		const bool isCompressed = (format != aTEXTURE_COOK_FORMAT_RGBA8);
+
+		DDS_header header;
+		memset(&header, 0, sizeof(DDS_header));
+		header.dwMagic = ('D' << 0) | ('D' << 8) | ('S' << 16) | (' ' << 24);
+		header.dwSize = 124;
+		header.dwFlags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT;
+		header.dwWidth = width;
+		header.dwHeight = height;
+		header.dwMipMapCount = mipmapCount;
+		header.sPixelFormat.dwSize = 32;
+		header.sCaps.dwCaps1 = DDSCAPS_TEXTURE;
+		header.dwReserved1[g_cookedTextureTagIndex] = g_cookedTextureTag;
+		header.dwReserved1[g_cookedTextureFlagsIndex] = settings.invertY ? g_cookedTextureFlagInvertY : 0;
+
+		if (mipmapCount > 1)
+		{
+			header.dwFlags |= DDSD_MIPMAPCOUNT;
+			header.sCaps.dwCaps1 |= DDSCAPS_COMPLEX | DDSCAPS_MIPMAP;
+		}
+
+		if (isCompressed)
+		{
+			const uint32 blockSize = (format == aTEXTURE_COOK_FORMAT_DXT1) ? 8 : 16;
+			header.dwFlags |= DDSD_LINEARSIZE;
+			header.dwPitchOrLinearSize = ((width + 3) / 4) * ((height + 3) / 4) * blockSize;
+			header.sPixelFormat.dwFlags = DDPF_FOURCC;
+			header.sPixelFormat.dwFourCC = ('D' << 0) | ('X' << 8) | ('T' << 16) | (((format == aTEXTURE_COOK_FORMAT_DXT1) ? '1' : '5') << 24);
+		}
+		else
+		{
+			header.dwFlags |= DDSD_PITCH;
+			header.dwPitchOrLinearSize = width * 4;
+			header.sPixelFormat.dwFlags = DDPF_RGB | DDPF_ALPHAPIXELS;
+			header.sPixelFormat.dwRGBBitCount = 32;
+			header.sPixelFormat.dwRBitMask = 0x00ff0000;
+			header.sPixelFormat.dwGBitMask = 0x0000ff00;
+			header.sPixelFormat.dwBBitMask = 0x000000ff;
+			header.sPixelFormat.dwAlphaBitMask = 0xff000000;
+		}
+
+		out->AppendToStream(&header, sizeof(DDS_header));
+
+		uint32 dataSizeInBytes = AppendMipLevel(image, width, height, format, out);
+
+		/*
+			Each level is box filtered from the one above. This matches the
+			chain size the DDS loaders expect, including for non power of two images.
+		*/
+		int32 mipWidth = width;
+		int32 mipHeight = height;
+		uint8 *mipImage = image;
+		uint8 *mipScratch = 0;
+		for(uint32 level = 1; level < mipmapCount; ++level)
+		{
+			const int32 nextWidth = (mipWidth > 1) ? (mipWidth / 2) : 1;
+			const int32 nextHeight = (mipHeight > 1) ? (mipHeight / 2) : 1;
+
+			uint8 *nextImage = (uint8*)MASH_ALLOC_COMMON(nextWidth * nextHeight * 4);
+			BoxFilterMipmapRGBA8(mipImage, mipWidth, mipHeight, nextImage);
+
+			if (mipScratch)
+				MASH_FREE(mipScratch);
+
+			mipScratch = nextImage;
+			mipImage = nextImage;
+			mipWidth = nextWidth;
+			mipHeight = nextHeight;
+
+			dataSizeInBytes += AppendMipLevel(mipImage, mipWidth, mipHeight, format, out);
+		}
+
+		if (mipScratch)
+			MASH_FREE(mipScratch);
+
+		SOIL_free_image_data(image);
+
+		if (info)
+		{
+			info->width = width;
+			info->height = height;
+			info->mipmapCount = mipmapCount;
+			info->format = format;
+			info->dataSizeInBytes = dataSizeInBytes;
+		}
+
+		return aMASH_OK;
+	}
+
+	bool IsCookedTextureDirectUpload(const void *data, uint32 sizeInBytes)
+	{
+		if (!data || (sizeInBytes < sizeof(DDS_header)))
+			return false;
+
+		DDS_header header;
+		memcpy(&header, data, sizeof(DDS_header));
+		if (memcmp(&header.dwMagic, "DDS ", 4) != 0)
+			return false;
+
+		if ((header.dwReserved1[g_cookedTextureTagIndex] != g_cookedTextureTag) || 
+			!(header.dwReserved1[g_cookedTextureFlagsIndex] & g_cookedTextureFlagInvertY))
+		{
+			return false;
+		}
+
+		//the sampler may use mipmaps so anything less than a full chain is processed
+		return (header.dwMipMapCount == CalculateMipmapCount(header.dwWidth, header.dwHeight));
+	}
+
+	eMASH_STATUS CookTextureFile(MashFileManager *fileManager, const int8 *sourceFile, const int8 *outputFile,
+		const sTextureCookSettings &settings, sTextureCookInfo *info)
+	{
+		if (!fileManager || !sourceFile || !outputFile)
+			return aMASH_FAILED;
+
+		MashFileStream *sourceStream = fileManager->CreateFileStream();
+		if (sourceStream->LoadFile(sourceFile, aFILE_IO_BINARY) == aMASH_FAILED)
+		{
+			MASH_WRITE_TO_LOG_EX(MashLog::aERROR_LEVEL_ERROR,
+				"CookTextureFile",
+				"Failed to load texture '%s'.", sourceFile);
+
+			sourceStream->Destroy();
+			return aMASH_FAILED;
+		}
+
+		MashFileStream *outputStream = fileManager->CreateFileStream();
+		eMASH_STATUS status = CookTexture(sourceStream->GetData(), sourceStream->GetDataSizeInBytes(), settings, outputStream, info);
+		sourceStream->Destroy();
+
+		if (status == aMASH_OK)
+		{
+			status = outputStream->SaveFile(outputFile, aFILE_IO_BINARY);
+			if (status == aMASH_FAILED)
+			{
+				MASH_WRITE_TO_LOG_EX(MashLog::aERROR_LEVEL_ERROR,
+					"CookTextureFile",
+					"Failed to save cooked texture '%s'.", outputFile);
+			}
+		}
+		else
+		{
+			MASH_WRITE_TO_LOG_EX(MashLog::aERROR_LEVEL_ERROR,
+				"CookTextureFile",
+				"Failed to cook texture '%s'.", sourceFile);
+		}
+
+		outputStream->Destroy();
+
+		return status;
+	}
+}
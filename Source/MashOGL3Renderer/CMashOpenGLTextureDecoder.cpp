@@ -0,0 +1,153 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#include "CMashOpenGLTextureDecoder.h"
+#include "SOIL.h"
+#include "image_helper.h"
+
+#include <cstring>
+#include <cstdlib>
+
+namespace mash
+{
+	uint32 NextPowerOfTwo(uint32 value)
+	{
+		uint32 result = 1;
+		while(result < value)
+			result <<= 1;
+
+		return result;
+	}
+
+	uint32 CalculateMipmapCount(uint32 width, uint32 height)
+	{
+		uint32 count = 1;
+		while((width > 1) || (height > 1))
+		{
+			width = (width > 1) ? (width / 2) : 1;
+			height = (height > 1) ? (height / 2) : 1;
+			++count;
+		}
+
+		return count;
+	}
+
+	void FlipImageY(uint8 *image, uint32 width, uint32 height, uint32 channels)
+	{
+		const uint32 rowSize = width * channels;
+		for(uint32 top = 0, bottom = height - 1; top < bottom; ++top, --bottom)
+		{
+			uint8 *topRow = &image[top * rowSize];
+			uint8 *bottomRow = &image[bottom * rowSize];
+			for(uint32 i = 0; i < rowSize; ++i)
+			{
+				const uint8 temp = topRow[i];
+				topRow[i] = bottomRow[i];
+				bottomRow[i] = temp;
+			}
+		}
+	}
+
+	void BoxFilterMipmapRGBA8(const uint8 *src, uint32 width, uint32 height, uint8 *dst)
+	{
+		const uint32 dstWidth = (width > 1) ? (width / 2) : 1;
+		const uint32 dstHeight = (height > 1) ? (height / 2) : 1;
+		const uint32 srcPitch = width * 4;
+
+		//1 pixel wide or high images sample the same row or column twice
+		const uint32 nextRow = (height > 1) ? srcPitch : 0;
+		const uint32 nextPixel = (width > 1) ? 4 : 0;
+		const uint32 srcStepY = (height > 1) ? (srcPitch * 2) : srcPitch;
+		const uint32 srcStepX = (width > 1) ? 8 : 4;
+
+		/*
+			Kept as simple fixed size loops over bytes so the compiler
+			can vectorise them.
+		*/
+		for(uint32 y = 0; y < dstHeight; ++y)
+		{
+			const uint8 *row0 = src + (y * srcStepY);
+			const uint8 *row1 = row0 + nextRow;
+			uint8 *dstRow = dst + (y * dstWidth * 4);
+			for(uint32 x = 0; x < dstWidth; ++x)
+			{
+				const uint32 p = x * srcStepX;
+				for(uint32 c = 0; c < 4; ++c)
+				{
+					const uint32 sum = (uint32)row0[p + c] + (uint32)row0[p + nextPixel + c] +
+						(uint32)row1[p + c] + (uint32)row1[p + nextPixel + c];
+
+					dstRow[(x * 4) + c] = (uint8)((sum + 2) >> 2);
+				}
+			}
+		}
+	}
+
+	CMashOpenGLTextureDecodeJob::CMashOpenGLTextureDecodeJob(const uint8 *fileData, uint32 fileSizeInBytes):MashJob(),
+		m_fileData(fileData), m_fileSizeInBytes(fileSizeInBytes), m_imageData(0), m_width(0), m_height(0), m_mipmapCount(0)
+	{
+	}
+
+	CMashOpenGLTextureDecodeJob::~CMashOpenGLTextureDecodeJob()
+	{
+		//malloc is used as the engine allocator may not be thread safe
+		if (m_imageData)
+			free(m_imageData);
+	}
+
+	void CMashOpenGLTextureDecodeJob::Run()
+	{
+		int32 width = 0;
+		int32 height = 0;
+		int32 channels = 0;
+		uint8 *image = SOIL_load_image_from_memory(m_fileData, m_fileSizeInBytes, &width, &height, &channels, SOIL_LOAD_RGBA);
+		if (!image)
+			return;
+
+		const uint32 potWidth = NextPowerOfTwo(width);
+		const uint32 potHeight = NextPowerOfTwo(height);
+		const uint32 mipmapCount = CalculateMipmapCount(potWidth, potHeight);
+
+		uint32 totalSizeInBytes = 0;
+		for(uint32 level = 0, w = potWidth, h = potHeight; level < mipmapCount; ++level)
+		{
+			totalSizeInBytes += w * h * 4;
+			w = (w > 1) ? (w / 2) : 1;
+			h = (h > 1) ? (h / 2) : 1;
+		}
+
+		uint8 *imageData = (uint8*)malloc(totalSizeInBytes);
+		if (!imageData)
+		{
+			SOIL_free_image_data(image);
+			return;
+		}
+
+		if ((potWidth != (uint32)width) || (potHeight != (uint32)height))
+			up_scale_image(image, width, height, 4, imageData, potWidth, potHeight);
+		else
+			memcpy(imageData, image, potWidth * potHeight * 4);
+
+		SOIL_free_image_data(image);
+
+		FlipImageY(imageData, potWidth, potHeight, 4);
+
+		uint8 *level = imageData;
+		for(uint32 i = 1, w = potWidth, h = potHeight; i < mipmapCount; ++i)
+		{
+			uint8 *nextLevel = level + (w * h * 4);
+			BoxFilterMipmapRGBA8(level, w, h, nextLevel);
+
+			level = nextLevel;
+			w = (w > 1) ? (w / 2) : 1;
+			h = (h > 1) ? (h / 2) : 1;
+		}
+
+		m_imageData = imageData;
+		m_width = potWidth;
+		m_height = potHeight;
+		m_mipmapCount = mipmapCount;
+	}
+}
@@ -0,0 +1,78 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+#ifndef _C_MASH_OPENGL_TEXTURE_DECODER_H_
+#define _C_MASH_OPENGL_TEXTURE_DECODER_H_
+
+#include "MashDataTypes.h"
+#include "MashJob.h"
+
+namespace mash
+{
+	uint32 NextPowerOfTwo(uint32 value);
+
+	//Number of levels in a full mip chain, including the top level.
+	uint32 CalculateMipmapCount(uint32 width, uint32 height);
+
+	//Flips an image vertically in place.
+	void FlipImageY(uint8 *image, uint32 width, uint32 height, uint32 channels);
+
+	/*
+		Creates the next mip level of an RGBA8 image using a 2x2 box filter.
+		dst must hold Max(width / 2, 1) * Max(height / 2, 1) pixels.
+	*/
+	void BoxFilterMipmapRGBA8(const uint8 *src, uint32 width, uint32 height, uint8 *dst);
+
+	/*
+		Decodes an image file into a flipped, power of two, RGBA8 image with a full
+		mip chain. All levels are stored one after the other in GetImageData(), largest first.
+
+		This is run on worker threads so it only touches the file data it was given
+		and its own allocations.
+	*/
+	class CMashOpenGLTextureDecodeJob : public MashJob
+	{
+	private:
+		const uint8 *m_fileData;
+		uint32 m_fileSizeInBytes;
+		uint8 *m_imageData;
+		uint32 m_width;
+		uint32 m_height;
+		uint32 m_mipmapCount;
+	public:
+		CMashOpenGLTextureDecodeJob(const uint8 *fileData, uint32 fileSizeInBytes);
+		~CMashOpenGLTextureDecodeJob();
+
+		void Run();
+
+		//NULL if decoding failed.
+		const uint8* GetImageData()const;
+		uint32 GetWidth()const;
+		uint32 GetHeight()const;
+		uint32 GetMipmapCount()const;
+	};
+
+	inline const uint8* CMashOpenGLTextureDecodeJob::GetImageData()const
+	{
+		return m_imageData;
+	}
+
+	inline uint32 CMashOpenGLTextureDecodeJob::GetWidth()const
+	{
+		return m_width;
+	}
+
+	inline uint32 CMashOpenGLTextureDecodeJob::GetHeight()const
+	{
+		return m_height;
+	}
+
+	inline uint32 CMashOpenGLTextureDecodeJob::GetMipmapCount()const
+	{
+		return m_mipmapCount;
+	}
+}
+
+#endif
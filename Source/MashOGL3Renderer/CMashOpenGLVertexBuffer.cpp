@@ -130,7 +130,19 @@ namespace mash
 			glBufferDataPtr(GL_ARRAY_BUFFER, m_size, 0, flag);
 		}
 
-		*pData = glMapBufferPtr(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
+		if (eType == aLOCK_WRITE_NOOVERWRITE)
+		{
+			/*
+				The caller promises not to touch data the GPU may be using, so
+				there is no need to wait for the GPU to finish with the buffer.
+			*/
+			*pData = glMapBufferRangePtr(GL_ARRAY_BUFFER, 0, m_size, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+		}
+		else
+		{
+			*pData = glMapBufferPtr(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
+		}
+
 		glBindBufferPtr(GL_ARRAY_BUFFER, 0);
 
 		return aMASH_OK;
@@ -5,11 +5,18 @@
 //-------------------------------------------------------------------------
 
 #include "MashInclude.h"
+#include "MashBone.h"
+#include "MashTransformState.h"
 
 #include "../SupportLib/MemoryAllocator/MashDefaultMemoryAllocator.h"
 #include "UnitTest++.h"
 #include "D3D10/MashD3D10Creation.h"
 #include "OpenGL3/MashOpenGL3Creation.h"
+#include "OpenGL3/MashTextureCooker.h"
+#include "Null/MashNullCreation.h"
+#include "Null/MashNullVideo.h"
+#include <ctime>
+#include <cstdio>
 
 #if defined (MASH_WINDOWS) && !defined(__MINGW32__)
     #define USE_DIRECTX
@@ -19,6 +26,9 @@ using namespace mash;
 
 void TestNodes(MashDevice *device);
 void TestLights(MashDevice *device);
+void TestMeshSimplification(MashDevice *device);
+void TestTextureCooker(MashDevice *device);
+void TestTriangleColliderBatch(MashDevice *device);
 
 class MainLoop : public mash::MashGameLoop
 {
@@ -33,6 +43,9 @@ public:
 	{
         TestNodes(m_device);
         TestLights(m_device);
+        TestMeshSimplification(m_device);
+        TestTextureCooker(m_device);
+        TestTriangleColliderBatch(m_device);
         
 		m_camera = (MashCamera*)m_device->GetSceneManager()->AddCamera(0, "Camera01");
 		m_camera->SetZFar(1000);
@@ -237,6 +250,362 @@ void TestLights(MashDevice *device)
     CHECK(!device->GetSceneManager()->GetDeferredSpotShadowsEnabled());
 }
 
+void TestMeshSimplification(MashDevice *device)
+{
+    MashSceneManager *sceneManager = device->GetSceneManager();
+    MashMaterial *material = device->GetRenderer()->GetMaterialManager()->GetStandardMaterial(MashMaterialManager::aSTANDARD_MATERIAL_DEFAULT_MESH);
+    CHECK(material != 0);
+    
+    MashMesh *sphereMesh = sceneManager->CreateStaticMesh();
+    CHECK(sceneManager->GetMeshBuilder()->CreateSphere(sphereMesh, 10.0f, 20, material->GetVertexDeclaration()) == aMASH_OK);
+    const uint32 sourceTriangleCount = sphereMesh->GetPrimitiveCount();
+    
+    f32 error = 0.0f;
+    MashMesh *simplifiedMesh = sceneManager->CreateStaticMesh();
+    CHECK(sceneManager->GetMeshBuilder()->SimplifyMesh(simplifiedMesh, sphereMesh, 0.5f, mash::math::MaxFloat(), &error) == aMASH_OK);
+    CHECK(simplifiedMesh->GetPrimitiveCount() <= (sourceTriangleCount / 2));
+    CHECK(simplifiedMesh->GetVertexCount() < sphereMesh->GetVertexCount());
+    CHECK(error < 10.0f);
+    
+    //no collapse may move the surface more than the max error
+    CHECK(sceneManager->GetMeshBuilder()->SimplifyMesh(simplifiedMesh, sphereMesh, 0.0f, 0.5f, &error) == aMASH_OK);
+    CHECK(error <= 0.5f);
+    CHECK(simplifiedMesh->GetPrimitiveCount() < sourceTriangleCount);
+    simplifiedMesh->Drop();
+    
+    MashModel *model = sceneManager->CreateModel();
+    model->Append(&sphereMesh);
+    sphereMesh->Drop();
+    
+    CHECK(sceneManager->GetMeshBuilder()->GenerateLods(model, 3, 0.5f) == aMASH_OK);
+    CHECK(model->GetLodCount() == 4);
+    for(uint32 i = 1; i < model->GetLodCount(); ++i)
+        CHECK(model->GetMesh(0, i)->GetPrimitiveCount() < model->GetMesh(0, i - 1)->GetPrimitiveCount());
+    
+    MashEntity *entity = sceneManager->AddEntity(0, model, "lodEntity");
+    CHECK(entity->SetLodScreenSize(1, 0.5f) == aMASH_OK);
+    CHECK(entity->SetLodScreenSize(2, 0.25f) == aMASH_OK);
+    CHECK(entity->SetLodScreenSize(3, 0.1f) == aMASH_OK);
+    model->Drop();
+    
+    sceneManager->RemoveAllSceneNodes();
+}
+
+f32 RandomUnitFloat()
+{
+    return ((f32)rand() / (f32)RAND_MAX) * 2.0f - 1.0f;
+}
+
+void TestTriangleColliderBatch(MashDevice *device)
+{
+    MashSceneManager *sceneManager = device->GetSceneManager();
+    MashMaterial *material = device->GetRenderer()->GetMaterialManager()->GetStandardMaterial(MashMaterialManager::aSTANDARD_MATERIAL_DEFAULT_MESH);
+    CHECK(material != 0);
+    
+    MashMesh *sphereMesh = sceneManager->CreateStaticMesh();
+    CHECK(sceneManager->GetMeshBuilder()->CreateSphere(sphereMesh, 10.0f, 40, material->GetVertexDeclaration()) == aMASH_OK);
+    MashModel *model = sceneManager->CreateModel();
+    model->Append(&sphereMesh);
+    sphereMesh->Drop();
+    
+    MashTriangleCollider *collider = sceneManager->CreateTriangleCollider(model, 0, aTRIANGLE_COLLIDER_KD_TREE);
+    CHECK(collider != 0);
+    
+    MashDummy *root = sceneManager->AddDummy(0, "pickRoot");
+    MashEntity *entity = sceneManager->AddEntity(root, model, "pickEntity");
+    entity->SetPosition(MashVector3(5.0f, -2.0f, 3.0f));
+    model->Drop();
+    sceneManager->UpdateScene(0.0f, root);
+    
+    const MashTransformState &transform = entity->GetWorldTransformState();
+    
+    //enough rays that large batches are split into jobs
+    const uint32 rayCount = 2000;
+    MashArray<MashRay> rays;
+    rays.Reserve(rayCount);
+    srand(3);
+    for(uint32 i = 0; i < rayCount; ++i)
+    {
+        const MashVector3 origin(RandomUnitFloat() * 30.0f, RandomUnitFloat() * 30.0f, RandomUnitFloat() * 30.0f);
+        const MashVector3 target(5.0f + RandomUnitFloat() * 12.0f, -2.0f + RandomUnitFloat() * 12.0f, 3.0f + RandomUnitFloat() * 12.0f);
+        rays.PushBack(MashRay(origin, (target - origin).Normalize()));
+    }
+    
+    //batched results must match one query at a time
+    MashArray<sTriPickResult> batchResults(rayCount);
+    bool *batchHits = MASH_ALLOC_T_COMMON(bool, rayCount);
+    collider->GetClosestTriangles(rays.Pointer(), rayCount, transform, batchResults.Pointer());
+    collider->CheckCollisions(rays.Pointer(), rayCount, transform, batchHits);
+    
+    uint32 hitCount = 0;
+    uint32 mismatches = 0;
+    for(uint32 i = 0; i < rayCount; ++i)
+    {
+        sTriPickResult result;
+        const bool hit = collider->GetClosestTriangle(rays[i], transform, result);
+        if ((hit != batchResults[i].collision) || (hit != batchHits[i]) || (hit != collider->CheckCollision(rays[i], transform)))
+            ++mismatches;
+        else if (hit && ((result.triangleIndex != batchResults[i].triangleIndex) || (result.distance != batchResults[i].distance)))
+            ++mismatches;
+        
+        if (hit)
+            ++hitCount;
+    }
+    
+    MASH_FREE(batchHits);
+    CHECK(hitCount > 0);
+    CHECK(hitCount < rayCount);
+    CHECK(mismatches == 0);
+    
+    //the scene batch must match single scene picks
+    MashArray<sTriPickResult> sceneResults(rayCount);
+    CHECK(MashScenePick::GetClosestTrisFromScene(root, rays.Pointer(), rayCount, aNODETYPE_ENTITY, false, sceneResults.Pointer()) == hitCount);
+    
+    mismatches = 0;
+    for(uint32 i = 0; i < rayCount; ++i)
+    {
+        sTriPickResult result;
+        const bool hit = MashScenePick::GetClosestTriFromScene(root, rays[i], aNODETYPE_ENTITY, false, result);
+        if ((hit != sceneResults[i].collision) || (hit && ((result.triangleIndex != sceneResults[i].triangleIndex) || (sceneResults[i].node != entity))))
+            ++mismatches;
+    }
+    
+    CHECK(mismatches == 0);
+    
+    //box batches keep the results for each box together and in order
+    const uint32 boxCount = 1000;
+    MashArray<MashAABB> boxes;
+    boxes.Reserve(boxCount);
+    for(uint32 i = 0; i < boxCount; ++i)
+    {
+        const MashVector3 center(5.0f + RandomUnitFloat() * 12.0f, -2.0f + RandomUnitFloat() * 12.0f, 3.0f + RandomUnitFloat() * 12.0f);
+        boxes.PushBack(MashAABB(center - MashVector3(1.0f, 1.0f, 1.0f), center + MashVector3(1.0f, 1.0f, 1.0f)));
+    }
+    
+    MashArray<sIntersectingTriangleResult> boxResults;
+    MashArray<uint32> boxResultStart(boxCount + 1);
+    const uint32 boxResultCount = collider->GetIntersectingTriangles(boxes.Pointer(), boxCount, transform, boxResults, boxResultStart.Pointer());
+    CHECK(boxResultCount == boxResults.Size());
+    CHECK(boxResultStart[boxCount] == boxResultCount);
+    
+    mismatches = 0;
+    for(uint32 i = 0; i < boxCount; ++i)
+    {
+        MashArray<sIntersectingTriangleResult> singleResults;
+        collider->GetIntersectingTriangles(boxes[i], transform, singleResults);
+        if (singleResults.Size() != (boxResultStart[i + 1] - boxResultStart[i]))
+        {
+            ++mismatches;
+            continue;
+        }
+        
+        for(uint32 r = 0; r < singleResults.Size(); ++r)
+        {
+            if (singleResults[r].triangleIndex != boxResults[boxResultStart[i] + r].triangleIndex)
+                ++mismatches;
+        }
+    }
+    
+    CHECK(mismatches == 0);
+    
+    collider->Drop();
+    sceneManager->RemoveAllSceneNodes();
+}
+
+//creates an uncompressed 32bit tga file in memory
+void CreateTestTGA(uint32 width, uint32 height, MashArray<uint8> &out)
+{
+    const uint8 header[18] = {0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        (uint8)(width & 0xff), (uint8)(width >> 8), (uint8)(height & 0xff), (uint8)(height >> 8), 32, 0x28};
+    
+    out.Clear();
+    out.Insert(0, header, 18);
+    for(uint32 y = 0; y < height; ++y)
+    {
+        for(uint32 x = 0; x < width; ++x)
+        {
+            out.PushBack((uint8)x);
+            out.PushBack((uint8)y);
+            out.PushBack((uint8)(x ^ y));
+            out.PushBack(((x / 8) & 1) ? 255 : 128);
+        }
+    }
+}
+
+//creates an uncompressed 32bit dds file with no mipmaps, as written by other tools
+void CreateTestDDS(uint32 width, uint32 height, MashArray<uint8> &out)
+{
+    uint32 header[32];
+    memset(header, 0, sizeof(header));
+    header[0] = ('D' << 0) | ('D' << 8) | ('S' << 16) | (' ' << 24);
+    header[1] = 124;
+    header[2] = 0x1 | 0x2 | 0x4 | 0x8 | 0x1000;//caps, height, width, pitch, pixel format
+    header[3] = height;
+    header[4] = width;
+    header[5] = width * 4;
+    header[19] = 32;//pixel format size
+    header[20] = 0x40 | 0x1;//rgb, alpha pixels
+    header[22] = 32;
+    header[23] = 0x00ff0000;
+    header[24] = 0x0000ff00;
+    header[25] = 0x000000ff;
+    header[26] = 0xff000000;
+    header[27] = 0x1000;//texture caps
+    
+    out.Clear();
+    out.Insert(0, (const uint8*)header, sizeof(header));
+    for(uint32 y = 0; y < height; ++y)
+    {
+        for(uint32 x = 0; x < width; ++x)
+        {
+            out.PushBack((uint8)x);
+            out.PushBack((uint8)y);
+            out.PushBack((uint8)(x ^ y));
+            out.PushBack(255);
+        }
+    }
+}
+
+void TestTextureCooker(MashDevice *device)
+{
+    MashFileManager *fileManager = device->GetFileManager();
+    MashArray<uint8> sourceImage;
+    CreateTestTGA(200, 100, sourceImage);
+    
+    MashFileStream *stream = fileManager->CreateFileStream();
+    sTextureCookInfo info;
+    sTextureCookSettings settings;
+    CHECK(CookTexture(sourceImage.Pointer(), sourceImage.Size(), settings, stream, &info) == aMASH_OK);
+    CHECK(info.width == 256);
+    CHECK(info.height == 128);
+    CHECK(info.mipmapCount == 9);
+    CHECK(info.format == aTEXTURE_COOK_FORMAT_DXT5);
+    //128 byte dds header
+    CHECK(stream->GetDataSizeInBytes() == (info.dataSizeInBytes + 128));
+    CHECK(memcmp(stream->GetData(), "DDS ", 4) == 0);
+    CHECK(IsCookedTextureDirectUpload(stream->GetData(), stream->GetDataSizeInBytes()));
+    
+    const uint32 dxt5Size = info.dataSizeInBytes;
+    stream->ClearStream();
+    settings.format = aTEXTURE_COOK_FORMAT_DXT1;
+    CHECK(CookTexture(sourceImage.Pointer(), sourceImage.Size(), settings, stream, &info) == aMASH_OK);
+    CHECK(info.dataSizeInBytes * 2 == dxt5Size);
+    
+    stream->ClearStream();
+    settings.format = aTEXTURE_COOK_FORMAT_RGBA8;
+    settings.generateMipmaps = false;
+    settings.resizeToPowerOfTwo = false;
+    CHECK(CookTexture(sourceImage.Pointer(), sourceImage.Size(), settings, stream, &info) == aMASH_OK);
+    CHECK(info.mipmapCount == 1);
+    CHECK(info.dataSizeInBytes == 200 * 100 * 4);
+    //without a full mip chain the file must be processed on load
+    CHECK(!IsCookedTextureDirectUpload(stream->GetData(), stream->GetDataSizeInBytes()));
+    
+    /*
+        Checks the flipped and box filtered mip chain shared with the threaded
+        texture decoder. Pixels are stored as BGRA after the 128 byte header.
+    */
+    CreateTestTGA(4, 2, sourceImage);
+    stream->ClearStream();
+    settings.generateMipmaps = true;
+    settings.invertY = true;
+    CHECK(CookTexture(sourceImage.Pointer(), sourceImage.Size(), settings, stream, &info) == aMASH_OK);
+    CHECK(info.mipmapCount == 3);
+    CHECK(info.dataSizeInBytes == (32 + 8 + 4));
+    
+    const uint8 *pixels = (const uint8*)stream->GetData() + 128;
+    //the bottom row comes first once flipped
+    const uint8 expectedTopLevel[4] = {1, 1, 0, 128};
+    const uint8 expectedLevel1[8] = {1, 1, 1, 128, 3, 1, 3, 128};
+    const uint8 expectedLevel2[4] = {2, 1, 2, 128};
+    CHECK(memcmp(pixels, expectedTopLevel, 4) == 0);
+    CHECK(memcmp(pixels + 32, expectedLevel1, 8) == 0);
+    CHECK(memcmp(pixels + 40, expectedLevel2, 4) == 0);
+    CHECK(IsCookedTextureDirectUpload(stream->GetData(), stream->GetDataSizeInBytes()));
+    
+    //files cooked for D3D are not flipped for OpenGL
+    stream->ClearStream();
+    settings.invertY = false;
+    CHECK(CookTexture(sourceImage.Pointer(), sourceImage.Size(), settings, stream, &info) == aMASH_OK);
+    CHECK(!IsCookedTextureDirectUpload(stream->GetData(), stream->GetDataSizeInBytes()));
+    stream->Destroy();
+    
+    /*
+        DDS files not written by the cooker take the normal path so they are
+        flipped and get a full mip chain.
+    */
+    MashArray<uint8> uncookedImage;
+    CreateTestDDS(16, 8, uncookedImage);
+    CHECK(!IsCookedTextureDirectUpload(uncookedImage.Pointer(), uncookedImage.Size()));
+    CHECK(fileManager->WriteFile("uncookedTest.dds", aFILE_IO_BINARY, uncookedImage.Pointer(), uncookedImage.Size()) == aMASH_OK);
+    
+    MashTexture *uncookedTexture = device->GetRenderer()->GetTexture("uncookedTest.dds");
+    CHECK(uncookedTexture != 0);
+    if (uncookedTexture)
+    {
+        uint32 width = 0;
+        uint32 height = 0;
+        uncookedTexture->GetSize(width, height);
+        CHECK((width == 16) && (height == 8));
+        CHECK(uncookedTexture->GetMipmapCount() == 5);
+        device->GetRenderer()->RemoveTextureFromCache(uncookedTexture);
+    }
+    
+    //loads a batch of textures, decoded on worker threads where supported
+    CreateTestTGA(200, 100, sourceImage);
+    CHECK(fileManager->WriteFile("decodeTest0.tga", aFILE_IO_BINARY, sourceImage.Pointer(), sourceImage.Size()) == aMASH_OK);
+    CreateTestTGA(64, 32, sourceImage);
+    CHECK(fileManager->WriteFile("decodeTest1.tga", aFILE_IO_BINARY, sourceImage.Pointer(), sourceImage.Size()) == aMASH_OK);
+    
+    MashVideo *videoDevice = device->GetRenderer();
+    const MashStringc decodeFiles[3] = {"decodeTest0.tga", "decodeTest1.tga", "decodeTest0.tga"};
+    MashTexture *decodedTextures[3] = {0, 0, 0};
+    CHECK(videoDevice->GetTextures(decodeFiles, 3, decodedTextures) == aMASH_OK);
+    CHECK(decodedTextures[0] && decodedTextures[1] && (decodedTextures[0] == decodedTextures[2]));
+    if (decodedTextures[0] && decodedTextures[1])
+    {
+        uint32 width = 0;
+        uint32 height = 0;
+        decodedTextures[1]->GetSize(width, height);
+        CHECK((width == 64) && (height == 32));
+        CHECK(decodedTextures[1]->GetMipmapCount() == 7);
+        
+        videoDevice->RemoveTextureFromCache(decodedTextures[0]);
+        videoDevice->RemoveTextureFromCache(decodedTextures[1]);
+    }
+    
+    //a cooked image must be smaller than the mip chain the default path creates
+    CreateTestTGA(1000, 1000, sourceImage);
+    CHECK(fileManager->WriteFile("cookerTest.tga", aFILE_IO_BINARY, sourceImage.Pointer(), sourceImage.Size()) == aMASH_OK);
+    
+    settings = sTextureCookSettings();
+#ifdef USE_DIRECTX
+    settings.invertY = false;
+#endif
+    CHECK(CookTextureFile(fileManager, "cookerTest.tga", "cookerTest.dds", settings, &info) == aMASH_OK);
+    
+    uint32 uncookedSize = 0;
+    for(uint32 w = 1024, h = 1024; ; w = math::Max<uint32>(w / 2, 1), h = math::Max<uint32>(h / 2, 1))
+    {
+        uncookedSize += w * h * 4;
+        if ((w == 1) && (h == 1))
+            break;
+    }
+    
+    CHECK(info.dataSizeInBytes < uncookedSize);
+    
+    MashTexture *cookedTexture = videoDevice->GetTexture("cookerTest.dds");
+    CHECK(cookedTexture != 0);
+    if (cookedTexture)
+    {
+        uint32 width = 0;
+        uint32 height = 0;
+        cookedTexture->GetSize(width, height);
+        CHECK((width == info.width) && (height == info.height));
+        videoDevice->RemoveTextureFromCache(cookedTexture);
+    }
+}
+
 bool g_errorLogWasReceived = false;
 struct sErrorHandler
 {
@@ -321,6 +690,33 @@ struct sEngineStartup
     }
 };
 
+//counts heap allocations made by containers
+class CountingAllocator : public MashMemoryPoolSimple
+{
+public:
+    static uint32 allocationCount;
+    
+    void* GetMemory(uint32 sizeInBytes, size_t alignment = mash::_g_globalMemoryAlignment)
+    {
+        ++allocationCount;
+        return MashMemoryPoolSimple::GetMemory(sizeInBytes, alignment);
+    }
+};
+
+uint32 CountingAllocator::allocationCount = 0;
+
+namespace mash
+{
+    namespace helpers
+    {
+        template<>
+        struct MashIsAllocatorStateless<CountingAllocator>
+        {
+            enum {value = 1};
+        };
+    }
+}
+
 SUITE(ArrayTest)
 {
 TEST(ArrayPushBack)
@@ -556,6 +952,175 @@ TEST(ArrayReserve)
     CHECK(testArray.Size() == 0);
     CHECK(testArray.ReservedSize() == 5);
 }
+
+TEST(ArrayInline)
+{
+    UNITTEST_TIME_CONSTRAINT(60000);//1min
+    
+    CountingAllocator::allocationCount = 0;
+    MashInlineArray<int32, 4, CountingAllocator> testArray;
+    CHECK(testArray.ReservedSize() == 4);
+    
+    for(int32 i = 0; i < 4; ++i)
+        testArray.PushBack(i);
+    CHECK(CountingAllocator::allocationCount == 0);
+    
+    //grows onto the heap
+    testArray.PushBack(4);
+    CHECK(CountingAllocator::allocationCount == 1);
+    CHECK(testArray.Size() == 5);
+    for(int32 i = 0; i < 5; ++i)
+        CHECK(testArray[i] == i);
+    
+    //returns to inline storage
+    testArray.DeleteData();
+    CHECK(testArray.ReservedSize() == 4);
+    testArray.PushBack(7);
+    CHECK(CountingAllocator::allocationCount == 1);
+    CHECK(testArray[0] == 7);
+    
+    //a non const pointer must still copy items
+    int32 items[3] = {1, 2, 3};
+    MashArray<int32> copiedArray(items, 3);
+    CHECK(copiedArray.Size() == 3);
+    CHECK(copiedArray[2] == 3);
+}
+
+TEST(ArraySwap)
+{
+    UNITTEST_TIME_CONSTRAINT(60000);//1min
+    
+    MashArray<MashStringc> a, b;
+    a.PushBack("a long string that will not fit in the string pool");
+    a.PushBack("short");
+    b.PushBack("b");
+    
+    a.Swap(b);
+    CHECK(a.Size() == 1);
+    CHECK(b.Size() == 2);
+    CHECK(a[0] == "b");
+    CHECK(b[0] == "a long string that will not fit in the string pool");
+    CHECK(b[1] == "short");
+    
+    //inline storage must move elements
+    MashInlineArray<MashStringc, 2> c;
+    c.PushBack("c");
+    c.Swap(b);
+    CHECK(b.Size() == 1);
+    CHECK(b[0] == "c");
+    CHECK(c.Size() == 2);
+    CHECK(c[1] == "short");
+    
+    //strings are moved when the array grows or shifts
+    for(uint32 i = 0; i < 64; ++i)
+        b.Insert(b.Begin(), "a long string that will not fit in the string pool");
+    b.Erase(b.Begin());
+    CHECK(b.Size() == 64);
+    CHECK(b[63] == "c");
+    CHECK(b[0] == "a long string that will not fit in the string pool");
+}
+}
+
+SUITE(JobTest)
+{
+    class TestSumJob : public MashJob
+    {
+    public:
+        uint32 start;
+        uint32 count;
+        uint64 result;
+        //jobs run from within this job
+        MashJob **innerJobs;
+        uint32 innerJobCount;
+        
+        TestSumJob():MashJob(), start(0), count(0), result(0), innerJobs(0), innerJobCount(0){}
+        
+        void Run()
+        {
+            result = 0;
+            for(uint32 i = start; i < start + count; ++i)
+                result += i;
+            
+            if (innerJobs)
+                jobs::RunJobs(innerJobs, innerJobCount);
+        }
+    };
+    
+    TEST(RunJobs)
+    {
+        UNITTEST_TIME_CONSTRAINT(60000);//1min
+        
+        const uint32 jobCount = 64;
+        const uint32 valuesPerJob = 1000;
+        TestSumJob sumJobs[jobCount];
+        MashJob *jobList[jobCount];
+        for(uint32 i = 0; i < jobCount; ++i)
+        {
+            sumJobs[i].start = i * valuesPerJob;
+            sumJobs[i].count = valuesPerJob;
+            jobList[i] = &sumJobs[i];
+        }
+        
+        const uint64 valueCount = jobCount * valuesPerJob;
+        
+        //workers are kept between calls
+        for(uint32 run = 0; run < 100; ++run)
+        {
+            for(uint32 i = 0; i < jobCount; ++i)
+                sumJobs[i].result = 0;
+            
+            jobs::RunJobs(jobList, jobCount, (run % 4) + 2);
+            
+            uint64 total = 0;
+            for(uint32 i = 0; i < jobCount; ++i)
+                total += sumJobs[i].result;
+            
+            CHECK(total == (valueCount * (valueCount - 1)) / 2);
+        }
+        
+        //single threaded
+        for(uint32 i = 0; i < jobCount; ++i)
+            sumJobs[i].result = 0;
+        
+        jobs::RunJobs(jobList, jobCount, 1);
+        CHECK(sumJobs[jobCount - 1].result != 0);
+    }
+    
+    TEST(RunJobsFromJob)
+    {
+        UNITTEST_TIME_CONSTRAINT(60000);//1min
+        
+        TestSumJob innerJobs[4];
+        MashJob *innerJobList[4];
+        for(uint32 i = 0; i < 4; ++i)
+        {
+            innerJobs[i].count = 10;
+            innerJobList[i] = &innerJobs[i];
+        }
+        
+        //inner jobs run on the thread of the outer job
+        TestSumJob outerJobs[2];
+        MashJob *outerJobList[2];
+        outerJobs[0].count = 10;
+        outerJobs[0].innerJobs = innerJobList;
+        outerJobs[0].innerJobCount = 4;
+        outerJobs[1].count = 20;
+        outerJobList[0] = &outerJobs[0];
+        outerJobList[1] = &outerJobs[1];
+        
+        jobs::RunJobs(outerJobList, 2, 2);
+        CHECK(outerJobs[0].result == 45);
+        CHECK(outerJobs[1].result == 190);
+        for(uint32 i = 0; i < 4; ++i)
+            CHECK(innerJobs[i].result == 45);
+        
+        jobs::ReleaseWorkerThreads();
+        
+        //workers start again when needed
+        outerJobs[1].result = 0;
+        jobs::RunJobs(outerJobList, 2, 2);
+        CHECK(outerJobs[1].result == 190);
+    }
 }
 
 SUITE(ListTest)
@@ -922,6 +1487,1374 @@ SUITE(StringTest)
     }
 }
 
+SUITE(StringSmallBufferTest)
+{
+    TEST(NoAllocation)
+    {
+        UNITTEST_TIME_CONSTRAINT(60000);//1min
+        
+        typedef MashBaseString<int8, CountingAllocator> CountedString;
+        
+        CountingAllocator::allocationCount = 0;
+        CountedString shortString("a short name");
+        shortString += "_01";
+        CountedString copy(shortString);
+        CHECK(CountingAllocator::allocationCount == 0);
+        CHECK(copy == "a short name_01");
+        
+        CountedString longString("a long string that will not fit in the string pool");
+        CHECK(CountingAllocator::allocationCount == 1);
+        
+        //no allocation when exchanging heap memory
+        longString.Swap(shortString);
+        CHECK(CountingAllocator::allocationCount == 1);
+        CHECK(longString == "a short name_01");
+        CHECK(shortString == "a long string that will not fit in the string pool");
+    }
+}
+
+SUITE(ListPoolTest)
+{
+    TEST(Swap)
+    {
+        UNITTEST_TIME_CONSTRAINT(60000);//1min
+        
+        MashList<int32> a, b;
+        for(int32 i = 0; i < 100; ++i)
+            a.PushBack(i);
+        b.PushBack(-1);
+        
+        a.Swap(b);
+        CHECK(a.Size() == 1);
+        CHECK(a.Front() == -1);
+        CHECK(b.Size() == 100);
+        CHECK(b.Back() == 99);
+        
+        //nodes are released back to the pool they came from
+        MashList<int32>::Iterator iter = b.Begin();
+        while(iter != b.End())
+        {
+            if ((*iter % 2) == 0)
+                iter = b.Erase(iter);
+            else
+                ++iter;
+        }
+        
+        CHECK(b.Size() == 50);
+        CHECK(b.Front() == 1);
+        
+        b.PushBack(100);
+        CHECK(b.Back() == 100);
+        
+        MashList<int32> c;
+        c.Swap(a);
+        CHECK(a.Empty());
+        CHECK(c.Front() == -1);
+        a.PushBack(5);
+        CHECK(a.Front() == 5);
+    }
+    
+    TEST(FreeAnyOrder)
+    {
+        UNITTEST_TIME_CONSTRAINT(60000);//1min
+        
+        MashMemoryPoolBlock pool;
+        MashArray<int32*> objects;
+        srand(5);
+        for(int32 i = 0; i < 5000; ++i)
+        {
+            int32 *object = (int32*)pool.GetMemory(sizeof(int32) * 4);
+            object[0] = i;
+            objects.PushBack(object);
+            
+            //different sizes and alignments come from the heap
+            if ((i % 100) == 0)
+            {
+                int32 *other = (int32*)pool.GetMemory(sizeof(int32) * 10, 64);
+                CHECK(((size_t)other % 64) == 0);
+                other[0] = i;
+                objects.PushBack(other);
+            }
+            
+            if ((rand() % 3) == 0)
+            {
+                const uint32 index = rand() % objects.Size();
+                pool.FreeMemory(objects[index]);
+                objects[index] = objects.Back();
+                objects.PopBack();
+            }
+        }
+        
+        bool valid = true;
+        for(uint32 i = 0; i < objects.Size(); ++i)
+        {
+            valid &= (objects[i][0] >= 0) && (objects[i][0] < 5000);
+            pool.FreeMemory(objects[i]);
+        }
+        
+        CHECK(valid);
+    }
+}
+
+SUITE(StringIDTest)
+{
+    TEST(Intern)
+    {
+        MashStringID a("walk");
+        MashStringID b(MashStringc("walk"));
+        MashStringID c("run");
+        
+        CHECK(a == b);
+        CHECK(a != c);
+        CHECK(strcmp(c.GetString(), "run") == 0);
+        CHECK(MashStringID("").IsEmpty());
+        CHECK(MashStringID((const int8*)0).IsEmpty());
+        
+        MashStringID found;
+        CHECK(MashStringID::Find("walk", found));
+        CHECK(found == a);
+        CHECK(!MashStringID::Find("__never_interned_name", found));
+    }
+    
+    TEST(Map)
+    {
+        UNITTEST_TIME_CONSTRAINT(60000);//1min
+        
+        const uint32 itemCount = 500;
+        MashArray<MashStringID> keys;
+        MashStringIDMap<uint32> testMap;
+        int8 buffer[100];
+        for(uint32 i = 0; i < itemCount; ++i)
+        {
+            MashStringc name = "key";
+            name += mash::helpers::NumberToString(buffer, 100, i);
+            keys.PushBack(MashStringID(name));
+            testMap.Insert(keys.Back(), i);
+        }
+        
+        CHECK(testMap.Size() == itemCount);
+        for(uint32 i = 0; i < itemCount; ++i)
+        {
+            const uint32 *value = testMap.Find(keys[i]);
+            CHECK(value && (*value == i));
+        }
+        
+        //overwrite
+        testMap.Insert(keys[0], 1000);
+        CHECK(testMap.Size() == itemCount);
+        CHECK(*testMap.Find("key0") == 1000);
+        
+        //erase every second key then make sure the rest can still be found
+        for(uint32 i = 0; i < itemCount; i += 2)
+            CHECK(testMap.Erase(keys[i]));
+        
+        CHECK(testMap.Size() == itemCount / 2);
+        for(uint32 i = 1; i < itemCount; i += 2)
+        {
+            const uint32 *value = testMap.Find(keys[i]);
+            CHECK(value && (*value == i));
+            CHECK(testMap.Find(keys[i - 1]) == 0);
+        }
+        
+        CHECK(!testMap.Erase(keys[0]));
+        testMap.Clear();
+        CHECK(testMap.Empty());
+        CHECK(testMap.Find(keys[1]) == 0);
+    }
+}
+
+/*
+    Compares the compile time selected math backend (see MashCompileSettings.h)
+    against the scalar kernels. Timings are in Source/Benchmarks.
+*/
+SUITE(MathTest)
+{
+    f32 RandomFloat()
+    {
+        return ((f32)rand() / (f32)RAND_MAX) * 4.0f - 2.0f;
+    }
+    
+    bool ArrayEquals(const f32 *a, const f32 *b, uint32 count, f32 ep)
+    {
+        for(uint32 i = 0; i < count; ++i)
+        {
+            if (!math::FloatEqualTo(a[i], b[i], ep))
+                return false;
+        }
+        
+        return true;
+    }
+    
+    TEST(MatrixMultiply)
+    {
+        MashMatrix4 a(false), b(false), scalarResult(false);
+        for(uint32 i = 0; i < 16; ++i)
+        {
+            a.v[i] = RandomFloat();
+            b.v[i] = RandomFloat();
+        }
+        
+        MashMatrix4 result = a * b;
+        simd::MatrixMultiplyScalar(a.v, b.v, scalarResult.v);
+        CHECK(result.Equals(scalarResult, 0.0001f));
+    }
+    
+    TEST(MatrixInverse)
+    {
+        MashMatrix4 a(MashQuaternion(0.7071f, 0.0f, 0.7071f, 0.0f), MashVector3(1.0f, 2.0f, 3.0f), MashVector3(2.0f, 2.0f, 2.0f));
+        MashMatrix4 scalarResult(false);
+        CHECK(simd::MatrixInverseScalar(a.v, scalarResult.v));
+        
+        MashMatrix4 result(a);
+        result.Invert();
+        CHECK(result.Equals(scalarResult, 0.0001f));
+        CHECK((a * result).Equals(MashMatrix4(), 0.0001f));
+        
+        //singular matrices are left unchanged
+        MashMatrix4 singular(false);
+        memset(singular.v, 0, sizeof(singular.v));
+        singular.Invert();
+        CHECK(singular.v[0] == 0.0f);
+        
+        //repeated inversion stays in step with the scalar kernel
+        for(uint32 i = 0; i < 1001; ++i)
+        {
+            simd::MatrixInverseScalar(scalarResult.v, scalarResult.v);
+            result.Invert();
+        }
+        
+        CHECK(result.Equals(scalarResult, 0.001f));
+    }
+    
+    TEST(QuaternionInterpolation)
+    {
+        MashQuaternion a, b, result, scalarResult;
+        a.SetEuler(10.0f, 45.0f, 0.0f);
+        b.SetEuler(-30.0f, 120.0f, 60.0f);
+        
+        result.Slerp(a, b, 0.3f);
+        simd::QuaternionSlerpScalar(a.v, b.v, 0.3f, scalarResult.v);
+        CHECK(ArrayEquals(result.v, scalarResult.v, 4, 0.0001f));
+        CHECK(math::FloatEqualTo(result.DotProduct(result), 1.0f, 0.001f));
+        
+        result.Nlerp(a, b, 0.3f);
+        simd::QuaternionNlerpScalar(a.v, b.v, 0.3f, scalarResult.v);
+        CHECK(ArrayEquals(result.v, scalarResult.v, 4, 0.0001f));
+        CHECK(math::FloatEqualTo(result.DotProduct(result), 1.0f, 0.001f));
+        
+        //end points
+        result.Nlerp(a, b, 1.0f);
+        CHECK(ArrayEquals(result.v, b.v, 4, 0.0001f));
+    }
+    
+    TEST(VectorTransform)
+    {
+        MashMatrix4 m(MashQuaternion(0.7071f, 0.7071f, 0.0f, 0.0f), MashVector3(1.0f, 2.0f, 3.0f), MashVector3(1.0f, 2.0f, 3.0f));
+        MashVector3 point(4.0f, 5.0f, 6.0f);
+        MashVector3 result, scalarResult;
+        
+        result = m.TransformVector(point);
+        simd::TransformPointScalar(m.v, point.v, scalarResult.v);
+        CHECK(ArrayEquals(result.v, scalarResult.v, 3, 0.0001f));
+        
+        MashVector4 vec4(4.0f, 5.0f, 6.0f, 1.0f);
+        MashVector4 result4 = m.TransformVector(vec4);
+        CHECK(ArrayEquals(result4.v, result.v, 3, 0.0001f));
+    }
+    
+    TEST(AABBTransform)
+    {
+        MashMatrix4 m(MashQuaternion(0.9238f, 0.0f, 0.3826f, 0.0f), MashVector3(10.0f, -2.0f, 3.0f), MashVector3(1.0f, 2.0f, 0.5f));
+        const MashAABB box(MashVector3(-1.0f, -2.0f, -3.0f), MashVector3(3.0f, 2.0f, 1.0f));
+        
+        MashAABB result(box);
+        result.Transform(m);
+        
+        MashAABB scalarResult;
+        simd::AABBTransformScalar(m.v, box.min.v, box.max.v, scalarResult.min.v, scalarResult.max.v);
+        CHECK(ArrayEquals(result.min.v, scalarResult.min.v, 3, 0.0001f));
+        CHECK(ArrayEquals(result.max.v, scalarResult.max.v, 3, 0.0001f));
+        
+        //every corner must be within the transformed box
+        MashVector3 corners[8];
+        box.GetVerticies(corners);
+        for(uint32 i = 0; i < 8; ++i)
+        {
+            const MashVector3 corner = m.TransformVector(corners[i]);
+            CHECK(corner.x >= result.min.x - 0.0001f && corner.x <= result.max.x + 0.0001f);
+            CHECK(corner.y >= result.min.y - 0.0001f && corner.y <= result.max.y + 0.0001f);
+            CHECK(corner.z >= result.min.z - 0.0001f && corner.z <= result.max.z + 0.0001f);
+        }
+        
+        //transform states give the same result as their matrix form
+        MashQuaternion orientation(0.9238f, 0.0f, 0.3826f, 0.0f);
+        orientation.Normalize();
+        const MashTransformState state(MashVector3(10.0f, -2.0f, 3.0f), MashVector3(1.0f, 2.0f, 0.5f), orientation);
+        MashAABB stateResult(box);
+        stateResult.Transform(state);
+        MashAABB matrixResult(box);
+        matrixResult.Transform(state.ToMatrix());
+        CHECK(ArrayEquals(stateResult.min.v, matrixResult.min.v, 3, 0.0001f));
+        CHECK(ArrayEquals(stateResult.max.v, matrixResult.max.v, 3, 0.0001f));
+        
+        MashAABB inverseStateResult(box);
+        inverseStateResult.TransformInverse(state);
+        MashAABB inverseMatrixResult(box);
+        inverseMatrixResult.Transform(state.ToMatrix().Invert());
+        CHECK(ArrayEquals(inverseStateResult.min.v, inverseMatrixResult.min.v, 3, 0.001f));
+        CHECK(ArrayEquals(inverseStateResult.max.v, inverseMatrixResult.max.v, 3, 0.001f));
+    }
+    
+    TEST(RayKernels)
+    {
+        const uint32 testCount = 500;
+        
+        //four rays against one box. Some rays are parallel to an axis.
+        uint32 aabbMismatches = 0;
+        uint32 aabbHits = 0;
+        for(uint32 test = 0; test < testCount; ++test)
+        {
+            MashAABB box(MashVector3(RandomFloat(), RandomFloat(), RandomFloat()), MashVector3(RandomFloat(), RandomFloat(), RandomFloat()));
+            box.Repair();
+            
+            MashRay rays[4];
+            f32 origins[12], dirs[12];
+            for(uint32 lane = 0; lane < 4; ++lane)
+            {
+                rays[lane].origin = MashVector3(RandomFloat(), RandomFloat(), RandomFloat()) * 3.0f;
+                rays[lane].dir = MashVector3(RandomFloat(), RandomFloat(), RandomFloat());
+                if ((test % 5) == lane)
+                    rays[lane].dir.v[test % 3] = 0.0f;
+                
+                for(uint32 axis = 0; axis < 3; ++axis)
+                {
+                    origins[(axis * 4) + lane] = rays[lane].origin.v[axis];
+                    dirs[(axis * 4) + lane] = rays[lane].dir.v[axis];
+                }
+            }
+            
+            f32 t[4], scalarT[4];
+            const uint32 mask = simd::RayAABB4(box.min.v, box.max.v, origins, dirs, t);
+            if (mask != simd::RayAABB4Scalar(box.min.v, box.max.v, origins, dirs, scalarT))
+                ++aabbMismatches;
+            
+            for(uint32 lane = 0; lane < 4; ++lane)
+            {
+                f32 expectedT = 0.0f;
+                const bool hit = collision::Ray_AABB(box, rays[lane], expectedT);
+                if (hit != ((mask & (1 << lane)) != 0))
+                    ++aabbMismatches;
+                else if (hit && ((t[lane] != expectedT) || (scalarT[lane] != expectedT)))
+                    ++aabbMismatches;
+                
+                if (hit)
+                    ++aabbHits;
+            }
+        }
+        
+        CHECK(aabbHits > 0);
+        CHECK(aabbMismatches == 0);
+        
+        //one ray against four triangles. Results must match collision::Ray_Triangle exactly.
+        uint32 triangleMismatches = 0;
+        uint32 triangleHits = 0;
+        for(uint32 test = 0; test < testCount; ++test)
+        {
+            MashVector3 points[4][3];
+            f32 triangles[36];
+            for(uint32 lane = 0; lane < 4; ++lane)
+            {
+                for(uint32 p = 0; p < 3; ++p)
+                {
+                    points[lane][p] = MashVector3(RandomFloat(), RandomFloat(), RandomFloat());
+                    for(uint32 axis = 0; axis < 3; ++axis)
+                        triangles[(p * 12) + (axis * 4) + lane] = points[lane][p].v[axis];
+                }
+            }
+            
+            const MashRay ray(MashVector3(RandomFloat(), RandomFloat(), RandomFloat()) * 3.0f, MashVector3(RandomFloat(), RandomFloat(), RandomFloat()));
+            
+            f32 t[4], v[4], w[4];
+            f32 scalarT[4], scalarV[4], scalarW[4];
+            const uint32 mask = simd::RayTriangle4(triangles, ray.origin.v, ray.dir.v, t, v, w);
+            if (mask != simd::RayTriangle4Scalar(triangles, ray.origin.v, ray.dir.v, scalarT, scalarV, scalarW))
+                ++triangleMismatches;
+            
+            for(uint32 lane = 0; lane < 4; ++lane)
+            {
+                f32 expectedU, expectedV, expectedW, expectedT;
+                const bool hit = collision::Ray_Triangle(points[lane][0], points[lane][1], points[lane][2], ray, expectedU, expectedV, expectedW, expectedT);
+                if (hit != ((mask & (1 << lane)) != 0))
+                    ++triangleMismatches;
+                else if (hit && ((t[lane] != expectedT) || (v[lane] != expectedV) || (w[lane] != expectedW) || (scalarT[lane] != expectedT)))
+                    ++triangleMismatches;
+                
+                if (hit)
+                    ++triangleHits;
+            }
+        }
+        
+        CHECK(triangleHits > 0);
+        CHECK(triangleMismatches == 0);
+        
+        //zeroed lanes never hit
+        f32 emptyTriangles[36];
+        memset(emptyTriangles, 0, sizeof(emptyTriangles));
+        const f32 origin[3] = {0.0f, 0.0f, -1.0f};
+        const f32 dir[3] = {0.0f, 0.0f, 1.0f};
+        f32 t[4], v[4], w[4];
+        CHECK(simd::RayTriangle4(emptyTriangles, origin, dir, t, v, w) == 0);
+    }
+    
+    TEST(BatchKernels)
+    {
+        //interleaved like vertex data
+        struct sTestVertex
+        {
+            MashVector3 position;
+            MashVector2 texcoord;
+        };
+        
+        const uint32 vertexCount = 101;
+        sTestVertex vertices[vertexCount];
+        MashVector3 points[vertexCount];
+        for(uint32 i = 0; i < vertexCount; ++i)
+            vertices[i].position = MashVector3(RandomFloat(), RandomFloat(), RandomFloat());
+        
+        const MashTransformState state(MashVector3(1.0f, 2.0f, 3.0f), MashVector3(1.0f, 2.0f, 0.5f), MashQuaternion(0.9238f, 0.0f, 0.3826f, 0.0f));
+        kernels::TransformPoints(state, vertices, sizeof(sTestVertex), points, sizeof(MashVector3), vertexCount);
+        
+        MashAABB expectedBounds;
+        for(uint32 i = 0; i < vertexCount; ++i)
+        {
+            CHECK(ArrayEquals(points[i].v, state.Transform(vertices[i].position).v, 3, 0.0001f));
+            expectedBounds.Add(vertices[i].position);
+        }
+        
+        MashAABB bounds;
+        kernels::ComputeBounds(vertices, sizeof(sTestVertex), vertexCount, bounds);
+        CHECK(ArrayEquals(bounds.min.v, expectedBounds.min.v, 3, 0.0f));
+        CHECK(ArrayEquals(bounds.max.v, expectedBounds.max.v, 3, 0.0f));
+        
+        MashAABB boxes[2] = {MashAABB(MashVector3(-1.0f, 0.0f, 0.0f), MashVector3(0.0f, 1.0f, 1.0f)),
+            MashAABB(MashVector3(0.0f, -2.0f, 0.0f), MashVector3(3.0f, 0.0f, 1.0f))};
+        MashAABB merged;
+        kernels::MergeAABBs(boxes, 2, merged);
+        CHECK(merged.min == MashVector3(-1.0f, -2.0f, 0.0f));
+        CHECK(merged.max == MashVector3(3.0f, 1.0f, 1.0f));
+        
+        kernels::NormalizeVectors(vertices, sizeof(sTestVertex), vertexCount);
+        for(uint32 i = 0; i < vertexCount; ++i)
+            CHECK(math::FloatEqualTo(vertices[i].position.Length(), 1.0f, 0.0001f));
+        
+        MashQuaternion quaternions[2] = {MashQuaternion(2.0f, 0.0f, 0.0f, 0.0f), MashQuaternion(0.0f, 0.0f, 0.0f, 0.0f)};
+        kernels::NormalizeQuaternions(quaternions, 2);
+        CHECK(quaternions[0] == MashQuaternion(1.0f, 0.0f, 0.0f, 0.0f));
+        CHECK(quaternions[1] == MashQuaternion(1.0f, 0.0f, 0.0f, 0.0f));
+        
+        MashMatrix4 a[3], b[3], results[3];
+        for(uint32 i = 0; i < 3; ++i)
+        {
+            a[i] = state.ToMatrix();
+            b[i].CreateTranslation(MashVector3((f32)i, 0.0f, 0.0f));
+        }
+        kernels::MultiplyMatrices(a, b, results, 3);
+        for(uint32 i = 0; i < 3; ++i)
+            CHECK(results[i].Equals(a[i] * b[i]));
+    }
+}
+
+SUITE(LightClusterTest)
+{
+    f32 RandomValue()
+    {
+        return ((f32)rand() / (f32)RAND_MAX) * 4.0f - 2.0f;
+    }
+    
+    MashLightClusterGrid::sLightVolume PointLight(const MashVector3 &position, f32 range)
+    {
+        MashLightClusterGrid::sLightVolume light;
+        light.type = aLIGHT_POINT;
+        light.position = position;
+        light.range = range;
+        light.direction = MashVector3(0.0f, 0.0f, 1.0f);
+        light.cosOuterCone = 0.0f;
+        return light;
+    }
+    
+    bool ClusterHasLight(const MashLightClusterGrid &grid, int32 cluster, uint32 light)
+    {
+        if (cluster < 0)
+            return false;
+        
+        const MashLightClusterGrid::sCluster &c = grid.GetClusters()[cluster];
+        for(uint32 i = 0; i < c.count; ++i)
+        {
+            if (grid.GetLightIndices()[c.offset + i] == light)
+                return true;
+        }
+        
+        return false;
+    }
+    
+    TEST(Binning)
+    {
+        MashLightClusterGrid grid;
+        grid.SetGridSize(8, 4, 16);
+        grid.SetProjection(math::DegsToRads(60.0f), 16.0f / 9.0f, 1.0f, 500.0f);
+        
+        MashLightClusterGrid::sLightVolume lights[3];
+        lights[0] = PointLight(MashVector3(2.0f, 1.0f, 20.0f), 3.0f);
+        
+        lights[1] = PointLight(MashVector3(0.0f, 0.0f, 0.0f), 0.0f);
+        lights[1].type = aLIGHT_DIRECTIONAL;
+        
+        //spot light pointing down +x from the left of the view
+        lights[2] = PointLight(MashVector3(-10.0f, 0.0f, 50.0f), 20.0f);
+        lights[2].type = aLIGHT_SPOT;
+        lights[2].direction = MashVector3(1.0f, 0.0f, 0.0f);
+        lights[2].cosOuterCone = cos(math::DegsToRads(20.0f));
+        
+        grid.Build(lights, 3);
+        
+        CHECK(grid.GetClusterCount() == 8 * 4 * 16);
+        CHECK(grid.GetClusterIndex(MashVector3(0.0f, 0.0f, 0.5f)) == -1);
+        CHECK(grid.GetClusterIndex(MashVector3(0.0f, 0.0f, 600.0f)) == -1);
+        
+        //directional lights touch every cluster
+        for(uint32 i = 0; i < grid.GetClusterCount(); ++i)
+            CHECK(ClusterHasLight(grid, i, 1));
+        
+        CHECK(ClusterHasLight(grid, grid.GetClusterIndex(MashVector3(2.0f, 1.0f, 20.0f)), 0));
+        CHECK(ClusterHasLight(grid, grid.GetClusterIndex(MashVector3(3.5f, 1.0f, 21.0f)), 0));
+        CHECK(!ClusterHasLight(grid, grid.GetClusterIndex(MashVector3(2.0f, 1.0f, 200.0f)), 0));
+        
+        CHECK(ClusterHasLight(grid, grid.GetClusterIndex(MashVector3(0.0f, 0.0f, 50.0f)), 2));
+        CHECK(!ClusterHasLight(grid, grid.GetClusterIndex(MashVector3(-10.0f, 0.0f, 10.0f)), 2));
+        
+        //every point inside a light must find it in its cluster
+        srand(1);
+        uint32 missed = 0;
+        for(uint32 i = 0; i < 10000; ++i)
+        {
+            const MashVector3 offset(RandomValue(), RandomValue(), RandomValue());
+            const MashVector3 point = lights[0].position + (offset * (lights[0].range / 4.0f));
+            if ((point.GetDistanceTo(lights[0].position) < lights[0].range) && !ClusterHasLight(grid, grid.GetClusterIndex(point), 0))
+                ++missed;
+        }
+        CHECK(missed == 0);
+        
+        //rebuilding an unchanged scene gives the same result
+        MashArray<uint32> indices;
+        indices.Append(grid.GetLightIndices(), grid.GetLightIndexCount());
+        grid.Build(lights, 3);
+        CHECK(grid.GetLightIndexCount() == indices.Size());
+        CHECK(memcmp(indices.Pointer(), grid.GetLightIndices(), sizeof(uint32) * indices.Size()) == 0);
+    }
+    
+    TEST(TileLights)
+    {
+        MashLightClusterGrid grid;
+        grid.SetGridSize(8, 4, 16);
+        grid.SetProjection(math::DegsToRads(60.0f), 16.0f / 9.0f, 1.0f, 500.0f);
+        
+        MashLightClusterGrid::sLightVolume lights[2];
+        lights[0] = PointLight(MashVector3(2.0f, 1.0f, 20.0f), 3.0f);
+        lights[1] = PointLight(MashVector3(0.0f, 0.0f, 0.0f), 0.0f);
+        lights[1].type = aLIGHT_DIRECTIONAL;
+        
+        grid.Build(lights, 2);
+        
+        const uint32 cluster = grid.GetClusterIndex(MashVector3(2.0f, 1.0f, 20.0f));
+        const uint32 tileX = cluster % grid.GetTilesX();
+        const uint32 tileY = (cluster / grid.GetTilesX()) % grid.GetTilesY();
+        
+        //each light is listed once even though the point light spans several slices
+        MashArray<uint32> tileLights;
+        CHECK(grid.GetTileLights(tileX, tileY, 10.0f, 30.0f, tileLights) == 2);
+        CHECK((tileLights[0] == 0) && (tileLights[1] == 1));
+        
+        CHECK(grid.GetTileLights(tileX, tileY, 200.0f, 300.0f, tileLights) == 1);
+        CHECK(tileLights[0] == 1);
+        
+        CHECK(grid.GetTileLights(tileX, tileY, 600.0f, 700.0f, tileLights) == 0);
+        CHECK(grid.GetTileLights(grid.GetTilesX(), tileY, 10.0f, 30.0f, tileLights) == 0);
+    }
+    
+    TEST(Threaded)
+    {
+        const uint32 lightCount = 1024;
+        MashArray<MashLightClusterGrid::sLightVolume> lights;
+        srand(2);
+        for(uint32 i = 0; i < lightCount; ++i)
+        {
+            const MashVector3 position(RandomValue() * 50.0f, RandomValue() * 25.0f, 5.0f + ((RandomValue() + 2.0f) * 60.0f));
+            lights.PushBack(PointLight(position, 2.0f + (RandomValue() + 2.0f)));
+        }
+        
+        MashLightClusterGrid grid;
+        grid.SetProjection(math::DegsToRads(60.0f), 16.0f / 9.0f, 1.0f, 500.0f);
+        grid.SetMaxThreads(1);
+        grid.Build(lights.Pointer(), lightCount);
+        
+        MashArray<uint32> indices;
+        indices.Append(grid.GetLightIndices(), grid.GetLightIndexCount());
+        
+        //threading must not change the result
+        grid.SetMaxThreads(4);
+        grid.Build(lights.Pointer(), lightCount);
+        CHECK(grid.GetLightIndexCount() == indices.Size());
+        CHECK(memcmp(indices.Pointer(), grid.GetLightIndices(), sizeof(uint32) * indices.Size()) == 0);
+    }
+}
+
+SUITE(LightInfluenceTest)
+{
+    TEST(Influences)
+    {
+        MashLightInfluenceIndex index(10.0f);
+        const MashVector3 attenuation(0.0f, 0.125f, 1.0f);
+        
+        index.SetLight(0, MashVector3(0.0f, 0.0f, 0.0f), 5.0f, attenuation, 1.0f);
+        index.SetLight(1, MashVector3(3.0f, 0.0f, 0.0f), 5.0f, attenuation, 1.0f);
+        index.SetLight(2, MashVector3(100.0f, 0.0f, 0.0f), 5.0f, attenuation, 1.0f);
+        //covers too many cells to hash
+        index.SetLight(3, MashVector3(0.0f, 500.0f, 0.0f), 1000.0f, attenuation, 0.1f);
+        CHECK(index.GetLightCount() == 4);
+        
+        MashAABB bounds(MashVector3(4.0f, -1.0f, -1.0f), MashVector3(6.0f, 1.0f, 1.0f));
+        uint32 lights[4];
+        
+        //closest light first, light 2 is out of range
+        CHECK(index.GetInfluences(bounds, 4, lights) == 3);
+        CHECK((lights[0] == 1) && (lights[1] == 0) && (lights[2] == 3));
+        
+        CHECK(index.GetInfluences(bounds, 1, lights) == 1);
+        CHECK(lights[0] == 1);
+        
+        //moving within the same cells doesn't rehash
+        index.SetLight(2, MashVector3(101.0f, 0.0f, 0.0f), 5.0f, attenuation, 1.0f);
+        CHECK(index.GetRehashCount() == 0);
+        
+        index.SetLight(2, MashVector3(6.0f, 0.0f, 0.0f), 5.0f, attenuation, 1.0f);
+        CHECK(index.GetRehashCount() == 1);
+        CHECK(index.GetInfluences(bounds, 4, lights) == 4);
+        CHECK(lights[0] == 2);
+        
+        index.RemoveLight(2);
+        index.RemoveLight(3);
+        CHECK(index.GetLightCount() == 2);
+        CHECK(index.GetInfluences(bounds, 4, lights) == 2);
+        CHECK((lights[0] == 1) && (lights[1] == 0));
+    }
+}
+
+SUITE(TextParserTest)
+{
+    TEST(ParseFloat)
+    {
+        const int8 *formats[] = {"%.6f", "%.9g", "%.3e", "%.17g", "%g", "%.1f"};
+        int8 buffer[64];
+        srand(3);
+        uint32 mismatches = 0;
+        for(uint32 i = 0; i < 100000; ++i)
+        {
+            const f64 value = (((f64)rand() / RAND_MAX) - 0.5) * pow(10.0, (f64)((rand() % 30) - 15));
+            sprintf(buffer, formats[i % 6], value);
+            
+            //must round exactly like strtof
+            f32 parsed = 1.0f;
+            const int8 *end = text::ParseFloat(buffer, parsed);
+            const f32 expected = strtof(buffer, 0);
+            if ((memcmp(&parsed, &expected, sizeof(f32)) != 0) || (*end != 0))
+                ++mismatches;
+        }
+        CHECK(mismatches == 0);
+        
+        f32 value = 1.0f;
+        CHECK(*text::ParseFloat("-.5e-3", value) == 0);
+        CHECK(value == -0.0005f);
+        //an 'e' without digits isn't part of the number
+        CHECK(*text::ParseFloat("2e", value) == 'e');
+        CHECK(value == 2.0f);
+        const int8 *notNumber = "abc";
+        CHECK(text::ParseFloat(notNumber, value) == notNumber);
+        
+        f32 floats[6];
+        CHECK(text::ParseFloatArray("  \n\t1.5 2x\r\n-3 abc                                  4", floats, 6) == 5);
+        CHECK((floats[0] == 1.5f) && (floats[1] == 2.0f) && (floats[2] == -3.0f) && (floats[3] == 0.0f) && (floats[4] == 4.0f));
+        CHECK(text::ParseFloatArray("1 2 3", floats, 2) == 2);
+        
+        int32 ints[4];
+        CHECK(text::ParseIntArray(" 1 -2 +3 2147483647 ", ints, 4) == 4);
+        CHECK((ints[0] == 1) && (ints[1] == -2) && (ints[2] == 3) && (ints[3] == 2147483647));
+        
+        bool bools[3];
+        CHECK(text::ParseBoolArray("true false 1", bools, 3) == 3);
+        CHECK(bools[0] && !bools[1] && bools[2]);
+    }
+    
+    TEST(ExtractElementText)
+    {
+        int8 document[] = "<?xml version=\"1.0\"?><!-- <p>0</p> --><a>"
+            "<float_array count=\"3\">1 2 3</float_array><p/><p>1 <b/>2</p><p a='>'>4 5</p><v>&amp;</v></a>";
+        int8 documentOut[sizeof(document)];
+        const int8 *names[] = {"float_array", "p", "v"};
+        MashArray<const int8*> elementText;
+        
+        CHECK(text::ExtractElementText(document, names, 3, documentOut, elementText) == 2);
+        CHECK(strcmp(documentOut, "<?xml version=\"1.0\"?><!-- <p>0</p> --><a>"
+            "<float_array count=\"3\"></float_array><p/><p>1 <b/>2</p><p a='>'></p><v>&amp;</v></a>") == 0);
+        
+        //one entry per matching element, 0 when left in the document
+        CHECK(elementText.Size() == 5);
+        CHECK(strcmp(elementText[0], "1 2 3") == 0);
+        CHECK((elementText[1] == 0) && (elementText[2] == 0) && (elementText[4] == 0));
+        CHECK(strcmp(elementText[3], "4 5") == 0);
+    }
+    
+    TEST(Document)
+    {
+        //generated COLLADA style mesh
+        const uint32 floatCount = 30000;
+        const uint32 indexCount = 15000;
+        MashArray<int8> document;
+        int8 buffer[32];
+        const int8 *header = "<?xml version=\"1.0\"?>\n<COLLADA><library_geometries><geometry><mesh><source>"
+            "<float_array count=\"30000\">\n";
+        document.Append(header, strlen(header));
+        srand(4);
+        for(uint32 i = 0; i < floatCount; ++i)
+        {
+            const int32 length = sprintf(buffer, ((i % 3) == 2) ? "%.6f\n" : "%.6f ", (((f64)rand() / RAND_MAX) - 0.5) * 200.0);
+            document.Append(buffer, length);
+        }
+        
+        const int8 *middle = "</float_array></source><triangles count=\"5000\"><p>";
+        document.Append(middle, strlen(middle));
+        for(uint32 i = 0; i < indexCount; ++i)
+        {
+            const int32 length = sprintf(buffer, "%d ", (int32)(i % 65536));
+            document.Append(buffer, length);
+        }
+        
+        const int8 *footer = "</p></triangles></mesh></geometry></library_geometries></COLLADA>";
+        document.Append(footer, strlen(footer) + 1);
+        
+        MashArray<int8> documentOut;
+        documentOut.Resize(document.Size());
+        MashArray<const int8*> elementText;
+        const int8 *names[] = {"float_array", "p"};
+        CHECK(text::ExtractElementText(document.Pointer(), names, 2, documentOut.Pointer(), elementText) == 2);
+        
+        MashArray<f32> floats;
+        floats.Resize(floatCount);
+        MashArray<int32> indices;
+        indices.Resize(indexCount);
+        CHECK(text::ParseFloatArray(elementText[0], floats.Pointer(), floatCount) == floatCount);
+        CHECK(text::ParseIntArray(elementText[1], indices.Pointer(), indexCount) == indexCount);
+        CHECK(indices[indexCount - 1] == (int32)(indexCount - 1));
+        
+        //must match atof on each token
+        const int8 *str = elementText[0];
+        uint32 tokenLength = 0;
+        uint32 tokenCount = 0;
+        uint32 mismatches = 0;
+        for(;; ++str)
+        {
+            if ((*str == 0) || isspace(*str))
+            {
+                if (tokenLength > 0)
+                {
+                    buffer[tokenLength] = 0;
+                    const f32 expected = (f32)atof(buffer);
+                    if ((tokenCount >= floatCount) || (memcmp(&floats[tokenCount], &expected, sizeof(f32)) != 0))
+                        ++mismatches;
+                    
+                    ++tokenCount;
+                    tokenLength = 0;
+                }
+                
+                if (*str == 0)
+                    break;
+            }
+            else
+                buffer[tokenLength++] = *str;
+        }
+        
+        CHECK(tokenCount == floatCount);
+        CHECK(mismatches == 0);
+    }
+}
+
+SUITE(NullDeviceTest)
+{
+    bool IsStateChange(eNULL_COMMAND_TYPE type)
+    {
+        switch(type)
+        {
+        case aNULL_CMD_SET_RENDER_TARGET:
+        case aNULL_CMD_SET_VIEWPORT:
+        case aNULL_CMD_SET_RASTERIZER_STATE:
+        case aNULL_CMD_SET_BLEND_STATE:
+        case aNULL_CMD_SET_VERTEX_FORMAT:
+            return true;
+        default:
+            return false;
+        };
+    }
+    
+    MashDevice* CreateNullTestDevice(bool createGUI = false)
+    {
+        sMashDeviceSettings deviceSettings;
+        deviceSettings.rendererFunctPtr = CreateMashNullDevice;
+        deviceSettings.headless = true;
+        deviceSettings.screenWidth = 800;
+        deviceSettings.screenHeight = 600;
+        deviceSettings.preferredLightingMode = aLIGHT_TYPE_PIXEL;
+        deviceSettings.rootPaths.PushBack("../../../../../../Media/Materials");
+        
+        if (createGUI)
+        {
+            deviceSettings.guiManagerFunctPtr = CreateMashGUI;
+            deviceSettings.rootPaths.PushBack("../../../../../../Media/GUI");
+        }
+        
+        return CreateDevice(deviceSettings);
+    }
+    
+    TEST(SceneCommandLog)
+    {
+        MashDevice *device = CreateNullTestDevice();
+        CHECK(device != 0);
+        if (!device)
+            return;
+        
+        MashNullVideo *renderer = (MashNullVideo*)device->GetRenderer();
+        MashSceneManager *sceneManager = device->GetSceneManager();
+        MashMaterial *material = renderer->GetMaterialManager()->GetStandardMaterial(MashMaterialManager::aSTANDARD_MATERIAL_DEFAULT_MESH);
+        CHECK(material != 0);
+        
+        MashMesh *sphereMesh = sceneManager->CreateStaticMesh();
+        CHECK(sceneManager->GetMeshBuilder()->CreateSphere(sphereMesh, 1.0f, 10, material->GetVertexDeclaration()) == aMASH_OK);
+        MashModel *model = sceneManager->CreateModel();
+        model->Append(&sphereMesh);
+        sphereMesh->Drop();
+        
+        MashDummy *root = sceneManager->AddDummy(0, "nullRoot");
+        MashCamera *camera = sceneManager->AddCamera(root, "nullCamera");
+        camera->SetZNear(1.0f);
+        camera->SetZFar(1000.0f);
+        CHECK(sceneManager->SetActiveCamera(camera) == aMASH_OK);
+        
+        //three visible entities sharing one material, one behind the camera
+        const uint32 visibleCount = 3;
+        for(uint32 i = 0; i < visibleCount; ++i)
+        {
+            MashEntity *entity = sceneManager->AddEntity(root, model, "visibleEntity");
+            entity->SetPosition(MashVector3(((f32)i - 1.0f) * 4.0f, 0.0f, 30.0f));
+        }
+        
+        MashEntity *culledEntity = sceneManager->AddEntity(root, model, "culledEntity");
+        culledEntity->SetPosition(MashVector3(0.0f, 0.0f, -30.0f));
+        
+        const MashMeshBuffer *sphereBuffer = model->GetMesh(0)->GetMeshBuffer();
+        model->Drop();
+        
+        renderer->SetCommandLogEnabled(true);
+        for(uint32 frame = 0; frame < 2; ++frame)
+        {
+            sceneManager->UpdateScene(0.0f, root);
+            
+            CHECK(renderer->BeginRender() == aMASH_OK);
+            CHECK(sceneManager->CullScene(root) == aMASH_OK);
+            CHECK(sceneManager->DrawScene() == aMASH_OK);
+            CHECK(renderer->EndRender() == aMASH_OK);
+            
+            const MashArray<sNullCommand> &commandLog = renderer->GetCommandLog();
+            const sNullFrameStats &stats = renderer->GetLastFrameStats();
+            
+            uint32 drawCount = 0;
+            uint32 sphereDrawCount = 0;
+            uint32 stateChangeCount = 0;
+            uint32 stateChangesBetweenSphereDraws = 0;
+            uint32 stateChangesSinceLastSphereDraw = 0;
+            for(uint32 i = 0; i < commandLog.Size(); ++i)
+            {
+                const sNullCommand &command = commandLog[i];
+                if (IsStateChange(command.type))
+                {
+                    ++stateChangeCount;
+                    ++stateChangesSinceLastSphereDraw;
+                }
+                else if ((command.type == aNULL_CMD_DRAW_INDEXED) ||
+                    (command.type == aNULL_CMD_DRAW_VERTEX) ||
+                    (command.type == aNULL_CMD_DRAW_VERTEX_INSTANCED) ||
+                    (command.type == aNULL_CMD_DRAW_INDEXED_INSTANCED))
+                {
+                    ++drawCount;
+                    if (command.object == sphereBuffer)
+                    {
+                        if (sphereDrawCount > 0)
+                            stateChangesBetweenSphereDraws += stateChangesSinceLastSphereDraw;
+                        
+                        ++sphereDrawCount;
+                        stateChangesSinceLastSphereDraw = 0;
+                    }
+                }
+            }
+            
+            CHECK(commandLog[0].type == aNULL_CMD_BEGIN_RENDER);
+            CHECK(commandLog[commandLog.Size() - 1].type == aNULL_CMD_END_RENDER);
+            
+            //the entity behind the camera must be culled
+            CHECK(sphereDrawCount == visibleCount);
+            CHECK(stats.drawCount == drawCount);
+            CHECK(stats.stateChangeCount == stateChangeCount);
+            
+            //entities with the same material are batched without redundant state changes
+            CHECK(stateChangesBetweenSphereDraws == 0);
+            CHECK(stats.effectChangeCount <= stats.drawCount);
+        }
+        
+        sceneManager->RemoveAllSceneNodes();
+        device->Drop();
+    }
+    
+    TEST(SkipsUnchangedParameters)
+    {
+        MashDevice *device = CreateNullTestDevice();
+        CHECK(device != 0);
+        if (!device)
+            return;
+        
+        MashVideo *renderer = device->GetRenderer();
+        MashMaterial *material = renderer->GetMaterialManager()->GetStandardMaterial(MashMaterialManager::aSTANDARD_MATERIAL_DEFAULT_MESH);
+        CHECK(material != 0);
+        MashEffect *effect = material->GetFirstTechnique()->GetTechnique()->GetEffect();
+        
+        MashEffectParamHandle *parameter = MASH_NEW_COMMON MashEffectParamHandle();
+        const MashVector4 valueA(1.0f, 2.0f, 3.0f, 4.0f);
+        const MashVector4 valueB(5.0f, 6.0f, 7.0f, 8.0f);
+        
+        CHECK(renderer->BeginRender() == aMASH_OK);
+        CHECK(renderer->GetCurrentFrameConstantBytesUploaded() == 0);
+        
+        effect->SetVector4(parameter, &valueA);
+        CHECK(renderer->GetCurrentFrameConstantBytesUploaded() == sizeof(MashVector4));
+        CHECK(renderer->GetCurrentFrameConstantUploadsSkipped() == 0);
+        
+        //unchanged data is not uploaded again
+        effect->SetVector4(parameter, &valueA);
+        effect->SetVector4(parameter, &valueA);
+        CHECK(renderer->GetCurrentFrameConstantBytesUploaded() == sizeof(MashVector4));
+        CHECK(renderer->GetCurrentFrameConstantUploadsSkipped() == 2);
+        
+        effect->SetVector4(parameter, &valueB);
+        CHECK(renderer->GetCurrentFrameConstantBytesUploaded() == (sizeof(MashVector4) * 2));
+        CHECK(renderer->EndRender() == aMASH_OK);
+        
+        //the last upload is remembered across frames
+        CHECK(renderer->BeginRender() == aMASH_OK);
+        effect->SetVector4(parameter, &valueB);
+        CHECK(renderer->GetCurrentFrameConstantBytesUploaded() == 0);
+        CHECK(renderer->GetCurrentFrameConstantUploadsSkipped() == 1);
+        
+        //per object parameters are always uploaded
+        parameter->_SetChangeTracking(false);
+        effect->SetVector4(parameter, &valueB);
+        CHECK(renderer->GetCurrentFrameConstantBytesUploaded() == sizeof(MashVector4));
+        CHECK(renderer->EndRender() == aMASH_OK);
+        
+        parameter->Drop();
+        device->Drop();
+    }
+    
+    TEST(TransientBufferRing)
+    {
+        MashDevice *device = CreateNullTestDevice();
+        CHECK(device != 0);
+        if (!device)
+            return;
+        
+        MashNullVideo *renderer = (MashNullVideo*)device->GetRenderer();
+        MashMaterial *material = renderer->GetMaterialManager()->GetStandardMaterial(MashMaterialManager::aSTANDARD_MATERIAL_DEFAULT_MESH);
+        CHECK(material != 0);
+        
+        MashVertex *vertexDecl = material->GetVertexDeclaration();
+        MashTransientVertexBuffer *transientBuffer = renderer->GetTransientVertexBuffer(vertexDecl);
+        CHECK(transientBuffer != 0);
+        CHECK(renderer->GetTransientVertexBuffer(vertexDecl) == transientBuffer);
+        
+        const uint32 stride = vertexDecl->GetStreamSizeInBytes(0);
+        const uint32 chunkVertexCount = 1000;
+        MashArray<uint8> vertices;
+        vertices.Resize(chunkVertexCount * 4 * stride, 0);
+        
+        renderer->SetCommandLogEnabled(true);
+        CHECK(renderer->BeginRender() == aMASH_OK);
+        const MashArray<sNullCommand> &commandLog = renderer->GetCommandLog();
+        
+        //the first write discards, following writes append without waiting on the gpu
+        uint32 firstVertex = math::MaxUInt32();
+        CHECK(transientBuffer->Write(vertices.Pointer(), chunkVertexCount, firstVertex) == aMASH_OK);
+        CHECK(firstVertex == 0);
+        CHECK(commandLog.Back().type == aNULL_CMD_UPDATE_BUFFER);
+        CHECK(commandLog.Back().args[1] == aLOCK_WRITE_DISCARD);
+        
+        const MashVertexBuffer *vertexBuffer = transientBuffer->GetMeshBuffer()->GetVertexBuffer();
+        const uint32 vertexCapacity = vertexBuffer->GetBufferSize() / stride;
+        CHECK(vertexCapacity > (chunkVertexCount * 2));
+        
+        uint32 nextVertex = chunkVertexCount;
+        while((nextVertex + chunkVertexCount) <= vertexCapacity)
+        {
+            CHECK(transientBuffer->Write(vertices.Pointer(), chunkVertexCount, firstVertex) == aMASH_OK);
+            CHECK(firstVertex == nextVertex);
+            CHECK(commandLog.Back().args[1] == aLOCK_WRITE_NOOVERWRITE);
+            nextVertex += chunkVertexCount;
+        }
+        
+        //unused locked space is returned to the ring
+        void *lockedData = 0;
+        CHECK(transientBuffer->Lock(1, &lockedData) == aMASH_OK);
+        CHECK(transientBuffer->IsLocked());
+        CHECK(transientBuffer->Unlock(0, firstVertex) == aMASH_OK);
+        CHECK(!transientBuffer->IsLocked());
+        CHECK(firstVertex == nextVertex);
+        
+        //data that doesn't fit wraps to the start of the ring and discards
+        CHECK(transientBuffer->Write(vertices.Pointer(), chunkVertexCount, firstVertex) == aMASH_OK);
+        CHECK(firstVertex == 0);
+        CHECK(commandLog.Back().args[1] == aLOCK_WRITE_DISCARD);
+        CHECK(transientBuffer->GetMeshBuffer()->GetVertexBuffer()->GetBufferSize() == (vertexCapacity * stride));
+        
+        //data larger than the ring grows it
+        vertices.Resize((vertexCapacity + 1) * stride, 0);
+        CHECK(transientBuffer->Write(vertices.Pointer(), vertexCapacity + 1, firstVertex) == aMASH_OK);
+        CHECK(firstVertex == 0);
+        CHECK(commandLog.Back().args[1] == aLOCK_WRITE_DISCARD);
+        const uint32 grownCapacity = transientBuffer->GetMeshBuffer()->GetVertexBuffer()->GetBufferSize() / stride;
+        CHECK(grownCapacity >= (vertexCapacity + 1));
+        
+        CHECK(transientBuffer->Write(vertices.Pointer(), 1, firstVertex) == aMASH_OK);
+        CHECK(firstVertex == (vertexCapacity + 1));
+        CHECK(commandLog.Back().args[1] == aLOCK_WRITE_NOOVERWRITE);
+        
+        CHECK(renderer->EndRender() == aMASH_OK);
+        device->Drop();
+    }
+    
+    void SendMouseMove(MashInputManager *inputManager, int32 x, int32 y)
+    {
+        inputManager->_SetCursorPosition(x, y);
+        
+        sInputEvent mouseEvent = sInputEvent();
+        mouseEvent.eventType = sInputEvent::aEVENTTYPE_MOUSE;
+        mouseEvent.action = aMOUSEEVENT_AXISX;
+        mouseEvent.value = 1.0f;
+        inputManager->ImmediateBroadcast(mouseEvent);
+    }
+    
+    void DrawGUIFrame(MashVideo *renderer, MashGUIManager *guiManager)
+    {
+        CHECK(renderer->BeginRender() == aMASH_OK);
+        CHECK(guiManager->BeginDraw() == aMASH_OK);
+        guiManager->DrawAll();
+        guiManager->EndDraw();
+        CHECK(renderer->EndRender() == aMASH_OK);
+    }
+    
+    TEST(RetainedViewMouseMove)
+    {
+        MashDevice *device = CreateNullTestDevice(true);
+        CHECK(device != 0);
+        if (!device)
+            return;
+        
+        MashGUIManager *guiManager = device->GetGUIManager();
+        CHECK(guiManager != 0);
+        if (!guiManager)
+        {
+            device->Drop();
+            return;
+        }
+        
+        MashVideo *renderer = device->GetRenderer();
+        MashInputManager *inputManager = device->GetInputManager();
+        MashSceneManager *sceneManager = device->GetSceneManager();
+        MashCamera *camera = sceneManager->AddCamera(0, "guiCamera");
+        CHECK(sceneManager->SetActiveCamera(camera) == aMASH_OK);
+        
+        MashGUIView *view = guiManager->AddView(MashGUIRect(MashGUIUnit(0.0f, 100.0f), MashGUIUnit(0.0f, 100.0f),
+            MashGUIUnit(0.0f, 400.0f), MashGUIUnit(0.0f, 400.0f)), guiManager->GetRootWindow());
+        view->SetRetainedMode(true);
+        guiManager->AddButton(MashGUIRect(MashGUIUnit(0.0f, 10.0f), MashGUIUnit(0.0f, 10.0f),
+            MashGUIUnit(0.0f, 90.0f), MashGUIUnit(0.0f, 40.0f)), view);
+        guiManager->AddButton(MashGUIRect(MashGUIUnit(0.0f, 10.0f), MashGUIUnit(0.0f, 200.0f),
+            MashGUIUnit(0.0f, 90.0f), MashGUIUnit(0.0f, 230.0f)), view);
+        
+        //moving into the view is a hover change so the cache is built on the next draw
+        SendMouseMove(inputManager, 250, 150);
+        DrawGUIFrame(renderer, guiManager);
+        DrawGUIFrame(renderer, guiManager);
+        const uint32 steadyGeneratedCount = guiManager->GetGeneratedVertexCount();
+        const uint32 steadyReusedCount = guiManager->GetReusedVertexCount();
+        CHECK(steadyReusedCount > 0);
+        
+        //moving within the same component reuses the cache
+        for(uint32 i = 0; i < 10; ++i)
+            SendMouseMove(inputManager, 250 + (i * 5), 150 + (i * 3));
+        
+        DrawGUIFrame(renderer, guiManager);
+        CHECK(guiManager->GetGeneratedVertexCount() == steadyGeneratedCount);
+        CHECK(guiManager->GetReusedVertexCount() == steadyReusedCount);
+        
+        //moving onto a button changes its hover state and rebuilds the view
+        SendMouseMove(inputManager, 150, 120);
+        DrawGUIFrame(renderer, guiManager);
+        CHECK(guiManager->GetGeneratedVertexCount() > steadyGeneratedCount);
+        CHECK(guiManager->GetReusedVertexCount() == 0);
+        
+        //and is reused again once the hover settles
+        SendMouseMove(inputManager, 155, 122);
+        DrawGUIFrame(renderer, guiManager);
+        CHECK(guiManager->GetGeneratedVertexCount() == steadyGeneratedCount);
+        CHECK(guiManager->GetReusedVertexCount() > 0);
+        
+        device->Drop();
+    }
+    
+    MashGUIRect PixelRect(f32 left, f32 top, f32 right, f32 bottom)
+    {
+        return MashGUIRect(MashGUIUnit(0.0f, left), MashGUIUnit(0.0f, top), MashGUIUnit(0.0f, right), MashGUIUnit(0.0f, bottom));
+    }
+    
+    //same rules as the views linear walk, without any grids
+    MashGUIComponent* BruteForceHitTest(MashGUIComponent *component, const MashVector2 &point)
+    {
+        if (!component->GetRenderEnabled() || !component->GetCanHaveFocus() || (component->GetClipState() == aCULL_CULLED))
+            return 0;
+        
+        MashGUIView *view = component->GetView();
+        if (view)
+        {
+            MashList<MashGUIComponent*>::ConstIterator iter = view->GetChildren().Begin();
+            MashList<MashGUIComponent*>::ConstIterator end = view->GetChildren().End();
+            for(; iter != end; ++iter)
+            {
+                MashGUIComponent *intersects = BruteForceHitTest(*iter, point);
+                if (intersects)
+                    return intersects;
+            }
+        }
+        
+        if (component->GetAbsoluteClippedRegion().IntersectsGUI(point))
+            return component;
+        
+        return 0;
+    }
+    
+    uint32 CountHitTestMismatches(MashGUIManager *guiManager)
+    {
+        uint32 mismatches = 0;
+        for(f32 y = 0.0f; y < 600.0f; y += 7.0f)
+        {
+            for(f32 x = 0.0f; x < 800.0f; x += 7.0f)
+            {
+                const MashVector2 point(x, y);
+                if (guiManager->GetRootWindow()->GetClosestIntersectingChild(point, false) != BruteForceHitTest(guiManager->GetRootWindow(), point))
+                    ++mismatches;
+            }
+        }
+        
+        return mismatches;
+    }
+    
+    TEST(HitTestGrid)
+    {
+        MashDevice *device = CreateNullTestDevice(true);
+        CHECK(device != 0);
+        if (!device)
+            return;
+        
+        MashGUIManager *guiManager = device->GetGUIManager();
+        CHECK(guiManager != 0);
+        if (!guiManager)
+        {
+            device->Drop();
+            return;
+        }
+        
+        //enough children in each view for them to build grids, some overlapping and some clipped
+        MashGUIView *container = guiManager->AddView(PixelRect(20.0f, 20.0f, 420.0f, 420.0f), guiManager->GetRootWindow());
+        MashGUIComponent *containerButtons[48];
+        for(uint32 i = 0; i < 48; ++i)
+        {
+            const f32 left = (f32)(i % 8) * 55.0f;
+            const f32 top = (f32)(i / 8) * 75.0f;
+            containerButtons[i] = guiManager->AddButton(PixelRect(left, top, left + 70.0f, top + 40.0f), container);
+        }
+        
+        MashGUIView *nested = guiManager->AddView(PixelRect(100.0f, 100.0f, 300.0f, 300.0f), container);
+        MashGUIComponent *nestedButtons[20];
+        for(uint32 i = 0; i < 20; ++i)
+        {
+            const f32 left = (f32)(i % 4) * 45.0f;
+            const f32 top = (f32)(i / 4) * 45.0f;
+            nestedButtons[i] = guiManager->AddButton(PixelRect(left, top, left + 40.0f, top + 40.0f), nested);
+        }
+        
+        MashGUIView *sibling = guiManager->AddView(PixelRect(500.0f, 20.0f, 780.0f, 300.0f), guiManager->GetRootWindow());
+        for(uint32 i = 0; i < 20; ++i)
+        {
+            const f32 top = (f32)i * 15.0f;
+            guiManager->AddButton(PixelRect(10.0f, top, 200.0f, top + 12.0f), sibling);
+        }
+        
+        CHECK(CountHitTestMismatches(guiManager) == 0);
+        
+        //layout changes in another view don't affect these grids
+        sibling->SetDestinationRegion(PixelRect(450.0f, 320.0f, 780.0f, 590.0f));
+        CHECK(CountHitTestMismatches(guiManager) == 0);
+        
+        //moving children invalidates only their views grid
+        for(uint32 i = 0; i < 20; i += 3)
+            nestedButtons[i]->AddPosition(13.0f, 21.0f);
+        
+        CHECK(CountHitTestMismatches(guiManager) == 0);
+        
+        containerButtons[5]->SetDestinationRegion(PixelRect(0.0f, 0.0f, 300.0f, 300.0f));
+        containerButtons[17]->SetRenderEnabled(false);
+        containerButtons[30]->SendToFront();
+        CHECK(CountHitTestMismatches(guiManager) == 0);
+        
+        //moving a view moves everything inside it
+        container->AddPosition(35.0f, 10.0f);
+        CHECK(CountHitTestMismatches(guiManager) == 0);
+        
+        nested->SetDestinationRegion(PixelRect(0.0f, 200.0f, 150.0f, 350.0f));
+        CHECK(CountHitTestMismatches(guiManager) == 0);
+        
+        device->Drop();
+    }
+    
+    TEST(SkinPaletteBuffer)
+    {
+        MashDevice *device = CreateNullTestDevice();
+        CHECK(device != 0);
+        if (!device)
+            return;
+        
+        MashNullVideo *renderer = (MashNullVideo*)device->GetRenderer();
+        MashSceneManager *sceneManager = device->GetSceneManager();
+        MashDummy *root = sceneManager->AddDummy(0, "paletteRoot");
+        
+        //skin a has an unused bone id, skin b has its bones added out of order
+        const uint32 boneCount = 4;
+        const uint32 boneIds[boneCount] = {0, 2, 1, 0};
+        MashBone *bones[boneCount];
+        for(uint32 i = 0; i < boneCount; ++i)
+        {
+            bones[i] = sceneManager->AddBone(root, "paletteBone");
+            bones[i]->SetPosition(MashVector3((f32)i, (f32)i * 2.0f, 3.0f));
+            
+            MashMatrix4 bindPose;
+            bindPose.SetTranslation(MashVector3(-1.0f, (f32)i, 0.5f));
+            bones[i]->SetWorldBindPose(bindPose, false);
+        }
+        
+        MashSkin *skinA = sceneManager->CreateSkin();
+        skinA->AddBone(bones[0], boneIds[0]);
+        skinA->AddBone(bones[1], boneIds[1]);
+        MashSkin *skinB = sceneManager->CreateSkin();
+        skinB->AddBone(bones[2], boneIds[2]);
+        skinB->AddBone(bones[3], boneIds[3]);
+        
+        MashSkinPaletteBuffer *paletteBuffer = sceneManager->CreateSkinPaletteBuffer();
+        CHECK(paletteBuffer->AddSkin(skinA) == aMASH_OK);
+        CHECK(paletteBuffer->AddSkin(skinB) == aMASH_OK);
+        CHECK(paletteBuffer->AddSkin(skinA) == aMASH_FAILED);
+        CHECK(paletteBuffer->GetSkinCount() == 2);
+        CHECK(paletteBuffer->GetSkinOffset(skinA) == 0);
+        CHECK(paletteBuffer->GetSkinOffset(skinB) == 3);
+        CHECK(paletteBuffer->GetPaletteSize() == 5);
+        
+        sceneManager->UpdateScene(0.0f, root);
+        
+        renderer->SetCommandLogEnabled(true);
+        CHECK(renderer->BeginRender() == aMASH_OK);
+        CHECK(paletteBuffer->Update() == aMASH_OK);
+        CHECK(paletteBuffer->Update() == aMASH_OK);
+        
+        //all palettes are uploaded together, once per frame
+        uint32 textureUpdateCount = 0;
+        const MashArray<sNullCommand> &commandLog = renderer->GetCommandLog();
+        for(uint32 i = 0; i < commandLog.Size(); ++i)
+        {
+            if (commandLog[i].type == aNULL_CMD_UPDATE_TEXTURE)
+                ++textureUpdateCount;
+        }
+        
+        CHECK(textureUpdateCount == 1);
+        CHECK(renderer->EndRender() == aMASH_OK);
+        
+        //each bone matches the unbatched skinning offset at its skins offset
+        const MashMatrix4 *palette = paletteBuffer->GetPalette();
+        CHECK(palette != 0);
+        for(uint32 i = 0; i < boneCount; ++i)
+        {
+            const uint32 skinOffset = (i < 2) ? 0 : 3;
+            MashMatrix4 expected;
+            bones[i]->GetWorldSkinningOffset(expected);
+            CHECK(memcmp(palette[skinOffset + boneIds[i]].v, expected.v, sizeof(MashMatrix4)) == 0);
+        }
+        
+        //unused ids are left in their bind pose
+        MashMatrix4 identity;
+        CHECK(memcmp(palette[1].v, identity.v, sizeof(MashMatrix4)) == 0);
+        
+        //matrix n starts at texel (n % matricesPerRow) * 4 of row n / matricesPerRow
+        const MashTextureState *textureState = 0;
+        MashTexture *texture = paletteBuffer->GetTexture(&textureState);
+        CHECK((texture != 0) && (textureState != 0));
+        if (texture)
+        {
+            uint32 width = 0;
+            uint32 height = 0;
+            texture->GetSize(width, height);
+            CHECK(width == (paletteBuffer->GetMatricesPerRow() * 4));
+            
+            //null textures keep their data so it can be read back
+            void *textureData = 0;
+            CHECK(texture->Lock(aLOCK_WRITE, &textureData) == aMASH_OK);
+            CHECK(memcmp(textureData, palette, sizeof(MashMatrix4) * paletteBuffer->GetPaletteSize()) == 0);
+            CHECK(texture->Unlock() == aMASH_OK);
+        }
+        
+        //removing a skin moves the following skins down
+        paletteBuffer->RemoveSkin(skinA);
+        CHECK(skinA->GetPaletteBuffer() == 0);
+        CHECK(paletteBuffer->GetSkinOffset(skinA) == -1);
+        CHECK(paletteBuffer->GetSkinOffset(skinB) == 0);
+        CHECK(paletteBuffer->GetPaletteSize() == 2);
+        
+        CHECK(paletteBuffer->Update() == aMASH_OK);
+        palette = paletteBuffer->GetPalette();
+        for(uint32 i = 2; i < boneCount; ++i)
+        {
+            MashMatrix4 expected;
+            bones[i]->GetWorldSkinningOffset(expected);
+            CHECK(memcmp(palette[boneIds[i]].v, expected.v, sizeof(MashMatrix4)) == 0);
+        }
+        
+        paletteBuffer->Drop();
+        skinA->Drop();
+        skinB->Drop();
+        device->Drop();
+    }
+}
+
 TEST_FIXTURE(sEngineStartup, FailSpectacularly)
 {
 	CHECK(g_device != 0);
@@ -0,0 +1,86 @@
+//-------------------------------------------------------------------------
+// This file is part of Mash 3D Engine
+// Copyright (c) 2012-2016 Alegra Software
+// For license and distribution see Mash.h
+//-------------------------------------------------------------------------
+
+#include "MashInclude.h"
+
+#include "MemoryAllocator/MashDefaultMemoryAllocator.h"
+#include "Null/MashNullCreation.h"
+#include "OpenGL3/MashTextureCooker.h"
+
+#include <cstdio>
+#include <cstring>
+
+using namespace mash;
+
+/*
+	Cooks images into pre-flipped, pre-mipped DDS files.
+
+	Usage : TextureCooker [options] <source> <output.dds>
+
+	Options:
+	-dxt1     DXT1 compression.
+	-dxt5     DXT5 compression.
+	-rgba     No compression.
+	          By default DXT5 is used for images with alpha, DXT1 otherwise.
+	-nomips   Don't generate mipmaps.
+	-nopow2   Don't resize to a power of two.
+	-d3d      Don't flip the image. Use this for files loaded by the D3D10 renderer.
+*/
+int main(int argc, char **argv)
+{
+	sTextureCookSettings settings;
+	const int8 *sourceFile = 0;
+	const int8 *outputFile = 0;
+
+	for(int32 i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "-dxt1") == 0)
+			settings.format = aTEXTURE_COOK_FORMAT_DXT1;
+		else if (strcmp(argv[i], "-dxt5") == 0)
+			settings.format = aTEXTURE_COOK_FORMAT_DXT5;
+		else if (strcmp(argv[i], "-rgba") == 0)
+			settings.format = aTEXTURE_COOK_FORMAT_RGBA8;
+		else if (strcmp(argv[i], "-nomips") == 0)
+			settings.generateMipmaps = false;
+		else if (strcmp(argv[i], "-nopow2") == 0)
+			settings.resizeToPowerOfTwo = false;
+		else if (strcmp(argv[i], "-d3d") == 0)
+			settings.invertY = false;
+		else if (!sourceFile)
+			sourceFile = argv[i];
+		else if (!outputFile)
+			outputFile = argv[i];
+	}
+
+	if (!sourceFile || !outputFile)
+	{
+		printf("Usage : TextureCooker [-dxt1|-dxt5|-rgba] [-nomips] [-nopow2] [-d3d] <source> <output.dds>\n");
+		return 1;
+	}
+
+	//no window or GPU is needed, the device is only used for file access
+	sMashDeviceSettings deviceSettings;
+	deviceSettings.rendererFunctPtr = CreateMashNullDevice;
+	deviceSettings.headless = true;
+
+	MashDevice *device = CreateDevice(deviceSettings);
+	if (!device)
+		return 1;
+
+	sTextureCookInfo info;
+	eMASH_STATUS status = CookTextureFile(device->GetFileManager(), sourceFile, outputFile, settings, &info);
+
+	if (status == aMASH_OK)
+	{
+		const int8 *formatNames[] = {"RGBA8", "DXT1", "DXT5"};
+		printf("Cooked '%s' : %dx%d, %d mip levels, %s, %d bytes.\n", outputFile, info.width, info.height,
+			info.mipmapCount, formatNames[info.format], info.dataSizeInBytes);
+	}
+
+	device->Drop();
+
+	return (status == aMASH_OK) ? 0 : 1;
+}